@@ -75,6 +75,35 @@ public:
     * @return vector3 of the world position for the node
 	*/	
 	vector3 getNodePosition(int nodeNumber);    
+
+   /**
+	* Copies world positions of a range of nodes to the array; much cheaper than calling `getNodePosition()` for each.
+	* @param buf Resized to the range; reuse it across frames to avoid reallocation.
+	* @param first Index of the first node.
+	* @param count Number of nodes, -1 means all the rest; clamped to the node count.
+	* @return Number of nodes copied.
+	*/
+	int getNodePositions(array<vector3>&inout buf, int first = 0, int count = -1);
+
+   /**
+	* Like `getNodePositions()`, but copies node velocities.
+	*/
+	int getNodeVelocities(array<vector3>&inout buf, int first = 0, int count = -1);
+
+   /**
+	* Like `getNodePositions()`, but copies the forces acting on the nodes in the last physics step.
+	*/
+	int getNodeForces(array<vector3>&inout buf, int first = 0, int count = -1);
+
+	/**
+	 * Gets the total amount of beams of the truck.
+	 */
+	int getBeamCount();
+
+   /**
+	* Like `getNodePositions()`, but copies current stress of a range of beams.
+	*/
+	int getBeamStresses(array<float>&inout buf, int first = 0, int count = -1);
     
 	/**
 	 * Gets the total amount of nodes of the wheels of the truck.
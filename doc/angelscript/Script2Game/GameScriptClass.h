@@ -316,6 +316,12 @@ public:
     */
     dictionary@ getScriptDetails(int nid);    
 
+    /**
+    * Returns ScriptUnitID of the script being executed; scripts normally use the global var `thisScript` which is initialized by it.
+    * Main thread only; worker-lane scripts use the global `getCurrentScriptUnit()`.
+    */
+    int getCurrentScriptUnit();
+
     /// @}
 
     /// @name Terrain
@@ -411,6 +417,13 @@ public:
 	 */
 	void moveObjectVisuals(const string instanceName, const vector3 pos);
 
+	/**
+	 * This moves an object to a new position, including its collision boxes and triangles
+	 * @param instanceName The unique name that you chose when spawning this object
+	 * @param pos The position where the object should be moved to
+	 */
+	void moveObject(const string instanceName, const vector3 pos);
+
 	/**
 	 * This destroys an object
 	 * @param instanceName The unique name that you chose when spawning this object
@@ -39,6 +39,18 @@ void log(const string message);
  */
 void print(const string message);
 
+/**
+ * Returns ScriptUnitID of the script being executed; normally use the global var `thisScript` which is initialized by it.
+ * Available to worker lane scripts, but only valid in `main()` and global initializers there.
+ */
+int getCurrentScriptUnit();
+
+/**
+ * Like `game.pushMessage()`, but thread-safe: the message is processed on the main thread at the start of the next frame.
+ * This is the only way for worker lane scripts (loaded with 'worker_lane' = true, see `MSG_APP_LOAD_SCRIPT_REQUESTED`) to affect the game.
+ */
+void queueMessage(MsgType type, dictionary@ dict);
+
 /**
  * Binding of `RoR::scriptEvents`; All the events that can be used by the script.
  * @see Script2Game::GameScriptClass::registerForEvent()
@@ -501,7 +513,7 @@ enum MsgType
     MSG_APP_MODCACHE_LOAD_REQUESTED,           //!< Internal for game startup, DO NOT PUSH MANUALLY.
     MSG_APP_MODCACHE_UPDATE_REQUESTED,         //!< Rescan installed mods and update cache. No params.
     MSG_APP_MODCACHE_PURGE_REQUESTED,          //!< Request cleanup and full rebuild of mod cache.
-    MSG_APP_LOAD_SCRIPT_REQUESTED,             //!< Request loading a script from resource(file) or memory; Params 'filename' (string)/'buffer'(string - has precedence over filename), 'category' (ScriptCategory), 'associated_actor' (int - only for SCRIPT_CATEGORY_ACTOR)
+    MSG_APP_LOAD_SCRIPT_REQUESTED,             //!< Request loading a script from resource(file) or memory; Params 'filename' (string)/'buffer'(string - has precedence over filename), 'category' (ScriptCategory), 'associated_actor' (int - only for SCRIPT_CATEGORY_ACTOR), 'worker_lane' (bool - only for SCRIPT_CATEGORY_CUSTOM; `frameStep()` runs on a worker thread with only the thread-safe API: math, strings, containers, vectors, LocalStorage, `queueMessage()`; no events)
     MSG_APP_UNLOAD_SCRIPT_REQUESTED,           //!< Request unloading a script; Param 'id' (int - the ID of the script unit, see 'Script Monitor' tab in console UI.)   
     // Networking
     MSG_NET_CONNECT_REQUESTED,                 //!< Request connection to multiplayer server specified by cvars 'mp_server_host, mp_server_port, mp_server_password'. No params.
@@ -23,6 +23,7 @@
 
 #include "AdvancedScreen.h"
 #include "Actor.h"
+#include "AsyncLogWriter.h"
 #include "CameraManager.h"
 #include "ChatSystem.h"
 #include "Console.h"
@@ -49,6 +50,8 @@
 #   include <windows.h>
 #endif
 
+#include <cstdlib>
+#include <exception>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -289,6 +292,12 @@ bool AppContext::SetUpRendering()
     miscParams["vsync"] = ropts["VSync"].currentValue;
     miscParams["gamma"] = ropts["sRGB Gamma Conversion"].currentValue;
     miscParams["border"] = "fixed";
+    if (App::cli_headless->getBool())
+    {
+        // Resources still need a GL/D3D context, but nobody looks at the window
+        miscParams["hidden"] = "true";
+        miscParams["vsync"] = "No";
+    }
 #if OGRE_PLATFORM == OGRE_PLATFORM_WIN32
     const auto rd = ropts["Rendering Device"];
     const auto it = std::find(rd.possibleValues.begin(), rd.possibleValues.end(), rd.currentValue);
@@ -311,7 +320,7 @@ bool AppContext::SetUpRendering()
     // Create render window
     m_render_window = Ogre::Root::getSingleton().createRenderWindow (
         "Rigs of Rods version " + Ogre::String (ROR_VERSION_STRING),
-        width, height, ropts["Full Screen"].currentValue == "Yes", &miscParams);
+        width, height, ropts["Full Screen"].currentValue == "Yes" && !App::cli_headless->getBool(), &miscParams);
     OgreBites::WindowEventUtilities::_addRenderWindow(m_render_window);
 
     this->SetRenderWindowIcon(m_render_window);
@@ -447,6 +456,42 @@ bool AppContext::SetUpProgramPaths()
     return true;
 }
 
+static std::terminate_handler g_prev_terminate_handler = nullptr;
+
+static void ShutDownLoggingAtExit()
+{
+    App::GetAppContext()->ShutDownLogging();
+}
+
+static void FlushLogOnTerminate()
+{
+    App::GetAppContext()->FlushLog();
+    if (g_prev_terminate_handler)
+    {
+        g_prev_terminate_handler();
+    }
+    std::abort();
+}
+
+void AppContext::FlushLog()
+{
+    if (m_log_writer)
+    {
+        m_log_writer->Flush();
+    }
+}
+
+void AppContext::ShutDownLogging()
+{
+    if (m_log_writer)
+    {
+        m_log_writer->Flush();
+        Ogre::LogManager::getSingleton().getDefaultLog()->removeListener(m_log_writer);
+        delete m_log_writer; // Joins the writer thread
+        m_log_writer = nullptr;
+    }
+}
+
 void AppContext::SetUpLogging()
 {
     std::string logs_dir = PathCombine(App::sys_user_dir->getStr(), "logs");
@@ -455,7 +500,13 @@ void AppContext::SetUpLogging()
 
     auto ogre_log_manager = OGRE_NEW Ogre::LogManager();
     std::string rorlog_path = PathCombine(logs_dir, "RoR.log");
-    Ogre::Log* rorlog = ogre_log_manager->createLog(rorlog_path, true, true);
+    // OGRE would write and flush every line on the calling thread; `AsyncLogWriter` does it in background
+    Ogre::Log* rorlog = ogre_log_manager->createLog(rorlog_path, /*defaultLog=*/true, /*debuggerOutput=*/false, /*suppressFileOutput=*/true);
+    m_log_writer = new AsyncLogWriter(rorlog_path, /*echo_stdout=*/true);
+    rorlog->addListener(m_log_writer);
+    // Early `return -1` from main() and uncaught exceptions must not lose the lines which explain them
+    std::atexit(ShutDownLoggingAtExit);
+    g_prev_terminate_handler = std::set_terminate(FlushLogOnTerminate);
     rorlog->stream() << "[RoR] Rigs of Rods (www.rigsofrods.org) version " << ROR_VERSION_STRING;
     std::time_t t = std::time(nullptr);
     rorlog->stream() << "[RoR] Current date: " << std::put_time(std::localtime(&t), "%Y-%m-%d");
@@ -61,6 +61,10 @@ public:
     void                 CaptureScreenshot();
     void                 ActivateFullscreen(bool val);
 
+    // Logging
+    void                 FlushLog(); //!< Waits until everything logged so far is in 'RoR.log'; call before exiting.
+    void                 ShutDownLogging(); //!< Writes out the rest and stops the writer thread; runs from `atexit()`.
+
     // Getters
     Ogre::Root*          GetOgreRoot() { return m_ogre_root; }
     Ogre::Viewport*      GetViewport() { return m_viewport; }
@@ -105,6 +109,8 @@ private:
     RoR::ForceFeedback   m_force_feedback;
 
     std::thread::id      m_mainthread_id;
+
+    AsyncLogWriter*      m_log_writer = nullptr; //!< Deleted by `ShutDownLogging()` at exit; a terminate handler flushes it on crash.
 };
 
 /// @} // addtogroup Application
@@ -74,6 +74,10 @@ static ThreadPool*          g_thread_pool;
 #if USE_SOCKETW
     static Network          g_network;
 #endif
+#if USE_OPENAL
+    static std::shared_ptr<Task> g_sound_manager_task;      //!< Opens the audio device while OGRE starts, see `CreateSoundManagerAsync()`
+    static SoundManager*         g_sound_manager_prepared;
+#endif
 
 // App
 CVar* app_state;
@@ -82,6 +86,7 @@ CVar* app_country;
 CVar* app_skip_main_menu;
 CVar* app_async_physics;
 CVar* app_num_workers;
+CVar* app_pin_threads;
 CVar* app_screenshot_format;
 CVar* app_rendersys_override;
 CVar* app_extra_mod_path;
@@ -91,6 +96,7 @@ CVar* app_disable_online_api;
 CVar* app_config_long_names;
 CVar* app_custom_scripts;
 CVar* app_recent_scripts;
+CVar* app_script_frame_budget_ms;
 
 // Simulation
 CVar* sim_state;
@@ -108,7 +114,17 @@ CVar* sim_no_self_collisions;
 CVar* sim_gearbox_mode;
 CVar* sim_soft_reset_mode;
 CVar* sim_quickload_dialog;
+CVar* sim_savegame_json;
+CVar* sim_autosave_interval;
 CVar* sim_live_repair_interval;
+CVar* sim_parallel_beams_min;
+CVar* sim_deterministic;
+CVar* sim_deterministic_steps;
+CVar* sim_step_budget_ms;
+CVar* sim_cab_bvh;
+CVar* sim_step_tier_distance;
+CVar* sim_implicit_iterations;
+CVar* sim_physics_lod_distance;
 
 // Multiplayer
 CVar* mp_state;
@@ -124,6 +140,9 @@ CVar* mp_player_name;
 CVar* mp_player_token;
 CVar* mp_api_url;
 CVar* mp_cyclethru_net_actors;
+CVar* mp_net_send_budget;
+CVar* mp_net_playout_delay;
+CVar* mp_net_detail_distance;
 
 // New remote API
 CVar* remote_query_url;
@@ -153,8 +172,11 @@ CVar* diag_hide_beam_stress;
 CVar* diag_hide_wheel_info;
 CVar* diag_hide_wheels;
 CVar* diag_hide_nodes;
+CVar* diag_declutter_labels;
 CVar* diag_terrn_log_roads;
 CVar* diag_actor_dump;
+CVar* diag_startup_profile;
+CVar* diag_log_rate_limit;
 
 // System
 CVar* sys_process_dir;
@@ -181,6 +203,11 @@ CVar* cli_preset_veh_enter;
 CVar* cli_force_cache_update;
 CVar* cli_resume_autosave;
 CVar* cli_custom_scripts;
+CVar* cli_benchmark_steps;
+CVar* cli_benchmark_seconds;
+CVar* cli_input_record;
+CVar* cli_input_replay;
+CVar* cli_headless;
 
 // Input - Output
 CVar* io_analog_smoothing;
@@ -191,6 +218,7 @@ CVar* io_ffb_camera_gain;
 CVar* io_ffb_center_gain;
 CVar* io_ffb_master_gain;
 CVar* io_ffb_stress_gain;
+CVar* io_ffb_rate;
 CVar* io_input_grab_mode;
 CVar* io_arcade_controls;
 CVar* io_hydro_coupling;
@@ -199,6 +227,7 @@ CVar* io_outgauge_ip;
 CVar* io_outgauge_port;
 CVar* io_outgauge_delay;
 CVar* io_outgauge_id;
+CVar* io_outsim_port;
 CVar* io_discord_rpc;
               
 // Audio
@@ -221,6 +250,7 @@ CVar* gfx_water_mode;
 CVar* gfx_anisotropy;
 CVar* gfx_water_waves;
 CVar* gfx_particles_mode;
+CVar* gfx_particles_cull_distance;
 CVar* gfx_enable_videocams;
 CVar* gfx_window_videocams;
 CVar* gfx_surveymap_icons;
@@ -241,9 +271,27 @@ CVar* gfx_fps_limit;
 CVar* gfx_speedo_digital;
 CVar* gfx_speedo_imperial;
 CVar* gfx_flexbody_cache;
+CVar* gfx_flexbody_lod_full;
+CVar* gfx_flexbody_lod_frozen;
+CVar* gfx_flexbody_vertex_budget;
+CVar* gfx_actor_lod_full;
+CVar* gfx_occlusion_culling;
+CVar* gfx_frame_budget_ms;
+CVar* gfx_water_grid_lod_height;
+CVar* gfx_water_reflection_interval;
+CVar* gfx_water_refraction_interval;
+CVar* gfx_water_still_reflection_interval;
+CVar* gfx_terrain_page_distance;
+CVar* gfx_terrain_max_pages;
+CVar* gfx_static_batch_size;
+CVar* gfx_renderdash_fps;
+CVar* gfx_videocam_fps;
+CVar* gfx_flares_light_budget;
 CVar* gfx_reduce_shadows;
 CVar* gfx_enable_rtshaders;
 CVar* gfx_alt_actor_materials;
+CVar* gfx_shader_cache;
+CVar* gfx_texture_max_size;
 
 // Flexbodies
 CVar* flexbody_defrag_enabled;
@@ -330,11 +378,27 @@ void CreateGfxScene()
     g_gfx_scene.Init();
 }
 
+void CreateSoundManagerAsync()
+{
+#if USE_OPENAL
+    ROR_ASSERT(!g_sound_manager_task);
+    g_sound_manager_task = g_thread_pool->RunTask([]{ g_sound_manager_prepared = new SoundManager(); });
+#endif
+}
+
 void CreateSoundScriptManager()
 {
 #if USE_OPENAL
     ROR_ASSERT(!g_sound_script_manager);
-    g_sound_script_manager = new SoundScriptManager();
+    SoundManager* sound_manager = nullptr;
+    if (g_sound_manager_task)
+    {
+        g_sound_manager_task->join();
+        g_sound_manager_task = nullptr;
+        sound_manager = g_sound_manager_prepared;
+        g_sound_manager_prepared = nullptr;
+    }
+    g_sound_script_manager = new SoundScriptManager(sound_manager);
 #endif
 }
 
@@ -286,6 +286,7 @@ extern CVar* app_country;
 extern CVar* app_skip_main_menu;
 extern CVar* app_async_physics;
 extern CVar* app_num_workers;
+extern CVar* app_pin_threads;          //!< Keep worker threads and the sim thread on performance cores of hybrid CPUs
 extern CVar* app_screenshot_format;
 extern CVar* app_rendersys_override;
 extern CVar* app_extra_mod_path;
@@ -295,6 +296,7 @@ extern CVar* app_disable_online_api;
 extern CVar* app_config_long_names;
 extern CVar* app_custom_scripts;
 extern CVar* app_recent_scripts;
+extern CVar* app_script_frame_budget_ms;  //!< Max. time per frame in one script's `frameStep()`; it's suspended when over and resumed next frame. 0 = unlimited.
 
 // Simulation
 extern CVar* sim_state;
@@ -311,7 +313,17 @@ extern CVar* sim_no_self_collisions;
 extern CVar* sim_gearbox_mode;
 extern CVar* sim_soft_reset_mode;
 extern CVar* sim_quickload_dialog;
+extern CVar* sim_savegame_json;        //!< Write savegames as JSON (readable, slow, large) instead of the binary format. Both formats load.
+extern CVar* sim_autosave_interval;    //!< Seconds between background saves to 'autosave.sav' during simulation; 0 = only on exit.
 extern CVar* sim_live_repair_interval; //!< Hold EV_COMMON_REPAIR_TRUCK to enter LiveRepair mode. 0 or negative interval disables.
+extern CVar* sim_parallel_beams_min;   //!< Minimum number of plain beams for splitting an actor's beams across worker threads. 0 disables.
+extern CVar* sim_deterministic;        //!< Repeatable simulation for benchmarks: fixed steps per frame, inter-actor collisions resolved in order.
+extern CVar* sim_deterministic_steps;  //!< Physics steps per frame with `sim_deterministic`; 33 is roughly 60 FPS.
+extern CVar* sim_step_budget_ms;       //!< Most real time the physics steps of one frame may take; the excess is dropped (slow motion) instead of piling up. 0 disables.
+extern CVar* sim_cab_bvh;              //!< Walk a tree of collision cab triangles in self and inter-actor collisions, instead of testing rate-limited triangles one by one.
+extern CVar* sim_implicit_iterations;  //!< Jacobi sweeps per step for actors with 'implicitsolver'; 0 falls back to explicit integration.
+extern CVar* sim_step_tier_distance;   //!< Slow actors farther from the camera than this step at half rate, if their beams allow it. 0 disables.
+extern CVar* sim_physics_lod_distance; //!< AI actors farther from the camera than this move as a rigid body instead of a softbody. 0 disables.
 
 // Multiplayer
 extern CVar* mp_state;
@@ -327,6 +339,9 @@ extern CVar* mp_player_name;
 extern CVar* mp_player_token;
 extern CVar* mp_api_url;
 extern CVar* mp_cyclethru_net_actors; //!< Include remote actors when cycling through with CTRL + [ and CTRL + ]
+extern CVar* mp_net_send_budget;      //!< Upstream budget for actor stream data in KiB/s, shared by all local actors
+extern CVar* mp_net_detail_distance;  //!< Remote actors farther from the camera (m) are updated at reduced detail; 0 = always full detail
+extern CVar* mp_net_playout_delay;    //!< How far (ms) remote actors are rendered behind the newest received update, absorbs jitter
 
 // New remote API
 extern CVar* remote_query_url;
@@ -357,8 +372,11 @@ extern CVar* diag_hide_beam_stress;
 extern CVar* diag_hide_wheel_info;
 extern CVar* diag_hide_wheels;
 extern CVar* diag_hide_nodes;
+extern CVar* diag_declutter_labels;    //!< Debug views skip node/beam labels which would overlap others
 extern CVar* diag_terrn_log_roads;
 extern CVar* diag_actor_dump;
+extern CVar* diag_startup_profile;     //!< Saves a Chrome trace of startup phases to 'sys_profiler_dir'
+extern CVar* diag_log_rate_limit;      //!< Max. lines per second written to 'RoR.log', the rest is counted; 0 = no limit
 
 // System
 extern CVar* sys_process_dir;
@@ -385,6 +403,11 @@ extern CVar* cli_preset_veh_enter;
 extern CVar* cli_force_cache_update;
 extern CVar* cli_resume_autosave;
 extern CVar* cli_custom_scripts;
+extern CVar* cli_benchmark_steps;     //!< Physics steps to run for a benchmark (command line `-benchmark`), see `SimBenchmark`; 0 = off.
+extern CVar* cli_benchmark_seconds;   //!< Duration of a benchmark (command line `-benchmark-time`), see `SimBenchmark`; 0 = off.
+extern CVar* cli_input_record;        //!< File to record input to (command line `-record`), see `InputRecorder`; empty = off.
+extern CVar* cli_input_replay;        //!< File to replay input from (command line `-replay`), see `InputRecorder`; empty = off.
+extern CVar* cli_headless;            //!< Simulation without rendering (command line `-headless`): hidden window, frames paced by sleeping.
 
 // Input - Output
 extern CVar* io_analog_smoothing;
@@ -395,6 +418,7 @@ extern CVar* io_ffb_camera_gain;
 extern CVar* io_ffb_center_gain;
 extern CVar* io_ffb_master_gain;
 extern CVar* io_ffb_stress_gain;
+extern CVar* io_ffb_rate;         //!< Hz; force feedback output thread rate, 0 = once per frame on main thread
 extern CVar* io_input_grab_mode;
 extern CVar* io_arcade_controls;
 extern CVar* io_hydro_coupling;
@@ -403,6 +427,7 @@ extern CVar* io_outgauge_ip;
 extern CVar* io_outgauge_port;
 extern CVar* io_outgauge_delay;
 extern CVar* io_outgauge_id;
+extern CVar* io_outsim_port;
 extern CVar* io_discord_rpc;
 
 // Audio
@@ -425,6 +450,7 @@ extern CVar* gfx_water_mode;
 extern CVar* gfx_anisotropy;
 extern CVar* gfx_water_waves;
 extern CVar* gfx_particles_mode;
+extern CVar* gfx_particles_cull_distance; //!< Actor exhausts and custom particles farther from the camera stop emitting; 0 = off.
 extern CVar* gfx_enable_videocams;
 extern CVar* gfx_window_videocams;
 extern CVar* gfx_surveymap_icons;
@@ -445,9 +471,27 @@ extern CVar* gfx_fps_limit;
 extern CVar* gfx_speedo_digital;
 extern CVar* gfx_speedo_imperial;
 extern CVar* gfx_flexbody_cache;
+extern CVar* gfx_flexbody_lod_full;       //!< Flexbodies at least this big on screen (fraction of screen height) deform every frame, smaller ones less often. 0 = always.
+extern CVar* gfx_flexbody_lod_frozen;     //!< Flexbodies smaller than this on screen, or off-screen, keep their shape until they grow.
+extern CVar* gfx_flexbody_vertex_budget;  //!< Max. deformed flexbody vertices per frame, biggest on screen first. 0 = unlimited.
+extern CVar* gfx_actor_lod_full;          //!< Actors at least this big on screen (fraction of screen height) always animate; smaller ones take turns when `gfx_frame_budget_ms` is tight.
+extern CVar* gfx_occlusion_culling;       //!< Hide actors behind terrain/buildings from the main camera and skip their visual updates, see `GfxOcclusion`.
+extern CVar* gfx_frame_budget_ms;         //!< Target frame time; optional visual updates are throttled to meet it, see `GfxFrameBudget`. 0 = unlimited.
+extern CVar* gfx_water_grid_lod_height;   //!< Hydrax water grid gets coarser when the camera is higher above the water than this (meters); 0 = always full.
+extern CVar* gfx_water_reflection_interval; //!< Hydrax reflection is rendered every Nth frame; 1 = every frame.
+extern CVar* gfx_water_refraction_interval; //!< Hydrax refraction (and depth) is rendered every Nth frame; 1 = every frame.
+extern CVar* gfx_water_still_reflection_interval; //!< Hydrax reflection is refreshed only every Nth frame while the camera doesn't move; 0 = disabled.
+extern CVar* gfx_terrain_page_distance;   //!< Terrain pages further than this from the camera (meters) are streamed in/out in the background; 0 = load all pages at terrain load.
+extern CVar* gfx_terrain_max_pages;       //!< Max. terrain pages kept loaded when streaming, nearest first; 0 = unlimited.
+extern CVar* gfx_static_batch_size;       //!< Static terrain objects are merged into one batch per region of this size (meters); 0 = disabled.
+extern CVar* gfx_renderdash_fps;          //!< Update rate of 3D dashboard textures (frames per second); 0 = every frame.
+extern CVar* gfx_videocam_fps;            //!< Update rate of video cameras and mirrors (frames per second); 0 = every frame.
+extern CVar* gfx_flares_light_budget;     //!< Max. flare light sources on at once across all actors, nearest/strongest in view first. 0 = unlimited.
 extern CVar* gfx_reduce_shadows;
 extern CVar* gfx_enable_rtshaders;
 extern CVar* gfx_alt_actor_materials;
+extern CVar* gfx_shader_cache;         //!< Keep compiled GPU programs in 'sys_cache_dir' between launches
+extern CVar* gfx_texture_max_size;     //!< Actor textures larger than this (pixels) are reduced when loading; 0 = no limit
 
 // Flexbodies
 extern CVar* flexbody_defrag_enabled;
@@ -494,6 +538,7 @@ void CreateMumble();
 void CreateThreadPool();
 void CreateCameraManager();
 void CreateGfxScene();
+void CreateSoundManagerAsync();  //!< Opens the audio device on the thread pool; `CreateSoundScriptManager()` waits for it.
 void CreateSoundScriptManager();
 void CreateScriptEngine();
 
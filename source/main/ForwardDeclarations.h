@@ -43,6 +43,9 @@ namespace RoR
     typedef int RefelemID_t; //!< index to `PointColDetector::m_ref_list`, use `RoR::REFELEMID_INVALID` as empty value.
     static const RefelemID_t REFELEMID_INVALID = -1;
 
+    typedef int GroundModelID_t; //!< Index to `Collisions::m_ground_models`, assigned in config load order; use `RoR::GROUNDMODELID_INVALID` as empty value.
+    static const GroundModelID_t GROUNDMODELID_INVALID = -1;
+
     typedef uint16_t NodeNum_t; //!< Node position within `Actor::ar_nodes`; use RoR::NODENUM_INVALID as empty value.
     static const NodeNum_t NODENUM_INVALID = std::numeric_limits<NodeNum_t>::max();
 
@@ -53,8 +56,10 @@ namespace RoR
     class  Airbrake;
     class  Airfoil;
     class  AppContext;
+    class  AsyncLogWriter;
     class  Autopilot;
     class  Buoyance;
+    class  CabTriangleBvh;
     class  CacheEntry;
     class  CacheSystem;
     class  CameraManager;
@@ -67,6 +72,7 @@ namespace RoR
     class  CVar;
     class  DashBoard;
     class  DashBoardManager;
+    class  DebugDrawBatch;
     class  DustPool;
     class  DiscordRpc;
     class  EngineSim;
@@ -111,6 +117,7 @@ namespace RoR
     class  Renderdash;
     class  Replay;
     class  RigLoadingProfiler;
+    class  RodBatch;
     class  Screwprop;
     class  ScriptEngine;
     class  ShadowManager;
@@ -126,6 +133,7 @@ namespace RoR
     class  SoundScriptInstance;
     class  SoundScriptManager;
     class  SoundScriptTemplate;
+    struct SoundStream;
     class  Task;
     class  TerrainEditor;
     class  TerrainGeometryManager;
@@ -135,10 +143,12 @@ namespace RoR
     struct Terrn2Def;
     class  Terrn2Parser;
     struct Terrn2Telepoint;
+    class  TexturePreloader;
     class  TorqueCurve;
     class  ThreadPool;
     class  VehicleAI;
     class  VideoCamera;
+    class  WaveField;
 
     // SimData.h
     struct node_t;
@@ -35,6 +35,7 @@
 #include "GUI_MainSelector.h"
 #include "GUI_TopMenubar.h"
 #include "InputEngine.h"
+#include "InputRecorder.h"
 #include "OverlayWrapper.h"
 #include "Replay.h"
 #include "ScrewProp.h"
@@ -43,6 +44,7 @@
 #include "SkyXManager.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
+#include "TexturePreloader.h"
 #include "Utils.h"
 #include "VehicleAI.h"
 #include "GUI_VehicleButtons.h"
@@ -54,22 +56,29 @@ using namespace RoR;
 
 void GameContext::PushMessage(Message m)
 {
+    if (!InputRecorder::FilterMessage(m))
+        return;
+
     std::lock_guard<std::mutex> lock(m_msg_mutex);
-    m_msg_queue.push(m);
+    m_msg_queue.push(std::move(m));
     m_msg_chain_end = &m_msg_queue.back();
 }
 
 void GameContext::ChainMessage(Message m)
 {
+    if (!InputRecorder::FilterMessage(m))
+        return;
+
     std::lock_guard<std::mutex> lock(m_msg_mutex);
     if (m_msg_chain_end)
     {
-        m_msg_chain_end->chain.push_back(m);
+        m_msg_chain_end->chain.push_back(std::move(m));
         m_msg_chain_end = &m_msg_chain_end->chain.back();
     }
     else
     {
-        this->PushMessage(m);
+        m_msg_queue.push(std::move(m)); // Not `PushMessage()`, we already hold the lock
+        m_msg_chain_end = &m_msg_queue.back();
     }
 }
 
@@ -83,11 +92,11 @@ Message GameContext::PopMessage()
 {
     std::lock_guard<std::mutex> lock(m_msg_mutex);
     ROR_ASSERT(m_msg_queue.size() > 0);
-    if (m_msg_chain_end == &m_msg_queue.front())
+    if (m_msg_queue.size() == 1)
     {
-        m_msg_chain_end = nullptr;
+        m_msg_chain_end = nullptr; // It points to the last message or into its chain
     }
-    Message m = m_msg_queue.front();
+    Message m = std::move(m_msg_queue.front());
     m_msg_queue.pop();
     return m;
 }
@@ -164,6 +173,7 @@ void GameContext::UnloadTerrain()
         // release local reference - object will be deleted when all references are released.
         m_terrain = nullptr;
     }
+    m_pending_spawns.clear(); // Running parse tasks only hold their own data; results are dropped.
 }
 
 // --------------------------------
@@ -314,6 +324,110 @@ ActorPtr GameContext::SpawnActor(ActorSpawnRequest& rq)
     return fresh_actor;
 }
 
+void GameContext::QueueActorSpawn(ActorSpawnRequest& rq)
+{
+    if (rq.asr_cache_entry != nullptr)
+    {
+        rq.asr_filename = rq.asr_cache_entry->fname;
+    }
+
+    PendingSpawn pending;
+    pending.rq = rq;
+    CacheEntry* entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, rq.asr_filename);
+    if (entry != nullptr)
+    {
+        pending.prefetch = App::GetCacheSystem()->PrefetchResource(*entry);
+    }
+
+    if (!pending.prefetch)
+    {
+        if (!this->ReadPendingSpawn(pending))
+        {
+            return; // Error already reported
+        }
+        if (!pending.task && !pending.textures && m_pending_spawns.empty())
+        {
+            this->SpawnActor(rq); // Nothing to wait for
+            return;
+        }
+    }
+    m_pending_spawns.push_back(pending);
+}
+
+bool GameContext::ReadPendingSpawn(PendingSpawn& pending)
+{
+    pending.src = std::make_shared<ActorDefSource>();
+    if (!m_actor_manager.ReadActorDefSource(pending.rq.asr_filename, *pending.src))
+    {
+        return false;
+    }
+
+    if (pending.src->cache_entry->actor_def == nullptr)
+    {
+        // The task must not own the `PendingSpawn` - that would make a reference cycle with `task`
+        std::shared_ptr<ActorDefSource> src = pending.src;
+        std::shared_ptr<RigDef::DocumentPtr> def = std::make_shared<RigDef::DocumentPtr>();
+        pending.def = def;
+        pending.task = App::GetThreadPool()->RunTask([src, def]()
+            {
+                *def = ActorManager::ParseActorDef(*src, /*predefined_on_terrain=*/false);
+            });
+    }
+    pending.textures = TexturePreloader::Start(pending.src->cache_entry->resource_group);
+    return true;
+}
+
+void GameContext::UpdatePendingSpawns()
+{
+    // Loading the bundle and reading the truckfile is main thread work; do one per frame
+    for (auto itor = m_pending_spawns.begin(); itor != m_pending_spawns.end(); ++itor)
+    {
+        if (!itor->src && itor->prefetch->is_finished())
+        {
+            if (!this->ReadPendingSpawn(*itor))
+            {
+                m_pending_spawns.erase(itor); // Error already reported
+            }
+            break;
+        }
+    }
+
+    if (m_pending_spawns.empty() || !m_pending_spawns.front().src ||
+        (m_pending_spawns.front().task && !m_pending_spawns.front().task->is_finished()) ||
+        (m_pending_spawns.front().textures && !m_pending_spawns.front().textures->IsFinished()))
+    {
+        return;
+    }
+
+    PendingSpawn pending = m_pending_spawns.front();
+    m_pending_spawns.pop_front();
+    if (pending.task)
+    {
+        if (*pending.def == nullptr)
+        {
+            return; // Error already reported
+        }
+        m_actor_manager.StoreActorDef(*pending.src, *pending.def);
+    }
+    if (pending.textures)
+    {
+        pending.textures->CreateTextures();
+    }
+
+    // Creating the scene objects must stay on main thread; one actor per frame keeps the hitch short.
+    this->SpawnActor(pending.rq);
+}
+
+void GameContext::CancelPendingNetworkSpawns(int source_id, int stream_id)
+{
+    m_pending_spawns.remove_if([source_id, stream_id](PendingSpawn const& pending)
+        {
+            return pending.rq.asr_origin == ActorSpawnRequest::Origin::NETWORK &&
+                pending.rq.net_source_id == source_id &&
+                (stream_id == -1 || pending.rq.net_stream_id == stream_id);
+        });
+}
+
 void GameContext::ModifyActor(ActorModifyRequest& rq)
 {
     ActorPtr actor = m_actor_manager.GetActorById(rq.amr_actor);
@@ -451,6 +565,12 @@ void GameContext::ChangePlayerActor(ActorPtr actor)
 
         prev_player_actor->GetGfxActor()->SetRenderdashActive(false);
 
+        // Release the render textures for the next actor's cameras
+        if (prev_player_actor->GetGfxActor()->GetVideoCamState() == VideoCamState::VCSTATE_ENABLED_ONLINE)
+        {
+            prev_player_actor->GetGfxActor()->SetVideoCamState(VideoCamState::VCSTATE_ENABLED_OFFLINE);
+        }
+
         SOUND_STOP(prev_player_actor, SS_TRIG_AIR);
         SOUND_STOP(prev_player_actor, SS_TRIG_PUMP);
     }
@@ -461,11 +581,6 @@ void GameContext::ChangePlayerActor(ActorPtr actor)
 
         if (prev_player_actor)
         {
-            if (prev_player_actor->GetGfxActor()->GetVideoCamState() == VideoCamState::VCSTATE_ENABLED_ONLINE)
-            {
-                prev_player_actor->GetGfxActor()->SetVideoCamState(VideoCamState::VCSTATE_ENABLED_OFFLINE);
-            }
-
             prev_player_actor->prepareInside(false);
 
             // get player out of the vehicle
@@ -718,7 +833,8 @@ void GameContext::OnLoaderGuiApply(LoaderType type, CacheEntry* entry, std::stri
             {
                 default_skin_entry = &m_dummy_cache_selection;
                 default_skin_entry->dname = "Default skin";
-                default_skin_entry->description = "Original, unmodified skin";
+                default_skin_entry->details = std::make_shared<CacheEntryDetails>();
+                default_skin_entry->details->description = "Original, unmodified skin";
             }
 
             if (!m_current_selection.asr_skin_entry && num_skins > 0)
@@ -1416,18 +1532,16 @@ void GameContext::UpdateCommonInputEvents(float dt)
     }
 
     // all commands
+    std::vector<int> const& button_event_ids = App::GetGuiManager()->VehicleButtons.GetCommandEventID();
     for (int i = 1; i <= MAX_COMMANDS; i++) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
     {
         int eventID = EV_COMMANDS_01 + (i - 1);
 
         m_player_actor->ar_command_key[i].playerInputValue = RoR::App::GetInputEngine()->getEventValue(eventID);
 
-        for (auto id: App::GetGuiManager()->VehicleButtons.GetCommandEventID())
+        if (i < (int)button_event_ids.size() && button_event_ids[i] == eventID)
         {
-            if (id == eventID)
-            {
-                m_player_actor->ar_command_key[i].playerInputValue = 1.f;
-            }
+            m_player_actor->ar_command_key[i].playerInputValue = 1.f;
         }
     }
 
@@ -1846,7 +1960,7 @@ void GameContext::UpdateTruckInputEvents(float dt)
     }
 
     m_player_actor->UpdatePropAnimInputEvents();
-    for (ActorPtr linked_actor : m_player_actor->ar_linked_actors)
+    for (ActorPtr& linked_actor : m_player_actor->ar_linked_actors)
     {
         linked_actor->UpdatePropAnimInputEvents();
     }
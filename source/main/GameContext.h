@@ -35,6 +35,7 @@
 #include "SimData.h"
 #include "Terrain.h"
 
+#include <deque>
 #include <list>
 #include <mutex>
 #include <queue>
@@ -61,7 +62,7 @@ struct Message
     std::vector<Message> chain; //!< Posted after the message is processed
 };
 
-typedef std::queue < Message, std::list<Message>> GameMsgQueue;
+typedef std::queue < Message, std::deque<Message>> GameMsgQueue; //!< Deque: pushes and pops keep pointers to other elements valid, see `ChainMessage()`
 
 /// @} // addtogroup MsgQueue
 
@@ -118,6 +119,9 @@ public:
     /// @{
 
     ActorPtr            SpawnActor(ActorSpawnRequest& rq);
+    void                QueueActorSpawn(ActorSpawnRequest& rq);   //!< Like `SpawnActor()`, but the truckfile is parsed in background; see `UpdatePendingSpawns()`.
+    void                UpdatePendingSpawns();                    //!< Finishes at most one queued spawn per frame, in order of queueing.
+    void                CancelPendingNetworkSpawns(int source_id, int stream_id = -1); //!< Stream ID -1 means all streams of the source.
     void                ModifyActor(ActorModifyRequest& rq);
     void                DeleteActor(ActorPtr actor);
     void                UpdateActors();
@@ -157,6 +161,7 @@ public:
     std::string         ExtractSceneName(std::string const& filename);
     std::string         ExtractSceneTerrain(std::string const& filename); //!< Returns terrain filename
     void                HandleSavegameHotkeys();
+    void                UpdateAutosave(float dt_sec); //!< Periodic 'autosave.sav' in background, see cvar 'sim_autosave_interval'; call while the sim is synced.
 
     /// @}
     /// @name Gameplay feats (misc.)
@@ -190,6 +195,20 @@ private:
     ActorPtr            m_player_actor = nullptr;           //!< Actor (vehicle or machine) mounted and controlled by player
     ActorPtr            m_prev_player_actor = nullptr;      //!< Previous actor (vehicle or machine) mounted and controlled by player
     ActorPtr            m_last_spawned_actor = nullptr;     //!< Last actor spawned by user and still alive.
+    float               m_autosave_timer = 0.f;             //!< Seconds since the last periodic autosave
+
+    /// Spawn request waiting for its truckfile to be parsed in background
+    struct PendingSpawn
+    {
+        ActorSpawnRequest                    rq;
+        std::shared_ptr<Task>                prefetch; //!< Reading the resource bundle; `src` is read once it's done
+        std::shared_ptr<ActorDefSource>      src;
+        std::shared_ptr<RigDef::DocumentPtr> def;  //!< Written by `task`
+        std::shared_ptr<Task>                task; //!< Null if the definition was already available
+        std::shared_ptr<TexturePreloader>    textures; //!< Decodes the textures meanwhile; null if there's nothing to decode
+    };
+    std::list<PendingSpawn> m_pending_spawns;
+    bool                ReadPendingSpawn(PendingSpawn& pending); //!< Reads the truckfile and starts parsing it; false if error was reported.
     
     CacheEntry*         m_last_cache_selection = nullptr;   //!< Vehicle/load
     CacheEntry*         m_last_skin_selection = nullptr;
@@ -23,6 +23,8 @@
 #include "Sound.h"
 #include "SoundManager.h"
 
+#include <cmath>
+
 using namespace Ogre;
 using namespace RoR;
 
@@ -30,6 +32,7 @@ Sound::Sound(ALuint buffer, SoundManager* soundManager, int sourceIndex) :
     buffer(buffer)
     , sound_manager(soundManager)
     , source_index(sourceIndex)
+    , requested_changes(0)
     , audibility(0.0f)
     , gain(0.0f)
     , pitch(1.0f)
@@ -38,8 +41,23 @@ Sound::Sound(ALuint buffer, SoundManager* soundManager, int sourceIndex) :
     , enabled(true)
     , loop(false)
     , should_play(false)
+    , length(0.0f)
+    , playback_offset(0.0f)
+    , playing(false)
     , hardware_index(-1)
 {
+    if (buffer == 0)
+        return; // streamed, `SoundManager::createSound()` sets the length
+
+    ALint size = 0, frequency = 0, channels = 0, bits = 0;
+    alGetBufferi(buffer, AL_SIZE, &size);
+    alGetBufferi(buffer, AL_FREQUENCY, &frequency);
+    alGetBufferi(buffer, AL_CHANNELS, &channels);
+    alGetBufferi(buffer, AL_BITS, &bits);
+    if (frequency > 0 && channels > 0 && bits >= 8)
+    {
+        length = (float)size / (float)(frequency * channels * (bits / 8));
+    }
 }
 
 void Sound::computeAudibility(Vector3 pos)
@@ -51,17 +69,6 @@ void Sound::computeAudibility(Vector3 pos)
         return;
     }
 
-    // first check if the sound is finished!
-    if (!loop && should_play && hardware_index != -1)
-    {
-        int value = 0;
-        alGetSourcei((ALuint)sound_manager->getHardwareSource(hardware_index), AL_SOURCE_STATE, &value);
-        if (value != AL_PLAYING)
-        {
-            should_play = false;
-        }
-    }
-
     // should it play at all?
     if (!should_play || gain == 0.0f)
     {
@@ -69,13 +76,28 @@ void Sound::computeAudibility(Vector3 pos)
         return;
     }
 
+    // distance culling comes before asking OpenAL anything
     float distance = (pos - position).length();
-
     if (distance > sound_manager->MAX_DISTANCE)
     {
         audibility = 0.0f;
+        return;
     }
-    else if (distance < sound_manager->REFERENCE_DISTANCE)
+
+    // check if the sound is finished!
+    if (!loop && hardware_index != -1)
+    {
+        int value = 0;
+        alGetSourcei((ALuint)sound_manager->getHardwareSource(hardware_index), AL_SOURCE_STATE, &value);
+        if (value != AL_PLAYING && (!stream || stream->ended)) // a stream may be waiting for samples
+        {
+            should_play = false;
+            audibility = 0.0f;
+            return;
+        }
+    }
+
+    if (distance < sound_manager->REFERENCE_DISTANCE)
     {
         audibility = gain;
     }
@@ -85,86 +107,153 @@ void Sound::computeAudibility(Vector3 pos)
     }
 }
 
-bool Sound::isPlaying()
+void Sound::advanceVirtualPlayback(float dt)
 {
-    if (hardware_index != -1)
+    playback_offset += dt * pitch;
+    if (length <= 0.0f)
     {
-        int value = 0;
-        alGetSourcei((ALuint)sound_manager->getHardwareSource(hardware_index), AL_SOURCE_STATE, &value);
-        return (value == AL_PLAYING);
+        return;
     }
-    return false;
+
+    if (loop)
+    {
+        playback_offset = std::fmod(playback_offset, length);
+    }
+    else if (playback_offset >= length)
+    {
+        // finished while nobody could hear it
+        should_play = false;
+        playback_offset = 0.0f;
+    }
+}
+
+void Sound::requestChange(int reason)
+{
+    if (requested_changes == 0)
+    {
+        sound_manager->changed_sounds.push_back(source_index);
+    }
+
+    // only the last of play/stop counts
+    if (reason == REASON_PLAY)
+        requested_changes &= ~(1 << REASON_STOP);
+    else if (reason == REASON_STOP)
+        requested_changes &= ~(1 << REASON_PLAY);
+    requested_changes |= (1 << reason);
+}
+
+bool Sound::isPlaying()
+{
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return playing || (requested_changes & (1 << REASON_PLAY));
 }
 
 void Sound::setEnabled(bool e)
 {
-    if (e == this->enabled)
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    if (e == requested.enabled)
         return;
 
-    this->enabled = e;
-    sound_manager->recomputeSource(source_index, REASON_PLAY, 0.0f, NULL);
+    requested.enabled = e;
+    this->requestChange(REASON_ENBL);
 }
 
 bool Sound::getEnabled()
 {
-    return enabled;
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return requested.enabled;
 }
 
 void Sound::play()
 {
-    should_play = true;
-    sound_manager->recomputeSource(source_index, REASON_PLAY, 0.0f, NULL);
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    this->requestChange(REASON_PLAY);
 }
 
 void Sound::stop()
 {
-    should_play = false;
-    sound_manager->recomputeSource(source_index, REASON_STOP, 0.0f, NULL);
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    this->requestChange(REASON_STOP);
 }
 
 void Sound::setGain(float gain)
 {
-    if (gain == this->gain)
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    if (gain == requested.gain)
         return;
 
-    this->gain = gain;
-    sound_manager->recomputeSource(source_index, REASON_GAIN, gain, NULL);
+    requested.gain = gain;
+    this->requestChange(REASON_GAIN);
+}
+
+float Sound::getGain()
+{
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return requested.gain;
 }
 
 void Sound::setLoop(bool loop)
 {
-    if (loop == this->loop)
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    if (loop == requested.loop)
         return;
 
-    this->loop = loop;
-    sound_manager->recomputeSource(source_index, REASON_LOOP, (loop) ? 1.0f : 0.0f, NULL);
+    requested.loop = loop;
+    this->requestChange(REASON_LOOP);
+}
+
+bool Sound::getLoop()
+{
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return requested.loop;
 }
 
 void Sound::setPitch(float pitch)
 {
-    if (pitch == this->pitch)
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    if (pitch == requested.pitch)
         return;
 
-    this->pitch = pitch;
-    sound_manager->recomputeSource(source_index, REASON_PTCH, pitch, NULL);
+    requested.pitch = pitch;
+    this->requestChange(REASON_PTCH);
+}
+
+float Sound::getPitch()
+{
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return requested.pitch;
 }
 
 void Sound::setPosition(Ogre::Vector3 pos)
 {
-    if (pos == this->position)
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    if (pos == requested.position)
         return;
 
-    this->position = pos;
-    sound_manager->recomputeSource(source_index, REASON_POSN, 0.0f, &pos);
+    requested.position = pos;
+    this->requestChange(REASON_POSN);
+}
+
+Ogre::Vector3 Sound::getPosition()
+{
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return requested.position;
 }
 
 void Sound::setVelocity(Ogre::Vector3 vel)
 {
-    if (vel == this->velocity)
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    if (vel == requested.velocity)
         return;
 
-    this->velocity = vel;
-    sound_manager->recomputeSource(source_index, REASON_VLCT, 0.0f, &vel);
+    requested.velocity = vel;
+    this->requestChange(REASON_VLCT);
+}
+
+Ogre::Vector3 Sound::getVelocity()
+{
+    std::lock_guard<std::mutex> lock(sound_manager->queue_mutex);
+    return requested.velocity;
 }
 
 #endif // USE_OPENAL
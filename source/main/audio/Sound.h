@@ -25,6 +25,12 @@
 #include "Application.h"
 #include "RefCountingObject.h"
 
+#include <OgreDataStream.h>
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <vector>
+
 #ifdef __APPLE__
 #   include <OpenAL/al.h>
 #else
@@ -36,6 +42,49 @@ namespace RoR {
 /// @addtogroup Audio
 /// @{
 
+/// Long sound file which is read while it plays, through a few small AL buffers.
+/// WAV is plain PCM - "decoding" is just reading the file. The game thread reads ahead
+/// (`SoundManager::readStreams()`), the audio thread queues what was read (`SoundManager::updateStream()`).
+struct SoundStream
+{
+    static const int    NUM_BUFFERS = 4;
+    static const size_t BUFFER_BYTES = 64 * 1024;
+
+    struct Chunk
+    {
+        size_t             pos;     //!< Relative to `data_begin`
+        std::vector<char>  samples;
+    };
+
+    // Set up by `SoundManager::loadWAVFile()`, constant afterwards
+    int                 format = 0;
+    int                 frequency = 0;
+    int                 block_align = 1;     //!< Bytes per sample frame
+    int                 bytes_per_second = 0;
+    size_t              data_begin = 0;      //!< Offset of the samples in `data`
+    size_t              data_size = 0;
+
+    // Reader side (game thread)
+    Ogre::DataStreamPtr data;
+    size_t              read_pos = 0;        //!< Next byte to read, relative to `data_begin`
+
+    // Guarded by `SoundManager::queue_mutex`
+    std::deque<Chunk>   ready_chunks;        //!< Read ahead, in playback order
+    bool                active = false;      //!< Has a hardware source; only then it's read ahead
+    bool                loop = false;
+    bool                seek_requested = false;
+    size_t              seek_pos = 0;
+    int                 seek_generation = 0; //!< Chunks read before the latest seek are dropped
+
+    // Audio thread side
+    ALuint              buffers[NUM_BUFFERS] = {};
+    std::vector<ALuint> free_buffers;
+    std::deque<std::pair<size_t, size_t>> queued; //!< Position and size of each queued buffer, oldest first
+    bool                ended = false;       //!< A one-shot stream had all its samples queued
+};
+
+/// Setters and getters may be used from any thread; the changes are applied by the audio thread
+/// once per frame, only the latest value of each counts. See `SoundManager::updateAudio()`.
 class Sound : public RefCountingObject<Sound>
 {
     friend class SoundManager;
@@ -54,15 +103,15 @@ public:
     void stop();
 
     bool getEnabled();
-    bool isPlaying();
+    bool isPlaying(); //!< As of the last audio update, or about to start.
     float getAudibility() { return audibility; }
-    float getGain() { return gain; }
-    float getPitch() { return pitch; }
-    bool getLoop() { return loop; }
+    float getGain();
+    float getPitch();
+    bool getLoop();
     int getCurrentHardwareIndex() { return hardware_index; }
     ALuint getBuffer() { return buffer; }
-    Ogre::Vector3 getPosition() { return position; }
-    Ogre::Vector3 getVelocity() { return velocity; }
+    Ogre::Vector3 getPosition();
+    Ogre::Vector3 getVelocity();
     int getSourceIndex() { return source_index; }
 
     enum RecomputeSource
@@ -73,21 +122,43 @@ public:
         REASON_LOOP,
         REASON_PTCH,
         REASON_POSN,
-        REASON_VLCT
+        REASON_VLCT,
+        REASON_ENBL
     };
 
 private:
+    struct Settings
+    {
+        float gain = 0.0f;
+        float pitch = 1.0f;
+        bool loop = false;
+        bool enabled = true;
+        Ogre::Vector3 position = Ogre::Vector3::ZERO;
+        Ogre::Vector3 velocity = Ogre::Vector3::ZERO;
+    };
+
+    void requestChange(int reason); //!< Caller must hold `SoundManager::queue_mutex`
     void computeAudibility(Ogre::Vector3 pos);
+    void advanceVirtualPlayback(float dt); //!< Keeps time while there's no hardware source; stops finished one-shot sounds.
+
+    // Game side, guarded by `SoundManager::queue_mutex`
+    Settings requested;
+    int requested_changes; //!< One bit per `RecomputeSource`; non-zero while listed in `SoundManager::changed_sounds`
 
-    float audibility;
+    // Audio thread side; the settings are copied from `requested`
+    std::atomic<float> audibility;
     float gain;
     float pitch;
     bool loop;
     bool enabled;
     bool should_play;
+    float length;          //!< Of the buffer, in seconds; 0 if unknown
+    float playback_offset; //!< Seconds into the buffer; only kept up to date while without hardware source
+    std::unique_ptr<SoundStream> stream; //!< Null if the whole file is in `buffer`
+    bool playing; //!< Published for `isPlaying()` by the audio thread; guarded by `SoundManager::queue_mutex`
 
     // this value is changed dynamically, depending on whether the input is played or not.
-    int hardware_index;
+    std::atomic<int> hardware_index;
     ALuint buffer;
 
     Ogre::Vector3 position;
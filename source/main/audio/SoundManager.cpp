@@ -28,6 +28,9 @@
 
 #include <OgreResourceGroupManager.h>
 
+#include <algorithm>
+#include <cmath>
+
 #define LOGSTREAM Ogre::LogManager::getSingleton().stream() << "[RoR|Audio] "
 
 bool _checkALErrors(const char* filename, int linenum)
@@ -52,6 +55,8 @@ const float SoundManager::MAX_DISTANCE = 500.0f;
 const float SoundManager::ROLLOFF_FACTOR = 1.0f;
 const float SoundManager::REFERENCE_DISTANCE = 7.5f;
 
+static const float HANDOFF_HYSTERESIS = 1.2f; // Audibility bonus of sounds already playing, so that equally loud ones don't swap every frame
+
 SoundManager::SoundManager()
 {
     if (App::audio_device_name->getStr() == "")
@@ -115,13 +120,29 @@ SoundManager::SoundManager()
     {
         hardware_sources_map[i] = -1;
     }
+
+    audio_thread = std::thread(&SoundManager::audioThreadMain, this);
 }
 
 SoundManager::~SoundManager()
 {
+    if (audio_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            exit_requested = true;
+        }
+        queue_cv.notify_one();
+        audio_thread.join();
+    }
+
     // delete the sources and buffers
     alDeleteSources(MAX_HARDWARE_SOURCES, hardware_sources);
     alDeleteBuffers(MAX_AUDIO_BUFFERS, audio_buffers);
+    for (int source_index: streamed_sounds)
+    {
+        alDeleteBuffers(SoundStream::NUM_BUFFERS, audio_sources[source_index]->stream->buffers);
+    }
 
     // destroy the sound context and device
     sound_context = alcGetCurrentContext();
@@ -139,22 +160,167 @@ void SoundManager::setCamera(Ogre::Vector3 position, Ogre::Vector3 direction, Og
 {
     if (!audio_device)
         return;
-    camera_position = position;
-    recomputeAllSources();
-
-    float orientation[6];
-    // direction
-    orientation[0] = direction.x;
-    orientation[1] = direction.y;
-    orientation[2] = direction.z;
-    // up
-    orientation[3] = up.x;
-    orientation[4] = up.y;
-    orientation[5] = up.z;
-
-    alListener3f(AL_POSITION, position.x, position.y, position.z);
-    alListener3f(AL_VELOCITY, velocity.x, velocity.y, velocity.z);
-    alListenerfv(AL_ORIENTATION, orientation);
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    requested_listener.position = position;
+    requested_listener.direction = direction;
+    requested_listener.up = up;
+    requested_listener.velocity = velocity;
+    listener_changed = true;
+}
+
+void SoundManager::update()
+{
+    if (!audio_device)
+        return;
+
+    this->readStreams();
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        requested_master_volume = App::audio_master_volume->getFloat();
+        frame_requested = true;
+    }
+    queue_cv.notify_one();
+}
+
+void SoundManager::audioThreadMain()
+{
+    std::vector<std::pair<int, int>> changes; // source index, `Sound::requested_changes`
+    auto last_update_time = std::chrono::steady_clock::now();
+
+    for (;;)
+    {
+        ListenerState listener;
+        bool update_listener = false;
+        float listener_gain = 0.0f;
+        bool update_listener_gain = false;
+
+        // take over the requests; the game may queue new ones meanwhile
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex);
+            queue_cv.wait(lock, [this] { return frame_requested || exit_requested; });
+            if (exit_requested)
+                return;
+            frame_requested = false;
+
+            changes.clear();
+            for (int source_index: changed_sounds)
+            {
+                Sound& sound = *audio_sources[source_index];
+                changes.push_back(std::make_pair(source_index, sound.requested_changes));
+                if (sound.requested_changes & (1 << Sound::REASON_PLAY))
+                    sound.playing = true; // until the update below publishes the actual state; `isPlaying()` must not blink
+                else if (sound.requested_changes & (1 << Sound::REASON_STOP))
+                    sound.playing = false;
+                sound.requested_changes = 0;
+                sound.gain = sound.requested.gain;
+                sound.pitch = sound.requested.pitch;
+                sound.loop = sound.requested.loop;
+                sound.enabled = sound.requested.enabled;
+                sound.position = sound.requested.position;
+                sound.velocity = sound.requested.velocity;
+            }
+            changed_sounds.clear();
+            audio_sources_count = audio_buffers_in_use_count;
+            master_volume = requested_master_volume;
+
+            listener = requested_listener;
+            update_listener = listener_changed;
+            listener_changed = false;
+            listener_gain = requested_listener_gain;
+            update_listener_gain = listener_gain_changed;
+            listener_gain_changed = false;
+        }
+
+        if (update_listener)
+        {
+            camera_position = listener.position;
+
+            float orientation[6];
+            // direction
+            orientation[0] = listener.direction.x;
+            orientation[1] = listener.direction.y;
+            orientation[2] = listener.direction.z;
+            // up
+            orientation[3] = listener.up.x;
+            orientation[4] = listener.up.y;
+            orientation[5] = listener.up.z;
+
+            alListener3f(AL_POSITION, listener.position.x, listener.position.y, listener.position.z);
+            alListener3f(AL_VELOCITY, listener.velocity.x, listener.velocity.y, listener.velocity.z);
+            alListenerfv(AL_ORIENTATION, orientation);
+        }
+        if (update_listener_gain)
+        {
+            alListenerf(AL_GAIN, listener_gain);
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        this->updateAudio(changes, std::chrono::duration<float>(now - last_update_time).count());
+        last_update_time = now;
+    }
+}
+
+void SoundManager::updateAudio(std::vector<std::pair<int, int>> const& changes, float dt)
+{
+    for (auto const& change: changes)
+    {
+        Sound& sound = *audio_sources[change.first];
+        if (change.second & (1 << Sound::REASON_PLAY))
+        {
+            sound.should_play = true;
+            sound.playback_offset = 0.0f;
+        }
+        else if (change.second & (1 << Sound::REASON_STOP))
+        {
+            sound.should_play = false;
+        }
+
+        // each setting once, with its latest value
+        for (int reason = Sound::REASON_PLAY; reason <= Sound::REASON_ENBL; reason++)
+        {
+            if (!(change.second & (1 << reason)))
+                continue;
+
+            switch (reason)
+            {
+            case Sound::REASON_GAIN: recomputeSource(change.first, reason, sound.gain, nullptr);
+                break;
+            case Sound::REASON_LOOP: recomputeSource(change.first, reason, (sound.loop) ? 1.0f : 0.0f, nullptr);
+                break;
+            case Sound::REASON_PTCH: recomputeSource(change.first, reason, sound.pitch, nullptr);
+                break;
+            case Sound::REASON_POSN: recomputeSource(change.first, reason, 0.0f, &sound.position);
+                break;
+            case Sound::REASON_VLCT: recomputeSource(change.first, reason, 0.0f, &sound.velocity);
+                break;
+            default: recomputeSource(change.first, reason, 0.0f, nullptr);
+                break;
+            }
+        }
+    }
+
+    this->recomputeAllSources(dt);
+
+    // publish for `Sound::isPlaying()`, which reads it together with the pending requests
+    for (int i = 0; i < audio_sources_count; i++)
+    {
+        Sound& sound = *audio_sources[i];
+        bool playing = false;
+        if (sound.hardware_index != -1)
+        {
+            int value = 0;
+            alGetSourcei(hardware_sources[sound.hardware_index], AL_SOURCE_STATE, &value);
+            playing = (value == AL_PLAYING) || (sound.stream && sound.should_play && !sound.stream->ended);
+        }
+        audio_sources_playing[i] = playing;
+    }
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    for (int i = 0; i < audio_sources_count; i++)
+    {
+        audio_sources[i]->playing = audio_sources_playing[i];
+    }
 }
 
 bool compareByAudibility(std::pair<int, float> a, std::pair<int, float> b)
@@ -162,47 +328,73 @@ bool compareByAudibility(std::pair<int, float> a, std::pair<int, float> b)
     return a.second > b.second;
 }
 
-// called when the camera moves
-void SoundManager::recomputeAllSources()
+// called once per frame, by the audio thread
+void SoundManager::recomputeAllSources(float dt)
 {
-    // Creates this issue: https://github.com/RigsOfRods/rigs-of-rods/issues/1054
-#if 0
-	if (!audio_device) return;
-
-	for (int i=0; i < audio_buffers_in_use_count; i++)
-	{
-		audio_sources[i]->computeAudibility(camera_position);
-		audio_sources_most_audible[i].first = i;
-		audio_sources_most_audible[i].second = audio_sources[i]->audibility;
-	}
-    // sort first 'num_hardware_sources' sources by audibility
+    if (!audio_device)
+        return;
+
+    // streams run dry unless refilled in time; do it before `computeAudibility()` takes them for finished
+    for (int i = 0; i < hardware_sources_num; i++)
+    {
+        if (hardware_sources_map[i] != -1 && audio_sources[hardware_sources_map[i]]->stream)
+        {
+            updateStream(*audio_sources[hardware_sources_map[i]], hardware_sources[i]);
+        }
+    }
+
+    int num_audible = 0;
+    for (int i = 0; i < audio_sources_count; i++)
+    {
+        SoundPtr& sound = audio_sources[i];
+        if (sound->hardware_index == -1 && sound->should_play)
+        {
+            sound->advanceVirtualPlayback(dt);
+        }
+        sound->computeAudibility(camera_position);
+
+        if (sound->audibility > 0.0f)
+        {
+            const float bias = (sound->hardware_index != -1) ? HANDOFF_HYSTERESIS : 1.0f;
+            audio_sources_most_audible[num_audible++] = std::make_pair(i, sound->audibility * bias);
+        }
+        else if (sound->hardware_index != -1)
+        {
+            retire(i);
+        }
+    }
+
+    // partial sort: only the first 'hardware_sources_num' need to be the most audible ones
     // see: https://en.wikipedia.org/wiki/Selection_algorithm
-	if ((audio_buffers_in_use_count - 1) > hardware_sources_num)
-	{
-		std::nth_element(audio_sources_most_audible, audio_sources_most_audible+hardware_sources_num, audio_sources_most_audible + audio_buffers_in_use_count - 1, compareByAudibility);
-	}
-    // retire out of range sources first
-	for (int i=0; i < audio_buffers_in_use_count; i++)
-	{
-		if (audio_sources[audio_sources_most_audible[i].first]->hardware_index != -1 && (i >= hardware_sources_num || audio_sources_most_audible[i].second == 0))
-			retire(audio_sources_most_audible[i].first);
-	}
-    // assign new sources
-	for (int i=0; i < std::min(audio_buffers_in_use_count, hardware_sources_num); i++)
-	{
-		if (audio_sources[audio_sources_most_audible[i].first]->hardware_index == -1 && audio_sources_most_audible[i].second > 0)
-		{
-			for (int j=0; j < hardware_sources_num; j++)
-			{
-				if (hardware_sources_map[j] == -1)
-				{
-					assign(audio_sources_most_audible[i].first, j);
-					break;
-				}
-			}
-		}
-	}
-#endif
+    const int num_selected = std::min(num_audible, hardware_sources_num);
+    if (num_audible > hardware_sources_num)
+    {
+        std::nth_element(audio_sources_most_audible, audio_sources_most_audible + hardware_sources_num,
+            audio_sources_most_audible + num_audible, compareByAudibility);
+    }
+
+    // retire the faint sources first, to make room
+    for (int i = num_selected; i < num_audible; i++)
+    {
+        retire(audio_sources_most_audible[i].first);
+    }
+
+    // assign free hardware sources to the audible ones; they resume where they virtually are
+    int free_index = 0;
+    for (int i = 0; i < num_selected; i++)
+    {
+        const int source_index = audio_sources_most_audible[i].first;
+        if (audio_sources[source_index]->hardware_index != -1)
+            continue;
+
+        while (free_index < hardware_sources_num && hardware_sources_map[free_index] != -1)
+        {
+            free_index++;
+        }
+        if (free_index == hardware_sources_num)
+            break;
+        assign(source_index, free_index);
+    }
 }
 
 void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vector3* vvec)
@@ -225,17 +417,37 @@ void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vect
         if (audio_sources[source_index]->hardware_index != -1)
         {
             ALuint hw_source = hardware_sources[audio_sources[source_index]->hardware_index];
+            SoundStream* stream = audio_sources[source_index]->stream.get();
             // m_audio_sources[source_index] already playing
             // update the AL settings
             switch (reason)
             {
-            case Sound::REASON_PLAY: alSourcePlay(hw_source);
+            case Sound::REASON_PLAY:
+                if (stream)
+                {
+                    // rewind; the samples arrive with the next `updateStream()`
+                    stopStream(*audio_sources[source_index], hw_source);
+                    startStream(*audio_sources[source_index]);
+                }
+                else
+                {
+                    alSourcePlay(hw_source);
+                }
                 break;
             case Sound::REASON_STOP: alSourceStop(hw_source);
                 break;
-            case Sound::REASON_GAIN: alSourcef(hw_source, AL_GAIN, vfl * App::audio_master_volume->getFloat());
+            case Sound::REASON_GAIN: alSourcef(hw_source, AL_GAIN, vfl * master_volume);
                 break;
-            case Sound::REASON_LOOP: alSourcei(hw_source, AL_LOOPING, (vfl > 0.5) ? AL_TRUE : AL_FALSE);
+            case Sound::REASON_LOOP:
+                if (stream) // streams loop by rewinding themselves
+                {
+                    std::lock_guard<std::mutex> lock(queue_mutex);
+                    stream->loop = (vfl > 0.5);
+                }
+                else
+                {
+                    alSourcei(hw_source, AL_LOOPING, (vfl > 0.5) ? AL_TRUE : AL_FALSE);
+                }
                 break;
             case Sound::REASON_PTCH: alSourcef(hw_source, AL_PITCH, vfl);
                 break;
@@ -250,6 +462,7 @@ void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vect
         {
             // try to make it play by the hardware
             // check if there is one free m_audio_sources[source_index] in the pool
+            // if not, it plays virtually until `recomputeAllSources()` finds it louder than others
             if (hardware_sources_in_use_count < hardware_sources_num)
             {
                 for (int i = 0; i < hardware_sources_num; i++)
@@ -261,29 +474,6 @@ void SoundManager::recomputeSource(int source_index, int reason, float vfl, Vect
                     }
                 }
             }
-            else
-            {
-                // now, compute who is the faintest
-                // note: we know the table m_hardware_sources_map is full!
-                float fv = 1.0f;
-                int al_faintest = 0;
-                for (int i = 0; i < hardware_sources_num; i++)
-                {
-                    if (hardware_sources_map[i] >= 0 && audio_sources[hardware_sources_map[i]]->audibility < fv)
-                    {
-                        fv = audio_sources[hardware_sources_map[i]]->audibility;
-                        al_faintest = i;
-                    }
-                }
-                // check to ensure that the sound is louder than the faintest sound currently playing
-                if (fv < audio_sources[source_index]->audibility)
-                {
-                    // this new m_audio_sources[source_index] is louder than the faintest!
-                    retire(hardware_sources_map[al_faintest]);
-                    assign(source_index, al_faintest);
-                }
-                // else this m_audio_sources[source_index] is too faint, we don't play it!
-            }
         }
     }
 }
@@ -300,15 +490,23 @@ void SoundManager::assign(int source_index, int hardware_index)
 
     // the hardware source is supposed to be stopped!
     alSourcei(hw_source, AL_BUFFER, audio_source->buffer);
-    alSourcef(hw_source, AL_GAIN, audio_source->gain * App::audio_master_volume->getFloat());
-    alSourcei(hw_source, AL_LOOPING, (audio_source->loop) ? AL_TRUE : AL_FALSE);
+    alSourcef(hw_source, AL_GAIN, audio_source->gain * master_volume);
+    alSourcei(hw_source, AL_LOOPING, (audio_source->loop && !audio_source->stream) ? AL_TRUE : AL_FALSE);
     alSourcef(hw_source, AL_PITCH, audio_source->pitch);
     alSource3f(hw_source, AL_POSITION, audio_source->position.x, audio_source->position.y, audio_source->position.z);
     alSource3f(hw_source, AL_VELOCITY, audio_source->velocity.x, audio_source->velocity.y, audio_source->velocity.z);
 
     if (audio_source->should_play)
     {
-        alSourcePlay(hw_source);
+        if (audio_source->stream)
+        {
+            startStream(*audio_source); // starts playing once the samples arrive
+        }
+        else
+        {
+            alSourcef(hw_source, AL_SEC_OFFSET, audio_source->playback_offset);
+            alSourcePlay(hw_source);
+        }
     }
 
     hardware_sources_in_use_count++;
@@ -320,7 +518,30 @@ void SoundManager::retire(int source_index)
         return;
     if (audio_sources[source_index]->hardware_index == -1)
         return;
-    alSourceStop(hardware_sources[audio_sources[source_index]->hardware_index]);
+    ALuint hw_source = hardware_sources[audio_sources[source_index]->hardware_index];
+    SoundStream* stream = audio_sources[source_index]->stream.get();
+    if (audio_sources[source_index]->should_play && (!stream || !stream->queued.empty()))
+    {
+        // keep the position, for when it gets a hardware source again
+        alGetSourcef(hw_source, AL_SEC_OFFSET, &audio_sources[source_index]->playback_offset);
+        if (stream)
+        {
+            // the offset is relative to the oldest queued buffer, which may be before the loop point
+            audio_sources[source_index]->playback_offset += (float)stream->queued.front().first / (float)stream->bytes_per_second;
+            if (audio_sources[source_index]->loop && audio_sources[source_index]->length > 0.0f)
+            {
+                audio_sources[source_index]->playback_offset = std::fmod(audio_sources[source_index]->playback_offset, audio_sources[source_index]->length);
+            }
+        }
+    }
+    if (stream)
+    {
+        stopStream(*audio_sources[source_index], hw_source);
+    }
+    else
+    {
+        alSourceStop(hw_source);
+    }
     hardware_sources_map[audio_sources[source_index]->hardware_index] = -1;
     audio_sources[source_index]->hardware_index = -1;
     hardware_sources_in_use_count--;
@@ -330,25 +551,183 @@ void SoundManager::pauseAllSounds()
 {
     if (!audio_device)
         return;
-    // no mutex needed
-    alListenerf(AL_GAIN, 0.0f);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        requested_listener_gain = 0.0f;
+        listener_gain_changed = true;
+        frame_requested = true;
+    }
+    queue_cv.notify_one();
 }
 
 void SoundManager::resumeAllSounds()
 {
     if (!audio_device)
         return;
-    // no mutex needed
-    alListenerf(AL_GAIN, App::audio_master_volume->getFloat());
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        requested_listener_gain = App::audio_master_volume->getFloat();
+        listener_gain_changed = true;
+        frame_requested = true;
+    }
+    queue_cv.notify_one();
 }
 
 void SoundManager::setMasterVolume(float v)
 {
     if (!audio_device)
         return;
-    // no mutex needed
     App::audio_master_volume->setVal(v); // TODO: Use 'pending' mechanism and set externally, only 'apply' here.
-    alListenerf(AL_GAIN, v);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        requested_listener_gain = v;
+        requested_master_volume = v;
+        listener_gain_changed = true;
+        frame_requested = true;
+    }
+    queue_cv.notify_one();
+}
+
+void SoundManager::startStream(Sound& sound)
+{
+    SoundStream& stream = *sound.stream;
+    size_t pos = (size_t)(sound.playback_offset * stream.bytes_per_second);
+    pos -= pos % stream.block_align;
+
+    stream.queued.clear();
+    stream.free_buffers.assign(stream.buffers, stream.buffers + SoundStream::NUM_BUFFERS);
+    stream.ended = false;
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    stream.ready_chunks.clear();
+    stream.active = true;
+    stream.loop = sound.loop;
+    stream.seek_requested = true;
+    stream.seek_pos = std::min(pos, stream.data_size);
+    stream.seek_generation++;
+}
+
+void SoundManager::stopStream(Sound& sound, ALuint hw_source)
+{
+    SoundStream& stream = *sound.stream;
+    alSourceStop(hw_source);
+    alSourcei(hw_source, AL_BUFFER, 0); // unqueue all
+    stream.queued.clear();
+    stream.free_buffers.assign(stream.buffers, stream.buffers + SoundStream::NUM_BUFFERS);
+
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    stream.ready_chunks.clear();
+    stream.active = false;
+}
+
+void SoundManager::updateStream(Sound& sound, ALuint hw_source)
+{
+    SoundStream& stream = *sound.stream;
+    ALint processed = 0;
+    alGetSourcei(hw_source, AL_BUFFERS_PROCESSED, &processed);
+    for (; processed > 0 && !stream.queued.empty(); processed--)
+    {
+        ALuint buffer = 0;
+        alSourceUnqueueBuffers(hw_source, 1, &buffer);
+        stream.queued.pop_front();
+        stream.free_buffers.push_back(buffer);
+    }
+
+    // take what the game thread has read meanwhile
+    stream_chunks.clear();
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        while (stream_chunks.size() < stream.free_buffers.size() && !stream.ready_chunks.empty())
+        {
+            stream_chunks.push_back(std::move(stream.ready_chunks.front()));
+            stream.ready_chunks.pop_front();
+        }
+    }
+
+    for (SoundStream::Chunk& chunk: stream_chunks)
+    {
+        ALuint buffer = stream.free_buffers.back();
+        stream.free_buffers.pop_back();
+        alBufferData(buffer, stream.format, chunk.samples.data(), (ALsizei)chunk.samples.size(), stream.frequency);
+        alSourceQueueBuffers(hw_source, 1, &buffer);
+        stream.queued.push_back(std::make_pair(chunk.pos, chunk.samples.size()));
+        if (!sound.loop && chunk.pos + chunk.samples.size() >= stream.data_size)
+        {
+            stream.ended = true;
+        }
+    }
+
+    // not started yet, or ran dry (a long frame); the end of a one-shot is detected by `Sound::computeAudibility()`
+    ALint state = 0;
+    alGetSourcei(hw_source, AL_SOURCE_STATE, &state);
+    if (state != AL_PLAYING && sound.should_play && !stream.queued.empty())
+    {
+        alSourcePlay(hw_source);
+    }
+}
+
+void SoundManager::readStreams()
+{
+    for (int source_index: streamed_sounds)
+    {
+        SoundStream& stream = *audio_sources[source_index]->stream;
+        size_t wanted = 0;
+        bool loop = false;
+        int generation = 0;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (!stream.active || stream.ready_chunks.size() >= SoundStream::NUM_BUFFERS)
+                continue;
+            if (stream.seek_requested)
+            {
+                stream.read_pos = stream.seek_pos;
+                stream.seek_requested = false;
+            }
+            wanted = SoundStream::NUM_BUFFERS - stream.ready_chunks.size();
+            loop = stream.loop;
+            generation = stream.seek_generation;
+        }
+
+        // read without holding the lock, it's the slow part
+        std::vector<SoundStream::Chunk> chunks;
+        while (chunks.size() < wanted)
+        {
+            if (stream.read_pos >= stream.data_size)
+            {
+                if (!loop)
+                    break;
+                stream.read_pos = 0;
+            }
+
+            size_t size = stream.data_size - stream.read_pos;
+            if (size > SoundStream::BUFFER_BYTES)
+                size = SoundStream::BUFFER_BYTES;
+            size -= size % stream.block_align;
+            if (size == 0)
+                break;
+
+            SoundStream::Chunk chunk;
+            chunk.pos = stream.read_pos;
+            chunk.samples.resize(size);
+            stream.data->seek(stream.data_begin + stream.read_pos);
+            if (stream.data->read(chunk.samples.data(), size) != size)
+            {
+                stream.read_pos = stream.data_size; // truncated file; play what we have
+                break;
+            }
+            stream.read_pos += size;
+            chunks.push_back(std::move(chunk));
+        }
+
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (stream.active && stream.seek_generation == generation)
+        {
+            for (SoundStream::Chunk& chunk: chunks)
+            {
+                stream.ready_chunks.push_back(std::move(chunk));
+            }
+        }
+    }
 }
 
 SoundPtr SoundManager::createSound(String filename, Ogre::String resource_group_name /* = "" */)
@@ -363,38 +742,59 @@ SoundPtr SoundManager::createSound(String filename, Ogre::String resource_group_
     }
 
     ALuint buffer = 0;
+    std::unique_ptr<SoundStream> stream;
 
     // is the file already loaded?
-    for (int i = 0; i < audio_buffers_in_use_count; i++)
+    auto found = audio_buffer_index.find(filename);
+    if (found != audio_buffer_index.end())
     {
-        if (filename == audio_buffer_file_name[i])
-        {
-            buffer = audio_buffers[i];
-            break;
-        }
+        buffer = found->second;
     }
 
     if (!buffer)
     {
-        // load the file
+        // load the file; long ones are streamed instead, each sound reading its own copy as it plays
         alGenBuffers(1, &audio_buffers[audio_buffers_in_use_count]);
-        if (loadWAVFile(filename, audio_buffers[audio_buffers_in_use_count], resource_group_name))
+        stream.reset(new SoundStream());
+        if (loadWAVFile(filename, audio_buffers[audio_buffers_in_use_count], resource_group_name, stream.get()))
         {
             // there was an error!
             alDeleteBuffers(1, &audio_buffers[audio_buffers_in_use_count]);
+            audio_buffers[audio_buffers_in_use_count] = 0;
             audio_buffer_file_name[audio_buffers_in_use_count] = "";
             return NULL;
         }
-        buffer = audio_buffers[audio_buffers_in_use_count];
-        audio_buffer_file_name[audio_buffers_in_use_count] = filename;
+
+        if (stream->data)
+        {
+            alDeleteBuffers(1, &audio_buffers[audio_buffers_in_use_count]);
+            audio_buffers[audio_buffers_in_use_count] = 0;
+            alGenBuffers(SoundStream::NUM_BUFFERS, stream->buffers);
+        }
+        else
+        {
+            stream.reset();
+            buffer = audio_buffers[audio_buffers_in_use_count];
+            audio_buffer_file_name[audio_buffers_in_use_count] = filename;
+            audio_buffer_index[filename] = buffer;
+        }
     }
 
-    audio_sources[audio_buffers_in_use_count] = new Sound(buffer, this, audio_buffers_in_use_count);
+    SoundPtr sound = new Sound(buffer, this, audio_buffers_in_use_count);
+    if (stream)
+    {
+        sound->length = (float)stream->data_size / (float)stream->bytes_per_second;
+        sound->stream = std::move(stream);
+        streamed_sounds.push_back(audio_buffers_in_use_count);
+    }
 
+    // the audio thread picks it up with the next update
+    std::lock_guard<std::mutex> lock(queue_mutex);
+    audio_sources[audio_buffers_in_use_count] = sound;
     return audio_sources[audio_buffers_in_use_count++];
 }
 
-bool SoundManager::loadWAVFile(String filename, ALuint buffer, Ogre::String resource_group_name /*= ""*/)
+bool SoundManager::loadWAVFile(String filename, ALuint buffer, Ogre::String resource_group_name /*= ""*/, SoundStream* stream_out /*= nullptr*/)
 {
     if (!audio_device)
         return true;
@@ -549,6 +949,19 @@ bool SoundManager::loadWAVFile(String filename, ALuint buffer, Ogre::String reso
 
     if (channels != 1) LOG("Invalid WAV file: the file needs to be mono, and nothing else. Will try to continue anyways ...");
 
+    if (stream_out && dataSize >= STREAMING_MIN_BYTES)
+    {
+        // the stream stays open, samples are read as they play
+        stream_out->data = stream;
+        stream_out->data_begin = stream->tell();
+        stream_out->data_size = std::min((size_t)dataSize, stream->size() - stream_out->data_begin);
+        stream_out->format = format;
+        stream_out->frequency = (int)freq;
+        stream_out->block_align = std::max(1, channels * bps / 8);
+        stream_out->bytes_per_second = (int)freq * stream_out->block_align;
+        return false;
+    }
+
     // ok, creating buffer
     void* bdata = malloc(dataSize);
     if (!bdata)
@@ -24,10 +24,18 @@
 #pragma once
 
 #include "Application.h"
+#include "Sound.h"
 
 #include <OgreVector3.h>
 #include <OgreString.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
 #ifdef __APPLE__
   #include <OpenAL/al.h>
   #include <OpenAL/alc.h>
@@ -41,6 +49,8 @@ namespace RoR {
 /// @addtogroup Audio
 /// @{
 
+/// All OpenAL sources are driven by a dedicated audio thread, so that driver latency doesn't hold up the frame.
+/// The game only records changes (see `Sound`) and hands them over once per frame with `update()`.
 class SoundManager
 {
     friend class Sound;
@@ -56,6 +66,7 @@ public:
     SoundPtr createSound(Ogre::String filename, Ogre::String resource_group_name = "");
 
     void setCamera(Ogre::Vector3 position, Ogre::Vector3 direction, Ogre::Vector3 up, Ogre::Vector3 velocity);
+    void update(); //!< Once per frame: reads ahead the streams and wakes up the audio thread.
     void pauseAllSounds();
     void resumeAllSounds();
     void setMasterVolume(float v);
@@ -69,18 +80,51 @@ public:
     static const float REFERENCE_DISTANCE;
     static const unsigned int MAX_HARDWARE_SOURCES = 32;
     static const unsigned int MAX_AUDIO_BUFFERS = 8192;
+    static const size_t STREAMING_MIN_BYTES = 1024 * 1024; //!< WAV files with more samples than this are streamed rather than loaded whole
 
 private:
-    void recomputeAllSources();
+    struct ListenerState
+    {
+        Ogre::Vector3 position = Ogre::Vector3::ZERO;
+        Ogre::Vector3 direction = Ogre::Vector3::NEGATIVE_UNIT_Z;
+        Ogre::Vector3 up = Ogre::Vector3::UNIT_Y;
+        Ogre::Vector3 velocity = Ogre::Vector3::ZERO;
+    };
+
+    // audio thread
+    void audioThreadMain();
+    void updateAudio(std::vector<std::pair<int, int>> const& changes, float dt); //!< Applies the changes and gives out the hardware sources.
+    void recomputeAllSources(float dt); //!< Gives the hardware sources to the most audible sounds; the rest play virtually.
     void recomputeSource(int source_index, int reason, float vfl, Ogre::Vector3 *vvec);
     ALuint getHardwareSource(int hardware_index) { return hardware_sources[hardware_index]; };
 
     void assign(int source_index, int hardware_index);
     void retire(int source_index);
 
-    bool loadWAVFile(Ogre::String filename, ALuint buffer, Ogre::String resource_group_name = "");
-
-    // active audio sources (hardware sources)
+    void startStream(Sound& sound);                    //!< Asks the game thread for samples from `playback_offset`
+    void stopStream(Sound& sound, ALuint hw_source);
+    void updateStream(Sound& sound, ALuint hw_source); //!< Queues the samples read so far, refilling the buffers which finished playing
+
+    // game thread
+    void readStreams(); //!< Reads ahead the streams which have a hardware source
+
+    /// @param stream_out If given and the file is long, it's set up for streaming and `buffer` is left empty.
+    bool loadWAVFile(Ogre::String filename, ALuint buffer, Ogre::String resource_group_name = "", SoundStream* stream_out = nullptr);
+
+    // requests for the audio thread
+    std::mutex              queue_mutex;              //!< Guards the requests, `Sound` settings and `SoundStream` read-ahead
+    std::condition_variable queue_cv;
+    std::vector<int>        changed_sounds;           //!< Sounds with `Sound::requested_changes`
+    ListenerState           requested_listener;
+    bool                    listener_changed = false;
+    float                   requested_listener_gain = 1.0f;
+    bool                    listener_gain_changed = false;
+    float                   requested_master_volume = 1.0f;
+    bool                    frame_requested = false;
+    bool                    exit_requested = false;
+    std::thread             audio_thread;
+
+    // active audio sources (hardware sources); audio thread only
     int    hardware_sources_num = 0;                       // total number of available hardware sources < MAX_HARDWARE_SOURCES
     int    hardware_sources_in_use_count = 0;
     int    hardware_sources_map[MAX_HARDWARE_SOURCES]; // stores the hardware index for each source. -1 = unmapped
@@ -88,15 +132,21 @@ private:
 
     // audio sources
     SoundPtr audio_sources[MAX_AUDIO_BUFFERS];
+    int      audio_sources_count = 0; //!< Known to the audio thread; `audio_buffers_in_use_count` as of its last update
     // helper for calculating the most audible sources
     std::pair<int, float> audio_sources_most_audible[MAX_AUDIO_BUFFERS];
-    
-    // audio buffers: Array of AL buffers and filenames
+    bool     audio_sources_playing[MAX_AUDIO_BUFFERS]; //!< Queried from OpenAL outside the lock, then published to `Sound::playing`
+    std::vector<SoundStream::Chunk> stream_chunks; //!< Samples on their way from a `SoundStream` to OpenAL
+
+    // audio buffers: Array of AL buffers and filenames; game thread, the count is published under `queue_mutex`
     int          audio_buffers_in_use_count = 0;
     ALuint       audio_buffers[MAX_AUDIO_BUFFERS];
     Ogre::String audio_buffer_file_name[MAX_AUDIO_BUFFERS];
+    std::unordered_map<Ogre::String, ALuint> audio_buffer_index; //!< Loaded files, shared by all sounds using them
+    std::vector<int> streamed_sounds;
 
-    Ogre::Vector3 camera_position = Ogre::Vector3::ZERO;
+    Ogre::Vector3 camera_position = Ogre::Vector3::ZERO; //!< audio thread
+    float         master_volume = 1.0f;                  //!< audio thread
     ALCdevice*    audio_device = nullptr;
     ALCcontext*   sound_context = nullptr;
 };
@@ -38,14 +38,14 @@ const float SoundScriptInstance::PITCHDOWN_CUTOFF_FACTOR = 5.0f;
 
 const SoundPtr SoundScriptInstance::SOUNDPTR_NULL; // Dummy value to be returned as const reference.
 
-SoundScriptManager::SoundScriptManager() :
+SoundScriptManager::SoundScriptManager(SoundManager* prepared_sound_manager) :
     disabled(true)
     , loading_base(false)
     , instance_counter(0)
     , max_distance(500.0f)
     , rolloff_factor(1.0f)
     , reference_distance(7.5f)
-    , sound_manager(nullptr)
+    , sound_manager(prepared_sound_manager)
 {
     for (int i = 0; i < SS_MAX_TRIG; i++)
     {
@@ -58,23 +58,11 @@ SoundScriptManager::SoundScriptManager() :
         free_gains[i] = 0;
     }
 
-    // TODO: there is a memory corruption going on here, need to fix
-    for (int i = 0; i < SS_MAX_TRIG * MAX_INSTANCES_PER_GROUP; i++)
-    {
-        trigs[i] = 0;
-    }
-
-    for (int i = 0; i < SS_MAX_MOD * MAX_INSTANCES_PER_GROUP; i++)
+    if (!sound_manager)
     {
-        pitches[i] = 0;
-        gains[i] = 0;
+        sound_manager = new SoundManager();
     }
 
-    // reset all states
-    state_map.clear();
-
-    sound_manager = new SoundManager();
-
     if (!sound_manager)
     {
         LOG("SoundScriptManager: Failed to create the Sound Manager");
@@ -116,12 +104,9 @@ void SoundScriptManager::trigOnce(int actor_id, int trig, int linkType, int link
     if (disabled)
         return;
 
-    for (int i = 0; i < free_trigs[trig]; i++)
+    if (const auto* found = findInstances(trig_index, { actor_id, linkType, linkItemID, trig }))
     {
-        // cycle through all instance groups
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        for (const SoundScriptInstancePtr& inst : *found)
         {
             inst->runOnce();
         }
@@ -146,13 +131,11 @@ void SoundScriptManager::trigStart(int actor_id, int trig, int linkType, int lin
     if (getTrigState(actor_id, trig, linkType, linkItemID))
         return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = true;
+    trig_states.insert({ actor_id, linkType, linkItemID, trig });
 
-    for (int i = 0; i < free_trigs[trig]; i++)
+    if (const auto* found = findInstances(trig_index, { actor_id, linkType, linkItemID, trig }))
     {
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        for (const SoundScriptInstancePtr& inst : *found)
         {
             inst->start();
         }
@@ -177,12 +160,10 @@ void SoundScriptManager::trigStop(int actor_id, int trig, int linkType, int link
     if (!getTrigState(actor_id, trig, linkType, linkItemID))
         return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
+    trig_states.erase({ actor_id, linkType, linkItemID, trig });
+    if (const auto* found = findInstances(trig_index, { actor_id, linkType, linkItemID, trig }))
     {
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        for (const SoundScriptInstancePtr& inst : *found)
         {
             inst->stop();
         }
@@ -207,12 +188,10 @@ void SoundScriptManager::trigKill(int actor_id, int trig, int linkType, int link
     if (!getTrigState(actor_id, trig, linkType, linkItemID))
         return;
 
-    state_map[linkType][linkItemID][actor_id][trig] = false;
-    for (int i = 0; i < free_trigs[trig]; i++)
+    trig_states.erase({ actor_id, linkType, linkItemID, trig });
+    if (const auto* found = findInstances(trig_index, { actor_id, linkType, linkItemID, trig }))
     {
-        const SoundScriptInstancePtr& inst = trigs[trig + i * SS_MAX_TRIG];
-
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        for (const SoundScriptInstancePtr& inst : *found)
         {
             inst->kill();
         }
@@ -257,7 +236,7 @@ bool SoundScriptManager::getTrigState(int actor_id, int trig, int linkType, int
     if (disabled)
         return false;
 
-    return state_map[linkType][linkItemID][actor_id][trig];
+    return trig_states.count({ actor_id, linkType, linkItemID, trig }) != 0;
 }
 
 void SoundScriptManager::modulate(const ActorPtr& actor, int mod, float value, int linkType, int linkItemID)
@@ -279,34 +258,64 @@ void SoundScriptManager::modulate(int actor_id, int mod, float value, int linkTy
     if (mod >= SS_MAX_MOD)
         return;
 
-    for (int i = 0; i < free_gains[mod]; i++)
+    // Called every physics step; only the last value before the frame ends gets to the sounds, see `update()`
+    if (const auto* found = findInstances(gain_index, { actor_id, linkType, linkItemID, mod }))
     {
-        const SoundScriptInstancePtr& inst = gains[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        for (const SoundScriptInstancePtr& inst : *found)
         {
             // this one requires modulation
             float gain = value * value * inst->templ->gain_square + value * inst->templ->gain_multiplier + inst->templ->gain_offset;
             gain = std::max(0.0f, gain);
             gain = std::min(gain, 1.0f);
-            inst->setGain(gain);
+            inst->pending_gain = gain;
+            inst->has_pending_gain = true;
         }
     }
 
-    for (int i = 0; i < free_pitches[mod]; i++)
+    if (const auto* found = findInstances(pitch_index, { actor_id, linkType, linkItemID, mod }))
     {
-        const SoundScriptInstancePtr& inst = pitches[mod + i * SS_MAX_MOD];
-        if (inst && inst->actor_id == actor_id && inst->sound_link_type == linkType && inst->sound_link_item_id == linkItemID)
+        for (const SoundScriptInstancePtr& inst : *found)
         {
             // this one requires modulation
             float pitch = value * value * inst->templ->pitch_square + value * inst->templ->pitch_multiplier + inst->templ->pitch_offset;
             pitch = std::max(0.0f, pitch);
-            inst->setPitch(pitch);
+            inst->pending_pitch = pitch;
+            inst->has_pending_pitch = true;
         }
     }
 }
 
+const std::vector<SoundScriptInstancePtr>* SoundScriptManager::findInstances(DispatchIndex const& index, DispatchKey const& key)
+{
+    auto found = index.find(key);
+    return (found != index.end()) ? &found->second : nullptr;
+}
+
+bool SoundScriptManager::removeFromIndex(DispatchIndex& index, DispatchKey const& key, const SoundScriptInstancePtr& ssi)
+{
+    auto found = index.find(key);
+    if (found == index.end())
+    {
+        return false;
+    }
+
+    const size_t prev_size = found->second.size();
+    EraseIf(found->second, [ssi](const SoundScriptInstancePtr& instance) { return ssi == instance; });
+    const bool removed = found->second.size() != prev_size;
+    if (found->second.empty())
+    {
+        index.erase(found);
+    }
+    return removed;
+}
+
 void SoundScriptManager::update(float dt_sec)
 {
+    for (const SoundScriptInstancePtr& inst : instances)
+    {
+        inst->applyPendingModulation();
+    }
+
     if (App::sim_state->getEnum<SimState>() == SimState::RUNNING ||
         App::sim_state->getEnum<SimState>() == SimState::EDITOR_MODE)
     {
@@ -319,6 +328,11 @@ void SoundScriptManager::update(float dt_sec)
         Ogre::Vector3 cameraDir = App::GetCameraManager()->GetCameraNode()->getOrientation() * -Ogre::Vector3::UNIT_Z;
         this->setCamera(App::GetCameraManager()->GetCameraNode()->getPosition(), cameraDir, upVector, cameraSpeed);
     }
+
+    if (!disabled)
+    {
+        sound_manager->update();
+    }
 }
 
 void SoundScriptManager::setCamera(Vector3 position, Vector3 direction, Vector3 up, Vector3 velocity)
@@ -383,17 +397,17 @@ SoundScriptInstancePtr SoundScriptManager::createInstance(Ogre::String templaten
     instance_counter++;
 
     // register to lookup tables
-    trigs[templ->trigger_source + free_trigs[templ->trigger_source] * SS_MAX_TRIG] = inst;
+    trig_index[{ actor_id, soundLinkType, soundLinkItemId, templ->trigger_source }].push_back(inst);
     free_trigs[templ->trigger_source]++;
 
     if (templ->gain_source != SS_MOD_NONE)
     {
-        gains[templ->gain_source + free_gains[templ->gain_source] * SS_MAX_MOD] = inst;
+        gain_index[{ actor_id, soundLinkType, soundLinkItemId, templ->gain_source }].push_back(inst);
         free_gains[templ->gain_source]++;
     }
     if (templ->pitch_source != SS_MOD_NONE)
     {
-        pitches[templ->pitch_source + free_pitches[templ->pitch_source] * SS_MAX_MOD] = inst;
+        pitch_index[{ actor_id, soundLinkType, soundLinkItemId, templ->pitch_source }].push_back(inst);
         free_pitches[templ->pitch_source]++;
     }
 
@@ -408,62 +422,19 @@ SoundScriptInstancePtr SoundScriptManager::createInstance(Ogre::String templaten
 
 void SoundScriptManager::removeInstance(const SoundScriptInstancePtr& ssi)
 {
-    // Find lookup table entries
-    int trigsPos = -1;
-    for (int i = 0; i < free_trigs[ssi->templ->trigger_source]; i++)
-    {
-        if (trigs[ssi->templ->trigger_source + i * SS_MAX_TRIG] == ssi)
-        {
-            trigsPos = i;
-        }
-    }
-
-    int gainsPos = -1;
-    for (int i = 0; i < free_gains[ssi->templ->gain_source]; i++)
-    {
-        if (gains[ssi->templ->gain_source + i * SS_MAX_MOD] == ssi)
-        {
-            gainsPos = i;
-        }
-    }
-
-    int pitchesPos = -1;
-    for (int i = 0; i < free_gains[ssi->templ->pitch_source]; i++)
-    {
-        if (pitches[ssi->templ->pitch_source + i * SS_MAX_MOD] == ssi)
-        {
-            pitchesPos = i;
-        }
-    }
-
     // Erase lookup entries
-    if (trigsPos != -1)
+    if (removeFromIndex(trig_index, { ssi->actor_id, ssi->sound_link_type, ssi->sound_link_item_id, ssi->templ->trigger_source }, ssi))
     {
-        for (int i = trigsPos + 1; i < free_trigs[ssi->templ->trigger_source]; i++)
-        {
-            trigs[ssi->templ->trigger_source + (i - 1) * SS_MAX_TRIG]
-                = trigs[ssi->templ->trigger_source + i * SS_MAX_TRIG];
-        }
         free_trigs[ssi->templ->trigger_source]--;
     }
-
-    if (gainsPos != -1)
+    if (ssi->templ->gain_source != SS_MOD_NONE &&
+        removeFromIndex(gain_index, { ssi->actor_id, ssi->sound_link_type, ssi->sound_link_item_id, ssi->templ->gain_source }, ssi))
     {
-        for (int i = gainsPos + 1; i < free_gains[ssi->templ->gain_source]; i++)
-        {
-            gains[ssi->templ->gain_source + (i - 1) * SS_MAX_MOD]
-                = gains[ssi->templ->gain_source + i * SS_MAX_MOD];
-        }
         free_gains[ssi->templ->gain_source]--;
     }
-
-    if (pitchesPos != -1)
+    if (ssi->templ->pitch_source != SS_MOD_NONE &&
+        removeFromIndex(pitch_index, { ssi->actor_id, ssi->sound_link_type, ssi->sound_link_item_id, ssi->templ->pitch_source }, ssi))
     {
-        for (int i = pitchesPos + 1; i < free_pitches[ssi->templ->pitch_source]; i++)
-        {
-            pitches[ssi->templ->pitch_source + (i - 1) * SS_MAX_MOD]
-                = pitches[ssi->templ->pitch_source + i * SS_MAX_MOD];
-        }
         free_pitches[ssi->templ->pitch_source]--;
     }
 
@@ -1102,6 +1073,10 @@ SoundScriptInstance::SoundScriptInstance(int actor_id, SoundScriptTemplatePtr te
     , stop_sound(NULL)
     , stop_sound_pitchgain(0.0f)
     , lastgain(1.0f)
+    , pending_gain(0.0f)
+    , pending_pitch(0.0f)
+    , has_pending_gain(false)
+    , has_pending_pitch(false)
 {
     // create sounds
     if (templ->has_start_sound)
@@ -1349,8 +1324,24 @@ void SoundScriptInstance::setVelocity(Vector3 velocity)
     }
 }
 
+void SoundScriptInstance::applyPendingModulation()
+{
+    if (has_pending_gain)
+    {
+        has_pending_gain = false;
+        this->setGain(pending_gain);
+    }
+    if (has_pending_pitch)
+    {
+        has_pending_pitch = false;
+        this->setPitch(pending_pitch);
+    }
+}
+
 void SoundScriptInstance::runOnce()
 {
+    this->applyPendingModulation(); // i.e. beam break volume, modulated right before
+
     if (start_sound)
     {
         if (start_sound->isPlaying())
@@ -1385,6 +1376,8 @@ void SoundScriptInstance::runOnce()
 
 void SoundScriptInstance::start()
 {
+    this->applyPendingModulation();
+
     if (start_sound)
     {
         start_sound->stop();
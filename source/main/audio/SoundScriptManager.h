@@ -32,6 +32,9 @@
 
 #include <OgreScriptLoader.h>
 
+#include <unordered_map>
+#include <unordered_set>
+
 #define SOUND_PLAY_ONCE(_ACTOR_, _TRIG_)        App::GetSoundScriptManager()->trigOnce    ( (_ACTOR_), (_TRIG_) )
 #define SOUND_START(_ACTOR_, _TRIG_)            App::GetSoundScriptManager()->trigStart   ( (_ACTOR_), (_TRIG_) )
 #define SOUND_STOP(_ACTOR_, _TRIG_)             App::GetSoundScriptManager()->trigStop    ( (_ACTOR_), (_TRIG_) )
@@ -254,6 +257,7 @@ public:
     void start();
     void stop();
     void kill();
+    void applyPendingModulation(); //!< Applies the last values passed to `SoundScriptManager::modulate()`; done once per frame.
 
     SoundScriptTemplatePtr getTemplate() { return templ; }
     const SoundPtr& getStartSound() { return start_sound; }
@@ -285,6 +289,10 @@ private:
     float stop_sound_pitchgain;
     float sounds_pitchgain[MAX_SOUNDS_PER_SCRIPT];
     float lastgain;
+    float pending_gain;     // queued by `SoundScriptManager::modulate()`, see `applyPendingModulation()`
+    float pending_pitch;
+    bool  has_pending_gain;
+    bool  has_pending_pitch;
 
     int actor_id;           // ID of the actor this sound belongs to, or an `ACTOR_ID_*` constant.
     int sound_link_type;    // holds the SL_ type this is bound to
@@ -295,7 +303,7 @@ class SoundScriptManager : public Ogre::ScriptLoader
 {
 public:
 
-    SoundScriptManager();
+    SoundScriptManager(SoundManager* sound_manager = nullptr); //!< Takes ownership of `sound_manager`; creates one if null.
     ~SoundScriptManager();
 
     // ScriptLoader interface
@@ -338,6 +346,30 @@ public:
 
 private:
 
+    /// Instances are looked up by everything the trigger/modulation functions match on.
+    struct DispatchKey
+    {
+        int actor_id;
+        int link_type;
+        int link_item_id;
+        int source;       //!< SS_TRIG_* or SS_MOD_*
+        bool operator==(DispatchKey const& other) const
+        {
+            return actor_id == other.actor_id && link_type == other.link_type && link_item_id == other.link_item_id && source == other.source;
+        }
+    };
+    struct DispatchKeyHash
+    {
+        size_t operator()(DispatchKey const& k) const
+        {
+            return std::hash<int>()(k.actor_id) ^ (std::hash<int>()(k.link_item_id) * 31) ^ (size_t)((k.source << 4) | k.link_type) * 1000003;
+        }
+    };
+    typedef std::unordered_map<DispatchKey, std::vector<SoundScriptInstancePtr>, DispatchKeyHash> DispatchIndex;
+
+    static const std::vector<SoundScriptInstancePtr>* findInstances(DispatchIndex const& index, DispatchKey const& key);
+    static bool removeFromIndex(DispatchIndex& index, DispatchKey const& key, const SoundScriptInstancePtr& ssi);
+
     SoundScriptTemplatePtr createTemplate(Ogre::String name, Ogre::String groupname, Ogre::String filename);
     void skipToNextCloseBrace(Ogre::DataStreamPtr& chunk);
     void skipToNextOpenBrace(Ogre::DataStreamPtr& chunk);
@@ -353,19 +385,18 @@ private:
     std::map <Ogre::String, SoundScriptTemplatePtr> templates;
     std::vector<SoundScriptInstancePtr> instances;
 
-    // instances lookup tables - using `std::array<>` because it does bounds checking under VisualStudio/Debug.
+    // instance counts per trigger/modulation source - using `std::array<>` because it does bounds checking under VisualStudio/Debug.
     std::array<int, SS_MAX_TRIG> free_trigs;
-    std::array<SoundScriptInstancePtr, SS_MAX_TRIG* MAX_INSTANCES_PER_GROUP> trigs;
-
     std::array<int, SS_MAX_MOD> free_pitches;
-    std::array<SoundScriptInstancePtr, SS_MAX_MOD* MAX_INSTANCES_PER_GROUP> pitches;
-    
     std::array<int, SS_MAX_MOD> free_gains;
-    std::array<SoundScriptInstancePtr, SS_MAX_MOD* MAX_INSTANCES_PER_GROUP> gains;
 
-    // state map
-    // soundLinks, soundItems, actor_ids, triggers
-    std::map <int, std::map <int, std::map <int, std::map <int, bool > > > > state_map;
+    // instances lookup tables; only modified when instances are created/removed, so lookups from physics are read-only
+    DispatchIndex trig_index;
+    DispatchIndex gain_index;
+    DispatchIndex pitch_index;
+
+    // started triggers (source = SS_TRIG_*)
+    std::unordered_set<DispatchKey, DispatchKeyHash> trig_states;
 
     SoundManager* sound_manager;
 };
@@ -682,24 +682,39 @@ void RoR::GfxCharacter::UpdateCharacterInScene()
     }
     else if (xc_simbuf.simbuf_anim_name != "") // Just do nothing if animation name is empty. May happen during networked play.
     {
-        auto* as_cur = entity->getAnimationState(xc_simbuf.simbuf_anim_name);
-        as_cur->setTimePosition(xc_simbuf.simbuf_anim_time);
+        // Distant remote characters animate at a quarter rate; an unchanged
+        // animation state also lets OGRE skip re-skinning the mesh.
+        bool update_anim = true;
+        if (xc_simbuf.simbuf_is_remote)
+        {
+            const float cam_dist_sq = xc_scenenode->getPosition().squaredDistance(App::GetCameraManager()->GetCameraNode()->getPosition());
+            update_anim = (cam_dist_sq < 100.f * 100.f) || (xc_anim_frame_counter++ % 4 == 0);
+        }
+        if (update_anim)
+        {
+            auto* as_cur = entity->getAnimationState(xc_simbuf.simbuf_anim_name);
+            as_cur->setTimePosition(xc_simbuf.simbuf_anim_time);
+        }
     }
 
     // Multiplayer label
 #ifdef USE_SOCKETW
     if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED && !xc_simbuf.simbuf_actor_coupling)
     {
-        // From 'updateCharacterNetworkColor()'
-        const String materialName = "tracks/" + xc_instance_name;
-
-        MaterialPtr mat = MaterialManager::getSingleton().getByName(materialName);
-        if (!mat.isNull() && mat->getNumTechniques() > 0 && mat->getTechnique(0)->getNumPasses() > 1 &&
-                mat->getTechnique(0)->getPass(1)->getNumTextureUnitStates() > 1)
+        // From 'updateCharacterNetworkColor()' - only when the color changed
+        if (xc_simbuf.simbuf_color_number != xc_applied_color_number)
         {
-            const auto& state = mat->getTechnique(0)->getPass(1)->getTextureUnitState(1);
-            Ogre::ColourValue color = App::GetNetwork()->GetPlayerColor(xc_simbuf.simbuf_color_number);
-            state->setColourOperationEx(LBX_BLEND_CURRENT_ALPHA, LBS_MANUAL, LBS_CURRENT, color);
+            const String materialName = "tracks/" + xc_instance_name;
+
+            MaterialPtr mat = MaterialManager::getSingleton().getByName(materialName);
+            if (!mat.isNull() && mat->getNumTechniques() > 0 && mat->getTechnique(0)->getNumPasses() > 1 &&
+                    mat->getTechnique(0)->getPass(1)->getNumTextureUnitStates() > 1)
+            {
+                const auto& state = mat->getTechnique(0)->getPass(1)->getTextureUnitState(1);
+                Ogre::ColourValue color = App::GetNetwork()->GetPlayerColor(xc_simbuf.simbuf_color_number);
+                state->setColourOperationEx(LBX_BLEND_CURRENT_ALPHA, LBS_MANUAL, LBS_CURRENT, color);
+            }
+            xc_applied_color_number = xc_simbuf.simbuf_color_number;
         }
 
         if ((!xc_simbuf.simbuf_is_remote && !App::mp_hide_own_net_label->getBool()) ||
@@ -709,7 +724,7 @@ void RoR::GfxCharacter::UpdateCharacterInScene()
             Ogre::Vector3 scene_pos = xc_scenenode->getPosition();
             scene_pos.y += (1.9f + camDist / 100.0f);
 
-            App::GetGfxScene()->DrawNetLabel(scene_pos, camDist, xc_simbuf.simbuf_net_username, xc_simbuf.simbuf_color_number);
+            App::GetGfxScene()->DrawNetLabel(xc_net_label, scene_pos, camDist, xc_simbuf.simbuf_net_username, xc_simbuf.simbuf_color_number);
         }
     }
 #endif // USE_SOCKETW
@@ -46,6 +46,7 @@ public:
     ~Character();
        
     int            getSourceID() const                  { return m_source_id; }
+    int            getStreamID() const                  { return m_stream_id; }
     bool           isRemote() const                     { return m_is_remote; }
     int            GetColorNum() const                  { return m_color_number; }
     bool           GetIsRemote() const                  { return m_is_remote; }
@@ -122,6 +123,9 @@ struct GfxCharacter
     Character*                xc_character;
     std::string               xc_instance_name; // TODO: Store MaterialPtr-s directly ~only_a_ptr, 05/2018
     SurveyMapEntity           xc_surveymap_entity;
+    int                       xc_applied_color_number = -2; //!< Net color last written to the material; -2 = none yet
+    int                       xc_anim_frame_counter = 0;    //!< Throttles animation updates of distant remote characters
+    NetLabelCache             xc_net_label;
 };
 
 } // namespace RoR
@@ -26,6 +26,8 @@
 #include "GfxScene.h"
 #include "Utils.h"
 
+#include <algorithm>
+
 using namespace RoR;
 
 Character* CharacterFactory::CreateLocalCharacter()
@@ -69,6 +71,11 @@ void CharacterFactory::removeStreamSource(int sourceid)
     {
         if ((*it)->getSourceID() == sourceid)
         {
+#ifdef USE_SOCKETW
+            Character* character = it->get();
+            m_pending_positions.erase(std::remove_if(m_pending_positions.begin(), m_pending_positions.end(),
+                [character](PendingPosition const& p) { return p.first == character; }), m_pending_positions.end());
+#endif // USE_SOCKETW
             (*it).reset();
             m_remote_characters.erase(it);
             return;
@@ -104,10 +111,11 @@ void CharacterFactory::DeleteAllCharacters()
 }
 
 #ifdef USE_SOCKETW
-void CharacterFactory::handleStreamData(std::vector<RoR::NetRecvPacket> packet_buffer)
+void CharacterFactory::handleStreamData(std::vector<RoR::NetRecvPacket*> const& packet_buffer)
 {
-    for (auto packet : packet_buffer)
+    for (RoR::NetRecvPacket* packet_view : packet_buffer)
     {
+        RoR::NetRecvPacket& packet = *packet_view;
         if (packet.header.command == RoRnet::MSG2_STREAM_REGISTER)
         {
             RoRnet::StreamRegister* reg = (RoRnet::StreamRegister *)packet.buffer;
@@ -120,13 +128,50 @@ void CharacterFactory::handleStreamData(std::vector<RoR::NetRecvPacket> packet_b
         {
             removeStreamSource(packet.header.source);
         }
-        else
+        else if (packet.header.command == RoRnet::MSG2_STREAM_DATA)
         {
+            Character* character = nullptr;
             for (auto& c : m_remote_characters)
             {
-                c->receiveStreamData(packet.header.command, packet.header.source, packet.header.streamid, packet.buffer);
+                if (c->getSourceID() == packet.header.source && c->getStreamID() == (int)packet.header.streamid)
+                {
+                    character = c.get();
+                    break;
+                }
             }
+            if (character == nullptr)
+            {
+                continue;
+            }
+
+            // Only the newest position update of each character matters - keep it for later.
+            // Other commands flush the pending position first to preserve ordering.
+            auto pending = std::find_if(m_pending_positions.begin(), m_pending_positions.end(),
+                [character](PendingPosition const& p) { return p.first == character; });
+            auto* msg = reinterpret_cast<NetCharacterMsgGeneric*>(packet.buffer);
+            if (msg->command == CHARACTER_CMD_POSITION)
+            {
+                if (pending != m_pending_positions.end())
+                    pending->second = packet_view;
+                else
+                    m_pending_positions.push_back(std::make_pair(character, packet_view));
+                continue;
+            }
+            if (pending != m_pending_positions.end())
+            {
+                RoR::NetRecvPacket& pos_packet = *pending->second;
+                character->receiveStreamData(pos_packet.header.command, pos_packet.header.source, pos_packet.header.streamid, pos_packet.buffer);
+                m_pending_positions.erase(pending);
+            }
+            character->receiveStreamData(packet.header.command, packet.header.source, packet.header.streamid, packet.buffer);
         }
     }
+
+    for (PendingPosition& p : m_pending_positions)
+    {
+        RoR::NetRecvPacket& pos_packet = *p.second;
+        p.first->receiveStreamData(pos_packet.header.command, pos_packet.header.source, pos_packet.header.streamid, pos_packet.buffer);
+    }
+    m_pending_positions.clear();
 }
 #endif // USE_SOCKETW
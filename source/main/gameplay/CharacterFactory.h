@@ -46,7 +46,7 @@ public:
     void UndoRemoteActorCoupling(ActorPtr actor);
     void Update(float dt);
 #ifdef USE_SOCKETW
-    void handleStreamData(std::vector<RoR::NetRecvPacket> packet);
+    void handleStreamData(std::vector<RoR::NetRecvPacket*> const& packet);
 #endif // USE_SOCKETW
 
 private:
@@ -54,6 +54,11 @@ private:
     std::unique_ptr<Character>              m_local_character;
     std::vector<std::unique_ptr<Character>> m_remote_characters;
 
+#ifdef USE_SOCKETW
+    typedef std::pair<Character*, RoR::NetRecvPacket*> PendingPosition;
+    std::vector<PendingPosition>            m_pending_positions; //!< Newest position packet per character, within one handleStreamData() pass
+#endif // USE_SOCKETW
+
     void createRemoteInstance(int sourceid, int streamid);
     void removeStreamSource(int sourceid);
 };
@@ -61,11 +61,11 @@ void ReceiveStreamData(unsigned int type, int source, char* buffer)
 #endif // USE_SOCKETW
 
 #ifdef USE_SOCKETW
-void HandleStreamData(std::vector<RoR::NetRecvPacket> packet_buffer)
+void HandleStreamData(std::vector<RoR::NetRecvPacket*> const& packet_buffer)
 {
-    for (auto packet : packet_buffer)
+    for (RoR::NetRecvPacket* packet : packet_buffer)
     {
-        ReceiveStreamData(packet.header.command, packet.header.source, packet.buffer);
+        ReceiveStreamData(packet->header.command, packet->header.source, packet->buffer);
     }
 }
 #endif // USE_SOCKETW
@@ -28,45 +28,47 @@
 #include "GameContext.h"
 #include "Language.h"
 #include "Terrain.h"
-#ifdef USE_PAGED
-#include "PropertyMaps.h"
-#include "PagedGeometry.h"
-#endif
+
 #include <OgreConfigFile.h>
+#include <algorithm>
+#include <unordered_map>
 
 using namespace Ogre;
 using namespace RoR;
 
 Landusemap::Landusemap(String configFilename) :
-    data(0)
-    , default_ground_model(nullptr)
+    default_ground_model(nullptr)
     , mapsize(App::GetGameContext()->GetTerrain()->getMaxTerrainSize())
+    , size_x((int)mapsize.x)
+    , size_z((int)mapsize.z)
 {
     loadConfig(configFilename);
-#ifndef USE_PAGED
-    LOG("RoR was not compiled with PagedGeometry support. You cannot use Landuse maps with it.");
-#endif //USE_PAGED
 }
 
 Landusemap::~Landusemap()
 {
-    if (data != nullptr)
-        delete[] data;
 }
 
 ground_model_t* Landusemap::getGroundModelAt(int x, int z)
 {
-    if (!data)
+    if (data.empty())
         return nullptr;
-#ifdef USE_PAGED
+
     // we return the default ground model if we are not anymore in this map
-    if (x < 0 || x >= mapsize.x || z < 0 || z >= mapsize.z)
+    if (x < 0 || x >= size_x || z < 0 || z >= size_z)
         return default_ground_model;
 
-    return data[x + z * (int)mapsize.x];
-#else
-    return nullptr;
-#endif // USE_PAGED
+    return palette[data[x + z * size_x]];
+}
+
+void Landusemap::getGroundModelsAt(const Ogre::Vector3* positions, size_t count, size_t stride, ground_model_t** out_models)
+{
+    const char* cursor = reinterpret_cast<const char*>(positions);
+    for (size_t i = 0; i < count; i++, cursor += stride)
+    {
+        const Ogre::Vector3& pos = *reinterpret_cast<const Ogre::Vector3*>(cursor);
+        out_models[i] = this->getGroundModelAt((int)pos.x, (int)pos.z);
+    }
 }
 
 int Landusemap::loadConfig(const Ogre::String& filename)
@@ -137,49 +139,52 @@ int Landusemap::loadConfig(const Ogre::String& filename)
             }
         }
     }
-#ifdef USE_PAGED
     // process the config data and load the buffers finally
     try
     {
-        Forests::ColorMap* colourMap = Forests::ColorMap::load(textureFilename, Forests::CHANNEL_COLOR);
-        colourMap->setFilter(Forests::MAPFILTER_NONE);
-
-        /*
-        // debug things below
-        printf("found ground use definitions:\n");
-        for (std::map < uint32, String >::iterator it=usemap.begin(); it!=usemap.end(); it++)
-        {
-            printf(" 0x%Lx : %s\n", it->first, it->second.c_str());
-        }
-        */
-
-        bool bgr = colourMap->getPixelBox().format == PF_A8B8G8R8;
-
-        Ogre::TRect<Ogre::Real> bounds = Forests::TBounds(0, 0, mapsize.x, mapsize.z);
-
-        // now allocate the data buffer to hold pointers to ground models
-        data = new ground_model_t*[(int)(mapsize.x * mapsize.z)];
-        ground_model_t** ptr = data;
-        //std::map < String, int > counters;
-        for (int z = 0; z < mapsize.z; z++)
+        TexturePtr texture = TextureManager::getSingleton().load(textureFilename, ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+
+        // Colors as 0xAARRGGBB, like the keys in 'use-map'
+        const int image_width = (int)texture->getWidth();
+        const int image_height = (int)texture->getHeight();
+        std::vector<uint32_t> pixels(image_width * image_height);
+        texture->getBuffer()->blitToMemory(PixelBox(image_width, image_height, 1, PF_A8R8G8B8, pixels.data()));
+
+        // now allocate the data buffer to hold palette indices; each distinct color is resolved once
+        std::unordered_map<uint32_t, uint8_t> color_to_index;
+        data.resize(size_x * size_z);
+        uint8_t* ptr = data.data();
+        for (int z = 0; z < size_z; z++)
         {
-            for (int x = 0; x < mapsize.x; x++)
+            const int image_z = (int)((int64_t)image_height * z / size_z);
+            for (int x = 0; x < size_x; x++)
             {
-                unsigned int col = colourMap->getColorAt(x, z, bounds);
-                if (bgr)
+                const int image_x = (int)((int64_t)image_width * x / size_x);
+                const uint32_t col = pixels[image_x + image_z * image_width];
+                auto found = color_to_index.find(col);
+                if (found == color_to_index.end())
                 {
-                    // Swap red and blue values
-                    unsigned int cols = col & 0xFF00FF00;
-                    cols |= (col & 0xFF) << 16;
-                    cols |= (col & 0xFF0000) >> 16;
-                    col = cols;
+                    ground_model_t* gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString(usemap[col]);
+                    auto in_palette = std::find(palette.begin(), palette.end(), gm);
+                    if (in_palette == palette.end() && palette.size() == MAX_PALETTE_SIZE)
+                    {
+                        LOG(fmt::format("[RoR|Physics] Landuse: more than {} ground models, using the default for color 0x{:08x}", MAX_PALETTE_SIZE, col));
+                        in_palette = std::find(palette.begin(), palette.end(), default_ground_model);
+                        if (in_palette == palette.end())
+                        {
+                            in_palette = palette.begin();
+                        }
+                    }
+                    else if (in_palette == palette.end())
+                    {
+                        palette.push_back(gm);
+                        in_palette = palette.end() - 1;
+                    }
+                    found = color_to_index.insert(std::make_pair(col, (uint8_t)(in_palette - palette.begin()))).first;
                 }
-                String use = usemap[col];
-                //if (use!="")
-                //	counters[use]++;
 
-                // store the pointer to the ground model in the data slot
-                *ptr = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString(use);
+                // store the index of the ground model in the data slot
+                *ptr = found->second;
                 ptr++;
             }
         }
@@ -188,16 +193,18 @@ int Landusemap::loadConfig(const Ogre::String& filename)
     {
         LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', <Ogre::Exception> message: '%s'",
             textureFilename.c_str(), oex.getFullDescription().c_str());
+        data.clear();
     }
     catch (std::exception& stex)
     {
         LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', <std::exception> message: '%s'",
             textureFilename.c_str(), stex.what());
+        data.clear();
     }
     catch (...)
     {
         LogFormat("[RoR|Physics] Landuse: failed to load texture '%s', unknown error", textureFilename.c_str());
+        data.clear();
     }
-#endif // USE_PAGED
     return 0;
 }
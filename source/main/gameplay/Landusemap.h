@@ -25,6 +25,8 @@
 #include "Application.h"
 #include "SimData.h"
 
+#include <vector>
+
 namespace RoR {
 
 /// @addtogroup Terrain
@@ -38,14 +40,20 @@ public:
     ~Landusemap();
 
     ground_model_t* getGroundModelAt(int x, int z);
+    void getGroundModelsAt(const Ogre::Vector3* positions, size_t count, size_t stride, ground_model_t** out_models); //!< Batched `getGroundModelAt()`, e.g. for all nodes of an actor
     int loadConfig(const Ogre::String& filename);
 
 protected:
 
-    ground_model_t** data;
+    static const size_t MAX_PALETTE_SIZE = 256;
+
+    std::vector<uint8_t> data; //!< One index to `palette` per 1x1m cell, X-major rows; empty if the map failed to load
+    std::vector<ground_model_t*> palette;
     ground_model_t* default_ground_model;
 
     Ogre::Vector3 mapsize;
+    int size_x = 0;
+    int size_z = 0;
 };
 
 /// @} // addtogroup Terrain
@@ -27,11 +27,45 @@
 #include "GUIManager.h"
 #include "InputEngine.h"
 #include "Language.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+
 using namespace Ogre;
 using namespace RoR;
 
+static const size_t CHUNK_FRAMES   = 50;      // Frames per chunk; a seek decodes at most this many
+static const float  POS_QUANTUM    = 0.0001f; // m; 16 bits cover +-3.2m of movement per frame
+static const float  VEL_QUANTUM    = 0.001f;  // m/s
+static const uint8_t FRAME_KEY     = 0;
+static const uint8_t FRAME_DELTA   = 1;
+static const char     FILE_SIGNATURE[8] = { 'R', 'o', 'R', '-', 'R', 'P', 'L', 'Y' };
+static const uint32_t FILE_VERSION = 1;
+
+template <typename T> static void AppendValue(std::vector<uint8_t>& data, T const& value)
+{
+    const size_t pos = data.size();
+    data.resize(pos + sizeof(T));
+    std::memcpy(&data[pos], &value, sizeof(T));
+}
+
+template <typename T> static T ReadValue(const uint8_t*& ptr)
+{
+    T value;
+    std::memcpy(&value, ptr, sizeof(T));
+    ptr += sizeof(T);
+    return value;
+}
+
+static uint8_t PackBeam(bool broken, bool disabled)
+{
+    return (broken ? 1 : 0) | (disabled ? 2 : 0);
+}
+
 Replay::Replay(ActorPtr actor, int _numFrames)
 {
     m_actor = actor;
@@ -41,20 +75,12 @@ Replay::Replay(ActorPtr actor, int _numFrames)
 
     replayTimer = new Timer();
 
-    // DO NOT get memory here, get memory when we use it first time!
-    nodes = 0;
-    beams = 0;
-    times = 0;
-
     outOfMemory = false;
 
     const int numNodes = actor->ar_num_nodes;
     const int numBeams = actor->ar_num_beams;
-    unsigned long bsize = (numNodes * numFrames * sizeof(node_simple_t) + numBeams * numFrames * sizeof(beam_simple_t) + numFrames * sizeof(unsigned long)) / 1024.0f;
-    LOG("replay buffer size: " + TOSTRING(bsize) + " kB");
-
-    writeIndex = 0;
-    firstRun = 1;
+    unsigned long ksize = (numNodes * sizeof(node_simple_t) + numBeams) / 1024.0f;
+    LOG("replay keyframe size: " + TOSTRING(ksize) + " kB, one per " + TOSTRING(CHUNK_FRAMES) + " frames");
 
     int steps = App::sim_replay_stepping->getInt();
 
@@ -62,152 +88,263 @@ Replay::Replay(ActorPtr actor, int _numFrames)
         this->ar_replay_precision = 0.0f;
     else
         this->ar_replay_precision = 1.0f / ((float)steps);
-
-    // windowing
-    int width = 300;
-    int height = 60;
-    int x = (MyGUI::RenderManager::getInstance().getViewSize().width - width) / 2;
-    int y = 0;
 }
 
 Replay::~Replay()
 {
-    if (nodes)
-    {
-        free(nodes);
-        nodes = 0;
-        free(beams);
-        beams = 0;
-        free(times);
-        times = 0;
-    }
+    this->StopSpill();
+    this->StopPlayback();
     delete replayTimer;
 }
 
-void* Replay::getWriteBuffer(int type)
+size_t Replay::GetMemoryUsage() const
 {
-    if (outOfMemory)
-        return 0;
-    if (!nodes)
+    auto chunk_bytes = [](Chunk const& chunk)
     {
-        // get memory
-        nodes = (node_simple_t*)calloc(m_actor->ar_num_nodes * numFrames, sizeof(node_simple_t));
-        if (!nodes)
+        return chunk.data.capacity() + chunk.offsets.capacity() * sizeof(size_t) + chunk.times.capacity() * sizeof(unsigned long);
+    };
+
+    size_t bytes = chunk_bytes(m_play_chunk);
+    for (Chunk const& chunk: m_chunks)
+        bytes += chunk_bytes(chunk);
+    for (Chunk const& chunk: m_spill_pending)
+        bytes += chunk_bytes(chunk);
+    bytes += (m_enc_nodes.capacity() + m_dec_nodes.capacity()) * sizeof(node_simple_t);
+    bytes += (m_enc_beams.capacity() + m_dec_beams.capacity()) * sizeof(beam_simple_t);
+    bytes += m_play_chunk_pos.capacity() * sizeof(long);
+    return bytes;
+}
+
+unsigned long Replay::getLastReadTime()
+{
+    return curFrameTime;
+}
+
+void Replay::RecordFrame()
+{
+    const int num_nodes = m_actor->ar_num_nodes;
+    const int num_beams = m_actor->ar_num_beams;
+
+    if (m_chunks.empty() || m_chunks.back().offsets.size() == CHUNK_FRAMES)
+    {
+        if (m_spill_file && !m_chunks.empty())
         {
-            outOfMemory = true;
-            return 0;
+            m_spill_pending.push_back(m_chunks.back());
+            this->SpillPendingChunks(/*wait=*/false);
         }
-        beams = (beam_simple_t*)calloc(m_actor->ar_num_beams * numFrames, sizeof(beam_simple_t));
-        if (!beams)
+        m_chunks.push_back(Chunk());
+    }
+    Chunk& chunk = m_chunks.back();
+    const size_t record_start = chunk.data.size();
+    chunk.offsets.push_back(record_start);
+    chunk.times.push_back(replayTimer->getMicroseconds());
+
+    bool keyframe = chunk.offsets.size() == 1 || (int)m_enc_nodes.size() != num_nodes;
+    if (!keyframe)
+    {
+        // Delta frame: bitmask of moved nodes, their quantized changes, then the changed beams
+        AppendValue(chunk.data, FRAME_DELTA);
+        const size_t mask_start = chunk.data.size();
+        chunk.data.resize(mask_start + (num_nodes + 7) / 8, 0);
+        for (int i = 0; i < num_nodes && !keyframe; i++)
         {
-            free(nodes);
-            nodes = 0;
-            outOfMemory = true;
-            return 0;
+            const node_simple_t now = { m_actor->ar_nodes[i].AbsPosition, m_actor->ar_nodes[i].Velocity };
+            node_simple_t& ref = m_enc_nodes[i];
+            int q[6];
+            for (int k = 0; k < 3; k++)
+            {
+                q[k]     = (int)std::round((now.position[k] - ref.position[k]) / POS_QUANTUM);
+                q[k + 3] = (int)std::round((now.velocity[k] - ref.velocity[k]) / VEL_QUANTUM);
+            }
+            if (!q[0] && !q[1] && !q[2] && !q[3] && !q[4] && !q[5])
+                continue;
+
+            for (int k = 0; k < 6; k++)
+            {
+                if (q[k] < INT16_MIN || q[k] > INT16_MAX)
+                    keyframe = true; // Too fast to encode, e.g. a reset; store the whole frame
+            }
+            if (keyframe)
+                break;
+
+            chunk.data[mask_start + i / 8] |= (uint8_t)(1 << (i % 8));
+            for (int k = 0; k < 6; k++)
+            {
+                AppendValue(chunk.data, (int16_t)q[k]);
+            }
+            for (int k = 0; k < 3; k++)
+            {
+                ref.position[k] += q[k] * POS_QUANTUM;
+                ref.velocity[k] += q[k + 3] * VEL_QUANTUM;
+            }
         }
-        times = (unsigned long*)calloc(numFrames, sizeof(unsigned long));
-        if (!times)
+
+        if (!keyframe)
         {
-            free(nodes);
-            nodes = 0;
-            free(beams);
-            beams = 0;
-            outOfMemory = true;
-            return 0;
+            const size_t count_pos = chunk.data.size();
+            AppendValue(chunk.data, (uint32_t)0);
+            uint32_t num_changes = 0;
+            for (int i = 0; i < num_beams; i++)
+            {
+                const beam_simple_t now = { m_actor->ar_beams[i].bm_broken, m_actor->ar_beams[i].bm_disabled };
+                if (now.broken != m_enc_beams[i].broken || now.disabled != m_enc_beams[i].disabled)
+                {
+                    AppendValue(chunk.data, (uint32_t)i);
+                    AppendValue(chunk.data, PackBeam(now.broken, now.disabled));
+                    m_enc_beams[i] = now;
+                    num_changes++;
+                }
+            }
+            std::memcpy(&chunk.data[count_pos], &num_changes, sizeof(uint32_t));
+        }
+        else
+        {
+            chunk.data.resize(record_start); // Half-written delta; `m_enc_nodes` is rewritten below
         }
     }
-    void* ptr = 0;
-    times[writeIndex] = replayTimer->getMicroseconds();
-    if (type == 0)
+
+    if (keyframe)
     {
-        // nodes
-        ptr = (void *)(nodes + (writeIndex * m_actor->ar_num_nodes));
+        m_enc_nodes.resize(num_nodes);
+        m_enc_beams.resize(num_beams);
+        AppendValue(chunk.data, FRAME_KEY);
+        for (int i = 0; i < num_nodes; i++)
+        {
+            m_enc_nodes[i].position = m_actor->ar_nodes[i].AbsPosition;
+            m_enc_nodes[i].velocity = m_actor->ar_nodes[i].Velocity;
+            AppendValue(chunk.data, m_enc_nodes[i]);
+        }
+        for (int i = 0; i < num_beams; i++)
+        {
+            m_enc_beams[i].broken = m_actor->ar_beams[i].bm_broken;
+            m_enc_beams[i].disabled = m_actor->ar_beams[i].bm_disabled;
+            AppendValue(chunk.data, PackBeam(m_enc_beams[i].broken, m_enc_beams[i].disabled));
+        }
     }
-    else if (type == 1)
+    m_next_frame++;
+
+    // Drop the oldest chunk once the others cover the replay length
+    while (m_chunks.size() > 1 && m_next_frame - m_first_frame - (int64_t)m_chunks.front().offsets.size() >= numFrames)
     {
-        // beams
-        ptr = (void *)(beams + (writeIndex * m_actor->ar_num_beams));
+        m_first_frame += m_chunks.front().offsets.size();
+        m_chunks.pop_front();
+        if (m_dec_frame < m_first_frame)
+            m_dec_frame = -1;
     }
-    return ptr;
 }
 
-void Replay::writeDone()
+Replay::Chunk const* Replay::GetChunk(size_t index)
 {
-    if (outOfMemory)
-        return;
-    writeIndex++;
-    if (writeIndex == numFrames)
+    if (!m_play_file)
+        return &m_chunks[index];
+
+    if (m_play_chunk_index != index)
     {
-        firstRun = 0;
-        writeIndex = 0;
+        m_play_chunk_index = SIZE_MAX;
+        uint32_t num_frames = 0;
+        uint64_t data_size = 0;
+        fseek(m_play_file, m_play_chunk_pos[index], SEEK_SET);
+        if (fread(&num_frames, sizeof(num_frames), 1, m_play_file) != 1 ||
+            fread(&data_size, sizeof(data_size), 1, m_play_file) != 1)
+        {
+            return nullptr;
+        }
+        std::vector<uint64_t> times(num_frames), offsets(num_frames);
+        m_play_chunk.data.resize((size_t)data_size);
+        if (fread(times.data(), sizeof(uint64_t), num_frames, m_play_file) != num_frames ||
+            fread(offsets.data(), sizeof(uint64_t), num_frames, m_play_file) != num_frames ||
+            fread(m_play_chunk.data.data(), 1, (size_t)data_size, m_play_file) != data_size)
+        {
+            return nullptr;
+        }
+        m_play_chunk.times.assign(times.begin(), times.end());
+        m_play_chunk.offsets.assign(offsets.begin(), offsets.end());
+        m_play_chunk_index = index;
     }
+    return &m_play_chunk;
 }
 
-//we take negative offsets only
-void* Replay::getReadBuffer(int offset, int type, unsigned long& time)
+bool Replay::SeekFrame(int64_t frame)
 {
-    if (offset >= 0)
-        offset = -1;
-    if (offset <= -numFrames)
-        offset = -numFrames + 1;
-
-    int delta = writeIndex + offset;
-    if (delta < 0)
-        if (firstRun && type == 0)
-            return (void *)(nodes);
-        else if (firstRun && type == 1)
-            return (void *)(beams);
+    const int64_t first_frame = (m_play_file) ? 0 : m_first_frame;
+    const int64_t end_frame = (m_play_file) ? m_play_num_frames : m_next_frame;
+    if (frame < first_frame || frame >= end_frame)
+        return false;
+
+    const size_t chunk_index = (size_t)((frame - first_frame) / CHUNK_FRAMES);
+    const int64_t chunk_first = first_frame + (int64_t)(chunk_index * CHUNK_FRAMES);
+    Chunk const* chunk_ptr = this->GetChunk(chunk_index);
+    if (!chunk_ptr)
+        return false;
+    Chunk const& chunk = *chunk_ptr;
+
+    // Continue from the last decoded frame when scrubbing forward within the chunk
+    int64_t f = (m_dec_frame >= chunk_first && m_dec_frame <= frame) ? m_dec_frame + 1 : chunk_first;
+    for (; f <= frame; f++)
+    {
+        const uint8_t* ptr = chunk.data.data() + chunk.offsets[(size_t)(f - chunk_first)];
+        const uint8_t kind = ReadValue<uint8_t>(ptr);
+        if (kind == FRAME_KEY)
+        {
+            m_dec_nodes.resize(m_actor->ar_num_nodes);
+            m_dec_beams.resize(m_actor->ar_num_beams);
+            for (node_simple_t& n: m_dec_nodes)
+            {
+                n = ReadValue<node_simple_t>(ptr);
+            }
+            for (beam_simple_t& b: m_dec_beams)
+            {
+                const uint8_t state = ReadValue<uint8_t>(ptr);
+                b.broken = (state & 1) != 0;
+                b.disabled = (state & 2) != 0;
+            }
+        }
         else
-            delta += numFrames;
-
-    // set the time
-    time = times[delta];
-    curFrameTime = time;
-
-    if (outOfMemory)
-        return 0;
-
-    // return buffer pointer
-    if (type == 0)
-        return (void *)(nodes + delta * m_actor->ar_num_nodes);
-    else if (type == 1)
-        return (void *)(beams + delta * m_actor->ar_num_beams);
-    return 0;
-}
-
-unsigned long Replay::getLastReadTime()
-{
-    return curFrameTime;
+        {
+            const uint8_t* mask = ptr;
+            ptr += (m_dec_nodes.size() + 7) / 8;
+            for (size_t i = 0; i < m_dec_nodes.size(); i++)
+            {
+                if (!(mask[i / 8] & (1 << (i % 8))))
+                    continue;
+                node_simple_t& n = m_dec_nodes[i];
+                for (int k = 0; k < 3; k++)
+                    n.position[k] += ReadValue<int16_t>(ptr) * POS_QUANTUM;
+                for (int k = 0; k < 3; k++)
+                    n.velocity[k] += ReadValue<int16_t>(ptr) * VEL_QUANTUM;
+            }
+            const uint32_t num_changes = ReadValue<uint32_t>(ptr);
+            for (uint32_t c = 0; c < num_changes; c++)
+            {
+                const uint32_t index = ReadValue<uint32_t>(ptr);
+                const uint8_t state = ReadValue<uint8_t>(ptr);
+                m_dec_beams[index].broken = (state & 1) != 0;
+                m_dec_beams[index].disabled = (state & 2) != 0;
+            }
+        }
+    }
+    m_dec_frame = frame;
+    curFrameTime = chunk.times[(size_t)(frame - chunk_first)];
+    return true;
 }
  
 void Replay::onPhysicsStep()
 {
-    m_replay_timer += PHYSICS_DT;
+    if (m_play_file)
+        return; // The recording must stay continuous with what's on screen
+
+    m_replay_timer += m_actor->ar_step_dt;
     if (m_replay_timer >= ar_replay_precision)
     {
-        // store nodes
-        node_simple_t* nbuff = (node_simple_t *)this->getWriteBuffer(0);
-        if (nbuff)
+        try
         {
-            for (int i = 0; i < m_actor->ar_num_nodes; i++)
-            {
-                nbuff[i].position = m_actor->ar_nodes[i].AbsPosition;
-                nbuff[i].velocity = m_actor->ar_nodes[i].Velocity;
-            }
+            this->RecordFrame();
         }
-
-        // store beams
-        beam_simple_t* bbuff = (beam_simple_t *)this->getWriteBuffer(1);
-        if (bbuff)
+        catch (std::bad_alloc&)
         {
-            for (int i = 0; i < m_actor->ar_num_beams; i++)
-            {
-                bbuff[i].broken = m_actor->ar_beams[i].bm_broken;
-                bbuff[i].disabled = m_actor->ar_beams[i].bm_disabled;
-            }
+            m_chunks.clear();
+            outOfMemory = true;
         }
-
-        this->writeDone();
         m_replay_timer = 0.0f;
     }
 }
@@ -216,44 +353,193 @@ void Replay::replayStepActor()
 {
     if (ar_replay_pos != m_replay_pos_prev)
     {
-        unsigned long time = 0;
-
-        node_simple_t* nbuff = (node_simple_t *)this->getReadBuffer(ar_replay_pos, 0, time);
-        if (nbuff)
+        // We take negative offsets only; before the recording filled up, show the oldest frame
+        int offset = std::min(ar_replay_pos, -1);
+        offset = std::max(offset, -this->getNumFrames() + 1);
+        const int64_t frame = (m_play_file)
+            ? std::max(m_play_num_frames + offset, (int64_t)0)
+            : std::max(m_next_frame + offset, m_first_frame);
+
+        if (this->SeekFrame(frame))
         {
             for (int i = 0; i < m_actor->ar_num_nodes; i++)
             {
-                m_actor->ar_nodes[i].AbsPosition = nbuff[i].position;
-                m_actor->ar_nodes[i].RelPosition = nbuff[i].position - m_actor->ar_origin;
+                m_actor->ar_nodes[i].AbsPosition = m_dec_nodes[i].position;
+                m_actor->ar_nodes[i].RelPosition = m_dec_nodes[i].position - m_actor->ar_origin;
 
-                m_actor->ar_nodes[i].Velocity = nbuff[i].velocity;
+                m_actor->ar_nodes[i].Velocity = m_dec_nodes[i].velocity;
                 m_actor->ar_nodes[i].Forces = Vector3::ZERO;
             }
 
             m_actor->updateSlideNodePositions();
             m_actor->UpdateBoundingBoxes();
             m_actor->calculateAveragePosition();
-        }
 
-        beam_simple_t* bbuff = (beam_simple_t *)this->getReadBuffer(ar_replay_pos, 1, time);
-        if (bbuff)
-        {
             for (int i = 0; i < m_actor->ar_num_beams; i++)
             {
-                m_actor->ar_beams[i].bm_broken = bbuff[i].broken;
-                m_actor->ar_beams[i].bm_disabled = bbuff[i].disabled;
+                m_actor->ar_beams[i].bm_broken = m_dec_beams[i].broken;
+                m_actor->ar_beams[i].bm_disabled = m_dec_beams[i].disabled;
             }
         }
         m_replay_pos_prev = ar_replay_pos;
     }
 }
 
+void Replay::WriteChunk(FILE* file, Chunk const& chunk)
+{
+    const uint32_t num_frames = (uint32_t)chunk.offsets.size();
+    const uint64_t data_size = chunk.data.size();
+    std::vector<uint64_t> times(chunk.times.begin(), chunk.times.end());
+    std::vector<uint64_t> offsets(chunk.offsets.begin(), chunk.offsets.end());
+    fwrite(&num_frames, sizeof(num_frames), 1, file);
+    fwrite(&data_size, sizeof(data_size), 1, file);
+    fwrite(times.data(), sizeof(uint64_t), num_frames, file);
+    fwrite(offsets.data(), sizeof(uint64_t), num_frames, file);
+    fwrite(chunk.data.data(), 1, chunk.data.size(), file);
+}
+
+void Replay::SpillPendingChunks(bool wait)
+{
+    // One write at a time keeps the chunks in order; called from the physics step, so never block there
+    if (m_spill_task)
+    {
+        if (!wait && !m_spill_task->is_finished())
+            return;
+        m_spill_task->join();
+        m_spill_task = nullptr;
+    }
+    if (m_spill_pending.empty())
+        return;
+
+    std::shared_ptr<std::vector<Chunk>> chunks = std::make_shared<std::vector<Chunk>>();
+    chunks->swap(m_spill_pending);
+    FILE* file = m_spill_file;
+    auto func = std::function<void()>([file, chunks]()
+        {
+            for (Chunk const& chunk: *chunks)
+            {
+                WriteChunk(file, chunk);
+            }
+        });
+    if (wait)
+        func();
+    else
+        m_spill_task = App::GetThreadPool()->RunTask(func, TaskPriority::BACKGROUND);
+}
+
+bool Replay::StartSpill(std::string const& filename)
+{
+    this->StopSpill();
+    m_spill_file = fopen(filename.c_str(), "wb");
+    if (!m_spill_file)
+        return false;
+
+    const uint32_t header[] = { FILE_VERSION, (uint32_t)m_actor->ar_num_nodes, (uint32_t)m_actor->ar_num_beams, (uint32_t)CHUNK_FRAMES };
+    fwrite(FILE_SIGNATURE, sizeof(FILE_SIGNATURE), 1, m_spill_file);
+    fwrite(header, sizeof(header), 1, m_spill_file);
+
+    // Whatever is recorded so far goes first; the unfinished chunk follows when it's complete
+    for (size_t i = 0; i + 1 < m_chunks.size(); i++)
+    {
+        m_spill_pending.push_back(m_chunks[i]);
+    }
+    this->SpillPendingChunks(/*wait=*/false);
+    return true;
+}
+
+void Replay::StopSpill()
+{
+    if (!m_spill_file)
+        return;
+
+    if (!m_chunks.empty())
+    {
+        m_spill_pending.push_back(m_chunks.back()); // Unfinished, so it must be the last one in the file
+    }
+    this->SpillPendingChunks(/*wait=*/true);
+    if (ferror(m_spill_file))
+    {
+        LOG("[RoR|Replay] Error writing replay file");
+    }
+    fclose(m_spill_file);
+    m_spill_file = nullptr;
+}
+
+bool Replay::StartPlayback(std::string const& filename)
+{
+    this->StopPlayback();
+    FILE* file = fopen(filename.c_str(), "rb");
+    if (!file)
+        return false;
+
+    char signature[sizeof(FILE_SIGNATURE)];
+    uint32_t header[4];
+    if (fread(signature, sizeof(signature), 1, file) != 1 || std::memcmp(signature, FILE_SIGNATURE, sizeof(signature)) != 0 ||
+        fread(header, sizeof(header), 1, file) != 1 || header[0] != FILE_VERSION ||
+        header[1] != (uint32_t)m_actor->ar_num_nodes || header[2] != (uint32_t)m_actor->ar_num_beams || header[3] != CHUNK_FRAMES)
+    {
+        LOG("[RoR|Replay] '" + filename + "' is not a replay of this actor");
+        fclose(file);
+        return false;
+    }
+
+    // Index the chunks; they're read one at a time when needed
+    m_play_chunk_pos.clear();
+    m_play_num_frames = 0;
+    for (;;)
+    {
+        const long pos = ftell(file);
+        uint32_t num_frames = 0;
+        uint64_t data_size = 0;
+        if (fread(&num_frames, sizeof(num_frames), 1, file) != 1 ||
+            fread(&data_size, sizeof(data_size), 1, file) != 1 ||
+            num_frames == 0 || num_frames > CHUNK_FRAMES ||
+            fseek(file, (long)(num_frames * 2 * sizeof(uint64_t) + data_size), SEEK_CUR) != 0)
+        {
+            break;
+        }
+        m_play_chunk_pos.push_back(pos);
+        m_play_num_frames += num_frames;
+        if (num_frames < CHUNK_FRAMES)
+            break; // Only the last chunk may be short
+    }
+    if (m_play_chunk_pos.empty())
+    {
+        fclose(file);
+        return false;
+    }
+
+    m_play_file = file;
+    m_play_chunk_index = SIZE_MAX;
+    m_dec_frame = -1;
+    ar_replay_pos = 0;
+    m_replay_pos_prev = 1; // Show the last frame right away
+    return true;
+}
+
+void Replay::StopPlayback()
+{
+    if (!m_play_file)
+        return;
+
+    fclose(m_play_file);
+    m_play_file = nullptr;
+    m_play_chunk_pos.clear();
+    m_play_chunk = Chunk();
+    m_play_chunk_index = SIZE_MAX;
+    m_dec_frame = -1;
+    m_replay_pos_prev = 1;
+}
+
 void Replay::UpdateInputEvents()
 {
     if (App::GetInputEngine()->getEventBoolValueBounce(EV_COMMON_TOGGLE_REPLAY_MODE))
     {
         if (m_actor->ar_state == ActorState::LOCAL_REPLAY)
+        {
             m_actor->ar_state = ActorState::LOCAL_SIMULATED;
+            this->StopPlayback();
+        }
         else
             m_actor->ar_state = ActorState::LOCAL_REPLAY;
     }
@@ -22,6 +22,13 @@
 
 #include "Application.h"
 
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace RoR {
 
 struct node_simple_t
@@ -36,26 +43,52 @@ struct beam_simple_t
     bool disabled:1;
 };
 
+/// Records the last `nframes` frames of an actor for the replay mode.
+/// Frames are stored in chunks; each chunk starts with a keyframe of all nodes and beams,
+/// the following frames only hold quantized changes of the nodes that moved and the beams
+/// whose state changed. Memory grows with motion rather than with node count. The oldest
+/// chunk is dropped when it's no longer needed to cover `nframes`.
+/// Completed chunks can also be spilled to a file in the background (`StartSpill()`), which
+/// records a whole session; such files are played back by reading one chunk at a time.
 class Replay
 {
 public:
     Replay(ActorPtr b, int nframes);
     ~Replay();
 
-    void*               getWriteBuffer(int type);
-    void*               getReadBuffer(int offset, int type, unsigned long& time);
     unsigned long       getLastReadTime();
-    void                writeDone();
     void                onPhysicsStep();
     void                replayStepActor();
     float               getPrecision() const { return ar_replay_precision; }
     float               getReplayPositionSec() const { return ((float)curFrameTime) / 1000000.0f; }
-    int                 getNumFrames() const { return numFrames; }
+    int                 getNumFrames() const { return (m_play_file) ? (int)m_play_num_frames : numFrames; }
     int                 getCurrentFrame() const { return ar_replay_pos; }
+    void                setCurrentFrame(int pos) { ar_replay_pos = pos; }
     bool                isValid() { return numFrames && !outOfMemory; };
     void                UpdateInputEvents();
 
+    bool                StartSpill(std::string const& filename); //!< Writes the recorded chunks and every chunk completed from now on to the file
+    void                StopSpill();
+    bool                IsSpilling() const { return m_spill_file != nullptr; }
+    bool                StartPlayback(std::string const& filename); //!< Shows the file instead of the recording, until replay mode is left; recording pauses meanwhile
+    void                StopPlayback();
+    bool                IsPlayingBack() const { return m_play_file != nullptr; }
+    size_t              GetMemoryUsage() const; //!< Bytes held by recorded and decoded frames
+
 protected:
+    struct Chunk
+    {
+        std::vector<uint8_t>       data;    //!< Frame records, see `RecordFrame()`
+        std::vector<size_t>        offsets; //!< Start of each frame's record in `data`
+        std::vector<unsigned long> times;
+    };
+
+    void                RecordFrame();
+    bool                SeekFrame(int64_t frame); //!< Decodes absolute frame index into `m_dec_nodes/beams`
+    Chunk const*        GetChunk(size_t index);
+    void                SpillPendingChunks(bool wait);
+    static void         WriteChunk(FILE* file, Chunk const& chunk);
+
     ActorPtr              m_actor = nullptr;
     float               m_replay_timer = 0.f;
     float               ar_replay_precision = 1.f;
@@ -64,14 +97,28 @@ protected:
     Ogre::Timer*        replayTimer = nullptr;
     int                 numFrames = 0;
     bool                outOfMemory = false;
-    int                 writeIndex = 0;
-    int                 firstRun = 0;
     unsigned long       curFrameTime = 0;
 
-    // malloc'ed
-    node_simple_t*      nodes = nullptr;
-    beam_simple_t*      beams = nullptr;
-    unsigned long*      times = nullptr;
+    std::deque<Chunk>          m_chunks;
+    int64_t                    m_first_frame = 0;  //!< Absolute index of the first frame in `m_chunks`
+    int64_t                    m_next_frame = 0;   //!< Absolute index of the next frame to be recorded
+    std::vector<node_simple_t> m_enc_nodes;        //!< Last recorded frame, as the player will decode it; deltas are taken against this so errors don't add up
+    std::vector<beam_simple_t> m_enc_beams;
+    std::vector<node_simple_t> m_dec_nodes;        //!< Last decoded frame
+    std::vector<beam_simple_t> m_dec_beams;
+    int64_t                    m_dec_frame = -1;   //!< Absolute index of the last decoded frame, -1 = none
+
+    // Spilling; the file belongs to `m_spill_task` while it runs
+    FILE*                      m_spill_file = nullptr;
+    std::vector<Chunk>         m_spill_pending;    //!< Completed chunks waiting for the previous write to finish
+    std::shared_ptr<Task>      m_spill_task;
+
+    // Playback from file
+    FILE*                      m_play_file = nullptr;
+    std::vector<long>          m_play_chunk_pos;   //!< File position of each chunk
+    int64_t                    m_play_num_frames = 0;
+    Chunk                      m_play_chunk;       //!< The one chunk in memory
+    size_t                     m_play_chunk_index = SIZE_MAX;
 };
 
 } // namespace RoR
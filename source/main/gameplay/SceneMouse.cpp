@@ -135,6 +135,10 @@ bool SceneMouse::mouseMoved(const OIS::MouseEvent& _arg)
                 if (!pair.first)
                     continue;
 
+                // skip actors which are entirely behind the nearest node found so far (0.1 = node sphere radius)
+                if (pair.second > mindist + 0.1f)
+                    continue;
+
                 for (int j = 0; j < actor->ar_num_nodes; j++)
                 {
                     if (actor->ar_nodes[j].nd_no_mouse_grab)
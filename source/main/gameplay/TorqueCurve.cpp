@@ -43,16 +43,40 @@ TorqueCurve::~TorqueCurve()
 
 Real TorqueCurve::getEngineTorque(Real rpm)
 {
-    if (!usedSpline)
+    if (lutDirty)
+        bakeLookupTable();
+    if (lut.empty())
         return 0.0f;
-    if (usedSpline->getNumPoints() == 1)
-        return usedSpline->getPoint(0).y;
+    if (lut.size() == 1)
+        return lut[0];
+
+    float x = Math::Clamp((rpm - lutMinRPM) * lutSamplesPerRPM, 0.0f, float(LUT_SIZE - 1));
+    int i = std::min(int(x), LUT_SIZE - 2);
+    return lut[i] + (lut[i + 1] - lut[i]) * (x - i);
+}
+
+void TorqueCurve::bakeLookupTable()
+{
+    lutDirty = false;
+    lut.clear();
+    if (!usedSpline || usedSpline->getNumPoints() == 0)
+        return;
+
     float minRPM = usedSpline->getPoint(0).x;
     float maxRPM = usedSpline->getPoint(usedSpline->getNumPoints() - 1).x;
-    if (minRPM == maxRPM)
-        return usedSpline->getPoint(0).y;
-    float t = Math::Clamp((rpm - minRPM) / (maxRPM - minRPM), 0.0f, 1.0f);
-    return usedSpline->interpolate(t).y;
+    if (usedSpline->getNumPoints() == 1 || minRPM == maxRPM)
+    {
+        lut.push_back(usedSpline->getPoint(0).y);
+        return;
+    }
+
+    lut.resize(LUT_SIZE);
+    for (int i = 0; i < LUT_SIZE; i++)
+    {
+        lut[i] = usedSpline->interpolate(float(i) / float(LUT_SIZE - 1)).y;
+    }
+    lutMinRPM = minRPM;
+    lutSamplesPerRPM = float(LUT_SIZE - 1) / (maxRPM - minRPM);
 }
 
 int TorqueCurve::loadDefaultTorqueModels()
@@ -123,6 +147,7 @@ int TorqueCurve::processLine(Ogre::StringVector args, String model)
     // attach the points to the spline
     // LOG("curve "+model+" : " + TOSTRING(point));
     splines[model].addPoint(point);
+    lutDirty = true;
 
     // special case for custom model:
     // we set it as active curve as well!
@@ -152,6 +177,7 @@ void TorqueCurve::AddCurveSample(float rpm, float progress, Ogre::String const&
 {
     /* attach the points to the spline */
     splines[model].addPoint(Ogre::Vector3(rpm, progress, 0));
+    lutDirty = true;
 }
 
 int TorqueCurve::setTorqueModel(String name)
@@ -166,6 +192,7 @@ int TorqueCurve::setTorqueModel(String name)
     // use the model
     usedSpline = &splines.find(name)->second;
     usedModel = name;
+    lutDirty = true;
     return 0;
 }
 
@@ -176,6 +203,7 @@ int TorqueCurve::spaceCurveEvenly(Ogre::SimpleSpline* spline)
 
     SimpleSpline tmpSpline = *spline;
     Real points = tmpSpline.getNumPoints();
+    lutDirty = true;
 
     if (points > 1)
     {
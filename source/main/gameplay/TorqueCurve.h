@@ -22,6 +22,8 @@
 
 #include "Application.h"
 
+#include <vector>
+
 /// @file
 /// @version 1
 /// @brief torquecurve loader.
@@ -49,6 +51,7 @@ public:
 
     /**
      * Returns the calculated engine torque based on the given RPM, interpolating the torque curve spline.
+     * The spline is baked into a lookup table whenever it changes, so this is cheap to call every physics step.
      * @param The current engine RPM.
      * @return Calculated engine torque.
      */
@@ -78,7 +81,7 @@ public:
      * Returns the used spline.
      * @return The torque spline used by the vehicle.
      */
-    Ogre::SimpleSpline* getUsedSpline() { return usedSpline; };
+    Ogre::SimpleSpline* getUsedSpline() { lutDirty = true; return usedSpline; }; // The caller may modify it
 
     /**
      * Returns the name of the torque model used by the vehicle.
@@ -110,9 +113,21 @@ protected:
      */
     int processLine(Ogre::StringVector args, Ogre::String model);
 
+    /**
+     * Samples the used spline into `lut`, evenly spaced between its first and last RPM.
+     */
+    void bakeLookupTable();
+
+    static const int LUT_SIZE = 256; //!< Samples of the baked curve; linear interpolation between them is indistinguishable from the spline.
+
     Ogre::SimpleSpline* usedSpline; //!< spline which is used for calculating the torque, set by setTorqueModel().
     Ogre::String usedModel; //!< name of the torque model used by the truck.
     std::map<Ogre::String, Ogre::SimpleSpline> splines; //!< container were all torque curve splines are stored in.
+
+    std::vector<float> lut;        //!< `usedSpline` baked by `bakeLookupTable()`; one value if the curve is flat.
+    float lutMinRPM = 0.f;
+    float lutSamplesPerRPM = 0.f;
+    bool lutDirty = true;          //!< Set on every change of the used curve.
 };
 
 /// @} // addtogroup Trucks
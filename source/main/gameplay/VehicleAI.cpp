@@ -139,7 +139,7 @@ void VehicleAI::setValueAtWaypoint(std::string const& id, int value_id, float va
         switch (value_id)
         {
         case AI_SPEED:
-            waypoint_speed.emplace(id, value);
+            waypoint_speed.emplace(waypointid, value);
             break;
         case AI_POWER:
             waypoint_power.emplace(waypointid, value);
@@ -150,6 +150,12 @@ void VehicleAI::setValueAtWaypoint(std::string const& id, int value_id, float va
     }
 }
 
+float VehicleAI::getWaypointSpeed(int waypoint_id)
+{
+    auto found = waypoint_speed.find(waypoint_id);
+    return (found != waypoint_speed.end()) ? found->second : 0.f;
+}
+
 void VehicleAI::updateWaypoint()
 {
     if (waypoint_names[current_waypoint_id] != "")
@@ -173,7 +179,7 @@ void VehicleAI::updateWaypoint()
         }
     }
 
-    float speed = waypoint_speed[waypoint_names[current_waypoint_id]];
+    float speed = this->getWaypointSpeed(current_waypoint_id);
     if (speed)
         maxspeed = speed;
 
@@ -266,14 +272,22 @@ void VehicleAI::update(float dt, int doUpdate)
     }
     else
     {
-        for (int i = 0; i < beam->ar_num_nodes; i++)
+        // Only test individual nodes once the waypoint is near the bounding box (2D)
+        Ogre::Vector3 box_min = beam->ar_bounding_box.getMinimum();
+        Ogre::Vector3 box_max = beam->ar_bounding_box.getMaximum();
+        if (current_waypoint.x > box_min.x - dist && current_waypoint.x < box_max.x + dist &&
+            current_waypoint.z > box_min.z - dist && current_waypoint.z < box_max.z + dist)
         {
-            Ogre::Vector3 pos = beam->getNodePosition(i);
-            pos.y = 0;
-            if (current_waypoint.distance(pos) < dist)
+            const float dist_sq = static_cast<float>(dist * dist);
+            for (int i = 0; i < beam->ar_num_nodes; i++)
             {
-                updateWaypoint();
-                return;
+                Ogre::Vector3 pos = beam->getNodePosition(i);
+                pos.y = 0;
+                if (current_waypoint.squaredDistance(pos) < dist_sq)
+                {
+                    updateWaypoint();
+                    return;
+                }
             }
         }
     }
@@ -395,7 +409,7 @@ void VehicleAI::update(float dt, int doUpdate)
             Ogre::Vector3 pos = beam->getPosition();
             pos.y = 0;
 
-            if (waypoint_speed[waypoint_names[current_waypoint_id-1]] == -1)
+            if (this->getWaypointSpeed(current_waypoint_id-1) == -1)
             {
                 // Turn ahead, reduce speed relative to the angle and the current speed
                 if (angle_deg > 0 && current_waypoint.distance(pos) < kmh_wheel_speed)
@@ -437,15 +451,20 @@ void VehicleAI::update(float dt, int doUpdate)
                         beam->ar_engine->autoSetAcc(0);
                     }
 
-                    for (int i = 0; i < beam->ar_num_nodes; i++)
+                    // Node-to-node test only when the bounding boxes are within 5m of each other
+                    Ogre::AxisAlignedBox near_box = beam->ar_bounding_box;
+                    near_box.setExtents(near_box.getMinimum() - Ogre::Vector3(5.f), near_box.getMaximum() + Ogre::Vector3(5.f));
+                    bool done = !near_box.intersects(actor->ar_bounding_box);
+                    for (int i = 0; i < beam->ar_num_nodes && !done; i++)
                     {
                         for (int k = 0; k < actor->ar_num_nodes; k++)
                         {
                             // Too close, stop
-                            if (beam->getNodePosition(i).distance(actor->getNodePosition(k)) < 5)
+                            if (beam->getNodePosition(i).squaredDistance(actor->getNodePosition(k)) < 5.f * 5.f)
                             {
                                 beam->ar_parking_brake = true;
                                 beam->toggleHeadlights();
+                                done = true;
                                 break;
                             }
                         }
@@ -482,7 +501,7 @@ void VehicleAI::update(float dt, int doUpdate)
                  App::GetGuiManager()->TopMenubar.ai_mode == 2 || // Drag race mode
                  App::GetGuiManager()->TopMenubar.ai_mode == 3) // Crash driving mode
         {
-            if (waypoint_speed[waypoint_names[current_waypoint_id-1]] == -1)
+            if (this->getWaypointSpeed(current_waypoint_id-1) == -1)
             {
                 maxspeed = App::GetGuiManager()->TopMenubar.ai_speed;
             }
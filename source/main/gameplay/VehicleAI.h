@@ -128,12 +128,18 @@ public:
      */
     void update(float dt, int doUpdate);
 
+    Ogre::Vector3 GetCurrentWaypoint() const { return current_waypoint; } //!< For the rigid-body proxy, see `Actor::UpdateRigidProxy()`
+    bool          IsWaiting() const { return is_waiting; }
+
 private:
     /**
      *   Updates the AI waypoint.
      */
     void updateWaypoint();
 
+    /// Speed set for a waypoint, 0 if none (-1 = auto speed). Doesn't insert like `operator[]`.
+    float getWaypointSpeed(int waypoint_id);
+
     bool is_waiting=false;//!<
     float wait_time=0.f;//!<(seconds) The amount of time the AI has to wait.
 
@@ -148,7 +154,7 @@ private:
     std::map<std::string, int> waypoint_ids;//!< Map with all waypoint IDs.
     std::map<int, std::string> waypoint_names;//!< Map with all waypoint names.
     std::map<int, int> waypoint_events;//!< Map with all waypoint events.
-    std::map<Ogre::String, float> waypoint_speed;//!< Map with all waypoint speeds.
+    std::map<int, float> waypoint_speed;//!< Map with all waypoint speeds.
     std::map<int, float> waypoint_power;//!< Map with all waypoint engine power.
     std::map<int, float> waypoint_wait_time;//!< Map with all waypoint wait times.
     int free_waypoints = 0;//!< The amount of waypoints.
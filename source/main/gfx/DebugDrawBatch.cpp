@@ -0,0 +1,110 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "DebugDrawBatch.h"
+
+#include "Application.h"
+#include "SimData.h"
+
+#include <algorithm>
+
+using namespace Ogre;
+using namespace RoR;
+
+void DebugDrawBatch::Begin(ImDrawList* drawlist, World2ScreenConverter& world2screen, const node_t* nodes, size_t num_nodes)
+{
+    m_drawlist = drawlist;
+    m_world2screen = &world2screen;
+    m_nodes = nodes;
+    m_screen_size = ImGui::GetIO().DisplaySize;
+
+    m_node_screen_pos.resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++)
+    {
+        m_node_screen_pos[i] = world2screen.Convert(nodes[i].AbsPosition);
+    }
+
+    // One label per cell roughly the size of a node ID
+    m_declutter_labels = App::diag_declutter_labels->getBool();
+    if (m_declutter_labels)
+    {
+        m_label_cell_size = ImVec2(ImGui::GetFontSize() * 2.f, ImGui::GetFontSize());
+        m_label_cells_x = std::max(1, static_cast<int>(m_screen_size.x / m_label_cell_size.x) + 1);
+        m_label_cells_y = std::max(1, static_cast<int>(m_screen_size.y / m_label_cell_size.y) + 1);
+        m_label_cells.assign(m_label_cells_x * m_label_cells_y, false);
+    }
+}
+
+Ogre::Vector3 DebugDrawBatch::Project(const node_t* node)
+{
+    // Beams may end in another actor (hooks, ties), these aren't cached
+    const size_t index = node - m_nodes;
+    if (node >= m_nodes && index < m_node_screen_pos.size())
+    {
+        return m_node_screen_pos[index];
+    }
+    return m_world2screen->Convert(node->AbsPosition);
+}
+
+bool DebugDrawBatch::IsOnScreen(Ogre::Vector3 const& pos, float margin) const
+{
+    return pos.z < 0.f &&
+        pos.x >= -margin && pos.x <= m_screen_size.x + margin &&
+        pos.y >= -margin && pos.y <= m_screen_size.y + margin;
+}
+
+void DebugDrawBatch::AddLine(Ogre::Vector3 const& pos1, Ogre::Vector3 const& pos2, ImU32 color, float thickness)
+{
+    if (pos1.z >= 0.f || pos2.z >= 0.f)
+        return; // Behind the camera
+
+    // Both ends past the same screen edge
+    if ((pos1.x < 0.f && pos2.x < 0.f) || (pos1.x > m_screen_size.x && pos2.x > m_screen_size.x) ||
+        (pos1.y < 0.f && pos2.y < 0.f) || (pos1.y > m_screen_size.y && pos2.y > m_screen_size.y))
+        return;
+
+    m_drawlist->AddLine(ImVec2(pos1.x, pos1.y), ImVec2(pos2.x, pos2.y), color, thickness);
+}
+
+void DebugDrawBatch::AddPoint(Ogre::Vector3 const& pos, float radius, ImU32 color)
+{
+    if (this->IsOnScreen(pos, radius))
+    {
+        m_drawlist->AddCircleFilled(ImVec2(pos.x, pos.y), radius, color);
+    }
+}
+
+bool DebugDrawBatch::ReserveLabel(Ogre::Vector3 const& pos)
+{
+    if (!this->IsOnScreen(pos, 0.f))
+        return false;
+    if (!m_declutter_labels)
+        return true;
+
+    const int cx = static_cast<int>(pos.x / m_label_cell_size.x);
+    const int cy = static_cast<int>(pos.y / m_label_cell_size.y);
+    std::vector<bool>::reference cell = m_label_cells[cy * m_label_cells_x + cx];
+    if (cell)
+        return false;
+    cell = true;
+    return true;
+}
@@ -0,0 +1,76 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/// @file
+/// @brief Screen-space drawing for the softbody debug views
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+#include "Utils.h"
+
+#include <imgui.h>
+#include <Ogre.h>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Gfx
+/// @{
+
+/// Draws lines, points and text labels of the actor debug views into one ImGui draw list
+/// (one dynamic vertex buffer for everything). Projects each node of the actor once per frame,
+/// skips primitives outside of the viewport and optionally thins out labels which would overlap.
+class DebugDrawBatch
+{
+public:
+    void           Begin(ImDrawList* drawlist, World2ScreenConverter& world2screen, const node_t* nodes, size_t num_nodes);
+
+    /// @return X,Y=screen pos, Z=view space pos ('Z<0' means 'in front of the camera'), see `World2ScreenConverter`
+    Ogre::Vector3  Project(const node_t* node);
+    Ogre::Vector3  Project(Ogre::Vector3 const& world_pos) { return m_world2screen->Convert(world_pos); }
+
+    /// @name Drawing; positions come from `Project()`
+    /// @{
+    void           AddLine(Ogre::Vector3 const& pos1, Ogre::Vector3 const& pos2, ImU32 color, float thickness);
+    void           AddPoint(Ogre::Vector3 const& pos, float radius, ImU32 color);
+    bool           ReserveLabel(Ogre::Vector3 const& pos); //!< False if the label is off-screen or another one already sits nearby; draw it otherwise
+    /// @}
+
+private:
+    bool           IsOnScreen(Ogre::Vector3 const& pos, float margin) const;
+
+    ImDrawList*                m_drawlist = nullptr;
+    World2ScreenConverter*     m_world2screen = nullptr;
+    const node_t*              m_nodes = nullptr;
+    std::vector<Ogre::Vector3> m_node_screen_pos;   //!< Projected nodes of the actor, in node order
+    ImVec2                     m_screen_size;
+    std::vector<bool>          m_label_cells;       //!< Screen grid; a set cell already holds a label
+    int                        m_label_cells_x = 0;
+    int                        m_label_cells_y = 0;
+    ImVec2                     m_label_cell_size;
+    bool                       m_declutter_labels = false;
+};
+
+/// @} // addtogroup Gfx
+
+} // namespace RoR
@@ -38,6 +38,7 @@ using namespace RoR;
 DustPool::DustPool(Ogre::SceneManager* sm, const char* dname, int dsize):
 	allocated(0),
 	size(std::min(dsize, static_cast<int>(MAX_DUSTS))),
+	m_num_enabled(0),
 	m_is_discarded(false)
 {
     for (int i = 0; i < size; i++)
@@ -89,42 +90,54 @@ void DustPool::setVisible(bool s)
     }
 }
 
-//Dust
-void DustPool::malloc(Vector3 pos, Vector3 vel, ColourValue col)
+int DustPool::Alloc(int type, Vector3 const& pos, Vector3 const& vel)
 {
+    // Coalesce with an emission of the same type nearby - with many wheels
+    // touching the ground, most contacts land within centimeters of each other.
+    for (int i = 0; i < allocated; i++)
+    {
+        if (types[i] == type && positions[i].squaredDistance(pos) < MERGE_DISTANCE_SQ)
+        {
+            if (vel.squaredLength() > velocities[i].squaredLength())
+            {
+                positions[i] = pos;
+                velocities[i] = vel;
+                return i;
+            }
+            return -1;
+        }
+    }
+
     if (allocated < size)
     {
         positions[allocated] = pos;
         velocities[allocated] = vel;
-        colours[allocated] = col;
-        types[allocated] = DUST_NORMAL;
-        allocated++;
+        types[allocated] = type;
+        return allocated++;
     }
+    return -1;
+}
+
+//Dust
+void DustPool::malloc(Vector3 pos, Vector3 vel, ColourValue col)
+{
+    int i = this->Alloc(DUST_NORMAL, pos, vel);
+    if (i != -1)
+        colours[i] = col;
 }
 
 //Clumps
 void DustPool::allocClump(Vector3 pos, Vector3 vel, ColourValue col)
 {
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        colours[allocated] = col;
-        types[allocated] = DUST_CLUMP;
-        allocated++;
-    }
+    int i = this->Alloc(DUST_CLUMP, pos, vel);
+    if (i != -1)
+        colours[i] = col;
 }
 
 //Rubber smoke
 void DustPool::allocSmoke(Vector3 pos, Vector3 vel)
 {
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        types[allocated] = DUST_RUBBER;
-        allocated++;
-    }
+    this->Alloc(DUST_RUBBER, pos, vel);
 }
 
 //
@@ -132,60 +145,32 @@ void DustPool::allocSparks(Vector3 pos, Vector3 vel)
 {
     if (vel.length() < 0.1)
         return; // try to prevent emitting sparks while standing
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        types[allocated] = DUST_SPARKS;
-        allocated++;
-    }
+    this->Alloc(DUST_SPARKS, pos, vel);
 }
 
 //Water vapour
 void DustPool::allocVapour(Vector3 pos, Vector3 vel, float time)
 {
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        types[allocated] = DUST_VAPOUR;
-        rates[allocated] = 5.0 - time;
-        allocated++;
-    }
+    int i = this->Alloc(DUST_VAPOUR, pos, vel);
+    if (i != -1)
+        rates[i] = 5.0 - time;
 }
 
 void DustPool::allocDrip(Vector3 pos, Vector3 vel, float time)
 {
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        types[allocated] = DUST_DRIP;
-        rates[allocated] = 5.0 - time;
-        allocated++;
-    }
+    int i = this->Alloc(DUST_DRIP, pos, vel);
+    if (i != -1)
+        rates[i] = 5.0 - time;
 }
 
 void DustPool::allocSplash(Vector3 pos, Vector3 vel)
 {
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        types[allocated] = DUST_SPLASH;
-        allocated++;
-    }
+    this->Alloc(DUST_SPLASH, pos, vel);
 }
 
 void DustPool::allocRipple(Vector3 pos, Vector3 vel)
 {
-    if (allocated < size)
-    {
-        positions[allocated] = pos;
-        velocities[allocated] = vel;
-        types[allocated] = DUST_RIPPLE;
-        allocated++;
-    }
+    this->Alloc(DUST_RIPPLE, pos, vel);
 }
 
 void DustPool::update()
@@ -286,9 +271,10 @@ void DustPool::update()
 
         emit->setColour(col);
     }
-    for (int i = allocated; i < size; i++)
+    for (int i = allocated; i < m_num_enabled; i++)
     {
         pss[i]->getEmitter(0)->setEnabled(false);
     }
+    m_num_enabled = allocated;
     allocated = 0;
 }
@@ -62,6 +62,7 @@ public:
 protected:
 
     static const int MAX_DUSTS = 100;
+    static constexpr float MERGE_DISTANCE_SQ = 0.25f; //!< Emissions of the same type closer than 0.5m share one emitter
 
     enum DustTypes
     {
@@ -84,7 +85,10 @@ protected:
     int allocated;
     int size;
     int types[MAX_DUSTS];
+    int m_num_enabled;     //!< Emitters left enabled by the last update(); only those need disabling.
     bool m_is_discarded;
+
+    int  Alloc(int type, Ogre::Vector3 const& pos, Ogre::Vector3 const& vel); //!< Returns slot index or -1 if full
 };
 
 /// @} // addtogroup Gfx
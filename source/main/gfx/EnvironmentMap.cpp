@@ -24,6 +24,7 @@
 #include "CameraManager.h"
 #include "GameContext.h"
 #include "GfxActor.h"
+#include "GfxFrameBudget.h"
 #include "GfxScene.h"
 #include "GUIManager.h"
 #include "SkyManager.h"
@@ -33,6 +34,11 @@
 #include <OgreOverlayManager.h>
 #include <OgreOverlay.h>
 
+// The cubemap is world-aligned, so only moving the probe changes what it sees (besides other moving objects)
+static const float ENVMAP_MOVE_THRESHOLD = 0.25f; // meters
+static const int   ENVMAP_IDLE_FRAMES    = 10;    // A resting probe renders one face per this many frames
+static const float ENVMAP_LOD_BIAS       = 0.5f;  // Reflections are small and blurry, coarser mesh LODs suffice
+
 RoR::GfxEnvmap::GfxEnvmap():
     m_update_round(0)
 {
@@ -54,6 +60,7 @@ void RoR::GfxEnvmap::SetupEnvMap()
         m_cameras[face]->setFOVy(Ogre::Degree(90));
         m_cameras[face]->setNearClipDistance(0.1f);
         m_cameras[face]->setFarClipDistance(App::GetCameraManager()->GetCamera()->getFarClipDistance());
+        m_cameras[face]->setLodBias(ENVMAP_LOD_BIAS);
 
         Ogre::Viewport* v = m_render_targets[face]->addViewport(m_cameras[face]);
         v->setOverlaysEnabled(false);
@@ -206,7 +213,20 @@ RoR::GfxEnvmap::~GfxEnvmap()
 void RoR::GfxEnvmap::UpdateEnvMap(Ogre::Vector3 center, GfxActor* gfx_actor, bool full/*=false*/)
 {
     // how many of the 6 render planes to update at once? Use cvar 'gfx_envmap_rate', unless instructed to do full render.
-    const int update_rate = full ? NUM_FACES : App::gfx_envmap_rate->getInt();
+    // The frame budget may reduce it to one plane per frame.
+    int update_rate = full ? NUM_FACES : App::GetGfxScene()->GetFrameBudget().GetAllowedUnits(GfxBudgetTask::ENVMAP, App::gfx_envmap_rate->getInt());
+
+    // Once all faces were rendered from a resting position, only trickle-refresh them
+    if (full || center.squaredDistance(m_last_center) > ENVMAP_MOVE_THRESHOLD * ENVMAP_MOVE_THRESHOLD)
+    {
+        m_last_center = center;
+        m_faces_since_move = 0;
+    }
+    if (m_faces_since_move >= (int)NUM_FACES)
+    {
+        m_idle_frames++;
+        update_rate = (m_idle_frames >= ENVMAP_IDLE_FRAMES) ? std::min(update_rate, 1) : 0;
+    }
 
     if (!App::gfx_envmap_enabled->getBool())
     {
@@ -223,6 +243,10 @@ void RoR::GfxEnvmap::UpdateEnvMap(Ogre::Vector3 center, GfxActor* gfx_actor, boo
         return;
     }
 
+    GfxBudgetZone budget_zone(App::GetGfxScene()->GetFrameBudget(), GfxBudgetTask::ENVMAP, update_rate);
+    m_faces_since_move += update_rate;
+    m_idle_frames = 0;
+
     for (int i = 0; i < NUM_FACES; i++)
     {
         m_cameras[i]->setPosition(center);
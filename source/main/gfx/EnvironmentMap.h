@@ -50,6 +50,9 @@ private:
     Ogre::RenderTarget*  m_render_targets[NUM_FACES];
     Ogre::TexturePtr     m_rtt_texture;
     int                  m_update_round; /// Render targets are updated one-by-one; this is the index of next target to update.
+    Ogre::Vector3        m_last_center = Ogre::Vector3::ZERO; //!< Probe position at the last move
+    int                  m_faces_since_move = 0;  //!< Faces rendered since the probe last moved; after a full round it only refreshes slowly
+    int                  m_idle_frames = 0;
 };
 
 /// @} // addtogroup Gfx
@@ -24,10 +24,12 @@
 #include "ApproxMath.h"
 #include "AirBrake.h"
 #include "Actor.h"
+#include "CameraManager.h"
 #include "Collisions.h"
 #include "DustPool.h" // General particle gfx
 #include "EngineSim.h"
 #include "GameContext.h"
+#include "GfxFrameBudget.h"
 #include "GfxScene.h"
 #include "GUIManager.h"
 #include "GUIUtils.h"
@@ -36,13 +38,16 @@
 #include "FlexBody.h"
 #include "FlexMeshWheel.h"
 #include "FlexObj.h"
+#include "FrameArena.h"
 #include "InputEngine.h" // TODO: Keys shouldn't be queried from here, but buffered in sim. loop ~ only_a_ptr, 06/2018
 #include "MeshObject.h"
 #include "MovableText.h"
 #include "OgreImGui.h"
 #include "Renderdash.h" // classic 'renderdash' material
+#include "RodBatch.h"
 #include "ActorSpawner.h"
 #include "SlideNode.h"
+#include "SimProfiler.h"
 #include "SkyManager.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
@@ -74,13 +79,10 @@ RoR::GfxActor::GfxActor(ActorPtr actor, ActorSpawner* spawner, std::string ogre_
 RoR::GfxActor::~GfxActor()
 {
     // Dispose videocameras
-    this->SetVideoCamState(VideoCamState::VCSTATE_DISABLED);
+    this->SetVideoCamState(VideoCamState::VCSTATE_DISABLED); // Returns render textures to the pool
     while (!m_videocameras.empty())
     {
         VideoCamera& vcam = m_videocameras.back();
-        Ogre::TextureManager::getSingleton().remove(vcam.vcam_render_tex->getHandle());
-        vcam.vcam_render_tex.setNull();
-        vcam.vcam_render_target = nullptr; // Invalidated with parent texture
         App::GetGfxScene()->GetSceneManager()->destroyCamera(vcam.vcam_ogre_camera);
 
         m_videocameras.pop_back();
@@ -89,12 +91,11 @@ RoR::GfxActor::~GfxActor()
     // Dispose rods
     if (m_gfx_beams_parent_scenenode != nullptr)
     {
-        for (BeamGfx& rod: m_gfx_beams)
+        for (RodBatch* batch: m_rod_batches)
         {
-            Ogre::MovableObject* ogre_object = rod.rod_scenenode->getAttachedObject(0);
-            rod.rod_scenenode->detachAllObjects();
-            App::GetGfxScene()->GetSceneManager()->destroyEntity(static_cast<Ogre::Entity*>(ogre_object));
+            delete batch;
         }
+        m_rod_batches.clear();
         m_gfx_beams.clear();
 
         m_gfx_beams_parent_scenenode->removeAndDestroyAllChildren();
@@ -303,24 +304,104 @@ void RoR::GfxActor::SetVideoCamState(VideoCamState state)
     }
 
     const bool enable = (state == VideoCamState::VCSTATE_ENABLED_ONLINE);
-    for (VideoCamera vidcam: m_videocameras)
+    for (VideoCamera& vidcam: m_videocameras)
     {
-        if (vidcam.vcam_render_target != nullptr)
+        if (vidcam.vcam_render_window != nullptr)
         {
-            vidcam.vcam_render_target->setActive(enable);
-            if (enable)
-                vidcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureName(vidcam.vcam_render_tex->getName());
-            else
-                vidcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureName(vidcam.vcam_off_tex_name);
+            vidcam.vcam_render_window->setActive(enable);
             continue;
         }
 
-        if (vidcam.vcam_render_window != nullptr)
+        // Only online (player's) cameras hold a render texture
+        if (enable)
+            this->AttachVideoCamTexture(vidcam);
+        else
+            this->DetachVideoCamTexture(vidcam);
+    }
+    m_vidcam_state = state;
+}
+
+void RoR::GfxActor::AttachVideoCamTexture(VideoCamera& vidcam)
+{
+    if (vidcam.vcam_render_target != nullptr || vidcam.vcam_tex_width == 0)
+        return;
+
+    vidcam.vcam_render_tex = App::GetGfxScene()->AcquireVideoCamTexture(vidcam.vcam_tex_width, vidcam.vcam_tex_height);
+    vidcam.vcam_render_target = vidcam.vcam_render_tex->getBuffer()->getRenderTarget();
+    vidcam.vcam_render_target->setAutoUpdated(false); // See `UpdateVideoCameras()`
+    vidcam.vcam_render_target->setActive(true);
+
+    Ogre::Viewport* vp = vidcam.vcam_render_target->addViewport(vidcam.vcam_ogre_camera);
+    vp->setClearEveryFrame(true);
+    vp->setBackgroundColour(App::GetCameraManager()->GetCamera()->getViewport()->getBackgroundColour());
+    vp->setVisibilityMask(vidcam.vcam_visibility_mask);
+    vp->setOverlaysEnabled(false);
+
+    vidcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureName(vidcam.vcam_render_tex->getName());
+    vidcam.vcam_update_timer = FLT_MAX; // Render on the next update
+}
+
+void RoR::GfxActor::DetachVideoCamTexture(VideoCamera& vidcam)
+{
+    Ogre::TextureUnitState* tus = vidcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0);
+    tus->setTextureName(vidcam.vcam_off_tex_name);
+    if (vidcam.vcam_res_scale != 1.f)
+    {
+        tus->setTextureScale(vidcam.vcam_tex_uscale, 1.f);
+        vidcam.vcam_res_scale = 1.f;
+    }
+
+    if (vidcam.vcam_render_target == nullptr)
+        return;
+
+    vidcam.vcam_render_target->removeAllViewports();
+    App::GetGfxScene()->ReleaseVideoCamTexture(vidcam.vcam_render_tex);
+    vidcam.vcam_render_tex.setNull();
+    vidcam.vcam_render_target = nullptr;
+}
+
+void RoR::GfxActor::RenderVideoCamera(VideoCamera& vidcam, const Ogre::Sphere* surface)
+{
+    // A full extra scene render; screens and mirrors read fine at a lower rate
+    const int fps = App::gfx_videocam_fps->getInt();
+    if (fps > 0 && vidcam.vcam_update_timer < 1.f / fps)
+        return;
+
+    if (vidcam.vcam_render_window != nullptr)
+    {
+        vidcam.vcam_update_timer = 0.f;
+        vidcam.vcam_render_window->update();
+        return;
+    }
+
+    if (vidcam.vcam_render_target == nullptr)
+        return;
+
+    // Don't render a texture nobody can see - mirrors by their own surface, screens by the whole actor
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    if ((surface != nullptr) ? !camera->isVisible(*surface) : !camera->isVisible(m_simbuf.simbuf_aabb))
+        return;
+
+    // Render only as many pixels as the surface covers on screen; the texture is sampled around its center
+    if (surface != nullptr)
+    {
+        const float dist = std::max(0.1f, camera->getDerivedPosition().distance(surface->getCenter()));
+        const float screen_px = camera->getViewport()->getActualHeight() * surface->getRadius()
+            / (dist * Ogre::Math::Tan(camera->getFOVy() / 2.f));
+        float scale = Ogre::Math::Clamp(screen_px / (float)vidcam.vcam_tex_height, 0.25f, 1.f);
+        scale = std::ceil(scale * 4.f) / 4.f; // Quarter steps, avoid changing every frame
+        if (scale != vidcam.vcam_res_scale)
         {
-            vidcam.vcam_render_window->setActive(enable);
+            const float margin = (1.f - scale) / 2.f;
+            vidcam.vcam_render_target->getViewport(0)->setDimensions(margin, margin, scale, scale);
+            vidcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureScale(
+                vidcam.vcam_tex_uscale / scale, 1.f / scale);
+            vidcam.vcam_res_scale = scale;
         }
     }
-    m_vidcam_state = state;
+
+    vidcam.vcam_update_timer = 0.f;
+    vidcam.vcam_render_target->update();
 }
 
 void RoR::GfxActor::UpdateVideoCameras(float dt_sec)
@@ -328,8 +409,22 @@ void RoR::GfxActor::UpdateVideoCameras(float dt_sec)
     if (m_vidcam_state != VideoCamState::VCSTATE_ENABLED_ONLINE)
         return;
 
+    // Under frame budget pressure, rendered cameras (not mirror props) take turns, see `GfxFrameBudget`
+    int num_rendered = 0;
     for (VideoCamera& vidcam: m_videocameras)
     {
+        if (vidcam.vcam_type != VCTYPE_MIRROR_PROP_LEFT && vidcam.vcam_type != VCTYPE_MIRROR_PROP_RIGHT)
+            num_rendered++;
+    }
+    GfxFrameBudget& budget = App::GetGfxScene()->GetFrameBudget();
+    const int num_allowed = budget.GetAllowedUnits(GfxBudgetTask::VIDEO_CAMERAS, num_rendered);
+    GfxBudgetZone budget_zone(budget, GfxBudgetTask::VIDEO_CAMERAS, num_allowed);
+    int render_index = 0;
+
+    for (VideoCamera& vidcam: m_videocameras)
+    {
+        vidcam.vcam_update_timer += dt_sec;
+
 #ifdef USE_CAELUM
         // caelum needs to know that we changed the cameras
         SkyManager* sky = App::GetGameContext()->GetTerrain()->getSkyManager();
@@ -371,20 +466,39 @@ void RoR::GfxActor::UpdateVideoCameras(float dt_sec)
             vidcam.vcam_ogre_camera->roll(roll);
             vidcam.vcam_ogre_camera->setNearClipDistance(1); // fixes Caelum sky rendered black on mirrors
 
+            const Ogre::AxisAlignedBox& prop_aabb = vidcam.vcam_prop_scenenode->_getWorldAABB();
+            if (prop_aabb.isFinite())
+            {
+                const Ogre::Sphere surface(prop_aabb.getCenter(), prop_aabb.getHalfSize().length());
+                this->RenderVideoCamera(vidcam, &surface);
+            }
+            else
+            {
+                this->RenderVideoCamera(vidcam, nullptr);
+            }
+
             continue; // Done processing mirror prop.
         }
 
-        // update the texture now, otherwise shuttering
-        if (vidcam.vcam_render_target != nullptr)
-            vidcam.vcam_render_target->update();
-
-        if (vidcam.vcam_render_window != nullptr)
-            vidcam.vcam_render_window->update();
-
-        // get the normal of the camera plane now
         const Ogre::Vector3 abs_pos_center = m_simbuf.simbuf_nodes[vidcam.vcam_node_center].AbsPosition;
         const Ogre::Vector3 abs_pos_z = m_simbuf.simbuf_nodes[vidcam.vcam_node_dir_z].AbsPosition;
         const Ogre::Vector3 abs_pos_y = m_simbuf.simbuf_nodes[vidcam.vcam_node_dir_y].AbsPosition;
+
+        // update the texture now, otherwise shuttering
+        const bool render_turn = ((render_index++ - m_vidcam_next_render + num_rendered) % num_rendered) < num_allowed;
+        if (render_turn && vidcam.vcam_type == VCTYPE_MIRROR)
+        {
+            // The mirror's reference nodes span its surface
+            const Ogre::Sphere surface(abs_pos_center, std::max(abs_pos_center.distance(abs_pos_y), abs_pos_center.distance(abs_pos_z)));
+            this->RenderVideoCamera(vidcam, &surface);
+        }
+        else if (render_turn)
+        {
+            // The screen showing a video camera may be anywhere on the actor
+            this->RenderVideoCamera(vidcam, nullptr);
+        }
+
+        // get the normal of the camera plane now
         Ogre::Vector3 normal = (-(abs_pos_center - abs_pos_z)).crossProduct(-(abs_pos_center - abs_pos_y));
         normal.normalise();
 
@@ -441,6 +555,11 @@ void RoR::GfxActor::UpdateVideoCameras(float dt_sec)
         // set the new position
         vidcam.vcam_ogre_camera->setPosition(pos);
     }
+
+    if (num_rendered > 0)
+    {
+        m_vidcam_next_render = (m_vidcam_next_render + num_allowed) % num_rendered;
+    }
 }
 
 void RoR::GfxActor::UpdateParticles(float dt_sec)
@@ -588,6 +707,7 @@ void RoR::GfxActor::UpdateDebugView()
         App::GetCameraManager()->GetCamera()->getViewMatrix(true), App::GetCameraManager()->GetCamera()->getProjectionMatrix(), Ogre::Vector2(screen_size.x, screen_size.y));
 
     ImDrawList* drawlist = GetImDummyFullscreenWindow();
+    m_debug_draw.Begin(drawlist, world2screen, m_actor->ar_nodes, static_cast<size_t>(m_actor->ar_num_nodes));
 
     if (m_actor->ar_physics_paused && !App::GetGuiManager()->IsGuiHidden())
     {
@@ -600,7 +720,7 @@ void RoR::GfxActor::UpdateDebugView()
             float radius = 0.0f;
             for (int i = 0; i < m_actor->ar_num_nodes; ++i)
             {
-                radius = std::max(radius, pos_xyz.distance(world2screen.Convert(m_actor->ar_nodes[i].AbsPosition)));
+                radius = std::max(radius, pos_xyz.distance(m_debug_draw.Project(&m_actor->ar_nodes[i])));
             }
 
             drawlist->AddCircleFilled(pos, radius * 1.05f, 0x22222222, 36);
@@ -622,26 +742,23 @@ void RoR::GfxActor::UpdateDebugView()
                      beams[i].p2->nd_tyre_node || beams[i].p2->nd_rim_node))
                 continue;
 
-            Ogre::Vector3 pos1 = world2screen.Convert(beams[i].p1->AbsPosition);
-            Ogre::Vector3 pos2 = world2screen.Convert(beams[i].p2->AbsPosition);
+            Ogre::Vector3 pos1 = m_debug_draw.Project(beams[i].p1);
+            Ogre::Vector3 pos2 = m_debug_draw.Project(beams[i].p2);
 
             if ((pos1.z < 0.f) && (pos2.z < 0.f))
             {
-                ImVec2 pos1xy(pos1.x, pos1.y);
-                ImVec2 pos2xy(pos2.x, pos2.y);
-
                 if (beams[i].bm_broken)
                 {
                     if (!App::diag_hide_broken_beams->getBool())
                     {
-                        drawlist->AddLine(pos1xy, pos2xy, BEAM_BROKEN_COLOR, BEAM_BROKEN_THICKNESS);
+                        m_debug_draw.AddLine(pos1, pos2, BEAM_BROKEN_COLOR, BEAM_BROKEN_THICKNESS);
                     }
                 }
                 else if (beams[i].bm_type == BEAM_HYDRO)
                 {
                     if (!beams[i].bm_disabled)
                     {
-                        drawlist->AddLine(pos1xy, pos2xy, BEAM_HYDRO_COLOR, BEAM_HYDRO_THICKNESS);
+                        m_debug_draw.AddLine(pos1, pos2, BEAM_HYDRO_COLOR, BEAM_HYDRO_THICKNESS);
                     }
                 }
                 else
@@ -662,7 +779,7 @@ void RoR::GfxActor::UpdateDebugView()
                             color = Ogre::ColourValue(0.2f, 0.4f * (1.0f - s), 0.33f * (1 + 1.0f * s), 1.0f).getAsABGR();
                         }
                     }
-                    drawlist->AddLine(pos1xy, pos2xy, color, BEAM_THICKNESS);
+                    m_debug_draw.AddLine(pos1, pos2, color, BEAM_THICKNESS);
                 }
             }
         }
@@ -677,19 +794,14 @@ void RoR::GfxActor::UpdateDebugView()
                 if (App::diag_hide_wheels->getBool() && (nodes[i].nd_tyre_node || nodes[i].nd_rim_node))
                     continue;
 
-                Ogre::Vector3 pos_xyz = world2screen.Convert(nodes[i].AbsPosition);
-
-                if (pos_xyz.z < 0.f)
+                Ogre::Vector3 pos_xyz = m_debug_draw.Project(&nodes[i]);
+                if (nodes[i].nd_immovable)
                 {
-                    ImVec2 pos(pos_xyz.x, pos_xyz.y);
-                    if (nodes[i].nd_immovable)
-                    {
-                        drawlist->AddCircleFilled(pos, NODE_IMMOVABLE_RADIUS, NODE_IMMOVABLE_COLOR);
-                    }
-                    else
-                    {
-                        drawlist->AddCircleFilled(pos, NODE_RADIUS, NODE_COLOR);
-                    }
+                    m_debug_draw.AddPoint(pos_xyz, NODE_IMMOVABLE_RADIUS, NODE_IMMOVABLE_COLOR);
+                }
+                else
+                {
+                    m_debug_draw.AddPoint(pos_xyz, NODE_RADIUS, NODE_COLOR);
                 }
             }
 
@@ -702,9 +814,9 @@ void RoR::GfxActor::UpdateDebugView()
                             (nodes[i].nd_tyre_node || nodes[i].nd_rim_node))
                         continue;
 
-                    Ogre::Vector3 pos = world2screen.Convert(nodes[i].AbsPosition);
+                    Ogre::Vector3 pos = m_debug_draw.Project(&nodes[i]);
 
-                    if (pos.z < 0.f)
+                    if (m_debug_draw.ReserveLabel(pos))
                     {
                         ImVec2 pos_xy(pos.x, pos.y);
                         Str<25> id_buf;
@@ -735,10 +847,10 @@ void RoR::GfxActor::UpdateDebugView()
 
                 // Position
                 Ogre::Vector3 world_pos = (beams[i].p1->AbsPosition + beams[i].p2->AbsPosition) / 2.f;
-                Ogre::Vector3 pos_xyz = world2screen.Convert(world_pos);
-                if (pos_xyz.z >= 0.f)
+                Ogre::Vector3 pos_xyz = m_debug_draw.Project(world_pos);
+                if (!m_debug_draw.ReserveLabel(pos_xyz))
                 {
-                    continue; // Behind the camera
+                    continue; // Off-screen or crowded
                 }
                 ImVec2 pos(pos_xyz.x, pos_xyz.y);
 
@@ -785,13 +897,13 @@ void RoR::GfxActor::UpdateDebugView()
 
             // Wheel axle
             {
-                Ogre::Vector3 pos1_xyz = world2screen.Convert(wheels[i].wh_axis_node_1->AbsPosition);
+                Ogre::Vector3 pos1_xyz = m_debug_draw.Project(wheels[i].wh_axis_node_1);
                 if (pos1_xyz.z < 0.f)
                 {
                     ImVec2 pos(pos1_xyz.x, pos1_xyz.y);
                     drawlist->AddCircleFilled(pos, NODE_IMMOVABLE_RADIUS, NODE_COLOR);
                 }
-                Ogre::Vector3 pos2_xyz = world2screen.Convert(wheels[i].wh_axis_node_0->AbsPosition);
+                Ogre::Vector3 pos2_xyz = m_debug_draw.Project(wheels[i].wh_axis_node_0);
                 if (pos2_xyz.z < 0.f)
                 {
                     ImVec2 pos(pos2_xyz.x, pos2_xyz.y);
@@ -829,13 +941,13 @@ void RoR::GfxActor::UpdateDebugView()
 
             // Reference arm
             {
-                Ogre::Vector3 pos1_xyz = world2screen.Convert(wheels[i].wh_arm_node->AbsPosition);
+                Ogre::Vector3 pos1_xyz = m_debug_draw.Project(wheels[i].wh_arm_node);
                 if (pos1_xyz.z < 0.f)
                 {
                     ImVec2 pos(pos1_xyz.x, pos1_xyz.y);
                     drawlist->AddCircleFilled(pos, NODE_IMMOVABLE_RADIUS, NODE_IMMOVABLE_COLOR);
                 }
-                Ogre::Vector3 pos2_xyz = world2screen.Convert(wheels[i].wh_near_attach_node->AbsPosition);
+                Ogre::Vector3 pos2_xyz = m_debug_draw.Project(wheels[i].wh_near_attach_node);
                 if (pos2_xyz.z < 0.f)
                 {
                     ImVec2 pos(pos2_xyz.x, pos2_xyz.y);
@@ -871,9 +983,9 @@ void RoR::GfxActor::UpdateDebugView()
 #endif
             // Projected reference arm & error arm
             {
-                Ogre::Vector3 pos1_xyz = world2screen.Convert(wheels[i].wh_near_attach_node->AbsPosition);
+                Ogre::Vector3 pos1_xyz = m_debug_draw.Project(wheels[i].wh_near_attach_node);
                 Ogre::Vector3 pos2_xyz = world2screen.Convert(wheels[i].wh_near_attach_node->AbsPosition + radius);
-                Ogre::Vector3 pos3_xyz = world2screen.Convert(wheels[i].wh_arm_node->AbsPosition);
+                Ogre::Vector3 pos3_xyz = m_debug_draw.Project(wheels[i].wh_arm_node);
                 if (pos2_xyz.z < 0.f)
                 {
                     ImVec2 pos(pos2_xyz.x, pos2_xyz.y);
@@ -896,7 +1008,7 @@ void RoR::GfxActor::UpdateDebugView()
             {
                 Ogre::Vector3 cforce = wheels[i].debug_scaled_cforce;
                 {
-                    Ogre::Vector3 pos1_xyz = world2screen.Convert(wheels[i].wh_arm_node->AbsPosition);
+                    Ogre::Vector3 pos1_xyz = m_debug_draw.Project(wheels[i].wh_arm_node);
                     Ogre::Vector3 pos2_xyz = world2screen.Convert(wheels[i].wh_arm_node->AbsPosition - cforce);
                     if ((pos1_xyz.z < 0.f) && (pos2_xyz.z < 0.f))
                     {
@@ -906,7 +1018,7 @@ void RoR::GfxActor::UpdateDebugView()
                     }
                 }
                 {
-                    Ogre::Vector3 pos1_xyz = world2screen.Convert(wheels[i].wh_near_attach_node->AbsPosition);
+                    Ogre::Vector3 pos1_xyz = m_debug_draw.Project(wheels[i].wh_near_attach_node);
                     Ogre::Vector3 pos2_xyz = world2screen.Convert(wheels[i].wh_near_attach_node->AbsPosition + cforce);
                     if ((pos1_xyz.z < 0.f) && (pos2_xyz.z < 0.f))
                     {
@@ -1010,8 +1122,8 @@ void RoR::GfxActor::UpdateDebugView()
             if (!(beams[i].bounded == SHOCK1 || beams[i].bounded == SHOCK2 || beams[i].bounded == SHOCK3))
                 continue;
 
-            Ogre::Vector3 pos1_xyz = world2screen.Convert(beams[i].p1->AbsPosition);
-            Ogre::Vector3 pos2_xyz = world2screen.Convert(beams[i].p2->AbsPosition);
+            Ogre::Vector3 pos1_xyz = m_debug_draw.Project(beams[i].p1);
+            Ogre::Vector3 pos2_xyz = m_debug_draw.Project(beams[i].p2);
 
             if (pos1_xyz.z < 0.f)
             {
@@ -1034,7 +1146,7 @@ void RoR::GfxActor::UpdateDebugView()
         }
         for (auto id : node_ids)
         {
-            Ogre::Vector3 pos_xyz = world2screen.Convert(m_actor->ar_nodes[id].AbsPosition);
+            Ogre::Vector3 pos_xyz = m_debug_draw.Project(&m_actor->ar_nodes[id]);
             if (pos_xyz.z < 0.f)
             {
                 ImVec2 pos_xy(pos_xyz.x, pos_xyz.y);
@@ -1052,8 +1164,8 @@ void RoR::GfxActor::UpdateDebugView()
             if (!(beams[i].bounded == SHOCK1 || beams[i].bounded == SHOCK2 || beams[i].bounded == SHOCK3))
                 continue;
 
-            Ogre::Vector3 pos1_xyz = world2screen.Convert(beams[i].p1->AbsPosition);
-            Ogre::Vector3 pos2_xyz = world2screen.Convert(beams[i].p2->AbsPosition);
+            Ogre::Vector3 pos1_xyz = m_debug_draw.Project(beams[i].p1);
+            Ogre::Vector3 pos2_xyz = m_debug_draw.Project(beams[i].p2);
             Ogre::Vector3 pos_xyz  = pos1_xyz.midPoint(pos2_xyz);
 
             if (pos_xyz.z < 0.f)
@@ -1092,8 +1204,8 @@ void RoR::GfxActor::UpdateDebugView()
         const size_t num_rotators = static_cast<size_t>(m_actor->ar_num_rotators);
         for (int i = 0; i < num_rotators; i++)
         {
-            Ogre::Vector3 pos1_xyz = world2screen.Convert(nodes[rotators[i].axis1].AbsPosition);
-            Ogre::Vector3 pos2_xyz = world2screen.Convert(nodes[rotators[i].axis2].AbsPosition);
+            Ogre::Vector3 pos1_xyz = m_debug_draw.Project(&nodes[rotators[i].axis1]);
+            Ogre::Vector3 pos2_xyz = m_debug_draw.Project(&nodes[rotators[i].axis2]);
 
             // Rotator axle
             {
@@ -1149,7 +1261,7 @@ void RoR::GfxActor::UpdateDebugView()
                     ImU32 node_color = Ogre::ColourValue(0.33f, 0.33f, 0.33f, j < 2 ? 1.0f : 0.5f).getAsABGR();
                     ImU32 beam_color = Ogre::ColourValue(0.33f, 0.33f, 0.33f, j < 2 ? 1.0f : 0.5f).getAsABGR();
 
-                    Ogre::Vector3 pos3_xyz = world2screen.Convert(nodes[rotators[i].nodes1[j]].AbsPosition);
+                    Ogre::Vector3 pos3_xyz = m_debug_draw.Project(&nodes[rotators[i].nodes1[j]]);
                     if (pos3_xyz.z < 0.f)
                     {
                         ImVec2 pos(pos3_xyz.x, pos3_xyz.y);
@@ -1170,7 +1282,7 @@ void RoR::GfxActor::UpdateDebugView()
                     ImU32 node_color = Ogre::ColourValue(1.00f, 0.87f, 0.27f, j < 2 ? 1.0f : 0.5f).getAsABGR();
                     ImU32 beam_color = Ogre::ColourValue(0.88f, 0.64f, 0.33f, j < 2 ? 1.0f : 0.5f).getAsABGR();
 
-                    Ogre::Vector3 pos3_xyz = world2screen.Convert(nodes[rotators[i].nodes2[j]].AbsPosition);
+                    Ogre::Vector3 pos3_xyz = m_debug_draw.Project(&nodes[rotators[i].nodes2[j]]);
                     if (pos3_xyz.z < 0.f)
                     {
                         ImVec2 pos(pos3_xyz.x, pos3_xyz.y);
@@ -1302,8 +1414,8 @@ void RoR::GfxActor::UpdateDebugView()
         {
             for (auto railsegment : railgroup->rg_segments)
             {
-                Ogre::Vector3 pos1 = world2screen.Convert(railsegment.rs_beam->p1->AbsPosition);
-                Ogre::Vector3 pos2 = world2screen.Convert(railsegment.rs_beam->p2->AbsPosition);
+                Ogre::Vector3 pos1 = m_debug_draw.Project(railsegment.rs_beam->p1);
+                Ogre::Vector3 pos2 = m_debug_draw.Project(railsegment.rs_beam->p2);
 
                 if (pos1.z < 0.f)
                 {
@@ -1324,7 +1436,7 @@ void RoR::GfxActor::UpdateDebugView()
         }
         for (auto id : node_ids)
         {
-            Ogre::Vector3 pos_xyz = world2screen.Convert(nodes[id].AbsPosition);
+            Ogre::Vector3 pos_xyz = m_debug_draw.Project(&nodes[id]);
             if (pos_xyz.z < 0.f)
             {
                 ImVec2 pos_xy(pos_xyz.x, pos_xyz.y);
@@ -1338,7 +1450,7 @@ void RoR::GfxActor::UpdateDebugView()
         for (auto slidenode :  m_actor->m_slidenodes)
         {
             auto id = slidenode.GetSlideNodeId();
-            Ogre::Vector3 pos_xyz = world2screen.Convert(nodes[id].AbsPosition);
+            Ogre::Vector3 pos_xyz = m_debug_draw.Project(&nodes[id]);
 
             if (pos_xyz.z < 0.f)
             {
@@ -1361,12 +1473,12 @@ void RoR::GfxActor::UpdateDebugView()
         const auto collcabs = m_actor->ar_collcabs;
         const auto num_collcabs = m_actor->ar_num_collcabs;
 
-        std::vector<std::pair<float, int>> render_cabs;
+        FrameVector<std::pair<float, int>> render_cabs;
         for (int i = 0; i < num_cabs; i++)
         {
-            Ogre::Vector3 pos1_xyz = world2screen.Convert(nodes[cabs[i*3+0]].AbsPosition);
-            Ogre::Vector3 pos2_xyz = world2screen.Convert(nodes[cabs[i*3+1]].AbsPosition);
-            Ogre::Vector3 pos3_xyz = world2screen.Convert(nodes[cabs[i*3+2]].AbsPosition);
+            Ogre::Vector3 pos1_xyz = m_debug_draw.Project(&nodes[cabs[i*3+0]]);
+            Ogre::Vector3 pos2_xyz = m_debug_draw.Project(&nodes[cabs[i*3+1]]);
+            Ogre::Vector3 pos3_xyz = m_debug_draw.Project(&nodes[cabs[i*3+2]]);
             if ((pos1_xyz.z < 0.f) && (pos2_xyz.z < 0.f) && (pos3_xyz.z < 0.f))
             {
                 float depth = pos1_xyz.z;
@@ -1378,7 +1490,7 @@ void RoR::GfxActor::UpdateDebugView()
         std::sort(render_cabs.begin(), render_cabs.end());
 
         // Cabs and contacters (which are part of a cab)
-        std::vector<int> node_ids;
+        FrameVector<bool> node_drawn(m_actor->ar_num_nodes, false);
         for (auto render_cab : render_cabs)
         {
             int i = render_cab.second;
@@ -1388,9 +1500,9 @@ void RoR::GfxActor::UpdateDebugView()
             ImU32 fill_color = Ogre::ColourValue(0.5f * coll, 0.5f * !buoy, 0.5f * (coll ^ buoy), 0.27f).getAsABGR();
             ImU32 beam_color = Ogre::ColourValue(0.5f * coll, 0.5f * !buoy, 0.5f * (coll ^ buoy), 0.53f).getAsABGR();
 
-            Ogre::Vector3 pos1_xyz = world2screen.Convert(nodes[cabs[i*3+0]].AbsPosition);
-            Ogre::Vector3 pos2_xyz = world2screen.Convert(nodes[cabs[i*3+1]].AbsPosition);
-            Ogre::Vector3 pos3_xyz = world2screen.Convert(nodes[cabs[i*3+2]].AbsPosition);
+            Ogre::Vector3 pos1_xyz = m_debug_draw.Project(&nodes[cabs[i*3+0]]);
+            Ogre::Vector3 pos2_xyz = m_debug_draw.Project(&nodes[cabs[i*3+1]]);
+            Ogre::Vector3 pos3_xyz = m_debug_draw.Project(&nodes[cabs[i*3+2]]);
             if ((pos1_xyz.z < 0.f) && (pos2_xyz.z < 0.f) && (pos3_xyz.z < 0.f))
             {
                 ImVec2 pos1_xy(pos1_xyz.x, pos1_xyz.y);
@@ -1402,9 +1514,9 @@ void RoR::GfxActor::UpdateDebugView()
             for (int k = 0; k < 3; k++)
             {
                 int id = cabs[i*3+k];
-                if (std::find(node_ids.begin(), node_ids.end(), id) == node_ids.end())
+                if (!node_drawn[id])
                 {
-                    Ogre::Vector3 pos_xyz = world2screen.Convert(nodes[id].AbsPosition);
+                    Ogre::Vector3 pos_xyz = m_debug_draw.Project(&nodes[id]);
                     if (pos_xyz.z < 0.f)
                     {
                         ImVec2 pos_xy(pos_xyz.x, pos_xyz.y);
@@ -1414,7 +1526,7 @@ void RoR::GfxActor::UpdateDebugView()
                         id_buf << id;
                         drawlist->AddText(pos_xy, NODE_TEXT_COLOR, id_buf.ToCStr());
                     }
-                    node_ids.push_back(id);
+                    node_drawn[id] = true;
                 }
             }
         }
@@ -1501,11 +1613,28 @@ void RoR::GfxActor::CycleDebugViews()
 
 void RoR::GfxActor::UpdateRods()
 {
+    if (m_rod_batches_dirty)
+    {
+        std::vector<uint16_t> batch_sizes(m_rod_batches.size(), 0);
+        for (BeamGfx& rod: m_gfx_beams)
+        {
+            rod.rod_batch_slot = batch_sizes[rod.rod_batch]++;
+        }
+        for (size_t i = 0; i < m_rod_batches.size(); i++)
+        {
+            m_rod_batches[i]->SetNumRods(batch_sizes[i]);
+        }
+        m_rod_batches_dirty = false;
+    }
+
     for (BeamGfx& rod: m_gfx_beams)
     {
-        rod.rod_scenenode->setVisible(rod.rod_is_visible);
+        RodBatch* batch = m_rod_batches[rod.rod_batch];
         if (!rod.rod_is_visible)
+        {
+            batch->HideRod(rod.rod_batch_slot);
             continue;
+        }
 
         NodeSB* nodes1 = this->GetSimNodeBuffer();
         Ogre::Vector3 pos1 = nodes1[rod.rod_node1].AbsPosition;
@@ -1516,9 +1645,15 @@ void RoR::GfxActor::UpdateRods()
         float beam_diameter = static_cast<float>(rod.rod_diameter_mm) * 0.001;
         float beam_length = pos1.distance(pos2);
 
-        rod.rod_scenenode->setPosition(pos1.midPoint(pos2));
-        rod.rod_scenenode->setScale(beam_diameter, beam_length, beam_diameter);
-        rod.rod_scenenode->setOrientation(GfxActor::SpecialGetRotationTo(Ogre::Vector3::UNIT_Y, (pos1 - pos2)));
+        batch->SetRod(rod.rod_batch_slot,
+            pos1.midPoint(pos2),
+            GfxActor::SpecialGetRotationTo(Ogre::Vector3::UNIT_Y, (pos1 - pos2)),
+            Ogre::Vector3(beam_diameter, beam_length, beam_diameter));
+    }
+
+    for (RodBatch* batch: m_rod_batches)
+    {
+        batch->UpdateBatch();
     }
 }
 
@@ -1639,6 +1774,8 @@ void RoR::GfxActor::UpdateSimDataBuffer()
     m_simbuf.simbuf_net_username = m_actor->m_net_username;
     m_simbuf.simbuf_net_colornum = m_actor->m_net_color_num;
     m_simbuf.simbuf_driveable = m_actor->ar_driveable;
+    m_simbuf.simbuf_net_reduced_detail = m_actor->m_net_reduced_detail;
+    m_simbuf.simbuf_net_nodes_updated = m_actor->m_net_nodes_updated;
 
     // Movement
     m_simbuf.simbuf_pos = m_actor->getRotationCenter();
@@ -1655,13 +1792,28 @@ void RoR::GfxActor::UpdateSimDataBuffer()
     }
 
     // Elements: nodes
-    m_simbuf.simbuf_nodes.resize(m_actor->ar_num_nodes);
-    for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+    // If the sim thread already made the snapshot and nothing moved the actor since (reset, teleport, network update), just swap it in.
+    if (m_simbuf_nodes_pending_ok &&
+        m_simbuf_nodes_pending.size() == static_cast<size_t>(m_actor->ar_num_nodes) &&
+        m_simbuf_nodes_pending[0].AbsPosition == m_actor->ar_nodes[0].AbsPosition)
     {
-        auto node = m_actor->ar_nodes[i];
-        m_simbuf.simbuf_nodes[i].AbsPosition = node.AbsPosition;
-        m_simbuf.simbuf_nodes[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        std::swap(m_simbuf.simbuf_nodes, m_simbuf_nodes_pending);
     }
+    else if (this->IsSimDataNodesUnchanged())
+    {
+        // Nothing moved the nodes since the last frame (paused or parked actor, network actor between updates), keep the buffer.
+    }
+    else
+    {
+        m_simbuf.simbuf_nodes.resize(m_actor->ar_num_nodes);
+        for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+        {
+            const node_t& node = m_actor->ar_nodes[i];
+            m_simbuf.simbuf_nodes[i].AbsPosition = node.AbsPosition;
+            m_simbuf.simbuf_nodes[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+        }
+    }
+    m_simbuf_nodes_pending_ok = false;
 
     for (NodeGfx& nx: m_gfx_nodes)
     {
@@ -1688,8 +1840,8 @@ void RoR::GfxActor::UpdateSimDataBuffer()
         m_simbuf.simbuf_airbrakes[i].simbuf_ab_ratio = m_actor->ar_airbrakes[i]->getRatio();
     }
 
-    // Elements: Command keys
-    for (int i = 1; i <= MAX_COMMANDS; ++i) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
+    // Elements: Command keys - only those read by prop animations, see `RegisterPropCommandKeys()`
+    for (int i: m_simbuf_commandkeys_used) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
     {
         m_simbuf.simbuf_commandkey[i].simbuf_cmd_value = m_actor->ar_command_key[i].commandValue;
     }
@@ -1797,43 +1949,117 @@ void RoR::GfxActor::UpdateSimDataBuffer()
 
 }
 
+void RoR::GfxActor::BufferNodesFromSimThread()
+{
+    // Runs on sim thread, so that the main thread doesn't have to copy nodes while the simulation is halted.
+    m_simbuf_nodes_pending.resize(m_actor->ar_num_nodes);
+    for (int i = 0; i < m_actor->ar_num_nodes; ++i)
+    {
+        const node_t& node = m_actor->ar_nodes[i];
+        m_simbuf_nodes_pending[i].AbsPosition = node.AbsPosition;
+        m_simbuf_nodes_pending[i].nd_has_contact = node.nd_has_ground_contact || node.nd_has_mesh_contact;
+    }
+    m_simbuf_nodes_pending_ok = (m_actor->ar_num_nodes > 0);
+}
+
+bool RoR::GfxActor::IsSimDataNodesUnchanged() const
+{
+    if (!m_initialized || m_actor->ar_num_nodes == 0 ||
+        m_simbuf.simbuf_nodes.size() != static_cast<size_t>(m_actor->ar_num_nodes))
+    {
+        return false;
+    }
+
+    if (m_actor->ar_state == ActorState::NETWORKED_OK)
+    {
+        // Node positions are only written by `Actor::calcNetwork()`, which reports it
+        return !m_actor->m_net_nodes_updated;
+    }
+
+    // Local actors are moved by physics (which leaves a snapshot, see `BufferNodesFromSimThread()`)
+    // or by resetting/teleporting/scaling, which always displaces the first or the last node.
+    const int last = m_actor->ar_num_nodes - 1;
+    return m_simbuf.simbuf_nodes[0].AbsPosition == m_actor->ar_nodes[0].AbsPosition &&
+           m_simbuf.simbuf_nodes[last].AbsPosition == m_actor->ar_nodes[last].AbsPosition;
+}
+
 bool RoR::GfxActor::IsActorLive() const
 {
     return (m_actor->ar_state < ActorState::LOCAL_SLEEPING);
 }
 
+bool RoR::GfxActor::IsNodeVisualsFrozen() const
+{
+    return (m_simbuf.simbuf_net_reduced_detail && !m_simbuf.simbuf_net_nodes_updated);
+}
+
 void RoR::GfxActor::UpdateCabMesh()
 {
+    if (this->IsNodeVisualsFrozen())
+        return;
+
     if ((m_cab_entity != nullptr) && (m_cab_mesh != nullptr))
     {
-        m_cab_scene_node->setPosition(m_cab_mesh->UpdateFlexObj());
+        if (!m_cab_mesh_computed)
+        {
+            m_cab_mesh->ComputeFlexObj();
+        }
+        m_cab_scene_node->setPosition(m_cab_mesh->UploadFlexObj());
     }
+    m_cab_mesh_computed = false;
 }
 
 void RoR::GfxActor::UpdateWheelVisuals()
 {
-    m_flexwheel_tasks.clear();
+    m_flexwheels_prepared.clear();
+
+    if (this->IsNodeVisualsFrozen())
+        return;
 
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_flex_mesh != nullptr && w.wx_flex_mesh->flexitPrepare())
         {
-            auto func = std::function<void()>([this, w]()
-                {
-                    w.wx_flex_mesh->flexitCompute();
-                });
-            auto task_handle = App::GetThreadPool()->RunTask(func);
-            m_flexwheel_tasks.push_back(task_handle);
+            m_flexwheels_prepared.push_back(w.wx_flex_mesh);
         }
     }
 }
 
-void RoR::GfxActor::FinishWheelUpdates()
+void RoR::GfxActor::ComputeVisuals(float dt_sec, bool animate_props)
 {
-    for (auto& task: m_flexwheel_tasks)
+    ROR_PROFILE_ZONE("GfxActor::ComputeVisuals", this->GetActorId());
+
+    for (Flexable* flex_mesh: m_flexwheels_prepared)
     {
-        task->join();
+        flex_mesh->flexitCompute();
     }
+
+    if (this->IsActorLive())
+    {
+        if (m_cab_mesh != nullptr && !this->IsNodeVisualsFrozen())
+        {
+            m_cab_mesh->ComputeFlexObj();
+            m_cab_mesh_computed = true;
+        }
+        m_wing_positions.resize(m_actor->ar_num_wings);
+        for (int i = 0; i < m_actor->ar_num_wings; ++i)
+        {
+            m_wing_positions[i] = m_actor->ar_wings[i].fa->updateVerticesGfx(this);
+        }
+        m_prop_anim_dt += dt_sec;
+        if (animate_props)
+        {
+            this->UpdatePropAnimations(m_prop_anim_dt);
+            m_prop_anim_dt = 0.f;
+        }
+    }
+}
+
+void RoR::GfxActor::FinishWheelUpdates()
+{
+    if (this->IsNodeVisualsFrozen())
+        return;
+
     for (WheelGfx& w: m_wheels)
     {
         if (w.wx_scenenode != nullptr && w.wx_flex_mesh != nullptr)
@@ -1875,7 +2101,7 @@ void RoR::GfxActor::UpdateAirbrakes()
     const size_t num_airbrakes = m_gfx_airbrakes.size();
     for (size_t i=0; i<num_airbrakes; ++i)
     {
-        AirbrakeGfx abx = m_gfx_airbrakes[i];
+        AirbrakeGfx& abx = m_gfx_airbrakes[i];
         const float ratio = m_simbuf.simbuf_airbrakes[i].simbuf_ab_ratio;
         const float maxangle = m_actor->ar_airbrakes[i]->getMaxAngle();
         Ogre::Vector3 ref_node_pos = m_simbuf.simbuf_nodes[m_gfx_airbrakes[i].abx_ref_node].AbsPosition;
@@ -1901,16 +2127,38 @@ void RoR::GfxActor::UpdateAirbrakes()
 // TODO: Also move the data structure + setup code to GfxActor ~ only_a_ptr, 05/2018
 void RoR::GfxActor::UpdateCParticles()
 {
+    // Switched off - emitters are disabled (see `Actor::toggleCustomParticles()`), nothing to aim
+    if (!m_actor->getCustomParticleMode())
+        return;
+
+    const float cull_dist = App::gfx_particles_cull_distance->getFloat();
+    const Ogre::Vector3 cam_pos = App::GetCameraManager()->GetCameraNode()->getPosition();
+
     //update custom particle systems
     for (int i = 0; i < m_actor->ar_num_custom_particles; i++)
     {
-        Ogre::Vector3 pos = m_simbuf.simbuf_nodes[m_actor->ar_custom_particles[i].emitterNode].AbsPosition;
-        Ogre::Vector3 dir = pos - m_simbuf.simbuf_nodes[m_actor->ar_custom_particles[i].directionNode].AbsPosition;
+        cparticle_t& cparticle = m_actor->ar_custom_particles[i];
+        Ogre::Vector3 pos = m_simbuf.simbuf_nodes[cparticle.emitterNode].AbsPosition;
+
+        // Distant emitters stop; particles already in the air live out their time
+        const bool culled = cull_dist > 0.f && pos.squaredDistance(cam_pos) > cull_dist * cull_dist;
+        if (culled != cparticle.culled)
+        {
+            cparticle.culled = culled;
+            for (int j = 0; j < cparticle.psys->getNumEmitters(); j++)
+            {
+                cparticle.psys->getEmitter(j)->setEnabled(cparticle.active && !culled);
+            }
+        }
+        if (culled || !cparticle.active)
+            continue;
+
+        Ogre::Vector3 dir = pos - m_simbuf.simbuf_nodes[cparticle.directionNode].AbsPosition;
         dir = fast_normalise(dir);
-        m_actor->ar_custom_particles[i].snode->setPosition(pos);
-        for (int j = 0; j < m_actor->ar_custom_particles[i].psys->getNumEmitters(); j++)
+        cparticle.snode->setPosition(pos);
+        for (int j = 0; j < cparticle.psys->getNumEmitters(); j++)
         {
-            m_actor->ar_custom_particles[i].psys->getEmitter(j)->setDirection(dir);
+            cparticle.psys->getEmitter(j)->setDirection(dir);
         }
     }
 }
@@ -1939,7 +2187,7 @@ void RoR::GfxActor::UpdateNetLabels(float dt)
         float y_offset = (m_simbuf.simbuf_aabb.getMaximum().y - m_simbuf.simbuf_pos.y) + (vlen / 100.0);
         Ogre::Vector3 scene_pos = m_simbuf.simbuf_pos + Ogre::Vector3::UNIT_Y * y_offset;
 
-    App::GetGfxScene()->DrawNetLabel(scene_pos, vlen, m_simbuf.simbuf_net_username, m_simbuf.simbuf_net_colornum);
+    App::GetGfxScene()->DrawNetLabel(m_net_label, scene_pos, vlen, m_simbuf.simbuf_net_username, m_simbuf.simbuf_net_colornum);
 
 }
 
@@ -2238,12 +2486,24 @@ void RoR::GfxActor::SetRenderdashActive(bool active)
     }
 }
 
-void RoR::GfxActor::UpdateRenderdashRTT()
+void RoR::GfxActor::UpdateRenderdashRTT(float dt_sec)
 {
-    if (m_renderdash != nullptr)
-    {
-        m_renderdash->getRenderTarget()->update();
-    }
+    // Manual updates don't check whether the texture is active; only the player's cockpit is
+    if (m_renderdash == nullptr || !m_renderdash->getRenderTarget()->isActive())
+        return;
+
+    // A full extra render pass; needles and lamps read fine at a lower rate
+    m_renderdash_timer += dt_sec;
+    const int fps = App::gfx_renderdash_fps->getInt();
+    if (fps > 0 && m_renderdash_timer < 1.f / fps)
+        return;
+
+    // The texture is only seen on the vehicle itself
+    if (!App::GetCameraManager()->GetCamera()->isVisible(m_simbuf.simbuf_aabb))
+        return;
+
+    m_renderdash_timer = 0.f;
+    m_renderdash->getRenderTarget()->update();
 }
 
 void RoR::GfxActor::SetBeaconsEnabled(bool beacon_light_is_active)
@@ -2341,73 +2601,146 @@ float UpdateSmoothShift(PropAnim& anim, float dt, float new_target_cstate)
     return anim.shifterSmooth;
 }
 
-void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, float dt)
+// Flags handled by `CalcPropAnimation()`; the rest is applied directly in `UpdatePropAnimations()`
+static const BitMask_t PROP_ANIM_FLAGS_CALCULATED = ~BitMask_t(PROP_ANIM_FLAG_EVENT | PROP_ANIM_FLAG_STEERING
+    | PROP_ANIM_FLAG_AILERONS | PROP_ANIM_FLAG_ELEVATORS | PROP_ANIM_FLAG_ARUDDER | PROP_ANIM_FLAG_PERMANENT);
+
+void RoR::GfxActor::UpdatePropAnimSources()
 {
-    // Note: This is not the same as 'animators' - those run on physics thread!
-    // ------------------------------------------------------------------------
+    PropAnimSources& src = m_prop_anim_sources;
 
-    //boat rudder
-    if (anim.animFlags & PROP_ANIM_FLAG_BRUDDER)
+    //boat rudder + throttle
+    if (m_prop_anim_flags_used & (PROP_ANIM_FLAG_BRUDDER | PROP_ANIM_FLAG_BTHROTTLE))
     {
-        size_t spi;
-        float ctmp = 0.0f;
-        for (spi = 0; spi < m_simbuf.simbuf_screwprops.size(); spi++)
+        src.screwprop_rudder = 0.f;
+        src.screwprop_throttle = 0.f;
+        for (ScrewpropSB& screwprop: m_simbuf.simbuf_screwprops)
         {
-            ctmp += m_simbuf.simbuf_screwprops[spi].simbuf_sp_rudder;
+            src.screwprop_rudder += screwprop.simbuf_sp_rudder;
+            src.screwprop_throttle += screwprop.simbuf_sp_throttle;
         }
-
-        if (spi > 0)
-            ctmp = ctmp / spi;
-        cstate = ctmp;
-        div++;
-    }
-
-    //boat throttle
-    if (anim.animFlags & PROP_ANIM_FLAG_BTHROTTLE)
-    {
-        size_t spi;
-        float ctmp = 0.0f;
-        for (spi = 0; spi < m_simbuf.simbuf_screwprops.size(); spi++)
+        if (m_simbuf.simbuf_screwprops.size() > 0)
         {
-            ctmp += m_simbuf.simbuf_screwprops[spi].simbuf_sp_throttle;
+            src.screwprop_rudder /= m_simbuf.simbuf_screwprops.size();
+            src.screwprop_throttle /= m_simbuf.simbuf_screwprops.size();
         }
-
-        if (spi > 0)
-            ctmp = ctmp / spi;
-        cstate = ctmp;
-        div++;
     }
 
     //differential lock status
-    if (anim.animFlags & PROP_ANIM_FLAG_DIFFLOCK)
+    if (m_prop_anim_flags_used & PROP_ANIM_FLAG_DIFFLOCK)
     {
         if (m_actor->m_num_wheel_diffs > 0) // read-only attribute - safe to read from here
         {
             switch (m_simbuf.simbuf_diff_type)
             {
             case DiffType::OPEN_DIFF:
-                cstate = 0.0f;
+                src.difflock = 0.0f;
                 break;
             case DiffType::SPLIT_DIFF:
-                cstate = 0.5f;
+                src.difflock = 0.5f;
                 break;
             case DiffType::LOCKED_DIFF:
-                cstate = 1.0f;
+                src.difflock = 1.0f;
                 break;
             default:;
             }
         }
         else // no axles/diffs avail, mode is split by default
-            cstate = 0.5f;
+            src.difflock = 0.5f;
+    }
+
+    //heading - rad2deg limitedrange  -1 to +1
+    src.heading = (m_simbuf.simbuf_rotation * 57.29578f) / 360.0f;
+
+    const Ogre::Vector3 node0_pos = this->GetSimNodeBuffer()[0].AbsPosition;
+    const Ogre::Vector3 node0_velo = m_simbuf.simbuf_node0_velo;
+    src.altitude = node0_pos.y;
+
+    //airspeed indicator
+    if (m_prop_anim_flags_used & PROP_ANIM_FLAG_AIRSPEED)
+    {
+        float ground_speed_kt = node0_velo.length() * 1.9438;
+        float altitude = node0_pos.y;
 
+        float sea_level_pressure = 101325; //in Pa
+
+        float airpressure = sea_level_pressure * pow(1.0 - 0.0065 * altitude / 288.15, 5.24947); //in Pa
+        float airdensity = airpressure * 0.0000120896;//1.225 at sea level
+        src.airspeed_kt = ground_speed_kt * sqrt(airdensity / 1.225);
+    }
+
+    //vvi indicator
+    src.vvi = node0_velo.y * 196.85;
+
+    //AOA
+    if (m_prop_anim_flags_used & PROP_ANIM_FLAG_AOA)
+    {
+        src.aoa = m_simbuf.simbuf_wing4_aoa / 25.f;
+        if ((node0_velo.length() * 1.9438) < 10.0f)
+            src.aoa = 0;
+    }
+
+    if (m_prop_anim_flags_used & (PROP_ANIM_FLAG_ROLL | PROP_ANIM_FLAG_PITCH))
+    {
+        Ogre::Vector3 cam_pos  = this->GetSimNodeBuffer()[m_actor->ar_main_camera_node_pos ].AbsPosition;
+        Ogre::Vector3 cam_roll = this->GetSimNodeBuffer()[m_actor->ar_main_camera_node_roll].AbsPosition;
+        Ogre::Vector3 cam_dir  = this->GetSimNodeBuffer()[m_actor->ar_main_camera_node_dir ].AbsPosition;
+        Ogre::Vector3 dirv = (cam_pos - cam_dir).normalisedCopy();
+
+        // roll
+        Ogre::Vector3 rollv = (cam_pos - cam_roll).normalisedCopy();
+        Ogre::Vector3 upv = dirv.crossProduct(-rollv);
+        float rollangle = asin(rollv.dotProduct(Ogre::Vector3::UNIT_Y));
+        // rad to deg
+        rollangle = Ogre::Math::RadiansToDegrees(rollangle);
+        // flip to other side when upside down
+        if (upv.y < 0)
+            rollangle = 180.0f - rollangle;
+        src.roll = rollangle / 180.0f;
+        // data output is -0.5 to 1.5, normalize to -1 to +1 without changing the zero position.
+        // this is vital for the animator beams and does not effect the animated props
+        if (src.roll >= 1.0f)
+            src.roll = src.roll - 2.0f;
+
+        // pitch - radian to degrees with a max cstate of +/- 1.0
+        float pitchangle = asin(dirv.dotProduct(Ogre::Vector3::UNIT_Y));
+        src.pitch = (Ogre::Math::RadiansToDegrees(pitchangle) / 90.0f);
+    }
+}
+
+void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, float dt)
+{
+    // Note: This is not the same as 'animators' - those run on physics thread!
+    // ------------------------------------------------------------------------
+
+    // Shared inputs are fetched by `UpdatePropAnimSources()` before the props are processed.
+    const PropAnimSources& src = m_prop_anim_sources;
+
+    //boat rudder
+    if (anim.animFlags & PROP_ANIM_FLAG_BRUDDER)
+    {
+        cstate = src.screwprop_rudder;
+        div++;
+    }
+
+    //boat throttle
+    if (anim.animFlags & PROP_ANIM_FLAG_BTHROTTLE)
+    {
+        cstate = src.screwprop_throttle;
+        div++;
+    }
+
+    //differential lock status
+    if (anim.animFlags & PROP_ANIM_FLAG_DIFFLOCK)
+    {
+        cstate = src.difflock;
         div++;
     }
 
     //heading
     if (anim.animFlags & PROP_ANIM_FLAG_HEADING)
     {
-        // rad2deg limitedrange  -1 to +1
-        cstate = (m_simbuf.simbuf_rotation * 57.29578f) / 360.0f;
+        cstate = src.heading;
         div++;
     }
 
@@ -2643,30 +2976,18 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
         }
     }
 
-    const Ogre::Vector3 node0_pos = this->GetSimNodeBuffer()[0].AbsPosition;
-    const Ogre::Vector3 node0_velo = m_simbuf.simbuf_node0_velo;
-
     //airspeed indicator
     if (anim.animFlags & PROP_ANIM_FLAG_AIRSPEED)
     {
-        float ground_speed_kt = node0_velo.length() * 1.9438;
-        float altitude = node0_pos.y;
-
-        float sea_level_pressure = 101325; //in Pa
-
-        float airpressure = sea_level_pressure * pow(1.0 - 0.0065 * altitude / 288.15, 5.24947); //in Pa
-        float airdensity = airpressure * 0.0000120896;//1.225 at sea level
-        float kt = ground_speed_kt * sqrt(airdensity / 1.225);
-        cstate -= kt / 100.0f;
+        cstate -= src.airspeed_kt / 100.0f;
         div++;
     }
 
     //vvi indicator
     if (anim.animFlags & PROP_ANIM_FLAG_VVI)
     {
-        float vvi = node0_velo.y * 196.85;
         // limit vvi scale to +/- 6m/s
-        cstate -= vvi / 6000.0f;
+        cstate -= src.vvi / 6000.0f;
         if (cstate >= 1.0f)
             cstate = 1.0f;
         if (cstate <= -1.0f)
@@ -2680,7 +3001,7 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
         //altimeter indicator 1k oscillating
         if (anim.animOpt3 == 3.0f)
         {
-            float altimeter = (node0_pos.y * 1.1811) / 360.0f;
+            float altimeter = (src.altitude * 1.1811) / 360.0f;
             int alti_int = int(altimeter);
             float alti_mod = (altimeter - alti_int);
             cstate -= alti_mod;
@@ -2689,7 +3010,7 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
         //altimeter indicator 10k oscillating
         if (anim.animOpt3 == 2.0f)
         {
-            float alti = node0_pos.y * 1.1811 / 3600.0f;
+            float alti = src.altitude * 1.1811 / 3600.0f;
             int alti_int = int(alti);
             float alti_mod = (alti - alti_int);
             cstate -= alti_mod;
@@ -2700,7 +3021,7 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
         //altimeter indicator 100k limited
         if (anim.animOpt3 == 1.0f)
         {
-            float alti = node0_pos.y * 1.1811 / 36000.0f;
+            float alti = src.altitude * 1.1811 / 36000.0f;
             cstate -= alti;
             if (cstate <= -1.0f)
                 cstate = -1.0f;
@@ -2711,10 +3032,7 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
     //AOA
     if (anim.animFlags & PROP_ANIM_FLAG_AOA)
     {
-        float aoa = m_simbuf.simbuf_wing4_aoa / 25.f;
-        if ((node0_velo.length() * 1.9438) < 10.0f)
-            aoa = 0;
-        cstate -= aoa;
+        cstate -= src.aoa;
         if (cstate <= -1.0f)
             cstate = -1.0f;
         if (cstate >= 1.0f)
@@ -2722,37 +3040,17 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
         div++;
     }
 
-    Ogre::Vector3 cam_pos  = this->GetSimNodeBuffer()[m_actor->ar_main_camera_node_pos ].AbsPosition;
-    Ogre::Vector3 cam_roll = this->GetSimNodeBuffer()[m_actor->ar_main_camera_node_roll].AbsPosition;
-    Ogre::Vector3 cam_dir  = this->GetSimNodeBuffer()[m_actor->ar_main_camera_node_dir ].AbsPosition;
-
     // roll
     if (anim.animFlags & PROP_ANIM_FLAG_ROLL)
     {
-        Ogre::Vector3 rollv = (cam_pos - cam_roll).normalisedCopy();
-        Ogre::Vector3 dirv = (cam_pos - cam_dir).normalisedCopy();
-        Ogre::Vector3 upv = dirv.crossProduct(-rollv);
-        float rollangle = asin(rollv.dotProduct(Ogre::Vector3::UNIT_Y));
-        // rad to deg
-        rollangle = Ogre::Math::RadiansToDegrees(rollangle);
-        // flip to other side when upside down
-        if (upv.y < 0)
-            rollangle = 180.0f - rollangle;
-        cstate = rollangle / 180.0f;
-        // data output is -0.5 to 1.5, normalize to -1 to +1 without changing the zero position.
-        // this is vital for the animator beams and does not effect the animated props
-        if (cstate >= 1.0f)
-            cstate = cstate - 2.0f;
+        cstate = src.roll;
         div++;
     }
 
     // pitch
     if (anim.animFlags & PROP_ANIM_FLAG_PITCH)
     {
-        Ogre::Vector3 dirv = (cam_pos - cam_dir).normalisedCopy();
-        float pitchangle = asin(dirv.dotProduct(Ogre::Vector3::UNIT_Y));
-        // radian to degrees with a max cstate of +/- 1.0
-        cstate = (Ogre::Math::RadiansToDegrees(pitchangle) / 90.0f);
+        cstate = src.pitch;
         div++;
     }
 
@@ -2777,6 +3075,11 @@ void RoR::GfxActor::CalcPropAnimation(PropAnim& anim, float& cstate, int& div, f
 
 void RoR::GfxActor::UpdatePropAnimations(float dt)
 {
+    if (m_simbuf.simbuf_net_reduced_detail)
+        return; // Far away remote actor, nobody will notice
+
+    this->UpdatePropAnimSources();
+
     int prop_anim_key_index = 0;
 
     for (Prop& prop: m_props)
@@ -2791,7 +3094,8 @@ void RoR::GfxActor::UpdatePropAnimations(float dt)
             float cstate = 0.0f;
             int div = 0.0f;
 
-            this->CalcPropAnimation(anim, cstate, div, dt);
+            if (anim.animFlags & PROP_ANIM_FLAGS_CALCULATED)
+                this->CalcPropAnimation(anim, cstate, div, dt);
 
             // key triggered animations - state determined in simulation
             if (anim.animFlags & ANIM_FLAG_EVENT)
@@ -2987,21 +3291,41 @@ void RoR::GfxActor::SortFlexbodies()
     std::sort(m_flexbodies.begin(), m_flexbodies.end(), [](FlexBody* a, FlexBody* b) { return a->getVertexCount() > b->getVertexCount(); });
 }
 
-void RoR::GfxActor::UpdateFlexbodies()
+void RoR::GfxActor::RegisterPropCommandKeys()
+{
+    // Only sequential shifters read command keys, see `CalcPropAnimation()`
+    m_simbuf_commandkeys_used.clear();
+    for (Prop& prop: m_props)
+    {
+        for (PropAnim& anim: prop.pp_animations)
+        {
+            if ((anim.animFlags & PROP_ANIM_FLAG_SHIFTER) && anim.animOpt3 == ShifterPropAnim::SHIFTERSEQ)
+            {
+                for (float limit: { anim.lower_limit, anim.upper_limit })
+                {
+                    const int key = static_cast<int>(limit);
+                    if (limit >= 1.0f && key <= MAX_COMMANDS &&
+                        std::find(m_simbuf_commandkeys_used.begin(), m_simbuf_commandkeys_used.end(), key) == m_simbuf_commandkeys_used.end())
+                    {
+                        m_simbuf_commandkeys_used.push_back(key);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void RoR::GfxActor::UpdateFlexbodies(std::vector<FlexBody*>& out_flexbodies)
 {
-    m_flexbody_tasks.clear();
+    if (this->IsNodeVisualsFrozen())
+        return;
 
     for (FlexBody* fb: m_flexbodies)
     {
         const int camera_mode = fb->getCameraMode();
         if ((camera_mode == -2) || (camera_mode == m_simbuf.simbuf_cur_cinecam))
         {
-            auto func = std::function<void()>([fb]()
-                {
-                    fb->computeFlexbody();
-                });
-            auto task_handle = App::GetThreadPool()->RunTask(func);
-            m_flexbody_tasks.push_back(task_handle);
+            out_flexbodies.push_back(fb);
         }
         else
         {
@@ -3028,10 +3352,9 @@ void RoR::GfxActor::SetFlexbodyVisible(bool visible)
 
 void RoR::GfxActor::FinishFlexbodyTasks()
 {
-    for (auto& task: m_flexbody_tasks)
-    {
-        task->join();
-    }
+    if (this->IsNodeVisualsFrozen())
+        return;
+
     for (FlexBody* fb: m_flexbodies)
     {
         fb->updateFlexbodyVertexBuffers();
@@ -3060,6 +3383,8 @@ void RoR::GfxActor::UpdateFlares(float dt_sec, bool is_player)
     // ------------------------------------------------------------------------------------------
 
     NodeSB* nodes = this->GetSimNodeBuffer();
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const bool use_light_budget = (App::gfx_flares_light_budget->getInt() > 0);
 
     int num_flares = static_cast<int>(m_actor->ar_flares.size());
     for (int i=0; i<num_flares; ++i)
@@ -3086,6 +3411,8 @@ void RoR::GfxActor::UpdateFlares(float dt_sec, bool is_player)
         if (vlen > 500.0)
         {
             flare.snode->setVisible(false);
+            if (flare.light && use_light_budget)
+                flare.light->setVisible(false);
             continue;
         }
         //normalize
@@ -3104,10 +3431,20 @@ void RoR::GfxActor::UpdateFlares(float dt_sec, bool is_player)
             flare.light->setPosition(mposition - 0.2 * amplitude * normal);
             // point the real light towards the ground a bit
             flare.light->setDirection(-normal - Ogre::Vector3(0, 0.2, 0));
+
+            // Lights which can't reach anything in view are off; the rest compete for the budget in `GfxScene`
+            if (use_light_budget && flare.light->isVisible())
+            {
+                const float range = flare.light->getAttenuationRange();
+                if (camera->isVisible(Ogre::Sphere(flare.light->getPosition(), range)))
+                    App::GetGfxScene()->RegisterFlareLight(flare.light, range / std::max(vlen, 1.f));
+                else
+                    flare.light->setVisible(false);
+            }
         }
         if (flare.intensity > 0)
         {
-            if (amplitude > 0)
+            if (amplitude > 0 && camera->isVisible(Ogre::Sphere(mposition, amplitude * fsize)))
             {
                 flare.bbs->setDefaultDimensions(amplitude * fsize, amplitude * fsize);
                 flare.snode->setVisible(true);
@@ -3144,9 +3481,9 @@ void RoR::GfxActor::SetCastShadows(bool value)
     }
 
     // Softbody beams
-    for (BeamGfx& rod: m_gfx_beams)
+    for (RodBatch* batch: m_rod_batches)
     {
-        static_cast<Ogre::Entity*>(rod.rod_scenenode->getAttachedObject(0))->setCastShadows(value);
+        batch->SetCastShadows(value);
     }
 
     // Flexbody meshes
@@ -3177,6 +3514,53 @@ void RoR::GfxActor::SetAllMeshesVisible(bool visible)
     this->SetAeroEnginesVisible(visible);
 }
 
+// internal helper
+static void SetSceneNodeListener(Ogre::SceneNode* node, Ogre::MovableObject::Listener* listener)
+{
+    if (node == nullptr)
+        return;
+
+    for (unsigned short i = 0; i < node->numAttachedObjects(); i++)
+    {
+        node->getAttachedObject(i)->setListener(listener);
+    }
+    for (unsigned short i = 0; i < node->numChildren(); i++)
+    {
+        SetSceneNodeListener(static_cast<Ogre::SceneNode*>(node->getChild(i)), listener);
+    }
+}
+
+void RoR::GfxActor::SetOcclusionListener(Ogre::MovableObject::Listener* listener)
+{
+    SetSceneNodeListener(m_cab_scene_node, listener);
+    SetSceneNodeListener(m_gfx_beams_parent_scenenode, listener);
+    for (WheelGfx& w: m_wheels)
+    {
+        SetSceneNodeListener(w.wx_scenenode, listener);
+        if (w.wx_is_meshwheel && ((FlexMeshWheel*)(w.wx_flex_mesh))->getRimEntity() != nullptr)
+        {
+            ((FlexMeshWheel*)(w.wx_flex_mesh))->getRimEntity()->setListener(listener);
+        }
+    }
+    for (Prop& prop: m_props)
+    {
+        SetSceneNodeListener(prop.pp_scene_node, listener);
+        SetSceneNodeListener(prop.pp_wheel_scene_node, listener);
+    }
+    for (FlexBody* fb: m_flexbodies)
+    {
+        fb->getEntity()->setListener(listener);
+    }
+    for (int i = 0; i < m_actor->ar_num_wings; ++i)
+    {
+        SetSceneNodeListener(m_actor->ar_wings[i].cnode, listener);
+    }
+    for (AirbrakeGfx& abx: m_gfx_airbrakes)
+    {
+        SetSceneNodeListener(abx.abx_scenenode, listener);
+    }
+}
+
 void RoR::GfxActor::SetWingsVisible(bool visible)
 {
     for (int i = 0; i < m_actor->ar_num_wings; ++i)
@@ -3192,11 +3576,12 @@ void RoR::GfxActor::SetWingsVisible(bool visible)
 
 void RoR::GfxActor::UpdateWingMeshes()
 {
-    for (int i = 0; i < m_actor->ar_num_wings; ++i)
+    const int num_wings = std::min(m_actor->ar_num_wings, static_cast<int>(m_wing_positions.size()));
+    for (int i = 0; i < num_wings; ++i)
     {
         wing_t& wing = m_actor->ar_wings[i];
-        wing.cnode->setPosition(wing.fa->updateVerticesGfx(this));
-        wing.fa->uploadVertices();
+        wing.cnode->setPosition(m_wing_positions[i]);
+        wing.fa->uploadVertices(); // Panels which didn't deform keep their buffer
     }
 }
 
@@ -3224,6 +3609,7 @@ void RoR::GfxActor::RemoveBeam(int beam_index)
         if (itor->rod_beam_index == beam_index)
         {
             m_gfx_beams.erase(itor);
+            m_rod_batches_dirty = true;
             return;
         }
         itor++;
@@ -28,13 +28,13 @@
 
 #include "Actor.h"
 #include "AutoPilot.h"
+#include "DebugDrawBatch.h"
 #include "Differentials.h"
 #include "ForwardDeclarations.h"
 #include "GfxData.h"
 #include "RigDef_Prerequisites.h"
 #include "SimBuffers.h"
 #include "SurveyMapEntity.h"
-#include "ThreadPool.h" // class Task
 
 #include <OgreAxisAlignedBox.h>
 #include <OgreColourValue.h>
@@ -66,6 +66,7 @@ public:
     void                 RegisterCabMaterial(Ogre::MaterialPtr mat, Ogre::MaterialPtr mat_trans);
     void                 RegisterCabMesh(Ogre::Entity* ent, Ogre::SceneNode* snode, FlexObj* flexobj);
     void                 SortFlexbodies();
+    void                 RegisterPropCommandKeys(); //!< Picks command keys which prop animations read; others aren't copied to the simbuffer.
 
     // Visual changes
 
@@ -93,41 +94,47 @@ public:
     void                 SetFlexbodiesVisible(bool visible);
     void                 SetPropsVisible(bool visible);
     void                 SetAeroEnginesVisible(bool visible);
+    void                 SetOcclusionListener(Ogre::MovableObject::Listener* listener); //!< Installs `GfxOcclusion`'s listener on all meshes; nullptr removes it
 
     // Visual updates
 
     void                 UpdateVideoCameras(float dt_sec);
     void                 UpdateParticles(float dt_sec);
     void                 UpdateRods();
-    void                 UpdateWheelVisuals();
-    void                 UpdateFlexbodies();
+    void                 UpdateWheelVisuals(); //!< Moves the rims; flexwheels to be deformed are picked up by `ComputeVisuals()`
+    void                 ComputeVisuals(float dt_sec, bool animate_props); //!< CPU-only part of the frame update; doesn't touch OGRE, so different actors may run it in parallel
+    void                 UpdateFlexbodies(std::vector<FlexBody*>& out_flexbodies); //!< Collects visible flexbodies; they're deformed in one batch by `GfxScene`
     void                 UpdateDebugView();
     void                 UpdateCabMesh();
-    void                 UpdateWingMeshes();
+    void                 UpdateWingMeshes(); //!< Places the wings and uploads vertices computed by `ComputeVisuals()`
     void                 UpdateBeaconFlare(Prop & prop, float dt, bool is_player_actor);
     void                 UpdateProps(float dt, bool is_player_actor);
     void                 UpdatePropAnimations(float dt);
+    void                 UpdatePropAnimSources(); //!< Fetches the inputs shared by animated props once per frame, see `PropAnimSources`
     void                 UpdateAirbrakes();
     void                 UpdateCParticles();
     void                 UpdateAeroEngines();
     void                 UpdateNetLabels(float dt);
     void                 UpdateFlares(float dt_sec, bool is_player);
-    void                 UpdateRenderdashRTT ();
+    void                 UpdateRenderdashRTT (float dt_sec);
 
     // SimBuffers
 
     void                 UpdateSimDataBuffer(); //!< Copies sim. data from `Actor` to `GfxActor` for later update
+    void                 BufferNodesFromSimThread(); //!< Pre-fills node snapshot on sim thread at the end of the physics task; picked up by `UpdateSimDataBuffer()`
     ActorSB&             GetSimDataBuffer() { return m_simbuf; }
     NodeSB*              GetSimNodeBuffer() { return m_simbuf.simbuf_nodes.data(); }
 
     // Internal updates
 
     void                 FinishWheelUpdates();
-    void                 FinishFlexbodyTasks();
+    void                 FinishFlexbodyTasks(); //!< Uploads deformed flexbodies; `GfxScene` must have finished the batch
 
     // Helpers
 
     bool                 IsActorLive() const; //!< Should the visuals be updated for this actor?
+    bool                 IsSimDataNodesUnchanged() const; //!< Can `UpdateSimDataBuffer()` keep last frame's node positions?
+    bool                 IsNodeVisualsFrozen() const; //!< Remote actor at reduced detail whose nodes didn't move; skip node-driven meshes
     bool                 IsActorInitialized() const  { return m_initialized; } //!< Temporary TODO: Remove once the spawn routine is fixed
     void                 InitializeActor() { m_initialized = true; } //!< Temporary TODO: Remove once the spawn routine is fixed
     void                 CalculateDriverPos(Ogre::Vector3& out_pos, Ogre::Quaternion& out_rot);
@@ -154,6 +161,10 @@ private:
 
     static Ogre::Quaternion SpecialGetRotationTo(const Ogre::Vector3& src, const Ogre::Vector3& dest);
 
+    void                 AttachVideoCamTexture(VideoCamera& vidcam); //!< Takes a render texture from `GfxScene`'s pool
+    void                 DetachVideoCamTexture(VideoCamera& vidcam); //!< Returns the render texture to `GfxScene`'s pool
+    void                 RenderVideoCamera(VideoCamera& vidcam, const Ogre::Sphere* surface); //!< Skips if not due or not on screen; `surface` is optional
+
     // Static info
     ActorPtr                      m_actor = nullptr;
     std::string                 m_custom_resource_group;
@@ -164,26 +175,51 @@ private:
     bool                        m_initialized = false;
     VideoCamState               m_vidcam_state = VideoCamState::VCSTATE_ENABLED_ONLINE;
     DebugViewType               m_debug_view = DebugViewType::DEBUGVIEW_NONE;
+    DebugDrawBatch              m_debug_draw;
     DebugViewType               m_last_debug_view = DebugViewType::DEBUGVIEW_SKELETON; // intentional
     bool                        m_beaconlight_active = true; // 'true' will trigger SetBeaconsEnabled(false) on the first buffer update
     float                       m_prop_anim_crankfactor_prev = 0.f;
     float                       m_prop_anim_shift_timer = 0.f;
     int                         m_prop_anim_prev_gear = 0;
-
-    // Threaded tasks
-    std::vector<std::shared_ptr<Task>> m_flexwheel_tasks;
-    std::vector<std::shared_ptr<Task>> m_flexbody_tasks;
+    BitMask_t                   m_prop_anim_flags_used = 0; //!< Union of `PropAnim::animFlags` of all props, filled by `ActorSpawner`
+
+    /// Stateless prop animation inputs, computed once per frame by `UpdatePropAnimSources()`
+    /// and shared by all props which animate with them (dashboards often have several gauges per source).
+    struct PropAnimSources
+    {
+        float screwprop_rudder = 0.f;
+        float screwprop_throttle = 0.f;
+        float difflock = 0.f;
+        float heading = 0.f;
+        float altitude = 0.f;
+        float airspeed_kt = 0.f;
+        float vvi = 0.f;
+        float aoa = 0.f;
+        float roll = 0.f;
+        float pitch = 0.f;
+    }                           m_prop_anim_sources;
+
+    // Computed by `ComputeVisuals()`, applied on main thread
+    std::vector<Flexable*>      m_flexwheels_prepared;
+    bool                        m_cab_mesh_computed = false;
+    std::vector<Ogre::Vector3>  m_wing_positions; //!< Scene node positions, vertices are kept by the `FlexAirfoil`s
+    float                       m_prop_anim_dt = 0.f; //!< Time since props were last animated; they may skip frames when far away
 
     // Elements
     std::vector<NodeGfx>        m_gfx_nodes;
     std::vector<BeamGfx>        m_gfx_beams;
+    std::vector<RodBatch*>      m_rod_batches; //!< Rods drawn in one batch per material
+    bool                        m_rod_batches_dirty = true; //!< Rods were added/removed; slots must be reassigned
     std::vector<AirbrakeGfx>    m_gfx_airbrakes;
     std::vector<Prop>           m_props;
     std::vector<FlexBody*>      m_flexbodies;
     std::vector<WheelGfx>       m_wheels;
     std::vector<VideoCamera>    m_videocameras;
+    int                         m_vidcam_next_render = 0; //!< Round-robin when the frame budget limits video cameras
     std::vector<FlareMaterial>  m_flare_materials;
+    NetLabelCache               m_net_label;
     RoR::Renderdash*            m_renderdash = nullptr;
+    float                       m_renderdash_timer = 0.f;  //!< Time since the last update of the texture
     
     // Particles
     DustPool*                   m_particles_drip = nullptr;
@@ -208,6 +244,9 @@ private:
     SurveyMapEntity             m_surveymap_entity;
 
     ActorSB                     m_simbuf;
+    std::vector<NodeSB>         m_simbuf_nodes_pending;          //!< Written by sim thread, swapped into `m_simbuf` while sim is halted
+    bool                        m_simbuf_nodes_pending_ok = false;
+    std::vector<int>            m_simbuf_commandkeys_used;       //!< See `RegisterPropCommandKeys()`
 };
 
 /// @} // addtogroup Gfx
@@ -231,8 +231,14 @@ struct VideoCamera
     Ogre::MaterialPtr    vcam_material;
     std::string          vcam_off_tex_name;                         //!< Used when videocamera is offline
     Ogre::Camera*        vcam_ogre_camera    = nullptr;
-    Ogre::RenderTexture* vcam_render_target  = nullptr;
-    Ogre::TexturePtr     vcam_render_tex;
+    Ogre::RenderTexture* vcam_render_target  = nullptr;             //!< Only while online, see `GfxScene::AcquireVideoCamTexture()`
+    Ogre::TexturePtr     vcam_render_tex;                           //!< Only while online
+    unsigned int         vcam_tex_width      = 0;
+    unsigned int         vcam_tex_height     = 0;
+    float                vcam_tex_uscale     = 1.f;                 //!< -1 flips mirrors left<>right
+    Ogre::uint32         vcam_visibility_mask = 0xFFFFFFFF;
+    float                vcam_res_scale      = 1.f;                 //!< Fraction of the texture rendered, by on-screen size of the surface
+    float                vcam_update_timer   = 0.f;                 //!< Time since the last render
     Ogre::SceneNode*     vcam_debug_node     = nullptr;
     Ogre::RenderWindow*  vcam_render_window  = nullptr;
     Ogre::SceneNode*     vcam_prop_scenenode = nullptr;             //!< Only for VCTYPE_MIRROR_PROP_*
@@ -265,8 +271,8 @@ struct NodeGfx
 /// Visuals of softbody beam (`beam_t` struct); Partially updated along with SimBuffer
 struct BeamGfx
 {
-    // We don't keep pointer to the Ogre::Entity - we rely on the SceneNode keeping it attached all the time.
-    Ogre::SceneNode* rod_scenenode       = nullptr;
+    uint16_t         rod_batch           = 0;                    //!< Index into `GfxActor::m_rod_batches`, by material
+    uint16_t         rod_batch_slot      = 0;                    //!< Position within the batch, assigned by `GfxActor::UpdateRods()`
     uint16_t         rod_beam_index      = 0;
     uint16_t         rod_diameter_mm     = 0;                    //!< Diameter in millimeters
 
@@ -301,6 +307,17 @@ struct FlareMaterial // materialflares
     Ogre::ColourValue emissive_color;
 };
 
+/// Caption of a multiplayer name label; rebuilt by `GfxScene::DrawNetLabel()` only when the shown text changes.
+struct NetLabelCache
+{
+    std::string       nlc_nick;
+    std::string       nlc_caption;
+    int               nlc_shown_dist = 0;  //!< Meters, negative = tenths of km, 0 = not shown (close by)
+    float             nlc_font_size = 0.f; //!< Font size the text was measured with
+    float             nlc_text_width = 0.f;
+    float             nlc_text_height = 0.f;
+};
+
 /// @} // addtogroup Gfx
 
 } // namespace RoR
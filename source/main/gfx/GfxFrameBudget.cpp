@@ -0,0 +1,115 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GfxFrameBudget.h"
+
+#include "Application.h"
+#include "SimProfiler.h"
+
+#include <algorithm>
+
+using namespace RoR;
+
+static const float SMOOTHING = 0.1f;           // Weight of the newest sample in running averages
+static const float RELEASE_HEADROOM = 0.8f;    // A throttled task is released only if it fits with 20% to spare, to avoid flip-flopping
+
+void GfxFrameBudget::ReportFrameWorkTime(float sec)
+{
+    m_frame_ms += (sec * 1000.f - m_frame_ms) * SMOOTHING;
+}
+
+void GfxFrameBudget::BeginFrame()
+{
+    m_frame_number++;
+
+    // Fold the last frame's measurements into running averages
+    float tasks_ms = 0.f;
+    for (TaskState& t: m_tasks)
+    {
+        if (t.frame_units > 0)
+        {
+            t.unit_ms += (t.frame_cost_ms / t.frame_units - t.unit_ms) * SMOOTHING;
+            if (!t.requested_units)
+            {
+                t.full_units = t.frame_units; // Tasks without units do all of their work whenever they're due
+            }
+        }
+        tasks_ms += t.frame_cost_ms;
+        t.frame_cost_ms = 0.f;
+        t.frame_units = 0;
+    }
+    m_tasks_ms += (tasks_ms - m_tasks_ms) * SMOOTHING;
+
+    const float target_ms = App::gfx_frame_budget_ms->getFloat();
+    if (target_ms <= 0.f)
+    {
+        for (TaskState& t: m_tasks)
+        {
+            t.throttled = false;
+        }
+        return;
+    }
+
+    // Time left for the tasks once the rest of the frame is paid for; handed out by priority
+    float available_ms = target_ms - std::max(0.f, m_frame_ms - m_tasks_ms);
+    for (TaskState& t: m_tasks)
+    {
+        if (m_frame_number - t.last_report_frame > DEFERRED_TASK_INTERVAL)
+        {
+            t.throttled = false; // Not running at all (no player actor, no video cameras...)
+            continue;
+        }
+        const float full_ms = t.unit_ms * std::max(1, t.full_units);
+        t.throttled = (t.throttled) ? (full_ms > available_ms * RELEASE_HEADROOM) : (full_ms > available_ms);
+        available_ms -= (t.throttled) ? t.unit_ms : full_ms;
+    }
+}
+
+int GfxFrameBudget::GetAllowedUnits(GfxBudgetTask task, int full_units)
+{
+    TaskState& t = m_tasks[(int)task];
+    t.full_units = full_units;
+    t.requested_units = true;
+    return (t.throttled) ? std::min(full_units, 1) : full_units;
+}
+
+bool GfxFrameBudget::IsTaskDue(GfxBudgetTask task) const
+{
+    return !m_tasks[(int)task].throttled || (m_frame_number % DEFERRED_TASK_INTERVAL) == 0;
+}
+
+void GfxFrameBudget::ReportCost(GfxBudgetTask task, float cost_ms, int units)
+{
+    TaskState& t = m_tasks[(int)task];
+    t.frame_cost_ms += cost_ms;
+    t.frame_units += units;
+    t.last_report_frame = m_frame_number;
+}
+
+GfxBudgetZone::GfxBudgetZone(GfxFrameBudget& budget, GfxBudgetTask task, int units):
+    m_budget(budget), m_task(task), m_units(units), m_begin_us(SimProfiler::GetTimestampUs())
+{
+}
+
+GfxBudgetZone::~GfxBudgetZone()
+{
+    m_budget.ReportCost(m_task, (SimProfiler::GetTimestampUs() - m_begin_us) / 1000.f, m_units);
+}
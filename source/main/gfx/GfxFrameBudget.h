@@ -0,0 +1,100 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Frame time budget for optional visual updates.
+
+#pragma once
+
+#include <cstdint>
+
+namespace RoR {
+
+/// @addtogroup Gfx
+/// @{
+
+/// Optional visual work which can be spread over several frames; in order of priority.
+enum class GfxBudgetTask
+{
+    VIDEO_CAMERAS, //!< Render-to-texture video cameras of the player actor; round-robin when throttled.
+    ENVMAP,        //!< Realtime reflections; one cubemap face per frame when throttled.
+    SKIDMARKS,     //!< Skidmark trails; updated every few frames when throttled.
+    DISTANT_ACTORS, //!< Prop animations and flexbody deformation of actors small on screen; round-robin when throttled.
+
+    COUNT
+};
+
+/// Keeps the frame time under 'gfx_frame_budget_ms' by throttling optional visual work.
+/// Each task reports what it cost; once per frame, tasks which no longer fit into the time
+/// left by the rest of the frame are throttled (lowest priority first), and released again
+/// when there's comfortable headroom.
+class GfxFrameBudget
+{
+public:
+    void     ReportFrameWorkTime(float sec); //!< Time the last frame took, excluding the FPS limiter's wait.
+    void     BeginFrame();                   //!< Decides which tasks are throttled in this frame.
+
+    int      GetAllowedUnits(GfxBudgetTask task, int full_units); //!< How many of `full_units` (cameras, faces) to process this frame; at least 1 unless 0.
+    bool     IsTaskDue(GfxBudgetTask task) const; //!< For tasks without units; false means skip this frame.
+    void     ReportCost(GfxBudgetTask task, float cost_ms, int units = 1);
+    bool     IsThrottled(GfxBudgetTask task) const { return m_tasks[(int)task].throttled; }
+    float    GetAverageFrameMs() const { return m_frame_ms; }
+
+private:
+
+    struct TaskState
+    {
+        float    unit_ms = 0.f;     //!< Smoothed cost of one unit
+        int      full_units = 0;    //!< Units needed for a full update
+        bool     requested_units = false; //!< Did `GetAllowedUnits()` set `full_units`?
+        float    frame_cost_ms = 0.f; //!< Accumulated in the current frame
+        int      frame_units = 0;
+        bool     throttled = false;
+        uint32_t last_report_frame = 0;
+    };
+
+    static const int DEFERRED_TASK_INTERVAL = 4; //!< Throttled tasks without units run every Nth frame.
+
+    TaskState    m_tasks[(int)GfxBudgetTask::COUNT];
+    float        m_frame_ms = 0.f;  //!< Smoothed frame work time
+    float        m_tasks_ms = 0.f;  //!< Smoothed time spent in all tasks per frame
+    uint32_t     m_frame_number = 0;
+};
+
+/// Measures the enclosing scope and reports it to the frame budget (which must outlive it).
+class GfxBudgetZone
+{
+public:
+    GfxBudgetZone(GfxFrameBudget& budget, GfxBudgetTask task, int units = 1);
+    ~GfxBudgetZone();
+
+    void         SetUnits(int units) { m_units = units; }
+
+private:
+    GfxFrameBudget& m_budget;
+    GfxBudgetTask   m_task;
+    int             m_units;
+    int64_t         m_begin_us;
+};
+
+/// @} // addtogroup Gfx
+
+} // namespace RoR
@@ -0,0 +1,233 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GfxOcclusion.h"
+
+#include "AppContext.h"
+#include "Application.h"
+#include "CameraManager.h"
+#include "GfxActor.h"
+#include "GfxScene.h"
+
+#include <algorithm>
+
+using namespace RoR;
+
+// --------------------------------
+// QueryBox
+
+GfxOcclusion::QueryBox::QueryBox()
+{
+    static const float VERTICES[8 * 3] =
+    {
+        -0.5f, -0.5f, -0.5f,    0.5f, -0.5f, -0.5f,    0.5f, 0.5f, -0.5f,    -0.5f, 0.5f, -0.5f,
+        -0.5f, -0.5f,  0.5f,    0.5f, -0.5f,  0.5f,    0.5f, 0.5f,  0.5f,    -0.5f, 0.5f,  0.5f,
+    };
+    static const uint16_t INDICES[12 * 3] = // Winding doesn't matter, the pass doesn't cull
+    {
+        0, 1, 2,  0, 2, 3,  4, 5, 6,  4, 6, 7,  0, 1, 5,  0, 5, 4,
+        3, 2, 6,  3, 6, 7,  0, 3, 7,  0, 7, 4,  1, 2, 6,  1, 6, 5,
+    };
+
+    mRenderOp.operationType = Ogre::RenderOperation::OT_TRIANGLE_LIST;
+    mRenderOp.useIndexes = true;
+
+    mRenderOp.vertexData = new Ogre::VertexData();
+    mRenderOp.vertexData->vertexStart = 0;
+    mRenderOp.vertexData->vertexCount = 8;
+    mRenderOp.vertexData->vertexDeclaration->addElement(0, 0, Ogre::VET_FLOAT3, Ogre::VES_POSITION);
+    Ogre::HardwareVertexBufferSharedPtr vbuf = Ogre::HardwareBufferManager::getSingleton().createVertexBuffer(
+        3 * sizeof(float), 8, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    vbuf->writeData(0, vbuf->getSizeInBytes(), VERTICES, true);
+    mRenderOp.vertexData->vertexBufferBinding->setBinding(0, vbuf);
+
+    mRenderOp.indexData = new Ogre::IndexData();
+    mRenderOp.indexData->indexStart = 0;
+    mRenderOp.indexData->indexCount = 36;
+    mRenderOp.indexData->indexBuffer = Ogre::HardwareBufferManager::getSingleton().createIndexBuffer(
+        Ogre::HardwareIndexBuffer::IT_16BIT, 36, Ogre::HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    mRenderOp.indexData->indexBuffer->writeData(0, mRenderOp.indexData->indexBuffer->getSizeInBytes(), INDICES, true);
+
+    this->setBoundingBox(Ogre::AxisAlignedBox(-0.5f, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f));
+}
+
+GfxOcclusion::QueryBox::~QueryBox()
+{
+    delete mRenderOp.vertexData;
+    delete mRenderOp.indexData;
+}
+
+void GfxOcclusion::QueryBox::SetBox(Ogre::AxisAlignedBox const& box)
+{
+    m_transform.makeTransform(box.getCenter(), box.getSize(), Ogre::Quaternion::IDENTITY);
+}
+
+// --------------------------------
+// GfxOcclusion
+
+bool GfxOcclusion::ActorListener::objectRendering(const Ogre::MovableObject* obj, const Ogre::Camera* cam)
+{
+    return !al_occluded || cam != App::GetCameraManager()->GetCamera();
+}
+
+bool GfxOcclusion::SetupQueries()
+{
+    if (!m_setup_done)
+    {
+        m_setup_done = true;
+        Ogre::RenderSystem* rs = App::GetAppContext()->GetOgreRoot()->getRenderSystem();
+        m_supported = rs->getCapabilities()->hasCapability(Ogre::RSC_HWOCCLUSION);
+        if (!m_supported)
+        {
+            LOG("[RoR|Gfx] Occlusion culling unavailable, the render system doesn't support occlusion queries");
+            return false;
+        }
+
+        // Depth test only, nothing gets written
+        Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(
+            "RoR/OcclusionQuery", Ogre::ResourceGroupManager::INTERNAL_RESOURCE_GROUP_NAME);
+        m_query_pass = mat->getTechnique(0)->getPass(0);
+        m_query_pass->setLightingEnabled(false);
+        m_query_pass->setColourWriteEnabled(false);
+        m_query_pass->setDepthWriteEnabled(false);
+        m_query_pass->setDepthCheckEnabled(true);
+        m_query_pass->setCullingMode(Ogre::CULL_NONE);
+        m_query_pass->setManualCullingMode(Ogre::MANUAL_CULL_NONE);
+        m_query_pass->setFog(true, Ogre::FOG_NONE);
+        mat->load();
+
+        m_query_box = std::unique_ptr<QueryBox>(new QueryBox());
+        m_query_box->setMaterial(mat);
+    }
+    return m_supported;
+}
+
+void GfxOcclusion::AddActor(GfxActor* gfx_actor)
+{
+    ActorQuery aq;
+    aq.aq_gfx_actor = gfx_actor;
+    aq.aq_listener = std::unique_ptr<ActorListener>(new ActorListener());
+    gfx_actor->SetOcclusionListener(aq.aq_listener.get());
+    m_actors.push_back(std::move(aq));
+}
+
+void GfxOcclusion::RemoveActor(GfxActor* gfx_actor)
+{
+    auto itor = std::find_if(m_actors.begin(), m_actors.end(),
+        [gfx_actor](ActorQuery const& aq) { return aq.aq_gfx_actor == gfx_actor; });
+    if (itor == m_actors.end())
+        return;
+
+    gfx_actor->SetOcclusionListener(nullptr);
+    if (itor->aq_query != nullptr)
+    {
+        App::GetAppContext()->GetOgreRoot()->getRenderSystem()->destroyHardwareOcclusionQuery(itor->aq_query);
+    }
+    m_actors.erase(itor);
+}
+
+void GfxOcclusion::ClearActors()
+{
+    for (ActorQuery& aq: m_actors)
+    {
+        if (aq.aq_query != nullptr)
+        {
+            App::GetAppContext()->GetOgreRoot()->getRenderSystem()->destroyHardwareOcclusionQuery(aq.aq_query);
+        }
+    }
+    m_actors.clear();
+}
+
+void GfxOcclusion::UpdateOcclusion(GfxActor* player_gfx_actor)
+{
+    const bool enabled = App::gfx_occlusion_culling->getBool() && this->SetupQueries();
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const Ogre::Vector3 cam_pos = camera->getDerivedPosition();
+    Ogre::RenderSystem* rs = App::GetAppContext()->GetOgreRoot()->getRenderSystem();
+
+    for (ActorQuery& aq: m_actors)
+    {
+        // Read the last result if it's ready; never stall on the GPU
+        bool visible_result = false;
+        if (aq.aq_pending && !aq.aq_query->isStillOutstanding())
+        {
+            unsigned int num_fragments = 0;
+            aq.aq_query->pullOcclusionQuery(&num_fragments);
+            aq.aq_pending = false;
+            visible_result = (num_fragments > 0);
+            aq.aq_occluded_results = (visible_result) ? 0 : (aq.aq_occluded_results + 1);
+        }
+
+        const Ogre::AxisAlignedBox& aabb = aq.aq_gfx_actor->GetSimDataBuffer().simbuf_aabb;
+        aq.aq_in_view = enabled && aabb.isFinite() && aq.aq_gfx_actor != player_gfx_actor && camera->isVisible(aabb);
+        if (aq.aq_in_view)
+        {
+            aq.aq_box = Ogre::AxisAlignedBox(aabb.getMinimum() - BOX_MARGIN, aabb.getMaximum() + BOX_MARGIN);
+            aq.aq_in_view = !aq.aq_box.contains(cam_pos); // The box would be clipped by the near plane
+        }
+
+        if (!aq.aq_in_view)
+        {
+            aq.aq_occluded_results = 0; // Start over when it comes into view, so it's never hidden right away
+        }
+        aq.aq_listener->al_occluded = (aq.aq_occluded_results >= OCCLUDED_RESULTS);
+
+        if (aq.aq_in_view && aq.aq_query == nullptr)
+        {
+            aq.aq_query = rs->createHardwareOcclusionQuery();
+        }
+    }
+}
+
+bool GfxOcclusion::IsOccluded(GfxActor* gfx_actor) const
+{
+    for (ActorQuery const& aq: m_actors)
+    {
+        if (aq.aq_gfx_actor == gfx_actor)
+            return aq.aq_listener->al_occluded;
+    }
+    return false;
+}
+
+void GfxOcclusion::renderQueueEnded(Ogre::uint8 queue_group_id, const Ogre::String& invocation, bool& repeat_this_invocation)
+{
+    // Terrain, objects and actors are all drawn by now; test against the main viewport's depth buffer only
+    if (queue_group_id != Ogre::RENDER_QUEUE_MAIN || m_query_pass == nullptr)
+        return;
+
+    Ogre::RenderSystem* rs = App::GetAppContext()->GetOgreRoot()->getRenderSystem();
+    Ogre::Viewport* vp = rs->_getViewport();
+    if (vp == nullptr || vp != App::GetAppContext()->GetViewport())
+        return;
+
+    Ogre::SceneManager* scene_manager = App::GetGfxScene()->GetSceneManager();
+    for (ActorQuery& aq: m_actors)
+    {
+        if (!aq.aq_in_view || aq.aq_pending || aq.aq_query == nullptr)
+            continue;
+
+        m_query_box->SetBox(aq.aq_box);
+        aq.aq_query->beginOcclusionQuery();
+        scene_manager->_injectRenderWithPass(m_query_pass, m_query_box.get(), false);
+        aq.aq_query->endOcclusionQuery();
+        aq.aq_pending = true;
+    }
+}
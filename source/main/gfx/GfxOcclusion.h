@@ -0,0 +1,106 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Hardware occlusion culling of actors.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <Ogre.h>
+#include <memory>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Gfx
+/// @{
+
+/// Hides actors which are behind terrain or buildings from the main camera, and lets `GfxScene` skip
+/// their visual updates. Once the opaque geometry is drawn, each actor's bounding box is tested against
+/// the depth buffer with a hardware occlusion query. Results arrive a frame or two later, so an actor
+/// must be occluded in several results in a row before it's hidden; the first visible result shows it again.
+/// Only the main camera is affected; shadows, reflections and video cameras still see every actor.
+class GfxOcclusion: public Ogre::RenderQueueListener
+{
+public:
+    void           AddActor(GfxActor* gfx_actor);     //!< Call once the actor's meshes are built
+    void           RemoveActor(GfxActor* gfx_actor);
+    void           UpdateOcclusion(GfxActor* player_gfx_actor); //!< Collects finished queries and places the boxes for the next ones
+    bool           IsOccluded(GfxActor* gfx_actor) const;
+    void           ClearActors();                      //!< For `GfxScene::ClearScene()`; the actors' objects go with the scene
+
+    // Ogre::RenderQueueListener
+    virtual void   renderQueueEnded(Ogre::uint8 queue_group_id, const Ogre::String& invocation, bool& repeat_this_invocation) override;
+
+private:
+
+    /// Hides an actor's objects from the main camera only, unlike `setVisible()`
+    struct ActorListener: public Ogre::MovableObject::Listener
+    {
+        virtual bool objectRendering(const Ogre::MovableObject* obj, const Ogre::Camera* cam) override;
+
+        bool                 al_occluded = false;
+    };
+
+    struct ActorQuery
+    {
+        GfxActor*                       aq_gfx_actor = nullptr;
+        Ogre::HardwareOcclusionQuery*   aq_query = nullptr;
+        Ogre::AxisAlignedBox            aq_box;              //!< Inflated actor bounds for the next query
+        bool                            aq_in_view = false;  //!< Off-screen actors are culled by the frustum anyway
+        bool                            aq_pending = false;  //!< Query issued, result not read yet
+        int                             aq_occluded_results = 0; //!< Consecutive
+        std::unique_ptr<ActorListener>  aq_listener;         //!< Address must not change, objects keep it
+    };
+
+    /// Unit cube drawn for the queries, scaled to each box in turn
+    class QueryBox: public Ogre::SimpleRenderable
+    {
+    public:
+        QueryBox();
+        ~QueryBox();
+
+        void                 SetBox(Ogre::AxisAlignedBox const& box);
+        virtual void         getWorldTransforms(Ogre::Matrix4* xform) const override { *xform = m_transform; }
+        virtual Ogre::Real   getSquaredViewDepth(const Ogre::Camera* cam) const override { return 0.f; }
+        virtual Ogre::Real   getBoundingRadius() const override { return 1.f; }
+
+    private:
+        Ogre::Matrix4        m_transform = Ogre::Matrix4::IDENTITY;
+    };
+
+    bool           SetupQueries(); //!< Lazy, the render system must be up; false if the hardware can't do it
+
+    static const int OCCLUDED_RESULTS = 3;      //!< Consecutive occluded results before an actor is hidden
+    static constexpr float BOX_MARGIN = 1.f;    //!< Meters added around actor bounds, so actors reappear a bit early
+
+    std::vector<ActorQuery>        m_actors;
+    std::unique_ptr<QueryBox>      m_query_box;
+    Ogre::Pass*                    m_query_pass = nullptr;
+    bool                           m_setup_done = false;
+    bool                           m_supported = false;
+};
+
+/// @} // addtogroup Gfx
+
+} // namespace RoR
@@ -24,7 +24,9 @@
 #include "AppContext.h"
 #include "Actor.h"
 #include "ActorManager.h"
+#include "CameraManager.h"
 #include "Console.h"
+#include "FlexBody.h"
 #include "DustPool.h"
 #include "HydraxWater.h"
 #include "GameContext.h"
@@ -32,20 +34,28 @@
 #include "GUIUtils.h"
 #include "GUI_DirectionArrow.h"
 #include "OverlayWrapper.h"
+#include "SimProfiler.h"
 #include "SkyManager.h"
 #include "SkyXManager.h"
 #include "TerrainGeometryManager.h"
 #include "Terrain.h"
 #include "TerrainObjectManager.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include "imgui_internal.h"
 
 #include <Ogre.h>
 
+#include <algorithm>
+#include <cmath>
+
 using namespace Ogre;
 using namespace RoR;
 
+static const int FLEXBODY_CHUNK_VERTICES = 2048; // Per ParallelFor item; large enough to amortize the shared counter
+static const int FLEXBODY_LOD_INTERVAL = 4;      // Frames between deformation updates of mid-size flexbodies
+
 void GfxScene::CreateDustPools()
 {
     ROR_ASSERT(m_dustpools.size() == 0);
@@ -68,9 +78,24 @@ void GfxScene::ClearScene()
     m_dustpools.clear();
 
     // Delete game elements
+    m_occlusion.ClearActors();
     m_all_gfx_actors.clear();
     m_all_gfx_characters.clear();
 
+    // Delete unused video camera textures
+    for (Ogre::TexturePtr& tex: m_vidcam_texture_pool)
+    {
+        Ogre::TextureManager::getSingleton().remove(tex->getHandle());
+    }
+    m_vidcam_texture_pool.clear();
+
+    // Pooled particle systems go with the scene manager wipe
+    m_particle_pool.clear();
+    m_particle_pool_keys.clear();
+
+    // Ground model IDs will be assigned again by the next terrain
+    m_skidmark_conf.ClearGroundModelCache();
+
     // Wipe scene manager
     m_scene_manager->clearScene();
 
@@ -85,16 +110,29 @@ void GfxScene::Init()
     m_scene_manager = App::GetAppContext()->GetOgreRoot()->createSceneManager(Ogre::ST_EXTERIOR_CLOSE, "main_scene_manager");
 
     m_skidmark_conf.LoadDefaultSkidmarkDefs();
+    m_scene_manager->addRenderQueueListener(&m_occlusion);
 }
 
 void GfxScene::UpdateScene(float dt_sec)
 {
+    m_frame_budget.BeginFrame();
+
     // Actors - start threaded tasks
-    for (GfxActor* gfx_actor: m_live_gfx_actors)
+    this->UpdateActorSchedule();
+    m_flexbody_batch.clear();
+    m_flexbody_batch_actors.clear();
+    m_flexbody_batch_updates.clear();
+    for (size_t i = 0; i < m_live_gfx_actors.size(); i++)
     {
-        gfx_actor->UpdateFlexbodies(); // Push flexbody tasks to threadpool
-        gfx_actor->UpdateWheelVisuals(); // Push flexwheel tasks to threadpool
+        GfxActor* gfx_actor = m_live_gfx_actors[i];
+        gfx_actor->UpdateFlexbodies(m_flexbody_batch); // Collect flexbodies for the batch
+        m_flexbody_batch_actors.resize(m_flexbody_batch.size(), gfx_actor->GetActorId());
+        m_flexbody_batch_updates.resize(m_flexbody_batch.size(), m_live_actor_updates[i]);
+        gfx_actor->UpdateWheelVisuals(); // Collect flexwheels for `StartActorUpdates()`
     }
+    this->UpdateFlexbodyLods();
+    this->StartFlexbodyBatch();
+    this->StartActorUpdates(dt_sec);
 
     // Var
     GfxActor* player_gfx_actor = nullptr;
@@ -104,7 +142,14 @@ void GfxScene::UpdateScene(float dt_sec)
     }
 
     // FOV
-    if (m_simbuf.simbuf_camera_behavior != CameraManager::CAMERA_BEHAVIOR_STATIC)
+    const int camera_behavior = static_cast<int>(m_simbuf.simbuf_camera_behavior);
+    const bool fov_changed = camera_behavior != m_fov_camera_behavior
+        || App::gfx_fov_internal->getVersion() != m_fov_internal_version
+        || App::gfx_fov_external->getVersion() != m_fov_external_version;
+    m_fov_camera_behavior = camera_behavior;
+    m_fov_internal_version = App::gfx_fov_internal->getVersion();
+    m_fov_external_version = App::gfx_fov_external->getVersion();
+    if (fov_changed && m_simbuf.simbuf_camera_behavior != CameraManager::CAMERA_BEHAVIOR_STATIC)
     {
         float fov = (m_simbuf.simbuf_camera_behavior == CameraManager::CAMERA_BEHAVIOR_VEHICLE_CINECAM)
             ? App::gfx_fov_internal->getFloat() : App::gfx_fov_external->getFloat();
@@ -138,6 +183,9 @@ void GfxScene::UpdateScene(float dt_sec)
     // Terrain - animated meshes and paged geometry
     App::GetGameContext()->GetTerrain()->getObjectManager()->UpdateTerrainObjects(dt_sec);
 
+    // Terrain - streamed pages
+    App::GetGameContext()->GetTerrain()->getGeometryManager()->UpdatePaging(App::GetCameraManager()->GetCameraNode()->_getDerivedPosition());
+
     // Terrain - lightmap; TODO: ported as-is from Terrain::update(), is it needed? ~ only_a_ptr, 05/2018
     App::GetGameContext()->GetTerrain()->getGeometryManager()->UpdateMainLightPosition(); // TODO: Is this necessary? I'm leaving it here just in case ~ only_a_ptr, 04/2017
 
@@ -206,7 +254,8 @@ void GfxScene::UpdateScene(float dt_sec)
         a->UpdateCharacterInScene();
     }
 
-    // Actors - update misc visuals
+    // Actors - update misc visuals; prop animations, cab mesh and flexwheel vertices come from `StartActorUpdates()`
+    this->FinishActorUpdates();
     for (GfxActor* gfx_actor: m_all_gfx_actors)
     {
         if (gfx_actor->IsActorLive())
@@ -217,14 +266,14 @@ void GfxScene::UpdateScene(float dt_sec)
             gfx_actor->UpdateAirbrakes();
             gfx_actor->UpdateCParticles();
             gfx_actor->UpdateAeroEngines();
-            gfx_actor->UpdatePropAnimations(dt_sec);
-            gfx_actor->UpdateRenderdashRTT();
+            gfx_actor->UpdateRenderdashRTT(dt_sec);
         }
         // Beacon flares must always be updated
         gfx_actor->UpdateProps(dt_sec, (gfx_actor == player_gfx_actor));
         // Blinkers (turn signals) must always be updated
         gfx_actor->UpdateFlares(dt_sec, (gfx_actor == player_gfx_actor));
     }
+    this->UpdateFlareLights();
     if (player_gfx_actor != nullptr)
     {
         player_gfx_actor->UpdateVideoCameras(dt_sec);
@@ -245,11 +294,317 @@ void GfxScene::UpdateScene(float dt_sec)
     App::GetGameContext()->GetSceneMouse().UpdateVisuals();
 
     // Actors - finalize threaded tasks
+    this->FinishFlexbodyBatch();
     for (GfxActor* gfx_actor: m_live_gfx_actors)
     {
         gfx_actor->FinishWheelUpdates();
         gfx_actor->FinishFlexbodyTasks();
     }
+    this->ReportDistantActorCost();
+}
+
+void GfxScene::UpdateActorSchedule()
+{
+    // The player's actor and actors big on screen are fully updated every frame. The rest are too
+    // while the frame budget allows; otherwise they take turns, and in between only follow their nodes.
+    // Occluded actors only follow their nodes.
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const Ogre::Vector3 cam_pos = camera->getDerivedPosition();
+    const float tan_half_fov = std::tan(camera->getFOVy().valueRadians() * 0.5f);
+    const float full_size = App::gfx_actor_lod_full->getFloat();
+    GfxActor* player_gfx_actor = (m_simbuf.simbuf_player_actor != nullptr) ? m_simbuf.simbuf_player_actor->GetGfxActor() : nullptr;
+    m_occlusion.UpdateOcclusion(player_gfx_actor);
+
+    m_live_actor_updates.assign(m_live_gfx_actors.size(), ACTOR_UPDATE_FULL);
+    m_distant_actors.clear();
+    for (size_t i = 0; i < m_live_gfx_actors.size(); i++)
+    {
+        const Ogre::AxisAlignedBox& aabb = m_live_gfx_actors[i]->GetSimDataBuffer().simbuf_aabb;
+        if (m_live_gfx_actors[i] == player_gfx_actor || !aabb.isFinite())
+            continue;
+        if (m_occlusion.IsOccluded(m_live_gfx_actors[i]))
+        {
+            m_live_actor_updates[i] = ACTOR_UPDATE_SKIPPED; // Nobody sees it; it catches up once it's back in view
+            continue;
+        }
+
+        const float dist = std::max(cam_pos.distance(aabb.getCenter()), 0.1f);
+        const float size = camera->isVisible(aabb) ? (aabb.getHalfSize().length() / (dist * tan_half_fov)) : 0.f;
+        if (size < full_size)
+            m_distant_actors.push_back(i);
+    }
+
+    m_distant_actors_due = 0;
+    m_distant_actor_cost_us = 0;
+    if (m_distant_actors.empty())
+        return;
+
+    const size_t num_due = static_cast<size_t>(m_frame_budget.GetAllowedUnits(GfxBudgetTask::DISTANT_ACTORS, static_cast<int>(m_distant_actors.size())));
+    m_distant_actor_cursor %= m_distant_actors.size();
+    for (size_t n = 0; n < m_distant_actors.size(); n++)
+    {
+        const size_t i = m_distant_actors[(m_distant_actor_cursor + n) % m_distant_actors.size()];
+        m_live_actor_updates[i] = (n < num_due) ? ACTOR_UPDATE_DISTANT : ACTOR_UPDATE_SKIPPED;
+    }
+    m_distant_actor_cursor += num_due;
+    m_distant_actors_due = static_cast<int>(num_due);
+}
+
+void GfxScene::ReportDistantActorCost()
+{
+    // Worker time, not wall time - on many cores it overestimates, which errs on the side of a smooth frame.
+    if (m_distant_actors_due > 0)
+    {
+        m_frame_budget.ReportCost(GfxBudgetTask::DISTANT_ACTORS, m_distant_actor_cost_us / 1000.f, m_distant_actors_due);
+    }
+}
+
+void GfxScene::UpdateFlexbodyLods()
+{
+    // Screen-space size decides how often a flexbody may change shape: every frame, every Nth frame, or
+    // (tiny or off-screen) not until it grows. Every flexbody still follows its nodes each frame.
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const Ogre::Vector3 cam_pos = camera->getDerivedPosition();
+    const float tan_half_fov = std::tan(camera->getFOVy().valueRadians() * 0.5f);
+    const float full_size = App::gfx_flexbody_lod_full->getFloat();
+    const float frozen_size = App::gfx_flexbody_lod_frozen->getFloat();
+    m_flexbody_vertex_budget = App::gfx_flexbody_vertex_budget->getInt();
+    m_flexbody_lod_frame++;
+
+    m_flexbody_batch_sizes.resize(m_flexbody_batch.size());
+    m_flexbody_batch_allowed.resize(m_flexbody_batch.size());
+    for (size_t i = 0; i < m_flexbody_batch.size(); i++)
+    {
+        FlexBody* fb = m_flexbody_batch[i];
+        const Ogre::Sphere bounds(fb->getFlexitCenter(), fb->getBoundingRadius());
+        const float dist = std::max(cam_pos.distance(bounds.getCenter()), 0.1f);
+        const float size = camera->isVisible(bounds) ? (bounds.getRadius() / (dist * tan_half_fov)) : 0.f;
+        const bool lod_frame = ((m_flexbody_lod_frame + m_flexbody_batch_actors[i]) % FLEXBODY_LOD_INTERVAL) == 0;
+
+        m_flexbody_batch_sizes[i] = size;
+        m_flexbody_batch_allowed[i] = !fb->hasShape() || ((m_flexbody_batch_updates[i] != ACTOR_UPDATE_SKIPPED)
+            && ((size >= full_size) || (size >= frozen_size && lod_frame)));
+    }
+}
+
+void GfxScene::StartFlexbodyBatch()
+{
+    if (m_flexbody_batch.empty())
+        return;
+
+    m_flexbody_task = App::GetThreadPool()->RunTask([this]()
+        {
+            // Per-flexbody setup is cheap (nodes, not vertices); do it first so unchanged meshes drop out
+            m_flexbody_batch_deformed.assign(m_flexbody_batch.size(), 0);
+            App::GetThreadPool()->ParallelFor(m_flexbody_batch.size(), [this](size_t i)
+                {
+                    m_flexbody_batch_deformed[i] = m_flexbody_batch[i]->prepareFlexbody();
+                });
+
+            // Admit deformed flexbodies allowed by their LOD, biggest on screen first, until the vertex budget is used up.
+            // The rest keep their old shape this frame and are picked up again next frame.
+            m_flexbody_admitted.clear();
+            for (size_t i = 0; i < m_flexbody_batch.size(); i++)
+            {
+                if (m_flexbody_batch_deformed[i] && m_flexbody_batch_allowed[i])
+                    m_flexbody_admitted.push_back(i);
+            }
+            if (m_flexbody_vertex_budget > 0)
+            {
+                std::sort(m_flexbody_admitted.begin(), m_flexbody_admitted.end(),
+                    [this](size_t a, size_t b) { return m_flexbody_batch_sizes[a] > m_flexbody_batch_sizes[b]; });
+                int num_verts = 0;
+                size_t num_admitted = 0;
+                for (; num_admitted < m_flexbody_admitted.size(); num_admitted++)
+                {
+                    num_verts += m_flexbody_batch[m_flexbody_admitted[num_admitted]]->getVertexCount();
+                    if (num_admitted > 0 && num_verts > m_flexbody_vertex_budget)
+                        break;
+                }
+                m_flexbody_admitted.resize(num_admitted);
+            }
+            App::GetThreadPool()->ParallelFor(m_flexbody_admitted.size(), [this](size_t i)
+                {
+                    m_flexbody_batch[m_flexbody_admitted[i]]->beginDeformation();
+                });
+
+            // Split all remaining vertices into equal chunks, so a huge mesh spreads across workers
+            // and small ones share a chunk's worth of overhead
+            m_flexbody_chunks.clear();
+            for (size_t i: m_flexbody_admitted)
+            {
+                const int num_verts = m_flexbody_batch[i]->getVertexCount();
+                for (int begin = 0; begin < num_verts; begin += FLEXBODY_CHUNK_VERTICES)
+                {
+                    m_flexbody_chunks.push_back(FlexbodyChunk{ m_flexbody_batch[i], m_flexbody_batch_actors[i],
+                        begin, std::min(begin + FLEXBODY_CHUNK_VERTICES, num_verts), m_flexbody_batch_updates[i] == ACTOR_UPDATE_DISTANT });
+                }
+            }
+            App::GetThreadPool()->ParallelFor(m_flexbody_chunks.size(), [this](size_t i)
+                {
+                    FlexbodyChunk& chunk = m_flexbody_chunks[i];
+                    ROR_PROFILE_ZONE("FlexBody::computeFlexbodyVertices", chunk.fc_actor_id);
+                    const int64_t begin_us = (chunk.fc_distant) ? SimProfiler::GetTimestampUs() : 0;
+                    chunk.fc_flexbody->computeFlexbodyVertices(chunk.fc_begin, chunk.fc_end);
+                    if (chunk.fc_distant)
+                    {
+                        m_distant_actor_cost_us += SimProfiler::GetTimestampUs() - begin_us;
+                    }
+                });
+        }, TaskPriority::HIGH); // Joined within the frame
+}
+
+void GfxScene::FinishFlexbodyBatch()
+{
+    if (m_flexbody_task)
+    {
+        m_flexbody_task->join();
+        m_flexbody_task = nullptr;
+    }
+}
+
+void GfxScene::StartActorUpdates(float dt_sec)
+{
+    if (m_live_gfx_actors.empty())
+        return;
+
+    // `m_live_gfx_actors` isn't modified until the next `BufferSimulationData()`, long after `FinishActorUpdates()`
+    m_actor_task = App::GetThreadPool()->RunTask([this, dt_sec]()
+        {
+            App::GetThreadPool()->ParallelFor(m_live_gfx_actors.size(), [this, dt_sec](size_t i)
+                {
+                    const ActorUpdate update = m_live_actor_updates[i];
+                    const int64_t begin_us = (update == ACTOR_UPDATE_DISTANT) ? SimProfiler::GetTimestampUs() : 0;
+                    m_live_gfx_actors[i]->ComputeVisuals(dt_sec, update != ACTOR_UPDATE_SKIPPED);
+                    if (update == ACTOR_UPDATE_DISTANT)
+                    {
+                        m_distant_actor_cost_us += SimProfiler::GetTimestampUs() - begin_us;
+                    }
+                });
+        }, TaskPriority::HIGH); // Joined within the frame
+}
+
+void GfxScene::FinishActorUpdates()
+{
+    if (m_actor_task)
+    {
+        m_actor_task->join();
+        m_actor_task = nullptr;
+    }
+}
+
+void GfxScene::RegisterFlareLight(Ogre::Light* light, float score)
+{
+    m_flare_light_candidates.push_back({ light, score });
+}
+
+void GfxScene::UpdateFlareLights()
+{
+    // Lights are ranked across all actors - with many vehicles around, those near the camera matter most.
+    const size_t budget = static_cast<size_t>(std::max(0, App::gfx_flares_light_budget->getInt()));
+    if (budget > 0 && m_flare_light_candidates.size() > budget)
+    {
+        std::nth_element(m_flare_light_candidates.begin(), m_flare_light_candidates.begin() + budget, m_flare_light_candidates.end(),
+            [](FlareLightCandidate const& a, FlareLightCandidate const& b) { return a.flc_score > b.flc_score; });
+        for (size_t i = budget; i < m_flare_light_candidates.size(); i++)
+        {
+            m_flare_light_candidates[i].flc_light->setVisible(false);
+        }
+    }
+    m_flare_light_candidates.clear();
+}
+
+Ogre::TexturePtr GfxScene::AcquireVideoCamTexture(unsigned int width, unsigned int height)
+{
+    for (auto itor = m_vidcam_texture_pool.begin(); itor != m_vidcam_texture_pool.end(); ++itor)
+    {
+        if ((*itor)->getWidth() == width && (*itor)->getHeight() == height)
+        {
+            Ogre::TexturePtr tex = *itor;
+            m_vidcam_texture_pool.erase(itor);
+            return tex;
+        }
+    }
+
+    return Ogre::TextureManager::getSingleton().createManual(
+        fmt::format("VideoCamTexture-{}", m_vidcam_texture_counter++),
+        Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
+        Ogre::TEX_TYPE_2D,
+        width,
+        height,
+        0, // no mip maps
+        Ogre::PF_R8G8B8,
+        Ogre::TU_RENDERTARGET);
+}
+
+void GfxScene::ReleaseVideoCamTexture(Ogre::TexturePtr tex)
+{
+    m_vidcam_texture_pool.push_back(tex);
+}
+
+Ogre::ParticleSystem* GfxScene::AcquireParticleSystem(std::string const& template_name, std::string const& resource_group)
+{
+    const std::string key = resource_group + "|" + template_name;
+    std::vector<Ogre::ParticleSystem*>& pool = m_particle_pool[key];
+    if (!pool.empty())
+    {
+        Ogre::ParticleSystem* psys = pool.back();
+        pool.pop_back();
+        return psys;
+    }
+
+    // None of `Ogre::SceneManager::createParticleSystem()` overloads
+    // lets us specify both resource group and template name.
+    Ogre::NameValuePairList params;
+    params["resourceGroup"] = resource_group;
+    params["templateName"] = template_name;
+
+    Ogre::MovableObject* obj = m_scene_manager->createMovableObject(
+        fmt::format("ActorParticles-{}-{}", template_name, m_particle_counter++), Ogre::ParticleSystemFactory::FACTORY_TYPE_NAME, &params);
+    Ogre::ParticleSystem* psys = static_cast<Ogre::ParticleSystem*>(obj);
+    psys->setVisibilityFlags(DEPTHMAP_DISABLED); // disable particles in depthmap
+    m_particle_pool_keys[psys] = key;
+    return psys;
+}
+
+void GfxScene::ReleaseParticleSystem(Ogre::ParticleSystem* psys)
+{
+    auto found = m_particle_pool_keys.find(psys);
+    if (found == m_particle_pool_keys.end())
+    {
+        psys->removeAllAffectors();
+        psys->removeAllEmitters();
+        m_scene_manager->destroyParticleSystem(psys);
+        return;
+    }
+
+    psys->detachFromParent();
+    psys->clear(); // Particles in flight
+    for (unsigned short i = 0; i < psys->getNumEmitters(); i++)
+    {
+        psys->getEmitter(i)->setEnabled(false);
+    }
+    m_particle_pool[found->second].push_back(psys);
+}
+
+void GfxScene::DiscardParticleSystems(std::string const& resource_group)
+{
+    for (auto itor = m_particle_pool.begin(); itor != m_particle_pool.end(); )
+    {
+        if (itor->first.compare(0, resource_group.size() + 1, resource_group + "|") == 0)
+        {
+            for (Ogre::ParticleSystem* psys: itor->second)
+            {
+                m_particle_pool_keys.erase(psys);
+                m_scene_manager->destroyParticleSystem(psys);
+            }
+            itor = m_particle_pool.erase(itor);
+        }
+        else
+        {
+            ++itor;
+        }
+    }
 }
 
 void GfxScene::SetParticlesVisible(bool visible)
@@ -276,6 +631,7 @@ DustPool* GfxScene::GetDustPool(const char* name)
 void GfxScene::RegisterGfxActor(RoR::GfxActor* gfx_actor)
 {
     m_all_gfx_actors.push_back(gfx_actor);
+    m_occlusion.AddActor(gfx_actor);
 }
 
 void GfxScene::BufferSimulationData()
@@ -315,6 +671,7 @@ void GfxScene::BufferSimulationData()
 
 void GfxScene::RemoveGfxActor(RoR::GfxActor* remove_me)
 {
+    m_occlusion.RemoveActor(remove_me);
     auto itor = std::remove(m_all_gfx_actors.begin(), m_all_gfx_actors.end(), remove_me);
     if (itor != m_all_gfx_actors.end())
     {
@@ -336,30 +693,10 @@ void GfxScene::RemoveGfxCharacter(RoR::GfxCharacter* remove_me)
     }
 }
 
-void GfxScene::DrawNetLabel(Ogre::Vector3 scene_pos, float cam_dist, std::string const& nick, int colornum)
+void GfxScene::DrawNetLabel(NetLabelCache& label, Ogre::Vector3 scene_pos, float cam_dist, std::string const& nick, int colornum)
 {
 #if USE_SOCKETW
 
-        // this ensures that the nickname is always in a readable size
-        float font_size = std::max(0.6, cam_dist / 40.0);
-        std::string caption;
-        if (cam_dist > 1000) // 1000 ... vlen
-        {
-            caption =
-                nick + " (" + TOSTRING((float)(ceil(cam_dist / 100) / 10.0) ) + " km)";
-        }
-        else if (cam_dist > 20) // 20 ... vlen ... 1000
-        {
-            caption =
-                nick + " (" + TOSTRING((int)cam_dist) + " m)";
-        }
-        else // 0 ... vlen ... 20
-        {
-            caption = nick;
-        }
-
-        // draw with DearIMGUI
-
     ImVec2 screen_size = ImGui::GetIO().DisplaySize;
     World2ScreenConverter world2screen(
         App::GetCameraManager()->GetCamera()->getViewMatrix(true), App::GetCameraManager()->GetCamera()->getProjectionMatrix(), Ogre::Vector2(screen_size.x, screen_size.y));
@@ -372,12 +709,38 @@ void GfxScene::DrawNetLabel(Ogre::Vector3 scene_pos, float cam_dist, std::string
         // Align position to whole pixels, to minimize jitter.
         ImVec2 pos((int)pos_xyz.x+0.5, (int)pos_xyz.y+0.5);
 
-        ImVec2 text_size = ImGui::CalcTextSize(caption.c_str());
-        GUIManager::GuiTheme const& theme = App::GetGuiManager()->GetTheme();
-
         ImDrawList* drawlist = GetImDummyFullscreenWindow();
         ImGuiContext* g = ImGui::GetCurrentContext();
 
+        // The caption only changes when the shown distance does (at most once per meter),
+        // so it's formatted and measured then, not every frame.
+        int shown_dist = 0; // 0 ... vlen ... 20
+        if (cam_dist > 1000) // 1000 ... vlen
+            shown_dist = -static_cast<int>(ceil(cam_dist / 100));
+        else if (cam_dist > 20) // 20 ... vlen ... 1000
+            shown_dist = static_cast<int>(cam_dist);
+
+        if (shown_dist != label.nlc_shown_dist || nick != label.nlc_nick || g->FontSize != label.nlc_font_size || label.nlc_caption.empty())
+        {
+            if (shown_dist < 0)
+                label.nlc_caption = fmt::format("{} ({:g} km)", nick, -shown_dist / 10.f);
+            else if (shown_dist > 0)
+                label.nlc_caption = fmt::format("{} ({} m)", nick, shown_dist);
+            else
+                label.nlc_caption = nick;
+
+            const ImVec2 measured_size = ImGui::CalcTextSize(label.nlc_caption.c_str());
+            label.nlc_text_width = measured_size.x;
+            label.nlc_text_height = measured_size.y;
+            label.nlc_shown_dist = shown_dist;
+            label.nlc_nick = nick;
+            label.nlc_font_size = g->FontSize;
+        }
+
+        const std::string& caption = label.nlc_caption;
+        ImVec2 text_size(label.nlc_text_width, label.nlc_text_height);
+        GUIManager::GuiTheme const& theme = App::GetGuiManager()->GetTheme();
+
         ImVec2 text_pos(pos.x - ((text_size.x / 2)), pos.y - ((text_size.y / 2)));
 
         // Draw background rectangle
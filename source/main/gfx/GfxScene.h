@@ -28,12 +28,17 @@
 #include "CameraManager.h"
 #include "ForwardDeclarations.h"
 #include "EnvironmentMap.h" // RoR::GfxEnvmap
+#include "GfxFrameBudget.h"
+#include "GfxOcclusion.h"
 #include "SimBuffers.h"
 #include "Skidmark.h"
+#include "ThreadPool.h" // class Task
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace RoR {
 
@@ -50,16 +55,23 @@ public:
     void           CreateDustPools();
     DustPool*      GetDustPool(const char* name);
     void           SetParticlesVisible(bool visible);
-    void           DrawNetLabel(Ogre::Vector3 pos, float cam_dist, std::string const& nick, int colornum);
+    void           DrawNetLabel(NetLabelCache& label, Ogre::Vector3 pos, float cam_dist, std::string const& nick, int colornum);
     void           UpdateScene(float dt_sec);
     void           ClearScene();
     void           RegisterGfxActor(RoR::GfxActor* gfx_actor);
     void           RemoveGfxActor(RoR::GfxActor* gfx_actor);
     void           RegisterGfxCharacter(RoR::GfxCharacter* gfx_character);
     void           RemoveGfxCharacter(RoR::GfxCharacter* gfx_character);
+    void           RegisterFlareLight(Ogre::Light* light, float score); //!< Candidate for the light budget, see `UpdateFlareLights()`
+    Ogre::TexturePtr AcquireVideoCamTexture(unsigned int width, unsigned int height); //!< Reuses a released texture of the same size if any
+    void           ReleaseVideoCamTexture(Ogre::TexturePtr tex); //!< Returns the texture to the pool; caller must remove its viewports
+    Ogre::ParticleSystem* AcquireParticleSystem(std::string const& template_name, std::string const& resource_group); //!< Reuses a released system of the same template if any
+    void           ReleaseParticleSystem(Ogre::ParticleSystem* psys); //!< Detaches it and returns it to the pool; systems not from the pool are destroyed
+    void           DiscardParticleSystems(std::string const& resource_group); //!< Destroys pooled systems of a bundle which is about to be reloaded
     void           BufferSimulationData(); //!< Run this when simulation is halted
     GameContextSB&     GetSimDataBuffer() { return m_simbuf; }
     GfxEnvmap&     GetEnvMap() { return m_envmap; }
+    GfxFrameBudget& GetFrameBudget() { return m_frame_budget; }
     RoR::SkidmarkConfig* GetSkidmarkConf () { return &m_skidmark_conf; }
     Ogre::SceneManager* GetSceneManager() { return m_scene_manager; }
     std::vector<GfxActor*>& GetGfxActors() { return m_all_gfx_actors; }
@@ -67,14 +79,81 @@ public:
 
 private:
 
+    void           UpdateActorSchedule(); //!< Decides which live actors get a full visual update this frame, see `GfxBudgetTask::DISTANT_ACTORS`
+    void           UpdateFlexbodyLods();  //!< Decides which flexbodies in `m_flexbody_batch` may deform this frame
+    void           StartFlexbodyBatch();  //!< Deforms `m_flexbody_batch` on the threadpool, in evenly sized vertex chunks
+    void           FinishFlexbodyBatch();
+    void           StartActorUpdates(float dt_sec); //!< Runs `GfxActor::ComputeVisuals()` for all live actors on the threadpool
+    void           ReportDistantActorCost(); //!< Threadpool time of `ACTOR_UPDATE_DISTANT` actors goes to the frame budget
+    void           FinishActorUpdates();
+    void           UpdateFlareLights(); //!< Keeps the `gfx_flares_light_budget` best scoring flare lights on, switches off the rest
+
+    enum ActorUpdate: char
+    {
+        ACTOR_UPDATE_FULL,    //!< Player's actor or big on screen; every frame
+        ACTOR_UPDATE_DISTANT, //!< Small on screen and it's its turn; cost goes to the frame budget
+        ACTOR_UPDATE_SKIPPED, //!< Small on screen and waits for its turn, or occluded; still follows its nodes
+    };
+
+    struct FlareLightCandidate
+    {
+        Ogre::Light*      flc_light;
+        float             flc_score; //!< Light range relative to camera distance; bigger means more visible influence
+    };
+
+    struct FlexbodyChunk
+    {
+        FlexBody*         fc_flexbody;
+        ActorInstanceID_t fc_actor_id;
+        int               fc_begin;
+        int               fc_end;
+        bool              fc_distant; //!< Counts towards `GfxBudgetTask::DISTANT_ACTORS`
+    };
+
     std::map<std::string, DustPool *> m_dustpools;
     Ogre::SceneManager*               m_scene_manager = nullptr;
     std::vector<GfxActor*>            m_all_gfx_actors;
     std::vector<GfxActor*>            m_live_gfx_actors;
     std::vector<GfxCharacter*>        m_all_gfx_characters;
     RoR::GfxEnvmap                    m_envmap;
+    RoR::GfxFrameBudget               m_frame_budget;
+    RoR::GfxOcclusion                 m_occlusion;
+    std::vector<Ogre::TexturePtr>     m_vidcam_texture_pool;  //!< Unused video camera textures; only online (player's) cameras hold one
+    int                               m_vidcam_texture_counter = 0;
+    std::map<std::string, std::vector<Ogre::ParticleSystem*>> m_particle_pool; //!< Released actor particle systems by resource group + template
+    std::map<Ogre::ParticleSystem*, std::string> m_particle_pool_keys; //!< Pool key of every system created by `AcquireParticleSystem()`
+    int                               m_particle_counter = 0;
     GameContextSB                     m_simbuf;
     SkidmarkConfig                    m_skidmark_conf;
+
+    // Last applied FOV inputs; the camera is only touched when one of them changes
+    int                               m_fov_camera_behavior = -1;
+    uint32_t                          m_fov_internal_version = 0;
+    uint32_t                          m_fov_external_version = 0;
+
+    // Visual updates of `m_live_gfx_actors`; small ones take turns when the frame budget is tight
+    std::vector<ActorUpdate>          m_live_actor_updates;
+    std::vector<size_t>               m_distant_actors;         //!< Indices into `m_live_gfx_actors`
+    size_t                            m_distant_actor_cursor = 0; //!< Round-robin position in `m_distant_actors`
+    int                               m_distant_actors_due = 0;
+    std::atomic<int64_t>              m_distant_actor_cost_us{0}; //!< Summed over threadpool workers
+
+    // Flexbodies of all live actors, deformed together; only touched by the batch task while it runs
+    std::vector<FlexBody*>            m_flexbody_batch;
+    std::vector<ActorInstanceID_t>    m_flexbody_batch_actors; //!< For profiling
+    std::vector<ActorUpdate>          m_flexbody_batch_updates; //!< Of the owning actor
+    std::vector<char>                 m_flexbody_batch_deformed;
+    std::vector<char>                 m_flexbody_batch_allowed; //!< By LOD
+    std::vector<float>                m_flexbody_batch_sizes;   //!< Screen-space size, fraction of screen height
+    std::vector<size_t>               m_flexbody_admitted;      //!< Indices into the batch which get deformed
+    int                               m_flexbody_vertex_budget = 0;
+    unsigned int                      m_flexbody_lod_frame = 0;
+    std::vector<FlexbodyChunk>        m_flexbody_chunks;
+    std::shared_ptr<Task>             m_flexbody_task;
+
+    std::shared_ptr<Task>             m_actor_task; //!< CPU-only actor updates, see `StartActorUpdates()`
+
+    std::vector<FlareLightCandidate>  m_flare_light_candidates; //!< Lit flares of all actors this frame, only with a light budget
 };
 
 /// @} // addtogroup Gfx
@@ -28,6 +28,9 @@
 #include "SkyManager.h"
 #include "Terrain.h"
 
+#include <algorithm>
+#include <limits>
+
 #ifdef USE_CAELUM
 #include <Caelum.h>
 #endif // USE_CAELUM
@@ -35,6 +38,15 @@
 using namespace Ogre;
 using namespace RoR;
 
+static const int GRID_LOD_MAX_LEVEL = 2;       // Up to 1/4 of the configured complexity in each direction
+static const int GRID_LOD_MIN_COMPLEXITY = 64;
+static const float GRID_LOD_HYSTERESIS = 0.8f; // Switching re-creates the mesh; don't flip-flop around a threshold
+static const float RTT_SCALE_STEP = 0.25f;
+static const float RTT_SCALE_MIN = 0.5f;
+static const float RTT_SCALE_HEADROOM = 0.8f;  // Raise the resolution only if the frame fits with 20% to spare
+static const float RTT_SCALE_DOWN_SEC = 2.f;   // Switching re-creates the textures; only react to sustained frame times
+static const float RTT_SCALE_UP_SEC = 5.f;
+
 // HydraxWater
 HydraxWater::HydraxWater(float water_height, Ogre::String conf_file):
     waternoise(0)
@@ -73,6 +85,7 @@ void HydraxWater::InitHydrax()
     mHydrax->setModule(static_cast<Hydrax::Module::Module*>(mModule));
 
     mHydrax->loadCfg(CurrentConfigFile);
+    m_grid_full_complexity = mModule->getOptions().Complexity;
 
     // Choose shader language based on renderer (HLSL=0, CG=1, GLSL=2)
     if (Root::getSingleton().getRenderSystem()->getName() == "Direct3D9 Rendering Subsystem" || Root::getSingleton().getRenderSystem()->getName() == "Direct3D11 Rendering Subsystem")
@@ -135,6 +148,16 @@ float HydraxWater::CalcWavesHeight(Vector3 pos)
     return waveHeight;
 }
 
+bool HydraxWater::AreWavesEnabled()
+{
+    return RoR::App::gfx_water_waves->getBool();
+}
+
+float HydraxWater::GetMaxWavesAmplitude()
+{
+    return std::numeric_limits<float>::max();
+}
+
 Vector3 HydraxWater::CalcWavesVelocity(Vector3 pos)
 {
     if (!RoR::App::gfx_water_waves->getBool())
@@ -153,8 +176,83 @@ void HydraxWater::FrameStepWater(float dt)
 {
     if (mHydrax)
     {
+        this->UpdateGridComplexity();
+        this->UpdateRttBudget(dt);
         mHydrax->update(dt);
     }
     this->UpdateWater();
 }
 
+void HydraxWater::UpdateGridComplexity()
+{
+    // From high up, the waves are small on screen and a coarser grid looks the same.
+    // Each level starts 4x higher than the previous one: the grid spreads over 4x the distance.
+    const float lod_height = App::gfx_water_grid_lod_height->getFloat();
+    int level = 0;
+    if (lod_height > 0.f)
+    {
+        const float cam_height = App::GetCameraManager()->GetCameraNode()->_getDerivedPosition().y - waterHeight;
+        level = m_grid_lod_level;
+        if (level < GRID_LOD_MAX_LEVEL && cam_height > lod_height * (1 << (2 * level)))
+        {
+            level++;
+        }
+        else if (level > 0 && cam_height < lod_height * (1 << (2 * (level - 1))) * GRID_LOD_HYSTERESIS)
+        {
+            level--;
+        }
+    }
+
+    if (level != m_grid_lod_level)
+    {
+        m_grid_lod_level = level;
+        Hydrax::Module::ProjectedGrid::Options options = mModule->getOptions();
+        options.Complexity = std::max(std::min(m_grid_full_complexity, GRID_LOD_MIN_COMPLEXITY), m_grid_full_complexity >> level);
+        if (options.Complexity != mModule->getOptions().Complexity)
+        {
+            mModule->setOptions(options);
+        }
+    }
+}
+
+void HydraxWater::UpdateRttBudget(float dt)
+{
+    Hydrax::RttManager* rtt = mHydrax->getRttManager();
+
+    // The depth maps belong to their color maps; the water shader reads them together
+    const int reflection_interval = std::max(1, App::gfx_water_reflection_interval->getInt());
+    const int refraction_interval = std::max(1, App::gfx_water_refraction_interval->getInt());
+    rtt->setUpdateInterval(Hydrax::RttManager::RTT_REFLECTION, reflection_interval);
+    rtt->setUpdateInterval(Hydrax::RttManager::RTT_DEPTH_REFLECTION, reflection_interval);
+    rtt->setUpdateInterval(Hydrax::RttManager::RTT_REFRACTION, refraction_interval);
+    rtt->setUpdateInterval(Hydrax::RttManager::RTT_DEPTH, refraction_interval);
+    rtt->setStillCameraReflectionInterval(App::gfx_water_still_reflection_interval->getInt());
+
+    // Lower the resolution while the frame doesn't fit the budget - the textures are full-screen sized by default
+    float scale = 1.f;
+    const float target_ms = App::gfx_frame_budget_ms->getFloat();
+    if (target_ms > 0.f)
+    {
+        const float frame_ms = App::GetGfxScene()->GetFrameBudget().GetAverageFrameMs();
+        m_rtt_over_budget_sec = (frame_ms > target_ms) ? (m_rtt_over_budget_sec + dt) : 0.f;
+        m_rtt_headroom_sec = (frame_ms < target_ms * RTT_SCALE_HEADROOM) ? (m_rtt_headroom_sec + dt) : 0.f;
+
+        scale = m_rtt_scale;
+        if (m_rtt_over_budget_sec > RTT_SCALE_DOWN_SEC && scale > RTT_SCALE_MIN)
+        {
+            scale = std::max(RTT_SCALE_MIN, scale - RTT_SCALE_STEP);
+            m_rtt_over_budget_sec = 0.f;
+        }
+        else if (m_rtt_headroom_sec > RTT_SCALE_UP_SEC && scale < 1.f)
+        {
+            scale = std::min(1.f, scale + RTT_SCALE_STEP);
+            m_rtt_headroom_sec = 0.f;
+        }
+    }
+
+    if (scale != m_rtt_scale)
+    {
+        m_rtt_scale = scale;
+        rtt->setResolutionScale(scale);
+    }
+}
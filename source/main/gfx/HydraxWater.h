@@ -42,6 +42,8 @@ public:
     float          GetStaticWaterHeight() override;
     void           SetStaticWaterHeight(float value) override;
     float          CalcWavesHeight(Ogre::Vector3 pos) override;
+    bool           AreWavesEnabled() override;
+    float          GetMaxWavesAmplitude() override; //!< Unknown, Hydrax has its own wave modules
     Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) override;
     void           SetWaterVisible(bool value) override;
     void           WaterSetSunPosition(Ogre::Vector3) override;
@@ -54,12 +56,19 @@ public:
 protected:
 
     void InitHydrax();
+    void UpdateGridComplexity(); //!< Coarser projected grid for high cameras, see 'gfx_water_grid_lod_height'
+    void UpdateRttBudget(float dt); //!< Reflection/refraction update rates and resolution, see 'gfx_water_*_interval' and 'gfx_frame_budget_ms'
     Hydrax::Hydrax* mHydrax;
     float waveHeight;
     float waterHeight;
     Hydrax::Noise::Perlin* waternoise;
     Hydrax::Module::ProjectedGrid* mModule;
     Ogre::String CurrentConfigFile;
+    int m_grid_full_complexity = 0; //!< As configured
+    int m_grid_lod_level = 0;       //!< Complexity is halved for each level
+    float m_rtt_scale = 1.f;        //!< Resolution of reflection/refraction textures, lowered when over frame budget
+    float m_rtt_over_budget_sec = 0.f;
+    float m_rtt_headroom_sec = 0.f;
 };
 
 /// @} // addtogroup Gfx
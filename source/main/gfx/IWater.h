@@ -45,6 +45,8 @@ public:
     virtual void           SetWaterBottomHeight(float value) {};
     virtual void           SetWavesHeight(float value) {};
     virtual float          CalcWavesHeight(Ogre::Vector3 pos) = 0;
+    virtual bool           AreWavesEnabled() { return false; } //!< False if `CalcWavesHeight()` is just the static height
+    virtual float          GetMaxWavesAmplitude() { return 0.f; } //!< No wave reaches higher above the static height
     virtual Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) = 0;
     virtual void           SetWaterVisible(bool value) = 0;
     virtual void           WaterSetSunPosition(Ogre::Vector3) {}
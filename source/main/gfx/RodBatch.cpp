@@ -0,0 +1,257 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "RodBatch.h"
+
+#include "Application.h"
+#include "GfxScene.h"
+
+using namespace Ogre;
+using namespace RoR;
+
+std::vector<RodBatch::RodVertex> RodBatch::s_template_vertices;
+std::vector<uint32_t>            RodBatch::s_template_indices;
+
+RodBatch::RodBatch(std::string const& name, std::string const& material_name, Ogre::SceneNode* parent_scenenode):
+    m_material_name(material_name)
+{
+    RodBatch::LoadRodTemplate();
+
+    m_mesh = MeshManager::getSingleton().createManual(name, ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    m_submesh = m_mesh->createSubMesh();
+    m_submesh->setMaterialName(material_name);
+    m_submesh->useSharedVertices = true;
+
+    m_mesh->sharedVertexData = new VertexData();
+    m_mesh->sharedVertexData->vertexCount = 0;
+    VertexDeclaration* decl = m_mesh->sharedVertexData->vertexDeclaration;
+    size_t offset = 0;
+    decl->addElement(0, offset, VET_FLOAT3, VES_POSITION);
+    offset += VertexElement::getTypeSize(VET_FLOAT3);
+    decl->addElement(0, offset, VET_FLOAT3, VES_NORMAL);
+    offset += VertexElement::getTypeSize(VET_FLOAT3);
+    decl->addElement(0, offset, VET_FLOAT2, VES_TEXTURE_COORDINATES, 0);
+
+    m_mesh->_setBounds(AxisAlignedBox(-1, -1, -1, 1, 1, 1), true);
+    m_mesh->load();
+
+    m_entity = App::GetGfxScene()->GetSceneManager()->createEntity(name, m_mesh->getName(), ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    m_entity->setVisible(false); // Until there are buffers to draw
+    m_scenenode = parent_scenenode->createChildSceneNode();
+    m_scenenode->attachObject(m_entity);
+}
+
+RodBatch::~RodBatch()
+{
+    m_scenenode->detachAllObjects();
+    App::GetGfxScene()->GetSceneManager()->destroySceneNode(m_scenenode);
+    App::GetGfxScene()->GetSceneManager()->destroyEntity(m_entity);
+    MeshManager::getSingleton().remove(m_mesh->getHandle());
+}
+
+void RodBatch::LoadRodTemplate()
+{
+    if (!s_template_vertices.empty())
+    {
+        return;
+    }
+
+    MeshPtr mesh = MeshManager::getSingleton().load("beam.mesh", ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+    std::vector<RodVertex> vertices;
+    std::vector<uint32_t> indices;
+    size_t shared_offset = 0;
+    bool added_shared = false;
+
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); i++)
+    {
+        SubMesh* submesh = mesh->getSubMesh(i);
+        VertexData* vertex_data = (submesh->useSharedVertices) ? mesh->sharedVertexData : submesh->vertexData;
+        size_t base_vertex = vertices.size();
+        if (submesh->useSharedVertices && added_shared)
+        {
+            base_vertex = shared_offset;
+        }
+        else
+        {
+            if (submesh->useSharedVertices)
+            {
+                added_shared = true;
+                shared_offset = base_vertex;
+            }
+            const RodVertex blank = { Vector3::ZERO, Vector3::UNIT_Y, Vector2::ZERO };
+            vertices.resize(base_vertex + vertex_data->vertexCount, blank);
+            const VertexElement* elems[3] = {
+                vertex_data->vertexDeclaration->findElementBySemantic(VES_POSITION),
+                vertex_data->vertexDeclaration->findElementBySemantic(VES_NORMAL),
+                vertex_data->vertexDeclaration->findElementBySemantic(VES_TEXTURE_COORDINATES) };
+            for (int e = 0; e < 3; e++)
+            {
+                if (elems[e] == nullptr)
+                {
+                    continue; // Keep the defaults
+                }
+                HardwareVertexBufferSharedPtr vbuf = vertex_data->vertexBufferBinding->getBuffer(elems[e]->getSource());
+                unsigned char* vertex = static_cast<unsigned char*>(vbuf->lock(HardwareBuffer::HBL_READ_ONLY));
+                for (size_t j = 0; j < vertex_data->vertexCount; ++j, vertex += vbuf->getVertexSize())
+                {
+                    float* src = nullptr;
+                    elems[e]->baseVertexPointerToElement(vertex, &src);
+                    RodVertex& dst = vertices[base_vertex + j];
+                    switch (e)
+                    {
+                    case 0:  dst.position = Vector3(src[0], src[1], src[2]); break;
+                    case 1:  dst.normal   = Vector3(src[0], src[1], src[2]); break;
+                    default: dst.texcoord = Vector2(src[0], src[1]);
+                    }
+                }
+                vbuf->unlock();
+            }
+        }
+
+        IndexData* index_data = submesh->indexData;
+        HardwareIndexBufferSharedPtr ibuf = index_data->indexBuffer;
+        const bool use_32bit = (ibuf->getType() == HardwareIndexBuffer::IT_32BIT);
+        const void* src = ibuf->lock(HardwareBuffer::HBL_READ_ONLY);
+        for (size_t j = index_data->indexStart; j < index_data->indexStart + index_data->indexCount; j++)
+        {
+            const uint32_t idx = (use_32bit) ? static_cast<const uint32_t*>(src)[j] : static_cast<const uint16_t*>(src)[j];
+            indices.push_back(static_cast<uint32_t>(base_vertex) + idx);
+        }
+        ibuf->unlock();
+    }
+
+    s_template_vertices = vertices;
+    s_template_indices = indices;
+}
+
+void RodBatch::SetNumRods(size_t num_rods)
+{
+    m_rods.clear();
+    m_rods.resize(num_rods);
+    m_entity->setVisible(num_rods > 0);
+    if (num_rods == 0)
+    {
+        return;
+    }
+
+    const size_t num_vertices = num_rods * s_template_vertices.size();
+    const size_t num_indices  = num_rods * s_template_indices.size();
+    m_vertices.resize(num_vertices);
+
+    // Vertices are rewritten every frame
+    m_hw_vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
+        sizeof(RodVertex), num_vertices, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+    m_mesh->sharedVertexData->vertexBufferBinding->setBinding(0, m_hw_vbuf);
+    m_mesh->sharedVertexData->vertexCount = num_vertices;
+
+    // Indices never change: the template repeated once per rod
+    const bool use_32bit = (num_vertices > std::numeric_limits<uint16_t>::max());
+    HardwareIndexBufferSharedPtr ibuf = HardwareBufferManager::getSingleton().createIndexBuffer(
+        (use_32bit) ? HardwareIndexBuffer::IT_32BIT : HardwareIndexBuffer::IT_16BIT, num_indices, HardwareBuffer::HBU_STATIC_WRITE_ONLY);
+    void* dst = ibuf->lock(HardwareBuffer::HBL_DISCARD);
+    size_t cursor = 0;
+    for (size_t rod = 0; rod < num_rods; rod++)
+    {
+        const uint32_t base_vertex = static_cast<uint32_t>(rod * s_template_vertices.size());
+        for (uint32_t idx: s_template_indices)
+        {
+            if (use_32bit)
+                static_cast<uint32_t*>(dst)[cursor++] = base_vertex + idx;
+            else
+                static_cast<uint16_t*>(dst)[cursor++] = static_cast<uint16_t>(base_vertex + idx);
+        }
+    }
+    ibuf->unlock();
+    m_submesh->indexData->indexBuffer = ibuf;
+    m_submesh->indexData->indexCount = num_indices;
+    m_submesh->indexData->indexStart = 0;
+}
+
+void RodBatch::SetRod(size_t index, Ogre::Vector3 const& position, Ogre::Quaternion const& orientation, Ogre::Vector3 const& scale)
+{
+    RodInstance& rod = m_rods[index];
+    rod.position = position;
+    rod.orientation = orientation;
+    rod.scale = scale;
+    rod.visible = true;
+}
+
+void RodBatch::HideRod(size_t index)
+{
+    m_rods[index].visible = false;
+}
+
+void RodBatch::UpdateBatch()
+{
+    if (m_rods.empty())
+    {
+        return;
+    }
+
+    // Vertices are relative to the scene node, which sits at the first visible rod
+    Vector3 center = Vector3::ZERO;
+    for (RodInstance& rod: m_rods)
+    {
+        if (rod.visible)
+        {
+            center = rod.position;
+            break;
+        }
+    }
+
+    AxisAlignedBox bounds;
+    RodVertex* dst = m_vertices.data();
+    for (RodInstance& rod: m_rods)
+    {
+        if (!rod.visible)
+        {
+            // Collapse to a point - degenerate triangles aren't rasterized
+            for (size_t i = 0; i < s_template_vertices.size(); i++)
+            {
+                dst->position = Vector3::ZERO;
+                dst->normal = Vector3::UNIT_Y;
+                dst->texcoord = s_template_vertices[i].texcoord;
+                dst++;
+            }
+            continue;
+        }
+
+        Matrix3 rot;
+        rod.orientation.ToRotationMatrix(rot);
+        const Vector3 offset = rod.position - center;
+        for (RodVertex const& src: s_template_vertices)
+        {
+            dst->position = offset + rot * (src.position * rod.scale);
+            dst->normal = rot * src.normal;
+            dst->texcoord = src.texcoord;
+            bounds.merge(dst->position);
+            dst++;
+        }
+    }
+
+    m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices.data(), true);
+    if (bounds.isNull())
+    {
+        bounds = AxisAlignedBox(Vector3::ZERO, Vector3::ZERO);
+    }
+    m_mesh->_setBounds(bounds, false);
+    m_scenenode->setPosition(center);
+}
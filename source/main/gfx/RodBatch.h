@@ -0,0 +1,88 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Batched visuals of softbody beams ("rods")
+
+#pragma once
+
+#include <Ogre.h>
+
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Gfx
+/// @{
+
+/// Draws all rods of an actor which share a material as a single dynamic mesh - one draw call and one scene node
+/// instead of an entity and a scene node per rod. Each rod is a copy of 'beam.mesh' transformed on CPU
+/// from a packed per-rod transform, just like the scene node used to do it.
+class RodBatch
+{
+public:
+    RodBatch(std::string const& name, std::string const& material_name, Ogre::SceneNode* parent_scenenode); //!< Throws `Ogre::Exception` if 'beam.mesh' can't be loaded
+    ~RodBatch();
+
+    void               SetNumRods(size_t num_rods); //!< Resizes the buffers; rods start hidden.
+    size_t             GetNumRods() const { return m_rods.size(); }
+    void               SetRod(size_t index, Ogre::Vector3 const& position, Ogre::Quaternion const& orientation, Ogre::Vector3 const& scale);
+    void               HideRod(size_t index);
+    void               UpdateBatch(); //!< Transforms and uploads all rods; call once per frame after `SetRod()`/`HideRod()`
+    void               SetCastShadows(bool value) { m_entity->setCastShadows(value); }
+    std::string const& GetMaterialName() const { return m_material_name; }
+
+private:
+
+    struct RodVertex
+    {
+        Ogre::Vector3 position;
+        Ogre::Vector3 normal;
+        Ogre::Vector2 texcoord;
+    };
+
+    struct RodInstance //!< Per-rod transform
+    {
+        Ogre::Vector3    position = Ogre::Vector3::ZERO;
+        Ogre::Quaternion orientation = Ogre::Quaternion::IDENTITY;
+        Ogre::Vector3    scale = Ogre::Vector3::ZERO;
+        bool             visible = false;
+    };
+
+    static void        LoadRodTemplate(); //!< Reads 'beam.mesh' on first use
+
+    static std::vector<RodVertex> s_template_vertices;
+    static std::vector<uint32_t>  s_template_indices;
+
+    std::string                   m_material_name;
+    Ogre::MeshPtr                 m_mesh;
+    Ogre::SubMesh*                m_submesh = nullptr;
+    Ogre::Entity*                 m_entity = nullptr;
+    Ogre::SceneNode*              m_scenenode = nullptr;
+    Ogre::HardwareVertexBufferSharedPtr m_hw_vbuf;
+    std::vector<RodInstance>      m_rods;
+    std::vector<RodVertex>        m_vertices; //!< Staging buffer, uploaded whole
+};
+
+/// @} // addtogroup Gfx
+
+} // namespace RoR
@@ -0,0 +1,141 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "ShaderCache.h"
+
+#include "Application.h"
+#include "PlatformUtils.h"
+
+#include <OgreGpuProgramManager.h>
+#include <OgreHighLevelGpuProgramManager.h>
+#include <OgreRenderSystem.h>
+#include <OgreRenderSystemCapabilities.h>
+#include <OgreRoot.h>
+
+#include <fmt/format.h>
+#include <fstream>
+
+using namespace RoR;
+
+static const char* SHADER_CACHE_VERSION = "1"; // Bump to drop caches written by older versions
+
+std::string ShaderCache::GetFilePath()
+{
+    // Microcode is only valid for the render system, device and driver it was compiled with.
+    Ogre::RenderSystem* rs = Ogre::Root::getSingleton().getRenderSystem();
+    const Ogre::RenderSystemCapabilities* caps = rs->getCapabilities();
+    const std::string key = fmt::format("{}|{}|{}|{}", SHADER_CACHE_VERSION,
+        rs->getName(), caps->getDeviceName(), caps->getDriverVersion().toString());
+    const Ogre::uint32 hash = Ogre::FastHash(key.c_str(), key.size());
+
+    return PathCombine(App::sys_cache_dir->getStr(), fmt::format("shadercache_{:08x}.bin", hash));
+}
+
+void ShaderCache::Load()
+{
+    Ogre::GpuProgramManager& mgr = Ogre::GpuProgramManager::getSingleton();
+    if (!App::gfx_shader_cache->getBool() || !mgr.canGetCompiledShaderBuffer())
+    {
+        return;
+    }
+
+    mgr.setSaveMicrocodesToCache(true);
+
+    const std::string path = GetFilePath();
+    if (!FileExists(path))
+    {
+        return;
+    }
+
+    try
+    {
+        std::ifstream* ifs = OGRE_NEW_T(std::ifstream, Ogre::MEMCATEGORY_GENERAL)(path.c_str(), std::ios::binary);
+        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(path, ifs, /*freeOnClose=*/true));
+        mgr.loadMicrocodeCache(stream);
+        LOG(fmt::format("[RoR|ShaderCache] Loaded '{}'", path));
+    }
+    catch (std::exception& e)
+    {
+        LOG(fmt::format("[RoR|ShaderCache] Could not load '{}', message: {}", path, e.what()));
+    }
+}
+
+void ShaderCache::Save()
+{
+    Ogre::GpuProgramManager& mgr = Ogre::GpuProgramManager::getSingleton();
+    if (!mgr.getSaveMicrocodesToCache() || !mgr.isCacheDirty())
+    {
+        return;
+    }
+
+    const std::string path = GetFilePath();
+    try
+    {
+        CreateFolder(App::sys_cache_dir->getStr());
+        std::fstream* fs = OGRE_NEW_T(std::fstream, Ogre::MEMCATEGORY_GENERAL)(path.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        Ogre::DataStreamPtr stream(OGRE_NEW Ogre::FileStreamDataStream(path, fs, /*freeOnClose=*/true));
+        mgr.saveMicrocodeCache(stream);
+        LOG(fmt::format("[RoR|ShaderCache] Saved '{}'", path));
+    }
+    catch (std::exception& e)
+    {
+        LOG(fmt::format("[RoR|ShaderCache] Could not save '{}', message: {}", path, e.what()));
+    }
+}
+
+void ShaderCache::PrecompilePrograms(std::string const& resource_group)
+{
+    int num_compiled = 0;
+    Ogre::ResourceManager::ResourceMapIterator itor = Ogre::HighLevelGpuProgramManager::getSingleton().getResourceIterator();
+    while (itor.hasMoreElements())
+    {
+        Ogre::ResourcePtr program = itor.getNext();
+        if (program->getGroup() != resource_group || program->isLoaded())
+        {
+            continue;
+        }
+
+        try
+        {
+            program->load(); // Compiles, or fetches the microcode from the cache
+            ++num_compiled;
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG(fmt::format("[RoR|ShaderCache] Could not precompile '{}', message: {}", program->getName(), e.getFullDescription()));
+        }
+    }
+
+    LOG(fmt::format("[RoR|ShaderCache] Precompiled {} GPU programs from group '{}'", num_compiled, resource_group));
+}
+
+ShaderCacheBypass::ShaderCacheBypass()
+{
+    Ogre::GpuProgramManager& mgr = Ogre::GpuProgramManager::getSingleton();
+    m_was_saving = mgr.getSaveMicrocodesToCache();
+    mgr.setSaveMicrocodesToCache(false);
+}
+
+ShaderCacheBypass::~ShaderCacheBypass()
+{
+    Ogre::GpuProgramManager::getSingleton().setSaveMicrocodesToCache(m_was_saving);
+}
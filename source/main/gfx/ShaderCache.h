@@ -0,0 +1,63 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/// @file
+/// @brief Persistent cache of compiled GPU programs.
+
+#pragma once
+
+#include <string>
+
+namespace RoR {
+
+/// @addtogroup Gfx
+/// @{
+
+/// Keeps OGRE's GPU program microcode cache in 'sys_cache_dir' between launches, so programs from
+/// material scripts aren't recompiled every time. One file per render system, device and driver.
+/// OGRE 1.11 looks microcode up by program name only, so programs whose source is generated at
+/// runtime (terrain, Hydrax) must be compiled inside a `ShaderCacheBypass`.
+class ShaderCache
+{
+public:
+    static void        Load();  //!< Call once the render system is up; enables saving of new microcode.
+    static void        Save();  //!< Writes the file only if new programs were compiled since the last load/save.
+    static void        PrecompilePrograms(std::string const& resource_group); //!< Compiles all GPU programs of the group now - call while a loading screen is up.
+
+private:
+    static std::string GetFilePath();
+};
+
+/// Keeps programs compiled in the enclosing scope out of the cache.
+class ShaderCacheBypass
+{
+public:
+    ShaderCacheBypass();
+    ~ShaderCacheBypass();
+
+private:
+    bool               m_was_saving;
+};
+
+/// @} // addtogroup Gfx
+
+} // namespace RoR
@@ -171,10 +171,18 @@ void ShadowManager::updateTerrainMaterial(Ogre::TerrainPSSMMaterialGenerator::SM
         matProfile->setReceiveDynamicShadowsLowLod(false);
         matProfile->setReceiveDynamicShadowsEnabled(true);
         matProfile->setReceiveDynamicShadowsPSSM(pssmSetup);
-        matProfile->setLightmapEnabled(false);
+        if (!App::gfx_reduce_shadows->getBool())
+        {
+            matProfile->setLightmapEnabled(false);
+        }
     }
 }
 
+bool ShadowManager::IsTerrainShadowFromLightmap(Ogre::TerrainPSSMMaterialGenerator::SM2Profile* matProfile)
+{
+    return App::gfx_reduce_shadows->getBool() && matProfile->isLightmapEnabled();
+}
+
 void ShadowManager::setManagedMaterialSplitPoints(Ogre::PSSMShadowCameraSetup::SplitPointList splitPointList)
 {
     Ogre::Vector4 splitPoints;
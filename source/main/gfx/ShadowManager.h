@@ -61,6 +61,10 @@ public:
 
     void updateTerrainMaterial(Ogre::TerrainPSSMMaterialGenerator::SM2Profile* matProfile);
 
+    /// With 'gfx_reduce_shadows', terrain self-shadowing comes from the lightmap, which is
+    /// only regenerated when the sun moves, and the PSSM cascades render just the objects.
+    bool IsTerrainShadowFromLightmap(Ogre::TerrainPSSMMaterialGenerator::SM2Profile* matProfile);
+
 protected:
 
     void processPSSM();
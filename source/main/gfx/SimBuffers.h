@@ -40,6 +40,9 @@
        It only updates positons and forces, it doesn't deal with graphics at all.
     2. When time comes for rendering, simulation is halted and all data relevant to graphics
        are copied-out to simbuffers. Then, simulation is resumed.
+       Node positions (the bulk of the data) are pre-copied by the sim thread itself
+       at the end of each physics task, so the halted phase only swaps buffers
+       (see `GfxActor::BufferNodesFromSimThread()`).
     3. The rendering thread processes the simbuffers and updates visual objects.
 
     OVERVIEW OF GAMEPLAY OBJECTS
@@ -118,6 +121,8 @@ struct ActorSB
     std::string       simbuf_net_username;
     int               simbuf_net_colornum;
     int               simbuf_driveable                = ActorType::NOT_DRIVEABLE;
+    bool              simbuf_net_reduced_detail       = false; //!< Remote actor far away or off-screen, see `Actor::m_net_reduced_detail`
+    bool              simbuf_net_nodes_updated        = false; //!< Remote actor's nodes moved since last buffering
 
     // Movement
     Ogre::Vector3     simbuf_pos                      = Ogre::Vector3::ZERO;
@@ -84,28 +84,52 @@ int RoR::SkidmarkConfig::ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::
     cfg.slipFrom = Ogre::StringConverter::parseReal(args[2]);
     cfg.slipTo = Ogre::StringConverter::parseReal(args[3]);
 
-    if (!m_models.size() || m_models.find(modelName) == m_models.end())
-        m_models[modelName] = std::vector<SkidmarkDef>();
-
-    m_models[modelName].push_back(cfg);
+    m_models[modelName].defs.push_back(cfg);
     return 0;
 }
 
-int RoR::SkidmarkConfig::getTexture(Ogre::String model, Ogre::String ground, float slip, Ogre::String& texture)
+int RoR::SkidmarkConfig::getTexture(Ogre::String const& model, ground_model_t const& ground, float slip, Ogre::String& texture)
 {
-    if (m_models.find(model) == m_models.end())
+    auto found = m_models.find(model);
+    if (found == m_models.end() || ground.gm_id == GROUNDMODELID_INVALID)
         return 1;
-    for (std::vector<SkidmarkDef>::iterator it = m_models[model].begin(); it != m_models[model].end(); it++)
+
+    SkidmarkModel& skid_model = found->second;
+    if (ground.gm_id >= (int)skid_model.ground_defs.size())
+    {
+        skid_model.ground_defs.resize(ground.gm_id + 1);
+    }
+    std::vector<size_t>& ground_defs = skid_model.ground_defs[ground.gm_id];
+    if (ground_defs.empty())
+    {
+        // Resolve the name once; `defs.size()` marks a ground without skidmarks
+        for (size_t i = 0; i < skid_model.defs.size(); i++)
+        {
+            if (skid_model.defs[i].ground == ground.name)
+                ground_defs.push_back(i);
+        }
+        ground_defs.push_back(skid_model.defs.size());
+    }
+
+    for (size_t i: ground_defs)
     {
-        if (it->ground == ground && it->slipFrom <= slip && it->slipTo > slip)
+        if (i < skid_model.defs.size() && skid_model.defs[i].slipFrom <= slip && skid_model.defs[i].slipTo > slip)
         {
-            texture = it->texture.c_str();
+            texture = skid_model.defs[i].texture;
             return 0;
         }
     }
     return 2;
 }
 
+void RoR::SkidmarkConfig::ClearGroundModelCache()
+{
+    for (auto& model_entry: m_models)
+    {
+        model_entry.second.ground_defs.clear();
+    }
+}
+
 // this is a hardcoded array which we use to map ground types to a certain texture with UV/ coords
 Ogre::Vector2 RoR::Skidmark::m_tex_coords[4] = {Ogre::Vector2(0, 0), Ogre::Vector2(0, 1), Ogre::Vector2(1, 0), Ogre::Vector2(1, 1)};
 
@@ -131,18 +155,16 @@ RoR::Skidmark::~Skidmark()
     this->reset();
 }
 
-void RoR::Skidmark::AddObject(Ogre::Vector3 start, Ogre::String texture)
+Ogre::String RoR::Skidmark::GetSharedMaterial(Ogre::String const& texture)
 {
-    SkidmarkSegment skid;
-    skid.pos = 0;
-    skid.lastPointAv = start;
-    skid.facecounter = 0;
+    const Ogre::String name = "mat-skidmark-" + texture;
+    if (Ogre::MaterialManager::getSingleton().getByName(name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME))
+    {
+        return name;
+    }
 
-    // new material
-    char bname[256] = "";
-    sprintf(bname, "mat-skidmark-%d", m_instance_counter);
-    skid.material = Ogre::MaterialManager::getSingleton().create(bname, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
-    Ogre::Pass* p = skid.material->getTechnique(0)->getPass(0);
+    Ogre::MaterialPtr mat = Ogre::MaterialManager::getSingleton().create(name, Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME);
+    Ogre::Pass* p = mat->getTechnique(0)->getPass(0);
 
     p->createTextureUnitState(texture);
     p->setSceneBlending(Ogre::SBT_TRANSPARENT_ALPHA);
@@ -150,59 +172,65 @@ void RoR::Skidmark::AddObject(Ogre::Vector3 start, Ogre::String texture)
     p->setDepthWriteEnabled(false);
     p->setDepthBias(3, 3);
     p->setCullingMode(Ogre::CULL_NONE);
+    return name;
+}
+
+void RoR::Skidmark::AddObject(Ogre::Vector3 start, Ogre::String const& texture)
+{
+    const Ogre::String mat_name = Skidmark::GetSharedMaterial(texture);
+
+    SkidmarkSegment skid;
+    if ((int)m_objects.size() >= m_bucket_count)
+    {
+        // Recycle the oldest segment - its buffers and ManualObject are already sized
+        skid = std::move(m_objects.front());
+        m_objects.pop();
+        skid.obj->getSection(0)->setMaterialName(mat_name);
+        skid.obj->beginUpdate(0);
+    }
+    else
+    {
+        skid.points.resize(m_length);
+        skid.faceSizes.resize(m_length);
+        skid.obj = App::GetGfxScene()->GetSceneManager()->createManualObject("skidmark" + TOSTRING(m_instance_counter++));
+        skid.obj->setDynamic(true);
+        skid.obj->setRenderingDistance(800); // 800m view distance
+        skid.obj->begin(mat_name, Ogre::RenderOperation::OT_TRIANGLE_STRIP);
+        m_scene_node->attachObject(skid.obj);
+    }
+    skid.pos = 0;
+    skid.lastPointAv = start;
+    skid.facecounter = 0;
+    skid.groundTexture = texture;
 
-    skid.points.resize(m_length);
-    skid.faceSizes.resize(m_length);
-    skid.groundTexture.resize(m_length);
-    skid.obj = App::GetGfxScene()->GetSceneManager()->createManualObject("skidmark" + TOSTRING(m_instance_counter++));
-    skid.obj->setDynamic(true);
-    skid.obj->setRenderingDistance(800); // 800m view distance
-    skid.obj->begin(bname, Ogre::RenderOperation::OT_TRIANGLE_STRIP);
     for (int i = 0; i < m_length; i++)
     {
         skid.points[i] = start;
         skid.faceSizes[i] = 0;
-        skid.groundTexture[i] = "0.png";
         skid.obj->position(start);
         skid.obj->textureCoord(0, 0);
     }
     skid.obj->end();
-    m_scene_node->attachObject(skid.obj);
 
-    m_objects.push(skid);
-
-    this->LimitObjects();
+    m_objects.push(std::move(skid));
 }
 
 void RoR::Skidmark::PopSegment()
 {
     SkidmarkSegment& skid = m_objects.front();
-    skid.points.clear();
-    skid.faceSizes.clear();
-    Ogre::MaterialManager::getSingleton().remove(skid.material->getName());
-    skid.material.setNull();
     App::GetGfxScene()->GetSceneManager()->destroyManualObject(skid.obj);
     m_objects.pop();
 }
 
-void RoR::Skidmark::LimitObjects()
-{
-    if ((int)m_objects.size() > m_bucket_count)
-    {
-        this->PopSegment();
-    }
-}
-
-void RoR::Skidmark::SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture)
+void RoR::Skidmark::SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize)
 {
     m_objects.back().points[index] = value;
     m_objects.back().faceSizes[index] = fsize;
-    m_objects.back().groundTexture[index] = texture;
 
     m_is_dirty = true;
 }
 
-void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name)
+void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, ground_model_t const& ground_model)
 {
     Ogre::Vector3 thisPoint = contact_point;
     Ogre::Vector3 axis = m_wheel->wh_axis_node_1->RelPosition - m_wheel->wh_axis_node_0->RelPosition;
@@ -214,7 +242,7 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
     Ogre::Real distance = 0;
     Ogre::Real maxDist = m_max_distance;
     Ogre::String texture = "none";
-    m_config->getTexture("default", ground_model_name, slip, texture);
+    m_config->getTexture("default", ground_model, slip, texture);
 
     // dont add points with no texture
     if (texture == "none")
@@ -231,7 +259,7 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
     else
     {
         // check existing buckets
-        SkidmarkSegment skid = m_objects.back();
+        SkidmarkSegment& skid = m_objects.back();
 
         distance = skid.lastPointAv.distance(thisPointAV);
         // too near to update?
@@ -242,7 +270,7 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
         }
 
         // change ground texture if required
-        if (skid.pos > 0 && skid.groundTexture[0] != texture)
+        if (skid.pos > 0 && skid.groundTexture != texture)
         {
             // new object with new texture
             if (distance > maxDist)
@@ -256,8 +284,8 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
                 Ogre::Vector3 lp1 = m_objects.back().points[m_objects.back().pos - 1];
                 Ogre::Vector3 lp2 = m_objects.back().points[m_objects.back().pos - 2];
                 this->AddObject(lp1, texture);
-                this->AddPoint(lp2, distance, texture);
-                this->AddPoint(lp1, distance, texture);
+                this->AddPoint(lp2, distance);
+                this->AddPoint(lp1, distance);
             }
         }
         else
@@ -278,8 +306,8 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
                     Ogre::Vector3 lp1 = m_objects.back().points[m_objects.back().pos - 1];
                     Ogre::Vector3 lp2 = m_objects.back().points[m_objects.back().pos - 2];
                     this->AddObject(lp1, texture);
-                    this->AddPoint(lp2, distance, texture);
-                    this->AddPoint(lp1, distance, texture);
+                    this->AddPoint(lp2, distance);
+                    this->AddPoint(lp1, distance);
                 }
             }
             else if (distance > m_max_distance)
@@ -292,20 +320,20 @@ void RoR::Skidmark::UpdatePoint(Ogre::Vector3 contact_point, int index, float sl
 
     const float overaxis = 0.2f;
 
-    this->AddPoint(contact_point - (axis * overaxis), distance, texture);
-    this->AddPoint(contact_point + axis + (axis * overaxis), distance, texture);
+    this->AddPoint(contact_point - (axis * overaxis), distance);
+    this->AddPoint(contact_point + axis + (axis * overaxis), distance);
 
     // save as last point (in the middle of the m_wheel)
     m_objects.back().lastPointAv = thisPointAV;
 }
 
-void RoR::Skidmark::AddPoint(const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture)
+void RoR::Skidmark::AddPoint(const Ogre::Vector3& value, Ogre::Real fsize)
 {
     if (m_objects.back().pos >= m_length)
     {
         return;
     }
-    this->SetPointInt(m_objects.back().pos, value, fsize, texture);
+    this->SetPointInt(m_objects.back().pos, value, fsize);
     m_objects.back().pos++;
 }
 
@@ -315,14 +343,14 @@ void RoR::Skidmark::reset()
         this->PopSegment();
 }
 
-void RoR::Skidmark::update(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name)
+void RoR::Skidmark::update(Ogre::Vector3 contact_point, int index, float slip, ground_model_t const& ground_model)
 {
-    this->UpdatePoint(contact_point, index, slip, ground_model_name);
+    this->UpdatePoint(contact_point, index, slip, ground_model);
     if (!m_is_dirty)
         return;
     if (!m_objects.size())
         return;
-    SkidmarkSegment skid = m_objects.back();
+    SkidmarkSegment& skid = m_objects.back();
     Ogre::Vector3 vaabMin = skid.points[0];
     Ogre::Vector3 vaabMax = skid.points[0];
     skid.obj->beginUpdate(0);
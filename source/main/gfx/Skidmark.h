@@ -35,7 +35,8 @@ public:
 
     void LoadDefaultSkidmarkDefs();
 
-    int getTexture(Ogre::String model, Ogre::String ground, float slip, Ogre::String& texture);
+    int getTexture(Ogre::String const& model, ground_model_t const& ground, float slip, Ogre::String& texture);
+    void ClearGroundModelCache(); //!< Ground model IDs are per terrain, see `Collisions::getGroundModel()`
 
 private:
 
@@ -47,9 +48,15 @@ private:
         float slipTo;   //!< Maximum slipping velocity
     };
 
+    struct SkidmarkModel
+    {
+        std::vector<SkidmarkDef> defs;
+        std::vector<std::vector<size_t>> ground_defs; //!< Indices to `defs` by `GroundModelID_t`, resolved from names on first use
+    };
+
     int ProcessSkidmarkConfLine(Ogre::StringVector args, Ogre::String model);
 
-    std::map<Ogre::String, std::vector<SkidmarkDef>> m_models;
+    std::map<Ogre::String, SkidmarkModel> m_models;
 };
 
 /// @addtogroup Gfx
@@ -64,28 +71,28 @@ public:
     virtual ~Skidmark();
 
     void reset();
-    void update(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name);
+    void update(Ogre::Vector3 contact_point, int index, float slip, ground_model_t const& ground_model);
 
 private:
 
     struct SkidmarkSegment //!< Also reffered to as 'bucket'
     {
         Ogre::ManualObject* obj;
-        Ogre::MaterialPtr material;
         std::vector<Ogre::Vector3> points;
         std::vector<Ogre::Real> faceSizes;
-        std::vector<Ogre::String> groundTexture;
+        Ogre::String groundTexture; //!< One texture per segment; a change of ground starts a new segment.
         Ogre::Vector3 lastPointAv;
         int pos;
         int facecounter;
     };
 
     void PopSegment();
-    void LimitObjects();
-    void AddObject(Ogre::Vector3 start, Ogre::String texture);
-    void SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture);
-    void AddPoint(const Ogre::Vector3& value, Ogre::Real fsize, Ogre::String texture);
-    void UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, Ogre::String ground_model_name);
+    void AddObject(Ogre::Vector3 start, Ogre::String const& texture);
+    void SetPointInt(unsigned short index, const Ogre::Vector3& value, Ogre::Real fsize);
+    void AddPoint(const Ogre::Vector3& value, Ogre::Real fsize);
+    void UpdatePoint(Ogre::Vector3 contact_point, int index, float slip, ground_model_t const& ground_model);
+
+    static Ogre::String  GetSharedMaterial(Ogre::String const& texture); //!< One material per ground texture, shared by all skidmarks
 
     static int           m_instance_counter;
     bool                 m_is_dirty;
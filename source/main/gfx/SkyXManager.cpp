@@ -88,26 +88,35 @@ bool SkyXManager::UpdateSkyLight()
 	const Ogre::Vector3 camPos = App::GetCameraManager()->GetCameraNode()->_getDerivedPosition();
 	Ogre::Vector3 sunPos = camPos - lightDir*mSkyX->getMeshManager()->getSkydomeRadius(App::GetCameraManager()->GetCamera());
 
+    // The sun position follows the camera, but the colors only depend on time of day.
+    // Re-evaluate the gradients once the sun has moved more than ~0.1 degree.
+    const bool sun_moved = lightDir.dotProduct(mLastLightDir) < 0.9999985f;
+
 	// Calculate current color gradients point
 	float point = (-lightDir.y + 1.0f) / 2.0f;
 
     if (App::GetGameContext()->GetTerrain()->getHydraxManager ()) 
     {
-        App::GetGameContext()->GetTerrain()->getHydraxManager ()->GetHydrax ()->setWaterColor (mWaterGradient.getColor (point));
+        if (sun_moved)
+        {
+            App::GetGameContext()->GetTerrain()->getHydraxManager ()->GetHydrax ()->setWaterColor (mWaterGradient.getColor (point));
+        }
         App::GetGameContext()->GetTerrain()->getHydraxManager ()->GetHydrax ()->setSunPosition (sunPos*0.1);
     }
-		
-
-	mLight0 = App::GetGfxScene()->GetSceneManager()->getLight("Light0");
-	mLight1 = App::GetGfxScene()->GetSceneManager()->getLight("Light1");
 
 	mLight0->setPosition(sunPos*0.02);
-	mLight1->setDirection(lightDir);
     if (App::GetGameContext()->GetTerrain()->getWater())
     {
         App::GetGameContext()->GetTerrain()->getWater()->WaterSetSunPosition(sunPos*0.1);
     }
 
+    if (!sun_moved)
+    {
+        return true;
+    }
+    mLastLightDir = lightDir;
+	mLight1->setDirection(lightDir);
+
 	//setFadeColour was removed with https://github.com/RigsOfRods/rigs-of-rods/pull/1459
 /*	Ogre::Vector3 sunCol = mSunGradient.getColor(point);
 	mLight0->setSpecularColour(sunCol.x, sunCol.y, sunCol.z);
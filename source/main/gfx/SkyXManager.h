@@ -65,6 +65,7 @@ protected:
 	SkyX::CfgFileManager* mCfgFileManager = nullptr;
 
     int mLastHour = 0;
+    Ogre::Vector3 mLastLightDir = Ogre::Vector3::ZERO; //!< Sun direction the gradient colors were last evaluated for
 };
 
 /// @} // addtogroup Gfx
@@ -117,9 +117,7 @@ void SurveyMapTextureCreator::postRenderTargetUpdate(const RenderTargetEvent &ev
     }
 }
 
-Ogre::TexturePtr SurveyMapTextureCreator::convertTextureToStatic(const std::string& texName, const std::string& rgName)
+void SurveyMapTextureCreator::convertToImage(Ogre::Image& img)
 {
-    Ogre::Image img;
     mTexture->convertToImage(img);
-    return Ogre::TextureManager::getSingleton().loadImage(texName, rgName, img);
 }
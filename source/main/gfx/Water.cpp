@@ -34,6 +34,7 @@ using namespace Ogre;
 using namespace RoR;
 
 static const int WAVEREZ = 100;
+static const size_t MAX_SHADER_WAVETRAINS = 8; // Must match 'Example_Fresnel.cg'
 
 Water::Water(Ogre::Vector3 terrn_size) :
     m_map_size(terrn_size),
@@ -46,6 +47,7 @@ Water::Water(Ogre::Vector3 terrn_size) :
     m_water_height(0),
     m_waterplane_node(0),
     m_waterplane_force_update_pos(false),
+    m_waves_on_gpu(false),
     m_frame_counter(0),
     m_refract_rtt_target(0),
     m_reflect_rtt_target(0),
@@ -288,16 +290,29 @@ void Water::PrepareWater()
             m_reflect_cam->enableCustomNearClipPlane(m_reflect_plane);
         }
 
+        // The fresnel materials displace the waves in their vertex program; the mesh never changes
+        m_waves_on_gpu = m_wavetrain_defs.size() <= MAX_SHADER_WAVETRAINS;
+        if (!m_waves_on_gpu)
+        {
+            LOG(fmt::format("[RoR|Water] {} wave trains defined, the water shader supports {} - computing waves on CPU", m_wavetrain_defs.size(), MAX_SHADER_WAVETRAINS));
+        }
+
         m_waterplane_mesh = MeshManager::getSingleton().createPlane("ReflectPlane",
             ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
             m_water_plane,
-            m_map_size.x * m_waterplane_mesh_scale, m_map_size.z * m_waterplane_mesh_scale, WAVEREZ, WAVEREZ, true, 1, 50, 50, Vector3::UNIT_Z, HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
+            m_map_size.x * m_waterplane_mesh_scale, m_map_size.z * m_waterplane_mesh_scale, WAVEREZ, WAVEREZ, true, 1, 50, 50, Vector3::UNIT_Z,
+            (m_waves_on_gpu) ? HardwareBuffer::HBU_STATIC_WRITE_ONLY : HardwareBuffer::HBU_DYNAMIC_WRITE_ONLY_DISCARDABLE);
 
         m_waterplane_entity = App::GetGfxScene()->GetSceneManager()->createEntity("plane", "ReflectPlane");
         if (full_gfx)
             m_waterplane_entity->setMaterialName("Examples/FresnelReflectionRefraction");
         else
             m_waterplane_entity->setMaterialName("Examples/FresnelReflection");
+
+        if (m_waves_on_gpu)
+        {
+            m_waterplane_material = m_waterplane_entity->getSubEntity(0)->getMaterial();
+        }
     }
     else
     {
@@ -336,7 +351,7 @@ void Water::PrepareWater()
     //setup for waves
     m_waterplane_vert_buf = m_waterplane_mesh->sharedVertexData->vertexBufferBinding->getBuffer(0);
 
-    if (m_waterplane_vert_buf->getSizeInBytes() == (WAVEREZ + 1) * (WAVEREZ + 1) * 32)
+    if (!m_waves_on_gpu && m_waterplane_vert_buf->getSizeInBytes() == (WAVEREZ + 1) * (WAVEREZ + 1) * 32)
     {
         m_waterplane_vert_buf_local = (float*)malloc(m_waterplane_vert_buf->getSizeInBytes());
         m_waterplane_vert_buf->readData(0, m_waterplane_vert_buf->getSizeInBytes(), m_waterplane_vert_buf_local);
@@ -370,6 +385,10 @@ void Water::ShowWave(Vector3 refpos)
     if (!m_waterplane_vert_buf_local)
         return;
 
+    // Not sampled from an actor's `WaveField`: those only cover the actor's bounding box, belong to the
+    // physics thread and are rebuilt every step; the plane spans the whole map at one sample per vertex,
+    // so a field of its own would cost exactly the `CalcWavesHeight()` calls it's meant to save.
+
     float xScaled = m_map_size.x * m_waterplane_mesh_scale;
     float zScaled = m_map_size.z * m_waterplane_mesh_scale;
 
@@ -403,6 +422,39 @@ void Water::ShowWave(Vector3 refpos)
     m_waterplane_vert_buf->writeData(0, (WAVEREZ + 1) * (WAVEREZ + 1) * 32, m_waterplane_vert_buf_local, true);
 }
 
+void Water::UpdateWavesShader()
+{
+    Pass* pass = m_waterplane_material->getTechnique(0)->getPass(0);
+    if (!pass->hasVertexProgram())
+        return;
+
+    // Same inputs as `CalcWavesHeight()`; zero amplitude is a flat plane
+    const bool waves = RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::DISABLED;
+    float trains[MAX_SHADER_WAVETRAINS * 4] = {};
+    float dirs[MAX_SHADER_WAVETRAINS * 4] = {};
+    for (size_t i = 0; i < MAX_SHADER_WAVETRAINS; i++)
+    {
+        trains[i * 4 + 0] = 1.f; // wavelength, avoids division by zero
+    }
+    for (size_t i = 0; waves && i < m_wavetrain_defs.size(); i++)
+    {
+        trains[i * 4 + 0] = m_wavetrain_defs[i].wavelength;
+        trains[i * 4 + 1] = m_wavetrain_defs[i].amplitude;
+        trains[i * 4 + 2] = m_wavetrain_defs[i].maxheight;
+        trains[i * 4 + 3] = m_wavetrain_defs[i].wavespeed;
+        dirs[i * 4 + 0] = m_wavetrain_defs[i].dir_sin;
+        dirs[i * 4 + 1] = m_wavetrain_defs[i].dir_cos;
+    }
+
+    const float time_sec = (float)(App::GetAppContext()->GetOgreRoot()->getTimer()->getMilliseconds() * 0.001);
+
+    GpuProgramParametersSharedPtr params = pass->getVertexProgramParameters();
+    params->setNamedConstant("waveTime", time_sec);
+    params->setNamedConstant("waveCenter", Vector4((m_map_size.x * m_waterplane_mesh_scale) * 0.5, 0, (m_map_size.z * m_waterplane_mesh_scale) * 0.5, m_waves_height));
+    params->setNamedConstant("waveTrains", trains, MAX_SHADER_WAVETRAINS);
+    params->setNamedConstant("waveDirs", dirs, MAX_SHADER_WAVETRAINS);
+}
+
 bool Water::IsCameraUnderWater()
 {
     return (App::GetCameraManager()->GetCameraNode()->getPosition().y < CalcWavesHeight(App::GetCameraManager()->GetCameraNode()->getPosition()));
@@ -442,7 +494,9 @@ void Water::UpdateWater()
             m_waterplane_node->setPosition(Vector3(waterPos.x, m_water_height, waterPos.z));
             m_bottomplane_node->setPosition(bottomPos);
         }
-        if (RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::DISABLED)
+        if (m_waves_on_gpu)
+            this->UpdateWavesShader();
+        else if (RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() == RoR::MpState::DISABLED)
             this->ShowWave(m_waterplane_node->getPosition());
     }
 
@@ -548,6 +602,11 @@ float Water::CalcWavesHeight(Vector3 pos)
     return result;
 }
 
+bool Water::AreWavesEnabled()
+{
+    return RoR::App::gfx_water_waves->getBool() && RoR::App::mp_state->getEnum<MpState>() != RoR::MpState::CONNECTED;
+}
+
 bool Water::IsUnderWater(Vector3 pos)
 {
     float waterheight = m_water_height;
@@ -25,6 +25,7 @@
 #include "Application.h"
 
 #include <OgreHardwareVertexBuffer.h> // Ogre::HardwareVertexBufferSharedPtr
+#include <OgreMaterial.h>
 #include <OgreMesh.h>
 #include <OgrePlane.h>
 #include <OgreRenderTargetListener.h>
@@ -50,6 +51,8 @@ public:
     void           SetWaterBottomHeight(float value) override;
     void           SetWavesHeight(float value) override;
     float          CalcWavesHeight(Ogre::Vector3 pos) override;
+    bool           AreWavesEnabled() override;
+    float          GetMaxWavesAmplitude() override { return m_max_ampl; }
     Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 pos) override;
     void           SetWaterVisible(bool value) override;
     bool           IsUnderWater(Ogre::Vector3 pos) override;
@@ -98,6 +101,7 @@ private:
 
     float          GetWaveHeight(Ogre::Vector3 pos);
     void           ShowWave(Ogre::Vector3 refpos);
+    void           UpdateWavesShader(); //!< Feeds the wave trains to the water plane's vertex program, see `m_waves_on_gpu`
     bool           IsCameraUnderWater();
     void           PrepareWater();
 
@@ -116,6 +120,8 @@ private:
     Ogre::HardwareVertexBufferSharedPtr  m_waterplane_vert_buf;
     float*                m_waterplane_vert_buf_local;
     bool                  m_waterplane_force_update_pos;
+    bool                  m_waves_on_gpu;          //!< Waves are displaced by the vertex program; the CPU path (`ShowWave()`) only serves the basic water material
+    Ogre::MaterialPtr     m_waterplane_material;   //!< Only with `m_waves_on_gpu`
     Ogre::Plane           m_reflect_plane;
     Ogre::Plane           m_refract_plane;
     ReflectionListener    m_reflect_listener;
@@ -742,7 +742,7 @@ void CameraManager::UpdateCameraBehaviorStatic()
                (distance > cmradius * 8.0f && angle < Degree(30)) ||
                (distance < cmradius * 2.0f && angle > Degree(150)) ||
                 distance > cmradius * std::max(25.0f, speed * 1.15f) ||
-                intersectsTerrain(m_staticcam_position, lookAt, lookAtPrediction, interval))
+                this->IsStaticCamOccluded(lookAt, lookAtPrediction, interval))
         {
             const auto water = App::GetGameContext()->GetTerrain()->getWater();
             float water_height = (water && !water->IsUnderWater(lookAt)) ? water->GetStaticWaterHeight() : 0.0f;
@@ -782,6 +782,7 @@ void CameraManager::UpdateCameraBehaviorStatic()
                 m_staticcam_update_timer.reset();
                 m_staticcam_position = viable_positions.front().second;
                 m_staticcam_force_update = false;
+                m_staticcam_occlusion_valid = false;
             }
         }
     }
@@ -797,6 +798,26 @@ void CameraManager::UpdateCameraBehaviorStatic()
     App::GetCameraManager()->GetCamera()->setFOVy(Radian(fov));
 }
 
+bool CameraManager::IsStaticCamOccluded(Ogre::Vector3 look_at, Ogre::Vector3 look_at_prediction, float interval)
+{
+    // Once the static camera is over 1 second old, the sweep (dozens of height samples and
+    // a collision ray per step) would run every frame; skip it while the targets moved less
+    // than half the sweep's step.
+    const float tolerance = interval / 12.f;
+    if (!m_staticcam_occlusion_valid ||
+        m_staticcam_occlusion_position != m_staticcam_position ||
+        m_staticcam_occlusion_look_at.squaredDistance(look_at) > tolerance * tolerance ||
+        m_staticcam_occlusion_prediction.squaredDistance(look_at_prediction) > tolerance * tolerance)
+    {
+        m_staticcam_occlusion_result = intersectsTerrain(m_staticcam_position, look_at, look_at_prediction, interval);
+        m_staticcam_occlusion_position = m_staticcam_position;
+        m_staticcam_occlusion_look_at = look_at;
+        m_staticcam_occlusion_prediction = look_at_prediction;
+        m_staticcam_occlusion_valid = true;
+    }
+    return m_staticcam_occlusion_result;
+}
+
 bool CameraManager::CameraBehaviorStaticMouseMoved(const OIS::MouseEvent& _arg)
 {
     const OIS::MouseState ms = _arg.state;
@@ -102,6 +102,7 @@ protected:
     void CameraBehaviorVehicleSplineUpdateSpline();
     void CameraBehaviorVehicleSplineUpdateSplineDisplay();
     void CreateCameraNode();
+    bool IsStaticCamOccluded(Ogre::Vector3 look_at, Ogre::Vector3 look_at_prediction, float interval); //!< Terrain sweep from the static camera, reused while the view barely changes
 
     Ogre::Camera*        m_camera;
     Ogre::SceneNode*     m_camera_node;
@@ -136,6 +137,11 @@ protected:
     Ogre::Vector3        m_staticcam_look_at;
     Ogre::Vector3        m_staticcam_position;
     Ogre::Timer          m_staticcam_update_timer;
+    Ogre::Vector3        m_staticcam_occlusion_position = Ogre::Vector3::ZERO;   //!< Inputs of the last `IsStaticCamOccluded()` sweep
+    Ogre::Vector3        m_staticcam_occlusion_look_at = Ogre::Vector3::ZERO;
+    Ogre::Vector3        m_staticcam_occlusion_prediction = Ogre::Vector3::ZERO;
+    bool                 m_staticcam_occlusion_valid = false;
+    bool                 m_staticcam_occlusion_result = false;
     // Character cam attributes
     bool                 m_charactercam_is_3rdperson;
     // Spline cam attributes
@@ -27,6 +27,11 @@ http://www.gnu.org/copyleft/lesser.txt.
 
 #include <Hydrax.h>
 
+#include "Application.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+
 namespace Hydrax{namespace Noise
 {
 	inline float uniform_deviate()
@@ -37,8 +42,13 @@ namespace Hydrax{namespace Noise
 	FFT::FFT()
 		: Noise("FFT", true)
 		, resolution(128)
+		, resolutionLog2(7)
 		, re(0)
 		, img(0)
+		, backRe(0)
+		, bitReversal(0)
+		, twiddleRe(0)
+		, twiddleImg(0)
 		, maximalValue(2)
 		, initialWaves(0)
 		, currentWaves(0)
@@ -52,8 +62,13 @@ namespace Hydrax{namespace Noise
 		: Noise("FFT", true)
 		, mOptions(Options)
 		, resolution(128)
+		, resolutionLog2(7)
 		, re(0)
 		, img(0)
+		, backRe(0)
+		, bitReversal(0)
+		, twiddleRe(0)
+		, twiddleImg(0)
 		, maximalValue(2)
 		, initialWaves(0)
 		, currentWaves(0)
@@ -84,6 +99,8 @@ namespace Hydrax{namespace Noise
 
 	void FFT::remove()
 	{
+		_waitForNoise();
+
 		if (areGPUNormalMapResourcesCreated())
 		{
 			Noise::removeGPUNormalMapResources(mGPUNormalMapManager);
@@ -106,6 +123,22 @@ namespace Hydrax{namespace Noise
 		{
 			delete [] img;
 		}
+		if (backRe)
+		{
+			delete [] backRe;
+		}
+		if (bitReversal)
+		{
+			delete [] bitReversal;
+		}
+		if (twiddleRe)
+		{
+			delete [] twiddleRe;
+		}
+		if (twiddleImg)
+		{
+			delete [] twiddleImg;
+		}
 		if (initialWaves)
 		{
 			delete [] initialWaves;
@@ -124,6 +157,9 @@ namespace Hydrax{namespace Noise
 
 	void FFT::setOptions(const Options &Options)
 	{
+		// The worker thread reads the options
+		_waitForNoise();
+
 		if (isCreated())
 		{
 			if (mOptions.Resolution != Options.Resolution ||
@@ -422,22 +458,72 @@ namespace Hydrax{namespace Noise
 
 	void FFT::update(const Ogre::Real &timeSinceLastFrame)
 	{
-		_calculeNoise(timeSinceLastFrame);
+		// Pick up the noise calculated during the last frame and start the next one,
+		// so the FFT runs concurrently with the rest of the frame (one frame of latency).
+		_waitForNoise();
 
 		if (areGPUNormalMapResourcesCreated())
 		{
 			_updateGPUNormalMapResources();
 		}
+
+		const float delta = timeSinceLastFrame;
+		mTask = RoR::App::GetThreadPool()->RunTask([this, delta]()
+			{
+				_calculeNoise(delta);
+			}, RoR::TaskPriority::HIGH); // Waited for before the water is updated
+	}
+
+	void FFT::_waitForNoise()
+	{
+		if (mTask)
+		{
+			mTask->join();
+			mTask = nullptr;
+			std::swap(re, backRe);
+		}
 	}
 
 	void FFT::_initNoise()
 	{
+		// The FFT works on powers of 2 only
+		resolutionLog2 = 0;
+		while ((1 << resolutionLog2) < resolution)
+		{
+			resolutionLog2++;
+		}
+		resolution = 1 << resolutionLog2;
+
 		initialWaves = new std::complex<float>[resolution*resolution];
 		currentWaves = new std::complex<float>[resolution*resolution];
 		angularFrequencies = new float[resolution*resolution];
 
 		re  = new float[resolution*resolution];
 		img = new float[resolution*resolution];
+		backRe = new float[resolution*resolution];
+
+		bitReversal = new int[resolution];
+		for (int i = 0; i < resolution; i++)
+		{
+			int r = 0;
+			for (int b = 0; b < resolutionLog2; b++)
+			{
+				r |= ((i >> b) & 1) << (resolutionLog2 - 1 - b);
+			}
+			bitReversal[i] = r;
+		}
+
+		// Inverse transform: w = e^(+i*PI*j/n) for j in [0, n) of the stage with half-size n
+		twiddleRe  = new float[std::max(1, resolution - 1)];
+		twiddleImg = new float[std::max(1, resolution - 1)];
+		for (int n = 1; n < resolution; n *= 2)
+		{
+			for (int j = 0; j < n; j++)
+			{
+				twiddleRe [n - 1 + j] = Ogre::Math::Cos(Ogre::Math::PI * j / n);
+				twiddleImg[n - 1 + j] = Ogre::Math::Sin(Ogre::Math::PI * j / n);
+			}
+		}
 
 		Ogre::Vector2 wave = Ogre::Vector2(0,0);
 
@@ -464,23 +550,23 @@ namespace Hydrax{namespace Noise
 		}
 
 		_calculeNoise(0);
+		std::swap(re, backRe);
 	}
 
 	void FFT::_calculeNoise(const float &delta)
 	{
 		time += delta*mOptions.AnimationSpeed;
 
-		std::complex<float>* pData = currentWaves;
-
-		int u, v;
+		RoR::App::GetThreadPool()->ParallelFor(resolution, [this](size_t row)
+		{
+			const int u = static_cast<int>(row);
+			std::complex<float>* pData = currentWaves + u * resolution;
 
-		float wt,
-			  coswt, sinwt,
-			  realVal, imagVal;
+			float wt,
+				  coswt, sinwt,
+				  realVal, imagVal;
 
-		for (u = 0; u < resolution; u++)
-		{
-			for (v = 0; v< resolution ; v++)
+			for (int v = 0; v< resolution ; v++)
 			{
 				const std::complex<float>& positive_h0 = initialWaves[u * (resolution)+v];
 				const std::complex<float>& negative_h0 = initialWaves[(resolution-1 - u) * (resolution) + (resolution-1- v)];
@@ -497,7 +583,7 @@ namespace Hydrax{namespace Noise
 
 				*pData++ = std::complex<float>(realVal, imagVal);
 			}
-		}
+		});
 
 		_executeInverseFFT();
 		_normalizeFFTData(0);
@@ -546,169 +632,86 @@ namespace Hydrax{namespace Noise
 
 	void FFT::_executeInverseFFT()
 	{
-		int l2n = 0, p = 1;
-		while (p < resolution)
-		{
-			p *= 2; l2n++;
-		}
-		int l2m = 0; p = 1;
-		while (p < resolution)
-		{
-			p *= 2; l2m++;
-		}
-
-		resolution = 1<<l2m;
-		resolution = 1<<l2n;
+		const int N = resolution;
 
-		int x, y, i;
+		// Columns are transformed in blocks of whole rows, see below
+		const int blockSize = std::min(N, 32);
+		const int numBlocks = N / blockSize;
 
-		for(x = 0; x <resolution; x++)
+		// Load the data in bit reversed order of both indices and calculate the FFT of the columns
+		RoR::App::GetThreadPool()->ParallelFor(N, [this, N](size_t x)
 		{
-			for(y = 0; y <resolution; y++)
-			{
-				re[resolution * x + y] = currentWaves[resolution * x + y].real();
-				img[resolution * x + y] = currentWaves[resolution * x + y].imag();
-			}
-		}
+			float* r = backRe + x * N;
+			float* m = img + x * N;
+			const std::complex<float>* src = currentWaves + bitReversal[x] * N;
 
-		//Bit reversal of each row
-		int j, k;
-		for(y = 0; y < resolution; y++) //for each row
-		{
-			j = 0;
-			for(i = 0; i < resolution - 1; i++)
+			for (int y = 0; y < N; y++)
 			{
-				re[resolution * i + y] = currentWaves[resolution * j + y].real();
-				img[resolution * i + y] = currentWaves[resolution * j + y].imag();
-
-				k = resolution / 2;
-				while (k <= j)
-				{
-					j -= k;
-					k/= 2;
-				}
-
-				j += k;
+				r[y] = src[bitReversal[y]].real();
+				m[y] = src[bitReversal[y]].imag();
 			}
-		}
 
-		//Bit reversal of each column
-		float tx = 0, ty = 0;
-		for(x = 0; x < resolution; x++) //for each column
-		{
-			j = 0;
-			for(i = 0; i < resolution - 1; i++)
+			for (int n = 1; n < N; n *= 2)
 			{
-				if(i < j)
-				{
-					tx = re[resolution * x + i];
-					ty = img[resolution * x + i];
-					re[resolution * x + i] = re[resolution * x + j];
-					img[resolution * x + i] = img[resolution * x + j];
-					re[resolution * x + j] = tx;
-					img[resolution * x + j] = ty;
-				}
-				k = resolution / 2;
-				while (k <= j)
+				const float* wr = twiddleRe + n - 1;
+				const float* wi = twiddleImg + n - 1;
+				for (int i = 0; i < N; i += 2*n)
 				{
-					j -= k;
-					k/= 2;
+					float* r0 = r + i; float* r1 = r0 + n;
+					float* m0 = m + i; float* m1 = m0 + n;
+					for (int j = 0; j < n; j++)
+					{
+						const float t1 = wr[j] * r1[j] - wi[j] * m1[j];
+						const float t2 = wr[j] * m1[j] + wi[j] * r1[j];
+						r1[j] = r0[j] - t1;
+						m1[j] = m0[j] - t2;
+						r0[j] += t1;
+						m0[j] += t2;
+					}
 				}
-				j += k;
 			}
-		}
-
-		//Calculate the FFT of the columns
-		float ca, sa,
-			  u1, u2,
-			  t1, t2,
-			  z;
+		});
 
-		int l1, l2,
-			l,  i1;
-
-		for(x = 0; x < resolution; x++) //for each column
+		// Calculate the FFT of the rows; each butterfly combines two whole rows (within a block of columns)
+		RoR::App::GetThreadPool()->ParallelFor(numBlocks, [this, N, blockSize](size_t block)
 		{
-			//This is the 1D FFT:
-			ca = -1.0;
-			sa = 0.0;
-			l1 = 1, l2 = 1;
+			const int y0 = static_cast<int>(block) * blockSize;
 
-			for(l=0;l<l2n;l++)
+			for (int n = 1; n < N; n *= 2)
 			{
-				l1 = l2;
-				l2 *= 2;
-				u1 = 1.0;
-				u2 = 0.0;
-				for(j = 0; j < l1; j++)
+				for (int i = 0; i < N; i += 2*n)
 				{
-					for(i = j; i < resolution; i += l2)
+					for (int j = 0; j < n; j++)
 					{
-						i1 = i + l1;
-						t1 = u1 * re[resolution * x + i1] - u2 * img[resolution * x + i1];
-						t2 = u1 * img[resolution * x + i1] + u2 * re[resolution * x + i1];
-						re[resolution * x + i1] = re[resolution * x + i] - t1;
-						img[resolution * x + i1] = img[resolution * x + i] - t2;
-						re[resolution * x + i] += t1;
-						img[resolution * x + i] += t2;
+						const float wr = twiddleRe[n - 1 + j];
+						const float wi = twiddleImg[n - 1 + j];
+						float* r0 = backRe + (i + j) * N + y0; float* r1 = r0 + n * N;
+						float* m0 = img    + (i + j) * N + y0; float* m1 = m0 + n * N;
+						for (int y = 0; y < blockSize; y++)
+						{
+							const float t1 = wr * r1[y] - wi * m1[y];
+							const float t2 = wr * m1[y] + wi * r1[y];
+							r1[y] = r0[y] - t1;
+							m1[y] = m0[y] - t2;
+							r0[y] += t1;
+							m0[y] += t2;
+						}
 					}
-					z =  u1 * ca - u2 * sa;
-					u2 = u1 * sa + u2 * ca;
-					u1 = z;
 				}
-				sa = Ogre::Math::Sqrt((1.0f - ca) / 2.0f);
-				ca = Ogre::Math::Sqrt((1.0f+ca) / 2.0f);
 			}
-		}
-		//Calculate the FFT of the rows
-		for(y = 0; y < resolution; y++) //for each row
-		{
-			//This is the 1D FFT:
-			ca = -1.0;
-			sa = 0.0;
-			l1= 1, l2 = 1;
 
-			for(l = 0; l < l2m; l++)
+			for (int x = 0; x < N; x++)
 			{
-				l1 = l2;
-				l2 *= 2;
-				u1 = 1.0;
-				u2 = 0.0;
-				for(j = 0; j < l1; j++)
+				float* r = backRe + x * N;
+				for (int y = y0; y < y0 + blockSize; y++)
 				{
-					for(i = j; i < resolution; i += l2)
+					if (((x+y) & 0x1)==0)
 					{
-						i1 = i + l1;
-					    t1 = u1 * re[resolution * i1 + y] - u2 * img[resolution * i1 + y];
-						t2 = u1 * img[resolution * i1 + y] + u2 * re[resolution* i1 + y];
-						re[resolution * i1 + y] = re[resolution * i + y] - t1;
-						img[resolution * i1 + y] = img[resolution * i + y] - t2;
-						re[resolution * i + y] += t1;
-						img[resolution * i + y] += t2;
+						r[y] = -r[y];
 					}
-					z =  u1 * ca - u2 * sa;
-					u2 = u1 * sa + u2 * ca;
-					u1 = z;
-				}
-				sa = Ogre::Math::Sqrt((1.0f - ca) / 2.0f);
-				ca = Ogre::Math::Sqrt((1.0f+ca) / 2.0f);
-			}
-		}
-
-		for(x=0;x<resolution;x++)
-		{
-			for(y=0;y<resolution;y++)
-			{
-				if (((x+y) & 0x1)==1)
-				{
-					re[x*resolution+y]*=1;
-				}
-				else
-				{
-					re[x*resolution+y]*=-1;
 				}
 			}
-		}
+		});
 	}
 
 	void FFT::_normalizeFFTData(const float& scale)
@@ -719,13 +722,13 @@ namespace Hydrax{namespace Noise
 		// Perform automatic detection of maximum value
 		if (scale == 0.0f)
 		{
-			float min=re[0], max=re[0],
+			float min=backRe[0], max=backRe[0],
 				  currentMax=maximalValue;;
 
 			for(i=1;i<resolution*resolution;i++)
 			{
-				if (min>re[i]) min=re[i];
-				if (max<re[i]) max=re[i];
+				if (min>backRe[i]) min=backRe[i];
+				if (max<backRe[i]) max=backRe[i];
 			}
 
 			min=Ogre::Math::Abs(min);
@@ -749,7 +752,7 @@ namespace Hydrax{namespace Noise
 			for(y=0;y<resolution;y++)
 			{
 				i=x*resolution+y;
-				re[i]=(re[i]+scaleCoef)/(scaleCoef*2);
+				backRe[i]=(backRe[i]+scaleCoef)/(scaleCoef*2);
 			}
 		}
 	}
@@ -30,6 +30,9 @@ http://www.gnu.org/copyleft/lesser.txt.
 #include "Noise.h"
 
 #include <complex>
+#include <memory>
+
+namespace RoR { class Task; }
 
 /// @addtogroup Gfx
 /// @{
@@ -225,7 +228,13 @@ namespace Hydrax{ namespace Noise
 		 */
 		void _calculeNoise(const float &delta);
 
+		/** Wait for the noise being calculated on a worker thread, then make it current
+		 */
+		void _waitForNoise();
+
 		/** Execute inverse fast fourier transform
+		    Radix-2, separable: the contiguous pass runs per row, the strided pass
+			processes whole rows at once so that both inner loops vectorize.
 		 */
 		void _executeInverseFFT();
 
@@ -253,8 +262,18 @@ namespace Hydrax{ namespace Noise
 
 		/// FFT resolution
 		int resolution;
+		/// log2(resolution)
+		int resolutionLog2;
 		/// Pointers to resolution*resolution float size arrays
     	float *re, *img;
+		/// Noise being calculated on a worker thread while `re` is read; swapped with `re` when finished
+		float *backRe;
+		/// Bit reversed indices, resolution size array
+		int *bitReversal;
+		/// Butterfly weights of all FFT stages, the stage with half-size n starts at index n-1; resolution-1 size arrays
+		float *twiddleRe, *twiddleImg;
+		/// Pending noise calculation, see _waitForNoise()
+		std::shared_ptr<RoR::Task> mTask;
 	    /// The minimal value of the result data of the fft transformation
     	float maximalValue;
 
@@ -295,6 +295,7 @@ namespace Hydrax
             mModule->update(timeSinceLastFrame);
 		    mDecalsManager->update();
 			_checkUnderwater(timeSinceLastFrame);
+			mRttManager->update();
 		}
     }
 
@@ -644,6 +645,9 @@ namespace Hydrax
 
 			if (mMesh->getMaterialName() != mMaterialManager->getMaterial(MaterialManager::MAT_UNDERWATER)->getName())
 			{
+				// Skies and planes flip, don't show the old Rtt contents
+				mRttManager->invalidate();
+
 				mRttManager->getTexture(RttManager::RTT_REFRACTION)->
 					getBuffer()->getRenderTarget()->getViewport(0)->
 					     setSkiesEnabled(true);
@@ -688,6 +692,8 @@ namespace Hydrax
 
 			if (mMesh->getMaterialName() != mMaterialManager->getMaterial(MaterialManager::MAT_WATER)->getName())
 			{
+				mRttManager->invalidate();
+
 				// We asume that RefractionRtt/ReflectionRtt are initialized
 				mRttManager->getTexture(RttManager::RTT_REFRACTION)->
 					getBuffer()->getRenderTarget()->getViewport(0)->
@@ -33,6 +33,8 @@ Contributors:
 
 #include <Hydrax.h>
 
+#include "ShaderCache.h"
+
 #define _def_Water_Material_Name  "_Hydrax_Water_Material"
 #define _def_Water_Shader_VP_Name "_Hydrax_Water_VP"
 #define _def_Water_Shader_FP_Name "_Hydrax_Water_FP"
@@ -341,7 +343,10 @@ namespace Hydrax
 	    HLGpuProgram->setSource(Data);
         HLGpuProgram->setParameter("entry_point", EntryPoint);
         HLGpuProgram->setParameter(Profiles[0], Profiles[1]);
-		HLGpuProgram->load();
+		{
+			RoR::ShaderCacheBypass bypass; // Generated source, the name doesn't change with the options
+			HLGpuProgram->load();
+		}
 
 		return true;
 	}
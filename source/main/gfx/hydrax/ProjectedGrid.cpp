@@ -30,6 +30,11 @@ http://www.cnblogs.com/ArenAK/archive/2007/11/07/951713.html
 
 #include <ProjectedGrid.h>
 
+#include "Application.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+
 #define _def_MaxFarClipDistance 99999
 
 namespace Hydrax{namespace Module
@@ -61,6 +66,7 @@ namespace Hydrax{namespace Module
 		, mHydrax(h)
 		, mVertices(0)
 		, mVerticesChoppyBuffer(0)
+		, mHeights(0)
 		, mBasePlane(BasePlane)
 		, mNormal(BasePlane.normal)
 		, mPos(Ogre::Vector3(0,0,0))
@@ -76,6 +82,7 @@ namespace Hydrax{namespace Module
 		, mHydrax(h)
 		, mVertices(0)
 		, mVerticesChoppyBuffer(0)
+		, mHeights(0)
 		, mBasePlane(BasePlane)
 		, mNormal(BasePlane.normal)
 		, mPos(Ogre::Vector3(0,0,0))
@@ -160,6 +167,8 @@ namespace Hydrax{namespace Module
 			mVertices = new Mesh::POS_VERTEX[mOptions.Complexity*mOptions.Complexity];
 		}
 
+		mHeights = new float[mOptions.Complexity*mOptions.Complexity];
+
 	    _setDisplacementAmplitude(0.0f);
 
 		mTmpRndrngCamera  = new Ogre::Camera("PG_TmpRndrngCamera", NULL);
@@ -196,6 +205,12 @@ namespace Hydrax{namespace Module
 			delete [] mVerticesChoppyBuffer;
 		}
 
+		if (mHeights)
+		{
+			delete [] mHeights;
+			mHeights = 0;
+		}
+
 		if (mTmpRndrngCamera)
 		{
 			delete mTmpRndrngCamera;
@@ -293,71 +308,20 @@ namespace Hydrax{namespace Module
 
 				if (mOptions.ChoppyWaves)
 				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-			            Vertices[i] = mVerticesChoppyBuffer[i];
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
+					_calculeHeights(Vertices, mVerticesChoppyBuffer, RenderingCameraPos);
 				}
 				else
 				{
-					for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		            {
-						Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		            }
+					_calculeHeights(Vertices, Vertices, RenderingCameraPos);
 				}
 			}
 			else if (getNormalMode() == MaterialManager::NM_RTT)
 			{
 				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-				for(int i = 0; i < mOptions.Complexity*mOptions.Complexity; i++)
-		        {
-				    Vertices[i].y = -mBasePlane.d + mNoise->getValue(RenderingCameraPos.x + Vertices[i].x, RenderingCameraPos.z + Vertices[i].z)*mOptions.Strength;
-		        }
+				_calculeHeights(Vertices, Vertices, RenderingCameraPos);
 			}
 
-			// Smooth the heightdata
-		    if (mOptions.Smooth)
-		    {
-				if (getNormalMode() == MaterialManager::NM_VERTEX)
-				{
-					Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
-
-					for(int v=1; v<(mOptions.Complexity-1); v++)
-					{
-						for(int u=1; u<(mOptions.Complexity-1); u++)
-						{
-							Vertices[v*mOptions.Complexity + u].y =
-								 0.2f *
-								(Vertices[v    *mOptions.Complexity + u    ].y +
-								 Vertices[v    *mOptions.Complexity + (u+1)].y +
-								 Vertices[v    *mOptions.Complexity + (u-1)].y +
-								 Vertices[(v+1)*mOptions.Complexity + u    ].y +
-								 Vertices[(v-1)*mOptions.Complexity + u    ].y);
-						}
-					}
-				}
-				else if(getNormalMode() == MaterialManager::NM_RTT)
-				{
-					Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
-
-					for(int v=1; v<(mOptions.Complexity-1); v++)
-					{
-						for(int u=1; u<(mOptions.Complexity-1); u++)
-						{
-							Vertices[v*mOptions.Complexity + u].y =
-								 0.2f *
-								(Vertices[v    *mOptions.Complexity + u    ].y +
-								 Vertices[v    *mOptions.Complexity + (u+1)].y +
-								 Vertices[v    *mOptions.Complexity + (u-1)].y +
-								 Vertices[(v+1)*mOptions.Complexity + u    ].y +
-								 Vertices[(v-1)*mOptions.Complexity + u    ].y);
-						}
-					}
-				}
-		    }
-
 			_calculeNormals();
 
 			_performChoppyWaves();
@@ -369,53 +333,104 @@ namespace Hydrax{namespace Module
 		mLastOrientation = mRenderingCamera->getDerivedOrientation();
 	}
 
-	bool ProjectedGrid::_renderGeometry(const Ogre::Matrix4& m,const Ogre::Matrix4& _viewMat, const Ogre::Vector3& WorldPos)
+	template <typename VertexType>
+	void ProjectedGrid::_projectVertices(VertexType* Vertices)
 	{
-		t_corners0 = _calculeWorldPosition(Ogre::Vector2( 0.0f, 0.0f),m,_viewMat);
-		t_corners1 = _calculeWorldPosition(Ogre::Vector2(+1.0f, 0.0f),m,_viewMat);
-		t_corners2 = _calculeWorldPosition(Ogre::Vector2( 0.0f,+1.0f),m,_viewMat);
-		t_corners3 = _calculeWorldPosition(Ogre::Vector2(+1.0f,+1.0f),m,_viewMat);
+		const int Complexity = mOptions.Complexity;
+		const float du = 1.0f/(Complexity-1),
+			        dv = 1.0f/(Complexity-1);
 
-		float du  = 1.0f/(mOptions.Complexity-1),
-			  dv  = 1.0f/(mOptions.Complexity-1),
-			  u,v = 0.0f,
-			  // _1_u = (1.0f-u)
-			  _1_u, _1_v = 1.0f,
-			  divide;
+		RoR::App::GetThreadPool()->ParallelFor(Complexity, [this, Vertices, Complexity, du, dv](size_t iv)
+		{
+			const float v = iv*dv,
+				        _1_v = 1.0f-v;
 
-		Ogre::Vector4 result;
+			Ogre::Vector4 result;
+			VertexType* Row = Vertices + iv*Complexity;
 
-		int i = 0, iv, iu;
+			for(int iu=0; iu<Complexity; iu++)
+			{
+				const float u = iu*du,
+					        // _1_u = (1.0f-u)
+					        _1_u = 1.0f-u;
 
-		if (getNormalMode() == MaterialManager::NM_VERTEX)
+				result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
+				result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
+				result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
+
+				const float divide = 1.0f/result.w;
+				Row[iu].x = result.x*divide;
+				Row[iu].z = result.z*divide;
+			}
+		});
+	}
+
+	template <typename VertexType, typename PositionType>
+	void ProjectedGrid::_calculeHeights(VertexType* Vertices, const PositionType* Positions, const Ogre::Vector3& WorldPos)
+	{
+		const int Complexity = mOptions.Complexity;
+		const bool Smooth = mOptions.Smooth && Complexity > 2;
+
+		RoR::App::GetThreadPool()->ParallelFor(Complexity, [this, Vertices, Positions, &WorldPos, Complexity, Smooth](size_t iv)
 		{
-			Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
+			const int v = static_cast<int>(iv);
+			for(int i = v*Complexity; i < (v+1)*Complexity; i++)
+			{
+				Vertices[i].x = Positions[i].x;
+				Vertices[i].z = Positions[i].z;
 
-			for(iv=0; iv<mOptions.Complexity; iv++)
+				const float Heigth = -mBasePlane.d + mNoise->getValue(WorldPos.x + Vertices[i].x, WorldPos.z + Vertices[i].z)*mOptions.Strength;
+				if (Smooth)
+				{
+					mHeights[i] = Heigth;
+				}
+				else
+				{
+					Vertices[i].y = Heigth;
+				}
+			}
+		});
+
+		// Smooth the heightdata; reads the unsmoothed heights only, so the rows don't depend on each other
+		if (Smooth)
+		{
+			RoR::App::GetThreadPool()->ParallelFor(Complexity, [this, Vertices, Complexity](size_t iv)
 			{
-				u = 0.0f;
-				_1_u = 1.0f;
-				for(iu=0; iu<mOptions.Complexity; iu++)
+				const int v = static_cast<int>(iv);
+				for(int u = 0; u < Complexity; u++)
 				{
-					result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
-					result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
-					result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
+					const int i = v*Complexity + u;
+					if (v == 0 || v == Complexity-1 || u == 0 || u == Complexity-1)
+					{
+						Vertices[i].y = mHeights[i];
+					}
+					else
+					{
+						Vertices[i].y =
+							 0.2f *
+							(mHeights[i] +
+							 mHeights[i+1] +
+							 mHeights[i-1] +
+							 mHeights[i+Complexity] +
+							 mHeights[i-Complexity]);
+					}
+				}
+			});
+		}
+	}
 
-					divide = 1.0f/result.w;
-					result.x *= divide;
-					result.z *= divide;
+	bool ProjectedGrid::_renderGeometry(const Ogre::Matrix4& m,const Ogre::Matrix4& _viewMat, const Ogre::Vector3& WorldPos)
+	{
+		t_corners0 = _calculeWorldPosition(Ogre::Vector2( 0.0f, 0.0f),m,_viewMat);
+		t_corners1 = _calculeWorldPosition(Ogre::Vector2(+1.0f, 0.0f),m,_viewMat);
+		t_corners2 = _calculeWorldPosition(Ogre::Vector2( 0.0f,+1.0f),m,_viewMat);
+		t_corners3 = _calculeWorldPosition(Ogre::Vector2(+1.0f,+1.0f),m,_viewMat);
 
-					Vertices[i].x = result.x;
-					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
+		if (getNormalMode() == MaterialManager::NM_VERTEX)
+		{
+			Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-					i++;
-					u += du;
-					_1_u = 1.0f-u;
-				}
-				v += dv;
-				_1_v = 1.0f-v;
-			}
+			_projectVertices(Vertices);
 
 			if (mOptions.ChoppyWaves)
 			{
@@ -424,77 +439,16 @@ namespace Hydrax{namespace Module
 			        mVerticesChoppyBuffer[i] = Vertices[i];
 		        }
 			}
+
+			_calculeHeights(Vertices, Vertices, WorldPos);
 		}
 		else if(getNormalMode() == MaterialManager::NM_RTT)
 		{
 			Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
 
-			for(iv=0; iv<mOptions.Complexity; iv++)
-			{
-				u = 0.0f;
-				_1_u = 1.0f;
-				for(iu=0; iu<mOptions.Complexity; iu++)
-				{
-					result.x = _1_v*(_1_u*t_corners0.x + u*t_corners1.x) + v*(_1_u*t_corners2.x + u*t_corners3.x);
-					result.z = _1_v*(_1_u*t_corners0.z + u*t_corners1.z) + v*(_1_u*t_corners2.z + u*t_corners3.z);
-					result.w = _1_v*(_1_u*t_corners0.w + u*t_corners1.w) + v*(_1_u*t_corners2.w + u*t_corners3.w);
+			_projectVertices(Vertices);
 
-					divide = 1.0f/result.w;
-					result.x *= divide;
-					result.z *= divide;
-
-					Vertices[i].x = result.x;
-					Vertices[i].z = result.z;
-					Vertices[i].y = -mBasePlane.d + mNoise->getValue(WorldPos.x + result.x, WorldPos.z + result.z)*mOptions.Strength;
-
-					i++;
-					u += du;
-					_1_u = 1.0f-u;
-				}
-				v += dv;
-				_1_v = 1.0f-v;
-			}
-		}
-
-		// Smooth the heightdata
-		if (mOptions.Smooth)
-		{
-			if (getNormalMode() == MaterialManager::NM_VERTEX)
-			{
-				Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
-
-				for(iv=1; iv<(mOptions.Complexity-1); iv++)
-				{
-					for(iu=1; iu<(mOptions.Complexity-1); iu++)
-					{
-						Vertices[iv*mOptions.Complexity + iu].y =
-							 0.2f *
-							(Vertices[iv    *mOptions.Complexity + iu    ].y +
-							 Vertices[iv    *mOptions.Complexity + (iu+1)].y +
-							 Vertices[iv    *mOptions.Complexity + (iu-1)].y +
-							 Vertices[(iv+1)*mOptions.Complexity + iu    ].y +
-							 Vertices[(iv-1)*mOptions.Complexity + iu    ].y);
-					}
-				}
-			}
-			else if(getNormalMode() == MaterialManager::NM_RTT)
-			{
-				Mesh::POS_VERTEX* Vertices = static_cast<Mesh::POS_VERTEX*>(mVertices);
-
-				for(iv=1; iv<(mOptions.Complexity-1); iv++)
-				{
-					for(iu=1; iu<(mOptions.Complexity-1); iu++)
-					{
-						Vertices[iv*mOptions.Complexity + iu].y =
-							 0.2f *
-							(Vertices[iv    *mOptions.Complexity + iu    ].y +
-							 Vertices[iv    *mOptions.Complexity + (iu+1)].y +
-							 Vertices[iv    *mOptions.Complexity + (iu-1)].y +
-							 Vertices[(iv+1)*mOptions.Complexity + iu    ].y +
-							 Vertices[(iv-1)*mOptions.Complexity + iu    ].y);
-					}
-				}
-			}
+			_calculeHeights(Vertices, Vertices, WorldPos);
 		}
 
 		_calculeNormals();
@@ -511,14 +465,14 @@ namespace Hydrax{namespace Module
 			return;
 		}
 
-		int v, u;
-		Ogre::Vector3 vec1, vec2, normal;
-
 		Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-		for(v=1; v<(mOptions.Complexity-1); v++)
+		RoR::App::GetThreadPool()->ParallelFor(std::max(0, mOptions.Complexity-2), [this, Vertices](size_t row)
 		{
-			for(u=1; u<(mOptions.Complexity-1); u++)
+			const int v = static_cast<int>(row) + 1;
+			Ogre::Vector3 vec1, vec2, normal;
+
+			for(int u=1; u<(mOptions.Complexity-1); u++)
 			{
 				vec1 = Ogre::Vector3(
 					Vertices[v*mOptions.Complexity + u + 1].x-Vertices[v*mOptions.Complexity + u - 1].x,
@@ -536,7 +490,7 @@ namespace Hydrax{namespace Module
 				Vertices[v*mOptions.Complexity + u].ny = normal.y;
 				Vertices[v*mOptions.Complexity + u].nz = normal.z;
 			}
-		}
+		});
 	}
 
 	void ProjectedGrid::_performChoppyWaves()
@@ -546,19 +500,15 @@ namespace Hydrax{namespace Module
 			return;
 		}
 
-		int v, u,
-		    Underwater = 1;
+		int Underwater = 1;
 
 		if (mHydrax->_isCurrentFrameUnderwater())
 		{
 			Underwater = -1;
 		}
 
-		float Dis1,  Dis2;//,
-		   // Dis1_, Dis2_;
-
-		Ogre::Vector3 CameraDir, Norm;
-		Ogre::Vector2 Dir, Perp, Norm2;
+		Ogre::Vector3 CameraDir;
+		Ogre::Vector2 Dir, Perp;
 
 		CameraDir = mRenderingCamera->getDerivedDirection();
 		Dir       = Ogre::Vector2(CameraDir.x, CameraDir.z).normalisedCopy();
@@ -572,8 +522,16 @@ namespace Hydrax{namespace Module
 
 		Mesh::POS_NORM_VERTEX* Vertices = static_cast<Mesh::POS_NORM_VERTEX*>(mVertices);
 
-		for(v=1; v<(mOptions.Complexity-1); v++)
+		RoR::App::GetThreadPool()->ParallelFor(std::max(0, mOptions.Complexity-2), [this, Vertices, Underwater, Dir, Perp](size_t row)
 		{
+			const int v = static_cast<int>(row) + 1;
+
+			float Dis1,  Dis2;//,
+			   // Dis1_, Dis2_;
+
+			Ogre::Vector3 Norm;
+			Ogre::Vector2 Norm2;
+
 			Dis1 =  (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + 1].x,
 					               mVerticesChoppyBuffer[v*mOptions.Complexity + 1].z) -
 					 Ogre::Vector2(mVerticesChoppyBuffer[(v+1)*mOptions.Complexity + 1].x,
@@ -586,7 +544,7 @@ namespace Hydrax{namespace Module
 
 			Dis1 = (Dis1+Dis1_)/2;*/
 
-			for(u=1; u<(mOptions.Complexity-1); u++)
+			for(int u=1; u<(mOptions.Complexity-1); u++)
 			{
 				Dis2 = (Ogre::Vector2(mVerticesChoppyBuffer[v*mOptions.Complexity + u].x,
 					                  mVerticesChoppyBuffer[v*mOptions.Complexity + u].z) -
@@ -613,7 +571,7 @@ namespace Hydrax{namespace Module
 				Vertices[v*mOptions.Complexity + u].x = mVerticesChoppyBuffer[v*mOptions.Complexity + u].x + Norm2.x * Underwater;
 				Vertices[v*mOptions.Complexity + u].z = mVerticesChoppyBuffer[v*mOptions.Complexity + u].z + Norm2.y * Underwater;
 			}
-		}
+		});
 	}
 
 	// Check the point of intersection with the plane (0,1,0,0) and return the position in homogenous coordinates
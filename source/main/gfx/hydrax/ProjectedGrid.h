@@ -207,6 +207,20 @@ namespace Hydrax{ namespace Module
 		}
 
 	private:
+		/** Project the grid vertices onto the base plane (x/z only)
+		    @param Vertices Mesh::POS_NORM_VERTEX or Mesh::POS_VERTEX array
+		 */
+		template <typename VertexType>
+		void _projectVertices(VertexType* Vertices);
+
+		/** Calcule the vertex heights; smoothed if enabled
+		    @param Vertices Mesh::POS_NORM_VERTEX or Mesh::POS_VERTEX array
+			@param Positions Where to take the x/z positions from (Vertices or mVerticesChoppyBuffer)
+			@param WorldPos Origin world position
+		 */
+		template <typename VertexType, typename PositionType>
+		void _calculeHeights(VertexType* Vertices, const PositionType* Positions, const Ogre::Vector3& WorldPos);
+
 		/** Calcule current normals
 		 */
 		void _calculeNormals();
@@ -248,6 +262,9 @@ namespace Hydrax{ namespace Module
 		/// Use it to store vertex positions when choppy displacement is enabled
 		Mesh::POS_NORM_VERTEX* mVerticesChoppyBuffer;
 
+		/// Unsmoothed vertex heights, persistent staging for the smoothing pass
+		float* mHeights;
+
 		/// For corners
 		Ogre::Vector4 t_corners0,t_corners1,t_corners2,t_corners3;
 
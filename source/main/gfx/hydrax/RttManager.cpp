@@ -41,6 +41,13 @@ namespace Hydrax
 		: mHydrax(h)
 		, mPlanesSceneNode(0)
 		, mReflectionDisplacementError(0.5f)
+		, mFrameNumber(0)
+		, mForceUpdate(true)
+		, mStillCameraReflectionInterval(0)
+		, mReflectionCameraPosition(Ogre::Vector3::ZERO)
+		, mReflectionCameraOrientation(Ogre::Quaternion::IDENTITY)
+		, mReflectionCameraFOVy(0)
+		, mResolutionScale(1)
 	{
 		Ogre::String RttNames[6] = 
 		    {_def_Hydrax_Reflection_Rtt_Name,
@@ -58,6 +65,7 @@ namespace Hydrax
 			mRttOptions[k].Size_ = Size(0);
 			mRttOptions[k].NumberOfChannels_ = NOC_3;
 			mRttOptions[k].BitsPerChannel_ = BPC_8;
+			mRttOptions[k].UpdateInterval = 1;
 		}
 
 		mReflectionListener.mRttManager = this;
@@ -194,6 +202,12 @@ namespace Hydrax
 			TSize.Height = mHydrax->getViewport()->getActualHeight();
 		}
 
+		if (Rtt != RTT_GPU_NORMAL_MAP && mResolutionScale < 1)
+		{
+			TSize.Width  = std::max(1, static_cast<int>(TSize.Width  * mResolutionScale));
+			TSize.Height = std::max(1, static_cast<int>(TSize.Height * mResolutionScale));
+		}
+
 		mTextures[Rtt] = Ogre::TextureManager::getSingleton()
 			.createManual(mRttOptions[Rtt].Name,
                           Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
@@ -218,6 +232,9 @@ namespace Hydrax
         RT_Texture_Viewport->setSkiesEnabled(RenderSky);
 
         RT_Texture->addListener(RTListener);
+
+		// The new texture has no content yet
+		mForceUpdate = true;
 	}
 
 	void RttManager::setTextureSize(const RttType& Rtt, const Size& S)
@@ -274,6 +291,91 @@ namespace Hydrax
 		}
 	}
 
+	void RttManager::setResolutionScale(const Ogre::Real& Scale)
+	{
+		const Ogre::Real NewScale = Ogre::Math::Clamp<Ogre::Real>(Scale, 0.1f, 1.0f);
+
+		if (NewScale == mResolutionScale)
+		{
+			return;
+		}
+
+		mResolutionScale = NewScale;
+
+		bool ReloadMaterialsNeeded = false;
+
+		// Reflection, refraction, depth and depth reflection; the GPU normal map keeps its size
+		for(int k = 0; k < 4; k++)
+		{
+			if (!getTexture(static_cast<RttType>(k)).isNull())
+			{
+				initialize(static_cast<RttType>(k));
+
+				ReloadMaterialsNeeded = true;
+			}
+		}
+
+		if (ReloadMaterialsNeeded)
+		{
+			mHydrax->getMaterialManager()->reload(MaterialManager::MAT_WATER);
+
+			if (mHydrax->isComponent(HYDRAX_COMPONENT_UNDERWATER))
+			{
+				mHydrax->getMaterialManager()->reload(MaterialManager::MAT_UNDERWATER);
+
+				if (mHydrax->_isCurrentFrameUnderwater())
+				{
+					mHydrax->getMaterialManager()->reload(MaterialManager::MAT_UNDERWATER_COMPOSITOR);
+				}
+			}
+		}
+	}
+
+	void RttManager::update()
+	{
+		mFrameNumber++;
+
+		Ogre::Camera *Cam = mHydrax->getCamera();
+
+		const bool CameraStill =
+			Cam->getDerivedPosition().positionEquals(mReflectionCameraPosition, 0.001f) &&
+			Cam->getDerivedOrientation().equals(mReflectionCameraOrientation, Ogre::Radian(0.0001f)) &&
+			Cam->getFOVy() == mReflectionCameraFOVy;
+
+		for (int k = 0; k < 6; k++)
+		{
+			if (mTextures[k].isNull())
+			{
+				continue;
+			}
+
+			const bool ReflectionSide = (k == RTT_REFLECTION || k == RTT_DEPTH_REFLECTION);
+
+			int Interval = mRttOptions[k].UpdateInterval;
+
+			if (ReflectionSide && CameraStill && mStillCameraReflectionInterval > 0)
+			{
+				Interval = std::max(Interval, mStillCameraReflectionInterval);
+			}
+
+			// Reflection side renders on even frames, refraction side on odd ones
+			const unsigned int Phase = ReflectionSide ? 0 : 1;
+
+			const bool Due = mForceUpdate || Interval <= 1 || ((mFrameNumber + Phase) % Interval) == 0;
+
+			mTextures[k]->getBuffer()->getRenderTarget()->setActive(Due);
+
+			if (Due && k == RTT_REFLECTION)
+			{
+				mReflectionCameraPosition = Cam->getDerivedPosition();
+				mReflectionCameraOrientation = Cam->getDerivedOrientation();
+				mReflectionCameraFOVy = Cam->getFOVy();
+			}
+		}
+
+		mForceUpdate = false;
+	}
+
 	const Ogre::PixelFormat RttManager::getPixelFormat(const RttType& Rtt) const
 	{ 
 		switch (mRttOptions[Rtt].NumberOfChannels_)
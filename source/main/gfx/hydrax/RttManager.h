@@ -88,6 +88,8 @@ namespace Hydrax
 			NumberOfChannels NumberOfChannels_;
 			/// Bits per channel
 			BitsPerChannel BitsPerChannel_;
+			/// Render every Nth frame; 1 = every frame
+			int UpdateInterval;
 		};
 
 		/** Rtt Listener class
@@ -211,6 +213,59 @@ namespace Hydrax
 			return mRttOptions[Rtt];
 		}
 
+		/** Set Rtt update interval
+		    @param Interval Render the Rtt every Nth frame, 1 = every frame
+			@remarks Reflection and refraction sides are staggered, so with equal intervals
+			         they don't render in the same frame. The texture lags behind the camera
+					 in between, use it for mid-range hardware only.
+		 */
+		inline void setUpdateInterval(const RttType& Rtt, const int& Interval)
+		{
+			mRttOptions[Rtt].UpdateInterval = std::max(1, Interval);
+		}
+
+		inline const int& getUpdateInterval(const RttType& Rtt) const
+		{
+			return mRttOptions[Rtt].UpdateInterval;
+		}
+
+		/** Reuse the reflection while the camera stands still
+		    @param Interval Refresh the reflection every Nth frame while the camera doesn't move, 0 = disabled
+			@remarks A still camera sees the same mirrored scene, only moving objects get refreshed less often.
+		 */
+		inline void setStillCameraReflectionInterval(const int& Interval)
+		{
+			mStillCameraReflectionInterval = std::max(0, Interval);
+		}
+
+		inline const int& getStillCameraReflectionInterval() const
+		{
+			return mStillCameraReflectionInterval;
+		}
+
+		/** Set resolution scale of reflection, refraction and depth Rtts
+		    @param Scale Range [0.1, 1], applied on top of the configured texture sizes
+			@remarks Existing Rtts are recreated, don't change it every frame.
+		 */
+		void setResolutionScale(const Ogre::Real& Scale);
+
+		inline const Ogre::Real& getResolutionScale() const
+		{
+			return mResolutionScale;
+		}
+
+		/** Decide which Rtts render in the current frame
+		    @remarks Call once per frame, before rendering.
+		 */
+		void update();
+
+		/** Render all Rtts in the next frame, regardless of update intervals
+		 */
+		inline void invalidate()
+		{
+			mForceUpdate = true;
+		}
+
 		/** Range [0.05, ~2], increase if you experience reflection issues when the camera is near to the water.
 	     */
 		void setReflectionDisplacementError(const Ogre::Real& ReflectionDisplacementError)
@@ -386,6 +441,19 @@ namespace Hydrax
 
 		/// Reflection displacement error, range [0.01, ~2]
 		Ogre::Real mReflectionDisplacementError;
+
+		/// Frame counter for update intervals
+		unsigned int mFrameNumber;
+		/// Render all Rtts in the next frame
+		bool mForceUpdate;
+		/// Reflection refresh interval while the camera is still, 0 = disabled
+		int mStillCameraReflectionInterval;
+		/// Camera state at the last reflection render
+		Ogre::Vector3 mReflectionCameraPosition;
+		Ogre::Quaternion mReflectionCameraOrientation;
+		Ogre::Radian mReflectionCameraFOVy;
+		/// Scale of reflection, refraction and depth Rtt sizes
+		Ogre::Real mResolutionScale;
 	};
 };
 
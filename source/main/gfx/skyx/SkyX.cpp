@@ -42,6 +42,7 @@ namespace SkyX
 		, mCreated(false)
 		, mLastCameraPosition(Ogre::Vector3(0,0,0))
 		, mLastCameraFarClipDistance(-1)
+		, mLastSunDirection(Ogre::Vector3::ZERO)
 		, mInfiniteCameraFarClipDistance(100000)
 		, mVisible(true)
 		, mLightingMode(LM_LDR)
@@ -143,8 +144,13 @@ namespace SkyX
 			}
 		}
 
-		mGPUManager->setGpuProgramParameter(GPUManager::GPUP_VERTEX, "uLightDir", mController->getSunDirection());
-		mGPUManager->setGpuProgramParameter(GPUManager::GPUP_FRAGMENT, "uLightDir", mController->getSunDirection());
+		// Also walks the ground passes - only do it when the sun actually moved
+		if (mController->getSunDirection() != mLastSunDirection)
+		{
+			mLastSunDirection = mController->getSunDirection();
+			mGPUManager->setGpuProgramParameter(GPUManager::GPUP_VERTEX, "uLightDir", mLastSunDirection);
+			mGPUManager->setGpuProgramParameter(GPUManager::GPUP_FRAGMENT, "uLightDir", mLastSunDirection);
+		}
 
 		mMoonManager->updateMoonPhase(mController->getMoonPhase());
 		mCloudsManager->update();
@@ -386,6 +386,8 @@ namespace SkyX
 		Ogre::Vector3 mLastCameraPosition;
 		/// Last camera far clip distance
 		Ogre::Real mLastCameraFarClipDistance;
+		/// Sun direction last sent to the skydome programs
+		Ogre::Vector3 mLastSunDirection;
 		/// Infinite camera far clip distance
 		Ogre::Real mInfiniteCameraFarClipDistance;
 
@@ -270,7 +270,11 @@ void DashBoard::updateFeatures()
 
 void DashBoard::update(float dt)
 {
-    // walk all controls and animate them
+    // Hidden widgets needn't follow; the controls remember what they show, so they catch up when shown
+    if (!visible)
+        return;
+
+    // walk all controls and animate them; only touch MyGUI when the displayed value changes
     for (int i = 0; i < free_controls; i++)
     {
         // get its value from its linkage
@@ -278,14 +282,15 @@ void DashBoard::update(float dt)
         {
             // get the value
             float val = manager->getNumeric(controls[i].linkID);
-            // calculate the angle
-            float angle = (val - controls[i].vmin) * (controls[i].wmax - controls[i].wmin) / (controls[i].vmax - controls[i].vmin) + controls[i].wmin;
 
             if (fabs(val - controls[i].last) < 0.02f)
                 continue;
 
             controls[i].last = val;
 
+            // calculate the angle
+            float angle = (val - controls[i].vmin) * (controls[i].wmax - controls[i].wmin) / (controls[i].vmax - controls[i].vmin) + controls[i].wmin;
+
             // enforce limits
             if (angle < controls[i].wmin)
                 angle = controls[i].wmin;
@@ -332,12 +337,11 @@ void DashBoard::update(float dt)
         {
             float val = manager->getNumeric(controls[i].linkID);
 
-            String fn = String(controls[i].texture) + String("-") + TOSTRING((int)val) + String(".png");
-
             if (fabs(val - controls[i].last) < 0.2f)
                 continue;
             controls[i].last = val;
 
+            String fn = String(controls[i].texture) + String("-") + TOSTRING((int)val) + String(".png");
             controls[i].img->setImageTexture(fn);
         }
         else if (controls[i].animationType == ANIM_SCALE)
@@ -420,6 +424,12 @@ void DashBoard::update(float dt)
         else if (controls[i].animationType == ANIM_TEXTSTRING)
         {
             char* val = manager->getChar(controls[i].linkID);
+
+            if (controls[i].lastState && strncmp(val, controls[i].lastText, DD_MAXCHAR) == 0)
+                continue;
+            controls[i].lastState = true; // Caption was set
+            strncpy(controls[i].lastText, val, DD_MAXCHAR);
+
             controls[i].txt->setCaption(MyGUI::UString(val));
         }
     }
@@ -324,6 +324,7 @@ protected:
 
         float last;
         bool lastState;
+        char lastText[DD_MAXCHAR]; //!< ANIM_TEXTSTRING: the caption shown, valid if `lastState`
     } layoutLink_t;
 
     void loadLayoutInternal();
@@ -119,6 +119,7 @@ bool GUIManager::AreStaticMenusAllowed() //!< i.e. top menubar / vehicle UI butt
             !this->TextureToolWindow.IsHovered() &&
             !this->NodeBeamUtils.IsHovered() &&
             !this->CollisionsDebug.IsHovered() &&
+            !this->NetworkTraffic.IsHovered() &&
             !this->MainSelector.IsHovered() &&
             !this->SurveyMap.IsHovered() &&
             !this->FlexbodyDebug.IsHovered());
@@ -155,6 +156,11 @@ void GUIManager::DrawSimulationGui(float dt)
     {
         this->FlexbodyDebug.Draw();
     }
+
+    if (this->NetworkTraffic.IsVisible())
+    {
+        this->NetworkTraffic.Draw();
+    }
 };
 
 void GUIManager::DrawSimGuiBuffered(GfxActor* player_gfx_actor)
@@ -42,6 +42,7 @@
 #include "GUI_MessageBox.h"
 #include "GUI_MultiplayerSelector.h"
 #include "GUI_MultiplayerClientList.h"
+#include "GUI_NetworkTraffic.h"
 #include "GUI_MainSelector.h"
 #include "GUI_NodeBeamUtils.h"
 #include "GUI_DirectionArrow.h"
@@ -114,6 +115,7 @@ public:
     GUI::GameChatBox            ChatBox;
     GUI::VehicleDescription     VehicleDescription;
     GUI::MpClientList           MpClientList;
+    GUI::NetworkTraffic         NetworkTraffic;
     GUI::FrictionSettings       FrictionSettings;
     GUI::TextureToolWindow      TextureToolWindow;
     GUI::GameControls           GameControls;
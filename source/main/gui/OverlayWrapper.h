@@ -138,7 +138,7 @@ public:
     void update(float dt);
     void UpdateLandVehicleHUD(RoR::GfxActor* ga);
     void UpdateAerialHUD(RoR::GfxActor* ga);
-    void UpdateMarineHUD(ActorPtr vehicle);
+    void UpdateMarineHUD(const ActorPtr& vehicle);
 
     void ShowRacingOverlay();
     void HideRacingOverlay();
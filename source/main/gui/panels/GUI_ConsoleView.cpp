@@ -30,7 +30,7 @@
 #include "Language.h"
 #include "Network.h"
 
-#include <algorithm> // min
+#include <algorithm> // min, partition_point
 #include <fmt/core.h>
 #include <string>
 
@@ -42,28 +42,29 @@ inline void color2i(ImVec4 v, int&r, int&g, int&b) { r=(int)(v.x*255); g=(int)(v
 
 static const int LINE_BUF_MAX = 5000;
 
+/// Compares the first words (everything up to the first space)
+static bool HasSamePrefix(std::string const& a, std::string const& b)
+{
+    const size_t a_len = std::min(a.find(' '), a.size());
+    const size_t b_len = std::min(b.find(' '), b.size());
+    return a_len == b_len && a.compare(0, a_len, b, 0, b_len) == 0;
+}
+
+/// In non-scrolling view, a generic message replaces the previous line if both start with the same word.
+static bool IsReplacedByNext(Console::Message const& m, Console::Message const& next)
+{
+    return next.cm_area == Console::CONSOLE_MSGTYPE_INFO && next.cm_type != Console::CONSOLE_SYSTEM_NETCHAT &&
+        HasSamePrefix(m.cm_text, next.cm_text);
+}
+
 void ConsoleView::DrawConsoleMessages()
 {
     // Update pre-filtered message list
     int num_incoming = this->UpdateMessages();
 
-    // Gather visible (non-expired) messages
-    const unsigned long curr_timestamp = App::GetConsole()->queryMessageTimer();
-    m_display_messages.clear();
-    std::string last_prefix;
-    for (Console::Message& m: m_filtered_messages)
-    {
-        if (cvw_msg_duration_ms == 0 || curr_timestamp <= m.cm_timestamp + cvw_msg_duration_ms)
-        {
-            if (m.cm_area == Console::CONSOLE_MSGTYPE_INFO && m.cm_type != Console::CONSOLE_SYSTEM_NETCHAT &&
-                m_display_messages.size() != 0 && !cvw_enable_scrolling && last_prefix == std::string(m.cm_text.substr(0, m.cm_text.find(" ")))) // same prefix with previous line
-            {
-                m_display_messages.pop_back(); // keep in same line
-            }
-            m_display_messages.push_back(&m);
-            last_prefix = m.cm_text.substr(0, m.cm_text.find(" "));
-        }
-    }
+    // Expired messages are always the oldest ones
+    const size_t first_live = this->FindFirstLiveMessage();
+    const size_t num_live = m_filtered_messages.size() - first_live;
 
     // Prepare drawing
     ImDrawList* drawlist = ImGui::GetWindowDrawList();
@@ -71,11 +72,16 @@ void ConsoleView::DrawConsoleMessages()
 
     if (!cvw_enable_scrolling)
     {
-        // Draw from bottom, messages may be multiline
+        // Draw from bottom, messages may be multiline.
+        // Walk backwards so that only messages which fit in the window get measured and formatted.
         ImVec2 cursor = ImGui::GetWindowPos() + ImVec2(0, ImGui::GetWindowHeight());
-        for (int i = m_display_messages.size() - 1; i >= 0; --i)
+        for (size_t i = m_filtered_messages.size(); i > first_live; --i)
         {
-            Console::Message const& m = *m_display_messages[i];
+            Console::Message const& m = m_filtered_messages[i - 1];
+            if (i < m_filtered_messages.size() && IsReplacedByNext(m, m_filtered_messages[i]))
+            {
+                continue; // keep in same line
+            }
             float msg_h = ImGui::CalcTextSize(m.cm_text.c_str()).y + (2 * cvw_background_padding.y) + cvw_line_spacing;
             cursor -= ImVec2(0, msg_h);
             if (cursor.y < ImGui::GetWindowPos().y)
@@ -89,7 +95,7 @@ void ConsoleView::DrawConsoleMessages()
     {
         // Add a dummy sized as messages to facilitate builtin scrolling
         float line_h = ImGui::CalcTextSize("").y + (2 * cvw_background_padding.y) + cvw_line_spacing;
-        float dummy_h = line_h * (float)m_display_messages.size();
+        float dummy_h = line_h * (float)num_live;
         ImGui::SetCursorPosY(dummy_h);
 
         // Autoscroll
@@ -111,7 +117,7 @@ void ConsoleView::DrawConsoleMessages()
         ImVec2 cursor = ImGui::GetWindowPos();
         if (ImGui::GetScrollMaxY() == 0) // No scrolling
         {
-            msg_count = (int)m_display_messages.size();
+            msg_count = (int)num_live;
             cursor += ImVec2(0, view_height - (msg_count * line_h)); // Align to bottom
         }
         else // Scrolling
@@ -121,7 +127,7 @@ void ConsoleView::DrawConsoleMessages()
             msg_start = std::max(0, (int)(scroll_offset/line_h));
 
             msg_count = std::min((int)(view_height / line_h)+2, // Bias (2) for partially visible messages (1 top, 1 bottom)
-                                 (int)m_display_messages.size() - msg_start);
+                                 (int)num_live - msg_start);
 
             const float line_offset = scroll_offset/line_h;
             if (cvw_smooth_scrolling)
@@ -139,7 +145,7 @@ void ConsoleView::DrawConsoleMessages()
         // Draw the messages
         for (int i = msg_start; i < msg_start + msg_count; i++)
         {
-            const Console::Message& m = *m_display_messages[i];
+            const Console::Message& m = m_filtered_messages[first_live + i];
 
             ImVec2 text_size = this->DrawMessage(cursor, m);
             ImGui::SetCursorPosX(text_size.x); // Enable horizontal scrolling
@@ -175,31 +181,27 @@ ImVec2 ConsoleView::DrawMessage(ImVec2 cursor, Console::Message const& m)
     {
         if (m.cm_icon != "")
         {
-            try
-            {
-                icon = Ogre::TextureManager::getSingleton().load(m.cm_icon, "IconsRG");
-            }
-            catch (...) {}
+            icon = this->FetchIcon(m.cm_icon);
         }
         else if (m.cm_area == Console::MessageArea::CONSOLE_MSGTYPE_SCRIPT)
         {
-            icon = Ogre::TextureManager::getSingleton().load("script.png", "IconsRG");
+            icon = this->FetchIcon("script.png");
         }
         else if (m.cm_type == Console::CONSOLE_SYSTEM_NOTICE)
         {
-            icon = Ogre::TextureManager::getSingleton().load("information.png", "IconsRG");
+            icon = this->FetchIcon("information.png");
         }
         else if (m.cm_type == Console::CONSOLE_SYSTEM_WARNING)
         {
-            icon = Ogre::TextureManager::getSingleton().load("error.png", "IconsRG");
+            icon = this->FetchIcon("error.png");
         }
         else if (m.cm_type == Console::CONSOLE_SYSTEM_ERROR)
         {
-            icon = Ogre::TextureManager::getSingleton().load("cancel.png", "IconsRG");
+            icon = this->FetchIcon("cancel.png");
         }
         else if (m.cm_type == Console::CONSOLE_SYSTEM_NETCHAT)
         {
-            icon = Ogre::TextureManager::getSingleton().load("comment.png", "IconsRG");
+            icon = this->FetchIcon("comment.png");
         }
     }
 
@@ -320,9 +322,10 @@ int ConsoleView::UpdateMessages()
     Console::MsgLockGuard lock(App::GetConsole());
 
     // Was console cleared?
-    if (lock.messages.size() < m_total_messages)
+    if (lock.revision != m_messages_revision)
     {
         m_reload_messages = true;
+        m_messages_revision = lock.revision;
     }
 
     // Handle full reload
@@ -333,14 +336,17 @@ int ConsoleView::UpdateMessages()
         m_reload_messages = false;
     }
 
+    // Find new messages - the console drops the oldest ones, we may have missed some.
+    const size_t num_new = std::min(lock.total - m_total_messages, lock.messages.size());
+
     // Apply filtering
     int orig_size = (int)m_filtered_messages.size();
-    for (size_t i = m_total_messages; i < lock.messages.size() ; ++i)
+    for (size_t i = lock.messages.size() - num_new; i < lock.messages.size() ; ++i)
     {
         Console::Message const& m = lock.messages[i];
         if (this->MessageFilter(m))
         {
-            if (cvw_enable_scrolling && m.cm_text.find("\n"))
+            if (cvw_enable_scrolling && m.cm_text.find("\n") != std::string::npos)
             {
                 // Keep it simple: only use single-line messages with scrolling view
                 Ogre::StringVector v = Ogre::StringUtil::split(m.cm_text, "\n"); // TODO: optimize
@@ -359,7 +365,46 @@ int ConsoleView::UpdateMessages()
             }
         }
     }
-    m_total_messages = lock.messages.size();
+    m_total_messages = lock.total;
 
-    return (int)m_filtered_messages.size() - orig_size;
+    // Keep bounded like the console itself.
+    int num_incoming = (int)m_filtered_messages.size() - orig_size;
+    while (m_filtered_messages.size() > Console::MAX_MESSAGES)
+    {
+        m_filtered_messages.pop_front();
+    }
+
+    return num_incoming;
+}
+
+size_t ConsoleView::FindFirstLiveMessage()
+{
+    if (cvw_msg_duration_ms == 0)
+    {
+        return 0;
+    }
+
+    // Messages are ordered by timestamp; binary search for the first non-expired.
+    const unsigned long curr_timestamp = App::GetConsole()->queryMessageTimer();
+    auto itor = std::partition_point(m_filtered_messages.begin(), m_filtered_messages.end(),
+        [this, curr_timestamp](Console::Message const& m) { return curr_timestamp > m.cm_timestamp + cvw_msg_duration_ms; });
+    return (size_t)(itor - m_filtered_messages.begin());
+}
+
+Ogre::TexturePtr ConsoleView::FetchIcon(std::string const& name)
+{
+    auto found = m_icon_cache.find(name);
+    if (found != m_icon_cache.end())
+    {
+        return found->second;
+    }
+
+    Ogre::TexturePtr icon;
+    try
+    {
+        icon = Ogre::TextureManager::getSingleton().load(name, "IconsRG");
+    }
+    catch (...) {}
+    m_icon_cache.insert(std::make_pair(name, icon));
+    return icon;
 }
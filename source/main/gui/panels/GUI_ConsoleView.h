@@ -30,7 +30,7 @@
 #include "Console.h"
 #include "OgreImGui.h"
 
-#include <vector>
+#include <unordered_map>
 
 
 namespace RoR {
@@ -71,11 +71,14 @@ private:
     ImVec2 DrawColoredTextWithIcon(ImVec2 text_cursor, Ogre::TexturePtr icon, ImVec4 default_color, std::string const& line);
     int    UpdateMessages(); //!< Ret. num of new message(s)
     ImVec2 DrawMessage(ImVec2 cursor, Console::Message const& m);
+    size_t FindFirstLiveMessage(); //!< Index of oldest non-expired message in `m_filtered_messages`
+    Ogre::TexturePtr FetchIcon(std::string const& name); //!< Resolved on first use, cached.
 
-    std::vector<Console::Message> m_filtered_messages;    //!< Updated as needed
-    std::vector<const Console::Message*> m_display_messages; //!< Rebuilt every frame; kept as member to reuse allocated memory
+    Console::MessageDeque         m_filtered_messages;    //!< Updated as needed, bounded by `Console::MAX_MESSAGES`
     bool                          m_reload_messages = false;
-    size_t                        m_total_messages = 0;
+    size_t                        m_total_messages = 0;   //!< Console's total message count at last update
+    size_t                        m_messages_revision = 0;
+    std::unordered_map<std::string, Ogre::TexturePtr> m_icon_cache; //!< Failed lookups are cached as null
 };
 
 } // namespace GUI
@@ -385,7 +385,7 @@ void FlexbodyDebug::DrawDebugView(FlexBody* flexbody, Prop* prop, NodeNum_t node
                 }
 
                 // The locator nodes
-                Locator_t& loc = flexbody->getVertexLocator(i);
+                const Locator_t& loc = flexbody->getVertexLocator(i);
                 Ogre::Vector3 refnode_pos = world2screen.Convert(nodes[loc.ref].AbsPosition);
                 Ogre::Vector3 xnode_pos = world2screen.Convert(nodes[loc.nx].AbsPosition);
                 Ogre::Vector3 ynode_pos = world2screen.Convert(nodes[loc.ny].AbsPosition);
@@ -502,7 +502,7 @@ void FlexbodyDebug::DrawLocatorsTable(FlexBody* flexbody, bool& locators_visible
     for (int i = 0; i < flexbody->getVertexCount(); i++)
     {
         ImGui::PushID(i);
-        Locator_t& loc = flexbody->getVertexLocator(i);
+        const Locator_t& loc = flexbody->getVertexLocator(i);
         ImGui::TextDisabled("%d", i);
         ImGui::NextColumn();
         ImGui::Text("%d", (int)loc.ref);
@@ -598,7 +598,7 @@ void FlexbodyDebug::DrawMemoryOrderGraph(FlexBody* flexbody)
     for (int i = 0; i < num_verts; i++)
     {
         const int NUM_SEGMENTS = 5;
-        Locator_t& loc = flexbody->getVertexLocator(i);
+        const Locator_t& loc = flexbody->getVertexLocator(i);
         ImVec2 bottom_x_pos = top_left_pos + ImVec2(i * x_step, size.y);
 
         drawlist->AddCircleFilled(bottom_x_pos - ImVec2(0, (loc.ref - forset_min) * y_step), MEMGRAPH_NODE_RADIUS, ImColor(MEMGRAPH_NODEREF_COLOR_V4), NUM_SEGMENTS);
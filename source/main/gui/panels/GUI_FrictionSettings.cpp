@@ -138,11 +138,10 @@ bool FrictionSettings::GmComboItemGetter(void* data, int idx, const char** out_t
 void FrictionSettings::AnalyzeTerrain()
 {
     m_gm_entries.clear();
-    auto itor = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModels()->begin();
-    auto endi = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModels()->end();
-    for (; itor != endi; ++itor)
+    Collisions* collisions = App::GetGameContext()->GetTerrain()->GetCollisions();
+    for (GroundModelID_t id = 0; id < (GroundModelID_t)collisions->getNumGroundModels(); id++)
     {
-        m_gm_entries.emplace_back(&itor->second);
+        m_gm_entries.emplace_back(collisions->getGroundModel(id));
     }
 }
 
@@ -362,6 +362,12 @@ void GameSettings::DrawGraphicsSettings()
     }
 
     DrawGCheckbox(App::gfx_enable_videocams, _LC("GameSettings", "Render video cameras"));
+    if (App::gfx_enable_videocams->getBool())
+    {
+        ImGui::PushItemWidth(125.f); // Width includes [+/-] buttons
+        DrawGIntSlider(App::gfx_videocam_fps, _LC("GameSettings", "Video camera FPS (0 = every frame)"), 0, 60);
+        ImGui::PopItemWidth();
+    }
     DrawGCheckbox(App::gfx_surveymap_icons,  _LC("GameSettings", "Overview map icons"));
     if (App::gfx_surveymap_icons->getBool())
     {
@@ -399,6 +405,7 @@ void GameSettings::DrawDiagSettings()
     DrawGCheckbox(App::diag_hide_wheel_info,     _LC("GameSettings", "Hide wheel info"));
     DrawGCheckbox(App::diag_hide_wheels,         _LC("GameSettings", "Hide wheels"));
     DrawGCheckbox(App::diag_hide_nodes,          _LC("GameSettings", "Hide nodes"));
+    DrawGCheckbox(App::diag_declutter_labels,    _LC("GameSettings", "Declutter labels"));
     DrawGCheckbox(App::diag_log_console_echo,    _LC("GameSettings", "Echo log to console"));
     DrawGCheckbox(App::diag_log_beam_break,      _LC("GameSettings", "Log beam breaking"));
     DrawGCheckbox(App::diag_log_beam_deform,     _LC("GameSettings", "Log beam deforming"));
@@ -443,6 +450,7 @@ void GameSettings::DrawControlSettings()
         DrawGIntBox(App::io_outgauge_port,    _LC("GameSettings", "OutGauge port"));
         DrawGIntBox(App::io_outgauge_id,      _LC("GameSettings", "OutGauge ID"));
         DrawGFloatBox(App::io_outgauge_delay, _LC("GameSettings", "OutGauge delay"));
+        DrawGIntBox(App::io_outsim_port,      _LC("GameSettings", "OutSim port (0 = off)"));
         ImGui::PopItemWidth();
     }
 }
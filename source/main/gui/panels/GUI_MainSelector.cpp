@@ -31,6 +31,7 @@
 #include "GUI_LoadingWindow.h"
 #include "InputEngine.h"
 #include "Language.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include <MyGUI.h>
@@ -89,6 +90,8 @@ void MainSelector::Draw()
 
     App::GetGuiManager()->RequestGuiCaptureKeyboard(true);
 
+    this->CheckPendingQuery();
+
     // category keyboard control
     const int num_categories = static_cast<int>(m_display_categories.size());
     if (!m_searchbox_was_active || m_search_input == "")
@@ -146,7 +149,7 @@ void MainSelector::Draw()
         m_selected_category = 0; // 'All'
         m_selected_cid = CID_All;
         this->UpdateSearchParams();
-        this->UpdateDisplayLists();
+        this->RequestDisplayListsUpdate();
     }
     ImGui::PopItemWidth();
     m_searchbox_was_active = ImGui::IsItemActive();
@@ -281,56 +284,57 @@ void MainSelector::Draw()
         }
 
         // Title and description
+        CacheEntryDetails const& details = App::GetCacheSystem()->GetEntryDetails(*sd_entry.sde_entry);
         RoR::ImTextWrappedColorMarked(sd_entry.sde_entry->dname);
-        ImGui::TextWrapped("%s", sd_entry.sde_entry->description.c_str());
+        ImGui::TextWrapped("%s", details.description.c_str());
         ImGui::Separator();
 
         // Details
-        for (AuthorInfo const& author: sd_entry.sde_entry->authors)
+        for (AuthorInfo const& author: details.authors)
         {
             ImGui::TextDisabled("%s", _LC("MainSelector", "Author(s): "));
             ImGui::SameLine();
             ImGui::TextColored(theme.value_blue_text_color, "%s [%s]", author.name.c_str(), author.type.c_str());
         }
         this->DrawAttrInt(_LC("MainSelector", "Version: "), sd_entry.sde_entry->version);
-        if (sd_entry.sde_entry->wheelcount > 0)
+        if (details.wheelcount > 0)
         {
             ImGui::Text("%s", _LC("MainSelector", "Wheels: ")); 
             ImGui::SameLine();
-            ImGui::TextColored(theme.value_blue_text_color, "%dx%d", sd_entry.sde_entry->wheelcount, sd_entry.sde_entry->propwheelcount);
+            ImGui::TextColored(theme.value_blue_text_color, "%dx%d", details.wheelcount, details.propwheelcount);
         }
-        if (sd_entry.sde_entry->truckmass > 0)
+        if (details.truckmass > 0)
         {
             ImGui::Text("%s", _LC("MainSelector", "Mass: ")); 
             ImGui::SameLine();
-            ImGui::TextColored(theme.value_blue_text_color, "%.2f t", Round(sd_entry.sde_entry->truckmass / 1000.0f, 3));
+            ImGui::TextColored(theme.value_blue_text_color, "%.2f t", Round(details.truckmass / 1000.0f, 3));
         }
 
         if (m_show_details)
         {
-            if (sd_entry.sde_entry->loadmass > 0)
+            if (details.loadmass > 0)
             {
                 ImGui::Text("%s", _LC("MainSelector", "Load Mass: ")); 
                 ImGui::SameLine();
-                ImGui::TextColored(theme.value_blue_text_color, "%f.2 t", Round(sd_entry.sde_entry->loadmass / 1000.0f, 3));
+                ImGui::TextColored(theme.value_blue_text_color, "%f.2 t", Round(details.loadmass / 1000.0f, 3));
             }
-            this->DrawAttrInt(_LC("MainSelector", "Nodes: "), sd_entry.sde_entry->nodecount);
-            this->DrawAttrInt(_LC("MainSelector", "Beams: "), sd_entry.sde_entry->beamcount);
-            this->DrawAttrInt(_LC("MainSelector", "Shocks: "), sd_entry.sde_entry->shockcount);
-            this->DrawAttrInt(_LC("MainSelector", "Hydros: "), sd_entry.sde_entry->hydroscount);
-            this->DrawAttrInt(_LC("MainSelector", "SoundSources: "), sd_entry.sde_entry->soundsourcescount);
-            this->DrawAttrInt(_LC("MainSelector", "Commands: "), sd_entry.sde_entry->commandscount);
-            this->DrawAttrInt(_LC("MainSelector", "Rotators: "), sd_entry.sde_entry->rotatorscount);
-            this->DrawAttrInt(_LC("MainSelector", "Exhausts: "), sd_entry.sde_entry->exhaustscount);
-            this->DrawAttrInt(_LC("MainSelector", "Flares: "), sd_entry.sde_entry->flarescount);
-            this->DrawAttrInt(_LC("MainSelector", "Flexbodies: "), sd_entry.sde_entry->flexbodiescount);
-            this->DrawAttrInt(_LC("MainSelector", "Props: "), sd_entry.sde_entry->propscount);
-            this->DrawAttrInt(_LC("MainSelector", "Wings: "), sd_entry.sde_entry->wingscount);
-            if (sd_entry.sde_entry->hasSubmeshs)
+            this->DrawAttrInt(_LC("MainSelector", "Nodes: "), details.nodecount);
+            this->DrawAttrInt(_LC("MainSelector", "Beams: "), details.beamcount);
+            this->DrawAttrInt(_LC("MainSelector", "Shocks: "), details.shockcount);
+            this->DrawAttrInt(_LC("MainSelector", "Hydros: "), details.hydroscount);
+            this->DrawAttrInt(_LC("MainSelector", "SoundSources: "), details.soundsourcescount);
+            this->DrawAttrInt(_LC("MainSelector", "Commands: "), details.commandscount);
+            this->DrawAttrInt(_LC("MainSelector", "Rotators: "), details.rotatorscount);
+            this->DrawAttrInt(_LC("MainSelector", "Exhausts: "), details.exhaustscount);
+            this->DrawAttrInt(_LC("MainSelector", "Flares: "), details.flarescount);
+            this->DrawAttrInt(_LC("MainSelector", "Flexbodies: "), details.flexbodiescount);
+            this->DrawAttrInt(_LC("MainSelector", "Props: "), details.propscount);
+            this->DrawAttrInt(_LC("MainSelector", "Wings: "), details.wingscount);
+            if (details.hasSubmeshs)
             {
                 ImGui::Text("%s", _LC("MainSelector", "Using Submeshs: ")); 
                 ImGui::SameLine();
-                ImGui::TextColored(theme.value_blue_text_color, "%s", sd_entry.sde_entry->hasSubmeshs ?_LC("MainSelector", "Yes") : _LC("MainSelector", "No"));
+                ImGui::TextColored(theme.value_blue_text_color, "%s", details.hasSubmeshs ?_LC("MainSelector", "Yes") : _LC("MainSelector", "No"));
             }
             if (sd_entry.sde_entry->default_skin != "")
             {
@@ -338,13 +342,13 @@ void MainSelector::Draw()
                 ImGui::SameLine();
                 ImGui::TextColored(theme.value_blue_text_color, "%s", sd_entry.sde_entry->default_skin.c_str());
             }
-            this->DrawAttrFloat(_LC("MainSelector", "Torque: "), sd_entry.sde_entry->torque);
-            this->DrawAttrInt(_LC("MainSelector", "Transmission Gear Count: "), sd_entry.sde_entry->numgears);
-            if (sd_entry.sde_entry->minrpm > 0)
+            this->DrawAttrFloat(_LC("MainSelector", "Torque: "), details.torque);
+            this->DrawAttrInt(_LC("MainSelector", "Transmission Gear Count: "), details.numgears);
+            if (details.minrpm > 0)
             {
                 ImGui::Text("%s", _LC("MainSelector", "Engine RPM: ")); 
                 ImGui::SameLine();
-                ImGui::TextColored(theme.value_blue_text_color, "%f - %f", sd_entry.sde_entry->minrpm, sd_entry.sde_entry->maxrpm);
+                ImGui::TextColored(theme.value_blue_text_color, "%f - %f", details.minrpm, details.maxrpm);
             }
             this->DrawAttrStr(_LC("MainSelector", "Unique ID: "), sd_entry.sde_entry->uniqueid);
             this->DrawAttrStr(_LC("MainSelector", "GUID: "), sd_entry.sde_entry->guid);
@@ -356,13 +360,13 @@ void MainSelector::Draw()
                 this->DrawAttrStr(_LC("MainSelector", "Vehicle Type: "), sd_entry.sde_driveable_str.ToCStr());
             }
 
-            this->DrawAttrSpecial(sd_entry.sde_entry->forwardcommands, _LC("MainSelector", "[forwards commands]"));
-            this->DrawAttrSpecial(sd_entry.sde_entry->importcommands, _LC("MainSelector", "[imports commands]"));
-            this->DrawAttrSpecial(sd_entry.sde_entry->rescuer, _LC("MainSelector", "[is rescuer]"));
-            this->DrawAttrSpecial(sd_entry.sde_entry->custom_particles, _LC("MainSelector", "[uses custom particles]"));
-            this->DrawAttrSpecial(sd_entry.sde_entry->fixescount > 0, _LC("MainSelector", "[has fixes]"));
+            this->DrawAttrSpecial(details.forwardcommands, _LC("MainSelector", "[forwards commands]"));
+            this->DrawAttrSpecial(details.importcommands, _LC("MainSelector", "[imports commands]"));
+            this->DrawAttrSpecial(details.rescuer, _LC("MainSelector", "[is rescuer]"));
+            this->DrawAttrSpecial(details.custom_particles, _LC("MainSelector", "[uses custom particles]"));
+            this->DrawAttrSpecial(details.fixescount > 0, _LC("MainSelector", "[has fixes]"));
             // Engine type 't' (truck) is the default, do not display it
-            this->DrawAttrSpecial(sd_entry.sde_entry->enginetype == 'c', _LC("MainSelector", "[car engine]"));
+            this->DrawAttrSpecial(details.enginetype == 'c', _LC("MainSelector", "[car engine]"));
             this->DrawAttrSpecial(sd_entry.sde_entry->resource_bundle_type == "Zip", _LC("MainSelector", "[zip archive]"));
             this->DrawAttrSpecial(sd_entry.sde_entry->resource_bundle_type == "FileSystem", _LC("MainSelector", "[unpacked in directory]"));
 
@@ -442,24 +446,84 @@ struct sort_cats
 
 void MainSelector::UpdateDisplayLists()
 {
-    m_display_categories.clear();
-    m_display_entries.clear();
+    this->CancelPendingQuery(); // Would be outdated
 
-    if (m_advertised_entry)
+    CacheQuery query;
+    this->PrepareQuery(query);
+    App::GetCacheSystem()->Query(query);
+    this->ApplyQueryResults(query);
+}
+
+void MainSelector::RequestDisplayListsUpdate()
+{
+    if (m_pending_query)
     {
-        m_display_entries.push_back(m_advertised_entry);
-        m_selected_entry = 0;
+        m_pending_query_outdated = true; // Will be re-run with the latest input once done
+        return;
     }
 
-    // Find all relevant entries
-    CacheQuery query;
+    std::shared_ptr<PendingQuery> pending_query = std::make_shared<PendingQuery>();
+    this->PrepareQuery(pending_query->query);
+    m_pending_query = pending_query;
+    m_pending_query_outdated = false;
+    m_pending_query_task = App::GetThreadPool()->RunTask([pending_query]()
+    {
+        App::GetCacheSystem()->Query(pending_query->query);
+        pending_query->finished = true;
+    });
+}
+
+void MainSelector::CheckPendingQuery()
+{
+    if (!m_pending_query || !m_pending_query->finished)
+    {
+        return;
+    }
+
+    m_pending_query_task->join();
+    std::shared_ptr<PendingQuery> pending_query = m_pending_query;
+    m_pending_query.reset();
+    m_pending_query_task.reset();
+    if (m_pending_query_outdated)
+    {
+        this->RequestDisplayListsUpdate(); // Skip outdated results, the list would flicker
+    }
+    else
+    {
+        this->ApplyQueryResults(pending_query->query);
+    }
+}
+
+void MainSelector::CancelPendingQuery()
+{
+    if (m_pending_query_task)
+    {
+        m_pending_query_task->join();
+    }
+    m_pending_query.reset();
+    m_pending_query_task.reset();
+    m_pending_query_outdated = false;
+}
+
+void MainSelector::PrepareQuery(CacheQuery& query) const
+{
     query.cqy_filter_type = m_loader_type;
     query.cqy_filter_category_id = m_selected_cid;
     query.cqy_search_method = m_search_method;
     query.cqy_search_string = m_search_string;
     query.cqy_filter_guid = m_filter_guid;
+}
 
-    App::GetCacheSystem()->Query(query);
+void MainSelector::ApplyQueryResults(CacheQuery& query)
+{
+    m_display_categories.clear();
+    m_display_entries.clear();
+
+    if (m_advertised_entry)
+    {
+        m_display_entries.push_back(m_advertised_entry);
+        m_selected_entry = 0;
+    }
 
     m_selected_entry = -1;
     for (CacheQueryResult const& res: query.cqy_results)
@@ -581,6 +645,7 @@ void MainSelector::DrawAttrStr(const char* desc, std::string const& str) const
 
 void MainSelector::Close()
 {
+    this->CancelPendingQuery();
     m_selected_entry = -1;
     m_selected_sectionconfig = 0;
     m_searchbox_was_active = false;
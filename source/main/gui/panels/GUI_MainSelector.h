@@ -30,7 +30,9 @@
 #include "CacheSystem.h" // CacheSearchMethod
 #include "ForwardDeclarations.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
 
 namespace RoR {
 namespace GUI {
@@ -70,7 +72,19 @@ private:
     typedef std::vector<DisplayCategory> DisplayCategoryVec;
     typedef std::vector<DisplayEntry>    DisplayEntryVec;
 
-    void UpdateDisplayLists();
+    /// Search running on the thread pool while typing
+    struct PendingQuery
+    {
+        CacheQuery        query;
+        std::atomic<bool> finished{false};
+    };
+
+    void UpdateDisplayLists();      //!< Queries the cache right away
+    void RequestDisplayListsUpdate(); //!< Queries the cache in background, see `CheckPendingQuery()`
+    void CheckPendingQuery();       //!< Applies results of a finished background query
+    void CancelPendingQuery();
+    void PrepareQuery(CacheQuery& query) const;
+    void ApplyQueryResults(CacheQuery& query);
     void UpdateSearchParams();
     void Apply();
     void Cancel();
@@ -93,6 +107,9 @@ private:
     bool               m_searchbox_was_active = false;
     CacheEntry*        m_advertised_entry = nullptr; //!< Always shown on top, even if not existing in modcache (i.e. dummy default skin)
     bool               m_is_hovered = false;
+    std::shared_ptr<PendingQuery> m_pending_query;
+    std::shared_ptr<Task>         m_pending_query_task;
+    bool               m_pending_query_outdated = false; //!< Search input changed while the background query was running
 
     int                m_selected_category = 0;    //!< Combobox position (uses display list)
     int                m_selected_cid = 0;         //!< Category ID
@@ -24,6 +24,7 @@
 
 #include "Application.h"
 #include "ContentManager.h"
+#include "CurlHelpers.h"
 #include "GameContext.h"
 #include "GUIManager.h"
 #include "GUIUtils.h"
@@ -34,6 +35,10 @@
 #include <imgui.h>
 #include <rapidjson/document.h>
 #include <fmt/core.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
 #include <vector>
 
 #ifdef USE_CURL
@@ -41,6 +46,10 @@
 #   include <curl/easy.h>
 #endif //USE_CURL
 
+#ifdef USE_SOCKETW
+#   include <SocketW.h>
+#endif //USE_SOCKETW
+
 #if defined(_MSC_VER) && defined(GetObject) // This MS Windows macro from <wingdi.h> (Windows Kit 8.1) clashes with RapidJSON
 #   undef GetObject
 #endif
@@ -48,40 +57,63 @@
 using namespace RoR;
 using namespace GUI;
 
-#if defined(USE_CURL)
+static const int    MP_PING_LANES = 8;          //!< Max. number of servers probed at once
+static const int    MP_PING_TIMEOUT_SEC = 2;
+
+struct RoR::GUI::MpPingProbes
+{
+    MpPingProbes(size_t count): targets(count), results(new std::atomic<int>[count])
+    {
+        for (size_t i = 0; i < count; ++i)
+            results[i] = MpServerInfo::PING_PENDING;
+    }
 
-// From example: https://gist.github.com/whoshuu/2dc858b8730079602044
-size_t CurlWriteFunc(void *ptr, size_t size, size_t nmemb, std::string* data)
+    std::vector<std::pair<std::string, int>> targets; //!< Host, port
+    std::unique_ptr<std::atomic<int>[]>      results; //!< Milliseconds or `MpServerInfo::PING_*`
+    std::atomic<size_t>                      next_target{0};
+    std::atomic<int>                         num_done{0};
+    std::atomic<bool>                        abandoned{false}; //!< Set when the list is refreshed
+};
+
+/// Runs on a background thread; each lane keeps taking the next unprobed server.
+static void RunPingLane(std::shared_ptr<MpPingProbes> probes)
 {
-    data->append((char*) ptr, size * nmemb);
-    return size * nmemb;
+#if defined(USE_SOCKETW)
+    for (size_t i = probes->next_target++; i < probes->targets.size() && !probes->abandoned; i = probes->next_target++)
+    {
+        const auto start_time = std::chrono::steady_clock::now();
+        SWBaseSocket::SWBaseError error;
+        SWInetSocket socket;
+        socket.set_timeout(MP_PING_TIMEOUT_SEC, 0);
+        socket.connect(probes->targets[i].second, probes->targets[i].first, &error);
+        if (error == SWBaseSocket::ok)
+        {
+            probes->results[i] = (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - start_time).count();
+            socket.set_timeout(1, 0);
+            socket.disconnect();
+        }
+        else
+        {
+            probes->results[i] = MpServerInfo::PING_UNREACHABLE;
+        }
+        probes->num_done++;
+    }
+#endif // defined(USE_SOCKETW)
 }
 
+#if defined(USE_CURL)
+
 void FetchServerlist(std::string portal_url)
 {
     std::string serverlist_url = portal_url + "/server-list?json=true";
     std::string response_payload;
-    std::string response_header;
     long        response_code = 0;
+    CURLcode    curl_result = CURLE_OK;
 
-    CURL *curl = curl_easy_init();
-    curl_easy_setopt(curl, CURLOPT_URL,           serverlist_url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlWriteFunc);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA,     &response_payload);
-    curl_easy_setopt(curl, CURLOPT_HEADERDATA,    &response_header);
-
-    CURLcode curl_result = curl_easy_perform(curl);
-    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-
-    curl_easy_cleanup(curl);
-    curl = nullptr;
-
-    if (curl_result != CURLE_OK || response_code != 200)
+    if (!GetUrlAsString(serverlist_url, /*out:*/curl_result, /*out:*/response_code, /*out:*/response_payload))
     {
-        Ogre::LogManager::getSingleton().stream() 
-            << "[RoR|Multiplayer] Failed to retrieve serverlist;"
-            << " Error: '" << curl_easy_strerror(curl_result) << "'; HTTP status code: " << response_code;
-
+        // Already logged by `GetUrlAsString()`
         CurlFailInfo* failinfo = new CurlFailInfo();
         failinfo->title = _LC("MultiplayerSelector", "Error connecting to server :(");
         failinfo->curl_result = curl_result;
@@ -266,18 +298,21 @@ void MultiplayerSelector::DrawServerlistTab()
                 + ImGui::GetStyle().ItemSpacing.y);
         ImGui::BeginChild("scrolling", ImVec2(0.f, table_height), false);
         // ... and the table itself
+        this->UpdatePings();
         const float table_width = ImGui::GetWindowContentRegionWidth();
-        ImGui::Columns(5, "mp-selector-columns");         // Col #0: Server name (and lock icon)
-        ImGui::SetColumnOffset(1, 0.36f * table_width);   // Col #1: Terrain name
-        ImGui::SetColumnOffset(2, 0.67f * table_width);   // Col #2: Users/Max
-        ImGui::SetColumnOffset(3, 0.74f * table_width);   // Col #3: Version
-        ImGui::SetColumnOffset(4, 0.82f * table_width);   // Col #4: Host/Port
+        ImGui::Columns(6, "mp-selector-columns");         // Col #0: Server name (and lock icon)
+        ImGui::SetColumnOffset(1, 0.33f * table_width);   // Col #1: Terrain name
+        ImGui::SetColumnOffset(2, 0.61f * table_width);   // Col #2: Users/Max
+        ImGui::SetColumnOffset(3, 0.68f * table_width);   // Col #3: Version
+        ImGui::SetColumnOffset(4, 0.76f * table_width);   // Col #4: Ping
+        ImGui::SetColumnOffset(5, 0.84f * table_width);   // Col #5: Host/Port
         // Draw table header
         ImGui::SetCursorPosX(ImGui::GetCursorPosX() + TABLE_PADDING_LEFT);
         DrawTableHeader(_LC("MultiplayerSelector", "Name"));
         DrawTableHeader(_LC("MultiplayerSelector", "Terrain"));
         DrawTableHeader(_LC("MultiplayerSelector", "Users"));
         DrawTableHeader(_LC("MultiplayerSelector", "Version"));
+        DrawTableHeader(_LC("MultiplayerSelector", "Ping"));
         DrawTableHeader(_LC("MultiplayerSelector", "Host/Port"));
         ImGui::Separator();
         // Draw table body
@@ -318,6 +353,7 @@ void MultiplayerSelector::DrawServerlistTab()
             ImGui::PushStyleColor(ImGuiCol_Text, version_color);
             ImGui::Text("%s", server.display_version.c_str()); ImGui::NextColumn();
             ImGui::PopStyleColor();
+            ImGui::Text("%s", server.display_ping.c_str());    ImGui::NextColumn();
             ImGui::Text("%s", server.display_host.c_str());    ImGui::NextColumn();
 
             ImGui::PopID();
@@ -384,6 +420,11 @@ void MultiplayerSelector::StartAsyncRefresh()
     m_serverlist_data.clear();
     m_selected_item = -1;
     m_serverlist_msg = "";
+    if (m_ping_probes)
+    {
+        m_ping_probes->abandoned = true; // Lanes finish their current probe and quit
+        m_ping_probes = nullptr;
+    }
     std::packaged_task<void(std::string)> task(FetchServerlist);
     std::thread(std::move(task), App::mp_api_url->getStr()).detach(); // launch on a thread
 #endif // defined(USE_CURL)
@@ -428,6 +469,67 @@ void MultiplayerSelector::UpdateServerlist(MpServerInfoVec* data)
     else
     {
         m_serverlist_msg = "";
+        this->StartPingProbes();
+    }
+}
+
+void MultiplayerSelector::StartPingProbes()
+{
+#if defined(USE_SOCKETW)
+    m_ping_probes = std::make_shared<MpPingProbes>(m_serverlist_data.size());
+    m_pings_received = 0;
+    for (size_t i = 0; i < m_serverlist_data.size(); ++i)
+    {
+        m_serverlist_data[i].ping_probe_index = i;
+        m_serverlist_data[i].display_ping = "...";
+        m_ping_probes->targets[i] = std::make_pair(m_serverlist_data[i].net_host, m_serverlist_data[i].net_port);
+    }
+
+    const int num_lanes = std::min(MP_PING_LANES, (int)m_serverlist_data.size());
+    for (int i = 0; i < num_lanes; ++i)
+    {
+        std::thread(RunPingLane, m_ping_probes).detach();
+    }
+#endif // defined(USE_SOCKETW)
+}
+
+void MultiplayerSelector::UpdatePings()
+{
+    if (!m_ping_probes || m_ping_probes->num_done == m_pings_received)
+    {
+        return;
+    }
+    m_pings_received = m_ping_probes->num_done;
+
+    for (MpServerInfo& server: m_serverlist_data)
+    {
+        server.net_ping_ms = m_ping_probes->results[server.ping_probe_index];
+        if (server.net_ping_ms >= 0)
+            server.display_ping = fmt::format("{} ms", server.net_ping_ms);
+        else if (server.net_ping_ms == MpServerInfo::PING_UNREACHABLE)
+            server.display_ping = "--";
+    }
+
+    // Sort by ping (pending, then unreachable last), keep selection
+    size_t selected_probe = (m_selected_item != -1) ? m_serverlist_data[m_selected_item].ping_probe_index : 0;
+    std::stable_sort(m_serverlist_data.begin(), m_serverlist_data.end(),
+        [](MpServerInfo const& a, MpServerInfo const& b)
+        {
+            auto sort_key = [](int ping_ms) -> long
+            {
+                if (ping_ms == MpServerInfo::PING_PENDING)     return LONG_MAX - 1;
+                if (ping_ms == MpServerInfo::PING_UNREACHABLE) return LONG_MAX;
+                return ping_ms;
+            };
+            return sort_key(a.net_ping_ms) < sort_key(b.net_ping_ms);
+        });
+    if (m_selected_item != -1)
+    {
+        for (size_t i = 0; i < m_serverlist_data.size(); ++i)
+        {
+            if (m_serverlist_data[i].ping_probe_index == selected_probe)
+                m_selected_item = (int)i;
+        }
     }
 }
 
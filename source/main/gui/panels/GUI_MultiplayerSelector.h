@@ -35,6 +35,9 @@ namespace GUI {
 
 struct MpServerInfo
 {
+    static const int PING_PENDING = -1;
+    static const int PING_UNREACHABLE = -2;
+
     bool          has_password;
     std::string   display_passwd;
     std::string   display_name;
@@ -47,8 +50,13 @@ struct MpServerInfo
     std::string   display_version;
     int           net_port;
     std::string   display_host;
+    int           net_ping_ms = PING_PENDING; //!< Measured TCP connect time
+    std::string   display_ping;
+    size_t        ping_probe_index = 0;       //!< Index in `MpPingProbes::targets`
 };
 
+struct MpPingProbes; // Shared with the probing threads, defined in .cpp
+
 typedef std::vector<MpServerInfo> MpServerInfoVec;
 
 class MultiplayerSelector
@@ -70,8 +78,12 @@ private:
     void                DrawSetupTab();
     void                DrawDirectTab();
     void                DrawServerlistTab();
+    void                StartPingProbes();
+    void                UpdatePings();       //!< Collects probe results and re-sorts the list by ping
 
     MpServerInfoVec     m_serverlist_data;
+    std::shared_ptr<MpPingProbes> m_ping_probes;
+    int                 m_pings_received = 0;
     int                 m_selected_item = -1;
     char                m_window_title[100];
     bool                m_is_visible = false;
@@ -0,0 +1,136 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "GUI_NetworkTraffic.h"
+
+#include "Actor.h"
+#include "ActorManager.h"
+#include "Application.h"
+#include "GameContext.h"
+#include "GUIManager.h"
+#include "Language.h"
+#include "Network.h"
+
+#include <imgui.h>
+
+using namespace RoR;
+using namespace GUI;
+
+void NetworkTraffic::UpdateRates()
+{
+#if USE_SOCKETW
+    const float now = App::GetNetwork()->GetStreamStatsTime();
+    if (now < m_last_sample_time) // Counters were reset (reconnect)
+    {
+        m_rates.clear();
+        m_last_sample_time = 0.f;
+    }
+    const float elapsed = now - m_last_sample_time;
+    if (elapsed < RATE_INTERVAL_SEC)
+        return;
+
+    for (NetStreamStats const& stats: App::GetNetwork()->GetStreamStats())
+    {
+        StreamRate& rate = m_rates[std::make_pair(stats.source_id, stats.stream_id)];
+        rate.bytes_per_sec = (stats.num_bytes - rate.last_bytes) / elapsed;
+        rate.packets_per_sec = (stats.num_packets - rate.last_packets) / elapsed;
+        rate.last_bytes = stats.num_bytes;
+        rate.last_packets = stats.num_packets;
+    }
+    m_last_sample_time = now;
+#endif // USE_SOCKETW
+}
+
+void NetworkTraffic::Draw()
+{
+#if USE_SOCKETW
+    ImGuiWindowFlags win_flags = ImGuiWindowFlags_NoCollapse | ImGuiWindowFlags_AlwaysAutoResize;
+    bool keep_open = true;
+    ImGui::Begin(_LC("NetworkTraffic", "Network traffic"), &keep_open, win_flags);
+
+    this->UpdateRates();
+
+    ImGui::Text("%s%d", _LC("NetworkTraffic", "Net quality: "), App::GetNetwork()->GetNetQuality());
+    ImGui::Text("%s%d / %d", _LC("NetworkTraffic", "Queued packets (send / receive): "),
+        (int)App::GetNetwork()->GetSendQueueSize(), (int)App::GetNetwork()->GetRecvQueueSize());
+    ImGui::Separator();
+
+    // Streams
+    ImGui::Columns(8, /*id=*/"NetworkTrafficStreams", /*border=*/true);
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "User"));       ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Stream"));     ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Direction"));  ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Total KiB"));  ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "KiB/s"));      ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Packets/s"));  ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Largest (B)")); ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Dropped"));    ImGui::NextColumn();
+    ImGui::Separator();
+    for (NetStreamStats const& stats: App::GetNetwork()->GetStreamStats())
+    {
+        StreamRate const& rate = m_rates[std::make_pair(stats.source_id, stats.stream_id)];
+        RoRnet::UserInfo user;
+        const char* username = (App::GetNetwork()->GetAnyUserInfo(stats.source_id, user)) ? user.username : "-";
+
+        ImGui::Text("%s (%d)", username, stats.source_id);                  ImGui::NextColumn();
+        ImGui::Text("%d", stats.stream_id);                                 ImGui::NextColumn();
+        ImGui::Text("%s", stats.outgoing ? _LC("NetworkTraffic", "out") : _LC("NetworkTraffic", "in")); ImGui::NextColumn();
+        ImGui::Text("%.1f", stats.num_bytes / 1024.f);                      ImGui::NextColumn();
+        ImGui::Text("%.2f", rate.bytes_per_sec / 1024.f);                   ImGui::NextColumn();
+        ImGui::Text("%.1f", rate.packets_per_sec);                          ImGui::NextColumn();
+        ImGui::Text("%u", stats.max_packet_size);                           ImGui::NextColumn();
+        ImGui::Text("%llu", (unsigned long long)stats.num_dropped);         ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+    ImGui::Separator();
+
+    // Remote actors
+    ImGui::Columns(5, /*id=*/"NetworkTrafficActors", /*border=*/true);
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Remote actor")); ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Stream"));       ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Late"));         ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Dropped"));      ImGui::NextColumn();
+    ImGui::TextDisabled("%s", _LC("NetworkTraffic", "Time offset (ms)")); ImGui::NextColumn();
+    ImGui::Separator();
+    for (ActorPtr& actor: App::GetGameContext()->GetActorManager()->GetActors())
+    {
+        if (actor->ar_state != ActorState::NETWORKED_OK && actor->ar_state != ActorState::NETWORKED_HIDDEN)
+            continue;
+
+        ImGui::Text("%s", actor->ar_design_name.c_str());                                   ImGui::NextColumn();
+        ImGui::Text("%d:%d", actor->ar_net_source_id, actor->ar_net_stream_id);            ImGui::NextColumn();
+        ImGui::Text("%d", (int)actor->ar_net_num_late_updates);                            ImGui::NextColumn();
+        ImGui::Text("%d", (int)actor->ar_net_num_dropped_updates);                         ImGui::NextColumn();
+        ImGui::Text("%d", App::GetGameContext()->GetActorManager()->GetNetTimeOffset(actor->ar_net_source_id)); ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+
+    m_is_hovered = ImGui::IsWindowHovered(ImGuiHoveredFlags_RootAndChildWindows);
+    App::GetGuiManager()->RequestGuiCaptureKeyboard(m_is_hovered);
+
+    ImGui::End();
+
+    if (!keep_open)
+    {
+        this->SetVisible(false);
+    }
+#endif // USE_SOCKETW
+}
@@ -0,0 +1,61 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <utility>
+
+namespace RoR {
+namespace GUI {
+
+/// Diagnostic view of multiplayer traffic: bytes/packets per stream, queue depths and remote actor playback health.
+class NetworkTraffic
+{
+public:
+    const float RATE_INTERVAL_SEC = 1.f;
+
+    void SetVisible(bool v) { m_is_visible = v; }
+    bool IsVisible() const { return m_is_visible; }
+    bool IsHovered() const { return IsVisible() && m_is_hovered; }
+
+    void Draw();
+
+private:
+    struct StreamRate
+    {
+        uint64_t last_bytes = 0;
+        uint64_t last_packets = 0;
+        float    bytes_per_sec = 0.f;
+        float    packets_per_sec = 0.f;
+    };
+
+    void UpdateRates();
+
+    bool  m_is_visible = false;
+    bool  m_is_hovered = false;
+    float m_last_sample_time = 0.f;
+    std::map<std::pair<int, int>, StreamRate> m_rates; //!< Key: source ID, stream ID
+};
+
+} // namespace GUI
+} // namespace RoR
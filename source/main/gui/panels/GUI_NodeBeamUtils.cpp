@@ -50,37 +50,37 @@ void NodeBeamUtils::Draw()
     {
         actor->ar_nb_mass_scale = cur_mass / ref_mass;
         actor->ar_nb_initialized = false;
-        actor->applyNodeBeamScales();
+        actor->applyNodeMassScale();
     }
     ImGui::Separator();
     ImGui::TextColored(GRAY_HINT_TEXT, _LC("NodeBeamUtils", "Beams:"));
     if (ImGui::SliderFloat("Spring##Beams", &actor->ar_nb_beams_scale.first, 0.1f, 10.0f, "%.5f"))
     {
-        actor->applyNodeBeamScales();
+        actor->applyBeamGroupScale(actor->ar_nb_plain_beams, actor->ar_nb_beams_scale);
     }
     if (ImGui::SliderFloat("Damping##Beams", &actor->ar_nb_beams_scale.second, 0.1f, 10.0f, "%.5f"))
     {
-        actor->applyNodeBeamScales();
+        actor->applyBeamGroupScale(actor->ar_nb_plain_beams, actor->ar_nb_beams_scale);
     }
     ImGui::Separator();
     ImGui::TextColored(GRAY_HINT_TEXT, _LC("NodeBeamUtils", "Shocks:"));
     if (ImGui::SliderFloat("Spring##Shocks", &actor->ar_nb_shocks_scale.first, 0.1f, 10.0f, "%.5f"))
     {
-        actor->applyNodeBeamScales();
+        actor->applyBeamGroupScale(actor->ar_nb_shock_beams, actor->ar_nb_shocks_scale);
     }
     if (ImGui::SliderFloat("Damping##Shocks", &actor->ar_nb_shocks_scale.second, 0.1f, 10.0f, "%.5f"))
     {
-        actor->applyNodeBeamScales();
+        actor->applyBeamGroupScale(actor->ar_nb_shock_beams, actor->ar_nb_shocks_scale);
     }
     ImGui::Separator();
     ImGui::TextColored(GRAY_HINT_TEXT, _LC("NodeBeamUtils", "Wheels:"));
     if (ImGui::SliderFloat("Spring##Wheels", &actor->ar_nb_wheels_scale.first, 0.1f, 10.0f, "%.5f"))
     {
-        actor->applyNodeBeamScales();
+        actor->applyBeamGroupScale(actor->ar_nb_wheel_beams, actor->ar_nb_wheels_scale);
     }
     if (ImGui::SliderFloat("Damping##Wheels", &actor->ar_nb_wheels_scale.second, 0.1f, 10.0f, "%.5f"))
     {
-        actor->applyNodeBeamScales();
+        actor->applyBeamGroupScale(actor->ar_nb_wheel_beams, actor->ar_nb_wheels_scale);
     }
     ImGui::Separator();
     ImGui::Spacing();
@@ -110,6 +110,11 @@ static size_t CurlOgreDataStreamWriteFunc(char* data_ptr, size_t _unused, size_t
     }
 }
 
+static size_t CurlFileWriteFunc(char* data_ptr, size_t size, size_t nmemb, void* userdata)
+{
+    return fwrite(data_ptr, size, nmemb, static_cast<FILE*>(userdata));
+}
+
 std::vector<GUI::ResourceCategories> GetResourceCategories(std::string portal_url)
 {
     std::string repolist_url = portal_url + "/resource-categories";
@@ -167,6 +172,10 @@ std::vector<GUI::ResourceCategories> GetResourceCategories(std::string portal_ur
 
 void GetResources(std::string portal_url)
 {
+    // Fetch categories in parallel - on high-latency links the round trips dominate.
+    std::future<std::vector<GUI::ResourceCategories>> categories =
+        std::async(std::launch::async, GetResourceCategories, portal_url);
+
     std::string repolist_url = portal_url + "/resources";
     std::string response_payload;
     std::string response_header;
@@ -247,7 +256,7 @@ void GetResources(std::string portal_url)
     }
 
     cdata_ptr->items = resc;
-    cdata_ptr->categories = GetResourceCategories(portal_url);
+    cdata_ptr->categories = categories.get();
 
     App::GetGameContext()->PushMessage(
             Message(MSG_NET_REFRESH_REPOLIST_SUCCESS, (void*)cdata_ptr));
@@ -327,27 +336,47 @@ void DownloadResourceFile(int resource_id, std::string filename, int id)
     progress_context.filename = filename;
     long response_code = 0;
 
+    // Download into a '.part' file and rename it once complete - an interrupted
+    // download resumes where it stopped, and the mod cache never sees a truncated ZIP.
+    const std::string part_file = file + ".part";
+
     CURL *curl = curl_easy_init();
-    try // We write using Ogre::DataStream which throws exceptions
+    for (int attempt = 0; attempt < 2; attempt++)
     {
-        // smart pointer - closes stream automatically
-        Ogre::DataStreamPtr datastream = Ogre::ResourceGroupManager::getSingleton().createResource(file, RGN_REPO);
+        curl_off_t resume_from = static_cast<curl_off_t>(GetFileSizeBytes(part_file));
+        FILE* f = fopen(part_file.c_str(), "ab");
+        if (f == nullptr)
+        {
+            App::GetConsole()->putMessage(
+                Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR,
+                fmt::format("Repository UI: cannot write file '{}'", part_file));
+            break;
+        }
 
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
         curl_easy_setopt(curl, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
 #ifdef _WIN32
         curl_easy_setopt(curl, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
 #endif // _WIN32
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlOgreDataStreamWriteFunc);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, datastream.get());
+        curl_easy_setopt(curl, CURLOPT_RESUME_FROM_LARGE, resume_from);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CurlFileWriteFunc);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, f);
         curl_easy_setopt(curl, CURLOPT_NOPROGRESS, NULL); // Disable Internal CURL progressmeter
         curl_easy_setopt(curl, CURLOPT_PROGRESSDATA, &progress_context);
         curl_easy_setopt(curl, CURLOPT_PROGRESSFUNCTION, CurlProgressFunc); // Use our progress window
-        
+
         CURLcode curl_result = curl_easy_perform(curl);
         curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
+        fclose(f);
 
-        if (curl_result != CURLE_OK || response_code != 200)
+        if (curl_result == CURLE_OK && response_code == 200 && resume_from > 0)
+        {
+            // Server ignored the range request and sent the whole file after our partial data - start over.
+            std::remove(part_file.c_str());
+            continue;
+        }
+
+        if (curl_result != CURLE_OK || (response_code != 200 && response_code != 206))
         {
             Ogre::LogManager::getSingleton().stream()
                 << "[RoR|Repository] Failed to download resource;"
@@ -355,13 +384,12 @@ void DownloadResourceFile(int resource_id, std::string filename, int id)
 
             // FIXME: we need a FAILURE message for MSG_GUI_DOWNLOAD_FINISHED
         }
-    }
-    catch (Ogre::Exception& oex)
-    {
-        App::GetConsole()->putMessage(
-            Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR,
-            fmt::format("Repository UI: cannot download file '{}' - {}",
-                url, oex.getFullDescription()));
+        else
+        {
+            std::remove(file.c_str()); // `rename()` doesn't overwrite on Windows
+            std::rename(part_file.c_str(), file.c_str());
+        }
+        break;
     }
     curl_easy_cleanup(curl);
     curl = nullptr;
@@ -1329,6 +1357,15 @@ Ogre::WorkQueue::Response* RepositorySelector::handleRequest(const Ogre::WorkQue
     // Purpose: to fetch one thumbnail image using CURL.
     // -----------------------------------------------------------------------
 
+    // One handle per worker thread: thumbnails download in parallel and each
+    // thread reuses its connection. Cleaned up at thread exit.
+    struct ThreadCurl
+    {
+        CURL* handle = curl_easy_init();
+        ~ThreadCurl() { curl_easy_cleanup(handle); }
+    };
+    static thread_local ThreadCurl curl_th;
+
     int item_idx = Ogre::any_cast<int>(req->getData());
     std::string filename = std::to_string(m_data.items[item_idx].resource_id) + ".png";
     std::string file = PathCombine(App::sys_thumbnails_dir->getStr(), filename);
@@ -1345,14 +1382,15 @@ Ogre::WorkQueue::Response* RepositorySelector::handleRequest(const Ogre::WorkQue
             // smart pointer - closes stream automatically
             Ogre::DataStreamPtr datastream = Ogre::ResourceGroupManager::getSingleton().createResource(filename, RGN_REPO);
 
-            curl_easy_setopt(curl_th, CURLOPT_URL, m_data.items[item_idx].icon_url.c_str());
-            curl_easy_setopt(curl_th, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
+            curl_easy_setopt(curl_th.handle, CURLOPT_URL, m_data.items[item_idx].icon_url.c_str());
+            curl_easy_setopt(curl_th.handle, CURLOPT_IPRESOLVE, CURL_IPRESOLVE_V4);
 #ifdef _WIN32
-            curl_easy_setopt(curl_th, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
+            curl_easy_setopt(curl_th.handle, CURLOPT_SSL_OPTIONS, CURLSSLOPT_NATIVE_CA);
 #endif // _WIN32
-            curl_easy_setopt(curl_th, CURLOPT_WRITEFUNCTION, CurlOgreDataStreamWriteFunc);
-            curl_easy_setopt(curl_th, CURLOPT_WRITEDATA, datastream.get());
-            CURLcode curl_result = curl_easy_perform(curl_th);
+            curl_easy_setopt(curl_th.handle, CURLOPT_WRITEFUNCTION, CurlOgreDataStreamWriteFunc);
+            curl_easy_setopt(curl_th.handle, CURLOPT_WRITEDATA, datastream.get());
+            CURLcode curl_result = curl_easy_perform(curl_th.handle);
+            curl_easy_getinfo(curl_th.handle, CURLINFO_RESPONSE_CODE, &response_code);
 
             if (curl_result != CURLE_OK || response_code != 200)
             {
@@ -1360,6 +1398,10 @@ Ogre::WorkQueue::Response* RepositorySelector::handleRequest(const Ogre::WorkQue
                     << "[RoR|Repository] Failed to download thumbnail;"
                     << " Error: '" << curl_easy_strerror(curl_result) << "'; HTTP status code: " << response_code;
 
+                // Don't leave a broken file behind - it would be treated as cached forever.
+                datastream->close();
+                Ogre::ResourceGroupManager::getSingleton().deleteResource(filename, RGN_REPO);
+
                 return OGRE_NEW Ogre::WorkQueue::Response(req, /*success:*/false, Ogre::Any(item_idx));
             }
             else
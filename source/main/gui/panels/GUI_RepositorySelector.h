@@ -126,9 +126,6 @@ private:
     ResourceItem                        m_selected_item;
     Ogre::uint16                        m_ogre_workqueue_channel = 0;
     Ogre::TexturePtr                    m_fallback_thumbnail;
-#ifdef USE_CURL
-    CURL                                *curl_th = curl_easy_init(); // One connection for fetching thumbnails using connection reuse
-#endif
 
     // status or error messages
     std::string                         m_repofiles_msg;
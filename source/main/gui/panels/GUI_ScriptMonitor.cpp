@@ -32,10 +32,11 @@ using namespace Ogre;
 void ScriptMonitor::Draw()
 {
     // Table setup
-    ImGui::Columns(3);
+    ImGui::Columns(4);
     ImGui::SetColumnWidth(0, 25);
     ImGui::SetColumnWidth(1, 200);
     ImGui::SetColumnWidth(2, 200);
+    ImGui::SetColumnWidth(3, 120);
 
     // Header
     ImGui::TextDisabled(_LC("ScriptMonitor", "ID"));
@@ -43,6 +44,8 @@ void ScriptMonitor::Draw()
     ImGui::TextDisabled(_LC("ScriptMonitor", "File name"));
     ImGui::NextColumn();
     ImGui::TextDisabled(_LC("ScriptMonitor", "Options"));
+    ImGui::NextColumn();
+    ImGui::TextDisabled(_LC("ScriptMonitor", "Time"));
     
     this->DrawCommentedSeparator(_LC("ScriptMonitor", "Active"));
 
@@ -78,6 +81,7 @@ void ScriptMonitor::Draw()
                 LoadScriptRequest* req = new LoadScriptRequest();
                 req->lsr_category = unit.scriptCategory;
                 req->lsr_filename = unit.scriptName;
+                req->lsr_worker_lane = unit.workerLane;
                 App::GetGameContext()->ChainMessage(Message(MSG_APP_LOAD_SCRIPT_REQUESTED, req));
             }
             ImGui::SameLine();
@@ -99,6 +103,23 @@ void ScriptMonitor::Draw()
         }
         default:;
         }
+        ImGui::NextColumn();
+        ImGui::AlignTextToFramePadding();
+        ImGui::Text("%.2f ms", unit.frameTimeMs);
+        if (unit.workerLane)
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("%s", _LC("ScriptMonitor", "(worker)"));
+        }
+        if (unit.frameStepSuspendCount > 0)
+        {
+            ImGui::SameLine();
+            ImGui::TextDisabled("(%d %s)", unit.frameStepSuspendCount, _LC("ScriptMonitor", "suspended"));
+            if (ImGui::IsItemHovered())
+            {
+                ImGui::SetTooltip("%s", _LC("ScriptMonitor", "Times frameStep() ran over 'app_script_frame_budget_ms' and was resumed next frame."));
+            }
+        }
 
         ImGui::PopID(); // ScriptUnitId_t id
     }
@@ -151,6 +172,7 @@ void ScriptMonitor::Draw()
                 {
                     CvarRemoveFileFromList(App::app_recent_scripts, filename);
                 }
+                ImGui::NextColumn(); // skip "Time"
 
                 ImGui::PopID(); // filename.c_str()
             }
@@ -174,4 +196,5 @@ void ScriptMonitor::DrawCommentedSeparator(const char* text)
     drawlist->AddRectFilled(pos, rect_max, ImColor(ImGui::GetStyle().Colors[ImGuiCol_PopupBg]), ImGui::GetStyle().WindowRounding);
     drawlist->AddText(pos + padding, ImColor(ImGui::GetStyle().Colors[ImGuiCol_TextDisabled]), text);
     ImGui::NextColumn(); // skip Name column
+    ImGui::NextColumn(); // skip Options column
 }
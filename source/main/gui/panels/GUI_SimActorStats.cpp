@@ -99,6 +99,13 @@ void SimActorStats::Draw(RoR::GfxActor* actorx)
     ImGui::SameLine();
     ImGui::Text("%8.2f Kg (%.2f tons)", m_stat_mass_Kg, m_stat_mass_Kg / 1000.0f);
 
+    ImGui::TextColored(theme.value_blue_text_color,"%s", _LC("SimActorStats", "Memory: "));
+    ImGui::SameLine();
+    ImGui::Text("%.2f MiB", m_stat_memory.GetTotal() / 1048576.f);
+    ImGui::Text("  sim %.0f KiB, replay %.0f KiB, flexbodies %.0f KiB, meshes %.0f KiB",
+        m_stat_memory.amu_simulation / 1024.f, m_stat_memory.amu_replay / 1024.f,
+        m_stat_memory.amu_flexbodies / 1024.f, m_stat_memory.amu_meshes / 1024.f);
+
     ImGui::NewLine();
 
     const float n0_velo_len   = actorx->GetSimDataBuffer().simbuf_node0_velo.length();
@@ -225,8 +232,25 @@ void SimActorStats::Draw(RoR::GfxActor* actorx)
     ImGui::PopStyleColor(1); // WindowBg
 }
 
+static const float BEAM_STATS_INTERVAL = 0.25f; // Seconds; the beam walk is the costly part, and its numbers change slowly
+
 void SimActorStats::UpdateStats(float dt, ActorPtr actor)
 {
+    Ogre::Vector3 gcur = actor->getGForces();
+    Ogre::Vector3 gmax = actor->getMaxGForces();
+    m_stat_gcur_x = gcur.x;
+    m_stat_gcur_y = gcur.y;
+    m_stat_gcur_z = gcur.z;
+    m_stat_gmax_x = gmax.x;
+    m_stat_gmax_y = gmax.y;
+    m_stat_gmax_z = gmax.z;
+
+    m_beam_stats_timer -= dt;
+    if (actor->ar_instance_id == m_beam_stats_actor && m_beam_stats_timer > 0.f)
+        return;
+    m_beam_stats_actor = actor->ar_instance_id;
+    m_beam_stats_timer = BEAM_STATS_INTERVAL;
+
     //taken from TruckHUD.cpp (now removed)
     beam_t* beam = actor->ar_beams;
     float average_deformation = 0.0f;
@@ -234,8 +258,6 @@ void SimActorStats::UpdateStats(float dt, ActorPtr actor)
     float mass = actor->getTotalMass();
     int beambroken = 0;
     int beamdeformed = 0;
-    Ogre::Vector3 gcur = actor->getGForces();
-    Ogre::Vector3 gmax = actor->getMaxGForces();
 
     for (int i = 0; i < actor->ar_num_beams; i++ , beam++)
     {
@@ -258,10 +280,5 @@ void SimActorStats::UpdateStats(float dt, ActorPtr actor)
     m_stat_beam_stress = beamstress;
     m_stat_mass_Kg = mass;
     m_stat_avg_deform = average_deformation;
-    m_stat_gcur_x = gcur.x;
-    m_stat_gcur_y = gcur.y;
-    m_stat_gcur_z = gcur.z;
-    m_stat_gmax_x = gmax.x;
-    m_stat_gmax_y = gmax.y;
-    m_stat_gmax_z = gmax.z;
+    m_stat_memory = actor->GetMemoryUsage();
 }
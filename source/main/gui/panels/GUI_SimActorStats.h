@@ -26,6 +26,7 @@
 #pragma once
 
 #include "ForwardDeclarations.h"
+#include "SimData.h"
 
 namespace RoR {
 namespace GUI {
@@ -53,6 +54,9 @@ private:
     float m_stat_gmax_x         = 0.f;
     float m_stat_gmax_y         = 0.f;
     float m_stat_gmax_z         = 0.f;
+    ActorMemoryUsage m_stat_memory;
+    float m_beam_stats_timer    = 0.f; //!< Until the next walk over all beams
+    ActorInstanceID_t m_beam_stats_actor = ACTORINSTANCEID_INVALID;
 };
 
 } // namespace GUI
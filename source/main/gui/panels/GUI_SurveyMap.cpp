@@ -24,6 +24,7 @@
 
 #include "AppContext.h"
 #include "Actor.h"
+#include "CacheSystem.h"
 #include "ContentManager.h"
 #include "GameContext.h"
 #include "GfxActor.h"
@@ -34,10 +35,15 @@
 #include "InputEngine.h"
 #include "Language.h"
 #include "OgreImGui.h"
+#include "PlatformUtils.h"
 #include "SurveyMapTextureCreator.h"
 #include "Terrain.h"
 #include "TerrainObjectManager.h"
+#include "ThreadPool.h"
 #include "Collisions.h"
+#include "Utils.h"
+
+#include <algorithm>
 
 using namespace RoR;
 using namespace GUI;
@@ -302,10 +308,10 @@ void SurveyMap::Draw()
 
             if ((visible) && (!App::gfx_declutter_map->getBool()))
             {
-                this->CacheMapIcon(e);
                 this->DrawMapIcon(e, tl_screen_pos, view_size, view_origin);
             }
         }
+        this->FlushMapIcons(); // Keep vehicles and characters on top
 
         // Draw actor icons
         for (GfxActor* gfx_actor: App::GetGfxScene()->GetGfxActors())
@@ -337,8 +343,6 @@ void SurveyMap::Draw()
                 e.draw_caption = true;
             }
 
-            // Cache and draw icon
-            this->CacheMapIcon(e);
             this->DrawMapIcon(e, tl_screen_pos, view_size, view_origin);
         }
 
@@ -363,11 +367,10 @@ void SurveyMap::Draw()
                     e.draw_caption = true;
                 }
 
-                // Cache and draw icon
-                this->CacheMapIcon(e);
                 this->DrawMapIcon(e, tl_screen_pos, view_size, view_origin);
             }
         }
+        this->FlushMapIcons();
     }
     ImGui::EndChild();
 
@@ -464,14 +467,51 @@ void SurveyMap::CreateTerrainTextures()
     mTerrainSize = Vector2(terrain_size.x, terrain_size.z);
     Ogre::Vector2 mMapCenter = mTerrainSize / 2;
 
+    // The rendered texture is cached per terrain, rendering it stalls the loading
+    const int res = 4096;
+    const CacheEntry* terrn_entry = App::GetGameContext()->GetTerrain()->getCacheEntry();
+    const std::string cache_key = fmt::format("{}|{}|{}|{}|{}|{}|{}|{}", terrn_entry->fname, terrn_entry->filetime, res,
+        mMapCenterOffset.x, mMapCenterOffset.y, mTerrainSize.x, mTerrainSize.y, terrain_size.y);
+    const std::string cache_filename = fmt::format("surveymap_{}.png", HashData(cache_key.c_str(), (int)cache_key.length()));
+    const std::string resource_group = App::GetGameContext()->GetTerrain()->getTerrainFileResourceGroup();
+    if (Ogre::ResourceGroupManager::getSingleton().resourceExists(RGN_CACHE, cache_filename))
+    {
+        try
+        {
+            Ogre::Image img;
+            img.load(cache_filename, RGN_CACHE);
+            mMapTexture = Ogre::TextureManager::getSingleton().loadImage("SurveyMapStatic", resource_group, img);
+            return;
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG(fmt::format("[RoR|SurveyMap] Cannot load cached map '{}', rendering it again. Message: {}", cache_filename, e.getFullDescription()));
+        }
+    }
+
     ConfigOptionMap ropts = App::GetAppContext()->GetOgreRoot()->getRenderSystem()->getConfigOptions();
     int fsaa = StringConverter::parseInt(ropts["FSAA"].currentValue, 0);
 
     SurveyMapTextureCreator texCreatorStatic(terrain_size.y);
-    texCreatorStatic.init(4096, fsaa);
+    texCreatorStatic.init(res, fsaa);
     texCreatorStatic.update(mMapCenter + mMapCenterOffset, mTerrainSize);
-    mMapTexture = texCreatorStatic.convertTextureToStatic(
-        "SurveyMapStatic", App::GetGameContext()->GetTerrain()->getTerrainFileResourceGroup());
+    std::shared_ptr<Ogre::Image> img = std::make_shared<Ogre::Image>();
+    texCreatorStatic.convertToImage(*img);
+    mMapTexture = Ogre::TextureManager::getSingleton().loadImage("SurveyMapStatic", resource_group, *img);
+
+    // Compressing the image takes a while, don't wait for it
+    const std::string cache_path = PathCombine(App::sys_cache_dir->getStr(), cache_filename);
+    App::GetThreadPool()->RunTask([img, cache_path]()
+    {
+        try
+        {
+            img->save(cache_path);
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG(fmt::format("[RoR|SurveyMap] Cannot save map to cache '{}'. Message: {}", cache_path, e.getFullDescription()));
+        }
+    }, TaskPriority::BACKGROUND);
 }
 
 
@@ -546,7 +586,9 @@ void SurveyMap::ToggleMode()
     mMapMode = (mMapMode == SurveyMapMode::NONE) ? mMapLastMode : SurveyMapMode::NONE;
 }
 
-void SurveyMap::DrawMapIcon(const SurveyMapEntity& e, ImVec2 view_pos, ImVec2 view_size, Ogre::Vector2 view_origin)
+static const float MAP_ICON_CULL_MARGIN = 32.f; // Pixels; icons are small, a bit past the edge may still show
+
+void SurveyMap::DrawMapIcon(SurveyMapEntity& e, ImVec2 view_pos, ImVec2 view_size, Ogre::Vector2 view_origin)
 {
     Ogre::Vector2 terrn_size_adj = mTerrainSize;
     if (mMapMode == SurveyMapMode::SMALL)
@@ -559,22 +601,30 @@ void SurveyMap::DrawMapIcon(const SurveyMapEntity& e, ImVec2 view_pos, ImVec2 vi
     img_pos.y = view_pos.y + ((e.pos.z - view_origin.y) / terrn_size_adj.y) * view_size.y;
     float img_dist = (img_pos.x - m_circle_center.x) * (img_pos.x - m_circle_center.x) + (img_pos.y - m_circle_center.y) * (img_pos.y - m_circle_center.y);
 
-    if (!e.cached_icon
-        || (mMapMode == SurveyMapMode::SMALL && img_dist > (m_circle_radius * m_circle_radius)*0.8))
+    // Cull first, so that icons off the map aren't even looked up
+    if (img_pos.x < view_pos.x - MAP_ICON_CULL_MARGIN || img_pos.x > view_pos.x + view_size.x + MAP_ICON_CULL_MARGIN ||
+        img_pos.y < view_pos.y - MAP_ICON_CULL_MARGIN || img_pos.y > view_pos.y + view_size.y + MAP_ICON_CULL_MARGIN ||
+        (mMapMode == SurveyMapMode::SMALL && img_dist > (m_circle_radius * m_circle_radius)*0.8))
     {
         return;
     }
 
-    DrawImageRotated(reinterpret_cast<ImTextureID>(e.cached_icon->getHandle()), img_pos,
-        ImVec2(e.cached_icon->getWidth(), e.cached_icon->getHeight()), e.rot_angle.valueRadians());
-
-    if (e.draw_caption)
+    this->CacheMapIcon(e);
+    if (!e.cached_icon)
     {
-        ImVec2 text_pos(img_pos.x - (ImGui::CalcTextSize(e.caption.c_str()).x/2), img_pos.y + 5);
-        ImVec4 text_color(e.caption_color.r, e.caption_color.g, e.caption_color.b, 1.f);
-        ImGui::GetWindowDrawList()->AddText(text_pos, ImColor(text_color), e.caption.c_str());
+        return;
     }
-    else
+
+    MapIconDraw icon;
+    icon.tex_id = reinterpret_cast<ImTextureID>(e.cached_icon->getHandle());
+    icon.pos = img_pos;
+    icon.size = ImVec2(e.cached_icon->getWidth(), e.cached_icon->getHeight());
+    icon.angle = e.rot_angle.valueRadians();
+    icon.caption = (e.draw_caption) ? e.caption.c_str() : nullptr;
+    icon.caption_color = ImColor(ImVec4(e.caption_color.r, e.caption_color.g, e.caption_color.b, 1.f));
+    m_icon_draws.push_back(icon);
+
+    if (!e.draw_caption)
     {
         ImVec2 dist = ImGui::GetMousePos() - img_pos;
         if (!e.caption.empty() && abs(dist.x) <= 5 && abs(dist.y) <= 5)
@@ -665,6 +715,29 @@ ImVec2 SurveyMap::CalcWaypointMapPos(ImVec2 view_pos, ImVec2 view_size, Ogre::Ve
     return ImGui::GetMousePos() - pos;
 }
 
+void SurveyMap::FlushMapIcons()
+{
+    // ImGui merges consecutive draws with the same texture into one draw call;
+    // grouping the icons by texture turns one call per icon into about one per icon type.
+    std::stable_sort(m_icon_draws.begin(), m_icon_draws.end(),
+        [](MapIconDraw const& a, MapIconDraw const& b) { return a.tex_id < b.tex_id; });
+    for (MapIconDraw const& icon: m_icon_draws)
+    {
+        DrawImageRotated(icon.tex_id, icon.pos, icon.size, icon.angle);
+    }
+
+    // Captions all use the font texture, so they go after the icons
+    for (MapIconDraw const& icon: m_icon_draws)
+    {
+        if (icon.caption)
+        {
+            ImVec2 text_pos(icon.pos.x - (ImGui::CalcTextSize(icon.caption).x/2), icon.pos.y + 5);
+            ImGui::GetWindowDrawList()->AddText(text_pos, icon.caption_color, icon.caption);
+        }
+    }
+    m_icon_draws.clear();
+}
+
 void SurveyMap::CacheIcons()
 {
     // Thanks WillM for the icons!
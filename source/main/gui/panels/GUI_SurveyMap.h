@@ -75,7 +75,8 @@ protected:
 
     void CacheMapIcon(SurveyMapEntity& e);
 
-    void DrawMapIcon(const SurveyMapEntity& e, ImVec2 view_pos, ImVec2 view_size, Ogre::Vector2 view_origin);
+    void DrawMapIcon(SurveyMapEntity& e, ImVec2 view_pos, ImVec2 view_size, Ogre::Vector2 view_origin); //!< Culls, caches and queues the icon
+    void FlushMapIcons(); //!< Draws queued icons grouped by texture, then their captions
 
     ImVec2 DrawWaypoint(ImVec2 view_pos, ImVec2 view_size, Ogre::Vector2 view_origin,
                      std::string const& caption, int idx);
@@ -103,6 +104,18 @@ protected:
     Ogre::TexturePtr m_right_mouse_button;
     void CacheIcons();
 
+    // Icons queued by `DrawMapIcon()`
+    struct MapIconDraw
+    {
+        ImTextureID tex_id;
+        ImVec2      pos;
+        ImVec2      size;
+        float       angle;
+        const char* caption; //!< Points into the entity; nullptr = no caption under the icon
+        ImU32       caption_color;
+    };
+    std::vector<MapIconDraw> m_icon_draws;
+
     // Circular minimap
     ImVec2 m_circle_center;
     float m_circle_radius = 0.f;
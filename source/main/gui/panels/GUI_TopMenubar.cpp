@@ -647,6 +647,15 @@ void TopMenubar::Update()
                 m_open_menu = TopMenu::TOPMENU_NONE;
             }
 
+            if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
+            {
+                if (ImGui::Button(_LC("TopMenubar", "Network traffic")))
+                {
+                    App::GetGuiManager()->NetworkTraffic.SetVisible(true);
+                    m_open_menu = TopMenu::TOPMENU_NONE;
+                }
+            }
+
             if (current_actor != nullptr)
             {
                 if (ImGui::Button(_LC("TopMenubar", "Node / Beam utility")))
@@ -789,6 +798,7 @@ void TopMenubar::Update()
                     DrawGCheckbox(App::diag_hide_beam_stress,    _LC("TopMenubar", "Hide beam stress"));
                     DrawGCheckbox(App::diag_hide_wheels,         _LC("TopMenubar", "Hide wheels"));
                     DrawGCheckbox(App::diag_hide_nodes,          _LC("TopMenubar", "Hide nodes"));
+                    DrawGCheckbox(App::diag_declutter_labels,    _LC("TopMenubar", "Declutter labels"));
                     if (debug_view_type >= 2)
                     {
                         DrawGCheckbox(App::diag_hide_wheel_info, _LC("TopMenubar", "Hide wheel info"));
@@ -54,6 +54,11 @@ void VehicleButtons::Draw(RoR::GfxActor* actorx)
         this->CacheIcons();
     }
 
+    if (actorx && actorx->GetActor()->ar_instance_id != m_features_actor)
+    {
+        this->CacheActorFeatures(actorx);
+    }
+
     bool is_visible = false;
 
     // Show only once for 5 sec, with a notice
@@ -141,16 +146,49 @@ void VehicleButtons::Draw(RoR::GfxActor* actorx)
     ImGui::PopStyleColor(1); // WindowBg
 }
 
-void VehicleButtons::DrawHeadLightButton(RoR::GfxActor* actorx)
+void VehicleButtons::CacheActorFeatures(RoR::GfxActor* actorx)
 {
-    bool has_headlight = false;
-    for (int i = 0; i < actorx->GetActor()->ar_flares.size(); i++)
+    // The buttons only need to know what the actor has, which doesn't change after spawn
+    ActorPtr actor = actorx->GetActor();
+    m_features_actor = actor->ar_instance_id;
+
+    m_has_headlight = false;
+    m_has_left_blinker = false;
+    m_has_right_blinker = false;
+    for (int i = 0; i < actor->ar_flares.size(); i++)
     {
-        if (actorx->GetActor()->ar_flares[i].fl_type == FlareType::HEADLIGHT || actorx->GetActor()->ar_flares[i].fl_type == FlareType::TAIL_LIGHT)
+        const FlareType type = actor->ar_flares[i].fl_type;
+        m_has_headlight |= (type == FlareType::HEADLIGHT || type == FlareType::TAIL_LIGHT);
+        m_has_left_blinker |= (type == FlareType::BLINKER_LEFT);
+        m_has_right_blinker |= (type == FlareType::BLINKER_RIGHT);
+    }
+
+    m_has_beacon = false;
+    for (Prop& prop: actorx->getProps())
+    {
+        m_has_beacon |= (prop.pp_beacon_type != 0);
+    }
+
+    m_has_custom_light.resize(MAX_CLIGHTS);
+    for (int i = 0; i < MAX_CLIGHTS; i++)
+    {
+        m_has_custom_light[i] = (actor->countCustomLights(i) > 0);
+    }
+
+    if (m_command_event_ids.empty())
+    {
+        // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
+        m_command_event_ids.resize(MAX_COMMANDS + 1, -1);
+        for (int i = 1; i <= MAX_COMMANDS; i++)
         {
-            has_headlight = true;
+            m_command_event_ids[i] = RoR::InputEngine::resolveEventName(fmt::format("COMMANDS_{:02d}", i));
         }
     }
+}
+
+void VehicleButtons::DrawHeadLightButton(RoR::GfxActor* actorx)
+{
+    const bool has_headlight = m_has_headlight;
 
     if (!has_headlight)
     {
@@ -191,14 +229,7 @@ void VehicleButtons::DrawHeadLightButton(RoR::GfxActor* actorx)
 
 void VehicleButtons::DrawLeftBlinkerButton(RoR::GfxActor* actorx)
 {
-    bool has_blink = false;
-    for (int i = 0; i < actorx->GetActor()->ar_flares.size(); i++)
-    {
-        if (actorx->GetActor()->ar_flares[i].fl_type == FlareType::BLINKER_LEFT)
-        {
-            has_blink = true;
-        }
-    }
+    const bool has_blink = m_has_left_blinker;
 
     if (!has_blink)
     {
@@ -239,14 +270,7 @@ void VehicleButtons::DrawLeftBlinkerButton(RoR::GfxActor* actorx)
 
 void VehicleButtons::DrawRightBlinkerButton(RoR::GfxActor* actorx)
 {
-    bool has_blink = false;
-    for (int i = 0; i < actorx->GetActor()->ar_flares.size(); i++)
-    {
-        if (actorx->GetActor()->ar_flares[i].fl_type == FlareType::BLINKER_RIGHT)
-        {
-            has_blink = true;
-        }
-    }
+    const bool has_blink = m_has_right_blinker;
 
     if (!has_blink)
     {
@@ -287,14 +311,7 @@ void VehicleButtons::DrawRightBlinkerButton(RoR::GfxActor* actorx)
 
 void VehicleButtons::DrawWarnBlinkerButton(RoR::GfxActor* actorx)
 {
-    bool has_blink = false;
-    for (int i = 0; i < actorx->GetActor()->ar_flares.size(); i++)
-    {
-        if (actorx->GetActor()->ar_flares[i].fl_type == FlareType::BLINKER_LEFT)
-        {
-            has_blink = true;
-        }
-    }
+    const bool has_blink = m_has_left_blinker;
 
     if (!has_blink)
     {
@@ -846,14 +863,7 @@ void VehicleButtons::DrawParticlesButton(RoR::GfxActor* actorx)
 
 void VehicleButtons::DrawBeaconButton(RoR::GfxActor* actorx)
 {
-    bool has_beacon = false;
-    for (Prop& prop: actorx->getProps())
-    {
-        if (prop.pp_beacon_type != 0)
-        {
-            has_beacon = true;
-        }
-    }
+    const bool has_beacon = m_has_beacon;
 
     if (!has_beacon)
     {
@@ -1039,7 +1049,7 @@ void VehicleButtons::DrawCustomLightButton(RoR::GfxActor* actorx)
 
     for (int i = 0; i < MAX_CLIGHTS; i++)
     {
-        if (actorx->GetActor()->countCustomLights(i) > 0)
+        if (m_has_custom_light[i])
         {
             ImGui::PushID(i);
             num_custom_flares++;
@@ -1096,7 +1106,7 @@ void VehicleButtons::DrawCommandButton(RoR::GfxActor* actorx)
         ImGui::PushID(i);
 
         std::string label = "C" + std::to_string(i);
-        int eventID = RoR::InputEngine::resolveEventName(fmt::format("COMMANDS_{:02d}", i));
+        const int eventID = m_command_event_ids[i];
 
         if (actorx->GetActor()->ar_command_key[i].playerInputValue != 0.0f)
         {
@@ -37,7 +37,7 @@ class VehicleButtons
 public:
     void Draw(RoR::GfxActor* actorx);
     bool GetHornButtonState() { return m_horn; }
-    std::vector<int> GetCommandEventID() { return m_id; }
+    std::vector<int> const& GetCommandEventID() const { return m_id; } //!< Indexed 1-MAX_COMMANDS like the commandkeys; -1 = button not held
 
 private:
     void DrawHeadLightButton(RoR::GfxActor* actorx);
@@ -67,11 +67,21 @@ private:
     void DrawCruiseControlButton(RoR::GfxActor* actorx);
     void DrawCameraButton();
     void CacheIcons();
+    void CacheActorFeatures(RoR::GfxActor* actorx);
     bool m_horn = false;
     std::vector<int> m_id;
     Ogre::Timer m_timer;
     bool m_init = false;
 
+    // Actor feature cache, see `CacheActorFeatures()`
+    ActorInstanceID_t m_features_actor = ACTORINSTANCEID_INVALID;
+    bool m_has_headlight = false;
+    bool m_has_left_blinker = false;
+    bool m_has_right_blinker = false;
+    bool m_has_beacon = false;
+    std::vector<bool> m_has_custom_light;
+    std::vector<int> m_command_event_ids; //!< Indexed 1-MAX_COMMANDS like the commandkeys
+
     // Icon cache
     bool m_icons_cached = false;
     Ogre::TexturePtr m_headlight_icon;
@@ -30,6 +30,7 @@
 #include "ContentManager.h"
 #include "DiscordRpc.h"
 #include "ErrorUtils.h"
+#include "FrameArena.h"
 #include "GameContext.h"
 #include "GfxScene.h"
 #include "GUI_DirectionArrow.h"
@@ -45,13 +46,18 @@
 #include "GUIManager.h"
 #include "GUIUtils.h"
 #include "InputEngine.h"
+#include "InputRecorder.h"
 #include "Language.h"
 #include "MumbleIntegration.h"
+#include "OgreImGui.h"
 #include "OutGauge.h"
 #include "OverlayWrapper.h"
 #include "PlatformUtils.h"
 #include "RoRVersion.h"
 #include "ScriptEngine.h"
+#include "ShaderCache.h"
+#include "SimBenchmark.h"
+#include "SimProfiler.h"
 #include "Skidmark.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
@@ -60,12 +66,59 @@
 #include <ctime>
 #include <iomanip>
 #include <string>
+#include <sstream>
 #include <fstream>
+#include <thread>
 
 #ifdef USE_CURL
 #   include <curl/curl.h>
 #endif //USE_CURL
 
+/// Times a startup phase: logs how long it took and records it as a profiler zone (see cvar 'diag_startup_profile').
+class StartupPhase
+{
+public:
+    StartupPhase(const char* name): m_name(name), m_zone(name, -1), m_begin_us(RoR::SimProfiler::GetTimestampUs()) {}
+
+    ~StartupPhase()
+    {
+        RoR::LogFormat("[RoR|Startup] %s took %.1f ms", m_name, (RoR::SimProfiler::GetTimestampUs() - m_begin_us) / 1000.f);
+    }
+
+private:
+    const char*          m_name; //!< Must be a string literal.
+    RoR::SimProfilerZone m_zone;
+    int64_t              m_begin_us;
+};
+
+/// Called once the main menu was rendered for the first time.
+static void FinishStartup(int64_t startup_begin_us)
+{
+    using namespace RoR;
+
+    LogFormat("[RoR|Startup] Startup finished in %.1f ms", (SimProfiler::GetTimestampUs() - startup_begin_us) / 1000.f);
+
+    if (!SimProfiler::IsCapturing() || !App::diag_startup_profile->getBool())
+        return;
+
+    const std::time_t time = std::time(nullptr);
+    std::stringstream filename;
+    filename << "startup_" << std::put_time(std::localtime(&time), "%Y-%m-%d_%H-%M-%S") << ".json";
+    CreateFolder(App::sys_profiler_dir->getStr());
+    const std::string path = PathCombine(App::sys_profiler_dir->getStr(), filename.str());
+
+    std::string summary;
+    if (SimProfiler::StopCapture(path, summary))
+    {
+        LOG("[RoR|Startup] Startup trace saved to " + path);
+    }
+    else
+    {
+        LOG("[RoR|Startup] Could not write startup trace " + path);
+    }
+    LOG(summary);
+}
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -74,6 +127,8 @@ int main(int argc, char *argv[])
 {
     using namespace RoR;
 
+    const int64_t startup_begin_us = SimProfiler::GetTimestampUs();
+
 #ifdef USE_CURL
     curl_global_init(CURL_GLOBAL_ALL); // MUST init before any threads are started
 #endif
@@ -105,6 +160,7 @@ int main(int argc, char *argv[])
         App::sys_savegames_dir ->setStr(PathCombine(App::sys_user_dir->getStr(), "savegames"));
         App::sys_screenshot_dir->setStr(PathCombine(App::sys_user_dir->getStr(), "screenshots"));
         App::sys_scripts_dir   ->setStr(PathCombine(App::sys_user_dir->getStr(), "scripts"));
+        App::sys_profiler_dir  ->setStr(PathCombine(App::sys_user_dir->getStr(), "profiler"));
 
         // Load RoR.cfg - updates cvars
         App::GetConsole()->loadConfig();
@@ -123,6 +179,19 @@ int main(int argc, char *argv[])
             return 0;
         }
 
+        if (App::diag_startup_profile->getBool())
+        {
+            SimProfiler::StartCapture();
+        }
+
+        // Needs config (worker count); used for startup tasks which don't touch OGRE
+        App::CreateThreadPool();
+
+#ifdef USE_OPENAL
+        // Opening the audio device can take a while; overlap it with OGRE startup
+        App::CreateSoundManagerAsync();
+#endif // USE_OPENAL
+
         // Find resources dir, update cvar 'sys_resources_dir'
         if (!App::GetAppContext()->SetUpResourcesDir())
         {
@@ -133,17 +202,24 @@ int main(int argc, char *argv[])
         CreateFolder(App::sys_config_dir->getStr());
 
         // Load and start OGRE renderer, uses config directory
-        if (!App::GetAppContext()->SetUpRendering())
         {
-            return -1; // Error already displayed
+            StartupPhase phase("SetUpRendering");
+            if (!App::GetAppContext()->SetUpRendering())
+            {
+                return -1; // Error already displayed
+            }
+            ShaderCache::Load();
         }
 
         Ogre::TextureManager::getSingleton().setDefaultNumMipmaps(5);
 
         // Deploy base config files from 'skeleton.zip'
-        if (!App::GetAppContext()->SetUpConfigSkeleton())
         {
-            return -1; // Error already displayed
+            StartupPhase phase("SetUpConfigSkeleton");
+            if (!App::GetAppContext()->SetUpConfigSkeleton())
+            {
+                return -1; // Error already displayed
+            }
         }
 
         Ogre::OverlaySystem* overlay_system = new Ogre::OverlaySystem(); //Overlay init
@@ -171,47 +247,69 @@ int main(int argc, char *argv[])
             Ogre::TextureManager::getSingleton()._getWarningTexture()->getBuffer()->blitFromMemory(pixels);
         }
 
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FLAGS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FONTS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::ICONS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::OGRE_CORE);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::WALLPAPERS);
-        App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::SCRIPTS);
+        {
+            StartupPhase phase("AddResourcePacks");
+            App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FLAGS);
+            App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::FONTS);
+            App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::ICONS);
+            App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::OGRE_CORE);
+            App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::WALLPAPERS);
+            App::GetContentManager()->AddResourcePack(ContentManager::ResourcePack::SCRIPTS);
+        }
 
+        {
+            StartupPhase phase("SetUpLanguage");
 #ifndef NOLANG
-        App::GetLanguageEngine()->setup();
+            App::GetLanguageEngine()->setup();
 #endif // NOLANG
-        App::GetConsole()->regBuiltinCommands(); // Call after localization had been set up
+            App::GetConsole()->regBuiltinCommands(); // Call after localization had been set up
+        }
 
-        App::GetContentManager()->InitContentManager();
+        {
+            StartupPhase phase("InitContentManager"); // Waits for the audio device, see `CreateSoundManagerAsync()`
+            App::GetContentManager()->InitContentManager();
+        }
 
         // Set up rendering
-        App::CreateGfxScene(); // Creates OGRE SceneManager, needs content manager
-        App::GetGfxScene()->GetSceneManager()->addRenderQueueListener(overlay_system);
-        App::CreateCameraManager(); // Creates OGRE Camera
-        App::GetGfxScene()->GetEnvMap().SetupEnvMap(); // Needs camera
+        {
+            StartupPhase phase("CreateGfxScene");
+            App::CreateGfxScene(); // Creates OGRE SceneManager, needs content manager
+            App::GetGfxScene()->GetSceneManager()->addRenderQueueListener(overlay_system);
+            App::CreateCameraManager(); // Creates OGRE Camera
+            App::GetGfxScene()->GetEnvMap().SetupEnvMap(); // Needs camera
+        }
 
-        App::CreateGuiManager(); // Needs scene manager
+        {
+            StartupPhase phase("CreateGuiManager");
+            App::CreateGuiManager(); // Needs scene manager
+        }
 
         App::GetDiscordRpc()->Init();
 
-        App::GetAppContext()->SetUpInput();
+        {
+            StartupPhase phase("SetUpInput");
+            App::GetAppContext()->SetUpInput();
+        }
 
 #ifdef USE_ANGELSCRIPT
-        App::CreateScriptEngine();
-        if (!FolderExists(App::sys_scripts_dir->getStr()))
         {
-            CreateFolder(App::sys_scripts_dir->getStr());
+            StartupPhase phase("CreateScriptEngine");
+            App::CreateScriptEngine();
+            if (!FolderExists(App::sys_scripts_dir->getStr()))
+            {
+                CreateFolder(App::sys_scripts_dir->getStr());
+            }
         }
 #endif
 
-        App::GetGuiManager()->SetUpMenuWallpaper();
+        {
+            StartupPhase phase("SetUpMenuWallpaper");
+            App::GetGuiManager()->SetUpMenuWallpaper();
+        }
 
         // Add "this is obsolete" marker file to old config location
         App::GetAppContext()->SetUpObsoleteConfMarker();
 
-        App::CreateThreadPool();
-
         // Load inertia config file
         App::GetGameContext()->GetActorManager()->GetInertiaConfig().LoadDefaultInertiaModels();
 
@@ -230,24 +328,27 @@ int main(int argc, char *argv[])
         }
 
         // Load startup scripts (console, then RoR.cfg)
-        if (App::cli_custom_scripts->getStr() != "")
         {
-            Ogre::StringVector script_names = Ogre::StringUtil::split(App::cli_custom_scripts->getStr(), ",");
-            for (Ogre::String const& scriptname: script_names)
+            StartupPhase phase("LoadStartupScripts");
+            if (App::cli_custom_scripts->getStr() != "")
             {
-                LOG(fmt::format("Loading startup script '{}' (from command line)", scriptname));
-                App::GetScriptEngine()->loadScript(scriptname, ScriptCategory::CUSTOM);
-                // errors are logged by OGRE & AngelScript
+                Ogre::StringVector script_names = Ogre::StringUtil::split(App::cli_custom_scripts->getStr(), ",");
+                for (Ogre::String const& scriptname: script_names)
+                {
+                    LOG(fmt::format("Loading startup script '{}' (from command line)", scriptname));
+                    App::GetScriptEngine()->loadScript(scriptname, ScriptCategory::CUSTOM);
+                    // errors are logged by OGRE & AngelScript
+                }
             }
-        }
-        if (App::app_custom_scripts->getStr() != "")
-        {
-            Ogre::StringVector script_names = Ogre::StringUtil::split(App::app_custom_scripts->getStr(), ",");
-            for (Ogre::String const& scriptname: script_names)
+            if (App::app_custom_scripts->getStr() != "")
             {
-                LOG(fmt::format("Loading startup script '{}' (from config file)", scriptname));
-                App::GetScriptEngine()->loadScript(scriptname, ScriptCategory::CUSTOM);
-                // errors are logged by OGRE & AngelScript
+                Ogre::StringVector script_names = Ogre::StringUtil::split(App::app_custom_scripts->getStr(), ",");
+                for (Ogre::String const& scriptname: script_names)
+                {
+                    LOG(fmt::format("Loading startup script '{}' (from config file)", scriptname));
+                    App::GetScriptEngine()->loadScript(scriptname, ScriptCategory::CUSTOM);
+                    // errors are logged by OGRE & AngelScript
+                }
             }
         }
 
@@ -316,9 +417,12 @@ int main(int argc, char *argv[])
         // --------------------------------------------------------------
 
         auto start_time = std::chrono::high_resolution_clock::now();
+        bool startup_finished = false;
 
         while (App::app_state->getEnum<AppState>() != AppState::SHUTDOWN)
         {
+            FrameArena::Get().Reset(); // Frees last frame's transient containers
+
             OgreBites::WindowEventUtilities::messagePump();
 
             // Halt physics (wait for async tasks to finish)
@@ -343,6 +447,7 @@ int main(int argc, char *argv[])
                         App::GetGameContext()->SaveScene("autosave.sav");
                     }
                     App::GetConsole()->saveConfig(); // RoR.cfg
+                    ShaderCache::Save();
                     App::GetDiscordRpc()->Shutdown();
 #ifdef USE_SOCKETW
                     if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
@@ -375,6 +480,7 @@ int main(int argc, char *argv[])
                 case MSG_APP_MODCACHE_LOAD_REQUESTED:
                     if (!App::GetCacheSystem()) // If not already loaded...
                     {
+                        StartupPhase phase("LoadModCache");
                         App::GetGuiManager()->SetMouseCursorVisibility(GUIManager::MouseCursorVisibility::HIDDEN);
                         App::GetContentManager()->InitModCache(CacheValidity::UNKNOWN);
                     }
@@ -402,7 +508,7 @@ int main(int argc, char *argv[])
                 {
                     LoadScriptRequest* request = static_cast<LoadScriptRequest*>(m.payload);
                     ActorPtr actor = App::GetGameContext()->GetActorManager()->GetActorById(request->lsr_associated_actor);
-                    ScriptUnitId_t nid = App::GetScriptEngine()->loadScript(request->lsr_filename, request->lsr_category, actor, request->lsr_buffer);
+                    ScriptUnitId_t nid = App::GetScriptEngine()->loadScript(request->lsr_filename, request->lsr_category, actor, request->lsr_buffer, request->lsr_worker_lane);
                     // we want to notify any running scripts that we might change something (prevent cheating)
                     App::GetScriptEngine()->triggerEvent(SE_ANGELSCRIPT_MANIPULATIONS,
                         MANIP_SCRIPT_LOADED, nid, (int)request->lsr_category, 0, request->lsr_filename);
@@ -605,6 +711,7 @@ int main(int argc, char *argv[])
                         }
                         App::GetGfxScene()->GetSceneManager()->setAmbientLight(Ogre::ColourValue(0.3f, 0.3f, 0.3f));
                         App::GetDiscordRpc()->UpdatePresence();
+                        ShaderCache::Save(); // Don't lose the terrain's shaders if the game crashes later
                         App::sim_state->setVal((int)SimState::RUNNING);
                         App::app_state->setVal((int)AppState::SIMULATION);
                         App::GetGuiManager()->GameMainMenu .SetVisible(false);
@@ -709,7 +816,16 @@ int main(int argc, char *argv[])
                     ActorSpawnRequest* rq = static_cast<ActorSpawnRequest*>(m.payload);
                     if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
                     {
-                        App::GetGameContext()->SpawnActor(*rq);
+                        // Other origins (terrain, savegame, presets) rely on the actor existing right after this message
+                        if (rq->asr_origin == ActorSpawnRequest::Origin::USER ||
+                            rq->asr_origin == ActorSpawnRequest::Origin::NETWORK)
+                        {
+                            App::GetGameContext()->QueueActorSpawn(*rq);
+                        }
+                        else
+                        {
+                            App::GetGameContext()->SpawnActor(*rq);
+                        }
                     }
                     delete rq;
                     break;
@@ -909,7 +1025,7 @@ int main(int argc, char *argv[])
                 case MSG_EDI_MODIFY_GROUNDMODEL_REQUESTED:
                 {
                     ground_model_t* modified_gm = static_cast<ground_model_t*>(m.payload);
-                    ground_model_t* live_gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString(modified_gm->name);
+                    ground_model_t* live_gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModel(modified_gm->gm_id);
                     *live_gm = *modified_gm; // Copy over
                     //DO NOT `delete` the payload - it's a weak pointer, the data are owned by `RoR::Collisions`; See `enum MsgType` in file 'Application.h'.
                     break;
@@ -955,6 +1071,7 @@ int main(int argc, char *argv[])
                     if (all_clear)
                     {
                         // Nobody uses the RG anymore -> destroy and re-create it.
+                        App::GetGfxScene()->DiscardParticleSystems(entry->resource_group);
                         App::GetCacheSystem()->ReLoadResource(*entry);
                     }
                     else
@@ -975,14 +1092,38 @@ int main(int argc, char *argv[])
                 {
                     for (Message& chained_msg: m.chain)
                     {
-                        App::GetGameContext()->PushMessage(chained_msg);
+                        App::GetGameContext()->PushMessage(std::move(chained_msg));
                     }
                 }
 
             } // Game events block
 
+            // Finish actor spawns whose truckfiles were parsed in background
+            if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+            {
+                App::GetGameContext()->UpdatePendingSpawns();
+            }
+
+            // Measure how long the frame actually took, for the graphics frame budget
+            if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
+            {
+                App::GetGfxScene()->GetFrameBudget().ReportFrameWorkTime(
+                    std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start_time).count());
+            }
+
             // Check FPS limit
-            if (App::gfx_fps_limit->getInt() > 0)
+            if (App::cli_headless->getBool())
+            {
+                // No vsync to hold us back and no one to see the frames - sleep instead of spinning, leave the cores to physics
+                const int HEADLESS_FPS = 60;
+                const float min_frame_time = 1.0f / ((App::gfx_fps_limit->getInt() > 0) ? Ogre::Math::Clamp(App::gfx_fps_limit->getInt(), 5, 240) : HEADLESS_FPS);
+                const float dt = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start_time).count();
+                if (dt < min_frame_time)
+                {
+                    std::this_thread::sleep_for(std::chrono::duration<float>(min_frame_time - dt));
+                }
+            }
+            else if (App::gfx_fps_limit->getInt() > 0 && !SimBenchmark::IsActive()) // Benchmarks measure the unthrottled frame time
             {
                 const float min_frame_time = 1.0f / Ogre::Math::Clamp(App::gfx_fps_limit->getInt(), 5, 240);
                 float dt = std::chrono::duration<float>(std::chrono::high_resolution_clock::now() - start_time).count();
@@ -994,14 +1135,14 @@ int main(int argc, char *argv[])
 
             // Calculate delta time
             const auto now = std::chrono::high_resolution_clock::now();
-            const float dt = std::chrono::duration<float>(now - start_time).count();
+            const float dt = InputRecorder::UpdateFrameTime(std::chrono::duration<float>(now - start_time).count()); // Replays use the recorded frame times
             start_time = now;
 
 #ifdef USE_SOCKETW
             // Process incoming network traffic
             if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
             {
-                std::vector<RoR::NetRecvPacket> packets = App::GetNetwork()->GetIncomingStreamData();
+                std::vector<RoR::NetRecvPacket*> const& packets = App::GetNetwork()->GetIncomingStreamData();
                 if (!packets.empty())
                 {
                     RoR::ChatSystem::HandleStreamData(packets);
@@ -1011,6 +1152,7 @@ int main(int argc, char *argv[])
                         App::GetGameContext()->GetCharacterFactory()->handleStreamData(packets); // Update characters last (or else beam coupling might fail)
                     }
                 }
+                App::GetNetwork()->ReleaseIncomingStreamData();
             }
 #endif // USE_SOCKETW
 
@@ -1018,6 +1160,7 @@ int main(int argc, char *argv[])
             if (dt != 0.f)
             {
                 App::GetInputEngine()->Capture();
+                InputRecorder::RecordEvents();
                 App::GetInputEngine()->updateKeyBounces(dt);
 
                 if (!App::GetGuiManager()->GameControls.IsInteractiveKeyBindingActive())
@@ -1089,6 +1232,7 @@ int main(int argc, char *argv[])
             }
 
             // Early GUI updates which require halted physics
+            InputRecorder::SetGuiScope(true);
             App::GetGuiManager()->NewImGuiFrame(dt);
             if (App::app_state->getEnum<AppState>() == AppState::SIMULATION)
             {
@@ -1106,6 +1250,7 @@ int main(int argc, char *argv[])
                     }
                 }
             }
+            InputRecorder::SetGuiScope(false);
 
 #ifdef USE_MUMBLE
             if (App::GetMumble())
@@ -1136,6 +1281,11 @@ int main(int argc, char *argv[])
                 App::GetGameContext()->GetSceneMouse().UpdateSimulation();
             }
 
+            if (App::sim_state->getEnum<SimState>() == SimState::RUNNING)
+            {
+                App::GetGameContext()->UpdateAutosave(dt); // Sim is synced here, it copies the state and writes in background
+            }
+
             // Create snapshot of simulation state for Gfx/GUI updates
             if (App::sim_state->getEnum<SimState>() == SimState::RUNNING ||   // Obviously
                 App::sim_state->getEnum<SimState>() == SimState::EDITOR_MODE) // Needed for character movement
@@ -1148,8 +1298,17 @@ int main(int argc, char *argv[])
             {
                 App::GetGameContext()->UpdateActors(); // *** Start new physics tasks. No reading from Actor N/B beyond this point.
             }
+            SimBenchmark::Update();
+
+#ifdef USE_SOCKETW
+            if (App::mp_state->getEnum<MpState>() == MpState::CONNECTED)
+            {
+                App::GetNetwork()->FlushSendQueue(); // Actor and character streams for this frame were just queued
+            }
+#endif // USE_SOCKETW
 
             // Scene and GUI updates
+            InputRecorder::SetGuiScope(true);
             if (App::app_state->getEnum<AppState>() == AppState::MAIN_MENU)
             {
                 App::GetGuiManager()->DrawMainMenuGui();
@@ -1158,6 +1317,7 @@ int main(int argc, char *argv[])
             {
                 App::GetGfxScene()->UpdateScene(dt); // Draws GUI as well
             }
+            InputRecorder::SetGuiScope(false);
 
             // Render!
             Ogre::RenderWindow* render_window = RoR::App::GetAppContext()->GetRenderWindow();
@@ -1165,9 +1325,15 @@ int main(int argc, char *argv[])
             {
                 App::GetGameContext()->PushMessage(Message(MSG_APP_SHUTDOWN_REQUESTED));
             }
+            else if (App::cli_headless->getBool())
+            {
+                ImGui::EndFrame(); // Normally done by the overlay while rendering
+            }
             else
             {
+                const int64_t render_begin_us = SimProfiler::GetTimestampUs();
                 App::GetAppContext()->GetOgreRoot()->renderOneFrame();
+                SimBenchmark::ReportRenderTime(SimProfiler::GetTimestampUs() - render_begin_us);
                 if (!render_window->isActive() && render_window->isVisible())
                 {
                     render_window->update(); // update even when in background !
@@ -1176,6 +1342,12 @@ int main(int argc, char *argv[])
 
             App::GetGuiManager()->ApplyGuiCaptureKeyboard();
 
+            if (!startup_finished)
+            {
+                FinishStartup(startup_begin_us); // First frame with main menu (and mod cache) is done
+                startup_finished = true;
+            }
+
         } // End of main rendering/input loop
 
 #ifndef _DEBUG
@@ -1183,15 +1355,18 @@ int main(int argc, char *argv[])
     catch (Ogre::Exception& e)
     {
         LOG(e.getFullDescription());
+        App::GetAppContext()->FlushLog();
         ErrorUtils::ShowError(_L("An exception has occured!"), e.getFullDescription());
     }
     catch (std::runtime_error& e)
     {
         LOG(e.what());
+        App::GetAppContext()->FlushLog();
         ErrorUtils::ShowError(_L("An exception (std::runtime_error) has occured!"), e.what());
     }
 #endif
 
+    App::GetAppContext()->FlushLog();
     return 0;
 }
 
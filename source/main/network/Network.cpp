@@ -23,7 +23,10 @@
 
 #include "Network.h"
 
+#include "Actor.h"
+#include "ActorManager.h"
 #include "Application.h"
+#include "CacheSystem.h"
 #include "ChatSystem.h"
 #include "Console.h"
 #include "ErrorUtils.h"
@@ -37,10 +40,12 @@
 
 #include <Ogre.h>
 #include <SocketW.h>
+#include <fmt/format.h>
 
 #include <algorithm>
 #include <chrono>
 #include <cstring>
+#include <iterator>
 
 using namespace RoR;
 
@@ -80,6 +85,10 @@ static Ogre::ColourValue MP_COLORS[] = // Classic RoR multiplayer colors
 using namespace RoRnet;
 
 static const unsigned int m_packet_buffer_size = 20;
+static const size_t       SEND_RING_CAPACITY = 256;  // Packets; discardable ones are capped by `m_packet_buffer_size`
+static const size_t       RECV_RING_CAPACITY = 2048; // Packets; RecvThread waits for the main thread when full
+static const size_t       SEND_BATCH_SIZE = 32 * 1024; // Bytes; queued packets are concatenated into one socket write
+static const int          SEND_FLUSH_TIMEOUT_MS = 50;
 
 #define LOG_THREAD(_MSG_) { std::stringstream s; s << _MSG_ << " (Thread ID: " << std::this_thread::get_id() << ")"; LOG(s.str()); }
 #define LOGSTREAM         Ogre::LogManager().getSingleton().stream()
@@ -124,6 +133,42 @@ int Network::GetUID()
     return m_uid;
 }
 
+void Network::RecordTraffic(int source_id, int stream_id, bool outgoing, size_t packet_size, bool dropped)
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    NetStreamStats& stats = m_stream_stats[std::make_pair(source_id, stream_id)];
+    stats.source_id = source_id;
+    stats.stream_id = stream_id;
+    stats.outgoing = outgoing;
+    if (dropped)
+    {
+        stats.num_dropped++;
+    }
+    else
+    {
+        stats.num_bytes += packet_size;
+        stats.num_packets++;
+        stats.max_packet_size = std::max(stats.max_packet_size, static_cast<uint32_t>(packet_size));
+    }
+}
+
+std::vector<NetStreamStats> Network::GetStreamStats()
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    std::vector<NetStreamStats> result;
+    for (auto& entry: m_stream_stats)
+    {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+float Network::GetStreamStatsTime()
+{
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    return std::chrono::duration<float>(std::chrono::steady_clock::now() - m_stream_stats_start).count();
+}
+
 bool Network::SendMessageRaw(char *buffer, int msgsize)
 {
     SWBaseSocket::SWBaseError error;
@@ -160,16 +205,6 @@ bool Network::SendNetMessage(int type, unsigned int streamid, int len, char* con
     return SendMessageRaw(buffer, msgsize);
 }
 
-void Network::QueueStreamData(RoRnet::Header &header, char *buffer, size_t buffer_len)
-{
-    NetRecvPacket packet;
-    packet.header = header;
-    memcpy(packet.buffer, buffer, std::min(buffer_len, size_t(RORNET_MAX_MESSAGE_LENGTH)));
-
-    std::lock_guard<std::mutex> lock(m_recv_packetqueue_mutex);
-    m_recv_packet_buffer.push_back(packet);
-}
-
 int Network::ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen)
 {
     SWBaseSocket::SWBaseError error;
@@ -216,21 +251,55 @@ void Network::SendThread()
     LOG("[RoR|Networking] SendThread started");
     while (!m_shutdown)
     {
-        NetSendPacket packet;
         {
             std::unique_lock<std::mutex> queue_lock(m_send_packetqueue_mutex);
-            while (m_send_packet_buffer.empty() && !m_shutdown)
+            while (!m_send_packet_buffer.Front() && !m_shutdown)
             {
-                m_send_packet_available_cv.wait(queue_lock);
+                // Woken by FlushSendQueue() once per frame; the timeout covers packets queued outside the game loop
+                m_send_packet_available_cv.wait_for(queue_lock, std::chrono::milliseconds(SEND_FLUSH_TIMEOUT_MS));
             }
-            if (m_shutdown)
+        }
+        if (m_shutdown)
+        {
+            break;
+        }
+
+        // Gather everything queued so far (typically all packets of one frame) into a single write.
+        // The bytes on the wire are unchanged, the server sees ordinary consecutive messages.
+        m_send_batch.clear();
+        while (NetSendPacket* packet = m_send_packet_buffer.Front())
+        {
+            if (!m_send_batch.empty() && m_send_batch.size() + packet->size > SEND_BATCH_SIZE)
             {
                 break;
             }
-            packet = m_send_packet_buffer.front();
-            m_send_packet_buffer.pop_front();
+
+            bool outdated = false;
+            if (((RoRnet::Header*)packet->buffer)->command == MSG2_STREAM_DATA_DISCARDABLE)
+            {
+                // Skip outdated discardable streamdata if a newer one is already queued
+                for (size_t i = 1; NetSendPacket* newer = m_send_packet_buffer.Peek(i); i++)
+                {
+                    if (!memcmp(packet->buffer, newer->buffer, sizeof(RoRnet::Header)))
+                    {
+                        outdated = true;
+                        break;
+                    }
+                }
+            }
+            RoRnet::Header* header = (RoRnet::Header*)packet->buffer;
+            if (!outdated)
+            {
+                m_send_batch.insert(m_send_batch.end(), packet->buffer, packet->buffer + packet->size);
+            }
+            this->RecordTraffic(m_uid, header->streamid, /*outgoing:*/true, packet->size, /*dropped:*/outdated);
+            m_send_packet_buffer.Pop();
+        }
+
+        if (!m_send_batch.empty())
+        {
+            SendMessageRaw(m_send_batch.data(), static_cast<int>(m_send_batch.size()));
         }
-        SendMessageRaw(packet.buffer, packet.size);
     }
     LOG("[RoR|Networking] SendThread stopped");
 }
@@ -239,12 +308,18 @@ void Network::RecvThread()
 {
     LOG_THREAD("[RoR|Networking] RecvThread starting...");
 
-    RoRnet::Header header;
-
-    char buffer[RORNET_MAX_MESSAGE_LENGTH] = {0};
-
     while (!m_shutdown)
     {
+        // Receive straight into the next free slot of the ring; it's only published if the main thread needs the packet
+        NetRecvPacket* packet = m_recv_packet_buffer.BeginPush();
+        if (!packet)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1)); // Main thread is behind, let it catch up
+            continue;
+        }
+        RoRnet::Header& header = packet->header;
+        char* buffer = packet->buffer;
+
         int err = ReceiveMessage(&header, buffer, RORNET_MAX_MESSAGE_LENGTH);
         //LOG("Received data: " + TOSTRING(header.command) + ", source: " + TOSTRING(header.source) + ":" + TOSTRING(header.streamid) + ", size: " + TOSTRING(header.size));
         if (err != 0)
@@ -255,6 +330,8 @@ void Network::RecvThread()
             continue; // Stop receiving data
         }
 
+        this->RecordTraffic(header.source, header.streamid, /*outgoing:*/false, sizeof(RoRnet::Header) + header.size, /*dropped:*/false);
+
         if (header.command == MSG2_STREAM_REGISTER)
         {
             if (header.source == m_uid)
@@ -366,7 +443,7 @@ void Network::RecvThread()
         }
         //DebugPacket("recv", &header, buffer);
 
-        QueueStreamData(header, buffer, RORNET_MAX_MESSAGE_LENGTH);
+        m_recv_packet_buffer.EndPush();
     }
 
     LOG_THREAD("[RoR|Networking] RecvThread stopped");
@@ -394,6 +471,16 @@ bool Network::StartConnecting()
     m_net_port = App::mp_server_port->getInt();
     m_password = App::mp_server_password->getStr();
 
+    m_recv_packet_buffer.Reset(RECV_RING_CAPACITY);
+    m_send_packet_buffer.Reset(SEND_RING_CAPACITY);
+    m_send_batch.reserve(SEND_BATCH_SIZE);
+
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_stream_stats.clear();
+        m_stream_stats_start = std::chrono::steady_clock::now();
+    }
+
     try
     {
         m_connect_thread = std::thread(&Network::ConnectThread, this);
@@ -561,7 +648,14 @@ bool Network::ConnectThread()
 
 void Network::Disconnect()
 {
+    if (m_playback)
+    {
+        this->FinishPlayback();
+        return;
+    }
+
     LOG("[RoR|Networking] Disconnect() disconnecting...");
+    this->StopRecording();
     bool is_clean_disconnect = !m_shutdown; // Hacky detection of invalid network state
 
     m_shutdown = true; // Instruct Send/Recv threads to shut down.
@@ -593,8 +687,9 @@ void Network::Disconnect()
     SetNetQuality(0);
     m_users.clear();
     m_disconnected_users.clear();
-    m_recv_packet_buffer.clear();
-    m_send_packet_buffer.clear();
+    m_recv_packet_views.clear();
+    m_recv_packet_buffer.Reset(0);
+    m_send_packet_buffer.Reset(0);
     App::GetConsole()->doCommand("clear net");
 
     m_shutdown = false;
@@ -605,6 +700,11 @@ void Network::Disconnect()
 
 void Network::AddPacket(int streamid, int type, int len, const char *content)
 {
+    if (m_playback)
+    {
+        return; // Nobody to send to
+    }
+
     const auto max_len = RORNET_MAX_MESSAGE_LENGTH - sizeof(RoRnet::Header);
     if (len > max_len)
     {
@@ -613,10 +713,23 @@ void Network::AddPacket(int streamid, int type, int len, const char *content)
         return;
     }
 
-    NetSendPacket packet;
-    memset(&packet, 0, sizeof(NetSendPacket));
+    if (type == MSG2_STREAM_DATA_DISCARDABLE && m_send_packet_buffer.Size() > m_packet_buffer_size)
+    {
+        // buffer full, discard unimportant data packets
+        this->RecordTraffic(m_uid, streamid, /*outgoing:*/true, 0, /*dropped:*/true);
+        return;
+    }
 
-    char *buffer = (char*)(packet.buffer);
+    NetSendPacket* packet = m_send_packet_buffer.BeginPush();
+    if (!packet)
+    {
+        LOGSTREAM << "[RoR|Networking] Discarding network packet (StreamID: "
+            <<streamid<<", Type: "<<type<<"), send queue is full";
+        return;
+    }
+
+    char *buffer = (char*)(packet->buffer);
+    memset(buffer, 0, sizeof(RoRnet::Header));
 
     RoRnet::Header *head = (RoRnet::Header *)buffer;
     head->command     = type;
@@ -629,31 +742,22 @@ void Network::AddPacket(int streamid, int type, int len, const char *content)
     memcpy(bufferContent, content, len);
 
     // record the packet size
-    packet.size = len + sizeof(RoRnet::Header);
+    packet->size = len + sizeof(RoRnet::Header);
 
-    { // Lock scope
-        std::lock_guard<std::mutex> lock(m_send_packetqueue_mutex);
-        if (type == MSG2_STREAM_DATA_DISCARDABLE)
-        {
-            if (m_send_packet_buffer.size() > m_packet_buffer_size)
-            {
-                // buffer full, discard unimportant data packets
-                return;
-            }
-            auto search = std::find_if(m_send_packet_buffer.begin(), m_send_packet_buffer.end(),
-                    [&](const NetSendPacket& p) { return !memcmp(packet.buffer, p.buffer, sizeof(RoRnet::Header)); });
-            if (search != m_send_packet_buffer.end())
-            {
-                // Found outdated discardable streamdata -> replace it
-                (*search) = packet;
-                m_send_packet_available_cv.notify_one();
-                return;
-            }
-        }
-        //DebugPacket("send", head, buffer);
-        m_send_packet_buffer.push_back(packet);
+    //DebugPacket("send", head, buffer);
+    m_send_packet_buffer.EndPush();
+}
+
+void Network::FlushSendQueue()
+{
+    if (m_playback || !m_send_packet_buffer.Front())
+    {
+        return;
     }
 
+    { // Lock scope; only contended while SendThread is about to sleep
+        std::lock_guard<std::mutex> lock(m_send_packetqueue_mutex);
+    }
     m_send_packet_available_cv.notify_one();
 }
 
@@ -669,12 +773,270 @@ void Network::AddLocalStream(RoRnet::StreamRegister *reg, int size)
     m_stream_id++;
 }
 
-std::vector<NetRecvPacket> Network::GetIncomingStreamData()
+std::vector<NetRecvPacket*> const& Network::GetIncomingStreamData()
+{
+    this->ReleaseIncomingStreamData();
+    if (m_playback)
+    {
+        this->PlaybackStreamData();
+        return m_recv_packet_views;
+    }
+
+    while (NetRecvPacket* packet = m_recv_packet_buffer.Peek(m_recv_packet_views.size()))
+    {
+        m_recv_packet_views.push_back(packet);
+    }
+    if (m_record_file.is_open())
+    {
+        this->RecordStreamData(m_recv_packet_views);
+    }
+    return m_recv_packet_views;
+}
+
+void Network::ReleaseIncomingStreamData()
+{
+    if (!m_playback) // Playback packets don't live in the ring
+    {
+        for (size_t i = 0; i < m_recv_packet_views.size(); i++)
+        {
+            m_recv_packet_buffer.Pop();
+        }
+    }
+    m_recv_packet_views.clear();
+}
+
+// ----------------------------------------------------------------------------
+// Stream recording
+//
+// File layout: RECORDING_MAGIC, RECORDING_VERSION, local UID (all uint32),
+// then packets: time in ms since start (uint32), RoRnet::Header, payload.
+// Remote users are stored as MSG2_USER_INFO packets before their first stream packet.
+
+static const uint32_t RECORDING_MAGIC = 0x52524E53; // "RRNS"
+static const uint32_t RECORDING_VERSION = 1;
+
+bool Network::StartRecording(std::string const& filename)
+{
+    this->StopRecording();
+    m_record_file.open(filename, std::ios::binary);
+    if (!m_record_file.is_open())
+    {
+        return false;
+    }
+
+    const uint32_t file_header[] = { RECORDING_MAGIC, RECORDING_VERSION, static_cast<uint32_t>(m_uid) };
+    m_record_file.write((const char*)file_header, sizeof(file_header));
+    m_record_known_users.clear();
+    m_record_start = std::chrono::steady_clock::now();
+
+    // Actors spawned before the recording started - write their registrations so playback can spawn them
+    std::vector<NetRecvPacket*> registrations;
+    std::vector<NetRecvPacket> packets;
+    ActorManager* actor_mgr = App::GetGameContext()->GetActorManager();
+    for (ActorPtr& actor: actor_mgr->GetActors())
+    {
+        if (actor->ar_state != ActorState::NETWORKED_OK && actor->ar_state != ActorState::NETWORKED_HIDDEN)
+            continue;
+
+        packets.emplace_back();
+        NetRecvPacket& packet = packets.back();
+        memset(&packet, 0, sizeof(NetRecvPacket));
+        packet.header.command = MSG2_STREAM_REGISTER;
+        packet.header.source = actor->ar_net_source_id;
+        packet.header.streamid = actor->ar_net_stream_id;
+        packet.header.size = sizeof(RoRnet::ActorStreamRegister);
+
+        RoRnet::ActorStreamRegister* reg = (RoRnet::ActorStreamRegister*)packet.buffer;
+        reg->type = 0;
+        reg->origin_sourceid = actor->ar_net_source_id;
+        reg->origin_streamid = actor->ar_net_stream_id;
+        strncpy(reg->name, actor->ar_filename.c_str(), sizeof(reg->name) - 1);
+        reg->time = static_cast<int32_t>(actor_mgr->GetNetTime()) + actor_mgr->GetNetTimeOffset(actor->ar_net_source_id);
+        if (actor->getUsedSkin())
+        {
+            strncpy(reg->skin, actor->getUsedSkin()->dname.c_str(), sizeof(reg->skin) - 1);
+        }
+        strncpy(reg->sectionconfig, actor->getSectionConfig().c_str(), sizeof(reg->sectionconfig) - 1);
+    }
+    for (NetRecvPacket& packet: packets)
+    {
+        registrations.push_back(&packet);
+    }
+    this->RecordStreamData(registrations);
+
+    return m_record_file.good();
+}
+
+void Network::StopRecording()
+{
+    if (m_record_file.is_open())
+    {
+        m_record_file.close();
+    }
+}
+
+void Network::WriteRecordedPacket(uint32_t time_ms, RoRnet::Header const& header, const char* payload)
+{
+    m_record_file.write((const char*)&time_ms, sizeof(time_ms));
+    m_record_file.write((const char*)&header, sizeof(RoRnet::Header));
+    m_record_file.write(payload, header.size);
+}
+
+void Network::RecordStreamData(std::vector<NetRecvPacket*> const& packets)
+{
+    const uint32_t time_ms = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_record_start).count());
+
+    for (NetRecvPacket* packet: packets)
+    {
+        RoRnet::UserInfo user;
+        if (m_record_known_users.insert(packet->header.source).second &&
+            this->GetUserInfo(packet->header.source, user))
+        {
+            RoRnet::Header user_header;
+            memset(&user_header, 0, sizeof(RoRnet::Header));
+            user_header.command = MSG2_USER_INFO;
+            user_header.source = packet->header.source;
+            user_header.size = sizeof(RoRnet::UserInfo);
+            this->WriteRecordedPacket(time_ms, user_header, (const char*)&user);
+        }
+        this->WriteRecordedPacket(time_ms, packet->header, packet->buffer);
+    }
+}
+
+bool Network::StartPlayback(std::string const& filename)
+{
+    std::ifstream file(filename, std::ios::binary);
+    uint32_t file_header[3] = {};
+    if (!file.is_open() ||
+        !file.read((char*)file_header, sizeof(file_header)) ||
+        file_header[0] != RECORDING_MAGIC || file_header[1] != RECORDING_VERSION)
+    {
+        return false;
+    }
+    m_playback_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    m_uid = static_cast<int>(file_header[2]);
+    m_userdata.uniqueid = file_header[2];
+    m_users.clear();
+    m_disconnected_users.clear();
+    m_playback = true;
+    m_playback_leaving = false;
+    m_playback_pos = 0;
+    m_playback_num_frames = 0;
+    m_playback_worst_frame = 0.f;
+    m_playback_start = std::chrono::steady_clock::now();
+    m_playback_last_frame = m_playback_start;
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_stream_stats.clear();
+        m_stream_stats_start = m_playback_start;
+    }
+    App::mp_state->setVal((int)MpState::CONNECTED);
+    return true;
+}
+
+void Network::StopPlayback()
+{
+    m_playback_pos = m_playback_data.size(); // Users leave on next frame
+}
+
+void Network::PlaybackStreamData()
 {
-    std::lock_guard<std::mutex> lock(m_recv_packetqueue_mutex);
-    std::vector<NetRecvPacket> buf_copy = m_recv_packet_buffer;
-    m_recv_packet_buffer.clear();
-    return buf_copy;
+    const auto now = std::chrono::steady_clock::now();
+    m_playback_worst_frame = std::max(m_playback_worst_frame, std::chrono::duration<float>(now - m_playback_last_frame).count());
+    m_playback_last_frame = now;
+    m_playback_num_frames++;
+
+    if (m_playback_leaving)
+    {
+        this->FinishPlayback();
+        return;
+    }
+
+    const uint32_t now_ms = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now - m_playback_start).count());
+    const size_t PACKET_PREFIX = sizeof(uint32_t) + sizeof(RoRnet::Header);
+    size_t num_packets = 0;
+    while (m_playback_pos + PACKET_PREFIX <= m_playback_data.size())
+    {
+        uint32_t time_ms = 0;
+        RoRnet::Header header;
+        memcpy(&time_ms, &m_playback_data[m_playback_pos], sizeof(uint32_t));
+        memcpy(&header, &m_playback_data[m_playback_pos + sizeof(uint32_t)], sizeof(RoRnet::Header));
+        if (time_ms > now_ms)
+        {
+            break;
+        }
+        if (header.size >= RORNET_MAX_MESSAGE_LENGTH || m_playback_pos + PACKET_PREFIX + header.size > m_playback_data.size())
+        {
+            m_playback_pos = m_playback_data.size(); // Truncated recording
+            break;
+        }
+        const char* payload = &m_playback_data[m_playback_pos + PACKET_PREFIX];
+        m_playback_pos += PACKET_PREFIX + header.size;
+
+        this->RecordTraffic(header.source, header.streamid, /*outgoing:*/false, sizeof(RoRnet::Header) + header.size, /*dropped:*/false);
+        if (header.command == MSG2_USER_INFO)
+        {
+            RoRnet::UserInfo user;
+            memcpy(&user, payload, std::min<size_t>(sizeof(RoRnet::UserInfo), header.size));
+            std::lock_guard<std::mutex> lock(m_users_mutex);
+            m_users.push_back(user);
+            continue;
+        }
+
+        if (num_packets == m_playback_packets.size())
+        {
+            m_playback_packets.emplace_back();
+        }
+        NetRecvPacket& packet = m_playback_packets[num_packets++];
+        packet.header = header;
+        memcpy(packet.buffer, payload, header.size);
+        packet.buffer[header.size] = '\0';
+    }
+
+    if (m_playback_pos >= m_playback_data.size())
+    {
+        // End of recording - remove the replayed users along with their actors and characters
+        std::lock_guard<std::mutex> lock(m_users_mutex);
+        for (RoRnet::UserInfo const& user: m_users)
+        {
+            if (num_packets == m_playback_packets.size())
+            {
+                m_playback_packets.emplace_back();
+            }
+            NetRecvPacket& packet = m_playback_packets[num_packets++];
+            memset(&packet.header, 0, sizeof(RoRnet::Header));
+            packet.header.command = MSG2_USER_LEAVE;
+            packet.header.source = static_cast<int32_t>(user.uniqueid);
+            packet.buffer[0] = '\0';
+        }
+        m_playback_leaving = true;
+    }
+
+    for (size_t i = 0; i < num_packets; i++)
+    {
+        m_recv_packet_views.push_back(&m_playback_packets[i]);
+    }
+}
+
+void Network::FinishPlayback()
+{
+    const float total_sec = std::chrono::duration<float>(std::chrono::steady_clock::now() - m_playback_start).count();
+    App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+        fmt::format(_L("netreplay: finished, {} frames in {:.1f}s, average frame {:.2f} ms, worst {:.2f} ms"),
+            m_playback_num_frames, total_sec,
+            (total_sec * 1000.f) / std::max<size_t>(m_playback_num_frames, 1), m_playback_worst_frame * 1000.f));
+
+    m_playback = false;
+    m_playback_data.clear();
+    m_playback_packets.clear();
+    m_recv_packet_views.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_users_mutex);
+        m_users.clear();
+    }
+    App::mp_state->setVal((int)MpState::DISABLED);
 }
 
 Ogre::String Network::GetTerrainName()
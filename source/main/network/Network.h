@@ -25,15 +25,19 @@
 
 #include "Application.h"
 #include "RoRnet.h"
+#include "SpscRing.h"
 
 #include <SocketW.h>
 
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <deque>
+#include <fstream>
 #include <list>
+#include <map>
 #include <mutex>
 #include <queue>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -101,6 +105,18 @@ struct NetRecvPacket
 
 // ------------------------ End of network messages --------------------------
 
+/// Traffic counters of one stream, see `Network::GetStreamStats()`
+struct NetStreamStats
+{
+    int      source_id = 0;       //!< Remote user ID; own UID for outgoing streams
+    int      stream_id = 0;
+    bool     outgoing = false;
+    uint64_t num_bytes = 0;       //!< Including RoRnet headers
+    uint64_t num_packets = 0;
+    uint32_t max_packet_size = 0; //!< Bytes, including the RoRnet header
+    uint64_t num_dropped = 0;     //!< Outgoing only; discardable packets which were never sent (queue full, superseded)
+};
+
 class Network
 {
 public:
@@ -109,13 +125,28 @@ public:
     void                 Disconnect();
 
     void                 AddPacket(int streamid, int type, int len, const char *content);
+    void                 FlushSendQueue();             //!< Wakes SendThread to write all packets queued this frame at once.
     void                 AddLocalStream(RoRnet::StreamRegister *reg, int size);
 
-    std::vector<NetRecvPacket> GetIncomingStreamData();
+    std::vector<NetRecvPacket*> const& GetIncomingStreamData(); //!< Packets received since last call, parsed in place; valid until `ReleaseIncomingStreamData()` or the next call.
+    void                 ReleaseIncomingStreamData();          //!< Hands the packet slots back to the receiver thread.
 
     int                  GetUID();
     int                  GetNetQuality();
 
+    std::vector<NetStreamStats> GetStreamStats();        //!< Copy of the traffic counters of all streams since connecting
+    float                GetStreamStatsTime();           //!< Seconds since the counters were reset
+    size_t               GetSendQueueSize() const { return m_send_packet_buffer.Size(); }
+    size_t               GetRecvQueueSize() const { return m_recv_packet_buffer.Size(); }
+
+    // Stream recording, see console commands `netrecord` and `netreplay`
+    bool                 StartRecording(std::string const& filename); //!< Saves incoming stream data with timestamps, starting with the actors already present.
+    void                 StopRecording();
+    bool                 IsRecording() const { return m_record_file.is_open(); }
+    bool                 StartPlayback(std::string const& filename); //!< Feeds a recording to the game as if connected; needs no server. Results go to console when done.
+    void                 StopPlayback();                               //!< Removes the replayed users and their actors on the next frame.
+    bool                 IsPlayingBack() const { return m_playback; }
+
     Ogre::String         GetTerrainName();
 
     int                  GetUserColor();
@@ -139,9 +170,13 @@ private:
     void                 SetNetQuality(int quality);
     bool                 SendMessageRaw(char *buffer, int msgsize);
     bool                 SendNetMessage(int type, unsigned int streamid, int len, char* content);
-    void                 QueueStreamData(RoRnet::Header &header, char *buffer, size_t buffer_len);
     int                  ReceiveMessage(RoRnet::Header *head, char* content, int bufferlen);
     void                 CouldNotConnect(std::string const & msg, bool close_socket = true);
+    void                 RecordTraffic(int source_id, int stream_id, bool outgoing, size_t packet_size, bool dropped);
+    void                 WriteRecordedPacket(uint32_t time_ms, RoRnet::Header const& header, const char* payload);
+    void                 RecordStreamData(std::vector<NetRecvPacket*> const& packets);
+    void                 PlaybackStreamData();                         //!< Fills `m_recv_packet_views` from the recording
+    void                 FinishPlayback();
 
     bool                 ConnectThread();
     void                 SendThread();
@@ -175,13 +210,32 @@ private:
 
     std::mutex           m_users_mutex;
     std::mutex           m_userdata_mutex;
-    std::mutex           m_recv_packetqueue_mutex;
-    std::mutex           m_send_packetqueue_mutex;
+    std::mutex           m_send_packetqueue_mutex; //!< Only for SendThread to sleep on; never held while sending
 
     std::condition_variable m_send_packet_available_cv;
 
-    std::vector<NetRecvPacket> m_recv_packet_buffer;
-    std::deque <NetSendPacket> m_send_packet_buffer;
+    std::mutex           m_stats_mutex;
+    std::map<std::pair<int, int>, NetStreamStats> m_stream_stats; //!< Key: source ID (own UID for outgoing), stream ID
+    std::chrono::steady_clock::time_point m_stream_stats_start;
+
+    // Recording and playback; main thread only
+    std::ofstream        m_record_file;
+    std::set<int>        m_record_known_users;      //!< Users whose USER_INFO was already written
+    std::chrono::steady_clock::time_point m_record_start;
+    bool                 m_playback = false;
+    bool                 m_playback_leaving = false; //!< USER_LEAVE for all replayed users was handed out, finish on next frame
+    std::vector<char>    m_playback_data;
+    size_t               m_playback_pos = 0;
+    std::vector<NetRecvPacket> m_playback_packets;   //!< Slots for the packets handed out this frame
+    std::chrono::steady_clock::time_point m_playback_start;
+    std::chrono::steady_clock::time_point m_playback_last_frame;
+    size_t               m_playback_num_frames = 0;
+    float                m_playback_worst_frame = 0.f; //!< Seconds
+
+    SpscRing<NetRecvPacket> m_recv_packet_buffer; //!< RecvThread -> main thread
+    std::vector<NetRecvPacket*> m_recv_packet_views; //!< Main thread only; slots of `m_recv_packet_buffer` handed out by `GetIncomingStreamData()`
+    SpscRing<NetSendPacket> m_send_packet_buffer; //!< Main thread -> SendThread
+    std::vector<char>    m_send_batch;            //!< SendThread only; packets coalesced into one socket write
 };
 
 /// @}   //addtogroup Network
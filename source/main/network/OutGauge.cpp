@@ -35,8 +35,12 @@ using namespace RoR;
 
 OutGauge::OutGauge(void) :
      sockfd(-1)
+    , outsim_sockfd(-1)
     , timer(0)
     , working(false)
+    , outsim_last_vel(Ogre::Vector3::ZERO)
+    , outsim_last_rot(Ogre::Vector3::ZERO)
+    , outsim_last_time(0)
 {
 }
 
@@ -53,26 +57,28 @@ void OutGauge::Close(void)
 #endif // USE_SOCKETW
         sockfd = 0;
     }
+    if (outsim_sockfd > 0)
+    {
+#ifdef USE_SOCKETW
+#   if _WIN32
+        closesocket(outsim_sockfd);
+#   else
+        close( outsim_sockfd );
+#   endif
+#endif // USE_SOCKETW
+    }
+    outsim_sockfd = -1;
 }
 
-void OutGauge::Connect()
+int OutGauge::ConnectSocket(int port)
 {
 #if defined(_WIN32) && defined(USE_SOCKETW)
-    SWBaseSocket::SWBaseError error;
-
-    // startup winsock
-    WSADATA wsd;
-    if (WSAStartup(MAKEWORD(2, 2), &wsd) != 0)
-    {
-        LOG("[RoR|OutGauge] Error starting up winsock. OutGauge disabled.");
-        return;
-    }
-
     // open a new socket
-    if ((sockfd = socket(AF_INET, SOCK_DGRAM, 0)) < 0)
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd < 0)
     {
         LOG(String("[RoR|OutGauge] Error creating socket for OutGauge: ").append(strerror(errno)));
-        return;
+        return -1;
     }
 
     // get the IP of the remote side, this function is compatible with windows 2000
@@ -84,15 +90,45 @@ void OutGauge::Connect()
     memset(&sendaddr, 0, sizeof(sendaddr));
     sendaddr.sin_family = AF_INET;
     sendaddr.sin_addr.s_addr = inet_addr(ip);
-    sendaddr.sin_port = htons(App::io_outgauge_port->getInt());
+    sendaddr.sin_port = htons(port);
 
     // connect
-    if (connect(sockfd, (struct sockaddr *) &sendaddr, sizeof(sendaddr)) == SOCKET_ERROR)
+    if (connect(fd, (struct sockaddr *) &sendaddr, sizeof(sendaddr)) == SOCKET_ERROR)
     {
         LOG(String("[RoR|OutGauge] Error connecting socket for OutGauge: ").append(strerror(errno)));
+        closesocket(fd);
+        return -1;
+    }
+    return fd;
+#else
+    return -1;
+#endif // _WIN32
+}
+
+void OutGauge::Connect()
+{
+#if defined(_WIN32) && defined(USE_SOCKETW)
+    SWBaseSocket::SWBaseError error;
+
+    // startup winsock
+    WSADATA wsd;
+    if (WSAStartup(MAKEWORD(2, 2), &wsd) != 0)
+    {
+        LOG("[RoR|OutGauge] Error starting up winsock. OutGauge disabled.");
         return;
     }
 
+    sockfd = this->ConnectSocket(App::io_outgauge_port->getInt());
+    if (sockfd < 0)
+    {
+        return;
+    }
+
+    if (App::io_outsim_port->getInt() > 0)
+    {
+        outsim_sockfd = this->ConnectSocket(App::io_outsim_port->getInt());
+    }
+
     LOG("[RoR|OutGauge] Connected successfully");
     working = true;
 #else
@@ -100,6 +136,53 @@ void OutGauge::Connect()
 #endif // _WIN32
 }
 
+void OutGauge::SendOutSim(ActorPtr truck)
+{
+#if defined(_WIN32) && defined(USE_SOCKETW)
+    OutSimPack os;
+    memset(&os, 0, sizeof(os));
+    os.Time = Root::getSingleton().getTimer()->getMilliseconds();
+    os.ID = App::io_outgauge_id->getInt();
+
+    if (truck && truck->ar_state == ActorState::LOCAL_SIMULATED)
+    {
+        // Convert RoR (X right, Y up, -Z forward) to LFS (X right, Y forward, Z up)
+        const Ogre::Vector3 vel = truck->ar_nodes[truck->ar_main_camera_node_pos].Velocity;
+        const Ogre::Vector3 pos = truck->ar_nodes[truck->ar_main_camera_node_pos].AbsPosition;
+        const Ogre::Vector3 lfs_vel(vel.x, -vel.z, vel.y);
+        const Ogre::Vector3 rot(
+            truck->getRotation(),
+            asin(Ogre::Math::Clamp(truck->GetCameraDir().y, -1.f, 1.f)),
+            asin(Ogre::Math::Clamp(truck->GetCameraRoll().y, -1.f, 1.f)));
+
+        const float dt = (os.Time - outsim_last_time) * 0.001f;
+        if (outsim_last_time != 0 && dt > 0.f)
+        {
+            const Ogre::Vector3 accel = (lfs_vel - outsim_last_vel) / dt;
+            Ogre::Vector3 rot_delta = rot - outsim_last_rot;
+            rot_delta.x = Ogre::Math::ATan2(Ogre::Math::Sin(rot_delta.x), Ogre::Math::Cos(rot_delta.x)).valueRadians(); // Heading wraps around
+            const Ogre::Vector3 ang_vel = rot_delta / dt;
+            os.Accel[0] = accel.x; os.Accel[1] = accel.y; os.Accel[2] = accel.z;
+            os.AngVel[0] = ang_vel.y; os.AngVel[1] = ang_vel.z; os.AngVel[2] = ang_vel.x; // Pitch is about X, roll about Y, heading about Z
+        }
+
+        os.Heading = rot.x;
+        os.Pitch = rot.y;
+        os.Roll = rot.z;
+        os.Vel[0] = lfs_vel.x; os.Vel[1] = lfs_vel.y; os.Vel[2] = lfs_vel.z;
+        os.Pos[0] = static_cast<int>(pos.x * 65536.f);
+        os.Pos[1] = static_cast<int>(-pos.z * 65536.f);
+        os.Pos[2] = static_cast<int>(pos.y * 65536.f);
+
+        outsim_last_vel = lfs_vel;
+        outsim_last_rot = rot;
+    }
+    outsim_last_time = os.Time;
+
+    send(outsim_sockfd, (const char*)&os, sizeof(os), NULL);
+#endif // _WIN32
+}
+
 bool OutGauge::Update(float dt, ActorPtr truck)
 {
 #if defined(_WIN32) && defined(USE_SOCKETW)
@@ -108,13 +191,21 @@ bool OutGauge::Update(float dt, ActorPtr truck)
         return false;
     }
 
+    // Motion data goes out every frame - motion platforms need the lowest latency
+    if (outsim_sockfd > 0)
+    {
+        this->SendOutSim(truck);
+    }
+
     // below the set delay?
+    const float interval = 0.1f * App::io_outgauge_delay->getFloat();
     timer += dt;
-    if (timer < (0.1f * App::io_outgauge_delay->getFloat()))
+    if (timer < interval)
     {
         return true;
     }
-    timer = 0;
+    // Keep the remainder so the average rate doesn't depend on the frame rate
+    timer = std::min(timer - interval, interval);
 
     // send a package
     OutGaugePack gd;
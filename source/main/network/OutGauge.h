@@ -54,11 +54,16 @@ public:
 
 private:
 
+    int  ConnectSocket(int port); //!< Returns UDP socket connected to `io_outgauge_ip`, or -1
+    void SendOutSim(ActorPtr truck);
+
     bool working;
     float timer;
     int sockfd;
-
-    
+    int outsim_sockfd;              //!< Motion data, see `io_outsim_port`
+    Ogre::Vector3 outsim_last_vel;  //!< For acceleration (LFS axes)
+    Ogre::Vector3 outsim_last_rot;  //!< Heading, pitch, roll - for angular velocity
+    unsigned long outsim_last_time; //!< Milliseconds
 
     // from LFS/doc/insim.txt
     enum
@@ -110,6 +115,21 @@ private:
         char           Display2[16]; // Usually Settings
         int            ID;           // optional - only if OutGauge ID is specified
     });
+
+    // from LFS/doc/insim.txt - motion data for motion platforms.
+    // LFS axes: X = right, Y = forward, Z = up.
+    PACK (struct OutSimPack
+    {
+        unsigned int   Time;         // time in milliseconds (to check order)
+        float          AngVel[3];    // 3 floats, angular velocity vector
+        float          Heading;      // anticlockwise from above (Z)
+        float          Pitch;        // anticlockwise from right (X)
+        float          Roll;         // anticlockwise from front (Y)
+        float          Accel[3];     // 3 floats X, Y, Z
+        float          Vel[3];       // 3 floats X, Y, Z
+        int            Pos[3];       // 3 ints   X, Y, Z (1m = 65536)
+        int            ID;           // optional - only if OutGauge ID is specified
+    });
 };
 
 /// @}   //addtogroup Network
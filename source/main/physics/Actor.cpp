@@ -29,6 +29,7 @@
 #include "ActorManager.h"
 #include "Buoyance.h"
 #include "CacheSystem.h"
+#include "CameraManager.h"
 #include "ChatSystem.h"
 #include "CmdKeyInertia.h"
 #include "Collisions.h"
@@ -58,6 +59,7 @@
 #include "RoRnet.h"
 #include "ScrewProp.h"
 #include "ScriptEngine.h"
+#include "SimProfiler.h"
 #include "Skidmark.h"
 #include "SlideNode.h"
 #include "SoundScriptManager.h"
@@ -71,11 +73,13 @@
 
 #include <sstream>
 #include <iomanip>
+#include <set>
 
 using namespace Ogre;
 using namespace RoR;
 
 static const Ogre::Vector3 BOUNDING_BOX_PADDING(0.05f, 0.05f, 0.05f);
+static const float NET_MAX_EXTRAPOLATION_MS = 250.f; //!< How long remote actors keep moving when updates are late
 
 Actor::~Actor()
 {
@@ -168,6 +172,10 @@ void Actor::dispose()
     // delete GfxActor
     m_gfx_actor.reset();
 
+    // release materials shared with other actors
+    ActorSpawner::ReleaseSharedMaterials(m_shared_material_keys);
+    m_shared_material_keys.clear();
+
     // delete wings
     for (int i = 0; i < ar_num_wings; i++)
     {
@@ -230,33 +238,29 @@ void Actor::dispose()
     // delete exhausts
     for (std::vector<exhaust_t>::iterator it = exhausts.begin(); it != exhausts.end(); it++)
     {
+        if (it->smoker)
+        {
+            App::GetGfxScene()->ReleaseParticleSystem(it->smoker); // Pooled; detach before the node goes
+        }
         if (it->smokeNode)
         {
             it->smokeNode->removeAndDestroyAllChildren();
             App::GetGfxScene()->GetSceneManager()->destroySceneNode(it->smokeNode);
         }
-        if (it->smoker)
-        {
-            it->smoker->removeAllAffectors();
-            it->smoker->removeAllEmitters();
-            App::GetGfxScene()->GetSceneManager()->destroyParticleSystem(it->smoker);
-        }
     }
 
     // delete ar_custom_particles
     for (int i = 0; i < ar_num_custom_particles; i++)
     {
+        if (ar_custom_particles[i].psys)
+        {
+            App::GetGfxScene()->ReleaseParticleSystem(ar_custom_particles[i].psys); // Pooled; detach before the node goes
+        }
         if (ar_custom_particles[i].snode)
         {
             ar_custom_particles[i].snode->removeAndDestroyAllChildren();
             App::GetGfxScene()->GetSceneManager()->destroySceneNode(ar_custom_particles[i].snode);
         }
-        if (ar_custom_particles[i].psys)
-        {
-            ar_custom_particles[i].psys->removeAllAffectors();
-            ar_custom_particles[i].psys->removeAllEmitters();
-            App::GetGfxScene()->GetSceneManager()->destroyParticleSystem(ar_custom_particles[i].psys);
-        }
     }
 
     // delete Rails
@@ -295,16 +299,34 @@ void Actor::dispose()
     }
     m_num_wheel_diffs = 0;
 
-    delete[] ar_nodes;
+    // Simulation arrays live in `m_sim_arena`; only `ar_beams` (ActorPtr) and `ar_nodes_name` need destructing
+    for (size_t i = 0; i < m_sim_arena_num_beams; i++)
+    {
+        ar_beams[i].~beam_t();
+    }
+    for (size_t i = 0; i < m_sim_arena_num_nodes; i++)
+    {
+        ar_nodes_name[i].~basic_string();
+    }
+    m_sim_arena.reset();
+    m_sim_arena_num_nodes = 0;
+    m_sim_arena_num_beams = 0;
+    m_sim_arena_size = 0;
+
+    ar_nodes = nullptr;
+    ar_nodes_id = nullptr;
+    ar_nodes_name = nullptr;
     ar_num_nodes = 0;
     m_wheel_node_count = 0;
-    delete[] ar_beams;
+    ar_beams = nullptr;
     ar_num_beams = 0;
-    delete[] ar_shocks;
+    m_plain_beams.clear();
+    m_bounded_beams.clear();
+    ar_shocks = nullptr;
     ar_num_shocks = 0;
-    delete[] ar_rotators;
+    ar_rotators = nullptr;
     ar_num_rotators = 0;
-    delete[] ar_wings;
+    ar_wings = nullptr;
     ar_num_wings = 0;
 
     ar_state = ActorState::DISPOSED;
@@ -384,6 +406,11 @@ void Actor::pushNetwork(char* data, int size)
 {
 #if USE_SOCKETW
     NetUpdate update;
+    if (!m_net_update_pool.empty())
+    {
+        update = std::move(m_net_update_pool.back()); // Reuse the buffers, no allocation
+        m_net_update_pool.pop_back();
+    }
 
     update.veh_state.resize(sizeof(RoRnet::VehicleState));
     update.node_data.resize(m_net_node_buf_size);
@@ -458,20 +485,23 @@ void Actor::pushNetwork(char* data, int size)
         RoRnet::VehicleState* oob = (RoRnet::VehicleState*)update.veh_state.data();
         int tnow = App::GetGameContext()->GetActorManager()->GetNetTime();
         int rnow = std::max(0, tnow + App::GetGameContext()->GetActorManager()->GetNetTimeOffset(ar_net_source_id));
-        if (oob->time > rnow + 100)
+        if (oob->time > rnow + App::mp_net_playout_delay->getInt())
         {
             App::GetGameContext()->GetActorManager()->UpdateNetTimeOffset(ar_net_source_id, oob->time - rnow);
         }
     }
 
-    m_net_updates.push_back(update);
+    m_net_updates.push_back(std::move(update));
 #endif // USE_SOCKETW
 }
 
 void Actor::calcNetwork()
 {
+    ROR_PROFILE_ZONE("Actor::calcNetwork", ar_instance_id);
     using namespace RoRnet;
 
+    m_net_nodes_updated = false;
+
     if (m_net_updates.size() < 2)
         return;
 
@@ -492,6 +522,14 @@ void Actor::calcNetwork()
     VehicleState* oob2 = (VehicleState*)m_net_updates[index_offset + 1].veh_state.data();
     char*        netb1 = (char*)        m_net_updates[index_offset    ].node_data.data();
     char*        netb2 = (char*)        m_net_updates[index_offset + 1].node_data.data();
+    // Neighbour snapshots for the spline tangents; fall back to the segment ends if unavailable
+    NetUpdate const& prev = (index_offset > 0) ? m_net_updates[index_offset - 1] :
+                            (!m_net_prev_update.node_data.empty()) ? m_net_prev_update : m_net_updates[index_offset];
+    NetUpdate const& next = (index_offset + 2 < (int)m_net_updates.size()) ? m_net_updates[index_offset + 2] : m_net_updates[index_offset + 1];
+    VehicleState* oob0 = (VehicleState*)prev.veh_state.data();
+    VehicleState* oob3 = (VehicleState*)next.veh_state.data();
+    char*        netb0 = (char*)        prev.node_data.data();
+    char*        netb3 = (char*)        next.node_data.data();
     float*     net_rp1 = (float*)       m_net_updates[index_offset    ].wheel_data.data();
     float*     net_rp2 = (float*)       m_net_updates[index_offset + 1].wheel_data.data();
 
@@ -499,7 +537,9 @@ void Actor::calcNetwork()
 
     if (tratio > 4.0f)
     {
+        ar_net_num_dropped_updates += m_net_updates.size();
         m_net_updates.clear();
+        m_net_prev_update = NetUpdate();
         return; // Wait for new data
     }
     else if (tratio > 1.0f)
@@ -511,92 +551,112 @@ void Actor::calcNetwork()
         App::GetGameContext()->GetActorManager()->UpdateNetTimeOffset(ar_net_source_id, +1);
     }
 
-    short* sp1 = (short*)(netb1 + sizeof(float) * 3);
-    short* sp2 = (short*)(netb2 + sizeof(float) * 3);
-    Vector3 p1ref = Vector3::ZERO;
-    Vector3 p2ref = Vector3::ZERO;
-    Vector3 p1 = Vector3::ZERO;
-    Vector3 p2 = Vector3::ZERO;
-
-    for (int i = 0; i < m_net_first_wheel_node; i++)
+    // Decodes a node position; the first node is uncompressed, all others are
+    // short ints relative to the first node.
+    auto decode_node = [this](const char* netb, int i) -> Vector3
     {
-        if (i == 0)
+        const float* ref = (const float*)netb;
+        Vector3 pos(ref[0], ref[1], ref[2]);
+        if (i > 0)
         {
-            // first node is uncompressed
-            p1.x = ((float*)netb1)[0];
-            p1.y = ((float*)netb1)[1];
-            p1.z = ((float*)netb1)[2];
-            p1ref = p1;
-
-            p2.x = ((float*)netb2)[0];
-            p2.y = ((float*)netb2)[1];
-            p2.z = ((float*)netb2)[2];
-            p2ref = p2;
+            const short* sp = (const short*)(netb + sizeof(float) * 3);
+            pos.x += (float)(sp[(i - 1) * 3 + 0]) / m_net_node_compression;
+            pos.y += (float)(sp[(i - 1) * 3 + 1]) / m_net_node_compression;
+            pos.z += (float)(sp[(i - 1) * 3 + 2]) / m_net_node_compression;
         }
-        else
+        return pos;
+    };
+
+    // Cubic Hermite weights; tangents are Catmull-Rom style, rescaled to the
+    // [oob1, oob2] segment so uneven send intervals don't overshoot.
+    const float seg_ms = (float)(oob2->time - oob1->time);
+    const bool  has_prev = (oob0->time < oob1->time);
+    const bool  has_next = (oob3->time > oob2->time);
+    const float k1 = (has_prev) ? seg_ms / (float)(oob2->time - oob0->time) : 1.f;
+    const float k2 = (has_next) ? seg_ms / (float)(oob3->time - oob1->time) : 1.f;
+
+    // Beyond the last snapshot, dead-reckon linearly but only for a limited time
+    const bool  extrapolate = (tratio > 1.0f);
+    if (extrapolate && !m_net_extrapolating)
+    {
+        ar_net_num_late_updates++;
+    }
+    m_net_extrapolating = extrapolate;
+    const float s = (extrapolate) ? 1.0f + std::min(tratio - 1.0f, NET_MAX_EXTRAPOLATION_MS / seg_ms) : std::max(0.0f, tratio);
+    const float s2 = s * s;
+    const float s3 = s2 * s;
+    const float h00 = 2.f * s3 - 3.f * s2 + 1.f;
+    const float h10 = s3 - 2.f * s2 + s;
+    const float h01 = -2.f * s3 + 3.f * s2;
+    const float h11 = s3 - s2;
+
+    // At reduced detail, nodes only move when a new update is reached; the VehicleState is still interpolated below
+    m_net_nodes_updated = !m_net_reduced_detail || index_offset > 0 || !m_net_initialized;
+    if (m_net_nodes_updated)
+    {
+        for (int i = 0; i < m_net_first_wheel_node; i++)
         {
-            // all other nodes are compressed:
-            // short int compared to previous node
-            p1.x = (float)(sp1[(i - 1) * 3 + 0]) / m_net_node_compression;
-            p1.y = (float)(sp1[(i - 1) * 3 + 1]) / m_net_node_compression;
-            p1.z = (float)(sp1[(i - 1) * 3 + 2]) / m_net_node_compression;
-            p1 = p1 + p1ref;
-
-            p2.x = (float)(sp2[(i - 1) * 3 + 0]) / m_net_node_compression;
-            p2.y = (float)(sp2[(i - 1) * 3 + 1]) / m_net_node_compression;
-            p2.z = (float)(sp2[(i - 1) * 3 + 2]) / m_net_node_compression;
-            p2 = p2 + p2ref;
-        }
+            const Vector3 p1 = decode_node(netb1, i);
+            const Vector3 p2 = decode_node(netb2, i);
 
-        // linear interpolation
-        ar_nodes[i].AbsPosition = p1 + tratio * (p2 - p1);
-        ar_nodes[i].RelPosition = ar_nodes[i].AbsPosition - ar_origin;
-        ar_nodes[i].Velocity    = (p2 - p1) * 1000.0f / (float)(oob2->time - oob1->time);
-    }
+            if (extrapolate)
+            {
+                ar_nodes[i].AbsPosition = p1 + s * (p2 - p1);
+            }
+            else
+            {
+                const Vector3 m1 = (has_prev) ? (p2 - decode_node(netb0, i)) * k1 : (p2 - p1);
+                const Vector3 m2 = (has_next) ? (decode_node(netb3, i) - p1) * k2 : (p2 - p1);
+                ar_nodes[i].AbsPosition = h00 * p1 + h10 * m1 + h01 * p2 + h11 * m2;
+            }
+            ar_nodes[i].RelPosition = ar_nodes[i].AbsPosition - ar_origin;
+            ar_nodes[i].Velocity    = (p2 - p1) * 1000.0f / seg_ms;
+        }
 
-    for (int i = 0; i < ar_num_wheels; i++)
-    {
-        float rp = net_rp1[i] + tratio * (net_rp2[i] - net_rp1[i]);
-        //compute ideal positions
-        Vector3 axis = ar_wheels[i].wh_axis_node_1->RelPosition - ar_wheels[i].wh_axis_node_0->RelPosition;
-        axis.normalise();
-        Plane pplan = Plane(axis, ar_wheels[i].wh_axis_node_0->AbsPosition);
-        Vector3 ortho = -pplan.projectVector(ar_wheels[i].wh_near_attach_node->AbsPosition) - ar_wheels[i].wh_axis_node_0->AbsPosition;
-        Vector3 ray = ortho.crossProduct(axis);
-        ray.normalise();
-        ray *= ar_wheels[i].wh_radius;
-        float drp = Math::TWO_PI / (ar_wheels[i].wh_num_nodes / 2);
-        for (int j = 0; j < ar_wheels[i].wh_num_nodes / 2; j++)
+        for (int i = 0; i < ar_num_wheels; i++)
         {
-            Vector3 uray = Quaternion(Radian(rp - drp * j), axis) * ray;
+            float rp = net_rp1[i] + s * (net_rp2[i] - net_rp1[i]);
+            //compute ideal positions
+            Vector3 axis = ar_wheels[i].wh_axis_node_1->RelPosition - ar_wheels[i].wh_axis_node_0->RelPosition;
+            axis.normalise();
+            Plane pplan = Plane(axis, ar_wheels[i].wh_axis_node_0->AbsPosition);
+            Vector3 ortho = -pplan.projectVector(ar_wheels[i].wh_near_attach_node->AbsPosition) - ar_wheels[i].wh_axis_node_0->AbsPosition;
+            Vector3 ray = ortho.crossProduct(axis);
+            ray.normalise();
+            ray *= ar_wheels[i].wh_radius;
+            float drp = Math::TWO_PI / (ar_wheels[i].wh_num_nodes / 2);
+            for (int j = 0; j < ar_wheels[i].wh_num_nodes / 2; j++)
+            {
+                Vector3 uray = Quaternion(Radian(rp - drp * j), axis) * ray;
 
-            ar_wheels[i].wh_nodes[j * 2 + 0]->AbsPosition = ar_wheels[i].wh_axis_node_0->AbsPosition + uray;
-            ar_wheels[i].wh_nodes[j * 2 + 0]->RelPosition = ar_wheels[i].wh_nodes[j * 2]->AbsPosition - ar_origin;
+                ar_wheels[i].wh_nodes[j * 2 + 0]->AbsPosition = ar_wheels[i].wh_axis_node_0->AbsPosition + uray;
+                ar_wheels[i].wh_nodes[j * 2 + 0]->RelPosition = ar_wheels[i].wh_nodes[j * 2]->AbsPosition - ar_origin;
 
-            ar_wheels[i].wh_nodes[j * 2 + 1]->AbsPosition = ar_wheels[i].wh_axis_node_1->AbsPosition + uray;
-            ar_wheels[i].wh_nodes[j * 2 + 1]->RelPosition = ar_wheels[i].wh_nodes[j * 2 + 1]->AbsPosition - ar_origin;
-        }
-        ray.normalise();
-        ray *= ar_wheels[i].wh_rim_radius;
-        for (int j = 0; j < ar_wheels[i].wh_num_rim_nodes / 2; j++)
-        {
-            Vector3 uray = Quaternion(Radian(rp - drp * j), axis) * ray;
+                ar_wheels[i].wh_nodes[j * 2 + 1]->AbsPosition = ar_wheels[i].wh_axis_node_1->AbsPosition + uray;
+                ar_wheels[i].wh_nodes[j * 2 + 1]->RelPosition = ar_wheels[i].wh_nodes[j * 2 + 1]->AbsPosition - ar_origin;
+            }
+            ray.normalise();
+            ray *= ar_wheels[i].wh_rim_radius;
+            for (int j = 0; j < ar_wheels[i].wh_num_rim_nodes / 2; j++)
+            {
+                Vector3 uray = Quaternion(Radian(rp - drp * j), axis) * ray;
 
-            ar_wheels[i].wh_rim_nodes[j * 2 + 0]->AbsPosition = ar_wheels[i].wh_axis_node_0->AbsPosition + uray;
-            ar_wheels[i].wh_rim_nodes[j * 2 + 0]->RelPosition = ar_wheels[i].wh_rim_nodes[j * 2]->AbsPosition - ar_origin;
+                ar_wheels[i].wh_rim_nodes[j * 2 + 0]->AbsPosition = ar_wheels[i].wh_axis_node_0->AbsPosition + uray;
+                ar_wheels[i].wh_rim_nodes[j * 2 + 0]->RelPosition = ar_wheels[i].wh_rim_nodes[j * 2]->AbsPosition - ar_origin;
 
-            ar_wheels[i].wh_rim_nodes[j * 2 + 1]->AbsPosition = ar_wheels[i].wh_axis_node_1->AbsPosition + uray;
-            ar_wheels[i].wh_rim_nodes[j * 2 + 1]->RelPosition = ar_wheels[i].wh_rim_nodes[j * 2 + 1]->AbsPosition - ar_origin;
+                ar_wheels[i].wh_rim_nodes[j * 2 + 1]->AbsPosition = ar_wheels[i].wh_axis_node_1->AbsPosition + uray;
+                ar_wheels[i].wh_rim_nodes[j * 2 + 1]->RelPosition = ar_wheels[i].wh_rim_nodes[j * 2 + 1]->AbsPosition - ar_origin;
+            }
         }
+        this->UpdateBoundingBoxes();
+        this->calculateAveragePosition();
     }
-    this->UpdateBoundingBoxes();
-    this->calculateAveragePosition();
 
-    float engspeed = oob1->engine_speed + tratio * (oob2->engine_speed - oob1->engine_speed);
-    float engforce = oob1->engine_force + tratio * (oob2->engine_force - oob1->engine_force);
-    float engclutch = oob1->engine_clutch + tratio * (oob2->engine_clutch - oob1->engine_clutch);
-    float netwspeed = oob1->wheelspeed + tratio * (oob2->wheelspeed - oob1->wheelspeed);
-    float netbrake = oob1->brake + tratio * (oob2->brake - oob1->brake);
+    float engspeed = oob1->engine_speed + s * (oob2->engine_speed - oob1->engine_speed);
+    float engforce = oob1->engine_force + s * (oob2->engine_force - oob1->engine_force);
+    float engclutch = oob1->engine_clutch + s * (oob2->engine_clutch - oob1->engine_clutch);
+    float netwspeed = oob1->wheelspeed + s * (oob2->wheelspeed - oob1->wheelspeed);
+    float netbrake = oob1->brake + s * (oob2->brake - oob1->brake);
 
     ar_hydro_dir_wheel_display = oob1->hydrodirstate;
     ar_wheel_speed = netwspeed;
@@ -654,8 +714,13 @@ void Actor::calcNetwork()
     else
         SOUND_STOP(ar_instance_id, SS_TRIG_REVERSE_GEAR);
 
+    if (index_offset > 0)
+    {
+        std::swap(m_net_prev_update, m_net_updates[index_offset - 1]); // Keep for the next spline tangent
+    }
     for (int i = 0; i < index_offset; i++)
     {
+        m_net_update_pool.push_back(std::move(m_net_updates.front()));
         m_net_updates.pop_front();
     }
 
@@ -772,46 +837,6 @@ float Actor::getTotalMass(bool withLocked)
     return mass;
 }
 
-void Actor::DetermineLinkedActors()
-{
-    // This updates `ar_linked_actors` by searching (iteratively) through global `inter_actor_links` list.
-    // --------------------------------------------------------------------------------------------------
-    ar_linked_actors.clear();
-
-    bool found = true;
-    std::map<ActorPtr, bool> lookup_table; // tracks visited actors
-
-    lookup_table.insert(std::pair<ActorPtr, bool>(this, false));
-
-    while (found)
-    {
-        found = false;
-
-        for (auto it_actor = lookup_table.begin(); it_actor != lookup_table.end(); ++it_actor)
-        {
-            if (!it_actor->second) // not visited yet?
-            {
-                ActorPtr actor = it_actor->first;
-                for (auto inter_actor_link: App::GetGameContext()->GetActorManager()->inter_actor_links)
-                {
-                    auto actor_pair = inter_actor_link.second;
-                    if (actor == actor_pair.first || actor == actor_pair.second)
-                    {
-                        auto other_actor = (actor != actor_pair.first) ? actor_pair.first : actor_pair.second;
-                        auto ret = lookup_table.insert(std::pair<ActorPtr, bool>(other_actor, false));
-                        if (ret.second)
-                        {
-                            ar_linked_actors.push_back(other_actor);
-                            found = true;
-                        }
-                    }
-                }
-                it_actor->second = true; // mark visited
-            }
-        }
-    }
-}
-
 int Actor::getWheelNodeCount() const
 {
     return m_wheel_node_count;
@@ -836,7 +861,7 @@ void Actor::calcNodeConnectivityGraph()
     }
 }
 
-bool Actor::Intersects(ActorPtr actor, Vector3 offset)
+bool Actor::Intersects(const ActorPtr& actor, Vector3 offset)
 {
     Vector3 bb_min = ar_bounding_box.getMinimum() + offset;
     Vector3 bb_max = ar_bounding_box.getMaximum() + offset;
@@ -1111,6 +1136,12 @@ inline void PadBoundingBox(Ogre::AxisAlignedBox& box) // Internal helper
     box.setMaximum(box.getMaximum() + BOUNDING_BOX_PADDING);
 }
 
+inline bool IsWithinReach(Ogre::AxisAlignedBox const& box, Ogre::Vector3 const& pos, float radius) // Internal helper
+{
+    // Broad phase for lock searches: can any node inside `box` be closer than `radius` to `pos`?
+    return !box.isFinite() || box.squaredDistance(pos) < radius * radius;
+}
+
 void Actor::UpdateBoundingBoxes()
 {
     // Reset
@@ -1174,6 +1205,113 @@ void Actor::UpdatePhysicsOrigin()
     }
 }
 
+bool Actor::EnterRigidProxy()
+{
+    m_proxy_contact_nodes.clear();
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        if (ar_nodes[i].nd_has_ground_contact)
+            m_proxy_contact_nodes.push_back(i);
+    }
+    if (m_proxy_contact_nodes.empty())
+        return false;
+
+    m_proxy_contact_pos.resize(m_proxy_contact_nodes.size());
+    m_proxy_contact_heights.resize(m_proxy_contact_nodes.size());
+    for (size_t i = 0; i < m_proxy_contact_nodes.size(); i++)
+    {
+        m_proxy_contact_pos[i] = ar_nodes[m_proxy_contact_nodes[i]].AbsPosition;
+    }
+    App::GetGameContext()->GetTerrain()->GetHeightsAt(m_proxy_contact_pos.data(), m_proxy_contact_pos.size(), sizeof(Vector3), m_proxy_contact_heights.data());
+
+    m_proxy_clearance = 0.f;
+    for (size_t i = 0; i < m_proxy_contact_nodes.size(); i++)
+    {
+        m_proxy_clearance += m_proxy_contact_pos[i].y - m_proxy_contact_heights[i];
+    }
+    m_proxy_clearance /= m_proxy_contact_nodes.size();
+
+    m_proxy_velocity = m_avg_node_velocity;
+    m_proxy_velocity.y = 0.f;
+    ar_rigid_proxy = true;
+    return true;
+}
+
+void Actor::LeaveRigidProxy()
+{
+    // The softbody picks up where the proxy left off; the suspension settles within a few steps
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        ar_nodes[i].Velocity = m_proxy_velocity;
+        ar_nodes[i].Forces = Vector3::ZERO;
+    }
+    m_avg_node_position_prev = m_avg_node_position;
+    ar_rigid_proxy = false;
+}
+
+void Actor::UpdateRigidProxy(float dt)
+{
+    const float MAX_YAW_RATE = 0.5f; // rad/s
+    const float MAX_ACCEL = 2.f;     // m/s^2
+
+    // Follow the AI: turn towards its waypoint, keep the speed, stop when it waits.
+    // The AI itself still runs and advances the waypoints as the actor moves.
+    float yaw = 0.f;
+    float speed = m_proxy_velocity.length();
+    float target_speed = speed;
+    if (ar_vehicle_ai && ar_vehicle_ai->isActive())
+    {
+        Vector3 to_waypoint = ar_vehicle_ai->GetCurrentWaypoint() - m_avg_node_position;
+        to_waypoint.y = 0.f;
+        if (speed > 0.1f && to_waypoint.squaredLength() > 1.f)
+        {
+            const float heading = std::atan2(m_proxy_velocity.x, m_proxy_velocity.z);
+            const float bearing = std::atan2(to_waypoint.x, to_waypoint.z);
+            const float error = bearing - heading;
+            const float wrapped = std::atan2(std::sin(error), std::cos(error));
+            yaw = Math::Clamp(wrapped, -MAX_YAW_RATE * dt, MAX_YAW_RATE * dt);
+        }
+        if (ar_vehicle_ai->IsWaiting())
+        {
+            target_speed = 0.f;
+        }
+    }
+    speed += Math::Clamp(target_speed - speed, -MAX_ACCEL * dt, MAX_ACCEL * dt);
+
+    const Quaternion rotation(Radian(yaw), Vector3::UNIT_Y);
+    if (m_proxy_velocity.squaredLength() > 0.f)
+    {
+        m_proxy_velocity = rotation * m_proxy_velocity.normalisedCopy() * speed;
+    }
+    const Vector3 pivot = m_avg_node_position;
+    const Vector3 translation = m_proxy_velocity * dt;
+
+    // Keep the contact nodes at their clearance above the terrain
+    for (size_t i = 0; i < m_proxy_contact_nodes.size(); i++)
+    {
+        m_proxy_contact_pos[i] = pivot + rotation * (ar_nodes[m_proxy_contact_nodes[i]].AbsPosition - pivot) + translation;
+    }
+    App::GetGameContext()->GetTerrain()->GetHeightsAt(m_proxy_contact_pos.data(), m_proxy_contact_pos.size(), sizeof(Vector3), m_proxy_contact_heights.data());
+    float clearance = 0.f;
+    for (size_t i = 0; i < m_proxy_contact_nodes.size(); i++)
+    {
+        clearance += m_proxy_contact_pos[i].y - m_proxy_contact_heights[i];
+    }
+    clearance /= m_proxy_contact_nodes.size();
+    const Vector3 offset = translation + Vector3(0.f, m_proxy_clearance - clearance, 0.f);
+
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        ar_nodes[i].AbsPosition = pivot + rotation * (ar_nodes[i].AbsPosition - pivot) + offset;
+        ar_nodes[i].RelPosition = ar_nodes[i].AbsPosition - ar_origin;
+    }
+
+    this->UpdateBoundingBoxes();
+    this->calculateAveragePosition();
+    m_avg_node_velocity = m_proxy_velocity;
+    m_avg_node_position_prev = m_avg_node_position;
+}
+
 void Actor::ResetAngle(float rot)
 {
     // Set origin of rotation to camera node
@@ -1549,6 +1687,7 @@ void Actor::SyncReset(bool reset_position)
     TRIGGER_EVENT_ASYNC(SE_TRUCK_RESET, ar_instance_id);
 
     m_reset_timer.reset();
+    ar_rigid_proxy = false; // Softbody again; `ActorManager::UpdatePhysicsLod()` decides anew
 
     m_camera_local_gforces_cur = Vector3::ZERO;
     m_camera_local_gforces_max = Vector3::ZERO;
@@ -1719,6 +1858,14 @@ void Actor::SyncReset(bool reset_position)
 }
 
 void Actor::applyNodeBeamScales()
+{
+    this->applyNodeMassScale();
+    this->applyBeamGroupScale(ar_nb_plain_beams, ar_nb_beams_scale);
+    this->applyBeamGroupScale(ar_nb_shock_beams, ar_nb_shocks_scale);
+    this->applyBeamGroupScale(ar_nb_wheel_beams, ar_nb_wheels_scale);
+}
+
+void Actor::applyNodeMassScale()
 {
     for (int i = 0; i < ar_num_nodes; i++)
     {
@@ -1726,25 +1873,14 @@ void Actor::applyNodeBeamScales()
     }
 
     m_total_mass = ar_initial_total_mass * ar_nb_mass_scale;
+}
 
-    for (int i = 0; i < ar_num_beams; i++)
+void Actor::applyBeamGroupScale(std::vector<int> const& beams, std::pair<float, float> const& scale)
+{
+    for (int i: beams)
     {
-        if ((ar_beams[i].p1->nd_tyre_node || ar_beams[i].p1->nd_rim_node) ||
-            (ar_beams[i].p2->nd_tyre_node || ar_beams[i].p2->nd_rim_node))
-        {
-            ar_beams[i].k = ar_initial_beam_defaults[i].first * ar_nb_wheels_scale.first;
-            ar_beams[i].d = ar_initial_beam_defaults[i].second * ar_nb_wheels_scale.second;
-        }
-        else if (ar_beams[i].bounded == SHOCK1 || ar_beams[i].bounded == SHOCK2 || ar_beams[i].bounded == SHOCK3)
-        {
-            ar_beams[i].k = ar_initial_beam_defaults[i].first * ar_nb_shocks_scale.first;;
-            ar_beams[i].d = ar_initial_beam_defaults[i].second * ar_nb_shocks_scale.second;
-        }
-        else
-        {
-            ar_beams[i].k = ar_initial_beam_defaults[i].first * ar_nb_beams_scale.first;
-            ar_beams[i].d = ar_initial_beam_defaults[i].second * ar_nb_beams_scale.second;
-        }
+        ar_beams[i].k = ar_initial_beam_defaults[i].first * scale.first;
+        ar_beams[i].d = ar_initial_beam_defaults[i].second * scale.second;
     }
 }
 
@@ -1933,7 +2069,7 @@ void Actor::sendStreamData()
 {
     using namespace RoRnet;
 #ifdef USE_SOCKETW
-    if (ar_net_timer.getMilliseconds() - ar_net_last_update_time < 100)
+    if (ar_net_timer.getMilliseconds() - ar_net_last_update_time < m_net_send_interval_ms)
         return;
 
     ar_net_last_update_time = ar_net_timer.getMilliseconds();
@@ -1941,8 +2077,16 @@ void Actor::sendStreamData()
     //look if the packet is too big first
     if (m_net_total_buffer_size + sizeof(RoRnet::VehicleState) > RORNET_MAX_MESSAGE_LENGTH)
     {
-        ErrorUtils::ShowError(_L("Actor is too big to be sent over the net."), _L("Network error!"));
-        exit(126);
+        // Keep playing; the actor just won't move for other players
+        if (!m_net_too_big_reported)
+        {
+            Str<400> text;
+            text << _L("Actor is too big to be sent over the net: ") << ar_filename
+                 << " (" << (int)(m_net_total_buffer_size + sizeof(RoRnet::VehicleState)) << "/" << RORNET_MAX_MESSAGE_LENGTH << " bytes)";
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_WARNING, text.ToCStr());
+            m_net_too_big_reported = true;
+        }
+        return;
     }
 
     char send_buffer[8192] = {0};
@@ -2164,14 +2308,14 @@ void Actor::CalcAnimators(hydrobeam_t const& hydrobeam, float &cstate, int &div)
         if (ar_anim_shift_timer > 0.0f)
         {
             cstate = 1.0f;
-            ar_anim_shift_timer -= PHYSICS_DT;
+            ar_anim_shift_timer -= ar_step_dt;
             if (ar_anim_shift_timer < 0.0f)
                 ar_anim_shift_timer = 0.0f;
         }
         if (ar_anim_shift_timer < 0.0f)
         {
             cstate = -1.0f;
-            ar_anim_shift_timer += PHYSICS_DT;
+            ar_anim_shift_timer += ar_step_dt;
             if (ar_anim_shift_timer > 0.0f)
                 ar_anim_shift_timer = 0.0f;
         }
@@ -2458,6 +2602,8 @@ void Actor::CalcAnimators(hydrobeam_t const& hydrobeam, float &cstate, int &div)
 
 void Actor::CalcCabCollisions()
 {
+    ROR_PROFILE_ZONE("Actor::CalcCabCollisions", ar_instance_id);
+
     for (int i = 0; i < ar_num_nodes; i++)
     {
         ar_nodes[i].nd_has_mesh_contact = false;
@@ -2465,7 +2611,7 @@ void Actor::CalcCabCollisions()
     if (m_intra_point_col_detector != nullptr)
     {
         m_intra_point_col_detector->UpdateIntraPoint();
-        ResolveIntraActorCollisions(PHYSICS_DT,
+        ResolveIntraActorCollisions(ar_step_dt,
             *m_intra_point_col_detector,
             ar_num_collcabs,
             ar_collcabs,
@@ -2473,7 +2619,8 @@ void Actor::CalcCabCollisions()
             ar_intra_collcabrate,
             ar_nodes,
             ar_collision_range,
-            *ar_submesh_ground_model);
+            *ar_submesh_ground_model,
+            (App::sim_cab_bvh->getBool()) ? &m_cab_bvh : nullptr);
     }
 }
 
@@ -2624,7 +2771,7 @@ void Actor::CalcTriggers(int i, Real difftoBeamL, bool trigger_hooks)
 {
     if ((ar_beams[i].shock->flags & SHOCK_FLAG_ISTRIGGER) && ar_beams[i].shock->trigger_enabled) // this is a trigger and its enabled
     {
-        const float dt = PHYSICS_DT;
+        const float dt = ar_step_dt;
 
         if (difftoBeamL > ar_beams[i].longbound * ar_beams[i].L || difftoBeamL < -ar_beams[i].shortbound * ar_beams[i].L) // that has hit boundary
         {
@@ -2908,7 +3055,7 @@ void Actor::updateSkidmarks()
             }
             if (n->nd_avg_collision_slip > 6.f && n->nd_last_collision_slip.squaredLength() > 9.f)
             {
-                m_skid_trails[i]->update(n->AbsPosition, j, n->nd_avg_collision_slip, n->nd_last_collision_gm->name);
+                m_skid_trails[i]->update(n->AbsPosition, j, n->nd_avg_collision_slip, *n->nd_last_collision_gm);
                 return;
             }
         }
@@ -3150,7 +3297,7 @@ void Actor::toggleCustomParticles()
         ar_custom_particles[i].active = !ar_custom_particles[i].active;
         for (int j = 0; j < ar_custom_particles[i].psys->getNumEmitters(); j++)
         {
-            ar_custom_particles[i].psys->getEmitter(j)->setEnabled(ar_custom_particles[i].active);
+            ar_custom_particles[i].psys->getEmitter(j)->setEnabled(ar_custom_particles[i].active && !ar_custom_particles[i].culled);
         }
     }
 
@@ -3199,11 +3346,18 @@ void Actor::updateVisual(float dt)
     // TODO: Move to GfxActor, don't forget dt*m_simulation_speed
     if (ar_engine && exhausts.size() > 0)
     {
+        const float cull_dist = App::gfx_particles_cull_distance->getFloat();
+        const Vector3 cam_pos = App::GetCameraManager()->GetCameraNode()->getPosition();
         std::vector<exhaust_t>::iterator it;
         for (it = exhausts.begin(); it != exhausts.end(); it++)
         {
             if (!it->smoker)
                 continue;
+            if (cull_dist > 0.f && ar_nodes[it->emitterNode].AbsPosition.squaredDistance(cam_pos) > cull_dist * cull_dist)
+            {
+                it->smoker->getEmitter(0)->setEnabled(false); // Too far to see the smoke
+                continue;
+            }
             Vector3 dir = ar_nodes[it->emitterNode].AbsPosition - ar_nodes[it->directionNode].AbsPosition;
             //			dir.normalise();
             ParticleEmitter* emit = it->smoker->getEmitter(0);
@@ -3295,13 +3449,17 @@ void Actor::AddInterActorBeam(beam_t* beam, ActorPtr a, ActorPtr b)
     std::pair<ActorPtr, ActorPtr> actor_pair(a, b);
     App::GetGameContext()->GetActorManager()->inter_actor_links[beam] = actor_pair;
 
-    a->DetermineLinkedActors();
-    for (ActorPtr& actor : a->ar_linked_actors)
-        actor->DetermineLinkedActors();
+    // A freshly hooked/tied actor must not stay asleep, the new beam would pull on a frozen body
+    for (ActorPtr actor : { a, b })
+    {
+        if (actor->ar_state == ActorState::LOCAL_SLEEPING)
+        {
+            actor->ar_state = ActorState::LOCAL_SIMULATED;
+        }
+        actor->ar_sleep_counter = 0.0f;
+    }
 
-    b->DetermineLinkedActors();
-    for (ActorPtr& actor : b->ar_linked_actors)
-        actor->DetermineLinkedActors();
+    App::GetGameContext()->GetActorManager()->MergeLinkedGroups(a, b);
 }
 
 void Actor::RemoveInterActorBeam(beam_t* beam)
@@ -3317,14 +3475,7 @@ void Actor::RemoveInterActorBeam(beam_t* beam)
     {
         auto actor_pair = it->second;
         App::GetGameContext()->GetActorManager()->inter_actor_links.erase(it);
-
-        actor_pair.first->DetermineLinkedActors();
-        for (ActorPtr& actor : actor_pair.first->ar_linked_actors)
-            actor->DetermineLinkedActors();
-
-        actor_pair.second->DetermineLinkedActors();
-        for (ActorPtr& actor : actor_pair.second->ar_linked_actors)
-            actor->DetermineLinkedActors();
+        App::GetGameContext()->GetActorManager()->SplitLinkedGroup(actor_pair.first);
     }
 }
 
@@ -3332,6 +3483,7 @@ void Actor::DisjoinInterActorBeams()
 {
     ar_inter_beams.clear();
     auto inter_actor_links = &App::GetGameContext()->GetActorManager()->inter_actor_links;
+    ActorPtr unlinked_actor; // Any actor from our group; all links are gone before the group is split
     for (auto it = inter_actor_links->begin(); it != inter_actor_links->end();)
     {
         auto actor_pair = it->second;
@@ -3341,20 +3493,17 @@ void Actor::DisjoinInterActorBeams()
             it->first->bm_inter_actor = false;
             it->first->bm_disabled = true;
             inter_actor_links->erase(it++);
-
-            actor_pair.first->DetermineLinkedActors();
-            for (ActorPtr& actor : actor_pair.first->ar_linked_actors)
-                actor->DetermineLinkedActors();
-
-            actor_pair.second->DetermineLinkedActors();
-            for (ActorPtr& actor : actor_pair.second->ar_linked_actors)
-                actor->DetermineLinkedActors();
+            unlinked_actor = actor_pair.first;
         }
         else
         {
             ++it;
         }
     }
+    if (unlinked_actor != nullptr)
+    {
+        App::GetGameContext()->GetActorManager()->SplitLinkedGroup(unlinked_actor);
+    }
 }
 
 void Actor::tieToggle(int group)
@@ -3413,7 +3562,8 @@ void Actor::tieToggle(int group)
                 for (ActorPtr& actor : App::GetGameContext()->GetActorManager()->GetActors())
                 {
                     if (actor->ar_state == ActorState::LOCAL_SLEEPING ||
-                        (actor == this && it->ti_no_self_lock))
+                        (actor == this && it->ti_no_self_lock) ||
+                        !IsWithinReach(actor->ar_bounding_box, it->ti_beam->p1->AbsPosition, mindist))
                     {
                         continue;
                     }
@@ -3507,6 +3657,8 @@ void Actor::ropeToggle(int group)
             {
                 if (actor->ar_state == ActorState::LOCAL_SLEEPING)
                     continue;
+                if (!IsWithinReach(actor->ar_bounding_box, it->rp_beam->p1->AbsPosition, mindist))
+                    continue;
                 // and their ropables
                 for (std::vector<ropable_t>::iterator itr = actor->ar_ropables.begin(); itr != actor->ar_ropables.end(); itr++)
                 {
@@ -3602,6 +3754,8 @@ void Actor::hookToggle(int group, HookAction mode, NodeNum_t mousenode /*=NODENU
                     continue;
                 if (this == actor.GetRef() && !it->hk_selflock)
                     continue; // don't lock to self
+                if (!IsWithinReach(actor->ar_bounding_box, it->hk_hook_node->AbsPosition, mindist))
+                    continue; // no node of this actor is in range
 
                 node_t* nearest_node = nullptr;
                 for (int i = 0; i < actor->ar_num_nodes; i++)
@@ -4317,6 +4471,7 @@ Actor::Actor(
     , ar_nb_shocks_d_interval(std::make_pair(0.1f, 8.0f))
     , ar_nb_wheels_k_interval(std::make_pair(1.0f, 1.0f))
     , ar_nb_wheels_d_interval(std::make_pair(1.0f, 1.0f))
+    , ar_step_dt(PHYSICS_DT)
 
     // Constructor parameters
     , m_avg_node_position_prev(rq.asr_position)
@@ -4324,6 +4479,8 @@ Actor::Actor(
     , m_avg_node_position(rq.asr_position)
     , ar_instance_id(actor_id)
     , ar_vector_index(vector_index)
+    , ar_linked_group(actor_id)
+    , m_turbulence_seed(actor_id * 2 + 1) // Must be odd, see `frand_11()`
     , m_avg_proped_wheel_radius(0.2f)
     , ar_filename(rq.asr_filename)
     , m_section_config(rq.asr_config)
@@ -4476,6 +4633,59 @@ Replay* Actor::getReplay()
         return nullptr;
 }
 
+template <typename T>
+static size_t VectorBytes(std::vector<T> const& v)
+{
+    return v.capacity() * sizeof(T);
+}
+
+ActorMemoryUsage Actor::GetMemoryUsage()
+{
+    ActorMemoryUsage usage;
+
+    usage.amu_simulation = sizeof(Actor) + m_sim_arena_size
+        + VectorBytes(ar_minimass) + VectorBytes(ar_inter_beams) + VectorBytes(ar_ropes) + VectorBytes(ar_ropables)
+        + VectorBytes(ar_ties) + VectorBytes(ar_hooks) + VectorBytes(ar_flares) + VectorBytes(ar_hydros)
+        + VectorBytes(ar_initial_node_masses) + VectorBytes(ar_initial_node_positions) + VectorBytes(ar_initial_beam_defaults)
+        + VectorBytes(ar_collision_bounding_boxes) + VectorBytes(ar_predicted_coll_bounding_boxes)
+        + VectorBytes(m_slidenodes) + VectorBytes(m_plain_beams) + VectorBytes(m_bounded_beams)
+        + VectorBytes(m_ground_heights) + VectorBytes(m_buoycab_nodes) + VectorBytes(m_node_wave_heights);
+    for (std::vector<int> const& connections: ar_node_to_node_connections)
+        usage.amu_simulation += VectorBytes(connections);
+    for (std::vector<int> const& connections: ar_node_to_beam_connections)
+        usage.amu_simulation += VectorBytes(connections);
+    for (std::vector<Ogre::Vector3> const& forces: m_beam_batch_forces)
+        usage.amu_simulation += VectorBytes(forces);
+
+    if (m_replay_handler)
+    {
+        usage.amu_replay = m_replay_handler->GetMemoryUsage();
+    }
+
+    if (m_gfx_actor)
+    {
+        std::set<Ogre::Mesh*> meshes;
+        for (FlexBody* fb: m_gfx_actor->GetFlexbodies())
+        {
+            usage.amu_flexbodies += fb->GetMemoryUsage();
+            meshes.insert(fb->getEntity()->getMesh().get());
+        }
+        for (Prop& prop: m_gfx_actor->getProps())
+        {
+            if (prop.pp_mesh_obj && prop.pp_mesh_obj->getEntity())
+                meshes.insert(prop.pp_mesh_obj->getEntity()->getMesh().get());
+            if (prop.pp_wheel_mesh_obj && prop.pp_wheel_mesh_obj->getEntity())
+                meshes.insert(prop.pp_wheel_mesh_obj->getEntity()->getMesh().get());
+        }
+        for (Ogre::Mesh* mesh: meshes)
+        {
+            usage.amu_meshes += mesh->getSize();
+        }
+    }
+
+    return usage;
+}
+
 Vector3 Actor::getNodePosition(int nodeNumber)
 {
     if (nodeNumber >= 0 && nodeNumber < ar_num_nodes)
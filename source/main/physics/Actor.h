@@ -22,6 +22,7 @@
 #pragma once
 
 #include "Application.h"
+#include "CabTriangleBvh.h"
 #include "CmdKeyInertia.h"
 #include "Differentials.h"
 #include "GfxActor.h"
@@ -34,6 +35,7 @@
 #include "SoundScriptManager.h"
 #include "TyrePressure.h"
 #include "VehicleAI.h"
+#include "WaveField.h"
 
 #include <Ogre.h>
 
@@ -87,6 +89,9 @@ public:
     float             getTotalMass(bool withLocked=true);
     int               getNodeCount() { return ar_num_nodes; }
     Ogre::Vector3     getNodePosition(int nodeNumber);     //!< Returns world position of node
+    // AngelScript only: `getNodePositions()`, `getNodeVelocities()`, `getNodeForces()`, see 'ActorAngelscript.cpp'
+    int               getBeamCount() { return ar_num_beams; }
+    // AngelScript only: `getBeamStresses()`
     int               getWheelNodeCount() const;
     float             getWheelSpeed() const { return ar_wheel_speed; }
     void              reset(bool keep_position = false);   //!< call this one to reset a truck from any context
@@ -117,7 +122,9 @@ public:
     void              scaleTruck(float value);
     void              setMass(float m);
     // not exported to scripting:
-    void              applyNodeBeamScales();               //!< For GUI::NodeBeamUtils
+    void              applyNodeBeamScales();               //!< For GUI::NodeBeamUtils; applies all of the below
+    void              applyNodeMassScale();                //!< Only `ar_nb_mass_scale`; no mass recalculation
+    void              applyBeamGroupScale(std::vector<int> const& beams, std::pair<float, float> const& scale); //!< e.g. `ar_nb_wheel_beams` + `ar_nb_wheels_scale`
     void              searchBeamDefaults();                //!< Searches for more stable beam defaults
     void              updateInitPosition();
     /// @}
@@ -205,6 +212,7 @@ public:
     /// @name Subsystems
     /// @{
     Replay*           getReplay();
+    ActorMemoryUsage  GetMemoryUsage(); //!< Caution: touches live data, must be synced with sim. thread
     TyrePressure&     getTyrePressure() { return m_tyre_pressure; }
     VehicleAIPtr      getVehicleAI() { return ar_vehicle_ai; }
     //! @}
@@ -230,7 +238,7 @@ public:
     void              HandleInputEvents(float dt);
     void              HandleAngelScriptEvents(float dt);
     void              UpdateCruiseControl(float dt);       //!< Defined in 'gameplay/CruiseControl.cpp'
-    bool              Intersects(ActorPtr actor, Ogre::Vector3 offset = Ogre::Vector3::ZERO);  //!< Slow intersection test
+    bool              Intersects(const ActorPtr& actor, Ogre::Vector3 offset = Ogre::Vector3::ZERO);  //!< Slow intersection test
     /// Moves the actor at most 'direction.length()' meters towards 'direction' to resolve any collisions
     void              resolveCollisions(Ogre::Vector3 direction);
     /// Auto detects an ideal collision avoidance direction (front, back, left, right, up)
@@ -245,6 +253,12 @@ public:
     void              UpdateBoundingBoxes();
     void              calculateAveragePosition();
     void              UpdatePhysicsOrigin();
+    /// @name Physics LOD; a distant AI actor suspends its softbody and moves as a rigid body, see `ActorManager::UpdatePhysicsLod()`
+    /// @{
+    bool              EnterRigidProxy();                   //!< False if the actor has no ground contact to follow the terrain with
+    void              LeaveRigidProxy();                   //!< Resumes the softbody; deformation is kept as it's in the node positions
+    void              UpdateRigidProxy(float dt);
+    /// @}
     void              SoftReset();
     void              SyncReset(bool reset_position);      //!< this one should be called only synchronously (without physics running in background)
     void              WriteDiagnosticDump(std::string const& filename);
@@ -359,6 +373,7 @@ ActorPtrVec                        ar_linked_actors;              //!< Sim state
     NodeNum_t         ar_exhaust_dir_node   = 0;   //!< Old-format exhaust (one per vehicle) backwards direction node
     ActorInstanceID_t ar_instance_id = ACTORINSTANCEID_INVALID;              //!< Static attr; session-unique ID
     unsigned int      ar_vector_index = 0;             //!< Sim attr; actor element index in std::vector<m_actors>
+    ActorInstanceID_t ar_linked_group = ACTORINSTANCEID_INVALID; //!< Sim state; same for all actors linked together (even indirectly), see `ActorManager::MergeLinkedGroups()`
     ActorType         ar_driveable = NOT_DRIVEABLE;                //!< Sim attr; marks vehicle type and features
     EngineSim*        ar_engine = nullptr;
     NodeNum_t         ar_cinecam_node[MAX_CAMERAS] = {NODENUM_INVALID}; //!< Sim attr; Cine-camera node indexes
@@ -394,6 +409,7 @@ ActorPtrVec                        ar_linked_actors;              //!< Sim state
     float             ar_hydro_elevator_command = 0.f;
     float             ar_hydro_elevator_state = 0.f;
     float             ar_sleep_counter = 0.f;               //!< Sim state; idle time counter
+    bool              ar_rigid_proxy = false;               //!< Sim state; softbody suspended, moved by `UpdateRigidProxy()`
     ground_model_t*   ar_submesh_ground_model = nullptr;
     bool              ar_parking_brake = false;
     bool              ar_trailer_parking_brake = false;
@@ -414,6 +430,8 @@ ActorPtrVec                        ar_linked_actors;              //!< Sim state
     std::map<int,int> ar_net_stream_results;
     Ogre::Timer       ar_net_timer;
     unsigned long     ar_net_last_update_time = 0;
+    size_t            ar_net_num_late_updates = 0;     //!< Network stats; times playback reached the newest update and had to extrapolate
+    size_t            ar_net_num_dropped_updates = 0;  //!< Network stats; updates thrown away because they fell too far behind
     DashBoardManager* ar_dashboard = nullptr;
     float             ar_collision_range = DEFAULT_COLLISION_RANGE;             //!< Physics attr
     float             ar_top_speed = 0.f;                   //!< Sim state
@@ -440,6 +458,9 @@ ActorPtrVec                        ar_linked_actors;              //!< Sim state
     std::pair<float, float> ar_nb_beams_scale;        //!< Scales for springiness & damping of regular beams
     std::pair<float, float> ar_nb_shocks_scale;       //!< Scales for springiness & damping of shock beams
     std::pair<float, float> ar_nb_wheels_scale;       //!< Scales for springiness & damping of wheel / rim beams
+    std::vector<int>        ar_nb_plain_beams;        //!< Beams affected by `ar_nb_beams_scale`, filled at spawn
+    std::vector<int>        ar_nb_shock_beams;        //!< Beams affected by `ar_nb_shocks_scale`, filled at spawn
+    std::vector<int>        ar_nb_wheel_beams;        //!< Beams affected by `ar_nb_wheels_scale`, filled at spawn
     std::pair<float, float> ar_nb_beams_d_interval;   //!< Search interval for springiness & damping of regular beams
     std::pair<float, float> ar_nb_beams_k_interval;   //!< Search interval for springiness & damping of regular beams
     std::pair<float, float> ar_nb_shocks_d_interval;  //!< Search interval for springiness & damping of shock beams
@@ -447,6 +468,14 @@ ActorPtrVec                        ar_linked_actors;              //!< Sim state
     std::pair<float, float> ar_nb_wheels_d_interval;  //!< Search interval for springiness & damping of wheel / rim beams
     std::pair<float, float> ar_nb_wheels_k_interval;  //!< Search interval for springiness & damping of wheel / rim beams
 
+    // Step rate tiers, see `ActorManager::UpdateStepTiers()`
+    float                   ar_step_dt;               //!< Physics state; time advanced by one step of this actor, PHYSICS_DT times `ar_step_divisor`
+    int                     ar_step_divisor = 1;      //!< Physics state; the actor steps on every n-th global physics step
+    int                     ar_step_phase = 0;        //!< Physics state; global steps since its last step
+    int                     ar_steps_planned = 0;     //!< Physics state; steps it takes in the current frame
+    int                     ar_steps_taken = 0;       //!< Physics state; steps it took so far in the current frame
+    int                     ar_max_step_divisor = 1;  //!< Physics attr, filled at spawn; 2 if its stiffest beam stays stable at twice the dt
+
     // Bit flags
     bool ar_update_physics:1; //!< Physics state; Should this actor be updated (locally) in the next physics step?
     bool ar_disable_aerodyn_turbulent_drag:1; //!< Physics state
@@ -469,17 +498,23 @@ private:
     void              CalcForcesEulerCompute(bool doUpdate, int num_steps); 
     void              CalcAnimators(hydrobeam_t const& hydrobeam, float &cstate, int &div);
     void              CalcBeams(bool trigger_hooks);       
+    void              CalcBeamDeformation(int i, Ogre::Real k, Ogre::Real difftoBeamL, float &slen); //!< Plastic deformation and breaking; only call when stress exceeds `minmaxposnegstress`
+    void              ProcessBeamBreakEvents();            //!< Slow path of `CalcBeams()`: sound, diagnostics, detacher groups and buoyant hull for beams queued by `CalcBeamDeformation()`
+    void              CalcPlainBeam(int i);
+    void              CalcPlainBeamsParallel();            //!< Splits `m_plain_beams` into `m_num_beam_batches` batches processed on the thread pool
     void              CalcBeamsInterActor();               
     void              CalcBuoyance(bool doUpdate);         
     void              CalcCommands(bool doUpdate);         
     void              CalcCabCollisions();                 
     void              CalcDifferentials();                 
+    void              BuildDrivetrainLinks();              //!< Flattens `m_axle_diffs`/`m_wheel_diffs` into `m_drivetrain_*`; call once all differentials exist
     void              CalcForceFeedback(bool doUpdate);    
     void              CalcFuseDrag();                      
     void              CalcHooks();                         
     void              CalcHydros();                        
     void              CalcMouse();                         
     void              CalcNodes();
+    void              CalcImplicitForces();                //!< Replaces node forces by a semi-implicit beam solution; 'implicitsolver' in truckfile
     void              CalcEventBoxes();
     void              CalcReplay();                        
     void              CalcRopes();                         
@@ -491,7 +526,6 @@ private:
     void              CalcTruckEngine(bool doUpdate);      
     void              CalcWheels(bool doUpdate, int num_steps); 
 
-    void              DetermineLinkedActors();
     void              RecalculateNodeMasses(Ogre::Real total); //!< Previously 'calc_masses2()'
     void              calcNodeConnectivityGraph();
     void              AddInterActorBeam(beam_t* beam, ActorPtr a, ActorPtr b);
@@ -512,25 +546,56 @@ private:
     // -------------------- data -------------------- //
 
     std::vector<std::shared_ptr<Task>> m_flexbody_tasks;   //!< Gfx state
+    std::unique_ptr<char[]>            m_sim_arena;        //!< Physics attr; one block holding `ar_nodes`, `ar_beams`, `ar_shocks` etc, see `ActorSpawner::InitializeRig()`
+    size_t                             m_sim_arena_num_nodes = 0; //!< Physics attr; allocated (not used) count, for destructing `ar_nodes_name`
+    size_t                             m_sim_arena_num_beams = 0; //!< Physics attr; allocated (not used) count, for destructing `ar_beams`
+    size_t                             m_sim_arena_size = 0;      //!< Physics attr; bytes, for `GetMemoryUsage()`
     RigDef::DocumentPtr                m_definition;
     std::unique_ptr<GfxActor>          m_gfx_actor;
     PerVehicleCameraContext            m_camera_context;
     Ogre::String                       m_section_config;
     std::vector<SlideNode>             m_slidenodes;       //!< all the SlideNodes available on this actor
     std::vector<RailGroup*>            m_railgroups;       //!< all the available RailGroups for this actor
+    std::vector<int>                   m_plain_beams;      //!< Physics attr; indices of NOSHOCK beams (fast path in `CalcBeams()`), filled at spawn
+    std::vector<int>                   m_bounded_beams;    //!< Physics attr; indices of shocks, triggers, supportbeams and ropes, filled at spawn
+    std::vector<int>                   m_used_command_keys; //!< Physics attr; indices of `ar_command_key`s with beams or rotators, filled at spawn
+    int                                m_num_beam_batches = 1; //!< Physics state; set by ActorManager every step, 1 = no intra-actor parallelism
+    std::vector<std::vector<Ogre::Vector3>> m_beam_batch_forces;   //!< Physics state; per-batch node force buffers for `CalcPlainBeamsParallel()`
+    std::vector<std::vector<int>>      m_beam_batch_deferred; //!< Physics state; per-batch beams needing deformation checks
+    std::vector<beam_break_event_t>    m_beam_break_events; //!< Physics state; beams which reached breaking stress this step, see `ProcessBeamBreakEvents()`
+    std::vector<float>                 m_ground_heights;   //!< Physics state; terrain height below each node, scratch buffer for `CalcNodes()`
+    Ogre::Vector3                      m_proxy_velocity = Ogre::Vector3::ZERO; //!< Sim state; horizontal velocity of the rigid-body proxy
+    float                              m_proxy_clearance = 0.f; //!< Sim state; average height of `m_proxy_contact_nodes` above ground when the proxy was entered
+    std::vector<NodeNum_t>             m_proxy_contact_nodes; //!< Sim state; nodes which touched the ground when the proxy was entered
+    std::vector<Ogre::Vector3>         m_proxy_contact_pos;  //!< Scratch buffer for `UpdateRigidProxy()`
+    std::vector<float>                 m_proxy_contact_heights; //!< Scratch buffer for `UpdateRigidProxy()`
+    bool                               m_implicit_solver = false; //!< Physics attr; 'implicitsolver' in truckfile, see `CalcImplicitForces()`
+    std::vector<Ogre::Vector3>         m_implicit_dv;      //!< Physics state; velocity change per node, scratch buffer for `CalcImplicitForces()`
+    std::vector<Ogre::Vector3>         m_implicit_rhs;     //!< Physics state; scratch buffer for `CalcImplicitForces()`
+    std::vector<Ogre::Vector3>         m_implicit_sum;     //!< Physics state; scratch buffer for `CalcImplicitForces()`
+    std::vector<Ogre::Matrix3>         m_implicit_diag;    //!< Physics state; inverted diagonal blocks per node, scratch buffer for `CalcImplicitForces()`
+    std::vector<Ogre::Vector4>         m_implicit_beams;   //!< Physics state; direction and coupling per plain beam, scratch buffer for `CalcImplicitForces()`
+    WaveField                          m_wave_field;       //!< Physics state; waves around the actor, sampled at the start of `CalcNodes()`
+    std::vector<NodeNum_t>             m_buoycab_nodes;    //!< Physics attr; unique nodes of buoyant cabs, filled on first use by `CalcBuoyance()`
+    std::vector<float>                 m_node_wave_heights; //!< Physics state; wave height at each of `m_buoycab_nodes`, indexed by node, scratch buffer for `CalcBuoyance()`
+    int                                m_turbulence_seed = 1; //!< Physics state; generator for the turbulent drag in `CalcNodes()`, seeded from the instance ID so runs are repeatable
     std::vector<Ogre::Entity*>         m_deletion_entities;    //!< For unloading vehicle; filled at spawn.
     std::vector<Ogre::SceneNode*>      m_deletion_scene_nodes; //!< For unloading vehicle; filled at spawn.
+    std::vector<std::string>           m_shared_material_keys; //!< For unloading vehicle; filled at spawn, see `ActorSpawner::AcquireSharedMaterial()`
     int               m_proped_wheel_pairs[MAX_WHEELS] = {};    //!< Physics attr; For inter-differential locking
     int               m_num_proped_wheels = 0;          //!< Physics attr, filled at spawn - Number of propelled wheels.
     float             m_avg_proped_wheel_radius = 0.f;    //!< Physics attr, filled at spawn - Average proped wheel radius.
     float             m_avionic_chatter_timer = 11.f;      //!< Sound fx state (some pseudo random number,  doesn't matter)
     PointColDetector* m_inter_point_col_detector = nullptr;   //!< Physics
+    std::vector<Actor*> m_inter_col_partners;     //!< Physics state; actors with overlapping bounding boxes, filled every step by `ActorManager::UpdateInterActorBroadPhase()`
     PointColDetector* m_intra_point_col_detector = nullptr;   //!< Physics
+    CabTriangleBvh    m_cab_bvh;                              //!< Physics state; collision cab tree for self and inter-actor collisions, see `sim_cab_bvh`
     
     Ogre::Vector3     m_avg_node_position = Ogre::Vector3::ZERO;          //!< average node position
     Ogre::Real        m_min_camera_radius = 0.f;
     Ogre::Vector3     m_avg_node_position_prev = Ogre::Vector3::ZERO;
     Ogre::Vector3     m_avg_node_velocity = Ogre::Vector3::ZERO;          //!< average node velocity (compared to the previous frame step)
+    float             m_max_node_speed_sq = 0.f;   //!< Sim state; squared speed of the fastest node in the last step, used for sleeping
     float             m_stabilizer_shock_sleep = 0.f;     //!< Sim state
     Replay*           m_replay_handler = nullptr;
     float             m_total_mass = 0.f;            //!< Physics state; total mass in Kg
@@ -549,6 +614,8 @@ private:
     int               m_num_axle_diffs = 0;           //!< Physics attr
     Differential*     m_wheel_diffs[MAX_WHEELS/2] = {};//!< Physics
     int               m_num_wheel_diffs = 0;          //!< Physics attr
+    DrivetrainLink    m_drivetrain_axles[1+MAX_WHEELS/2] = {}; //!< Physics attr; flattened `m_axle_diffs`, filled at spawn
+    DrivetrainLink    m_drivetrain_wheels[MAX_WHEELS/2] = {};  //!< Physics attr; flattened `m_wheel_diffs`, filled at spawn
     TransferCase*     m_transfer_case = nullptr;            //!< Physics
     int               m_wheel_node_count = 0;      //!< Static attr; filled at spawn
     int               m_previous_gear = 0;         //!< Sim state; land vehicle shifting
@@ -582,6 +649,14 @@ private:
     size_t            m_net_total_buffer_size = 0;    //!< For incoming/outgoing traffic; calculated on spawn
     float             m_net_node_compression = 0.f;     //!< For incoming/outgoing traffic; calculated on spawn
     int               m_net_first_wheel_node = 0;     //!< Network attr; Determines data buffer layout; calculated on spawn
+    bool              m_net_too_big_reported = false; //!< Network state; the actor doesn't fit in a RoRnet message, warning was shown
+    unsigned long     m_net_send_interval_ms = 100;   //!< Network state; time between stream updates, set by `ActorManager::UpdateNetSendIntervals()`
+    unsigned int      m_net_last_deform_events = 0;   //!< Network state; `m_num_deform_events` when the send interval was last updated
+    bool              m_net_reduced_detail = false;   //!< Network state; far away or off-screen, nodes only follow new updates; set by `ActorManager::UpdateNetRelevance()`
+    bool              m_net_nodes_updated = false;    //!< Network state; `calcNetwork()` moved the nodes this frame
+    bool              m_net_extrapolating = false;    //!< Network state; playback is past the newest update
+    unsigned int      m_num_deform_events = 0;        //!< Sim state; counts plastic deformations and breaks of beams
+    float             m_hydro_inputs[5] = {};         //!< Physics state; inputs of hydros without animators at last step, see `CalcHydros()`
 
     Ogre::UTFString   m_net_username;
     int               m_net_color_num = 0;
@@ -633,7 +708,9 @@ private:
         std::vector<float> wheel_data; //!< Wheel rotations
     };
 
-    std::deque<NetUpdate> m_net_updates; //!< Incoming stream of NetUpdates
+    std::deque<NetUpdate>  m_net_updates;     //!< Incoming stream of NetUpdates
+    NetUpdate              m_net_prev_update; //!< Last consumed NetUpdate, for interpolation tangents; empty if none
+    std::vector<NetUpdate> m_net_update_pool; //!< Consumed NetUpdates, recycled by `pushNetwork()` to avoid allocations
 };
 
 /// @} // addtogroup Physics
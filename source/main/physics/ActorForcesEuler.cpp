@@ -23,6 +23,7 @@
 #include "AirBrake.h"
 #include "Airfoil.h"
 #include "ApproxMath.h"
+#include "BeamKernels.h"
 #include "Actor.h"
 #include "ActorManager.h"
 #include "Buoyance.h"
@@ -37,14 +38,19 @@
 #include "ScrewProp.h"
 #include "ScriptEngine.h"
 #include "SoundScriptManager.h"
+#include "SimProfiler.h"
 #include "Terrain.h"
 #include "Water.h"
 
+#include <algorithm>
+
 using namespace Ogre;
 using namespace RoR;
 
 void Actor::CalcForcesEulerCompute(bool doUpdate, int num_steps)
 {
+    ROR_PROFILE_ZONE("Actor::CalcForcesEulerCompute", ar_instance_id);
+
     this->CalcNodes(); // must be done directly after the inter truck collisions are handled
     this->UpdateBoundingBoxes();
     this->CalcEventBoxes();
@@ -62,7 +68,7 @@ void Actor::CalcForcesEulerCompute(bool doUpdate, int num_steps)
     this->CalcMouse();
     this->CalcBeams(doUpdate);
     this->CalcCabCollisions();
-    this->updateSlideNodeForces(PHYSICS_DT); // must be done after the contacters are updated
+    this->updateSlideNodeForces(ar_step_dt); // must be done after the contacters are updated
     this->CalcForceFeedback(doUpdate);
 }
 
@@ -109,7 +115,7 @@ void Actor::CalcAircraftForces(bool doUpdate)
     //turboprop forces
     for (int i = 0; i < ar_num_aeroengines; i++)
         if (ar_aeroengines[i])
-            ar_aeroengines[i]->updateForces(PHYSICS_DT, doUpdate);
+            ar_aeroengines[i]->updateForces(ar_step_dt, doUpdate);
 
     //screwprop forces
     for (int i = 0; i < ar_num_screwprops; i++)
@@ -152,14 +158,57 @@ void Actor::CalcBuoyance(bool doUpdate)
 {
     if (ar_num_buoycabs && App::GetGameContext()->GetTerrain()->getWater())
     {
+        // Most hull nodes are shared by several cabs; sample the waves once per node
+        if (m_buoycab_nodes.empty())
+        {
+            for (int i = 0; i < ar_num_buoycabs; i++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    m_buoycab_nodes.push_back(ar_cabs[ar_buoycabs[i] * 3 + k]);
+                }
+            }
+            std::sort(m_buoycab_nodes.begin(), m_buoycab_nodes.end());
+            m_buoycab_nodes.erase(std::unique(m_buoycab_nodes.begin(), m_buoycab_nodes.end()), m_buoycab_nodes.end());
+        }
+        m_node_wave_heights.resize(ar_num_nodes);
+        for (NodeNum_t n: m_buoycab_nodes)
+        {
+            m_node_wave_heights[n] = m_wave_field.CalcWavesHeight(ar_nodes[n].AbsPosition);
+        }
+
         for (int i = 0; i < ar_num_buoycabs; i++)
         {
             int tmpv = ar_buoycabs[i] * 3;
-            m_buoyance->computeNodeForce(&ar_nodes[ar_cabs[tmpv]], &ar_nodes[ar_cabs[tmpv + 1]], &ar_nodes[ar_cabs[tmpv + 2]], doUpdate == 1, ar_buoycab_types[i]);
+            const NodeNum_t a = ar_cabs[tmpv], b = ar_cabs[tmpv + 1], c = ar_cabs[tmpv + 2];
+            m_buoyance->computeNodeForce(&ar_nodes[a], &ar_nodes[b], &ar_nodes[c],
+                m_node_wave_heights[a], m_node_wave_heights[b], m_node_wave_heights[c], doUpdate == 1, ar_buoycab_types[i], m_wave_field);
         }
     }
 }
 
+void Actor::BuildDrivetrainLinks()
+{
+    // The transfer case differential sits past `m_num_axle_diffs` and is only evaluated in 4WD mode
+    int num_axle_diffs = (m_transfer_case && m_axle_diffs[m_num_axle_diffs]) ? m_num_axle_diffs + 1 : m_num_axle_diffs;
+    for (int i = 0; i < num_axle_diffs; i++)
+    {
+        Differential* a_1 = m_wheel_diffs[m_axle_diffs[i]->di_idx_1];
+        Differential* a_2 = m_wheel_diffs[m_axle_diffs[i]->di_idx_2];
+        m_drivetrain_axles[i].dl_diff = m_axle_diffs[i];
+        m_drivetrain_axles[i].dl_wheels[0] = a_1->di_idx_1;
+        m_drivetrain_axles[i].dl_wheels[1] = a_1->di_idx_2;
+        m_drivetrain_axles[i].dl_wheels[2] = a_2->di_idx_1;
+        m_drivetrain_axles[i].dl_wheels[3] = a_2->di_idx_2;
+    }
+    for (int i = 0; i < m_num_wheel_diffs; i++)
+    {
+        m_drivetrain_wheels[i].dl_diff = m_wheel_diffs[i];
+        m_drivetrain_wheels[i].dl_wheels[0] = m_wheel_diffs[i]->di_idx_1;
+        m_drivetrain_wheels[i].dl_wheels[1] = m_wheel_diffs[i]->di_idx_2;
+    }
+}
+
 void Actor::CalcDifferentials()
 {
     if (ar_engine && m_num_proped_wheels > 0)
@@ -181,89 +230,122 @@ void Actor::CalcDifferentials()
     // Handle detached wheels
     for (int i = 0; i < num_axle_diffs; i++)
     {
-        int a_1 = m_axle_diffs[i]->di_idx_1;
-        int a_2 = m_axle_diffs[i]->di_idx_2;
-        wheel_t* axle_1_wheels[2] = {&ar_wheels[m_wheel_diffs[a_1]->di_idx_1], &ar_wheels[m_wheel_diffs[a_1]->di_idx_2]};
-        wheel_t* axle_2_wheels[2] = {&ar_wheels[m_wheel_diffs[a_2]->di_idx_1], &ar_wheels[m_wheel_diffs[a_2]->di_idx_2]};
-        if (axle_1_wheels[0]->wh_is_detached && axle_1_wheels[1]->wh_is_detached)
+        const int* w = m_drivetrain_axles[i].dl_wheels;
+        if (ar_wheels[w[0]].wh_is_detached && ar_wheels[w[1]].wh_is_detached)
         {
-            axle_1_wheels[0]->wh_speed = axle_2_wheels[0]->wh_speed;
-            axle_1_wheels[1]->wh_speed = axle_2_wheels[1]->wh_speed;
+            ar_wheels[w[0]].wh_speed = ar_wheels[w[2]].wh_speed;
+            ar_wheels[w[1]].wh_speed = ar_wheels[w[3]].wh_speed;
         }
-        if (axle_2_wheels[0]->wh_is_detached && axle_2_wheels[1]->wh_is_detached)
+        if (ar_wheels[w[2]].wh_is_detached && ar_wheels[w[3]].wh_is_detached)
         {
-            axle_2_wheels[0]->wh_speed = axle_1_wheels[0]->wh_speed;
-            axle_2_wheels[1]->wh_speed = axle_1_wheels[1]->wh_speed;
+            ar_wheels[w[2]].wh_speed = ar_wheels[w[0]].wh_speed;
+            ar_wheels[w[3]].wh_speed = ar_wheels[w[1]].wh_speed;
         }
     }
     for (int i = 0; i < m_num_wheel_diffs; i++)
     {
-        wheel_t* axle_wheels[2] = {&ar_wheels[m_wheel_diffs[i]->di_idx_1], &ar_wheels[m_wheel_diffs[i]->di_idx_2]};
-        if (axle_wheels[0]->wh_is_detached) axle_wheels[0]->wh_speed = axle_wheels[1]->wh_speed;
-        if (axle_wheels[1]->wh_is_detached) axle_wheels[1]->wh_speed = axle_wheels[0]->wh_speed;
+        const int* w = m_drivetrain_wheels[i].dl_wheels;
+        if (ar_wheels[w[0]].wh_is_detached) ar_wheels[w[0]].wh_speed = ar_wheels[w[1]].wh_speed;
+        if (ar_wheels[w[1]].wh_is_detached) ar_wheels[w[1]].wh_speed = ar_wheels[w[0]].wh_speed;
     }
 
     // loop through all interaxle differentials, this is the torsion to keep
     // the axles aligned with each other as if they connected by a shaft
     for (int i = 0; i < num_axle_diffs; i++)
     {
-        int a_1 = m_axle_diffs[i]->di_idx_1;
-        int a_2 = m_axle_diffs[i]->di_idx_2;
+        const DrivetrainLink& link = m_drivetrain_axles[i];
+        wheel_t& w0 = ar_wheels[link.dl_wheels[0]];
+        wheel_t& w1 = ar_wheels[link.dl_wheels[1]];
+        wheel_t& w2 = ar_wheels[link.dl_wheels[2]];
+        wheel_t& w3 = ar_wheels[link.dl_wheels[3]];
 
-        Ogre::Real axle_torques[2] = {0.0f, 0.0f};
         DifferentialData diff_data =
         {
-            {
-                (ar_wheels[m_wheel_diffs[a_1]->di_idx_1].wh_speed + ar_wheels[m_wheel_diffs[a_1]->di_idx_2].wh_speed) * 0.5f,
-                (ar_wheels[m_wheel_diffs[a_2]->di_idx_1].wh_speed + ar_wheels[m_wheel_diffs[a_2]->di_idx_2].wh_speed) * 0.5f
-            },
-            m_axle_diffs[i]->di_delta_rotation,
-            {axle_torques[0], axle_torques[1]},
-            ar_wheels[m_wheel_diffs[a_1]->di_idx_1].wh_torque + ar_wheels[m_wheel_diffs[a_1]->di_idx_2].wh_torque +
-            ar_wheels[m_wheel_diffs[a_2]->di_idx_1].wh_torque + ar_wheels[m_wheel_diffs[a_2]->di_idx_2].wh_torque,
-            PHYSICS_DT
+            {(w0.wh_speed + w1.wh_speed) * 0.5f, (w2.wh_speed + w3.wh_speed) * 0.5f},
+            link.dl_diff->di_delta_rotation,
+            {0.0f, 0.0f},
+            w0.wh_torque + w1.wh_torque + w2.wh_torque + w3.wh_torque,
+            ar_step_dt
         };
 
-        m_axle_diffs[i]->CalcAxleTorque(diff_data);
+        Differential::CalcDiffTorque(link.dl_diff->GetActiveDiffType(), diff_data);
 
-        m_axle_diffs[i]->di_delta_rotation = diff_data.delta_rotation;
+        link.dl_diff->di_delta_rotation = diff_data.delta_rotation;
 
-        ar_wheels[m_wheel_diffs[a_1]->di_idx_1].wh_torque = diff_data.out_torque[0] * 0.5f;
-        ar_wheels[m_wheel_diffs[a_1]->di_idx_2].wh_torque = diff_data.out_torque[0] * 0.5f;
-        ar_wheels[m_wheel_diffs[a_2]->di_idx_1].wh_torque = diff_data.out_torque[1] * 0.5f;
-        ar_wheels[m_wheel_diffs[a_2]->di_idx_2].wh_torque = diff_data.out_torque[1] * 0.5f;
+        w0.wh_torque = diff_data.out_torque[0] * 0.5f;
+        w1.wh_torque = diff_data.out_torque[0] * 0.5f;
+        w2.wh_torque = diff_data.out_torque[1] * 0.5f;
+        w3.wh_torque = diff_data.out_torque[1] * 0.5f;
     }
 
     // loop through all interwheel differentials, this is the torsion to keep
     // the wheels aligned with each other as if they connected by a shaft
     for (int i = 0; i < m_num_wheel_diffs; i++)
     {
-        Ogre::Real axle_torques[2] = {0.0f, 0.0f};
-        wheel_t* axle_wheels[2] = {&ar_wheels[m_wheel_diffs[i]->di_idx_1], &ar_wheels[m_wheel_diffs[i]->di_idx_2]};
+        const DrivetrainLink& link = m_drivetrain_wheels[i];
+        wheel_t& w0 = ar_wheels[link.dl_wheels[0]];
+        wheel_t& w1 = ar_wheels[link.dl_wheels[1]];
 
         DifferentialData diff_data =
         {
-            {axle_wheels[0]->wh_speed, axle_wheels[1]->wh_speed},
-            m_wheel_diffs[i]->di_delta_rotation,
-            {axle_torques[0], axle_torques[1]},
-            axle_wheels[0]->wh_torque + axle_wheels[1]->wh_torque,
-            PHYSICS_DT
+            {w0.wh_speed, w1.wh_speed},
+            link.dl_diff->di_delta_rotation,
+            {0.0f, 0.0f},
+            w0.wh_torque + w1.wh_torque,
+            ar_step_dt
         };
 
-        m_wheel_diffs[i]->CalcAxleTorque(diff_data);
+        Differential::CalcDiffTorque(link.dl_diff->GetActiveDiffType(), diff_data);
+
+        link.dl_diff->di_delta_rotation = diff_data.delta_rotation;
+
+        w0.wh_torque = diff_data.out_torque[0];
+        w1.wh_torque = diff_data.out_torque[1];
+    }
+}
+
+/// Applies the wheel's torque to its rim nodes and measures their average speed around the axis.
+/// Also sums up ground contacts of the rim nodes; returns the number of nodes in contact.
+static float CalcWheelRimNodes(wheel_t& wheel, Vector3 const& axis, float& out_speed, Vector3& out_slip, Vector3& out_force)
+{
+    // Reversed wheels spin the other way, flip the tangent instead of each radius
+    const float dir_sign = (wheel.wh_propulsed == 2) ? -1.0f : 1.0f;
+    const float torque_per_node = wheel.wh_torque / (Real)(wheel.wh_num_nodes);
+    node_t* const axis_nodes[2] = { wheel.wh_axis_node_0, wheel.wh_axis_node_1 };
+
+    float speed = 0.0f;
+    float contact_counter = 0.0f;
+    for (int j = 0; j < wheel.wh_num_nodes; j++)
+    {
+        node_t* outer_node = wheel.wh_nodes[j];
+        node_t* inner_node = axis_nodes[j % 2];
+
+        const Vector3 radius = outer_node->RelPosition - inner_node->RelPosition;
+        const float inverted_rlen = 1.0f / radius.length(); // Exact; feeds the wheel speed used by TC, ABS and the engine RPM
 
-        m_wheel_diffs[i]->di_delta_rotation = diff_data.delta_rotation;
+        const Vector3 dir = axis.crossProduct(radius) * (inverted_rlen * dir_sign);
+        outer_node->Forces += dir * (torque_per_node * inverted_rlen);
+        speed += (outer_node->Velocity - inner_node->Velocity).dotProduct(dir);
 
-        ar_wheels[m_wheel_diffs[i]->di_idx_1].wh_torque = diff_data.out_torque[0];
-        ar_wheels[m_wheel_diffs[i]->di_idx_2].wh_torque = diff_data.out_torque[1];
+        if (outer_node->nd_has_ground_contact || outer_node->nd_has_mesh_contact)
+        {
+            contact_counter += 1.0f;
+            float force_ratio = outer_node->nd_last_collision_force.length();
+            out_slip  += outer_node->nd_last_collision_slip * force_ratio;
+            out_force += outer_node->nd_last_collision_force;
+        }
     }
+    out_speed = speed / (Real)(wheel.wh_num_nodes);
+    return contact_counter;
 }
 
 void Actor::CalcWheels(bool doUpdate, int num_steps)
 {
+    ROR_PROFILE_ZONE("Actor::CalcWheels", ar_instance_id);
+
     // driving aids traction control & anti-lock brake pulse
-    tc_timer += PHYSICS_DT;
-    alb_timer += PHYSICS_DT;
+    tc_timer += ar_step_dt;
+    alb_timer += ar_step_dt;
 
     if (alb_timer >= alb_pulse_time)
     {
@@ -282,59 +364,61 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
     ar_wheel_spin = 0.0f;
     ar_wheel_speed = 0.0f;
 
+    // The same for all wheels; `getDirection()` is derived from the camera nodes
+    const float relspeed = ar_nodes[0].Velocity.dotProduct(getDirection());
+    const float curspeed = fabs(relspeed);
+    const float abrake = ar_brake_force * ar_brake; // footbrake
+    const float inv_num_steps = 1.0f / (float)num_steps;
+
     for (int i = 0; i < ar_num_wheels; i++)
     {
+        wheel_t& wheel = ar_wheels[i];
         if (doUpdate)
         {
-            ar_wheels[i].debug_rpm = 0.0f;
-            ar_wheels[i].debug_torque = 0.0f;
-            ar_wheels[i].debug_vel = Vector3::ZERO;
-            ar_wheels[i].debug_slip = Vector3::ZERO;
-            ar_wheels[i].debug_force = Vector3::ZERO;
-            ar_wheels[i].debug_scaled_cforce = Vector3::ZERO;
+            wheel.debug_rpm = 0.0f;
+            wheel.debug_torque = 0.0f;
+            wheel.debug_vel = Vector3::ZERO;
+            wheel.debug_slip = Vector3::ZERO;
+            wheel.debug_force = Vector3::ZERO;
+            wheel.debug_scaled_cforce = Vector3::ZERO;
         }
 
-        if (ar_wheels[i].wh_is_detached)
+        if (wheel.wh_is_detached)
             continue;
 
-        float relspeed = ar_nodes[0].Velocity.dotProduct(getDirection());
-        float curspeed = fabs(relspeed);
-        float wheel_slip = fabs(ar_wheels[i].wh_speed - relspeed) / std::max(1.0f, curspeed);
+        float wheel_slip = fabs(wheel.wh_speed - relspeed) / std::max(1.0f, curspeed);
 
         // traction control
-        if (tc_mode && fabs(ar_wheels[i].wh_torque) > 0.0f && fabs(ar_wheels[i].wh_speed) > curspeed && wheel_slip > 0.25f)
+        if (tc_mode && fabs(wheel.wh_torque) > 0.0f && fabs(wheel.wh_speed) > curspeed && wheel_slip > 0.25f)
         {
             if (tc_pulse_state)
             {
-                ar_wheels[i].wh_tc_coef = curspeed / fabs(ar_wheels[i].wh_speed);
-                ar_wheels[i].wh_tc_coef = pow(ar_wheels[i].wh_tc_coef, tc_ratio);
+                wheel.wh_tc_coef = curspeed / fabs(wheel.wh_speed);
+                wheel.wh_tc_coef = pow(wheel.wh_tc_coef, tc_ratio);
             }
-            float tc_coef = pow(ar_wheels[i].wh_tc_coef, std::min(std::abs(ar_wheels[i].wh_speed) / 5.0f, 1.0f));
-            ar_wheels[i].wh_torque *= tc_coef;
+            float tc_coef = pow(wheel.wh_tc_coef, std::min(std::abs(wheel.wh_speed) / 5.0f, 1.0f));
+            wheel.wh_torque *= tc_coef;
             m_tractioncontrol = true;
         }
         else
         {
-            ar_wheels[i].wh_tc_coef = 1.0f;
+            wheel.wh_tc_coef = 1.0f;
         }
 
-        if (ar_wheels[i].wh_braking != wheel_t::BrakeCombo::NONE)
+        if (wheel.wh_braking != wheel_t::BrakeCombo::NONE)
         {
-            // footbrake
-            float abrake = ar_brake_force * ar_brake;
-
             // handbrake
             float hbrake = 0.0f;
-            if (ar_parking_brake && (ar_wheels[i].wh_braking != wheel_t::BrakeCombo::FOOT_ONLY))
+            if (ar_parking_brake && (wheel.wh_braking != wheel_t::BrakeCombo::FOOT_ONLY))
             {
                 hbrake = m_handbrake_force;
             }
 
             // directional braking
             float dbrake = 0.0f;
-            if ((ar_wheels[i].wh_speed < 20.0f)
-                && (((ar_wheels[i].wh_braking == wheel_t::BrakeCombo::FOOT_HAND_SKID_LEFT)  && (ar_hydro_dir_state > 0.0f))
-                 || ((ar_wheels[i].wh_braking == wheel_t::BrakeCombo::FOOT_HAND_SKID_RIGHT) && (ar_hydro_dir_state < 0.0f))))
+            if ((wheel.wh_speed < 20.0f)
+                && (((wheel.wh_braking == wheel_t::BrakeCombo::FOOT_HAND_SKID_LEFT)  && (ar_hydro_dir_state > 0.0f))
+                 || ((wheel.wh_braking == wheel_t::BrakeCombo::FOOT_HAND_SKID_RIGHT) && (ar_hydro_dir_state < 0.0f))))
             {
                 dbrake = ar_brake_force * abs(ar_hydro_dir_state);
             }
@@ -344,114 +428,85 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
                 float adbrake = abrake + dbrake; 
 
                 // anti-lock braking
-                if (alb_mode && curspeed > alb_minspeed && curspeed > fabs(ar_wheels[i].wh_speed) && (adbrake > 0.0f) && wheel_slip > 0.25f) 
+                if (alb_mode && curspeed > alb_minspeed && curspeed > fabs(wheel.wh_speed) && (adbrake > 0.0f) && wheel_slip > 0.25f) 
                 {
                     if (alb_pulse_state)
                     {
-                        ar_wheels[i].wh_alb_coef = fabs(ar_wheels[i].wh_speed) / curspeed;
-                        ar_wheels[i].wh_alb_coef = pow(ar_wheels[i].wh_alb_coef, alb_ratio);
+                        wheel.wh_alb_coef = fabs(wheel.wh_speed) / curspeed;
+                        wheel.wh_alb_coef = pow(wheel.wh_alb_coef, alb_ratio);
                     }
-                    adbrake *= ar_wheels[i].wh_alb_coef;
+                    adbrake *= wheel.wh_alb_coef;
                     m_antilockbrake = true;
                 }
 
-                float force = -ar_wheels[i].wh_avg_speed * ar_wheels[i].wh_radius * ar_wheels[i].wh_mass / PHYSICS_DT;
-                force -= ar_wheels[i].wh_last_retorque;
+                float force = -wheel.wh_avg_speed * wheel.wh_radius * wheel.wh_mass / ar_step_dt;
+                force -= wheel.wh_last_retorque;
 
-                if (ar_wheels[i].wh_speed > 0)
-                    ar_wheels[i].wh_torque += Math::Clamp(force, -(adbrake + hbrake), 0.0f);
+                if (wheel.wh_speed > 0)
+                    wheel.wh_torque += Math::Clamp(force, -(adbrake + hbrake), 0.0f);
                 else
-                    ar_wheels[i].wh_torque += Math::Clamp(force, 0.0f, +(adbrake + hbrake));
+                    wheel.wh_torque += Math::Clamp(force, 0.0f, +(adbrake + hbrake));
             }
             else
             {
-                ar_wheels[i].wh_alb_coef = 1.0f;
+                wheel.wh_alb_coef = 1.0f;
             }
         }
 
-        ar_wheels[i].debug_torque += ar_wheels[i].wh_torque / (float)num_steps;
+        wheel.debug_torque += wheel.wh_torque * inv_num_steps;
 
         // application to wheel
-        Vector3 axis = (ar_wheels[i].wh_axis_node_1->RelPosition - ar_wheels[i].wh_axis_node_0->RelPosition).normalisedCopy();
-        float axis_precalc = ar_wheels[i].wh_torque / (Real)(ar_wheels[i].wh_num_nodes);
+        Vector3 axis = (wheel.wh_axis_node_1->RelPosition - wheel.wh_axis_node_0->RelPosition).normalisedCopy();
 
-        float expected_wheel_speed = ar_wheels[i].wh_speed;
-        ar_wheels[i].wh_speed = 0.0f;
-
-        Real contact_counter = 0.0f;
+        float expected_wheel_speed = wheel.wh_speed;
         Vector3 slip = Vector3::ZERO;
         Vector3 force = Vector3::ZERO;
-        for (int j = 0; j < ar_wheels[i].wh_num_nodes; j++)
-        {
-            node_t* outer_node = ar_wheels[i].wh_nodes[j];
-            node_t* inner_node = (j % 2) ? ar_wheels[i].wh_axis_node_1 : ar_wheels[i].wh_axis_node_0;
-
-            Vector3 radius = outer_node->RelPosition - inner_node->RelPosition;
-            float inverted_rlen = 1.0f / radius.length();
-
-            if (ar_wheels[i].wh_propulsed == 2)
-            {
-                radius = -radius;
-            }
-
-            Vector3 dir = axis.crossProduct(radius) * inverted_rlen;
-            ar_wheels[i].wh_nodes[j]->Forces += dir * axis_precalc * inverted_rlen;
-            ar_wheels[i].wh_speed += (outer_node->Velocity - inner_node->Velocity).dotProduct(dir);
-
-            if (ar_wheels[i].wh_nodes[j]->nd_has_ground_contact || ar_wheels[i].wh_nodes[j]->nd_has_mesh_contact)
-            {
-                contact_counter += 1.0f;
-                float force_ratio = ar_wheels[i].wh_nodes[j]->nd_last_collision_force.length();
-                slip  += ar_wheels[i].wh_nodes[j]->nd_last_collision_slip * force_ratio;
-                force += ar_wheels[i].wh_nodes[j]->nd_last_collision_force;
-            }
-        }
+        const float contact_counter = CalcWheelRimNodes(wheel, axis, wheel.wh_speed, slip, force);
         if (contact_counter > 0.0f && !force.isZeroLength())
         {
             slip /= force.length(); // slip vector weighted by down force
             slip /= contact_counter; // average slip vector
             force /= contact_counter; // average force vector
             Vector3 normal = force.normalisedCopy(); // contact plane normal
-            Vector3 v = ar_wheels[i].wh_axis_node_0->Velocity.midPoint(ar_wheels[i].wh_axis_node_1->Velocity);
+            Vector3 v = wheel.wh_axis_node_0->Velocity.midPoint(wheel.wh_axis_node_1->Velocity);
             Vector3 vel = v - v.dotProduct(normal) * normal;
-            ar_wheels[i].debug_vel   += vel / (float)num_steps;
-            ar_wheels[i].debug_slip  += slip / (float)num_steps;
-            ar_wheels[i].debug_force += force / (float)num_steps;
+            wheel.debug_vel   += vel * inv_num_steps;
+            wheel.debug_slip  += slip * inv_num_steps;
+            wheel.debug_force += force * inv_num_steps;
         }
 
-        ar_wheels[i].wh_speed /= (Real)ar_wheels[i].wh_num_nodes;
-        ar_wheels[i].wh_net_rp += (ar_wheels[i].wh_speed / ar_wheels[i].wh_radius) * PHYSICS_DT;
+        wheel.wh_net_rp += (wheel.wh_speed / wheel.wh_radius) * ar_step_dt;
         // We overestimate the average speed on purpose in order to improve the quality of the braking force estimate
-        ar_wheels[i].wh_avg_speed = ar_wheels[i].wh_avg_speed * 0.99 + ar_wheels[i].wh_speed * 0.1;
-        ar_wheels[i].debug_rpm += RAD_PER_SEC_TO_RPM * ar_wheels[i].wh_speed / ar_wheels[i].wh_radius / (float)num_steps;
-        if (ar_wheels[i].wh_propulsed == 1)
+        wheel.wh_avg_speed = wheel.wh_avg_speed * 0.99 + wheel.wh_speed * 0.1;
+        wheel.debug_rpm += RAD_PER_SEC_TO_RPM * wheel.wh_speed / wheel.wh_radius * inv_num_steps;
+        if (wheel.wh_propulsed == 1)
         {
-            float speedacc = ar_wheels[i].wh_speed / (float)m_num_proped_wheels;
-            ar_wheel_speed += speedacc;                          // Accumulate the average wheel speed (m/s)
-            ar_wheel_spin  += speedacc / ar_wheels[i].wh_radius; // Accumulate the average wheel spin  (radians)
+            float speedacc = wheel.wh_speed / (float)m_num_proped_wheels;
+            ar_wheel_speed += speedacc;                   // Accumulate the average wheel speed (m/s)
+            ar_wheel_spin  += speedacc / wheel.wh_radius; // Accumulate the average wheel spin  (radians)
         }
 
-        expected_wheel_speed += ((ar_wheels[i].wh_last_torque / ar_wheels[i].wh_radius) / ar_wheels[i].wh_mass) * PHYSICS_DT;
-        ar_wheels[i].wh_last_retorque = ar_wheels[i].wh_mass * (ar_wheels[i].wh_speed - expected_wheel_speed) / PHYSICS_DT;
+        expected_wheel_speed += ((wheel.wh_last_torque / wheel.wh_radius) / wheel.wh_mass) * ar_step_dt;
+        wheel.wh_last_retorque = wheel.wh_mass * (wheel.wh_speed - expected_wheel_speed) / ar_step_dt;
 
         // reaction torque
-        Vector3 rradius = ar_wheels[i].wh_arm_node->RelPosition - ar_wheels[i].wh_near_attach_node->RelPosition;
-        Vector3 radius = Plane(axis, ar_wheels[i].wh_near_attach_node->RelPosition).projectVector(rradius);
+        Vector3 rradius = wheel.wh_arm_node->RelPosition - wheel.wh_near_attach_node->RelPosition;
+        Vector3 radius = Plane(axis, wheel.wh_near_attach_node->RelPosition).projectVector(rradius);
         float offset = (rradius - radius).length(); // length of the error arm
         Real rlen = radius.normalise(); // length of the projected arm
         // TODO: Investigate the offset length abort condition ~ ulteq 10/2018
-        if (rlen > 0.01 && offset * 2.0f < rlen && fabs(ar_wheels[i].wh_torque) > 0.01f)
+        if (rlen > 0.01 && offset * 2.0f < rlen && fabs(wheel.wh_torque) > 0.01f)
         {
             Vector3 cforce = axis.crossProduct(radius);
             // modulate the force according to induced torque error
-            cforce *= (0.5f * ar_wheels[i].wh_torque / rlen) * (1.0f - ((offset * 2.0f) / rlen)); // linear modulation
-            ar_wheels[i].wh_arm_node->Forces -= cforce;
-            ar_wheels[i].wh_near_attach_node->Forces += cforce;
-            ar_wheels[i].debug_scaled_cforce += cforce / m_total_mass / (float)num_steps;
+            cforce *= (0.5f * wheel.wh_torque / rlen) * (1.0f - ((offset * 2.0f) / rlen)); // linear modulation
+            wheel.wh_arm_node->Forces -= cforce;
+            wheel.wh_near_attach_node->Forces += cforce;
+            wheel.debug_scaled_cforce += cforce / m_total_mass * inv_num_steps;
         }
 
-        ar_wheels[i].wh_last_torque = ar_wheels[i].wh_torque;
-        ar_wheels[i].wh_torque = 0.0f;
+        wheel.wh_last_torque = wheel.wh_torque;
+        wheel.wh_torque = 0.0f;
     }
 
     ar_avg_wheel_speed = ar_avg_wheel_speed * 0.995 + ar_wheel_speed * 0.005;
@@ -483,7 +538,7 @@ void Actor::CalcWheels(bool doUpdate, int num_steps)
     }
 
     // calculate driven distance
-    float distance_driven = fabs(ar_wheel_speed * PHYSICS_DT);
+    float distance_driven = fabs(ar_wheel_speed * ar_step_dt);
     m_odometer_total += distance_driven;
     m_odometer_user += distance_driven;
 }
@@ -494,7 +549,7 @@ void Actor::CalcShocks(bool doUpdate, int num_steps)
     if (this->ar_has_active_shocks && m_stabilizer_shock_request)
     {
         if ((m_stabilizer_shock_request == 1 && m_stabilizer_shock_ratio < 0.1) || (m_stabilizer_shock_request == -1 && m_stabilizer_shock_ratio > -0.1))
-            m_stabilizer_shock_ratio = m_stabilizer_shock_ratio + (float)m_stabilizer_shock_request * PHYSICS_DT * STAB_RATE;
+            m_stabilizer_shock_ratio = m_stabilizer_shock_ratio + (float)m_stabilizer_shock_request * ar_step_dt * STAB_RATE;
         for (int i = 0; i < ar_num_shocks; i++)
         {
             // active shocks now
@@ -507,7 +562,7 @@ void Actor::CalcShocks(bool doUpdate, int num_steps)
     //auto shock adjust
     if (this->ar_has_active_shocks && doUpdate)
     {
-        m_stabilizer_shock_sleep -= PHYSICS_DT * num_steps;
+        m_stabilizer_shock_sleep -= ar_step_dt * num_steps;
 
         float roll = asin(GetCameraRoll().dotProduct(Vector3::UNIT_Y));
         //mWindow->setDebugText("Roll:"+ TOSTRING(roll));
@@ -545,6 +600,8 @@ void Actor::CalcShocks(bool doUpdate, int num_steps)
 
 void Actor::CalcHydros()
 {
+    ROR_PROFILE_ZONE("Actor::CalcHydros", ar_instance_id);
+
     //direction
     if (ar_hydro_dir_state != 0 || ar_hydro_dir_command != 0)
     {
@@ -555,7 +612,7 @@ void Actor::CalcHydros()
             float sensitivity = Math::Clamp(App::io_analog_sensitivity->getFloat(), 0.5f, 2.0f);
             float diff = ar_hydro_dir_command - ar_hydro_dir_state;
             float rate = std::exp(-std::min(std::abs(diff), 1.0f) / sensitivity) * diff;
-            ar_hydro_dir_state += (10.0f / smoothing) * PHYSICS_DT * rate;
+            ar_hydro_dir_state += (10.0f / smoothing) * ar_step_dt * rate;
         }
         else
         {
@@ -565,21 +622,21 @@ void Actor::CalcHydros()
                 {
                     float rate = std::max(1.2f, 30.0f / (10.0f));
                     if (ar_hydro_dir_state > ar_hydro_dir_command)
-                        ar_hydro_dir_state -= PHYSICS_DT * rate;
+                        ar_hydro_dir_state -= ar_step_dt * rate;
                     else
-                        ar_hydro_dir_state += PHYSICS_DT * rate;
+                        ar_hydro_dir_state += ar_step_dt * rate;
                 }
                 else
                 {
                     // minimum rate: 20% --> enables to steer high velocity vehicles
                     float rate = std::max(1.2f, 30.0f / (10.0f + std::abs(ar_wheel_speed / 2.0f)));
                     if (ar_hydro_dir_state > ar_hydro_dir_command)
-                        ar_hydro_dir_state -= PHYSICS_DT * rate;
+                        ar_hydro_dir_state -= ar_step_dt * rate;
                     else
-                        ar_hydro_dir_state += PHYSICS_DT * rate;
+                        ar_hydro_dir_state += ar_step_dt * rate;
                 }
             }
-            float dirdelta = PHYSICS_DT;
+            float dirdelta = ar_step_dt;
             if (ar_hydro_dir_state > dirdelta)
                 ar_hydro_dir_state -= dirdelta;
             else if (ar_hydro_dir_state < -dirdelta)
@@ -594,11 +651,11 @@ void Actor::CalcHydros()
         if (ar_hydro_aileron_command != 0)
         {
             if (ar_hydro_aileron_state > ar_hydro_aileron_command)
-                ar_hydro_aileron_state -= PHYSICS_DT * 4.0;
+                ar_hydro_aileron_state -= ar_step_dt * 4.0;
             else
-                ar_hydro_aileron_state += PHYSICS_DT * 4.0;
+                ar_hydro_aileron_state += ar_step_dt * 4.0;
         }
-        float delta = PHYSICS_DT;
+        float delta = ar_step_dt;
         if (ar_hydro_aileron_state > delta)
             ar_hydro_aileron_state -= delta;
         else if (ar_hydro_aileron_state < -delta)
@@ -612,12 +669,12 @@ void Actor::CalcHydros()
         if (ar_hydro_rudder_command != 0)
         {
             if (ar_hydro_rudder_state > ar_hydro_rudder_command)
-                ar_hydro_rudder_state -= PHYSICS_DT * 4.0;
+                ar_hydro_rudder_state -= ar_step_dt * 4.0;
             else
-                ar_hydro_rudder_state += PHYSICS_DT * 4.0;
+                ar_hydro_rudder_state += ar_step_dt * 4.0;
         }
 
-        float delta = PHYSICS_DT;
+        float delta = ar_step_dt;
         if (ar_hydro_rudder_state > delta)
             ar_hydro_rudder_state -= delta;
         else if (ar_hydro_rudder_state < -delta)
@@ -631,11 +688,11 @@ void Actor::CalcHydros()
         if (ar_hydro_elevator_command != 0)
         {
             if (ar_hydro_elevator_state > ar_hydro_elevator_command)
-                ar_hydro_elevator_state -= PHYSICS_DT * 4.0;
+                ar_hydro_elevator_state -= ar_step_dt * 4.0;
             else
-                ar_hydro_elevator_state += PHYSICS_DT * 4.0;
+                ar_hydro_elevator_state += ar_step_dt * 4.0;
         }
-        float delta = PHYSICS_DT;
+        float delta = ar_step_dt;
         if (ar_hydro_elevator_state > delta)
             ar_hydro_elevator_state -= delta;
         else if (ar_hydro_elevator_state < -delta)
@@ -643,11 +700,27 @@ void Actor::CalcHydros()
         else
             ar_hydro_elevator_state = 0;
     }
+    // Hydros without animators depend only on these; while none of them changes, such hydros
+    // are only updated if their inertia still moves or their beam was changed elsewhere (i.e. reset)
+    const float speed_state = (ar_wheel_speed < 12.0f) ? ar_hydro_dir_state * (12.0f - ar_wheel_speed) / 12.0f : 0.0f;
+    const float hydro_inputs[5] = { speed_state, ar_hydro_dir_state, ar_hydro_aileron_state, ar_hydro_rudder_state, ar_hydro_elevator_state };
+    const bool hydro_inputs_changed = !std::equal(hydro_inputs, hydro_inputs + 5, m_hydro_inputs);
+    std::copy(hydro_inputs, hydro_inputs + 5, m_hydro_inputs);
+
     //update length, dirstate between -1.0 and 1.0
     const int num_hydros = static_cast<int>(ar_hydros.size());
     for (int i = 0; i < num_hydros; ++i)
     {
         hydrobeam_t& hydrobeam = ar_hydros[i];
+        const uint16_t beam_idx = hydrobeam.hb_beam_index;
+
+        if (!hydro_inputs_changed && !hydrobeam.hb_anim_flags && ar_beams[beam_idx].L == hydrobeam.hb_last_length &&
+            hydrobeam.hb_inertia.IsIdle(hydrobeam.hb_cmd_input, ar_step_dt))
+        {
+            if (hydrobeam.hb_flags != 0 && !(hydrobeam.hb_flags & HYDRO_FLAG_SPEED))
+                ar_hydro_dir_wheel_display = hydrobeam.hb_cmd_input;
+            continue;
+        }
 
         //compound hydro
         float cstate = 0.0f;
@@ -655,8 +728,7 @@ void Actor::CalcHydros()
         if (hydrobeam.hb_flags & HYDRO_FLAG_SPEED)
         {
             //special treatment for SPEED
-            if (ar_wheel_speed < 12.0f)
-                cstate += ar_hydro_dir_state * (12.0f - ar_wheel_speed) / 12.0f;
+            cstate += speed_state;
             div++;
         }
         if (hydrobeam.hb_flags & HYDRO_FLAG_DIR)
@@ -695,8 +767,6 @@ void Actor::CalcHydros()
             div++;
         }
 
-        const uint16_t beam_idx = hydrobeam.hb_beam_index;
-
         if (cstate > 1.0)
             cstate = 1.0;
         if (cstate < -1.0)
@@ -713,7 +783,8 @@ void Actor::CalcHydros()
         {
             cstate /= (float)div;
 
-            cstate = hydrobeam.hb_inertia.CalcCmdKeyDelay(cstate, PHYSICS_DT);
+            hydrobeam.hb_cmd_input = cstate;
+            cstate = hydrobeam.hb_inertia.CalcCmdKeyDelay(cstate, ar_step_dt);
 
             if (!(hydrobeam.hb_flags & HYDRO_FLAG_SPEED) && !hydrobeam.hb_anim_flags)
                 ar_hydro_dir_wheel_display = cstate;
@@ -731,11 +802,42 @@ void Actor::CalcHydros()
 
             ar_beams[beam_idx].L = hydrobeam.hb_ref_length * factor;
         }
+        hydrobeam.hb_last_length = ar_beams[beam_idx].L;
     }
 }
 
+/// A key without input, with settled inertia and none of its beams moving on its own
+/// (1-press modes, auto-centering) would leave all its beams and rotators as they are.
+static bool IsCommandKeyIdle(command_t& cmd, beam_t* beams, int num_beams)
+{
+    if (cmd.commandValue != 0.0f)
+        return false;
+#ifdef USE_OPENAL
+    if (cmd.cmd_plays_sound && cmd.commandValueState != 0)
+        return false; // The command sound must be started/stopped
+#endif // USE_OPENAL
+    if (!cmd.command_inertia.IsIdle(0.0f, PHYSICS_DT) ||
+        (!cmd.rotators.empty() && !cmd.rotator_inertia.IsIdle(0.0f, PHYSICS_DT)))
+        return false;
+
+    for (commandbeam_t& cmd_beam: cmd.beams)
+    {
+        if (cmd_beam.cmb_state->auto_moving_mode != 0)
+            return false;
+        if (cmd_beam.cmb_is_autocentering && !cmd_beam.cmb_state->auto_move_lock && cmd_beam.cmb_beam_index < num_beams)
+        {
+            beam_t& beam = beams[cmd_beam.cmb_beam_index];
+            if (beam.refL != 0 && beam.L != 0 && fabs((beam.L / beam.refL) - cmd_beam.cmb_center_length) >= 0.0001)
+                return false; // Still centering
+        }
+    }
+    return true;
+}
+
 void Actor::CalcCommands(bool doUpdate)
 {
+    ROR_PROFILE_ZONE("Actor::CalcCommands", ar_instance_id);
+
     if (m_has_command_beams)
     {
         int active = 0;
@@ -757,7 +859,7 @@ void Actor::CalcCommands(bool doUpdate)
         if (ar_driveable == MACHINE)
             crankfactor = 2;
 
-        for (int i = 1; i <= MAX_COMMANDS; i++) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
+        for (int i: m_used_command_keys)
         {
             for (int j = 0; j < (int)ar_command_key[i].beams.size(); j++)
             {
@@ -765,6 +867,7 @@ void Actor::CalcCommands(bool doUpdate)
             }
         }
 
+        // All keys: values of keys without beams still drive animations and sounds
         for (int i = 1; i <= MAX_COMMANDS; i++) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
         {
             float oldValue = ar_command_key[i].commandValue;
@@ -798,8 +901,21 @@ void Actor::CalcCommands(bool doUpdate)
         }
 
         // now process normal commands
-        for (int i = 1; i <= MAX_COMMANDS; i++) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
+        for (int i: m_used_command_keys)
         {
+            if (IsCommandKeyIdle(ar_command_key[i], ar_beams, ar_num_beams))
+            {
+                // Nothing would move, only keep the side effects the following keys depend on
+                if (ar_command_key[i].cmd_is_force_restricted)
+                    crankfactor = std::min(crankfactor, 1.0f);
+                if (doUpdate)
+                {
+                    for (int rotator: ar_command_key[i].rotators)
+                        ar_rotators[std::abs(rotator) - 1].debug_rate = 0.0f;
+                }
+                continue;
+            }
+
             bool requestpower = false;
             for (int j = 0; j < (int)ar_command_key[i].beams.size(); j++)
             {
@@ -891,7 +1007,7 @@ void Actor::CalcCommands(bool doUpdate)
                             }
                         }
 
-                        v = ar_command_key[i].command_inertia.CalcCmdKeyDelay(v, PHYSICS_DT);
+                        v = ar_command_key[i].command_inertia.CalcCmdKeyDelay(v, ar_step_dt);
 
                         if (bbeam_dir * cmd_beam.cmb_state->auto_moving_mode > 0)
                             v = 1;
@@ -932,9 +1048,9 @@ void Actor::CalcCommands(bool doUpdate)
                             cf = crankfactor;
 
                         if (bbeam_dir > 0)
-                            ar_beams[bbeam].L *= (1.0 + cmd_beam.cmb_speed * v * cf * PHYSICS_DT / ar_beams[bbeam].L);
+                            ar_beams[bbeam].L *= (1.0 + cmd_beam.cmb_speed * v * cf * ar_step_dt / ar_beams[bbeam].L);
                         else
-                            ar_beams[bbeam].L *= (1.0 - cmd_beam.cmb_speed * v * cf * PHYSICS_DT / ar_beams[bbeam].L);
+                            ar_beams[bbeam].L *= (1.0 - cmd_beam.cmb_speed * v * cf * ar_step_dt / ar_beams[bbeam].L);
 
                         dl = fabs(dl - ar_beams[bbeam].L);
                         if (requestpower)
@@ -959,7 +1075,7 @@ void Actor::CalcCommands(bool doUpdate)
                 if (ar_rotators[rota].needs_engine && ((ar_engine && !ar_engine->isRunning()) || !ar_engine_hydraulics_ready))
                     continue;
 
-                v = ar_command_key[i].rotator_inertia.CalcCmdKeyDelay(ar_command_key[i].commandValue, PHYSICS_DT);
+                v = ar_command_key[i].rotator_inertia.CalcCmdKeyDelay(ar_command_key[i].commandValue, ar_step_dt);
 
                 if (v > 0.0f && ar_rotators[rota].engine_coupling > 0.0f)
                     requestpower = true;
@@ -970,9 +1086,9 @@ void Actor::CalcCommands(bool doUpdate)
                     cf = crankfactor;
 
                 if (ar_command_key[i].rotators[j] > 0)
-                    ar_rotators[rota].angle += ar_rotators[rota].rate * v * cf * PHYSICS_DT;
+                    ar_rotators[rota].angle += ar_rotators[rota].rate * v * cf * ar_step_dt;
                 else
-                    ar_rotators[rota].angle -= ar_rotators[rota].rate * v * cf * PHYSICS_DT;
+                    ar_rotators[rota].angle -= ar_rotators[rota].rate * v * cf * ar_step_dt;
 
                 if (doUpdate || v != 0.0f)
                 {
@@ -1065,7 +1181,7 @@ void Actor::CalcTies()
         float clen = it->ti_beam->L / it->ti_beam->refL;
         if (clen > it->ti_min_length)
         {
-            it->ti_beam->L *= (1.0 - it->ti_contract_speed * PHYSICS_DT / it->ti_beam->L);
+            it->ti_beam->L *= (1.0 - it->ti_contract_speed * ar_step_dt / it->ti_beam->L);
         }
         else
         {
@@ -1084,7 +1200,7 @@ void Actor::CalcTruckEngine(bool doUpdate)
 {
     if (ar_engine)
     {
-        ar_engine->UpdateEngineSim(PHYSICS_DT, doUpdate);
+        ar_engine->UpdateEngineSim(ar_step_dt, doUpdate);
     }
 }
 
@@ -1102,6 +1218,8 @@ bool Actor::CalcForcesEulerPrepare(bool doUpdate)
         return false;
     if (ar_physics_paused)
         return false;
+    if (ar_rigid_proxy)
+        return false;
     if (ar_state != ActorState::LOCAL_SIMULATED)
         return false;
 
@@ -1138,9 +1256,116 @@ void LogBeamNodes(RoR::Str<L>& msg, beam_t& beam) // Internal helper
     msg << ".";
 }
 
+inline void Actor::CalcPlainBeam(int i)
+{
+    beam_t& beam = ar_beams[i];
+
+    Vector3 dis;
+    float inverted_dislen, difftoBeamL;
+    const float slen = CalcPlainBeamStress(beam, dis, inverted_dislen, difftoBeamL);
+    beam.stress = slen;
+
+    // Fast test for deformation
+    if (std::abs(slen) > beam.minmaxposnegstress)
+    {
+        this->CalcBeamDeformation(i, beam.k, difftoBeamL, slen);
+    }
+
+    // At last update the beam forces
+    const Vector3 f = CalcPlainBeamForce(dis, slen, inverted_dislen);
+    beam.p1->Forces += f;
+    beam.p2->Forces -= f;
+}
+
+void Actor::CalcPlainBeamsParallel()
+{
+    // Each batch accumulates node forces into its own buffer; beams which need the
+    // (rare, non-thread-safe) deformation/breaking logic are deferred and processed
+    // sequentially afterwards, so results don't depend on scheduling.
+    const size_t num_batches = static_cast<size_t>(m_num_beam_batches);
+    const size_t batch_size = (m_plain_beams.size() + num_batches - 1) / num_batches;
+    const size_t num_nodes = static_cast<size_t>(ar_num_nodes);
+    m_beam_batch_forces.resize(num_batches);
+    m_beam_batch_deferred.resize(num_batches);
+
+    App::GetThreadPool()->ParallelFor(num_batches, [this, batch_size, num_nodes](size_t batch)
+        {
+            std::vector<Vector3>& forces = m_beam_batch_forces[batch];
+            std::vector<int>& deferred = m_beam_batch_deferred[batch];
+            forces.assign(num_nodes, Vector3::ZERO);
+            deferred.clear();
+
+            const size_t end = std::min(m_plain_beams.size(), (batch + 1) * batch_size);
+            for (size_t j = batch * batch_size; j < end; j++)
+            {
+                const int i = m_plain_beams[j];
+                beam_t& beam = ar_beams[i];
+                if (beam.bm_disabled || beam.bm_inter_actor)
+                    continue;
+
+                Vector3 dis;
+                float inverted_dislen, difftoBeamL;
+                const float slen = CalcPlainBeamStress(beam, dis, inverted_dislen, difftoBeamL);
+
+                if (std::abs(slen) > beam.minmaxposnegstress)
+                {
+                    deferred.push_back(i);
+                    continue;
+                }
+
+                beam.stress = slen;
+                const Vector3 f = CalcPlainBeamForce(dis, slen, inverted_dislen);
+                forces[beam.p1->pos] += f;
+                forces[beam.p2->pos] -= f;
+            }
+        });
+
+    // Reduce the batch buffers, split by node ranges
+    const size_t node_range = (num_nodes + num_batches - 1) / num_batches;
+    App::GetThreadPool()->ParallelFor(num_batches, [this, num_batches, node_range, num_nodes](size_t range)
+        {
+            const size_t end = std::min(num_nodes, (range + 1) * node_range);
+            for (size_t batch = 0; batch < num_batches; batch++)
+            {
+                const std::vector<Vector3>& forces = m_beam_batch_forces[batch];
+                for (size_t n = range * node_range; n < end; n++)
+                {
+                    ar_nodes[n].Forces += forces[n];
+                }
+            }
+        });
+
+    for (const std::vector<int>& deferred: m_beam_batch_deferred)
+    {
+        for (int i: deferred)
+        {
+            this->CalcPlainBeam(i);
+        }
+    }
+}
+
 void Actor::CalcBeams(bool trigger_hooks)
 {
-    for (int i = 0; i < ar_num_beams; i++)
+    ROR_PROFILE_ZONE("Actor::CalcBeams", ar_instance_id);
+
+    // Plain (NOSHOCK) beams make up the bulk of every rig - process them in a tight loop without the special-beam dispatch.
+    if (m_num_beam_batches > 1)
+    {
+        this->CalcPlainBeamsParallel();
+    }
+    else
+    {
+        for (int i: m_plain_beams)
+        {
+            if (!ar_beams[i].bm_disabled && !ar_beams[i].bm_inter_actor)
+            {
+                this->CalcPlainBeam(i);
+            }
+        }
+    }
+
+    // Bounded beams: shocks, triggers, supportbeams, ropes
+    for (int i: m_bounded_beams)
     {
         if (!ar_beams[i].bm_disabled && !ar_beams[i].bm_inter_actor)
         {
@@ -1249,152 +1474,187 @@ void Actor::CalcBeams(bool trigger_hooks)
             ar_beams[i].stress = slen;
 
             // Fast test for deformation
-            float len = std::abs(slen);
-            if (len > ar_beams[i].minmaxposnegstress)
+            if (std::abs(slen) > ar_beams[i].minmaxposnegstress)
+            {
+                this->CalcBeamDeformation(i, k, difftoBeamL, slen);
+            }
+
+            // At last update the beam forces
+            Vector3 f = dis;
+            f *= (slen * inverted_dislen);
+            ar_beams[i].p1->Forces += f;
+            ar_beams[i].p2->Forces -= f;
+        }
+    }
+
+    if (!m_beam_break_events.empty())
+    {
+        this->ProcessBeamBreakEvents();
+    }
+}
+
+void Actor::CalcBeamDeformation(int i, Real k, Real difftoBeamL, float& slen)
+{
+    float len = std::abs(slen);
+    if (ar_beams[i].bm_type == BEAM_NORMAL && ar_beams[i].bounded != SHOCK1 && k != 0.0f)
+    {
+        // Actual deformation tests
+        if (slen > ar_beams[i].maxposstress && difftoBeamL < 0.0f) // compression
+        {
+            Real yield_length = ar_beams[i].maxposstress / k;
+            Real deform = difftoBeamL + yield_length * (1.0f - ar_beams[i].plastic_coef);
+            Real Lold = ar_beams[i].L;
+            ar_beams[i].L += deform;
+            ar_beams[i].L = std::max(MIN_BEAM_LENGTH, ar_beams[i].L);
+            m_num_deform_events++;
+            slen = slen - (slen - ar_beams[i].maxposstress) * 0.5f;
+            len = slen;
+            if (ar_beams[i].L > 0.0f && Lold > ar_beams[i].L)
+            {
+                ar_beams[i].maxposstress *= Lold / ar_beams[i].L;
+                ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].maxposstress, -ar_beams[i].maxnegstress);
+                ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].minmaxposnegstress, ar_beams[i].strength);
+            }
+            // For the compression case we do not remove any of the beam's
+            // strength for structure stability reasons
+            //ar_beams[i].strength += deform * k * 0.5f;
+            if (m_beam_deform_debug_enabled)
+            {
+                RoR::Str<300> msg;
+                msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
+                    << len << " / " << ar_beams[i].strength << ". ";
+                LogBeamNodes(msg, ar_beams[i]);
+                RoR::Log(msg.ToCStr());
+            }
+        }
+        else if (slen < ar_beams[i].maxnegstress && difftoBeamL > 0.0f) // expansion
+        {
+            Real yield_length = ar_beams[i].maxnegstress / k;
+            Real deform = difftoBeamL + yield_length * (1.0f - ar_beams[i].plastic_coef);
+            Real Lold = ar_beams[i].L;
+            ar_beams[i].L += deform;
+            m_num_deform_events++;
+            slen = slen - (slen - ar_beams[i].maxnegstress) * 0.5f;
+            len = -slen;
+            if (Lold > 0.0f && ar_beams[i].L > Lold)
+            {
+                ar_beams[i].maxnegstress *= ar_beams[i].L / Lold;
+                ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].maxposstress, -ar_beams[i].maxnegstress);
+                ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].minmaxposnegstress, ar_beams[i].strength);
+            }
+            ar_beams[i].strength -= deform * k;
+            if (m_beam_deform_debug_enabled)
+            {
+                RoR::Str<300> msg;
+                msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
+                    << len << " / " << ar_beams[i].strength << ". ";
+                LogBeamNodes(msg, ar_beams[i]);
+                RoR::Log(msg.ToCStr());
+            }
+        }
+    }
+
+    // Test if the beam should break
+    if (len > ar_beams[i].strength)
+    {
+        beam_break_event_t event;
+        event.bbe_beam = i;
+        event.bbe_energy = 0.5f * k * difftoBeamL * difftoBeamL;
+        event.bbe_force = len;
+        event.bbe_broken = false;
+
+        //Break the beam only when it is not connected to a node
+        //which is a part of a collision triangle and has 2 "live" beams or less
+        //connected to it.
+        if (!((ar_beams[i].p1->nd_cab_node && GetNumActiveConnectedBeams(ar_beams[i].p1->pos) < 3) || (ar_beams[i].p2->nd_cab_node && GetNumActiveConnectedBeams(ar_beams[i].p2->pos) < 3)))
+        {
+            slen = 0.0f;
+            ar_beams[i].bm_broken = true;
+            ar_beams[i].bm_disabled = true;
+            m_num_deform_events++;
+            event.bbe_broken = true;
+        }
+        else
+        {
+            ar_beams[i].strength = 2.0f * ar_beams[i].minmaxposnegstress;
+        }
+
+        // Sound, diagnostics, detacher groups and buoyant hull are handled by `ProcessBeamBreakEvents()`
+        m_beam_break_events.push_back(event);
+    }
+}
+
+void Actor::ProcessBeamBreakEvents()
+{
+    for (beam_break_event_t const& event: m_beam_break_events)
+    {
+        const int i = event.bbe_beam;
+
+        // Sound effect.
+        // Sound volume depends on springs stored energy
+        SOUND_MODULATE(ar_instance_id, SS_MOD_BREAK, event.bbe_energy);
+        SOUND_PLAY_ONCE(ar_instance_id, SS_TRIG_BREAK);
+
+        if (event.bbe_broken)
+        {
+            if (m_beam_break_debug_enabled)
+            {
+                RoR::Str<200> msg;
+                msg << "[RoR|Diag] XXX Beam " << i << " just broke with force " << event.bbe_force << " / " << ar_beams[i].strength << ". ";
+                LogBeamNodes(msg, ar_beams[i]);
+                App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_NOTICE, msg.ToCStr());
+            }
+
+            // detachergroup check: beam[i] is already broken, check detacher group# == 0/default skip the check ( performance bypass for beams with default setting )
+            // only perform this check if this is a master detacher beams (positive detacher group id > 0)
+            if (ar_beams[i].detacher_group > 0)
             {
-                if (ar_beams[i].bm_type == BEAM_NORMAL && ar_beams[i].bounded != SHOCK1 && k != 0.0f)
+                // cycle once through the other beams
+                for (int j = 0; j < ar_num_beams; j++)
                 {
-                    // Actual deformation tests
-                    if (slen > ar_beams[i].maxposstress && difftoBeamL < 0.0f) // compression
+                    // beam[i] detacher group# == checked beams detacher group# -> delete & disable checked beam
+                    // do this with all master(positive id) and minor(negative id) beams of this detacher group
+                    if (abs(ar_beams[j].detacher_group) == ar_beams[i].detacher_group)
                     {
-                        Real yield_length = ar_beams[i].maxposstress / k;
-                        Real deform = difftoBeamL + yield_length * (1.0f - ar_beams[i].plastic_coef);
-                        Real Lold = ar_beams[i].L;
-                        ar_beams[i].L += deform;
-                        ar_beams[i].L = std::max(MIN_BEAM_LENGTH, ar_beams[i].L);
-                        slen = slen - (slen - ar_beams[i].maxposstress) * 0.5f;
-                        len = slen;
-                        if (ar_beams[i].L > 0.0f && Lold > ar_beams[i].L)
-                        {
-                            ar_beams[i].maxposstress *= Lold / ar_beams[i].L;
-                            ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].maxposstress, -ar_beams[i].maxnegstress);
-                            ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].minmaxposnegstress, ar_beams[i].strength);
-                        }
-                        // For the compression case we do not remove any of the beam's
-                        // strength for structure stability reasons
-                        //ar_beams[i].strength += deform * k * 0.5f;
-                        if (m_beam_deform_debug_enabled)
-                        {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
-                                << len << " / " << ar_beams[i].strength << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            RoR::Log(msg.ToCStr());
-                        }
-                    }
-                    else if (slen < ar_beams[i].maxnegstress && difftoBeamL > 0.0f) // expansion
-                    {
-                        Real yield_length = ar_beams[i].maxnegstress / k;
-                        Real deform = difftoBeamL + yield_length * (1.0f - ar_beams[i].plastic_coef);
-                        Real Lold = ar_beams[i].L;
-                        ar_beams[i].L += deform;
-                        slen = slen - (slen - ar_beams[i].maxnegstress) * 0.5f;
-                        len = -slen;
-                        if (Lold > 0.0f && ar_beams[i].L > Lold)
-                        {
-                            ar_beams[i].maxnegstress *= ar_beams[i].L / Lold;
-                            ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].maxposstress, -ar_beams[i].maxnegstress);
-                            ar_beams[i].minmaxposnegstress = std::min(ar_beams[i].minmaxposnegstress, ar_beams[i].strength);
-                        }
-                        ar_beams[i].strength -= deform * k;
-                        if (m_beam_deform_debug_enabled)
+                        ar_beams[j].bm_broken = true;
+                        ar_beams[j].bm_disabled = true;
+                        if (m_beam_break_debug_enabled)
                         {
-                            RoR::Str<300> msg;
-                            msg << "[RoR|Diag] YYY Beam " << i << " just deformed with extension force "
-                                << len << " / " << ar_beams[i].strength << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            RoR::Log(msg.ToCStr());
+                            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_NOTICE,
+                                "Deleting Detacher BeamID: " + TOSTRING(j) + ", Detacher Group: " + TOSTRING(ar_beams[i].detacher_group)+ ", actor ID: " + TOSTRING(ar_instance_id));
                         }
                     }
                 }
-
-                // Test if the beam should break
-                if (len > ar_beams[i].strength)
+                // cycle once through all wheeldetachers
+                for (wheeldetacher_t const& wheeldetacher: ar_wheeldetachers)
                 {
-                    // Sound effect.
-                    // Sound volume depends on springs stored energy
-                    SOUND_MODULATE(ar_instance_id, SS_MOD_BREAK, 0.5 * k * difftoBeamL * difftoBeamL);
-                    SOUND_PLAY_ONCE(ar_instance_id, SS_TRIG_BREAK);
-
-                    //Break the beam only when it is not connected to a node
-                    //which is a part of a collision triangle and has 2 "live" beams or less
-                    //connected to it.
-                    if (!((ar_beams[i].p1->nd_cab_node && GetNumActiveConnectedBeams(ar_beams[i].p1->pos) < 3) || (ar_beams[i].p2->nd_cab_node && GetNumActiveConnectedBeams(ar_beams[i].p2->pos) < 3)))
+                    if (wheeldetacher.wd_detacher_group == ar_beams[i].detacher_group)
                     {
-                        slen = 0.0f;
-                        ar_beams[i].bm_broken = true;
-                        ar_beams[i].bm_disabled = true;
-
+                        ar_wheels[wheeldetacher.wd_wheel_id].wh_is_detached = true;
                         if (m_beam_break_debug_enabled)
                         {
-                            RoR::Str<200> msg;
-                            msg << "[RoR|Diag] XXX Beam " << i << " just broke with force " << len << " / " << ar_beams[i].strength << ". ";
-                            LogBeamNodes(msg, ar_beams[i]);
-                            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_NOTICE, msg.ToCStr());
-                        }
-
-                        // detachergroup check: beam[i] is already broken, check detacher group# == 0/default skip the check ( performance bypass for beams with default setting )
-                        // only perform this check if this is a master detacher beams (positive detacher group id > 0)
-                        if (ar_beams[i].detacher_group > 0)
-                        {
-                            // cycle once through the other beams
-                            for (int j = 0; j < ar_num_beams; j++)
-                            {
-                                // beam[i] detacher group# == checked beams detacher group# -> delete & disable checked beam
-                                // do this with all master(positive id) and minor(negative id) beams of this detacher group
-                                if (abs(ar_beams[j].detacher_group) == ar_beams[i].detacher_group)
-                                {
-                                    ar_beams[j].bm_broken = true;
-                                    ar_beams[j].bm_disabled = true;
-                                    if (m_beam_break_debug_enabled)
-                                    {
-                                        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_NOTICE,
-                                            "Deleting Detacher BeamID: " + TOSTRING(j) + ", Detacher Group: " + TOSTRING(ar_beams[i].detacher_group)+ ", actor ID: " + TOSTRING(ar_instance_id));
-                                    }
-                                }
-                            }
-                            // cycle once through all wheeldetachers
-                            for (wheeldetacher_t const& wheeldetacher: ar_wheeldetachers)
-                            {
-                                if (wheeldetacher.wd_detacher_group == ar_beams[i].detacher_group)
-                                {
-                                    ar_wheels[wheeldetacher.wd_wheel_id].wh_is_detached = true;
-                                    if (m_beam_break_debug_enabled)
-                                    {
-                                        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_NOTICE,
-                                            "Detaching wheel ID: " + TOSTRING(wheeldetacher.wd_wheel_id) + ", Detacher Group: " + TOSTRING(ar_beams[i].detacher_group)+ ", actor ID: " + TOSTRING(ar_instance_id));
-                                    }
-                                }
-                            }
-                        }
-                    }
-                    else
-                    {
-                        ar_beams[i].strength = 2.0f * ar_beams[i].minmaxposnegstress;
-                    }
-
-                    // something broke, check buoyant hull
-                    for (int mk = 0; mk < ar_num_buoycabs; mk++)
-                    {
-                        int tmpv = ar_buoycabs[mk] * 3;
-                        if (ar_buoycab_types[mk] == Buoyance::BUOY_DRAGONLY)
-                            continue;
-                        if ((ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 2]]) &&
-                            (ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 2]]))
-                        {
-                            m_buoyance->sink = true;
+                            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_ACTOR, Console::CONSOLE_SYSTEM_NOTICE,
+                                "Detaching wheel ID: " + TOSTRING(wheeldetacher.wd_wheel_id) + ", Detacher Group: " + TOSTRING(ar_beams[i].detacher_group)+ ", actor ID: " + TOSTRING(ar_instance_id));
                         }
                     }
                 }
             }
+        }
 
-            // At last update the beam forces
-            Vector3 f = dis;
-            f *= (slen * inverted_dislen);
-            ar_beams[i].p1->Forces += f;
-            ar_beams[i].p2->Forces -= f;
+        // something broke, check buoyant hull
+        for (int mk = 0; mk < ar_num_buoycabs; mk++)
+        {
+            int tmpv = ar_buoycabs[mk] * 3;
+            if (ar_buoycab_types[mk] == Buoyance::BUOY_DRAGONLY)
+                continue;
+            if ((ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p1 == &ar_nodes[ar_cabs[tmpv + 2]]) &&
+                (ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 1]] || ar_beams[i].p2 == &ar_nodes[ar_cabs[tmpv + 2]]))
+            {
+                m_buoyance->sink = true;
+            }
         }
     }
+    m_beam_break_events.clear();
 }
 
 void Actor::CalcBeamsInterActor()
@@ -1530,52 +1790,178 @@ void Actor::CalcBeamsInterActor()
     }
 }
 
+void Actor::CalcImplicitForces()
+{
+    // Linearized backward Euler for the plain beams (which includes hydros and commands):
+    //   (M + c*L) dv = dt*F - dt^2*k*L*v,  with c = dt*d + dt^2*k
+    // where L couples the two nodes of each beam along its axis (n * n^T). Solved with a few
+    // block Jacobi sweeps starting from zero; the result is written back as forces, so the
+    // integration in `CalcNodes()` stays as is. Stiff rigs survive larger steps at the cost
+    // of some numerical damping.
+    ROR_PROFILE_ZONE("Actor::CalcImplicitForces", ar_instance_id);
+
+    const int iterations = App::sim_implicit_iterations->getInt();
+    if (iterations <= 0)
+        return;
+
+    const float dt = ar_step_dt;
+    m_implicit_dv.assign(ar_num_nodes, Vector3::ZERO);
+    m_implicit_rhs.resize(ar_num_nodes);
+    m_implicit_sum.resize(ar_num_nodes);
+    m_implicit_diag.assign(ar_num_nodes, Matrix3::ZERO);
+    m_implicit_beams.resize(m_plain_beams.size());
+
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        m_implicit_rhs[i] = ar_nodes[i].Forces * dt;
+    }
+
+    for (size_t b = 0; b < m_plain_beams.size(); b++)
+    {
+        const beam_t& beam = ar_beams[m_plain_beams[b]];
+        Vector4& ib = m_implicit_beams[b];
+        ib.w = 0.f;
+        if (beam.bm_broken || beam.bm_disabled || beam.bm_inter_actor)
+            continue;
+
+        Vector3 dir = beam.p1->RelPosition - beam.p2->RelPosition;
+        const float len = dir.length();
+        if (len < 1e-6f)
+            continue;
+        dir /= len;
+
+        const float c = dt * beam.d + dt * dt * beam.k;
+        ib = Vector4(dir.x, dir.y, dir.z, c);
+
+        const Matrix3 coupling(
+            c * dir.x * dir.x, c * dir.x * dir.y, c * dir.x * dir.z,
+            c * dir.y * dir.x, c * dir.y * dir.y, c * dir.y * dir.z,
+            c * dir.z * dir.x, c * dir.z * dir.y, c * dir.z * dir.z);
+        m_implicit_diag[beam.p1->pos] = m_implicit_diag[beam.p1->pos] + coupling;
+        m_implicit_diag[beam.p2->pos] = m_implicit_diag[beam.p2->pos] + coupling;
+
+        const Vector3 stiff = dir * (dt * dt * beam.k * dir.dotProduct(beam.p1->Velocity - beam.p2->Velocity));
+        m_implicit_rhs[beam.p1->pos] -= stiff;
+        m_implicit_rhs[beam.p2->pos] += stiff;
+    }
+
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        const Matrix3 diag = m_implicit_diag[i] + Matrix3::IDENTITY * ar_nodes[i].mass;
+        if (!diag.Inverse(m_implicit_diag[i]))
+        {
+            m_implicit_diag[i] = Matrix3::IDENTITY * (1.f / ar_nodes[i].mass);
+        }
+    }
+
+    for (int iter = 0; iter < iterations; iter++)
+    {
+        m_implicit_sum = m_implicit_rhs;
+        for (size_t b = 0; b < m_plain_beams.size(); b++)
+        {
+            const Vector4& ib = m_implicit_beams[b];
+            if (ib.w == 0.f)
+                continue;
+
+            const beam_t& beam = ar_beams[m_plain_beams[b]];
+            const Vector3 dir(ib.x, ib.y, ib.z);
+            m_implicit_sum[beam.p1->pos] += dir * (ib.w * dir.dotProduct(m_implicit_dv[beam.p2->pos]));
+            m_implicit_sum[beam.p2->pos] += dir * (ib.w * dir.dotProduct(m_implicit_dv[beam.p1->pos]));
+        }
+        for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+        {
+            if (!ar_nodes[i].nd_immovable)
+            {
+                m_implicit_dv[i] = m_implicit_diag[i] * m_implicit_sum[i];
+            }
+        }
+    }
+
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        ar_nodes[i].Forces = m_implicit_dv[i] * (ar_nodes[i].mass / dt);
+    }
+}
+
 void Actor::CalcNodes()
 {
+    ROR_PROFILE_ZONE("Actor::CalcNodes", ar_instance_id);
+
     const auto water = App::GetGameContext()->GetTerrain()->getWater();
     const float gravity = App::GetGameContext()->GetTerrain()->getGravity();
+    Collisions* collisions = App::GetGameContext()->GetTerrain()->GetCollisions();
+
+    // Sample the waves once for this step if the actor floats or wades; nodes and buoyant cabs query them many times
+    if (water)
+    {
+        const size_t BUOYCAB_QUERIES = 10; // Roughly, see `Buoyance::computeNodeForce()`
+        const bool in_water = m_water_contact || ar_num_buoycabs > 0;
+        const size_t expected_queries = (in_water) ? (ar_num_nodes + BUOYCAB_QUERIES * ar_num_buoycabs) : 0;
+        m_wave_field.UpdateWaveField(water, ar_bounding_box, expected_queries, ar_num_buoycabs > 0);
+    }
     m_water_contact = false;
 
+    // Look up terrain heights for all nodes in one go, in place of a terrain query per node.
+    // Landuse is only resolved by `groundCollision()` for the few nodes which actually penetrate the ground.
+    m_ground_heights.resize(ar_num_nodes);
+    App::GetGameContext()->GetTerrain()->GetHeightsAt(&ar_nodes[0].AbsPosition, ar_num_nodes, sizeof(node_t), m_ground_heights.data());
+
+    // COLLISION
+    // Done in a separate pass so that the integration loop below only streams
+    // through the kinematic fields at the front of `node_t` and stays compact.
     for (NodeNum_t i = 0; i < ar_num_nodes; i++)
     {
-        // COLLISION
-        if (!ar_nodes[i].nd_no_ground_contact)
-        {
-            Vector3 oripos = ar_nodes[i].AbsPosition;
-            bool contacted = App::GetGameContext()->GetTerrain()->GetCollisions()->groundCollision(&ar_nodes[i], PHYSICS_DT);
-            contacted = contacted | App::GetGameContext()->GetTerrain()->GetCollisions()->nodeCollision(&ar_nodes[i], PHYSICS_DT);
-            ar_nodes[i].nd_has_ground_contact = contacted;
-            if (ar_nodes[i].nd_has_ground_contact || ar_nodes[i].nd_has_mesh_contact)
+        node_t& node = ar_nodes[i];
+        if (!node.nd_no_ground_contact)
+        {
+            Vector3 oripos = node.AbsPosition;
+            bool contacted = collisions->groundCollision(&node, ar_step_dt, m_ground_heights[i]);
+            contacted = contacted | collisions->nodeCollision(&node, ar_step_dt);
+            node.nd_has_ground_contact = contacted;
+            if (node.nd_has_ground_contact || node.nd_has_mesh_contact)
             {
-                ar_last_fuzzy_ground_model = ar_nodes[i].nd_last_collision_gm;
+                ar_last_fuzzy_ground_model = node.nd_last_collision_gm;
                 // Reverts: commit/d11a88142f737528638bd357c38d717c85cebba6#diff-4003254e55aec2c60d21228f375f2a2dL1153
                 // Fixes: Gavril Omega Six sliding on ground on the simple2 spawn
-                // ar_nodes[i].AbsPosition - oripos is always zero ... dark floating point magic
-                ar_nodes[i].RelPosition += ar_nodes[i].AbsPosition - oripos;
+                // node.AbsPosition - oripos is always zero ... dark floating point magic
+                node.RelPosition += node.AbsPosition - oripos;
             }
         }
+    }
 
-        if (i == ar_main_camera_node_pos)
-        {
-            // record g forces on cameras
-            m_camera_gforces_accu += ar_nodes[i].Forces / ar_nodes[i].mass;
-        }
+    if (m_implicit_solver)
+    {
+        this->CalcImplicitForces();
+    }
+
+    // record g forces on cameras
+    if (ar_main_camera_node_pos < ar_num_nodes)
+    {
+        m_camera_gforces_accu += ar_nodes[ar_main_camera_node_pos].Forces / ar_nodes[ar_main_camera_node_pos].mass;
+    }
+
+    Real max_speed_sq = 0.f;
+    for (NodeNum_t i = 0; i < ar_num_nodes; i++)
+    {
+        node_t& node = ar_nodes[i];
 
         // integration
-        if (!ar_nodes[i].nd_immovable)
+        if (!node.nd_immovable)
         {
-            ar_nodes[i].Velocity += ar_nodes[i].Forces / ar_nodes[i].mass * PHYSICS_DT;
-            ar_nodes[i].RelPosition += ar_nodes[i].Velocity * PHYSICS_DT;
-            ar_nodes[i].AbsPosition = ar_origin;
-            ar_nodes[i].AbsPosition += ar_nodes[i].RelPosition;
+            node.Velocity += node.Forces / node.mass * ar_step_dt;
+            node.RelPosition += node.Velocity * ar_step_dt;
+            node.AbsPosition = ar_origin;
+            node.AbsPosition += node.RelPosition;
         }
 
         // prepare next loop (optimisation)
         // we start forces from zero
         // start with gravity
-        ar_nodes[i].Forces = Vector3(0, ar_nodes[i].mass * gravity, 0);
+        node.Forces = Vector3(0, node.mass * gravity, 0);
 
-        Real approx_speed = approx_sqrt(ar_nodes[i].Velocity.squaredLength());
+        const Real speed_sq = node.Velocity.squaredLength();
+        max_speed_sq = std::max(max_speed_sq, speed_sq);
+        Real approx_speed = approx_sqrt(speed_sq);
 
         // anti-explsion guard (mach 20)
         if (approx_speed > 6860 && !m_ongoing_reset)
@@ -1590,31 +1976,31 @@ void Actor::CalcNodes()
         if (m_fusealge_airfoil)
         {
             // aerodynamics on steroids!
-            ar_nodes[i].Forces += ar_fusedrag;
+            node.Forces += ar_fusedrag;
         }
         else if (!ar_disable_aerodyn_turbulent_drag)
         {
             // add viscous drag (turbulent model)
             Real defdragxspeed = DEFAULT_DRAG * approx_speed;
-            Vector3 drag = -defdragxspeed * ar_nodes[i].Velocity;
+            Vector3 drag = -defdragxspeed * node.Velocity;
             // plus: turbulences
             Real maxtur = defdragxspeed * approx_speed * 0.005f;
-            drag += maxtur * Vector3(frand_11(), frand_11(), frand_11());
-            ar_nodes[i].Forces += drag;
+            drag += maxtur * Vector3(frand_11(m_turbulence_seed), frand_11(m_turbulence_seed), frand_11(m_turbulence_seed));
+            node.Forces += drag;
         }
 
         if (water)
         {
-            const bool is_under_water = water->IsUnderWater(ar_nodes[i].AbsPosition);
+            const bool is_under_water = m_wave_field.IsUnderWater(node.AbsPosition);
             if (is_under_water)
             {
                 m_water_contact = true;
                 if (ar_num_buoycabs == 0)
                 {
                     // water drag (turbulent)
-                    ar_nodes[i].Forces -= (DEFAULT_WATERDRAG * approx_speed) * ar_nodes[i].Velocity;
+                    node.Forces -= (DEFAULT_WATERDRAG * approx_speed) * node.Velocity;
                     // basic buoyance
-                    ar_nodes[i].Forces += ar_nodes[i].buoyancy * Vector3::UNIT_Y;
+                    node.Forces += node.buoyancy * Vector3::UNIT_Y;
                 }
                 // engine stall
                 if (i == ar_cinecam_node[0] && ar_engine)
@@ -1622,9 +2008,10 @@ void Actor::CalcNodes()
                     ar_engine->StopEngine();
                 }
             }
-            ar_nodes[i].nd_under_water = is_under_water;
+            node.nd_under_water = is_under_water;
         }
     }
+    m_max_node_speed_sq = max_speed_sq;
 }
 
 void Actor::CalcEventBoxes()
@@ -1712,7 +2099,7 @@ void Actor::CalcHooks()
     for (std::vector<hook_t>::iterator it = ar_hooks.begin(); it != ar_hooks.end(); it++)
     {
         //we need to do this here to avoid countdown speedup by triggers
-        it->hk_timer = std::max(0.0f, it->hk_timer - PHYSICS_DT);
+        it->hk_timer = std::max(0.0f, it->hk_timer - ar_step_dt);
 
         if (it->hk_lock_node && it->hk_locked == PRELOCK)
         {
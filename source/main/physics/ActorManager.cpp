@@ -27,13 +27,17 @@
 
 #include "Application.h"
 #include "Actor.h"
+#include "AppContext.h"
 #include "CacheSystem.h"
+#include "CameraManager.h"
 #include "ContentManager.h"
 #include "ChatSystem.h"
 #include "Collisions.h"
 #include "DashBoardManager.h"
 #include "DynamicCollisions.h"
 #include "EngineSim.h"
+#include "FlexBody.h"
+#include "FrameArena.h"
 #include "GameContext.h"
 #include "GfxScene.h"
 #include "GUIManager.h"
@@ -46,10 +50,13 @@
 #include "PointColDetector.h"
 #include "Replay.h"
 #include "RigDef_Validator.h"
+#include "RoRnet.h"
 #include "ActorSpawner.h"
 #include "ScriptEngine.h"
+#include "SimProfiler.h"
 #include "SoundScriptManager.h"
 #include "Terrain.h"
+#include "TexturePreloader.h"
 #include "ThreadPool.h"
 #include "Utils.h"
 #include "VehicleAI.h"
@@ -66,13 +73,14 @@ ActorManager::ActorManager()
     , m_physics_steps(2000)
     , m_simulation_speed(1.0f)
 {
-    // Create worker thread (used for physics calculations)
-    m_sim_thread_pool = std::unique_ptr<ThreadPool>(new ThreadPool(1));
+    // Create worker thread (used for physics calculations); it drives the physics workers, so it must not be preempted by background work
+    m_sim_thread_pool = std::unique_ptr<ThreadPool>(new ThreadPool(1, ThreadPriority::HIGH));
 }
 
 ActorManager::~ActorManager()
 {
     this->SyncWithSimThread(); // Wait for sim task to finish
+    this->SyncWithSaveTask(); // Finish writing the savegame
 }
 
 ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr def)
@@ -86,10 +94,28 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
 
     LOG(" == Spawning vehicle: " + def->name);
 
+    // Remote actors are spawned without what only local simulation needs (see `ActorSpawner::m_net_lightweight`)
+    const bool net_lightweight = (rq.asr_origin == ActorSpawnRequest::Origin::NETWORK);
+
+    // Remote actors have fewer beams; they neither use nor fill templates
+    ActorSpawnTemplate* tmpl = nullptr;
+    if (!net_lightweight)
+    {
+        tmpl = &m_spawn_templates[std::make_pair(def.get(), actor->m_section_config)];
+    }
+    const bool tmpl_ready = tmpl && tmpl->def != nullptr;
+
     ActorSpawner spawner;
     spawner.ConfigureSections(actor->m_section_config, def);
+    if (tmpl_ready)
+    {
+        spawner.UsePlainBeamOrder(&tmpl->plain_beams);
+    }
     spawner.ProcessNewActor(actor, rq, def);
 
+    // The template must describe exactly this structure, otherwise indices would be off
+    const bool tmpl_valid = tmpl_ready && tmpl->num_nodes == actor->ar_num_nodes && tmpl->num_beams == actor->ar_num_beams;
+
     if (App::diag_actor_dump->getBool())
     {
         actor->WriteDiagnosticDump(actor->ar_filename + "_dump_raw.txt"); // Saves file to 'logs'
@@ -98,7 +124,10 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
     /* POST-PROCESSING */
 
     actor->ar_initial_node_positions.resize(actor->ar_num_nodes);
-    actor->ar_initial_beam_defaults.resize(actor->ar_num_beams);
+    if (!net_lightweight) // Only used by resets and 'nodebeam' randomization
+    {
+        actor->ar_initial_beam_defaults.resize(actor->ar_num_beams);
+    }
     actor->ar_initial_node_masses.resize(actor->ar_num_nodes);
 
     actor->UpdateBoundingBoxes(); // (records the unrotated dimensions for 'veh_aab_size')
@@ -120,7 +149,11 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
     };
 
     /* Place correctly */
-    if (spawner.GetMemoryRequirements().num_fixes == 0)
+    if (net_lightweight)
+    {
+        actor->resetPosition(rq.asr_position, true); // Overwritten by the first network update anyway
+    }
+    else if (spawner.GetMemoryRequirements().num_fixes == 0)
     {
         Ogre::Vector3 vehicle_position = rq.asr_position;
 
@@ -177,6 +210,28 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
         actor->ar_initial_node_masses[i] = actor->ar_nodes[i].mass;
     }
 
+    // Explicit Euler needs `dt * sqrt(k/m)` and `dt * d/m` well below 2 for every beam;
+    // allow half rate (see `UpdateStepTiers()`) only with a safety factor of 2 at twice the dt.
+    if (actor->m_implicit_solver && App::sim_implicit_iterations->getInt() > 0)
+    {
+        actor->ar_max_step_divisor = 2; // Unconditionally stable, see `Actor::CalcImplicitForces()`
+    }
+    else if (!net_lightweight)
+    {
+        const float dt_half_rate = PHYSICS_DT * 2.f;
+        actor->ar_max_step_divisor = 2;
+        for (int i = 0; i < actor->ar_num_beams; i++)
+        {
+            const beam_t& beam = actor->ar_beams[i];
+            const float inv_mass = 1.f / beam.p1->mass + 1.f / beam.p2->mass;
+            if (dt_half_rate * std::sqrt(beam.k * inv_mass) > 1.f || dt_half_rate * beam.d * inv_mass > 1.f)
+            {
+                actor->ar_max_step_divisor = 1;
+                break;
+            }
+        }
+    }
+
     //setup default sounds
     if (!actor->m_disable_default_sounds)
     {
@@ -184,7 +239,15 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
     }
 
     //compute node connectivity graph
-    actor->calcNodeConnectivityGraph();
+    if (tmpl_valid)
+    {
+        actor->ar_node_to_node_connections = tmpl->node_to_node;
+        actor->ar_node_to_beam_connections = tmpl->node_to_beam;
+    }
+    else
+    {
+        actor->calcNodeConnectivityGraph();
+    }
 
     actor->UpdateBoundingBoxes();
     actor->calculateAveragePosition();
@@ -213,11 +276,41 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
     }
 
     // Set beam defaults
-    for (int i = 0; i < actor->ar_num_beams; i++)
+    for (int i = 0; i < actor->ar_num_beams && !net_lightweight; i++)
     {
         actor->ar_beams[i].initial_beam_strength       = actor->ar_beams[i].strength;
         actor->ar_beams[i].default_beam_deform         = actor->ar_beams[i].minmaxposnegstress;
         actor->ar_initial_beam_defaults[i]             = std::make_pair(actor->ar_beams[i].k, actor->ar_beams[i].d);
+
+        // Groups for 'Node/Beam utils' scales, so that a scale change only touches its own beams
+        if (tmpl_valid)
+            continue;
+        if ((actor->ar_beams[i].p1->nd_tyre_node || actor->ar_beams[i].p1->nd_rim_node) ||
+            (actor->ar_beams[i].p2->nd_tyre_node || actor->ar_beams[i].p2->nd_rim_node))
+            actor->ar_nb_wheel_beams.push_back(i);
+        else if (actor->ar_beams[i].bounded == SHOCK1 || actor->ar_beams[i].bounded == SHOCK2 || actor->ar_beams[i].bounded == SHOCK3)
+            actor->ar_nb_shock_beams.push_back(i);
+        else
+            actor->ar_nb_plain_beams.push_back(i);
+    }
+
+    if (tmpl_valid)
+    {
+        actor->ar_nb_plain_beams = tmpl->nb_plain_beams;
+        actor->ar_nb_shock_beams = tmpl->nb_shock_beams;
+        actor->ar_nb_wheel_beams = tmpl->nb_wheel_beams;
+    }
+    else if (tmpl)
+    {
+        tmpl->def            = def;
+        tmpl->num_nodes      = actor->ar_num_nodes;
+        tmpl->num_beams      = actor->ar_num_beams;
+        tmpl->plain_beams    = actor->m_plain_beams;
+        tmpl->node_to_node   = actor->ar_node_to_node_connections;
+        tmpl->node_to_beam   = actor->ar_node_to_beam_connections;
+        tmpl->nb_plain_beams = actor->ar_nb_plain_beams;
+        tmpl->nb_shock_beams = actor->ar_nb_shock_beams;
+        tmpl->nb_wheel_beams = actor->ar_nb_wheel_beams;
     }
 
     actor->m_spawn_rotation = actor->getRotation();
@@ -256,14 +349,21 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
     {
         actor->GetGfxActor()->UpdateSimDataBuffer(); // Initial fill of sim data buffers
 
-        actor->GetGfxActor()->UpdateFlexbodies(); // Push tasks to threadpool
-        actor->GetGfxActor()->UpdateWheelVisuals(); // Push tasks to threadpool
+        // Flexbodies are independent of each other, deform them all in parallel; uploaded by `FinishFlexbodyTasks()`
+        std::vector<FlexBody*> flexbodies;
+        actor->GetGfxActor()->UpdateFlexbodies(flexbodies);
+        App::GetThreadPool()->ParallelFor(flexbodies.size(), [&flexbodies](size_t i)
+            {
+                flexbodies[i]->computeFlexbody();
+            });
+        actor->GetGfxActor()->UpdateWheelVisuals();
+        actor->GetGfxActor()->ComputeVisuals(0.f, true);
         actor->GetGfxActor()->UpdateCabMesh();
         actor->GetGfxActor()->UpdateWingMeshes();
         actor->GetGfxActor()->UpdateProps(0.f, false);
         actor->GetGfxActor()->UpdateRods(); // beam visuals
-        actor->GetGfxActor()->FinishWheelUpdates(); // Sync tasks from threadpool
-        actor->GetGfxActor()->FinishFlexbodyTasks(); // Sync tasks from threadpool
+        actor->GetGfxActor()->FinishWheelUpdates();
+        actor->GetGfxActor()->FinishFlexbodyTasks();
     }
 
     App::GetGfxScene()->RegisterGfxActor(actor->GetGfxActor());
@@ -276,7 +376,7 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
             actor->ar_engine->OffStart();
     }
     // pressurize tires
-    if (actor->getTyrePressure().IsEnabled())
+    if (actor->getTyrePressure().IsEnabled() && !net_lightweight)
     {
         actor->getTyrePressure().ModifyTyrePressure(0.f); // Initialize springiness of pressure-beams.
     }
@@ -339,6 +439,7 @@ ActorPtr ActorManager::CreateNewActor(ActorSpawnRequest rq, RigDef::DocumentPtr
 void ActorManager::RemoveStreamSource(int sourceid)
 {
     m_stream_mismatches.erase(sourceid);
+    App::GetGameContext()->CancelPendingNetworkSpawns(sourceid);
 
     for (ActorPtr& actor : m_actors)
     {
@@ -353,20 +454,25 @@ void ActorManager::RemoveStreamSource(int sourceid)
 }
 
 #ifdef USE_SOCKETW
-void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_buffer)
+void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket*> const& packets)
 {
+    ROR_PROFILE_ZONE("ActorManager::HandleActorStreamData", -1);
+
+    FrameVector<RoR::NetRecvPacket*> packet_buffer(packets.begin(), packets.end()); // Reordered below, other handlers need the original
+
     // Sort by stream source
     std::stable_sort(packet_buffer.begin(), packet_buffer.end(),
-            [](const RoR::NetRecvPacket& a, const RoR::NetRecvPacket& b)
-            { return a.header.source > b.header.source; });
+            [](const RoR::NetRecvPacket* a, const RoR::NetRecvPacket* b)
+            { return a->header.source > b->header.source; });
     // Compress data stream by eliminating all but the last update from every consecutive group of stream data updates
     auto it = std::unique(packet_buffer.rbegin(), packet_buffer.rend(),
-            [](const RoR::NetRecvPacket& a, const RoR::NetRecvPacket& b)
-            { return !memcmp(&a.header, &b.header, sizeof(RoRnet::Header)) &&
-            a.header.command == RoRnet::MSG2_STREAM_DATA; });
+            [](const RoR::NetRecvPacket* a, const RoR::NetRecvPacket* b)
+            { return !memcmp(&a->header, &b->header, sizeof(RoRnet::Header)) &&
+            a->header.command == RoRnet::MSG2_STREAM_DATA; });
     packet_buffer.erase(packet_buffer.begin(), it.base());
-    for (auto& packet : packet_buffer)
+    for (RoR::NetRecvPacket* packet_view : packet_buffer)
     {
+        RoR::NetRecvPacket& packet = *packet_view;
         if (packet.header.command == RoRnet::MSG2_STREAM_REGISTER)
         {
             RoRnet::StreamRegister* reg = (RoRnet::StreamRegister *)packet.buffer;
@@ -395,7 +501,9 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
 
                     LOG("[RoR] Creating remote actor for " + TOSTRING(reg->origin_sourceid) + ":" + TOSTRING(reg->origin_streamid));
 
-                    if (!App::GetCacheSystem()->CheckResourceLoaded(filename))
+                    // Don't load the bundle here, only start reading it; the spawn finishes over the next frames
+                    CacheEntry* cache_entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, filename);
+                    if (cache_entry == nullptr)
                     {
                         App::GetConsole()->putMessage(
                             Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_WARNING,
@@ -406,6 +514,8 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                     }
                     else
                     {
+                        filename = cache_entry->fname;
+                        App::GetCacheSystem()->PrefetchResource(*cache_entry);
                         auto actor_reg = reinterpret_cast<RoRnet::ActorStreamRegister*>(reg);
                         if (m_stream_time_offsets.find(reg->origin_sourceid) == m_stream_time_offsets.end())
                         {
@@ -473,6 +583,7 @@ void ActorManager::HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet_
                 }
             }
             m_stream_mismatches[packet.header.source].erase(packet.header.streamid);
+            App::GetGameContext()->CancelPendingNetworkSpawns(packet.header.source, packet.header.streamid);
         }
         else if (packet.header.command == RoRnet::MSG2_USER_LEAVE)
         {
@@ -629,6 +740,17 @@ void ActorManager::RecursiveActivation(int j, std::vector<bool>& visited)
 
     visited[j] = true;
 
+    // Linked actors wake up as a group
+    for (ActorPtr& linked_actor: m_actors[j]->ar_linked_actors)
+    {
+        if (linked_actor->ar_state == ActorState::LOCAL_SLEEPING)
+        {
+            linked_actor->ar_sleep_counter = 0.0f;
+            linked_actor->ar_state = ActorState::LOCAL_SIMULATED;
+            this->RecursiveActivation(linked_actor->ar_vector_index, visited);
+        }
+    }
+
     for (unsigned int t = 0; t < m_actors.size(); t++)
     {
         if (t == j || visited[t])
@@ -647,7 +769,7 @@ void ActorManager::RecursiveActivation(int j, std::vector<bool>& visited)
     }
 }
 
-void ActorManager::ForwardCommands(ActorPtr source_actor)
+void ActorManager::ForwardCommands(const ActorPtr& source_actor)
 {
     if (source_actor->ar_forward_commands)
     {
@@ -773,7 +895,7 @@ void ActorManager::SyncLinkedActors()
     }
 }
 
-void ActorManager::UpdateSleepingState(ActorPtr player_actor, float dt)
+void ActorManager::UpdateSleepingState(const ActorPtr& player_actor, float dt)
 {
     if (!m_forced_awake)
     {
@@ -783,17 +905,44 @@ void ActorManager::UpdateSleepingState(ActorPtr player_actor, float dt)
                 continue;
             if (actor->ar_driveable == AI)
                 continue;
-            if (actor->getVelocity().squaredLength() > 0.01f)
+            // The average velocity hides nodes which keep swinging or sliding
+            // (i.e. a loose part or a trailer resting on a slope), check the fastest node too.
+            if (actor->getVelocity().squaredLength() > 0.01f ||
+                actor->m_max_node_speed_sq > 0.25f)
             {
                 actor->ar_sleep_counter = 0.0f;
                 continue;
             }
 
             actor->ar_sleep_counter += dt;
+        }
+
+        // Linked actors (hooks, ties, ropes) only fall asleep together,
+        // otherwise the sleeping one would turn into a fixed anchor for the rest.
+        for (ActorPtr& actor: m_actors)
+        {
+            if (actor->ar_state != ActorState::LOCAL_SIMULATED || actor->ar_sleep_counter < 10.0f)
+                continue;
+
+            bool group_idle = true;
+            for (ActorPtr& linked_actor: actor->ar_linked_actors)
+            {
+                if (linked_actor->ar_state == ActorState::LOCAL_SIMULATED &&
+                    (linked_actor->ar_driveable == AI || linked_actor->ar_sleep_counter < 10.0f))
+                {
+                    group_idle = false;
+                    break;
+                }
+            }
 
-            if (actor->ar_sleep_counter >= 10.0f)
+            if (group_idle)
             {
                 actor->ar_state = ActorState::LOCAL_SLEEPING;
+                for (ActorPtr& linked_actor: actor->ar_linked_actors)
+                {
+                    if (linked_actor->ar_state == ActorState::LOCAL_SIMULATED)
+                        linked_actor->ar_state = ActorState::LOCAL_SLEEPING;
+                }
             }
         }
     }
@@ -914,6 +1063,7 @@ void ActorManager::CleanUpSimulation() // Called after simulation finishes
         this->DeleteActorInternal(m_actors.back());
     }
 
+    m_spawn_templates.clear();
     m_total_sim_time = 0.f;
     m_last_simulation_speed = 0.1f;
     m_simulation_paused = false;
@@ -1045,7 +1195,7 @@ const ActorPtr& ActorManager::FetchRescueVehicle()
     return ACTORPTR_NULL;
 }
 
-void ActorManager::UpdateActors(ActorPtr player_actor)
+void ActorManager::UpdateActors(const ActorPtr& player_actor)
 {
     float dt = m_simulation_time;
 
@@ -1056,18 +1206,41 @@ void ActorManager::UpdateActors(ActorPtr player_actor)
 
     dt += m_dt_remainder;
     m_physics_steps = dt / PHYSICS_DT;
+    if (App::sim_deterministic->getBool() && !m_simulation_paused)
+    {
+        // Same number of steps every frame, whatever the frame time
+        m_physics_steps = std::max(1, App::sim_deterministic_steps->getInt());
+        dt = m_physics_steps * PHYSICS_DT;
+    }
     if (m_physics_steps == 0)
     {
         return;
     }
 
     m_dt_remainder = dt - (m_physics_steps * PHYSICS_DT);
-    dt = PHYSICS_DT * m_physics_steps;
 
     this->SyncWithSimThread();
 
+    // Don't let a slow frame schedule more steps than the sim thread can do in one frame;
+    // the dropped time is not carried over, or every following frame would be slower still.
+    const float budget_us = App::sim_step_budget_ms->getFloat() * 1000.f;
+    if (budget_us > 0.f && m_step_cost_us > 0.f && !App::sim_deterministic->getBool())
+    {
+        m_physics_steps = std::min(m_physics_steps, std::max(1, static_cast<int>(budget_us / m_step_cost_us)));
+    }
+    dt = PHYSICS_DT * m_physics_steps;
+
     this->UpdateSleepingState(player_actor, dt);
 
+    if (App::mp_state->getEnum<MpState>() == RoR::MpState::CONNECTED)
+    {
+        this->UpdateNetSendIntervals(player_actor);
+        this->UpdateNetRelevance();
+    }
+
+    this->UpdateStepTiers(player_actor);
+    this->UpdatePhysicsLod(player_actor, dt);
+
     for (ActorPtr& actor: m_actors)
     {
         actor->HandleInputEvents(dt);
@@ -1100,8 +1273,10 @@ void ActorManager::UpdateActors(ActorPtr player_actor)
         if (actor->ar_state != ActorState::LOCAL_SLEEPING)
         {
             actor->updateVisual(dt);
-            if (actor->ar_update_physics && App::gfx_skidmarks_mode->getInt() > 0)
+            if (actor->ar_update_physics && App::gfx_skidmarks_mode->getInt() > 0 &&
+                App::GetGfxScene()->GetFrameBudget().IsTaskDue(GfxBudgetTask::SKIDMARKS))
             {
+                GfxBudgetZone budget_zone(App::GetGfxScene()->GetFrameBudget(), GfxBudgetTask::SKIDMARKS);
                 actor->updateSkidmarks();
             }
         }
@@ -1141,14 +1316,31 @@ void ActorManager::UpdateActors(ActorPtr player_actor)
             player_actor->ar_toggle_ropes = false;
         }
 
-        player_actor->ForceFeedbackStep(m_physics_steps);
-
         if (player_actor->ar_state == ActorState::LOCAL_REPLAY)
         {
             player_actor->getReplay()->replayStepActor();
         }
     }
 
+    // The other actors of a session replay (see `replay play`) follow the player actor's replay
+    const bool player_replay = player_actor && player_actor->ar_state == ActorState::LOCAL_REPLAY && player_actor->getReplay();
+    for (ActorPtr& actor: m_actors)
+    {
+        if (actor == player_actor || actor->ar_state != ActorState::LOCAL_REPLAY || !actor->getReplay())
+            continue;
+
+        if (player_replay)
+        {
+            actor->getReplay()->setCurrentFrame(player_actor->getReplay()->getCurrentFrame());
+            actor->getReplay()->replayStepActor();
+        }
+        else
+        {
+            actor->ar_state = ActorState::LOCAL_SIMULATED;
+            actor->getReplay()->StopPlayback();
+        }
+    }
+
     auto func = std::function<void()>([this]()
         {
             this->UpdatePhysicsSimulation();
@@ -1156,6 +1348,7 @@ void ActorManager::UpdateActors(ActorPtr player_actor)
     m_sim_task = m_sim_thread_pool->RunTask(func);
 
     m_total_sim_time += dt;
+    m_total_sim_steps += m_physics_steps;
 
     if (!App::app_async_physics->getBool())
         m_sim_task->join();
@@ -1175,77 +1368,451 @@ const ActorPtr& ActorManager::GetActorById(ActorInstanceID_t actor_id)
 
 void ActorManager::UpdatePhysicsSimulation()
 {
+    ROR_PROFILE_ZONE("ActorManager::UpdatePhysicsSimulation", -1);
+    const int64_t begin_us = SimProfiler::GetTimestampUs();
+    FrameArenaScope arena_scope; // Runs on a pool thread - free this step's transient containers when done
+
     for (ActorPtr& actor: m_actors)
     {
         actor->UpdatePhysicsOrigin();
+        actor->ar_steps_planned = (actor->ar_step_phase + m_physics_steps) / actor->ar_step_divisor;
+        actor->ar_steps_taken = 0;
     }
     for (int i = 0; i < m_physics_steps; i++)
     {
         {
-            std::vector<std::function<void()>> tasks;
+            m_sim_step_actors.clear();
             for (ActorPtr& actor: m_actors)
             {
-                if (actor->ar_update_physics = actor->CalcForcesEulerPrepare(i == 0))
+                if (++actor->ar_step_phase < actor->ar_step_divisor)
                 {
-                    auto func = std::function<void()>([this, i, &actor]()
-                        {
-                            actor->CalcForcesEulerCompute(i == 0, m_physics_steps);
-                        });
-                    tasks.push_back(func);
+                    continue; // Reduced rate, see `UpdateStepTiers()`
                 }
-            }
-            App::GetThreadPool()->Parallelize(tasks);
-            for (ActorPtr& actor: m_actors)
-            {
-                if (actor->ar_update_physics)
+                actor->ar_step_phase = 0;
+                if (actor->ar_update_physics = actor->CalcForcesEulerPrepare(actor->ar_steps_taken == 0))
                 {
-                    actor->CalcBeamsInterActor();
+                    m_sim_step_actors.push_back(actor.GetRef());
                 }
             }
+            this->AssignBeamBatches();
+            App::GetThreadPool()->ParallelFor(m_sim_step_actors.size(), [this](size_t index)
+                {
+                    Actor* actor = m_sim_step_actors[index];
+                    actor->CalcForcesEulerCompute(actor->ar_steps_taken == 0, actor->ar_steps_planned);
+                    actor->ar_steps_taken++;
+                });
+            this->AssignInterActorGroups();
+            App::GetThreadPool()->ParallelFor(m_inter_actor_groups.size(), [this](size_t index)
+                {
+                    for (Actor* actor: m_inter_actor_groups[index])
+                    {
+                        actor->CalcBeamsInterActor();
+                    }
+                });
         }
         {
-            std::vector<std::function<void()>> tasks;
+            m_sim_step_actors.clear();
             for (ActorPtr& actor: m_actors)
             {
-                if (actor->m_inter_point_col_detector != nullptr && (actor->ar_update_physics ||
-                        (App::mp_pseudo_collisions->getBool() && actor->ar_state == ActorState::NETWORKED_OK)))
+                if (actor->m_inter_point_col_detector != nullptr && ((actor->ar_update_physics && actor->ar_step_phase == 0) ||
+                        (App::mp_pseudo_collisions->getBool() && actor->ar_state == ActorState::NETWORKED_OK && !actor->m_net_reduced_detail)))
                 {
-                    auto func = std::function<void()>([this, &actor]()
-                        {
-                            actor->m_inter_point_col_detector->UpdateInterPoint();
-                            if (actor->ar_collision_relevant)
-                            {
-                                ResolveInterActorCollisions(PHYSICS_DT,
-                                   *actor->m_inter_point_col_detector,
-                                    actor->ar_num_collcabs,
-                                    actor->ar_collcabs,
-                                    actor->ar_cabs,
-                                    actor->ar_inter_collcabrate,
-                                    actor->ar_nodes,
-                                    actor->ar_collision_range,
-                                   *actor->ar_submesh_ground_model);
-                            }
-                        });
-                    tasks.push_back(func);
+                    m_sim_step_actors.push_back(actor.GetRef());
+                }
+            }
+            this->UpdateInterActorBroadPhase();
+            auto resolve_collisions = [this](size_t index)
+                {
+                    Actor* actor = m_sim_step_actors[index];
+                    ROR_PROFILE_ZONE("InterActorCollisions", actor->ar_instance_id);
+                    actor->m_inter_point_col_detector->UpdateInterPoint(actor->m_inter_col_partners);
+                    if (actor->ar_collision_relevant)
+                    {
+                        ResolveInterActorCollisions(PHYSICS_DT,
+                           *actor->m_inter_point_col_detector,
+                            actor->ar_num_collcabs,
+                            actor->ar_collcabs,
+                            actor->ar_cabs,
+                            actor->ar_inter_collcabrate,
+                            actor->ar_nodes,
+                            actor->ar_collision_range,
+                           *actor->ar_submesh_ground_model,
+                            (App::sim_cab_bvh->getBool()) ? &actor->m_cab_bvh : nullptr);
+                    }
+                };
+            if (App::sim_deterministic->getBool())
+            {
+                // Actors push the nodes of their partners, so the outcome depends on the order
+                for (size_t index = 0; index < m_sim_step_actors.size(); index++)
+                {
+                    resolve_collisions(index);
                 }
             }
-            App::GetThreadPool()->Parallelize(tasks);
+            else
+            {
+                App::GetThreadPool()->ParallelFor(m_sim_step_actors.size(), resolve_collisions);
+            }
         }
     }
     for (ActorPtr& actor: m_actors)
     {
         actor->m_ongoing_reset = false;
-        if (actor->ar_update_physics && m_physics_steps > 0)
+        if (actor->ar_update_physics && actor->ar_steps_taken > 0)
         {
-            Vector3  camera_gforces = actor->m_camera_gforces_accu / m_physics_steps;
+            Vector3  camera_gforces = actor->m_camera_gforces_accu / actor->ar_steps_taken;
             actor->m_camera_gforces_accu = Vector3::ZERO;
             actor->m_camera_gforces = actor->m_camera_gforces * 0.5f + camera_gforces * 0.5f;
             actor->calculateLocalGForces();
             actor->calculateAveragePosition();
             actor->m_avg_node_velocity  = actor->m_avg_node_position - actor->m_avg_node_position_prev;
-            actor->m_avg_node_velocity /= (m_physics_steps * PHYSICS_DT);
+            actor->m_avg_node_velocity /= (actor->ar_steps_taken * actor->ar_step_dt);
             actor->m_avg_node_position_prev = actor->m_avg_node_position;
             actor->ar_top_speed = std::max(actor->ar_top_speed, actor->ar_nodes[0].Velocity.length());
+            actor->GetGfxActor()->BufferNodesFromSimThread();
+        }
+    }
+
+    // Publish right away instead of waiting for the next frame on the main thread
+    Actor* player_actor = App::GetGameContext()->GetPlayerActor().GetRef();
+    if (App::io_ffb_enabled->getBool() && player_actor && player_actor->ar_update_physics &&
+        player_actor->ar_driveable == TRUCK && m_physics_steps > 0)
+    {
+        player_actor->ForceFeedbackStep(m_physics_steps);
+        App::GetAppContext()->GetForceFeedback().PublishForces(player_actor);
+    }
+
+    if (m_physics_steps > 0)
+    {
+        const float cost_us = static_cast<float>(SimProfiler::GetTimestampUs() - begin_us) / m_physics_steps;
+        m_step_cost_us = (m_step_cost_us > 0.f) ? (m_step_cost_us + (cost_us - m_step_cost_us) * 0.1f) : cost_us;
+    }
+}
+
+void ActorManager::UpdateNetSendIntervals(const ActorPtr& player_actor)
+{
+    // Parked actors are sent at 1 Hz, moving ones faster with speed, up to 30 Hz.
+    // Damage must be seen quickly, so a deforming actor gets the full rate.
+    const float MIN_RATE = 1.f;
+    const float MAX_RATE = 30.f;
+    const float PLAYER_MIN_RATE = 10.f; // The former fixed rate
+
+    float total_bytes_per_sec = 0.f;
+    FrameVector<std::pair<Actor*, float>> rates;
+    for (ActorPtr& actor: m_actors)
+    {
+        if (actor->ar_state == ActorState::NETWORKED_OK || actor->ar_state == ActorState::NETWORKED_HIDDEN)
+            continue;
+
+        float rate = MIN_RATE;
+        if (actor->ar_state == ActorState::LOCAL_SIMULATED)
+        {
+            rate = Ogre::Math::Clamp(actor->getVelocity().length() * 1.5f, MIN_RATE, MAX_RATE);
+            if (actor->m_num_deform_events != actor->m_net_last_deform_events)
+            {
+                rate = MAX_RATE;
+            }
+            if (actor == player_actor)
+            {
+                rate = std::max(rate, PLAYER_MIN_RATE);
+            }
+        }
+        actor->m_net_last_deform_events = actor->m_num_deform_events;
+
+        total_bytes_per_sec += rate * (actor->m_net_total_buffer_size + sizeof(RoRnet::VehicleState));
+        rates.push_back(std::make_pair(actor.GetRef(), rate));
+    }
+
+    // Over budget: slow everyone down evenly, but never below the minimum rate
+    const float budget = App::mp_net_send_budget->getInt() * 1024.f;
+    const float scale = (budget > 0.f && total_bytes_per_sec > budget) ? (budget / total_bytes_per_sec) : 1.f;
+    for (auto& entry: rates)
+    {
+        const float rate = std::max(entry.second * scale, MIN_RATE);
+        entry.first->m_net_send_interval_ms = static_cast<unsigned long>(1000.f / rate);
+    }
+}
+
+void ActorManager::UpdateNetRelevance()
+{
+    // Beyond the detail distance, or off-screen and not close by, remote actors
+    // jump to each incoming update instead of being interpolated every frame;
+    // their visuals are only refreshed when that happens, and they don't collide.
+    const float detail_dist = App::mp_net_detail_distance->getFloat();
+    const float HYSTERESIS = 0.9f; // Needs to come this much closer to switch back
+    const float OFFSCREEN_RATIO = 0.25f; // Invisible actors closer than this fraction stay detailed, they may turn up any moment
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+
+    for (ActorPtr& actor: m_actors)
+    {
+        if (actor->ar_state != ActorState::NETWORKED_OK || detail_dist <= 0.f || !camera)
+        {
+            actor->m_net_reduced_detail = false;
+            continue;
+        }
+
+        const float dist = actor->ar_bounding_box.distance(camera->getDerivedPosition());
+        const float limit = (actor->m_net_reduced_detail) ? (detail_dist * HYSTERESIS) : detail_dist;
+        const bool visible = camera->isVisible(actor->ar_bounding_box);
+        actor->m_net_reduced_detail = (dist > limit) || (!visible && dist > limit * OFFSCREEN_RATIO);
+    }
+}
+
+void ActorManager::UpdatePhysicsLod(const ActorPtr& player_actor, float dt)
+{
+    // Distant AI actors suspend their softbody and move as a rigid body once per frame, instead of
+    // every physics step. Parked actors don't need this, they fall asleep. Anything which could
+    // deform or interact with other actors keeps the softbody.
+    const float lod_dist = App::sim_physics_lod_distance->getFloat();
+    const float HYSTERESIS = 0.9f; // Needs to come this much closer to switch back
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const bool enabled = lod_dist > 0.f && camera && !App::sim_deterministic->getBool();
+
+    for (ActorPtr& actor: m_actors)
+    {
+        bool proxy = false;
+        if (enabled && actor != player_actor &&
+            actor->ar_state == ActorState::LOCAL_SIMULATED && !actor->ar_physics_paused &&
+            actor->ar_vehicle_ai && actor->ar_vehicle_ai->isActive() &&
+            actor->ar_linked_actors.empty() && actor->m_inter_col_partners.empty() &&
+            actor->m_mouse_grab_node == NODENUM_INVALID && !actor->m_water_contact)
+        {
+            const float dist = actor->ar_bounding_box.distance(camera->getDerivedPosition());
+            const float limit = (actor->ar_rigid_proxy) ? (lod_dist * HYSTERESIS) : lod_dist;
+            proxy = (dist > limit);
+        }
+
+        if (proxy && !actor->ar_rigid_proxy)
+        {
+            actor->EnterRigidProxy();
+        }
+        else if (!proxy && actor->ar_rigid_proxy)
+        {
+            actor->LeaveRigidProxy();
+        }
+
+        if (actor->ar_rigid_proxy)
+        {
+            actor->UpdateRigidProxy(dt);
+            actor->GetGfxActor()->BufferNodesFromSimThread();
+        }
+    }
+}
+
+void ActorManager::UpdateStepTiers(const ActorPtr& player_actor)
+{
+    // Slow actors far from the camera step at half rate with twice the dt. Actors linked to
+    // others or touching them stay at full rate, so inter-actor beams and collisions always
+    // see both sides step together. Tiers change the outcome, so not in deterministic mode.
+    const float tier_dist = App::sim_step_tier_distance->getFloat();
+    const float MAX_SPEED = 5.f; // m/s
+    const float HYSTERESIS = 0.9f; // Needs to come this much closer to switch back
+    Ogre::Camera* camera = App::GetCameraManager()->GetCamera();
+    const bool enabled = tier_dist > 0.f && camera && !App::sim_deterministic->getBool();
+
+    for (ActorPtr& actor: m_actors)
+    {
+        int divisor = 1;
+        if (enabled && actor != player_actor && actor->ar_max_step_divisor > 1 &&
+            actor->ar_state == ActorState::LOCAL_SIMULATED &&
+            actor->ar_linked_actors.empty() && actor->m_inter_col_partners.empty() &&
+            actor->m_mouse_grab_node == NODENUM_INVALID &&
+            actor->getVelocity().length() < MAX_SPEED)
+        {
+            const float dist = actor->ar_bounding_box.distance(camera->getDerivedPosition());
+            const float limit = (actor->ar_step_divisor > 1) ? (tier_dist * HYSTERESIS) : tier_dist;
+            if (dist > limit)
+            {
+                divisor = actor->ar_max_step_divisor;
+            }
+        }
+        if (divisor != actor->ar_step_divisor)
+        {
+            actor->ar_step_divisor = divisor;
+            actor->ar_step_dt = PHYSICS_DT * divisor;
+            actor->ar_step_phase = 0;
+        }
+    }
+}
+
+void ActorManager::UpdateInterActorBroadPhase()
+{
+    // Simulated actors are both probes and targets, networked actors with pseudo-collisions only probe.
+    const bool pseudo_collisions = App::mp_pseudo_collisions->getBool();
+    m_broadphase_sweep.clear();
+    for (ActorPtr& actor: m_actors)
+    {
+        actor->m_inter_col_partners.clear();
+        if (actor->ar_update_physics || (pseudo_collisions && actor->ar_state == ActorState::NETWORKED_OK && !actor->m_net_reduced_detail))
+        {
+            m_broadphase_sweep.push_back(actor.GetRef());
+        }
+    }
+
+    std::sort(m_broadphase_sweep.begin(), m_broadphase_sweep.end(), [](Actor* a, Actor* b)
+        {
+            return a->ar_bounding_box.getMinimum().x < b->ar_bounding_box.getMinimum().x;
+        });
+
+    // Sweep along X; only overlapping pairs are tested on all axes.
+    for (size_t i = 0; i < m_broadphase_sweep.size(); i++)
+    {
+        Actor* a = m_broadphase_sweep[i];
+        const float max_x = a->ar_bounding_box.getMaximum().x;
+        for (size_t j = i + 1; j < m_broadphase_sweep.size(); j++)
+        {
+            Actor* b = m_broadphase_sweep[j];
+            if (b->ar_bounding_box.getMinimum().x > max_x)
+                break;
+            if (!a->ar_bounding_box.intersects(b->ar_bounding_box))
+                continue;
+
+            // Only simulated actors are collision targets, see `PointColDetector::UpdateInterPoint()`
+            if (b->ar_update_physics)
+                a->m_inter_col_partners.push_back(b);
+            if (a->ar_update_physics)
+                b->m_inter_col_partners.push_back(a);
+        }
+    }
+
+    // Keep a stable partner order so `PointColDetector` only rebuilds its structures when the partners really change.
+    for (Actor* actor: m_broadphase_sweep)
+    {
+        std::sort(actor->m_inter_col_partners.begin(), actor->m_inter_col_partners.end(), [](Actor* a, Actor* b)
+            {
+                return a->ar_vector_index < b->ar_vector_index;
+            });
+    }
+}
+
+void ActorManager::AssignBeamBatches()
+{
+    // With fewer actors than threads, split the beams of large actors so idle workers can help.
+    // Each batch should have at least half the threshold of beams to be worth the reduction overhead.
+    const int threshold = App::sim_parallel_beams_min->getInt();
+    const int num_threads = App::GetThreadPool()->GetNumWorkers() + 1; // Including the sim thread
+    const int spare_threads = num_threads - static_cast<int>(m_sim_step_actors.size());
+    for (Actor* actor: m_sim_step_actors)
+    {
+        actor->m_num_beam_batches = 1;
+        const int num_beams = static_cast<int>(actor->m_plain_beams.size());
+        if (threshold > 0 && spare_threads > 0 && num_beams >= threshold)
+        {
+            actor->m_num_beam_batches = std::max(2, std::min(spare_threads + 1, num_beams / std::max(1, threshold / 2)));
+        }
+    }
+}
+
+void ActorManager::AssignInterActorGroups()
+{
+    // Inter-actor beams write forces into nodes of both actors, so actors joined by links (even indirectly)
+    // must be processed by the same task; `Actor::ar_linked_group` tells which. Groups keep the `m_actors` order,
+    // which makes the forces add up in the same order as when all actors are processed on a single thread.
+    size_t num_groups = 0;
+    for (Actor* actor: m_sim_step_actors) // Ordered like `m_actors`
+    {
+        if (actor->ar_inter_beams.empty())
+        {
+            continue;
+        }
+        size_t group_id = 0; // There are few groups, a linear search beats a lookup table
+        while (group_id < num_groups && m_inter_actor_groups[group_id][0]->ar_linked_group != actor->ar_linked_group)
+        {
+            group_id++;
+        }
+        if (group_id == num_groups)
+        {
+            num_groups++;
+            if (m_inter_actor_groups.size() < num_groups)
+            {
+                m_inter_actor_groups.emplace_back();
+            }
+            m_inter_actor_groups[group_id].clear();
+        }
+        m_inter_actor_groups[group_id].push_back(actor);
+    }
+    m_inter_actor_groups.resize(num_groups);
+}
+
+void ActorManager::MergeLinkedGroups(ActorPtr a, ActorPtr b)
+{
+    // Weighted quick-find: the smaller group takes the bigger one's ID, so over any sequence of links
+    // each actor is relabeled at most log(n) times, and the group of an actor is always known without a search.
+    if (a->ar_linked_group == b->ar_linked_group)
+    {
+        return;
+    }
+    if (a->ar_linked_actors.size() < b->ar_linked_actors.size())
+    {
+        std::swap(a, b);
+    }
+
+    ActorPtrVec group = a->ar_linked_actors;
+    group.push_back(a);
+    const size_t num_kept = group.size();
+    group.insert(group.end(), b->ar_linked_actors.begin(), b->ar_linked_actors.end());
+    group.push_back(b);
+    for (size_t i = num_kept; i < group.size(); i++)
+    {
+        group[i]->ar_linked_group = a->ar_linked_group;
+    }
+    this->AssignLinkedActors(group);
+}
+
+void ActorManager::SplitLinkedGroup(ActorPtr actor)
+{
+    // Labels can't be split, so walk the remaining links of this one group to find what still hangs together.
+    // Each part is named after one of its members, which keeps IDs unique across groups.
+    const ActorInstanceID_t old_group = actor->ar_linked_group;
+    ActorPtrVec remaining = actor->ar_linked_actors;
+    remaining.push_back(actor);
+    while (!remaining.empty())
+    {
+        ActorPtrVec group;
+        group.push_back(remaining.back());
+        remaining.pop_back();
+        for (size_t i = 0; i < group.size(); i++) // Grows as linked actors are found
+        {
+            for (auto& link: inter_actor_links)
+            {
+                if (link.second.first->ar_linked_group != old_group)
+                {
+                    continue;
+                }
+                auto itor = remaining.end();
+                if (link.second.first == group[i])
+                {
+                    itor = std::find(remaining.begin(), remaining.end(), link.second.second);
+                }
+                else if (link.second.second == group[i])
+                {
+                    itor = std::find(remaining.begin(), remaining.end(), link.second.first);
+                }
+                if (itor != remaining.end())
+                {
+                    group.push_back(*itor);
+                    remaining.erase(itor);
+                }
+            }
+        }
+        for (ActorPtr& member: group)
+        {
+            member->ar_linked_group = group[0]->ar_instance_id;
+        }
+        this->AssignLinkedActors(group);
+    }
+}
+
+void ActorManager::AssignLinkedActors(ActorPtrVec const& group)
+{
+    for (ActorPtr const& actor: group)
+    {
+        actor->ar_linked_actors.clear();
+        for (ActorPtr const& other: group)
+        {
+            if (other != actor)
+            {
+                actor->ar_linked_actors.push_back(other);
+            }
         }
     }
 }
@@ -1270,19 +1837,92 @@ void HandleErrorLoadingTruckfile(std::string filename, std::string exception_msg
 }
 
 RigDef::DocumentPtr ActorManager::FetchActorDef(std::string filename, bool predefined_on_terrain)
+{
+    ActorDefSource src;
+    if (!this->ReadActorDefSource(filename, src))
+    {
+        return nullptr; // Error already reported
+    }
+    if (src.cache_entry->actor_def != nullptr)
+    {
+        return src.cache_entry->actor_def;
+    }
+
+    RigDef::DocumentPtr def = ActorManager::ParseActorDef(src, predefined_on_terrain);
+    this->StoreActorDef(src, def);
+    return def;
+}
+
+void ActorManager::PrepareActorDefs(std::vector<std::string> const& filenames, bool predefined_on_terrain)
+{
+    ROR_PROFILE_ZONE("ActorManager::PrepareActorDefs", -1);
+
+    // Get all the bundles into the OS file cache at once; reading them below is then just unzipping
+    std::vector<CacheEntry*> entries;
+    std::vector<std::string> unique_filenames;
+    for (std::string const& filename: filenames)
+    {
+        CacheEntry* entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, filename);
+        if (entry != nullptr && std::find(entries.begin(), entries.end(), entry) == entries.end())
+        {
+            entries.push_back(entry);
+            unique_filenames.push_back(filename);
+            App::GetCacheSystem()->PrefetchResource(*entry);
+        }
+    }
+
+    // Reading needs Ogre's resource system, so it's main thread work; decoding textures starts right away
+    std::vector<ActorDefSource> sources;
+    std::vector<std::shared_ptr<TexturePreloader>> textures;
+    for (std::string const& filename: unique_filenames)
+    {
+        ActorDefSource src;
+        if (!this->ReadActorDefSource(filename, src))
+        {
+            continue; // Error already reported
+        }
+        std::shared_ptr<TexturePreloader> preloader = TexturePreloader::Start(src.cache_entry->resource_group);
+        if (preloader)
+        {
+            textures.push_back(preloader);
+        }
+        if (src.cache_entry->actor_def == nullptr)
+        {
+            sources.push_back(src);
+        }
+    }
+
+    std::vector<RigDef::DocumentPtr> defs(sources.size());
+    App::GetThreadPool()->ParallelFor(sources.size(), [&sources, &defs, predefined_on_terrain](size_t i)
+        {
+            defs[i] = ActorManager::ParseActorDef(sources[i], predefined_on_terrain);
+        });
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        this->StoreActorDef(sources[i], defs[i]);
+    }
+    for (auto& preloader: textures)
+    {
+        preloader->CreateTextures();
+    }
+}
+
+bool ActorManager::ReadActorDefSource(std::string filename, ActorDefSource& out_src)
 {
     // Find the user content
     CacheEntry* cache_entry = App::GetCacheSystem()->FindEntryByFilename(LT_AllBeam, /*partial=*/false, filename);
     if (cache_entry == nullptr)
     {
         HandleErrorLoadingTruckfile(filename, "Truckfile not found in ModCache (probably not installed)");
-        return nullptr;
+        return false;
     }
+    out_src.cache_entry = cache_entry;
+    out_src.filename = filename;
 
     // If already parsed, re-use
     if (cache_entry->actor_def != nullptr)
     {
-        return cache_entry->actor_def;
+        return true;
     }
 
     // Load the 'truckfile'
@@ -1293,20 +1933,55 @@ RigDef::DocumentPtr ActorManager::FetchActorDef(std::string filename, bool prede
         if (!App::GetCacheSystem()->CheckResourceLoaded(resource_filename, resource_groupname)) // Validates the filename and finds resource group
         {
             HandleErrorLoadingTruckfile(filename, "Truckfile not found");
-            return nullptr;
+            return false;
         }
         Ogre::DataStreamPtr stream = Ogre::ResourceGroupManager::getSingleton().openResource(resource_filename, resource_groupname);
 
         if (stream.isNull() || !stream->isReadable())
         {
             HandleErrorLoadingTruckfile(filename, "Unable to open/read truckfile");
-            return nullptr;
+            return false;
         }
+        out_src.filename = resource_filename;
+        out_src.resource_group = resource_groupname;
+        out_src.content = stream->getAsString();
+
+        // Reuse the definition parsed in an earlier session, unless the file changed since
+        out_src.hash = Sha1Hash(out_src.content);
+        RigDef::DocumentPtr cached_def = App::GetCacheSystem()->LoadCachedActorDef(out_src.hash);
+        if (cached_def != nullptr)
+        {
+            RoR::LogFormat("[RoR] Loaded parsed truckfile '%s' from cache", resource_filename.c_str());
+            cache_entry->actor_def = cached_def;
+        }
+        return true;
+    }
+    catch (Ogre::Exception& oex)
+    {
+        HandleErrorLoadingTruckfile(filename, oex.getFullDescription().c_str());
+        return false;
+    }
+    catch (std::exception& stex)
+    {
+        HandleErrorLoadingTruckfile(filename, stex.what());
+        return false;
+    }
+    catch (...)
+    {
+        HandleErrorLoadingTruckfile(filename, "<Unknown exception occurred>");
+        return false;
+    }
+}
 
-        RoR::LogFormat("[RoR] Parsing truckfile '%s'", resource_filename.c_str());
+RigDef::DocumentPtr ActorManager::ParseActorDef(ActorDefSource const& src, bool predefined_on_terrain)
+{
+    try
+    {
+        RoR::LogFormat("[RoR] Parsing truckfile '%s'", src.filename.c_str());
+        Ogre::MemoryDataStream stream(src.filename, (void*)src.content.data(), src.content.size(), /*freeOnClose=*/false, /*readOnly=*/true);
         RigDef::Parser parser;
         parser.Prepare();
-        parser.ProcessOgreStream(stream.getPointer(), resource_groupname);
+        parser.ProcessOgreStream(&stream, src.resource_group);
         parser.Finalize();
 
         auto def = parser.GetFile();
@@ -1323,7 +1998,7 @@ RigDef::DocumentPtr ActorManager::FetchActorDef(std::string filename, bool prede
             //     "soundloads" = play sound effect at certain spot
             //     "fixes"      = structures of N/B fixed to the ground
             // These files can have no beams. Possible extensions: .load or .fixed
-            std::string file_extension = filename.substr(filename.find_last_of('.'));
+            std::string file_extension = src.filename.substr(src.filename.find_last_of('.'));
             Ogre::StringUtil::toLowerCase(file_extension);
             if ((file_extension == ".load") | (file_extension == ".fixed"))
             {
@@ -1333,28 +2008,36 @@ RigDef::DocumentPtr ActorManager::FetchActorDef(std::string filename, bool prede
 
         validator.Validate(); // Sends messages to console
 
-        def->hash = Sha1Hash(stream->getAsString());
-
-        cache_entry->actor_def = def;
+        def->hash = src.hash;
         return def;
     }
     catch (Ogre::Exception& oex)
     {
-        HandleErrorLoadingTruckfile(filename, oex.getFullDescription().c_str());
+        HandleErrorLoadingTruckfile(src.filename, oex.getFullDescription().c_str());
         return nullptr;
     }
     catch (std::exception& stex)
     {
-        HandleErrorLoadingTruckfile(filename, stex.what());
+        HandleErrorLoadingTruckfile(src.filename, stex.what());
         return nullptr;
     }
     catch (...)
     {
-        HandleErrorLoadingTruckfile(filename, "<Unknown exception occurred>");
+        HandleErrorLoadingTruckfile(src.filename, "<Unknown exception occurred>");
         return nullptr;
     }
 }
 
+void ActorManager::StoreActorDef(ActorDefSource const& src, RigDef::DocumentPtr def)
+{
+    if (def == nullptr)
+    {
+        return; // Error already reported
+    }
+    App::GetCacheSystem()->SaveCachedActorDef(def);
+    src.cache_entry->actor_def = def;
+}
+
 std::vector<ActorPtr> ActorManager::GetLocalActors()
 {
     std::vector<ActorPtr> actors;
@@ -1456,7 +2139,7 @@ void ActorManager::UpdateInputEvents(float dt)
     }
 }
 
-void ActorManager::UpdateTruckFeatures(ActorPtr vehicle, float dt)
+void ActorManager::UpdateTruckFeatures(const ActorPtr& vehicle, float dt)
 {
     if (vehicle->isBeingReset() || vehicle->ar_physics_paused)
         return;
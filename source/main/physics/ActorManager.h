@@ -42,6 +42,33 @@ namespace RoR {
 /// @addtogroup Physics
 /// @{
 
+struct SavegameSnapshot; // Defined in Savegame.cpp
+
+/// Truckfile read into memory, so it can be parsed on any thread.
+struct ActorDefSource
+{
+    CacheEntry*    cache_entry = nullptr;
+    std::string    filename;
+    std::string    resource_group;
+    std::string    content;
+    std::string    hash;           //!< SHA1 of `content`, keys the on-disk definition cache.
+};
+
+/// Spawn results which only depend on the definition and section config, kept from the first
+/// spawn so further instances of the same vehicle copy them instead of recomputing.
+struct ActorSpawnTemplate
+{
+    RigDef::DocumentPtr            def;            //!< Keeps the definition alive so the key pointer can't be reused
+    int                            num_nodes = 0;
+    int                            num_beams = 0;
+    std::vector<int>               plain_beams;    //!< `Actor::m_plain_beams`, sorted
+    std::vector<std::vector<int>>  node_to_node;   //!< `Actor::ar_node_to_node_connections`
+    std::vector<std::vector<int>>  node_to_beam;   //!< `Actor::ar_node_to_beam_connections`
+    std::vector<int>               nb_plain_beams;
+    std::vector<int>               nb_shock_beams;
+    std::vector<int>               nb_wheel_beams;
+};
+
 /// Builds and manages softbody actors (physics on background thread, networking)
 class ActorManager
 {
@@ -66,7 +93,7 @@ public:
     const ActorPtr& FetchRescueVehicle();
     /// @}
 
-    void           UpdateActors(ActorPtr player_actor);
+    void           UpdateActors(const ActorPtr& player_actor);
     void           SyncWithSimThread();
     void           UpdatePhysicsSimulation();
     void           WakeUpAllActors();
@@ -86,25 +113,36 @@ public:
     bool           IsSimulationPaused() const              { return m_simulation_paused; }
     void           SetSimulationPaused(bool v)             { m_simulation_paused = v; }
     float          GetTotalTime() const                    { return m_total_sim_time; }
+    int64_t        GetTotalSteps() const                   { return m_total_sim_steps; }
     RoR::CmdKeyInertiaConfig& GetInertiaConfig()           { return m_inertia_config; }
 
     void           CleanUpSimulation(); //!< Call this after simulation loop finishes.
 
     void           RepairActor(Collisions* collisions, const Ogre::String& inst, const Ogre::String& box, bool keepPosition = false);
-    void           UpdateSleepingState(ActorPtr player_actor, float dt);
+    void           UpdateSleepingState(const ActorPtr& player_actor, float dt);
     
 
     void           UpdateInputEvents(float dt);
     RigDef::DocumentPtr   FetchActorDef(std::string filename, bool predefined_on_terrain = false);
 
+    /// @name Loading actor definitions in steps; `FetchActorDef()` does all of them at once.
+    /// @{
+    bool                  ReadActorDefSource(std::string filename, ActorDefSource& out_src); //!< Main thread; fills `cache_entry->actor_def` if already parsed or cached on disk. False if error was reported.
+    static RigDef::DocumentPtr ParseActorDef(ActorDefSource const& src, bool predefined_on_terrain); //!< Thread-safe; parses and validates. Nullptr if error was reported.
+    void                  StoreActorDef(ActorDefSource const& src, RigDef::DocumentPtr def); //!< Main thread; saves to disk cache and keeps it in the cache entry.
+    /// @}
+    void                  PrepareActorDefs(std::vector<std::string> const& filenames, bool predefined_on_terrain); //!< Main thread; batch of the above - parses all definitions in parallel (duplicates once) and decodes their textures, so spawning them is instant.
+
 #ifdef USE_SOCKETW
-    void           HandleActorStreamData(std::vector<RoR::NetRecvPacket> packet);
+    void           HandleActorStreamData(std::vector<RoR::NetRecvPacket*> const& packets); //!< Takes views into the receive ring, see `Network::GetIncomingStreamData()`
 #endif
 
     // Savegames (defined in Savegame.cpp)
 
     bool           LoadScene(Ogre::String filename);
     bool           SaveScene(Ogre::String filename);
+    void           SaveSceneAsync(std::string const& filename); //!< Copies the scene state now, writes it on the background lane; skipped while the previous one is still being written.
+    void           SyncWithSaveTask();                          //!< Waits until the file from `SaveSceneAsync()` is written.
     void           RestoreSavedState(ActorPtr actor, rapidjson::Value const& j_entry);
 
     ActorPtrVec& GetActors() { return m_actors; };
@@ -117,6 +155,8 @@ public:
     // A list of all beams interconnecting two actors
     std::map<beam_t*, std::pair<ActorPtr, ActorPtr>> inter_actor_links;
     void SyncLinkedActors();
+    void MergeLinkedGroups(ActorPtr a, ActorPtr b); //!< Call after a link between `a` and `b` was added; updates `Actor::ar_linked_group` and `ar_linked_actors`
+    void SplitLinkedGroup(ActorPtr actor);          //!< Call after link(s) within the actor's group were removed; the group may fall apart
     /// @}
 
     static const ActorPtr ACTORPTR_NULL; // Dummy value to be returned as const reference.
@@ -127,28 +167,48 @@ private:
     bool           PredictActorCollAabbIntersect(int a, int b);  //!< Returns whether or not the bounding boxes of truck a and truck b might intersect during the next framestep. Based on the truck collision bounding boxes.
     void           RemoveStreamSource(int sourceid);
     void           RecursiveActivation(int j, std::vector<bool>& visited);
-    void           ForwardCommands(ActorPtr source_actor); //!< Fowards things to trailers
-    void           UpdateTruckFeatures(ActorPtr vehicle, float dt);
+    void           ForwardCommands(const ActorPtr& source_actor); //!< Fowards things to trailers
+    void           UpdateTruckFeatures(const ActorPtr& vehicle, float dt);
+    void           AssignBeamBatches();                           //!< Chooses between per-actor and intra-actor parallelism for `m_sim_step_actors`
+    void           AssignInterActorGroups();                      //!< Splits `m_sim_step_actors` with inter-actor beams into `m_inter_actor_groups`
+    void           AssignLinkedActors(ActorPtrVec const& group);  //!< Fills `Actor::ar_linked_actors` of all members
+    void           UpdateInterActorBroadPhase();                  //!< Sweep-and-prune on actor bounding boxes; fills `Actor::m_inter_col_partners`
+    void           UpdateNetSendIntervals(const ActorPtr& player_actor); //!< Spreads `mp_net_send_budget` across local actors by speed and damage
+    void           UpdateNetRelevance();                          //!< Picks remote actors to be shown at reduced detail, by camera distance and visibility
+    void           UpdateStepTiers(const ActorPtr& player_actor); //!< Picks local actors which step at a reduced rate, see `Actor::ar_step_divisor`
+    void           UpdatePhysicsLod(const ActorPtr& player_actor, float dt); //!< Switches distant AI actors to and from a rigid-body proxy, see `Actor::ar_rigid_proxy`
+    std::shared_ptr<SavegameSnapshot> TakeSceneSnapshot(std::string const& filename); //!< Main thread, sim synced; null if the scene can't be saved (error reported).
+    static bool    WriteSceneSnapshot(SavegameSnapshot& snapshot); //!< Thread-safe; builds the JSON/binary chunks and writes the file.
 
     // Networking
     std::map<int, std::set<int>> m_stream_mismatches; //!< Networking: A set of streams without a corresponding actor in the actor-array for each stream source
     std::map<int, int>  m_stream_time_offsets;       //!< Networking: A network time offset for each stream source
     Ogre::Timer         m_net_timer;
 
+    // Spawning
+    std::map<std::pair<RigDef::Document*, std::string>, ActorSpawnTemplate>
+                        m_spawn_templates;                //!< Keyed by definition + section config; see `ActorSpawnTemplate`
+
     // Physics
     ActorPtrVec         m_actors;
+    std::vector<Actor*> m_sim_step_actors;                //!< Scratch list of actors processed by the current physics step stage; reused to avoid allocations
+    std::vector<Actor*> m_broadphase_sweep;               //!< Actors taking part in inter-actor collisions, sorted by bounding box min X; reused between steps
+    std::vector<std::vector<Actor*>> m_inter_actor_groups; //!< Actors linked by inter-actor beams, one list per independent group; reused between steps
     bool                m_forced_awake           = false; //!< disables sleep counters
     int                 m_physics_steps          = 0;
     float               m_dt_remainder           = 0.f;   //!< Keeps track of the rounding error in the time step calculation
+    float               m_step_cost_us           = 0.f;   //!< Running average of the real time one physics step takes; written by the sim thread
     float               m_simulation_speed       = 1.f;   //!< slow motion < 1.0 < fast motion
     float               m_last_simulation_speed  = 0.1f;  //!< previously used time ratio between real time (evt.timeSinceLastFrame) and physics time ('dt' used in calcPhysics)
     float               m_simulation_time        = 0.f;   //!< Amount of time the physics simulation is going to be advanced
     bool                m_simulation_paused      = false;
     float               m_total_sim_time         = 0.f;
+    int64_t             m_total_sim_steps        = 0;
 
     // Utils
     std::unique_ptr<ThreadPool> m_sim_thread_pool;
     std::shared_ptr<Task>       m_sim_task;
+    std::shared_ptr<Task>       m_save_task;    //!< Writing the file, see `SaveSceneAsync()`
     RoR::CmdKeyInertiaConfig    m_inertia_config;
 };
 
@@ -77,6 +77,14 @@ std::pair<RailGroup*, Ogre::Real> Actor::GetClosestRailOnActor(ActorPtr actor, c
     RailSegment* curRail = NULL;
     Ogre::Real lenToCurRail = std::numeric_limits<Ogre::Real>::infinity();
 
+    // rails are beams of the actor, so none can be in range if its bounding box isn't
+    const Ogre::Real attach_dist = node.GetAttachmentDistance();
+    if (actor->m_railgroups.empty() ||
+        (actor->ar_bounding_box.isFinite() && actor->ar_bounding_box.squaredDistance(node.GetSlideNodePosition()) >= attach_dist * attach_dist))
+    {
+        return closest;
+    }
+
     for (std::vector<RailGroup*>::iterator itGroup = actor->m_railgroups.begin();
          itGroup != actor->m_railgroups.end();
          itGroup++)
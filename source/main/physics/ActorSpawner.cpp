@@ -58,6 +58,7 @@
 #include "MeshObject.h"
 #include "PointColDetector.h"
 #include "Renderdash.h"
+#include "RodBatch.h"
 #include "ScrewProp.h"
 #include "Skidmark.h"
 #include "SkinFileFormat.h"
@@ -75,13 +76,38 @@
 #include <OgreMovableObject.h>
 #include <OgreParticleSystem.h>
 #include <OgreEntity.h>
+#include <algorithm>
 #include <climits>
 #include <fmt/format.h>
 
 const char* ACTOR_ID_TOKEN = "@Actor_"; // Appended to material name, followed by actor ID (aka 'trucknum')
+const char* SHARED_MATERIAL_TOKEN = "@Shared_"; // Appended to name of material used by many actors, followed by a counter
 
 using namespace RoR;
 
+std::map<std::string, ActorSpawner::SharedMaterial> ActorSpawner::s_shared_materials;
+
+static const size_t SIM_ARENA_ALIGNMENT = 64; // Cache line
+
+/// Reserves an aligned section of the simulation arena, see `ActorSpawner::InitializeRig()`
+static size_t ReserveArenaSection(size_t& inout_arena_size, size_t num_bytes)
+{
+    const size_t offset = (inout_arena_size + SIM_ARENA_ALIGNMENT - 1) & ~(SIM_ARENA_ALIGNMENT - 1);
+    inout_arena_size = offset + num_bytes;
+    return offset;
+}
+
+template <typename T>
+static T* ConstructArenaArray(char* arena, size_t offset, size_t count)
+{
+    T* elements = reinterpret_cast<T*>(arena + offset);
+    for (size_t i = 0; i < count; i++)
+    {
+        new (&elements[i]) T();
+    }
+    return elements;
+}
+
 /* -------------------------------------------------------------------------- */
 // Prepare for loading
 /* -------------------------------------------------------------------------- */
@@ -211,24 +237,40 @@ void ActorSpawner::InitializeRig()
         this->CalcMemoryRequirements(req, module.get());
     }
 
-    // Allocate memory as needed
-    m_actor->ar_beams = new beam_t[req.num_beams];
-    m_actor->ar_nodes = new node_t[req.num_nodes];
-    m_actor->ar_nodes_id = new int[req.num_nodes];
+    // Allocate memory as needed - all simulation arrays share one block, the ones used every physics step first,
+    // each one starting on a cache line. Released at once by `Actor::dispose()`.
+    size_t arena_size = 0;
+    const size_t nodes_offset     = ReserveArenaSection(arena_size, sizeof(node_t) * req.num_nodes);
+    const size_t beams_offset     = ReserveArenaSection(arena_size, sizeof(beam_t) * req.num_beams);
+    const size_t shocks_offset    = ReserveArenaSection(arena_size, sizeof(shock_t) * req.num_shocks);
+    const size_t rotators_offset  = ReserveArenaSection(arena_size, sizeof(rotator_t) * req.num_rotators);
+    const size_t wings_offset     = ReserveArenaSection(arena_size, sizeof(wing_t) * req.num_wings);
+    const size_t nodes_id_offset  = ReserveArenaSection(arena_size, sizeof(int) * req.num_nodes);
+    const size_t nodes_name_offset = ReserveArenaSection(arena_size, sizeof(std::string) * req.num_nodes);
+
+    m_actor->m_sim_arena.reset(new char[arena_size + SIM_ARENA_ALIGNMENT - 1]);
+    char* arena = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(m_actor->m_sim_arena.get()) + SIM_ARENA_ALIGNMENT - 1) & ~(uintptr_t)(SIM_ARENA_ALIGNMENT - 1));
+    m_actor->m_sim_arena_num_nodes = req.num_nodes;
+    m_actor->m_sim_arena_num_beams = req.num_beams;
+    m_actor->m_sim_arena_size = arena_size;
+
+    m_actor->ar_nodes = ConstructArenaArray<node_t>(arena, nodes_offset, req.num_nodes);
+    m_actor->ar_beams = ConstructArenaArray<beam_t>(arena, beams_offset, req.num_beams);
+    m_actor->ar_nodes_id = ConstructArenaArray<int>(arena, nodes_id_offset, req.num_nodes);
     for (size_t i = 0; i < req.num_nodes; ++i)
     {
         m_actor->ar_nodes_id[i] = -1;
     }
-    m_actor->ar_nodes_name = new std::string[req.num_nodes];
+    m_actor->ar_nodes_name = ConstructArenaArray<std::string>(arena, nodes_name_offset, req.num_nodes);
 
     if (req.num_shocks > 0)
-        m_actor->ar_shocks = new shock_t[req.num_shocks];
+        m_actor->ar_shocks = ConstructArenaArray<shock_t>(arena, shocks_offset, req.num_shocks);
 
     if (req.num_rotators > 0)
-        m_actor->ar_rotators = new rotator_t[req.num_rotators];
+        m_actor->ar_rotators = ConstructArenaArray<rotator_t>(arena, rotators_offset, req.num_rotators);
 
     if (req.num_wings > 0)
-        m_actor->ar_wings = new wing_t[req.num_wings];
+        m_actor->ar_wings = ConstructArenaArray<wing_t>(arena, wings_offset, req.num_wings);
 
     m_actor->ar_minimass.resize(req.num_nodes);
 
@@ -261,7 +303,7 @@ void ActorSpawner::InitializeRig()
     m_actor->ar_num_cinecams=0;
     m_actor->m_deletion_scene_nodes.clear();
 
-    m_actor->ar_state = ActorState::LOCAL_SLEEPING;
+    m_actor->ar_state = (m_net_lightweight) ? ActorState::NETWORKED_OK : ActorState::LOCAL_SLEEPING;
     m_actor->m_fusealge_airfoil = nullptr;
     m_actor->m_fusealge_front = nullptr;
     m_actor->m_fusealge_back = nullptr;
@@ -281,7 +323,10 @@ void ActorSpawner::InitializeRig()
     }
 
 #ifdef USE_ANGELSCRIPT
-    m_actor->ar_vehicle_ai = new VehicleAI(m_actor);
+    if (!m_net_lightweight)
+    {
+        m_actor->ar_vehicle_ai = new VehicleAI(m_actor);
+    }
 #endif // USE_ANGELSCRIPT
 
     m_actor->ar_airbrake_intensity = 0;
@@ -327,7 +372,7 @@ void ActorSpawner::InitializeRig()
         m_actor->m_inter_point_col_detector = new PointColDetector(m_actor);
     }
 
-    if (!App::sim_no_self_collisions->getBool())
+    if (!App::sim_no_self_collisions->getBool() && !m_net_lightweight)
     {
         m_actor->m_intra_point_col_detector = new PointColDetector(m_actor);
     }
@@ -391,6 +436,44 @@ void ActorSpawner::FinalizeRig()
         }
     }
 
+    // Sort beams by type so that the physics loop can process plain beams without per-beam dispatch
+    for (int i=0; i<m_actor->ar_num_beams; i++)
+    {
+        if (m_actor->ar_beams[i].bounded == NOSHOCK)
+            m_actor->m_plain_beams.push_back(i);
+        else
+            m_actor->m_bounded_beams.push_back(i);
+    }
+
+    // Walk plain beams in order of their nodes rather than in section order, so consecutive beams
+    // mostly touch nodes which are already in cache. The beams keep their indices - everything
+    // referring to beams or nodes (hydros, commands, flexbodies, savegames, network) is unaffected.
+    // Bounded beams keep their order, triggers/blockers depend on it.
+    if (m_plain_beam_order && m_plain_beam_order->size() == m_actor->m_plain_beams.size())
+    {
+        m_actor->m_plain_beams = *m_plain_beam_order;
+    }
+    else
+    {
+        std::stable_sort(m_actor->m_plain_beams.begin(), m_actor->m_plain_beams.end(), [this](int a, int b)
+            {
+                const beam_t& beam_a = m_actor->ar_beams[a];
+                const beam_t& beam_b = m_actor->ar_beams[b];
+                const NodeNum_t lo_a = std::min(beam_a.p1->pos, beam_a.p2->pos);
+                const NodeNum_t lo_b = std::min(beam_b.p1->pos, beam_b.p2->pos);
+                if (lo_a != lo_b)
+                    return lo_a < lo_b;
+                return std::max(beam_a.p1->pos, beam_a.p2->pos) < std::max(beam_b.p1->pos, beam_b.p2->pos);
+            });
+    }
+
+    // Most actors use a handful of the MAX_COMMANDS keys; `CalcCommands()` only walks these
+    for (int i = 1; i <= MAX_COMMANDS; i++) // BEWARE: commandkeys are indexed 1-MAX_COMMANDS!
+    {
+        if (!m_actor->ar_command_key[i].beams.empty() || !m_actor->ar_command_key[i].rotators.empty())
+            m_actor->m_used_command_keys.push_back(i);
+    }
+
     //calculate gwps height offset
     //get a starting value
     m_actor->ar_posnode_spawn_height=m_actor->ar_nodes[0].RelPosition.y;
@@ -491,6 +574,8 @@ void ActorSpawner::FinalizeRig()
         m_actor->m_axle_diffs[m_actor->m_num_axle_diffs] = diff;
     }
 
+    m_actor->BuildDrivetrainLinks();
+
     if (m_actor->ar_main_camera_node_dir == 0 || m_actor->ar_main_camera_node_dir == NODENUM_INVALID)
     {
         Ogre::Vector3 ref = m_actor->ar_nodes[m_actor->ar_main_camera_node_pos].RelPosition;
@@ -564,6 +649,7 @@ void ActorSpawner::FinalizeRig()
     m_flex_factory.SaveFlexbodiesToCache();
 
     m_actor->GetGfxActor()->SortFlexbodies();
+    m_actor->GetGfxActor()->RegisterPropCommandKeys();
 }
 
 /* -------------------------------------------------------------------------- */
@@ -1233,12 +1319,11 @@ void ActorSpawner::ProcessExhaust(RigDef::Exhaust & def)
         template_name = "tracks/Smoke"; // defined in `particles/smoke.particle`
     }
 
-    std::string name = this->ComposeName(template_name.c_str(), static_cast<int>(m_actor->exhausts.size()));
-    exhaust.smoker = this->CreateParticleSystem(name, template_name);
+    exhaust.smoker = this->CreateParticleSystem(template_name);
     if (exhaust.smoker == nullptr)
     {
         std::stringstream msg;
-        msg << "Failed to create particle system '" << name << "' (template: '" << template_name <<"')";
+        msg << "Failed to create exhaust particle system (template: '" << template_name <<"')";
         AddMessage(Message::TYPE_ERROR, msg.str());
         return;
     }
@@ -1484,7 +1569,7 @@ void ActorSpawner::ProcessFlexbody(RigDef::Flexbody& def)
     rot=rot*Ogre::Quaternion(Ogre::Degree(def.rotation.y), Ogre::Vector3::UNIT_Y);
     rot=rot*Ogre::Quaternion(Ogre::Degree(def.rotation.x), Ogre::Vector3::UNIT_X);
 
-    m_actor->GetGfxActor()->UpdateSimDataBuffer(); // fill all current nodes - needed to setup flexing meshes
+    // Node snapshot for the flexing meshes is taken once for the whole section, see `ProcessNewActor()`
 
     try
     {
@@ -1983,6 +2068,7 @@ void ActorSpawner::ProcessProp(RigDef::Prop & def)
         }
 
         prop.pp_animations.push_back(anim);
+        BITMASK_SET_1(m_actor->m_gfx_actor->m_prop_anim_flags_used, anim.animFlags);
     }
 
     m_actor->m_gfx_actor->m_props.push_back(prop);
@@ -2240,6 +2326,92 @@ Ogre::MaterialPtr ActorSpawner::InstantiateManagedMaterial(Ogre::String const &
     return src_mat->clone(clone_name, true, m_custom_resource_group);
 }
 
+bool ActorSpawner::IsMaterialShareable(std::string const & material_name)
+{
+    if (material_name == "mirror" || material_name == m_cab_material_name ||
+        this->FindFlareBindingForMaterial(material_name) != nullptr ||
+        this->FindVideoCameraByMaterial(material_name) != nullptr)
+    {
+        return false;
+    }
+
+    // Managed materials are processed before 'globals', look up the cab material directly
+    for (auto& module: m_selected_modules)
+    {
+        for (auto& def: module->globals)
+        {
+            if (def.material_name == material_name)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string ActorSpawner::ComposeSharedMaterialKey(std::string const & material_desc)
+{
+    std::stringstream key;
+    key << m_custom_resource_group << "|";
+    if (m_actor->m_used_skin_entry != nullptr)
+    {
+        key << m_actor->m_used_skin_entry->resource_group << ":" << m_actor->m_used_skin_entry->fname;
+    }
+    key << "|" << App::gfx_alt_actor_materials->getBool() << "|" << material_desc;
+    return key.str();
+}
+
+std::string ActorSpawner::ComposeSharedMaterialName(std::string const & orig_name)
+{
+    static unsigned int shared_mat_counter = 0;
+    return orig_name + SHARED_MATERIAL_TOKEN + TOSTRING(shared_mat_counter++);
+}
+
+Ogre::MaterialPtr ActorSpawner::AcquireSharedMaterial(std::string const & key)
+{
+    auto itor = s_shared_materials.find(key);
+    if (itor == s_shared_materials.end())
+    {
+        return Ogre::MaterialPtr();
+    }
+
+    // Gone with its resource group (bundle reloaded)
+    if (Ogre::MaterialManager::getSingleton().getByName(itor->second.material->getName(), itor->second.material->getGroup()).isNull())
+    {
+        s_shared_materials.erase(itor);
+        return Ogre::MaterialPtr();
+    }
+
+    itor->second.num_users++;
+    m_actor->m_shared_material_keys.push_back(key);
+    return itor->second.material;
+}
+
+void ActorSpawner::RegisterSharedMaterial(std::string const & key, Ogre::MaterialPtr const & mat)
+{
+    SharedMaterial& entry = s_shared_materials[key];
+    entry.material = mat;
+    entry.num_users = 1;
+    m_actor->m_shared_material_keys.push_back(key);
+}
+
+void ActorSpawner::ReleaseSharedMaterials(std::vector<std::string> const& keys)
+{
+    for (std::string const& key: keys)
+    {
+        auto itor = s_shared_materials.find(key);
+        if (itor == s_shared_materials.end())
+        {
+            continue;
+        }
+        if (--itor->second.num_users <= 0)
+        {
+            Ogre::MaterialManager::getSingleton().remove(itor->second.material);
+            s_shared_materials.erase(itor);
+        }
+    }
+}
+
 void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
 {
     if (m_managed_materials.find(def.name) != m_managed_materials.end())
@@ -2278,7 +2450,25 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
         m_placeholder_managedmat->clone(def.name, /*changeGroup=*/true, m_custom_resource_group);
     }
 
-    std::string custom_name = def.name + ACTOR_ID_TOKEN + TOSTRING(m_actor->ar_instance_id);
+    // Reuse the material generated for an earlier spawn with equal definition, skin and options
+    const bool shared = this->IsMaterialShareable(def.name);
+    std::stringstream shared_desc;
+    shared_desc << "managed:" << def.name << ":" << static_cast<int>(def.type) << ":" << def.diffuse_map << ":"
+        << def.damaged_diffuse_map << ":" << def.specular_map << ":" << def.options.double_sided;
+    const std::string shared_key = this->ComposeSharedMaterialKey(shared_desc.str());
+    if (shared)
+    {
+        Ogre::MaterialPtr shared_mat = this->AcquireSharedMaterial(shared_key);
+        if (!shared_mat.isNull())
+        {
+            m_managed_materials.insert(std::make_pair(def.name, shared_mat));
+            return;
+        }
+    }
+
+    std::string custom_name = (shared)
+        ? this->ComposeSharedMaterialName(def.name)
+        : def.name + ACTOR_ID_TOKEN + TOSTRING(m_actor->ar_instance_id);
     Ogre::MaterialPtr material;
     if (def.type == RigDef::ManagedMaterialType::FLEXMESH_STANDARD || def.type == RigDef::ManagedMaterialType::FLEXMESH_TRANSPARENT)
     {
@@ -2446,6 +2636,10 @@ void ActorSpawner::ProcessManagedMaterial(RigDef::ManagedMaterial & def)
     /* Finalize */
 
     material->compile();
+    if (shared)
+    {
+        this->RegisterSharedMaterial(shared_key, material);
+    }
     m_managed_materials.insert(std::make_pair(def.name, material));
 }
 
@@ -2715,12 +2909,11 @@ void ActorSpawner::ProcessParticle(RigDef::Particle & def)
     particle.emitterNode = GetNodeIndexOrThrow(def.emitter_node);
     particle.directionNode = GetNodeIndexOrThrow(def.reference_node);
 
-    std::string name = this->ComposeName(def.particle_system_name.c_str(), particle_index);
-    particle.psys = this->CreateParticleSystem(name, def.particle_system_name);
+    particle.psys = this->CreateParticleSystem(def.particle_system_name);
     if (particle.psys == nullptr)
     {
         std::stringstream msg;
-        msg << "Failed to create particle system '" << name << "' (template: '" << def.particle_system_name <<"')";
+        msg << "Failed to create particle system (template: '" << def.particle_system_name <<"')";
         AddMessage(Message::TYPE_ERROR, msg.str());
         return;
     }
@@ -3478,6 +3671,16 @@ void ActorSpawner::ProcessCommand(RigDef::Command2 & def)
     /* Options */
     if (def.option_r_rope)          { beam.bounded = ROPE; }
 
+    if (! def.option_i_invisible)
+    {
+        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
+    }
+
+    if (m_net_lightweight)
+    {
+        return; // Remote actor: the beam only follows network nodes, keys are never operated
+    }
+
     /* set the middle of the command, so its not required to recalculate this everytime ... */
     float center_length = 0.f;
     if (def.max_extension > def.max_contraction)
@@ -3506,6 +3709,8 @@ void ActorSpawner::ProcessCommand(RigDef::Command2 & def)
     cmd_beam.cmb_center_length = center_length;
     cmd_beam.cmb_state = std::shared_ptr<commandbeam_state_t>(new commandbeam_state_t);
     contract_command->beams.push_back(cmd_beam);
+    contract_command->cmd_plays_sound |= cmd_beam.cmb_plays_sound;
+    contract_command->cmd_is_force_restricted |= cmd_beam.cmb_is_force_restricted;
     if (contract_command->description.empty())
     {
         contract_command->description = def.description;
@@ -3516,6 +3721,8 @@ void ActorSpawner::ProcessCommand(RigDef::Command2 & def)
     cmd_beam.cmb_speed = def.lengthen_rate;
     cmd_beam.cmb_boundary_length = def.max_extension;
     extend_command->beams.push_back(cmd_beam);
+    extend_command->cmd_plays_sound |= cmd_beam.cmb_plays_sound;
+    extend_command->cmd_is_force_restricted |= cmd_beam.cmb_is_force_restricted;
     if (extend_command->description.empty())
     {
         extend_command->description = def.description;
@@ -3525,11 +3732,6 @@ void ActorSpawner::ProcessCommand(RigDef::Command2 & def)
                              contract_command->command_inertia,
                              extend_command->command_inertia);
 
-    if (! def.option_i_invisible)
-    {
-        this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
-    }
-
     m_actor->m_num_command_beams++;
     m_actor->m_has_command_beams = true;
 }
@@ -3792,6 +3994,11 @@ void ActorSpawner::ProcessHydro(RigDef::Hydro & def)
         this->CreateBeamVisuals(beam, beam_index, true, def.beam_defaults);
     }
 
+    if (m_net_lightweight)
+    {
+        return; // Remote actor: not steered locally
+    }
+
     hydrobeam_t hb;
     hb.hb_flags = hydro_flags;
     hb.hb_speed = def.lenghtening_factor;
@@ -5555,10 +5762,21 @@ void ActorSpawner::CreateBeamVisuals(beam_t const & beam, int beam_index, bool v
 
     try
     {
-        Ogre::Entity* entity = App::GetGfxScene()->GetSceneManager()->createEntity(this->ComposeName("beam", beam_index), "beam.mesh");
-        entity->setMaterialName(material_name);
+        // One batch per material
+        std::vector<RodBatch*>& batches = m_actor->m_gfx_actor->m_rod_batches;
+        size_t batch_index = 0;
+        while (batch_index < batches.size() && batches[batch_index]->GetMaterialName() != material_name)
+        {
+            batch_index++;
+        }
+        if (batch_index == batches.size())
+        {
+            batches.push_back(new RodBatch(this->ComposeName("RodBatch", (int)batch_index), material_name,
+                m_actor->m_gfx_actor->m_gfx_beams_parent_scenenode));
+        }
 
         BeamGfx beamx;
+        beamx.rod_batch = static_cast<uint16_t>(batch_index);
         beamx.rod_diameter_mm = uint16_t(beam_defaults->visual_beam_diameter * 1000.f);
         beamx.rod_beam_index = static_cast<uint16_t>(beam_index);
         beamx.rod_node1 = beam.p1->pos;
@@ -5566,12 +5784,8 @@ void ActorSpawner::CreateBeamVisuals(beam_t const & beam, int beam_index, bool v
         beamx.rod_target_actor = m_actor;
         beamx.rod_is_visible = false;
 
-        beamx.rod_scenenode = m_actor->m_gfx_actor->m_gfx_beams_parent_scenenode->createChildSceneNode();
-        beamx.rod_scenenode->attachObject(entity);
-        beamx.rod_scenenode->setVisible(visible, /*cascade:*/ false);
-        beamx.rod_scenenode->setScale(beam_defaults->visual_beam_diameter, -1, beam_defaults->visual_beam_diameter);
-
         m_actor->m_gfx_actor->m_gfx_beams.push_back(beamx);
+        m_actor->m_gfx_actor->m_rod_batches_dirty = true;
     }
     catch (Ogre::Exception& e)
     {
@@ -6415,6 +6629,19 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
             lookup_entry.material_flare_def = mat_flare_def;
         }
 
+        // Reuse the substitute generated for an earlier spawn with equal skin and options
+        const bool shared = this->IsMaterialShareable(mat_lookup_name);
+        const std::string shared_key = this->ComposeSharedMaterialKey("substitute:" + mat_lookup_name);
+        if (shared)
+        {
+            lookup_entry.material = this->AcquireSharedMaterial(shared_key);
+            if (!lookup_entry.material.isNull())
+            {
+                m_material_substitutions.insert(std::make_pair(mat_lookup_name, lookup_entry));
+                return lookup_entry.material;
+            }
+        }
+
         // Query .skin material replacements
         if (m_actor->m_used_skin_entry != nullptr)
         {
@@ -6428,8 +6655,19 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
                 if (!skin_mat.isNull())
                 {
                     std::stringstream name_buf;
-                    name_buf << skin_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
+                    if (shared)
+                    {
+                        name_buf << this->ComposeSharedMaterialName(skin_mat->getName());
+                    }
+                    else
+                    {
+                        name_buf << skin_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
+                    }
                     lookup_entry.material = skin_mat->clone(name_buf.str(), /*changeGroup=*/true, m_custom_resource_group);
+                    if (shared)
+                    {
+                        this->RegisterSharedMaterial(shared_key, lookup_entry.material);
+                    }
                     m_material_substitutions.insert(std::make_pair(mat_lookup_name, lookup_entry));
                     return lookup_entry.material;
                 }
@@ -6446,11 +6684,13 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
         }
 
         // Acquire substitute - either use managedmaterial or generate new by cloning.
+        bool register_shared = shared;
         auto mmat_res = m_managed_materials.find(mat_lookup_name);
         if (mmat_res != m_managed_materials.end())
         {
-            // Use managedmaterial as substitute
+            // Use managedmaterial as substitute; when shared, it already holds its own reference
             lookup_entry.material = mmat_res->second;
+            register_shared = false;
         }
         else
         {
@@ -6465,7 +6705,14 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
             }
 
             std::stringstream name_buf;
-            name_buf << orig_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
+            if (shared)
+            {
+                name_buf << this->ComposeSharedMaterialName(orig_mat->getName());
+            }
+            else
+            {
+                name_buf << orig_mat->getName() << ACTOR_ID_TOKEN << m_actor->ar_instance_id;
+            }
             lookup_entry.material = orig_mat->clone(name_buf.str(), true, m_custom_resource_group);
         }
 
@@ -6479,6 +6726,7 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
                     // Built-ins
                     if (tex_unit->getTextureName() == "dashtexture")
                     {
+                        register_shared = false; // Each actor has its own dashboard texture
                         if (!m_oldstyle_renderdash)
                         {
                             // This is technically a bug, but does it matter at all? Let's watch ~ only_a_ptr, 05/2019
@@ -6529,6 +6777,10 @@ Ogre::MaterialPtr ActorSpawner::FindOrCreateCustomizedMaterial(std::string mat_l
             } // passes
         } // techniques
 
+        if (register_shared)
+        {
+            this->RegisterSharedMaterial(shared_key, lookup_entry.material);
+        }
         m_material_substitutions.insert(std::make_pair(mat_lookup_name, lookup_entry)); // Register the substitute
         return lookup_entry.material;
     }
@@ -6558,6 +6810,7 @@ Ogre::MaterialPtr ActorSpawner::CreateSimpleMaterial(Ogre::ColourValue color)
 void ActorSpawner::SetupNewEntity(Ogre::Entity* ent, Ogre::ColourValue simple_color)
 {
     // RULE: Each actor must have it's own material instances (a lookup table is kept for OrigName->CustomName)
+    //       Exception: materials the actor never modifies are shared between actors with equal bundle, skin and options.
     //
     // Setup routine:
     //
@@ -6567,6 +6820,7 @@ void ActorSpawner::SetupNewEntity(Ogre::Entity* ent, Ogre::ColourValue simple_co
     //          material is generated, added to lookup table under generated name (special case) and processing ends.
     //   3. If the material is a 'videocamera' of any subtype, material is created, added to lookup table and processing ends.
     //   4  'materialflarebindngs' are resolved -> binding is persisted in lookup table.
+    //      If the material isn't bound to a flare/cab and a shared substitute exists, it's used and processing ends.
     //   5  SkinZIP _material replacements_ are queried. If match is found, it's added to lookup table and processing ends.
     //   6. ManagedMaterials are queried. If match is found, it's added to lookup table and processing ends.
     //   7. Orig. material is cloned to create substitute.
@@ -6639,10 +6893,9 @@ void ActorSpawner::FinalizeGfxSetup()
         }
     }
 
-    if (!App::gfx_enable_videocams->getBool())
-    {
-        m_actor->m_gfx_actor->SetVideoCamState(VideoCamState::VCSTATE_DISABLED);
-    }
+    // Cameras go online when the player enters the actor, see `GameContext::ChangePlayerActor()`
+    m_actor->m_gfx_actor->SetVideoCamState(App::gfx_enable_videocams->getBool()
+        ? VideoCamState::VCSTATE_ENABLED_OFFLINE : VideoCamState::VCSTATE_DISABLED);
 
     // Load dashboard layouts
     for (auto& module: m_selected_modules)
@@ -6911,17 +7164,10 @@ void ActorSpawner::CreateVideoCamera(RigDef::VideoCamera* def)
 
         if (!App::gfx_window_videocams->getBool())
         {
-            vcam.vcam_render_tex = Ogre::TextureManager::getSingleton().createManual(
-                vcam.vcam_material->getName() + "_texture",
-                Ogre::ResourceGroupManager::DEFAULT_RESOURCE_GROUP_NAME,
-                Ogre::TEX_TYPE_2D,
-                def->texture_width,
-                def->texture_height,
-                0, // no mip maps
-                Ogre::PF_R8G8B8,
-                Ogre::TU_RENDERTARGET);
-            vcam.vcam_render_target = vcam.vcam_render_tex->getBuffer()->getRenderTarget();
-            vcam.vcam_render_target->setAutoUpdated(false);
+            // The texture is taken from a pool shared by all actors when the camera goes online, see `GfxActor::SetVideoCamState()`
+            vcam.vcam_tex_width = def->texture_width;
+            vcam.vcam_tex_height = def->texture_height;
+            vcam.vcam_visibility_mask = ~DEPTHMAP_DISABLED;
         }
         else
         {
@@ -6941,20 +7187,11 @@ void ActorSpawner::CreateVideoCamera(RigDef::VideoCamera* def)
         vcam.vcam_material->getTechnique(0)->getPass(0)->setLightingEnabled(false);
         vcam.vcam_off_tex_name = "Chrome.dds"; // Built-in gray texture
 
-        if (vcam.vcam_render_target)
+        // this is a mirror, flip the image left<>right to have a mirror and not a cameraimage
+        if (vcam.vcam_tex_width != 0 && def->camera_role == 1)
         {
-            Ogre::Viewport* vp = vcam.vcam_render_target->addViewport(vcam.vcam_ogre_camera);
-            vp->setClearEveryFrame(true);
-            vp->setBackgroundColour(App::GetCameraManager()->GetCamera()->getViewport()->getBackgroundColour());
-            vp->setVisibilityMask(~HIDE_MIRROR);
-            vp->setVisibilityMask(~DEPTHMAP_DISABLED);
-            vp->setOverlaysEnabled(false);
-
-            vcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureName(vcam.vcam_render_tex->getName());
-
-            // this is a mirror, flip the image left<>right to have a mirror and not a cameraimage
-            if (def->camera_role == 1)
-                vcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureUScale(-1);
+            vcam.vcam_tex_uscale = -1.f;
+            vcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureUScale(-1);
         }
 
         if (vcam.vcam_render_window)
@@ -7012,16 +7249,9 @@ void ActorSpawner::CreateMirrorPropVideoCam(
             return;
         }
 
-        // Create rendering texture
-        const std::string mirror_tex_name = this->ComposeName("MirrorPropTexture-", static_cast<int>(mprop_counter));
-        vcam.vcam_render_tex = Ogre::TextureManager::getSingleton().createManual(mirror_tex_name
-            , m_custom_resource_group
-            , Ogre::TEX_TYPE_2D
-            , 128
-            , 256
-            , 0
-            , Ogre::PF_R8G8B8
-            , Ogre::TU_RENDERTARGET);
+        // Rendering texture is taken from a pool when the camera goes online
+        vcam.vcam_tex_width = 128;
+        vcam.vcam_tex_height = 256;
 
         // Create OGRE camera
         vcam.vcam_ogre_camera = App::GetGfxScene()->GetSceneManager()->createCamera(this->ComposeName("MirrorPropCamera-", static_cast<int>(mprop_counter)));
@@ -7031,17 +7261,8 @@ void ActorSpawner::CreateMirrorPropVideoCam(
         vcam.vcam_ogre_camera->setAspectRatio(
             (App::GetCameraManager()->GetCamera()->getViewport()->getActualWidth() / App::GetCameraManager()->GetCamera()->getViewport()->getActualHeight()) / 2.0f);
 
-        // Setup rendering
-        vcam.vcam_render_target = vcam.vcam_render_tex->getBuffer()->getRenderTarget();
-        vcam.vcam_render_target->setActive(true);
-        Ogre::Viewport* v = vcam.vcam_render_target->addViewport(vcam.vcam_ogre_camera);
-        v->setClearEveryFrame(true);
-        v->setBackgroundColour(App::GetCameraManager()->GetCamera()->getViewport()->getBackgroundColour());
-        v->setOverlaysEnabled(false);
-
         // Setup material
         vcam.vcam_material = custom_mat;
-        vcam.vcam_material->getTechnique(0)->getPass(0)->getTextureUnitState(0)->setTextureName(vcam.vcam_render_tex->getName());
         vcam.vcam_material->getTechnique(0)->getPass(0)->setLightingEnabled(false);
 
         // Submit the videocamera
@@ -7081,20 +7302,10 @@ void ActorSpawner::HandleException()
     }
 }
 
-Ogre::ParticleSystem* ActorSpawner::CreateParticleSystem(std::string const & name, std::string const & template_name)
+Ogre::ParticleSystem* ActorSpawner::CreateParticleSystem(std::string const & template_name)
 {
-    // None of `Ogre::SceneManager::createParticleSystem()` overloads
-    // lets us specify both resource group and template name.
-
-    Ogre::NameValuePairList params;
-    params["resourceGroup"] = m_custom_resource_group;
-    params["templateName"] = template_name;
-
-    Ogre::MovableObject* obj = App::GetGfxScene()->GetSceneManager()->createMovableObject(
-       name, Ogre::ParticleSystemFactory::FACTORY_TYPE_NAME, &params);
-    Ogre::ParticleSystem* psys = static_cast<Ogre::ParticleSystem*>(obj);
-    psys->setVisibilityFlags(DEPTHMAP_DISABLED); // disable particles in depthmap
-    return psys;
+    // Pooled across actors, returned by `Actor::dispose()`
+    return App::GetGfxScene()->AcquireParticleSystem(template_name, m_custom_resource_group);
 }
 
 void ActorSpawner::CreateCabVisual()
@@ -97,7 +97,9 @@ public:
     /// @{
     void                           ConfigureSections(Ogre::String const & sectionconfig, RigDef::DocumentPtr def);
     void                           ProcessNewActor(ActorPtr actor, ActorSpawnRequest rq, RigDef::DocumentPtr def);
+    void                           UsePlainBeamOrder(std::vector<int> const* order) { m_plain_beam_order = order; } //!< Order from an earlier spawn of the same configuration; skips the sort
     static void                    SetupDefaultSoundSources(ActorPtr const& actor);
+    static void                    ReleaseSharedMaterials(std::vector<std::string> const& keys); //!< Called by `Actor::dispose()`, see `AcquireSharedMaterial()`
     /// @}
 
     /// @name Utility
@@ -376,13 +378,18 @@ private:
     void                          FinalizeGfxSetup();
     Ogre::MaterialPtr             FindOrCreateCustomizedMaterial(std::string orig_name);
     Ogre::MaterialPtr             CreateSimpleMaterial(Ogre::ColourValue color);
-    Ogre::ParticleSystem*         CreateParticleSystem(std::string const & name, std::string const & template_name);
+    Ogre::ParticleSystem*         CreateParticleSystem(std::string const & template_name); //!< From the pool, see `GfxScene::AcquireParticleSystem()`
     RigDef::MaterialFlareBinding* FindFlareBindingForMaterial(std::string const & material_name); //!< Returns NULL if none found
     RigDef::VideoCamera*          FindVideoCameraByMaterial(std::string const & material_name); //!< Returns NULL if none found
     void                          CreateVideoCamera(RigDef::VideoCamera* def);
     void                          CreateMirrorPropVideoCam(Ogre::MaterialPtr custom_mat, CustomMaterial::MirrorPropType type, Ogre::SceneNode* prop_scenenode);
     void                          SetupNewEntity(Ogre::Entity* e, Ogre::ColourValue simple_color); //!< Full texture and material setup
     Ogre::MaterialPtr             InstantiateManagedMaterial(Ogre::String const & source_name, Ogre::String const & clone_name);
+    bool                          IsMaterialShareable(std::string const & material_name); //!< False if the actor modifies the material at runtime (flares, cab, cameras)
+    std::string                   ComposeSharedMaterialKey(std::string const & material_desc); //!< Adds bundle, skin and graphics options
+    std::string                   ComposeSharedMaterialName(std::string const & orig_name);
+    Ogre::MaterialPtr             AcquireSharedMaterial(std::string const & key); //!< Returns NULL if not cached yet; otherwise the actor holds a reference
+    void                          RegisterSharedMaterial(std::string const & key, Ogre::MaterialPtr const & mat); //!< The actor holds the first reference
     void                          CreateCabVisual();
     void                          CreateMaterialFlare(int flare_index, Ogre::MaterialPtr mat);
 
@@ -445,6 +452,8 @@ private:
     bool                     m_apply_simple_materials;
     std::string              m_custom_resource_group;
     bool                     m_generate_wing_position_lights;
+    std::vector<int> const*  m_plain_beam_order = nullptr; //!< See `ActorSpawnTemplate`
+    bool                     m_net_lightweight = false; //!< Remote actor: only what rendering, sound and pseudo-collisions need; nodes come from network
     ActorMemoryRequirements  m_memory_requirements;
     /// @}
 
@@ -480,6 +489,15 @@ private:
     CustomMaterial::MirrorPropType            m_curr_mirror_prop_type;
     Ogre::SceneNode*                          m_curr_mirror_prop_scenenode;
     /// @}
+
+    /// Skin and managed materials which no actor modifies are generated once per bundle, skin and
+    /// graphics options and shared by all actors spawned with them, instead of cloned per actor.
+    struct SharedMaterial
+    {
+        Ogre::MaterialPtr material;
+        int               num_users = 0;
+    };
+    static std::map<std::string, SharedMaterial> s_shared_materials;
 };
 
 /// @} // addtogroup Physics
@@ -61,6 +61,7 @@ void ActorSpawner::ProcessNewActor(ActorPtr actor, ActorSpawnRequest rq, RigDef:
 
     m_particles_parent_scenenode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
     m_spawn_position = rq.asr_position;
+    m_net_lightweight = (rq.asr_origin == ActorSpawnRequest::Origin::NETWORK);
     m_current_keyword = RigDef::Keyword::INVALID;
     m_wing_area = 0.f;
     m_fuse_z_min = 1000.0f;
@@ -100,6 +101,7 @@ void ActorSpawner::ProcessNewActor(ActorPtr actor, ActorSpawnRequest rq, RigDef:
     m_actor->ar_import_commands          = m_file->import_commands;
     m_actor->ar_rescuer_flag             = m_file->rescuer;
     m_actor->m_disable_default_sounds    = m_file->disable_default_sounds;
+    m_actor->m_implicit_solver           = m_file->implicit_solver;
     m_actor->ar_hide_in_actor_list       = m_file->hide_in_chooser;
 
     PROCESS_ELEMENT(RigDef::Keyword::MINIMASS, minimass, ProcessMinimass);
@@ -168,31 +170,51 @@ void ActorSpawner::ProcessNewActor(ActorPtr actor, ActorSpawnRequest rq, RigDef:
 
     // ---------------------------- Other ----------------------------
 
-    PROCESS_ELEMENT(RigDef::Keyword::ANTILOCKBRAKES, antilockbrakes, ProcessAntiLockBrakes);
+    // Sections marked 'local only' are simulation-only; remote actors just follow network data.
+    // They are skipped in place - moving them would change beam indices (savegames refer to them).
+    if (!m_net_lightweight) // local only
+    {
+        PROCESS_ELEMENT(RigDef::Keyword::ANTILOCKBRAKES, antilockbrakes, ProcessAntiLockBrakes);
+    }
     PROCESS_ELEMENT(RigDef::Keyword::FLARES2, flares2, ProcessFlare2);
     PROCESS_ELEMENT(RigDef::Keyword::FLARES3, flares3, ProcessFlare3);
-    PROCESS_ELEMENT(RigDef::Keyword::AXLES, axles, ProcessAxle);
-    PROCESS_ELEMENT(RigDef::Keyword::TRANSFERCASE, transfercase, ProcessTransferCase);
-    PROCESS_ELEMENT(RigDef::Keyword::INTERAXLES, interaxles, ProcessInterAxle);
+    if (!m_net_lightweight) // local only
+    {
+        PROCESS_ELEMENT(RigDef::Keyword::AXLES, axles, ProcessAxle);
+        PROCESS_ELEMENT(RigDef::Keyword::TRANSFERCASE, transfercase, ProcessTransferCase);
+        PROCESS_ELEMENT(RigDef::Keyword::INTERAXLES, interaxles, ProcessInterAxle);
+    }
     PROCESS_ELEMENT(RigDef::Keyword::SUBMESH, submeshes, ProcessSubmesh);
     PROCESS_ELEMENT(RigDef::Keyword::CONTACTERS, contacters, ProcessContacter);
     PROCESS_ELEMENT(RigDef::Keyword::CAMERAS, cameras, ProcessCamera);
     PROCESS_ELEMENT(RigDef::Keyword::HOOKS, hooks, ProcessHook);	
-    PROCESS_ELEMENT(RigDef::Keyword::TIES, ties, ProcessTie);
-    PROCESS_ELEMENT(RigDef::Keyword::ROPABLES, ropables, ProcessRopable);
+    if (!m_net_lightweight) // local only
+    {
+        PROCESS_ELEMENT(RigDef::Keyword::TIES, ties, ProcessTie);
+        PROCESS_ELEMENT(RigDef::Keyword::ROPABLES, ropables, ProcessRopable);
+    }
     PROCESS_ELEMENT(RigDef::Keyword::ANIMATORS, animators, ProcessAnimator);
     PROCESS_ELEMENT(RigDef::Keyword::FUSEDRAG, fusedrag, ProcessFusedrag);
     PROCESS_ELEMENT(RigDef::Keyword::TURBOJETS, turbojets, ProcessTurbojet);
     PROCESS_ELEMENT(RigDef::Keyword::PROPS, props, ProcessProp);
-    PROCESS_ELEMENT(RigDef::Keyword::TRACTIONCONTROL, tractioncontrol, ProcessTractionControl);
+    if (!m_net_lightweight) // local only
+    {
+        PROCESS_ELEMENT(RigDef::Keyword::TRACTIONCONTROL, tractioncontrol, ProcessTractionControl);
+    }
     PROCESS_ELEMENT(RigDef::Keyword::ROTATORS, rotators, ProcessRotator);
     PROCESS_ELEMENT(RigDef::Keyword::ROTATORS2, rotators2, ProcessRotator2);
-    PROCESS_ELEMENT(RigDef::Keyword::LOCKGROUPS, lockgroups, ProcessLockgroup);
-    PROCESS_ELEMENT(RigDef::Keyword::RAILGROUPS, railgroups, ProcessRailGroup);
-    PROCESS_ELEMENT(RigDef::Keyword::SLIDENODES, slidenodes, ProcessSlidenode);
+    if (!m_net_lightweight) // local only
+    {
+        PROCESS_ELEMENT(RigDef::Keyword::LOCKGROUPS, lockgroups, ProcessLockgroup);
+        PROCESS_ELEMENT(RigDef::Keyword::RAILGROUPS, railgroups, ProcessRailGroup);
+        PROCESS_ELEMENT(RigDef::Keyword::SLIDENODES, slidenodes, ProcessSlidenode);
+    }
     PROCESS_ELEMENT(RigDef::Keyword::PARTICLES, particles, ProcessParticle);
-    PROCESS_ELEMENT(RigDef::Keyword::CRUISECONTROL, cruisecontrol, ProcessCruiseControl);
-    PROCESS_ELEMENT(RigDef::Keyword::SPEEDLIMITER, speedlimiter, ProcessSpeedLimiter);
+    if (!m_net_lightweight) // local only
+    {
+        PROCESS_ELEMENT(RigDef::Keyword::CRUISECONTROL, cruisecontrol, ProcessCruiseControl);
+        PROCESS_ELEMENT(RigDef::Keyword::SPEEDLIMITER, speedlimiter, ProcessSpeedLimiter);
+    }
     PROCESS_ELEMENT(RigDef::Keyword::COLLISIONBOXES, collisionboxes, ProcessCollisionBox);
     PROCESS_ELEMENT(RigDef::Keyword::EXHAUSTS, exhausts, ProcessExhaust);
     PROCESS_ELEMENT(RigDef::Keyword::EXTCAMERA, extcamera, ProcessExtCamera);
@@ -201,6 +223,7 @@ void ActorSpawner::ProcessNewActor(ActorPtr actor, ActorSpawnRequest rq, RigDef:
     PROCESS_ELEMENT(RigDef::Keyword::TURBOPROPS2, turboprops2, ProcessTurboprop2); // 'turboprops' are auto-imported as 'turboprops2'.
     PROCESS_ELEMENT(RigDef::Keyword::SCREWPROPS, screwprops, ProcessScrewprop);
     PROCESS_ELEMENT(RigDef::Keyword::FIXES, fixes, ProcessFixedNode);
+    m_actor->GetGfxActor()->UpdateSimDataBuffer(); // fill all current nodes - needed to setup flexing meshes
     PROCESS_ELEMENT(RigDef::Keyword::FLEXBODIES, flexbodies, ProcessFlexbody); // (needs GfxActor to exist)
     PROCESS_ELEMENT(RigDef::Keyword::WINGS, wings, ProcessWing); // (needs GfxActor to exist)
     PROCESS_ELEMENT(RigDef::Keyword::AIRBRAKES, airbrakes, ProcessAirbrake); // (needs GfxActor to exist)
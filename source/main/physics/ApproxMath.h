@@ -23,7 +23,7 @@
 
 #pragma once
 
-#include "Application.h"
+#include <OgreVector3.h> // Only OGRE, so that 'source/microbenchmarks' can use it
 
 static int mirand = 1;
 
@@ -52,17 +52,24 @@ inline float frand_02()
 }
 
 // Returns a random number in the range [-1, 1]
-inline float frand_11()
+// Advances the given generator state; use a separate state per thread or actor to get repeatable sequences.
+inline float frand_11(int& state)
 {
     unsigned int a;
 
-    mirand *= 16807;
+    state *= 16807;
 
-    a = (mirand&0x007fffff) | 0x40000000;
+    a = (state&0x007fffff) | 0x40000000;
 
     return( *((float*)&a) - 3.0f );
 }
 
+// Returns a random number in the range [-1, 1]
+inline float frand_11()
+{
+    return frand_11(mirand);
+}
+
 // Calculates approximate e^x.
 // Use it in code not requiring precision
 inline float approx_exp(const float x)
@@ -0,0 +1,66 @@
+/*
+    This source file is part of Rigs of Rods
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Inner loop of the plain beam solver, shared with 'source/microbenchmarks'.
+/// Only depends on OGRE's math headers, so that the benchmarks can build without the game.
+
+#pragma once
+
+#include "ApproxMath.h"
+
+#include <OgreVector3.h>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// Spring and damper stress of a plain beam, see `Actor::CalcPlainBeam()`.
+/// @tparam BEAM `beam_t` or a look-alike with `p1`, `p2` (nodes with `RelPosition` and `Velocity`), `k`, `d` and `L`.
+/// @param out_dis Vector from `p2` to `p1`
+/// @param out_inverted_dislen 1 / length of `out_dis`
+/// @param out_difftoBeamL Deviation from the beam's rest length, for deformation
+template <class BEAM>
+inline float CalcPlainBeamStress(BEAM const& beam, Ogre::Vector3& out_dis, float& out_inverted_dislen, float& out_difftoBeamL)
+{
+    // Calculate beam length
+    out_dis = beam.p1->RelPosition - beam.p2->RelPosition;
+
+    float dislen = out_dis.squaredLength();
+    out_inverted_dislen = fast_invSqrt(dislen);
+
+    dislen *= out_inverted_dislen;
+
+    // Calculate beam's deviation from normal
+    out_difftoBeamL = dislen - beam.L;
+
+    // Calculate beam's rate of change
+    const float v = (beam.p1->Velocity - beam.p2->Velocity).dotProduct(out_dis) * out_inverted_dislen;
+
+    return -beam.k * out_difftoBeamL - beam.d * v;
+}
+
+/// Force on `p1` (and negated on `p2`) for the stress from `CalcPlainBeamStress()`.
+inline Ogre::Vector3 CalcPlainBeamForce(Ogre::Vector3 const& dis, float stress, float inverted_dislen)
+{
+    return dis * (stress * inverted_dislen);
+}
+
+/// @} // addtogroup Physics
+
+} // namespace RoR
@@ -84,6 +84,12 @@ float RoR::CmdKeyInertia::CalcCmdKeyDelay(float cmd_input, float dt)
     return calculated_output;
 }
 
+bool RoR::CmdKeyInertia::IsIdle(float cmd_input, float dt) const
+{
+    // Once the output reaches the input, each step only resets the timer to `dt`
+    return !m_start_spline || !m_stop_spline || (m_last_output == cmd_input && m_time == dt);
+}
+
 int RoR::CmdKeyInertia::SetCmdKeyDelay(RoR::CmdKeyInertiaConfig& cfg, float start_delay, float stop_delay, std::string start_function, std::string stop_function)
 {
     // Delay values should always be greater than 0
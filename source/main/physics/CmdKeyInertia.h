@@ -48,6 +48,7 @@ public:
     CmdKeyInertia();
 
     float CalcCmdKeyDelay(float cmd_input, float dt);
+    bool IsIdle(float cmd_input, float dt) const; //!< True if `CalcCmdKeyDelay()` would return `cmd_input` and leave the state as it is
     int SetCmdKeyDelay(RoR::CmdKeyInertiaConfig& cfg, float start_delay, float stop_delay, std::string start_function, std::string stop_function);
     void ResetCmdKeyDelay();
 
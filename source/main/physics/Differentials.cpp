@@ -24,26 +24,44 @@
 
 using namespace RoR;
 
+// Must match the constants in `CalcViscousDiff()` and `CalcLockedDiff()`.
+static const DiffModeCoefs DIFF_MODE_TABLE[] =
+{
+    //  share   rate        damp      integrate  open
+    {   0.5f,   0.0f,       0.0f,     0.0f,      false }, // SPLIT_DIFF
+    {   0.0f,   0.0f,       0.0f,     0.0f,      true  }, // OPEN_DIFF
+    {   0.5f,   0.0f,       10000.0f, 0.0f,      false }, // VISCOUS_DIFF
+    {   0.5f,   1000000.0f, 10000.0f, 1.0f,      false }, // LOCKED_DIFF
+    {   0.0f,   0.0f,       0.0f,     0.0f,      false }, // INVALID_DIFF - no torque, like an empty mode list
+};
+
 void Differential::ToggleDifferentialMode()
 {
     if (m_available_diffs.size() > 1)
     {
         std::rotate(m_available_diffs.begin(), m_available_diffs.begin() + 1, m_available_diffs.end());
+        m_active_diff = m_available_diffs[0];
     }
 }
 
-void Differential::CalcAxleTorque(DifferentialData& diff_data)
+void Differential::CalcDiffTorque(DiffType type, DifferentialData& diff_data)
 {
-    if (m_available_diffs.empty())
-        return;
+    const DiffModeCoefs& mode = DIFF_MODE_TABLE[type];
 
-    switch (m_available_diffs[0])
+    if (mode.dm_open)
     {
-    case SPLIT_DIFF:   this->CalcSeparateDiff(diff_data);  return;
-    case OPEN_DIFF:    this->CalcOpenDiff(diff_data);      return;
-    case VISCOUS_DIFF: this->CalcViscousDiff(diff_data);   return;
-    case LOCKED_DIFF:  this->CalcLockedDiff(diff_data);    return;
+        CalcOpenDiff(diff_data);
+        return;
     }
+
+    const float delta_speed = diff_data.speed[0] - diff_data.speed[1];
+    diff_data.delta_rotation += delta_speed * diff_data.dt * mode.dm_integrate;
+
+    const float torsion = diff_data.delta_rotation * mode.dm_torsion_rate + delta_speed * mode.dm_torsion_damp;
+    const float share = diff_data.in_torque * mode.dm_torque_share;
+
+    diff_data.out_torque[0] = share - torsion;
+    diff_data.out_torque[1] = share + torsion;
 }
 
 Ogre::UTFString Differential::GetDifferentialTypeName()
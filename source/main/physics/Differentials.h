@@ -63,29 +63,54 @@ enum DiffType
     INVALID_DIFF
 };
 
+/// Precomputed per-mode coefficients, indexed by `DiffType`. Split, viscous and locked
+/// differentials are one torsion spring-damper with different rates; only open differentials
+/// distribute the torque by wheel speed instead.
+struct DiffModeCoefs
+{
+    float dm_torque_share;   //!< Fraction of the input torque each side receives
+    float dm_torsion_rate;   //!< Spring rate acting on the accumulated delta rotation
+    float dm_torsion_damp;   //!< Damping acting on the speed difference
+    float dm_integrate;      //!< 1 if the delta rotation accumulates, 0 if it's left untouched
+    bool  dm_open;           //!< Torque is split by normalized wheel speed
+};
+
+class Differential;
+
+/// One entry of the flattened drivetrain graph, resolved once at spawn so the per-step pass
+/// in `Actor::CalcDifferentials()` reads wheel indices directly instead of chasing
+/// `Differential` -> `m_wheel_diffs` -> `ar_wheels`.
+struct DrivetrainLink
+{
+    Differential* dl_diff = nullptr; //!< Owns the active mode and the delta rotation
+    int           dl_wheels[4] = {}; //!< Interaxle: wheels of axle 1, then axle 2; interwheel: first two only
+};
+
 class Differential
 {
 public:
-    Differential(): di_idx_1(0), di_idx_2(0), di_delta_rotation(0.0f) {};
+    Differential(): di_idx_1(0), di_idx_2(0), di_delta_rotation(0.0f), m_active_diff(INVALID_DIFF) {};
 
     int       di_idx_1;          //!< array location of wheel / axle 1
     int       di_idx_2;          //!< array location of wheel / axle 2
     float     di_delta_rotation; //!< difference of rotational position between two wheels/axles... a kludge at best
 
-    void             AddDifferentialType(DiffType diff) { m_available_diffs.push_back(diff); }
+    void             AddDifferentialType(DiffType diff) { m_available_diffs.push_back(diff); m_active_diff = m_available_diffs[0]; }
     void             ToggleDifferentialMode();
-    void             CalcAxleTorque(DifferentialData& diff_data);
+    void             CalcAxleTorque(DifferentialData& diff_data) { CalcDiffTorque(m_active_diff, diff_data); }
     Ogre::UTFString  GetDifferentialTypeName();
-    DiffType         GetActiveDiffType() const { return m_available_diffs[0]; }
+    DiffType         GetActiveDiffType() const { return m_active_diff; }
     int              GetNumDiffTypes() { return static_cast<int>(m_available_diffs.size()); }
     
     static void      CalcSeparateDiff(DifferentialData& diff_data);  //!< a differential that always splits the torque evenly, this is the original method
     static void      CalcOpenDiff(DifferentialData& diff_data );     //!< more power goes to the faster spining wheel
     static void      CalcViscousDiff(DifferentialData& diff_data );  //!< more power goes to the slower spining wheel
     static void      CalcLockedDiff(DifferentialData& diff_data );   //!< ensures both wheels rotate at the the same speed
+    static void      CalcDiffTorque(DiffType type, DifferentialData& diff_data); //!< evaluates any mode from `DIFF_MODE_TABLE` without per-mode dispatch
 
 private:
     std::vector<DiffType> m_available_diffs;
+    DiffType              m_active_diff; //!< Cached `m_available_diffs[0]`, `INVALID_DIFF` if empty
 };
 
 /// @} // addtogroup Trucks
@@ -36,11 +36,15 @@
 #include "Language.h"
 #include "PlatformUtils.h"
 #include "ScrewProp.h"
+#include "SimProfiler.h"
 #include "Skidmark.h"
 #include "SkyManager.h"
 #include "Terrain.h"
 
 #include <rapidjson/rapidjson.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+#include <cstdio>
 #include <fstream>
 
 #define SAVEGAME_FILE_FORMAT 3
@@ -48,6 +52,154 @@
 using namespace Ogre;
 using namespace RoR;
 
+// Binary savegames start with SAVEGAME_BIN_MAGIC, followed by chunks {uint32 tag, uint32 size, data}.
+// The JSON chunk holds the same document as a JSON savegame, minus the per-actor "nodes" and "beams" arrays;
+// those follow as raw NODE/BEAM chunks, one of each per actor, in actor order. Unknown chunks are skipped.
+static const char     SAVEGAME_BIN_MAGIC[8] = { 'R', 'o', 'R', 'S', 'a', 'v', 'e', '\x01' };
+static const uint32_t SAVEGAME_CHUNK_JSON = 0x4E4F534A; // "JSON"
+static const uint32_t SAVEGAME_CHUNK_NODE = 0x45444F4E; // "NODE"
+static const uint32_t SAVEGAME_CHUNK_BEAM = 0x4D414542; // "BEAM"
+
+struct SavegameNode
+{
+    float    abs_position[3];
+    float    velocity[3];
+    float    initial_position[3];
+};
+
+struct SavegameBeam
+{
+    float    maxposstress;
+    float    maxnegstress;
+    float    minmaxposnegstress;
+    float    strength;
+    float    length;
+    int32_t  locked_actor;
+    uint8_t  broken;
+    uint8_t  disabled;
+    uint8_t  inter_actor;
+    uint8_t  padding;
+};
+
+/// Scene state copied at a frame boundary, so it can be serialized and written on any thread.
+struct SavegameSnapshot
+{
+    std::string                             path;   //!< Full path, resolved on main thread
+    bool                                    binary = true;
+    rapidjson::Document                     j_doc;  //!< All but nodes and beams; owns its strings
+    std::vector<std::vector<SavegameNode>>  nodes;  //!< Per entry of `j_doc["actors"]`
+    std::vector<std::vector<SavegameBeam>>  beams;  //!< Per entry of `j_doc["actors"]`
+};
+
+static void AppendSavegameChunk(std::vector<char>& out, uint32_t tag, const void* data, size_t size)
+{
+    const uint32_t chunk_header[] = { tag, static_cast<uint32_t>(size) };
+    out.insert(out.end(), (const char*)chunk_header, (const char*)chunk_header + sizeof(chunk_header));
+    out.insert(out.end(), (const char*)data, (const char*)data + size);
+}
+
+/// Reads either savegame format; binary NODE/BEAM chunks are attached to the actor entries as "nodes_bin"/"beams_bin" strings.
+static bool LoadSavegameDocument(std::string const& filename, rapidjson::Document& j_doc)
+{
+    std::string data;
+    try
+    {
+        Ogre::DataStreamPtr stream = Ogre::ResourceGroupManager::getSingleton().openResource(filename, RGN_SAVEGAMES);
+        data = stream->getAsString();
+    }
+    catch (Ogre::FileNotFoundException)
+    {
+        return false; // Error already logged by OGRE
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|Savegame] Failed to read '%s', message: '%s'", filename.c_str(), e.what());
+        return false;
+    }
+
+    if (data.size() < sizeof(SAVEGAME_BIN_MAGIC) || memcmp(data.data(), SAVEGAME_BIN_MAGIC, sizeof(SAVEGAME_BIN_MAGIC)) != 0)
+    {
+        j_doc.Parse<rapidjson::kParseNanAndInfFlag>(data.data(), data.size());
+        return !j_doc.HasParseError();
+    }
+
+    size_t pos = sizeof(SAVEGAME_BIN_MAGIC);
+    rapidjson::SizeType node_actor = 0;
+    rapidjson::SizeType beam_actor = 0;
+    while (pos + 2 * sizeof(uint32_t) <= data.size())
+    {
+        uint32_t chunk_header[2];
+        memcpy(chunk_header, &data[pos], sizeof(chunk_header));
+        pos += sizeof(chunk_header);
+        if (pos + chunk_header[1] > data.size())
+        {
+            RoR::LogFormat("[RoR|Savegame] '%s' is truncated", filename.c_str());
+            return false;
+        }
+        const char* chunk = &data[pos];
+        pos += chunk_header[1];
+
+        if (chunk_header[0] == SAVEGAME_CHUNK_JSON)
+        {
+            j_doc.Parse<rapidjson::kParseNanAndInfFlag>(chunk, chunk_header[1]);
+            if (j_doc.HasParseError() || !j_doc.IsObject() || !j_doc.HasMember("actors") || !j_doc["actors"].IsArray())
+                return false;
+        }
+        else if ((chunk_header[0] == SAVEGAME_CHUNK_NODE || chunk_header[0] == SAVEGAME_CHUNK_BEAM) && j_doc.IsObject())
+        {
+            const bool nodes = (chunk_header[0] == SAVEGAME_CHUNK_NODE);
+            rapidjson::SizeType& index = nodes ? node_actor : beam_actor;
+            if (index < j_doc["actors"].Size())
+            {
+                j_doc["actors"][index].AddMember(rapidjson::StringRef(nodes ? "nodes_bin" : "beams_bin"),
+                    rapidjson::Value(chunk, chunk_header[1], j_doc.GetAllocator()), j_doc.GetAllocator());
+            }
+            index++;
+        }
+    }
+    return j_doc.IsObject();
+}
+
+/// Thread-safe (plain file IO, not Ogre's resource system). Writes the binary format if `actor_chunks` is given, plain JSON otherwise.
+/// Goes through a temporary file, so a crash while writing leaves the previous savegame intact.
+static bool WriteSavegameFile(std::string const& path, rapidjson::Document& j_doc, std::vector<char> const* actor_chunks)
+{
+    rapidjson::StringBuffer j_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer, rapidjson::UTF8<>, rapidjson::UTF8<>,
+                      rapidjson::CrtAllocator, rapidjson::kWriteNanAndInfFlag>
+                      writer(j_buffer);
+    j_doc.Accept(writer);
+
+    const std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream file(tmp_path, std::ios::binary | std::ios::trunc);
+        if (actor_chunks)
+        {
+            std::vector<char> head(SAVEGAME_BIN_MAGIC, SAVEGAME_BIN_MAGIC + sizeof(SAVEGAME_BIN_MAGIC));
+            AppendSavegameChunk(head, SAVEGAME_CHUNK_JSON, j_buffer.GetString(), j_buffer.GetSize());
+            file.write(head.data(), head.size());
+            file.write(actor_chunks->data(), actor_chunks->size());
+        }
+        else
+        {
+            file.write(j_buffer.GetString(), j_buffer.GetSize());
+        }
+        if (!file.good())
+        {
+            RoR::LogFormat("[RoR|Savegame] Error writing '%s', disk full?", path.c_str());
+            return false;
+        }
+    }
+
+    std::remove(path.c_str()); // `rename()` doesn't replace existing files on Windows
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        RoR::LogFormat("[RoR|Savegame] Error writing '%s', cannot rename the temporary file", path.c_str());
+        return false;
+    }
+    return true;
+}
+
 // --------------------------------
 // GameContext functions
 
@@ -70,11 +222,28 @@ void GameContext::SaveScene(std::string const& filename)
     m_actor_manager.SaveScene(filename);
 }
 
+void GameContext::UpdateAutosave(float dt_sec)
+{
+    const int interval = App::sim_autosave_interval->getInt();
+    if (interval <= 0)
+    {
+        m_autosave_timer = 0.f;
+        return;
+    }
+
+    m_autosave_timer += dt_sec;
+    if (m_autosave_timer >= interval)
+    {
+        m_autosave_timer = 0.f;
+        m_actor_manager.SaveSceneAsync("autosave.sav");
+    }
+}
+
 std::string GameContext::ExtractSceneName(std::string const& filename)
 {
     // Read from disk
     rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, j_doc) ||
+    if (!LoadSavegameDocument(filename, j_doc) ||
         !j_doc.IsObject() || !j_doc.HasMember("format_version") || !j_doc["format_version"].IsNumber() ||
         !j_doc.HasMember("scene_name") || !j_doc["scene_name"].IsString())
         return "";
@@ -86,7 +255,7 @@ std::string GameContext::ExtractSceneTerrain(std::string const& filename)
 {
     // Read from disk
     rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, j_doc) ||
+    if (!LoadSavegameDocument(filename, j_doc) ||
         !j_doc.IsObject() || !j_doc.HasMember("format_version") || !j_doc["format_version"].IsNumber() ||
         !j_doc.HasMember("terrain_name") || !j_doc["terrain_name"].IsString())
         return "";
@@ -237,9 +406,11 @@ void GameContext::HandleSavegameHotkeys()
 
 bool ActorManager::LoadScene(Ogre::String filename)
 {
+    this->SyncWithSaveTask(); // It may be writing this very file
+
     // Read from disk
     rapidjson::Document j_doc;
-    if (!App::GetContentManager()->LoadAndParseJson(filename, RGN_SAVEGAMES, j_doc) ||
+    if (!LoadSavegameDocument(filename, j_doc) ||
         !j_doc.IsObject() || !j_doc.HasMember("format_version") || !j_doc["format_version"].IsNumber())
     {
         App::GetConsole()->putMessage(
@@ -406,32 +577,86 @@ bool ActorManager::LoadScene(Ogre::String filename)
 }
 
 bool ActorManager::SaveScene(Ogre::String filename)
+{
+    this->SyncWithSaveTask(); // Don't let an autosave overwrite this one
+
+    std::shared_ptr<SavegameSnapshot> snapshot = this->TakeSceneSnapshot(filename);
+    if (!snapshot)
+    {
+        return false;
+    }
+    if (!ActorManager::WriteSceneSnapshot(*snapshot))
+    {
+        return false; // Error already reported
+    }
+
+    if (filename != "autosave.sav")
+    {
+        App::GetConsole()->putMessage(
+            Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, _L("Scene saved"));
+    }
+
+    return true;
+}
+
+void ActorManager::SaveSceneAsync(std::string const& filename)
+{
+    if (m_save_task && !m_save_task->is_finished())
+    {
+        return; // The previous save is still being written, skip this one rather than piling them up
+    }
+
+    std::shared_ptr<SavegameSnapshot> snapshot = this->TakeSceneSnapshot(filename);
+    if (snapshot)
+    {
+        m_save_task = App::GetThreadPool()->RunTask([snapshot]()
+            {
+                ActorManager::WriteSceneSnapshot(*snapshot);
+            }, TaskPriority::BACKGROUND);
+    }
+}
+
+void ActorManager::SyncWithSaveTask()
+{
+    if (m_save_task)
+    {
+        m_save_task->join();
+        m_save_task = nullptr;
+    }
+}
+
+std::shared_ptr<SavegameSnapshot> ActorManager::TakeSceneSnapshot(std::string const& filename)
 {
     std::vector<ActorPtr> x_actors = GetLocalActors();
 
     if (App::mp_state->getEnum<MpState>() == RoR::MpState::CONNECTED)
     {
         if (filename == "autosave.sav")
-            return false;
+            return nullptr;
         if (x_actors.size() > 3)
         {
             App::GetConsole()->putMessage(
                 Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("Error while saving scene: Too many vehicles"));
-            return false;
+            return nullptr;
         }
     }
 
-    rapidjson::Document j_doc;
+    std::shared_ptr<SavegameSnapshot> snapshot = std::make_shared<SavegameSnapshot>();
+    snapshot->path = PathCombine(App::sys_savegames_dir->getStr(), filename);
+    snapshot->binary = !App::sim_savegame_json->getBool();
+
+    // Everything ends up copied into the document - the actors may be gone by the time it's written
+    rapidjson::Document& j_doc = snapshot->j_doc;
     j_doc.SetObject();
     j_doc.AddMember("format_version", SAVEGAME_FILE_FORMAT, j_doc.GetAllocator());
 
     // Pretty name
     String pretty_name = App::GetCacheSystem()->GetPrettyName(App::sim_terrain_name->getStr());
     String scene_name = StringUtil::format("%s [%d]", pretty_name.c_str(), x_actors.size());
-    j_doc.AddMember("scene_name", rapidjson::StringRef(scene_name.c_str()), j_doc.GetAllocator());
+    j_doc.AddMember("scene_name", rapidjson::Value(scene_name.c_str(), j_doc.GetAllocator()), j_doc.GetAllocator());
 
     // Terrain
-    j_doc.AddMember("terrain_name", rapidjson::StringRef(App::sim_terrain_name->getStr().c_str()), j_doc.GetAllocator());
+    j_doc.AddMember("terrain_name", rapidjson::Value(App::sim_terrain_name->getStr().c_str(), j_doc.GetAllocator()), j_doc.GetAllocator());
 
 #ifdef USE_CAELUM
     if (App::gfx_sky_mode->getEnum<GfxSkyMode>() == GfxSkyMode::CAELUM)
@@ -470,7 +695,7 @@ bool ActorManager::SaveScene(Ogre::String filename)
     {
         rapidjson::Value j_entry(rapidjson::kObjectType);
 
-        j_entry.AddMember("filename", rapidjson::StringRef(actor->ar_filename.c_str()), j_doc.GetAllocator());
+        j_entry.AddMember("filename", rapidjson::Value(actor->ar_filename.c_str(), j_doc.GetAllocator()), j_doc.GetAllocator());
         rapidjson::Value j_actor_position(rapidjson::kArrayType);
         j_actor_position.PushBack(actor->ar_nodes[0].AbsPosition.x, j_doc.GetAllocator());
         j_actor_position.PushBack(actor->ar_nodes[0].AbsPosition.y, j_doc.GetAllocator());
@@ -487,10 +712,10 @@ bool ActorManager::SaveScene(Ogre::String filename)
 
         if (actor->m_used_skin_entry)
         {
-            j_entry.AddMember("skin", rapidjson::StringRef(actor->m_used_skin_entry->dname.c_str()), j_doc.GetAllocator());
+            j_entry.AddMember("skin", rapidjson::Value(actor->m_used_skin_entry->dname.c_str(), j_doc.GetAllocator()), j_doc.GetAllocator());
         }
 
-        j_entry.AddMember("section_config", rapidjson::StringRef(actor->m_section_config.c_str()), j_doc.GetAllocator());
+        j_entry.AddMember("section_config", rapidjson::Value(actor->m_section_config.c_str(), j_doc.GetAllocator()), j_doc.GetAllocator());
 
         // Engine, anti-lock brake, traction control
         if (actor->ar_engine)
@@ -688,71 +913,98 @@ bool ActorManager::SaveScene(Ogre::String filename)
 
         j_entry.AddMember("slidenodes_locked", actor->m_slidenodes_locked, j_doc.GetAllocator());
 
-        // Nodes
-        rapidjson::Value j_nodes(rapidjson::kArrayType);
+        // Nodes and beams - raw copies, the slow part (JSON or chunks) is done by `WriteSceneSnapshot()`
+        snapshot->nodes.emplace_back(actor->ar_num_nodes);
+        std::vector<SavegameNode>& nodes = snapshot->nodes.back();
         for (int i = 0; i < actor->ar_num_nodes; i++)
         {
-            rapidjson::Value j_node(rapidjson::kArrayType);
+            memcpy(nodes[i].abs_position, actor->ar_nodes[i].AbsPosition.ptr(), sizeof(nodes[i].abs_position));
+            memcpy(nodes[i].velocity, actor->ar_nodes[i].Velocity.ptr(), sizeof(nodes[i].velocity));
+            memcpy(nodes[i].initial_position, actor->ar_initial_node_positions[i].ptr(), sizeof(nodes[i].initial_position));
+        }
+        snapshot->beams.emplace_back(actor->ar_num_beams);
+        std::vector<SavegameBeam>& beams = snapshot->beams.back();
+        for (int i = 0; i < actor->ar_num_beams; i++)
+        {
+            ActorPtr locked_actor = actor->ar_beams[i].bm_locked_actor;
+            beams[i].maxposstress       = actor->ar_beams[i].maxposstress;
+            beams[i].maxnegstress       = actor->ar_beams[i].maxnegstress;
+            beams[i].minmaxposnegstress = actor->ar_beams[i].minmaxposnegstress;
+            beams[i].strength           = actor->ar_beams[i].strength;
+            beams[i].length             = actor->ar_beams[i].L;
+            beams[i].locked_actor       = locked_actor ? vector_index_lookup[locked_actor->ar_vector_index] : -1;
+            beams[i].broken             = actor->ar_beams[i].bm_broken;
+            beams[i].disabled           = actor->ar_beams[i].bm_disabled;
+            beams[i].inter_actor        = actor->ar_beams[i].bm_inter_actor;
+            beams[i].padding            = 0;
+        }
 
-            // Position
-            j_node.PushBack(actor->ar_nodes[i].AbsPosition.x, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].AbsPosition.y, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].AbsPosition.z, j_doc.GetAllocator());
+        j_actors.PushBack(j_entry, j_doc.GetAllocator());
+    }
+    j_doc.AddMember("actors", j_actors, j_doc.GetAllocator());
 
-            // Velocity
-            j_node.PushBack(actor->ar_nodes[i].Velocity.x, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].Velocity.y, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_nodes[i].Velocity.z, j_doc.GetAllocator());
+    return snapshot;
+}
 
-            // Initial Position
-            j_node.PushBack(actor->ar_initial_node_positions[i].x, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_initial_node_positions[i].y, j_doc.GetAllocator());
-            j_node.PushBack(actor->ar_initial_node_positions[i].z, j_doc.GetAllocator());
+bool ActorManager::WriteSceneSnapshot(SavegameSnapshot& snapshot)
+{
+    ROR_PROFILE_ZONE("ActorManager::WriteSceneSnapshot", -1);
 
+    rapidjson::Document& j_doc = snapshot.j_doc;
+    rapidjson::Value& j_actors = j_doc["actors"];
+    std::vector<char> actor_chunks; // Binary format only: NODE/BEAM chunks
+    for (rapidjson::SizeType a = 0; a < j_actors.Size(); a++)
+    {
+        std::vector<SavegameNode> const& nodes = snapshot.nodes[a];
+        std::vector<SavegameBeam> const& beams = snapshot.beams[a];
+        if (snapshot.binary)
+        {
+            AppendSavegameChunk(actor_chunks, SAVEGAME_CHUNK_NODE, nodes.data(), nodes.size() * sizeof(SavegameNode));
+            AppendSavegameChunk(actor_chunks, SAVEGAME_CHUNK_BEAM, beams.data(), beams.size() * sizeof(SavegameBeam));
+            continue;
+        }
+
+        rapidjson::Value j_nodes(rapidjson::kArrayType);
+        for (SavegameNode const& node: nodes)
+        {
+            // Position, velocity, initial position
+            rapidjson::Value j_node(rapidjson::kArrayType);
+            for (float value: node.abs_position)
+                j_node.PushBack(value, j_doc.GetAllocator());
+            for (float value: node.velocity)
+                j_node.PushBack(value, j_doc.GetAllocator());
+            for (float value: node.initial_position)
+                j_node.PushBack(value, j_doc.GetAllocator());
             j_nodes.PushBack(j_node, j_doc.GetAllocator());
         }
-        j_entry.AddMember("nodes", j_nodes, j_doc.GetAllocator());
+        j_actors[a].AddMember("nodes", j_nodes, j_doc.GetAllocator());
 
-        // Beams
         rapidjson::Value j_beams(rapidjson::kArrayType);
-        for (int i = 0; i < actor->ar_num_beams; i++)
+        for (SavegameBeam const& beam: beams)
         {
             rapidjson::Value j_beam(rapidjson::kArrayType);
-
-            j_beam.PushBack(actor->ar_beams[i].maxposstress, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].maxnegstress, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].minmaxposnegstress, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].strength, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].L, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].bm_broken, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].bm_disabled, j_doc.GetAllocator());
-            j_beam.PushBack(actor->ar_beams[i].bm_inter_actor, j_doc.GetAllocator());
-            ActorPtr locked_actor = actor->ar_beams[i].bm_locked_actor;
-            j_beam.PushBack(locked_actor ? vector_index_lookup[locked_actor->ar_vector_index] : -1, j_doc.GetAllocator());
-
+            j_beam.PushBack(beam.maxposstress, j_doc.GetAllocator());
+            j_beam.PushBack(beam.maxnegstress, j_doc.GetAllocator());
+            j_beam.PushBack(beam.minmaxposnegstress, j_doc.GetAllocator());
+            j_beam.PushBack(beam.strength, j_doc.GetAllocator());
+            j_beam.PushBack(beam.length, j_doc.GetAllocator());
+            j_beam.PushBack(beam.broken != 0, j_doc.GetAllocator());
+            j_beam.PushBack(beam.disabled != 0, j_doc.GetAllocator());
+            j_beam.PushBack(beam.inter_actor != 0, j_doc.GetAllocator());
+            j_beam.PushBack(beam.locked_actor, j_doc.GetAllocator());
             j_beams.PushBack(j_beam, j_doc.GetAllocator());
         }
-        j_entry.AddMember("beams", j_beams, j_doc.GetAllocator());
-
-        j_actors.PushBack(j_entry, j_doc.GetAllocator());
+        j_actors[a].AddMember("beams", j_beams, j_doc.GetAllocator());
     }
-    j_doc.AddMember("actors", j_actors, j_doc.GetAllocator());
 
     // Write to disk
-    if (!App::GetContentManager()->SerializeAndWriteJson(filename, RGN_SAVEGAMES, j_doc))
+    if (!WriteSavegameFile(snapshot.path, j_doc, snapshot.binary ? &actor_chunks : nullptr))
     {
         // Error already logged
         App::GetConsole()->putMessage(
             Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("Error while saving scene"));
         return false;
     }
-
-    if (filename != "autosave.sav")
-    {
-        App::GetConsole()->putMessage(
-            Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, _L("Scene saved"));
-    }
-
     return true;
 }
 
@@ -906,31 +1158,75 @@ void ActorManager::RestoreSavedState(ActorPtr actor, rapidjson::Value const& j_e
         }
     }
 
-    auto nodes = j_entry["nodes"].GetArray();
-    for (rapidjson::SizeType i = 0; i < nodes.Size(); i++)
+    // Nodes and beams come either as JSON arrays or as binary chunks, see LoadSavegameDocument()
+    std::vector<SavegameNode> nodes;
+    if (j_entry.HasMember("nodes_bin"))
+    {
+        rapidjson::Value const& j_nodes = j_entry["nodes_bin"];
+        nodes.resize(j_nodes.GetStringLength() / sizeof(SavegameNode));
+        memcpy(nodes.data(), j_nodes.GetString(), nodes.size() * sizeof(SavegameNode));
+    }
+    else
+    {
+        for (rapidjson::Value const& j_node: j_entry["nodes"].GetArray())
+        {
+            auto data = j_node.GetArray();
+            SavegameNode node;
+            for (int k = 0; k < 3; k++)
+            {
+                node.abs_position[k]     = data[k].GetFloat();
+                node.velocity[k]         = data[k + 3].GetFloat();
+                node.initial_position[k] = data[k + 6].GetFloat();
+            }
+            nodes.push_back(node);
+        }
+    }
+    for (int i = 0; i < std::min((int)nodes.size(), actor->ar_num_nodes); i++)
     {
-        auto data = nodes[i].GetArray();
-        actor->ar_nodes[i].AbsPosition      = Vector3(data[0].GetFloat(), data[1].GetFloat(), data[2].GetFloat());
+        actor->ar_nodes[i].AbsPosition      = Vector3(nodes[i].abs_position);
         actor->ar_nodes[i].RelPosition      = actor->ar_nodes[i].AbsPosition - actor->ar_origin;
-        actor->ar_nodes[i].Velocity         = Vector3(data[3].GetFloat(), data[4].GetFloat(), data[5].GetFloat());
-        actor->ar_initial_node_positions[i] = Vector3(data[6].GetFloat(), data[7].GetFloat(), data[8].GetFloat());
+        actor->ar_nodes[i].Velocity         = Vector3(nodes[i].velocity);
+        actor->ar_initial_node_positions[i] = Vector3(nodes[i].initial_position);
     }
 
     std::vector<ActorPtr> actors = this->GetLocalActors();
 
-    auto beams = j_entry["beams"].GetArray();
-    for (rapidjson::SizeType i = 0; i < beams.Size(); i++)
-    {
-        auto data = beams[i].GetArray();
-        actor->ar_beams[i].maxposstress       = data[0].GetFloat();
-        actor->ar_beams[i].maxnegstress       = data[1].GetFloat();
-        actor->ar_beams[i].minmaxposnegstress = data[2].GetFloat();
-        actor->ar_beams[i].strength           = data[3].GetFloat();
-        actor->ar_beams[i].L                  = data[4].GetFloat();
-        actor->ar_beams[i].bm_broken          = data[5].GetBool();
-        actor->ar_beams[i].bm_disabled        = data[6].GetBool();
-        actor->ar_beams[i].bm_inter_actor     = data[7].GetBool();
-        int locked_actor                      = data[8].GetInt();
+    std::vector<SavegameBeam> beams;
+    if (j_entry.HasMember("beams_bin"))
+    {
+        rapidjson::Value const& j_beams = j_entry["beams_bin"];
+        beams.resize(j_beams.GetStringLength() / sizeof(SavegameBeam));
+        memcpy(beams.data(), j_beams.GetString(), beams.size() * sizeof(SavegameBeam));
+    }
+    else
+    {
+        for (rapidjson::Value const& j_beam: j_entry["beams"].GetArray())
+        {
+            auto data = j_beam.GetArray();
+            SavegameBeam beam;
+            beam.maxposstress       = data[0].GetFloat();
+            beam.maxnegstress       = data[1].GetFloat();
+            beam.minmaxposnegstress = data[2].GetFloat();
+            beam.strength           = data[3].GetFloat();
+            beam.length             = data[4].GetFloat();
+            beam.broken             = data[5].GetBool();
+            beam.disabled           = data[6].GetBool();
+            beam.inter_actor        = data[7].GetBool();
+            beam.locked_actor       = data[8].GetInt();
+            beams.push_back(beam);
+        }
+    }
+    for (int i = 0; i < std::min((int)beams.size(), actor->ar_num_beams); i++)
+    {
+        actor->ar_beams[i].maxposstress       = beams[i].maxposstress;
+        actor->ar_beams[i].maxnegstress       = beams[i].maxnegstress;
+        actor->ar_beams[i].minmaxposnegstress = beams[i].minmaxposnegstress;
+        actor->ar_beams[i].strength           = beams[i].strength;
+        actor->ar_beams[i].L                  = beams[i].length;
+        actor->ar_beams[i].bm_broken          = beams[i].broken != 0;
+        actor->ar_beams[i].bm_disabled        = beams[i].disabled != 0;
+        actor->ar_beams[i].bm_inter_actor     = beams[i].inter_actor != 0;
+        int locked_actor                      = beams[i].locked_actor;
         if (locked_actor != -1 &&
             locked_actor < (int)actors.size() &&
             actors[locked_actor] != nullptr)
@@ -294,6 +294,8 @@ enum class AeroEngineType
 // Soft body physics
 
 /// Physics: A vertex in the softbody structure
+/// The kinematic fields used by the integrator (`Actor::CalcNodes()`) and the beam solver (`Actor::CalcBeams()`)
+/// are kept together at the front; attributes and collision state follow. Keep it that way when adding fields.
 struct node_t
 {
     static const int8_t    INVALID_BBOX = -1;
@@ -342,31 +344,34 @@ struct beam_t
 {
     beam_t() { memset(this, 0, sizeof(beam_t)); }
 
+    // Fields read by `Actor::CalcBeams()` every physics step; kept together in the first 64 bytes (one cache line)
+
     node_t*         p1;
     node_t*         p2;
     Ogre::Real      k;                     //!< tensile spring
     Ogre::Real      d;                     //!< damping factor
     Ogre::Real      L;                     //!< length
     Ogre::Real      minmaxposnegstress;
-    Ogre::Real      maxposstress;
-    Ogre::Real      maxnegstress;
-    Ogre::Real      strength;
     Ogre::Real      stress;
-    Ogre::Real      plastic_coef;
-    int             detacher_group;        //!< Attribute: detacher group number (integer)
     SpecialBeam     bounded;
     BeamType        bm_type;
     bool            bm_inter_actor;        //!< in case p2 is on another actor
-    ActorPtr        bm_locked_actor;       //!< in case p2 is on another actor
     bool            bm_disabled;
     bool            bm_broken;
-
     Ogre::Real      shortbound;
     Ogre::Real      longbound;
-    Ogre::Real      refL;                  //!< reference length
-
     shock_t*        shock;
 
+    // Fields used when deforming, breaking, detaching or resetting
+
+    Ogre::Real      maxposstress;
+    Ogre::Real      maxnegstress;
+    Ogre::Real      strength;
+    Ogre::Real      plastic_coef;
+    int             detacher_group;        //!< Attribute: detacher group number (integer)
+    ActorPtr        bm_locked_actor;       //!< in case p2 is on another actor
+    Ogre::Real      refL;                  //!< reference length
+
     Ogre::Real      initial_beam_strength; //!< for reset
     Ogre::Real      default_beam_deform;   //!< for reset
 
@@ -410,6 +415,14 @@ struct shock_t
     float sbd_damp;             //!< set beam default for damping
 };
 
+struct beam_break_event_t
+{
+    int   bbe_beam;                 //!< Index to Actor::ar_beams array
+    float bbe_energy;               //!< Energy stored in the spring when it broke; modulates the sound effect
+    float bbe_force;                //!< Stress which exceeded the beam strength; for diagnostics
+    bool  bbe_broken;               //!< False if the break was prevented because a collision-cab node would be left hanging
+};
+
 struct collcab_rate_t
 {
     int rate;     // remaining amount of physics cycles to be skipped
@@ -578,6 +591,8 @@ struct command_t
     bool trigger_cmdkeyblock_state = false;  //!< identifies blocked F-commands for triggers
     std::vector<commandbeam_t> beams;
     std::vector<int> rotators;
+    bool cmd_plays_sound = false;          //!< Attr; any of `beams` plays sound, set at spawn
+    bool cmd_is_force_restricted = false;  //!< Attr; any of `beams` is force restricted, set at spawn
     Ogre::String description;
     RoR::CmdKeyInertia rotator_inertia;
     RoR::CmdKeyInertia command_inertia;
@@ -592,6 +607,8 @@ struct hydrobeam_t
     int      hb_anim_flags; //!< Animators (beams updating length based on simulation variables)
     float    hb_anim_param; //!< Animators (beams updating length based on simulation variables)
     RoR::CmdKeyInertia  hb_inertia;
+    float    hb_cmd_input = 0.f;     //!< State; input of `hb_inertia` at last update, see `Actor::CalcHydros()`
+    float    hb_last_length = -1.f;  //!< State; beam length at last update, see `Actor::CalcHydros()`
 };
 
 struct rotator_t
@@ -647,6 +664,7 @@ struct cparticle_t
     NodeNum_t emitterNode   = NODENUM_INVALID;
     NodeNum_t directionNode = NODENUM_INVALID;
     bool active;
+    bool culled;                //!< Too far from the camera, emitters are off; see `GfxActor::UpdateCParticles()`
     Ogre::SceneNode *snode;
     Ogre::ParticleSystem* psys;
 };
@@ -760,6 +778,8 @@ struct ground_model_t
     float fx_particle_timedelta;    //!< delta for particle animation
     float fx_particle_velo_factor;  //!< velocity factor
     float fx_particle_ttl;
+
+    GroundModelID_t gm_id;          //!< Dense ID, see `Collisions::getGroundModel()`; kept when copying from base
 };
 
 /// @} // addtogroup Collisions
@@ -773,6 +793,17 @@ struct authorinfo_t
     Ogre::String email;
 };
 
+/// Memory held by one actor, see `Actor::GetMemoryUsage()`
+struct ActorMemoryUsage
+{
+    size_t amu_simulation = 0;  //!< The actor object, its simulation arrays and containers
+    size_t amu_replay = 0;      //!< Recorded frames
+    size_t amu_flexbodies = 0;  //!< CPU-side deformation buffers (locators are shared by instances of the same flexbody)
+    size_t amu_meshes = 0;      //!< Ogre meshes of props and flexbodies; a mesh shared by several props is counted once
+
+    size_t GetTotal() const { return amu_simulation + amu_replay + amu_flexbodies + amu_meshes; }
+};
+
 struct ActorSpawnRequest
 {
     enum class Origin //!< Enables special processing
@@ -59,6 +59,13 @@ Ogre::Vector3 NearestPointOnLine(const Ogre::Vector3& pt1, const Ogre::Vector3&
     return pt1 + b * len;
 }
 
+/// Squared distance from `point` to the segment's beam; ordering is the same as `SlideNode::getLenTo()`, without the square root.
+static Ogre::Real GetSqLenTo(const RailSegment* rail, const Ogre::Vector3& point)
+{
+    const beam_t* beam = rail->rs_beam;
+    return (NearestPointOnLine(beam->p1->AbsPosition, beam->p2->AbsPosition, point) - point).squaredLength();
+}
+
 // SLIDE NODES IMPLEMENTATION //////////////////////////////////////////////////
 SlideNode::SlideNode(node_t* slidingNode, RailGroup* slidingRail):
 
@@ -113,12 +120,12 @@ void SlideNode::UpdateForces(float dt)
 
 RailSegment* RailGroup::FindClosestSegment(const Ogre::Vector3& point)
 {
-    float closest_dist_sq = SlideNode::getLenTo(&this->rg_segments[0], point);
+    float closest_dist_sq = GetSqLenTo(&this->rg_segments[0], point);
     size_t closest_seg = 0;
 
     for (size_t i = 1; i < this->rg_segments.size(); ++i)
     {
-        const float dist_sq = SlideNode::getLenTo(&this->rg_segments[i], point);
+        const float dist_sq = GetSqLenTo(&this->rg_segments[i], point);
         if (dist_sq < closest_dist_sq)
         {
             closest_dist_sq = dist_sq;
@@ -131,12 +138,12 @@ RailSegment* RailGroup::FindClosestSegment(const Ogre::Vector3& point)
 
 RailSegment* RailSegment::CheckCurSlideSegment(const Ogre::Vector3& point)
 {
-    float closest_dist_sq = SlideNode::getLenTo(this, point);
+    float closest_dist_sq = GetSqLenTo(this, point);
     RailSegment* closest_seg = this;
 
     if (this->rs_prev != nullptr)
     {
-        const float dist_sq = SlideNode::getLenTo(this->rs_prev, point);
+        const float dist_sq = GetSqLenTo(this->rs_prev, point);
         if (dist_sq < closest_dist_sq)
         {
             closest_seg = this->rs_prev;
@@ -146,7 +153,7 @@ RailSegment* RailSegment::CheckCurSlideSegment(const Ogre::Vector3& point)
 
     if (this->rs_next != nullptr)
     {
-        const float dist_sq = SlideNode::getLenTo(this->rs_next, point);
+        const float dist_sq = GetSqLenTo(this->rs_next, point);
         if (dist_sq < closest_dist_sq)
         {
             closest_seg = this->rs_next;
@@ -170,8 +177,14 @@ void SlideNode::UpdatePosition()
         return;
     }
 
-    // find which beam to use
-    m_cur_rail_seg = m_cur_rail_seg->CheckCurSlideSegment(m_sliding_node->AbsPosition);
+    // find which beam to use - walk along the rail from the last segment until the neighbours are no closer;
+    // the distance strictly decreases with every step, so this also terminates on looped rails
+    RailSegment* next_seg = m_cur_rail_seg->CheckCurSlideSegment(m_sliding_node->AbsPosition);
+    while (next_seg != m_cur_rail_seg)
+    {
+        m_cur_rail_seg = next_seg;
+        next_seg = m_cur_rail_seg->CheckCurSlideSegment(m_sliding_node->AbsPosition);
+    }
     m_sliding_beam = m_cur_rail_seg->rs_beam;
 
     // Get vector for beam
@@ -23,18 +23,36 @@
 #include "Application.h"
 
 #include <Ogre.h>
+#include <cmath>
+#include <map>
 
 using namespace Ogre;
 using namespace RoR;
 
 Airfoil::Airfoil(Ogre::String const& fname)
+    : m_table(LoadTable(fname))
 {
-    for (int i = 0; i < 3601; i++) //init in case of bad things
+}
+
+Airfoil::~Airfoil()
+{
+}
+
+std::shared_ptr<const Airfoil::Table> Airfoil::LoadTable(Ogre::String const& fname)
+{
+    // Only referenced tables are kept; the last wing using a file frees its table
+    static std::map<Ogre::String, std::weak_ptr<const Table>> s_tables;
+    std::shared_ptr<const Table> shared = s_tables[fname].lock();
+    if (shared)
     {
-        cl[i] = 0;
-        cd[i] = 0;
-        cm[i] = 0;
+        return shared;
     }
+
+    std::shared_ptr<Table> table = std::make_shared<Table>();
+    table->fill(Coefs{ 0.f, 0.f, 0.f }); //init in case of bad things
+    std::shared_ptr<const Table> result = table;
+    Table& t = *table;
+
     char line[1024];
     //we load directly X-Plane AFL file format!!!
     bool process = false;
@@ -53,7 +71,7 @@ Airfoil::Airfoil(Ogre::String const& fname)
     if (group == "")
     {
         LOG(String("Airfoil error: could not load airfoil ")+fname);
-        return;
+        return result; // Not cached, in case the resource turns up later
     }
 
     DataStreamPtr ds = rgm.openResource(fname, group);
@@ -79,32 +97,32 @@ Airfoil::Airfoil(Ogre::String const& fname)
                 neg = false;
             int ia = (a * 10 + b) + 1800;
             if (ia == 3600) { process = false; };
-            cl[ia] = l;
-            cd[ia] = d;
-            cm[ia] = m;
+            t[ia].cl = l;
+            t[ia].cd = d;
+            t[ia].cm = m;
             if (lastia != -1 && ia - lastia > 1)
             {
                 //we have to interpolate previous elements (linear interpolation)
                 int i;
                 for (i = 0; i < ia - lastia - 1; i++)
                 {
-                    cl[lastia + 1 + i] = cl[lastia] + (float)(i + 1) * (cl[ia] - cl[lastia]) / (float)(ia - lastia);
-                    cd[lastia + 1 + i] = cd[lastia] + (float)(i + 1) * (cd[ia] - cd[lastia]) / (float)(ia - lastia);
-                    cm[lastia + 1 + i] = cm[lastia] + (float)(i + 1) * (cm[ia] - cm[lastia]) / (float)(ia - lastia);
+                    const float f = (float)(i + 1) / (float)(ia - lastia);
+                    t[lastia + 1 + i].cl = t[lastia].cl + f * (t[ia].cl - t[lastia].cl);
+                    t[lastia + 1 + i].cd = t[lastia].cd + f * (t[ia].cd - t[lastia].cd);
+                    t[lastia + 1 + i].cm = t[lastia].cm + f * (t[ia].cm - t[lastia].cm);
                 }
             }
             lastia = ia;
         }
     }
-}
 
-Airfoil::~Airfoil()
-{
+    s_tables[fname] = result;
+    return result;
 }
 
 void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* ocd, float* ocm)
 {
-    int ta = (int)(a / 360.0);
+    int ta = (int)(a / 360.0f);
     //		float va=360.0f*fmod(a, 360.0f); FMOD IS TOTALLY UNRELIABLE HERE : fmod(-180.0f, 360.0f)=-180.0f!!!!!
     float va = a - (float)(ta * 360);
     if (va > 180.0f)
@@ -113,16 +131,16 @@ void Airfoil::getparams(float a, float cratio, float cdef, float* ocl, float* oc
         va += 360.0f;
     int ia = (int)((va + 180.0f) * 10.0f);
     //drag shift
-    float dva = va + 1.15 * (1.0 - cratio) * cdef;
+    const float flap = 1.0f - cratio;
+    float dva = va + 1.15f * flap * cdef;
     if (dva > 180.0f)
         dva -= 360.0f;
     if (dva < -180.0f)
         dva += 360.0f;
     int dia = (int)((dva + 180.0f) * 10.0f);
-    float sign = 1.0;
-    if (cdef < 0)
-        sign = -1.0;
-    *ocl = cl[ia] - 0.66 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
-    *ocd = cd[dia] + 0.00015 * (1.0 - cratio) * cdef * cdef;
-    *ocm = cm[ia] + 0.20 * sign * (1.0 - cratio) * sqrt(fabs(cdef));
+    const float signed_root = (cdef < 0) ? -std::sqrt(-cdef) : std::sqrt(cdef);
+    const Table& t = *m_table;
+    *ocl = t[ia].cl - 0.66f * flap * signed_root;
+    *ocd = t[dia].cd + 0.00015f * flap * cdef * cdef;
+    *ocm = t[ia].cm + 0.20f * flap * signed_root;
 }
@@ -22,6 +22,9 @@
 
 #include "Application.h"
 
+#include <array>
+#include <memory>
+
 namespace RoR {
 
 /// @addtogroup Physics
@@ -41,9 +44,20 @@ public:
 
 private:
 
-    float cl[3601];
-    float cd[3601];
-    float cm[3601];
+    struct Coefs
+    {
+        float cl;
+        float cd;
+        float cm;
+    };
+
+    /// Coefficients for every 0.1 degree of AoA from -180 to 180; interleaved so that a lookup touches one cache line.
+    /// Wings mostly share a few .afl files; the tables are loaded once per file and shared by all wings using it.
+    typedef std::array<Coefs, 3601> Table;
+
+    static std::shared_ptr<const Table> LoadTable(Ogre::String const& fname);
+
+    std::shared_ptr<const Table> m_table;
 };
 
 /// @} // addtogroup Physics
@@ -0,0 +1,209 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "CabTriangleBvh.h"
+
+#include "PointColDetector.h"
+
+#include <algorithm>
+
+using namespace Ogre;
+using namespace RoR;
+
+static const int BVH_LEAF_TRIS = 4;
+static const size_t BVH_MAX_QUERY_HITS = 32; // Below this many hits, children filter their parent's hits instead of querying the kd-tree
+
+static bool IsInsideBox(Vector3 const& pos, Vector3 const& bbmin, Vector3 const& bbmax)
+{
+    return pos.x >= bbmin.x && pos.x <= bbmax.x &&
+           pos.y >= bbmin.y && pos.y <= bbmax.y &&
+           pos.z >= bbmin.z && pos.z <= bbmax.z;
+}
+
+void CabTriangleBvh::Update(const int num_collcabs, const int collcabs[], const int cabs[], const node_t nodes[])
+{
+    const bool rebuild = (num_collcabs != m_num_collcabs);
+    if (rebuild)
+    {
+        m_num_collcabs = num_collcabs;
+        m_tris.resize(num_collcabs);
+        for (int i = 0; i < num_collcabs; i++)
+        {
+            m_tris[i].collcab_index = i;
+            for (int j = 0; j < 3; j++)
+            {
+                m_tris[i].nodes[j] = cabs[collcabs[i] * 3 + j];
+            }
+        }
+    }
+
+    for (bvhtri_t& tri: m_tris)
+    {
+        tri.bbmin = nodes[tri.nodes[0]].AbsPosition;
+        tri.bbmax = tri.bbmin;
+        for (int j = 1; j < 3; j++)
+        {
+            tri.bbmin.makeFloor(nodes[tri.nodes[j]].AbsPosition);
+            tri.bbmax.makeCeil(nodes[tri.nodes[j]].AbsPosition);
+        }
+    }
+
+    if (rebuild)
+    {
+        m_nodes.clear();
+        m_hits.clear();
+        if (!m_tris.empty())
+        {
+            m_nodes.resize(1);
+            this->Build(0, 0, static_cast<int>(m_tris.size()), 0);
+        }
+        return;
+    }
+
+    // Refit bottom-up
+    for (int i = static_cast<int>(m_nodes.size()) - 1; i >= 0; i--)
+    {
+        bvhnode_t& node = m_nodes[i];
+        if (node.left == -1)
+        {
+            node.bbmin = m_tris[node.begin].bbmin;
+            node.bbmax = m_tris[node.begin].bbmax;
+            for (int t = node.begin + 1; t < node.end; t++)
+            {
+                node.bbmin.makeFloor(m_tris[t].bbmin);
+                node.bbmax.makeCeil(m_tris[t].bbmax);
+            }
+        }
+        else
+        {
+            node.bbmin = m_nodes[node.left].bbmin;
+            node.bbmax = m_nodes[node.left].bbmax;
+            node.bbmin.makeFloor(m_nodes[node.left + 1].bbmin);
+            node.bbmax.makeCeil(m_nodes[node.left + 1].bbmax);
+        }
+    }
+}
+
+void CabTriangleBvh::Build(int index, int begin, int end, int depth)
+{
+    if (static_cast<int>(m_hits.size()) < depth + 2)
+    {
+        m_hits.resize(depth + 2);
+    }
+
+    Vector3 bbmin = m_tris[begin].bbmin, bbmax = m_tris[begin].bbmax;
+    for (int t = begin + 1; t < end; t++)
+    {
+        bbmin.makeFloor(m_tris[t].bbmin);
+        bbmax.makeCeil(m_tris[t].bbmax);
+    }
+    m_nodes[index].bbmin = bbmin;
+    m_nodes[index].bbmax = bbmax;
+    m_nodes[index].begin = begin;
+    m_nodes[index].end = end;
+    if (end - begin <= BVH_LEAF_TRIS)
+    {
+        return;
+    }
+
+    // Median split of triangle centers along the longest axis
+    const Vector3 extent = bbmax - bbmin;
+    const int axis = (extent.x > extent.y) ? ((extent.x > extent.z) ? 0 : 2) : ((extent.y > extent.z) ? 1 : 2);
+    const int median = begin + (end - begin) / 2;
+    std::nth_element(m_tris.begin() + begin, m_tris.begin() + median, m_tris.begin() + end,
+        [axis](bvhtri_t const& a, bvhtri_t const& b)
+        {
+            return (a.bbmin[axis] + a.bbmax[axis]) < (b.bbmin[axis] + b.bbmax[axis]);
+        });
+
+    const int left = static_cast<int>(m_nodes.size());
+    m_nodes[index].left = left;
+    m_nodes.resize(left + 2); // Invalidates references to `m_nodes`
+    this->Build(left, begin, median, depth + 1);
+    this->Build(left + 1, median, end, depth + 1);
+}
+
+void CabTriangleBvh::ForEachCandidate(PointColDetector& pcd, const float margin, const CandidateFunc& func)
+{
+    if (!m_nodes.empty())
+    {
+        this->Walk(0, 0, pcd, margin, nullptr, func);
+    }
+}
+
+void CabTriangleBvh::Walk(int index, int depth, PointColDetector& pcd, const float margin,
+    const std::vector<PointidID_t>* candidates, const CandidateFunc& func)
+{
+    const bvhnode_t& node = m_nodes[index];
+    const Vector3 bbmin = node.bbmin - margin;
+    const Vector3 bbmax = node.bbmax + margin;
+
+    std::vector<PointidID_t>& hits = m_hits[depth];
+    if (candidates == nullptr)
+    {
+        pcd.query(bbmin, bbmax);
+        hits = pcd.hit_list;
+    }
+    else
+    {
+        hits.clear();
+        for (PointidID_t h: *candidates)
+        {
+            if (IsInsideBox(pcd.getPointPosition(h), bbmin, bbmax))
+            {
+                hits.push_back(h);
+            }
+        }
+    }
+    if (hits.empty())
+    {
+        return; // Nothing near any triangle of this subtree
+    }
+
+    if (node.left != -1)
+    {
+        const std::vector<PointidID_t>* child_candidates = (candidates != nullptr || hits.size() <= BVH_MAX_QUERY_HITS) ? &hits : nullptr;
+        const int left = node.left;
+        this->Walk(left, depth + 1, pcd, margin, child_candidates, func);
+        this->Walk(left + 1, depth + 1, pcd, margin, child_candidates, func);
+        return;
+    }
+
+    std::vector<PointidID_t>& tri_hits = m_hits[depth + 1];
+    for (int t = node.begin; t < node.end; t++)
+    {
+        const Vector3 tri_min = m_tris[t].bbmin - margin;
+        const Vector3 tri_max = m_tris[t].bbmax + margin;
+        tri_hits.clear();
+        for (PointidID_t h: hits)
+        {
+            if (IsInsideBox(pcd.getPointPosition(h), tri_min, tri_max))
+            {
+                tri_hits.push_back(h);
+            }
+        }
+        if (!tri_hits.empty())
+        {
+            func(m_tris[t].collcab_index, tri_hits);
+        }
+    }
+}
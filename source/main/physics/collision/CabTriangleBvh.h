@@ -0,0 +1,85 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+#include "SimData.h"
+
+#include <Ogre.h>
+#include <functional>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// @addtogroup Collisions
+/// @{
+
+/// Bounding volume tree over an actor's collision cab triangles.
+/// The topology is built once from the spawn pose, after that the boxes are refitted every step,
+/// so it stays correct (if less tight) as the actor deforms. Walking the tree against a `PointColDetector`
+/// skips whole groups of triangles which have no contacters nearby, with one query per tree node.
+class CabTriangleBvh
+{
+public:
+    typedef std::function<void(int collcab_index, const std::vector<PointidID_t>& hits)> CandidateFunc;
+
+    /// Builds the tree on first use (or if the cabs changed), refits the boxes otherwise.
+    void           Update(const int num_collcabs, const int collcabs[], const int cabs[], const node_t nodes[]);
+
+    /// Calls `func` for every triangle with points of `pcd` within its bounding box enlarged by `margin`.
+    /// The points are visited in tree order, not in `collcabs` order.
+    void           ForEachCandidate(PointColDetector& pcd, const float margin, const CandidateFunc& func);
+
+private:
+    struct bvhtri_t
+    {
+        int            collcab_index;  //!< Index to `Actor::ar_collcabs`
+        int            nodes[3];
+        Ogre::Vector3  bbmin, bbmax;
+    };
+
+    struct bvhnode_t
+    {
+        Ogre::Vector3  bbmin, bbmax;
+        int            left = -1;      //!< Index of first child, the second is next to it; -1 for leaves
+        int            begin = 0;      //!< Leaves: range in `m_tris`
+        int            end = 0;
+    };
+
+    void           Build(int index, int begin, int end, int depth);
+    void           Walk(int index, int depth, PointColDetector& pcd, const float margin,
+                       const std::vector<PointidID_t>* candidates, const CandidateFunc& func);
+
+    std::vector<bvhtri_t>                 m_tris;
+    std::vector<bvhnode_t>                m_nodes;   //!< Children always come after their parent
+    std::vector<std::vector<PointidID_t>> m_hits;    //!< Scratch, one list per tree level + one for triangles
+    int                                   m_num_collcabs = -1;
+};
+
+/// @} // addtogroup Collisions
+/// @} // addtogroup Physics
+
+} // namespace RoR
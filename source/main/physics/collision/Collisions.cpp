@@ -34,6 +34,7 @@
 #include "PlatformUtils.h"
 #include "ScriptEngine.h"
 #include "Terrain.h"
+#include "ThreadPool.h"
 
 using namespace RoR;
 
@@ -42,94 +43,17 @@ using namespace RoR;
 #pragma GCC diagnostic ignored "-Wfloat-equal"
 #endif //OGRE_PLATFORM_LINUX
 
-//hash function SBOX
-//from http://home.comcast.net/~bretm/hash/10.html
-unsigned int sbox[] =
-{
-    0xF53E1837, 0x5F14C86B, 0x9EE3964C, 0xFA796D53,
-    0x32223FC3, 0x4D82BC98, 0xA0C7FA62, 0x63E2C982,
-    0x24994A5B, 0x1ECE7BEE, 0x292B38EF, 0xD5CD4E56,
-    0x514F4303, 0x7BE12B83, 0x7192F195, 0x82DC7300,
-    0x084380B4, 0x480B55D3, 0x5F430471, 0x13F75991,
-    0x3F9CF22C, 0x2FE0907A, 0xFD8E1E69, 0x7B1D5DE8,
-    0xD575A85C, 0xAD01C50A, 0x7EE00737, 0x3CE981E8,
-    0x0E447EFA, 0x23089DD6, 0xB59F149F, 0x13600EC7,
-    0xE802C8E6, 0x670921E4, 0x7207EFF0, 0xE74761B0,
-    0x69035234, 0xBFA40F19, 0xF63651A0, 0x29E64C26,
-    0x1F98CCA7, 0xD957007E, 0xE71DDC75, 0x3E729595,
-    0x7580B7CC, 0xD7FAF60B, 0x92484323, 0xA44113EB,
-    0xE4CBDE08, 0x346827C9, 0x3CF32AFA, 0x0B29BCF1,
-    0x6E29F7DF, 0xB01E71CB, 0x3BFBC0D1, 0x62EDC5B8,
-    0xB7DE789A, 0xA4748EC9, 0xE17A4C4F, 0x67E5BD03,
-    0xF3B33D1A, 0x97D8D3E9, 0x09121BC0, 0x347B2D2C,
-    0x79A1913C, 0x504172DE, 0x7F1F8483, 0x13AC3CF6,
-    0x7A2094DB, 0xC778FA12, 0xADF7469F, 0x21786B7B,
-    0x71A445D0, 0xA8896C1B, 0x656F62FB, 0x83A059B3,
-    0x972DFE6E, 0x4122000C, 0x97D9DA19, 0x17D5947B,
-    0xB1AFFD0C, 0x6EF83B97, 0xAF7F780B, 0x4613138A,
-    0x7C3E73A6, 0xCF15E03D, 0x41576322, 0x672DF292,
-    0xB658588D, 0x33EBEFA9, 0x938CBF06, 0x06B67381,
-    0x07F192C6, 0x2BDA5855, 0x348EE0E8, 0x19DBB6E3,
-    0x3222184B, 0xB69D5DBA, 0x7E760B88, 0xAF4D8154,
-    0x007A51AD, 0x35112500, 0xC9CD2D7D, 0x4F4FB761,
-    0x694772E3, 0x694C8351, 0x4A7E3AF5, 0x67D65CE1,
-    0x9287DE92, 0x2518DB3C, 0x8CB4EC06, 0xD154D38F,
-    0xE19A26BB, 0x295EE439, 0xC50A1104, 0x2153C6A7,
-    0x82366656, 0x0713BC2F, 0x6462215A, 0x21D9BFCE,
-    0xBA8EACE6, 0xAE2DF4C1, 0x2A8D5E80, 0x3F7E52D1,
-    0x29359399, 0xFEA1D19C, 0x18879313, 0x455AFA81,
-    0xFADFE838, 0x62609838, 0xD1028839, 0x0736E92F,
-    0x3BCA22A3, 0x1485B08A, 0x2DA7900B, 0x852C156D,
-    0xE8F24803, 0x00078472, 0x13F0D332, 0x2ACFD0CF,
-    0x5F747F5C, 0x87BB1E2F, 0xA7EFCB63, 0x23F432F0,
-    0xE6CE7C5C, 0x1F954EF6, 0xB609C91B, 0x3B4571BF,
-    0xEED17DC0, 0xE556CDA0, 0xA7846A8D, 0xFF105F94,
-    0x52B7CCDE, 0x0E33E801, 0x664455EA, 0xF2C70414,
-    0x73E7B486, 0x8F830661, 0x8B59E826, 0xBB8AEDCA,
-    0xF3D70AB9, 0xD739F2B9, 0x4A04C34A, 0x88D0F089,
-    0xE02191A2, 0xD89D9C78, 0x192C2749, 0xFC43A78F,
-    0x0AAC88CB, 0x9438D42D, 0x9E280F7A, 0x36063802,
-    0x38E8D018, 0x1C42A9CB, 0x92AAFF6C, 0xA24820C5,
-    0x007F077F, 0xCE5BC543, 0x69668D58, 0x10D6FF74,
-    0xBE00F621, 0x21300BBE, 0x2E9E8F46, 0x5ACEA629,
-    0xFA1F86C7, 0x52F206B8, 0x3EDF1A75, 0x6DA8D843,
-    0xCF719928, 0x73E3891F, 0xB4B95DD6, 0xB2A42D27,
-    0xEDA20BBF, 0x1A58DBDF, 0xA449AD03, 0x6DDEF22B,
-    0x900531E6, 0x3D3BFF35, 0x5B24ABA2, 0x472B3E4C,
-    0x387F2D75, 0x4D8DBA36, 0x71CB5641, 0xE3473F3F,
-    0xF6CD4B7F, 0xBF7D1428, 0x344B64D0, 0xC5CDFCB6,
-    0xFE2E0182, 0x2C37A673, 0xDE4EB7A3, 0x63FDC933,
-    0x01DC4063, 0x611F3571, 0xD167BFAF, 0x4496596F,
-    0x3DEE0689, 0xD8704910, 0x7052A114, 0x068C9EC5,
-    0x75D0E766, 0x4D54CC20, 0xB44ECDE2, 0x4ABC653E,
-    0x2C550A21, 0x1A52C0DB, 0xCFED03D0, 0x119BAFE2,
-    0x876A6133, 0xBC232088, 0x435BA1B2, 0xAE99BBFA,
-    0xBB4F08E4, 0xA62B5F49, 0x1DA4B695, 0x336B84DE,
-    0xDC813D31, 0x00C134FB, 0x397A98E6, 0x151F0E64,
-    0xD9EB3E69, 0xD3C7DF60, 0xD2F2C336, 0x2DDD067B,
-    0xBD122835, 0xB0B3BD3A, 0xB0D54E46, 0x8641F1E4,
-    0xA0B38F96, 0x51D39199, 0x37A6AD75, 0xDF84EE41,
-    0x3C034CBA, 0xACDA62FC, 0x11923B8B, 0x45EF170A,
-};
-
 using namespace Ogre;
 using namespace RoR;
 
 Collisions::Collisions(Ogre::Vector3 terrn_size):
       forcecam(false)
     , free_eventsource(0)
-    , hashmask(0)
     , landuse(0)
     , m_terrain_size(terrn_size)
     , collision_version(0)
     , forcecampos(Ogre::Vector3::ZERO)
 {
-    for (int i=0; i < HASH_POWER; i++)
-    {
-        hashmask = hashmask << 1;
-        hashmask++;
-    }
-
     loadDefaultModels();
     defaultgm = getGroundModelByString("concrete");
     defaultgroundgm = getGroundModelByString("gravel");
@@ -178,20 +102,20 @@ int Collisions::loadGroundModelsConfigFile(Ogre::String filename)
     parseGroundConfig(&cfg);
 
     // after it was parsed, resolve the dependencies
-    std::map<Ogre::String, ground_model_t>::iterator it;
-    for (it=ground_models.begin(); it!=ground_models.end(); it++)
+    for (ground_model_t& gm: m_ground_models)
     {
-        if (!strlen(it->second.basename)) continue; // no base, normal material
-        String bname = String(it->second.basename);
-        if (ground_models.find(bname) == ground_models.end()) continue; // base not found!
+        if (!strlen(gm.basename)) continue; // no base, normal material
+        ground_model_t *basegm = this->getGroundModelByString(gm.basename);
+        if (!basegm) continue; // base not found!
         // copy the values from the base if not set otherwise
-        ground_model_t *thisgm = &(it->second);
-        ground_model_t *basegm = &ground_models[bname];
-        memcpy(thisgm, basegm, sizeof(ground_model_t));
-        // re-set the name
-        strncpy(thisgm->name, it->first.c_str(), 255);
+        const String name = gm.name;
+        const GroundModelID_t id = gm.gm_id;
+        memcpy(&gm, basegm, sizeof(ground_model_t));
+        // re-set the name and ID
+        strncpy(gm.name, name.c_str(), 255);
+        gm.gm_id = id;
         // after that we need to reload the config to overwrite settings of the base
-        parseGroundConfig(&cfg, it->first);
+        parseGroundConfig(&cfg, name);
     }
     // check the version
     if (this->collision_version != LATEST_GROUND_MODEL_VERSION)
@@ -228,62 +152,66 @@ void Collisions::parseGroundConfig(Ogre::ConfigFile *cfg, String groundModel)
             } else
             {
                 // we assume that all other sections are separate ground types!
-                if (ground_models.find(secName) == ground_models.end())
+                GroundModelID_t gm_id = this->getGroundModelID(secName);
+                if (gm_id == GROUNDMODELID_INVALID)
                 {
                     // ground models not known yet, init it!
-                    ground_models[secName] = ground_model_t();
+                    gm_id = static_cast<GroundModelID_t>(m_ground_models.size());
+                    m_ground_models.emplace_back();
+                    m_ground_model_ids[secName] = gm_id;
                     // clear it
-                    memset(&ground_models[secName], 0, sizeof(ground_model_t));
+                    memset(&m_ground_models[gm_id], 0, sizeof(ground_model_t));
+                    m_ground_models[gm_id].gm_id = gm_id;
                     // set some default values
-                    ground_models[secName].alpha = 2.0f;
-                    ground_models[secName].strength = 1.0f;
+                    m_ground_models[gm_id].alpha = 2.0f;
+                    m_ground_models[gm_id].strength = 1.0f;
                     // some fx defaults
-                    ground_models[secName].fx_particle_amount = 20;
-                    ground_models[secName].fx_particle_min_velo = 5;
-                    ground_models[secName].fx_particle_max_velo = 99999;
-                    ground_models[secName].fx_particle_velo_factor = 0.7f;
-                    ground_models[secName].fx_particle_fade = -1;
-                    ground_models[secName].fx_particle_timedelta = 1;
-                    ground_models[secName].fx_particle_ttl = 2;
-                    strncpy(ground_models[secName].name, secName.c_str(), 255);
+                    m_ground_models[gm_id].fx_particle_amount = 20;
+                    m_ground_models[gm_id].fx_particle_min_velo = 5;
+                    m_ground_models[gm_id].fx_particle_max_velo = 99999;
+                    m_ground_models[gm_id].fx_particle_velo_factor = 0.7f;
+                    m_ground_models[gm_id].fx_particle_fade = -1;
+                    m_ground_models[gm_id].fx_particle_timedelta = 1;
+                    m_ground_models[gm_id].fx_particle_ttl = 2;
+                    strncpy(m_ground_models[gm_id].name, secName.c_str(), 255);
 
                 }
 
-                if (kname == "adhesion velocity") ground_models[secName].va = StringConverter::parseReal(kvalue);
-                else if (kname == "static friction coefficient") ground_models[secName].ms = StringConverter::parseReal(kvalue);
-                else if (kname == "sliding friction coefficient") ground_models[secName].mc = StringConverter::parseReal(kvalue);
-                else if (kname == "hydrodynamic friction") ground_models[secName].t2 = StringConverter::parseReal(kvalue);
-                else if (kname == "stribeck velocity") ground_models[secName].vs = StringConverter::parseReal(kvalue);
-                else if (kname == "alpha") ground_models[secName].alpha = StringConverter::parseReal(kvalue);
-                else if (kname == "strength") ground_models[secName].strength = StringConverter::parseReal(kvalue);
-                else if (kname == "base") strncpy(ground_models[secName].basename, kvalue.c_str(), 255);
+                if (kname == "adhesion velocity") m_ground_models[gm_id].va = StringConverter::parseReal(kvalue);
+                else if (kname == "static friction coefficient") m_ground_models[gm_id].ms = StringConverter::parseReal(kvalue);
+                else if (kname == "sliding friction coefficient") m_ground_models[gm_id].mc = StringConverter::parseReal(kvalue);
+                else if (kname == "hydrodynamic friction") m_ground_models[gm_id].t2 = StringConverter::parseReal(kvalue);
+                else if (kname == "stribeck velocity") m_ground_models[gm_id].vs = StringConverter::parseReal(kvalue);
+                else if (kname == "alpha") m_ground_models[gm_id].alpha = StringConverter::parseReal(kvalue);
+                else if (kname == "strength") m_ground_models[gm_id].strength = StringConverter::parseReal(kvalue);
+                else if (kname == "base") strncpy(m_ground_models[gm_id].basename, kvalue.c_str(), 255);
                 else if (kname == "fx_type")
                 {
                     if (kvalue == "PARTICLE")
-                        ground_models[secName].fx_type = FX_PARTICLE;
+                        m_ground_models[gm_id].fx_type = FX_PARTICLE;
                     else if (kvalue == "HARD")
-                        ground_models[secName].fx_type = FX_HARD;
+                        m_ground_models[gm_id].fx_type = FX_HARD;
                     else if (kvalue == "DUSTY")
-                        ground_models[secName].fx_type = FX_DUSTY;
+                        m_ground_models[gm_id].fx_type = FX_DUSTY;
                     else if (kvalue == "CLUMPY")
-                        ground_models[secName].fx_type = FX_CLUMPY;
+                        m_ground_models[gm_id].fx_type = FX_CLUMPY;
                 }
-                else if (kname == "fx_particle_name") strncpy(ground_models[secName].particle_name, kvalue.c_str(), 255);
-                else if (kname == "fx_colour") ground_models[secName].fx_colour = StringConverter::parseColourValue(kvalue);
-                else if (kname == "fx_particle_amount") ground_models[secName].fx_particle_amount = StringConverter::parseInt(kvalue);
-                else if (kname == "fx_particle_min_velo") ground_models[secName].fx_particle_min_velo = StringConverter::parseReal(kvalue);
-                else if (kname == "fx_particle_max_velo") ground_models[secName].fx_particle_max_velo = StringConverter::parseReal(kvalue);
-                else if (kname == "fx_particle_fade") ground_models[secName].fx_particle_fade = StringConverter::parseReal(kvalue);
-                else if (kname == "fx_particle_timedelta") ground_models[secName].fx_particle_timedelta = StringConverter::parseReal(kvalue);
-                else if (kname == "fx_particle_velo_factor") ground_models[secName].fx_particle_velo_factor = StringConverter::parseReal(kvalue);
-                else if (kname == "fx_particle_ttl") ground_models[secName].fx_particle_ttl = StringConverter::parseReal(kvalue);
-
-
-                else if (kname == "fluid density") ground_models[secName].fluid_density = StringConverter::parseReal(kvalue);
-                else if (kname == "flow consistency index") ground_models[secName].flow_consistency_index = StringConverter::parseReal(kvalue);
-                else if (kname == "flow behavior index") ground_models[secName].flow_behavior_index = StringConverter::parseReal(kvalue);
-                else if (kname == "solid ground level") ground_models[secName].solid_ground_level = StringConverter::parseReal(kvalue);
-                else if (kname == "drag anisotropy") ground_models[secName].drag_anisotropy = StringConverter::parseReal(kvalue);
+                else if (kname == "fx_particle_name") strncpy(m_ground_models[gm_id].particle_name, kvalue.c_str(), 255);
+                else if (kname == "fx_colour") m_ground_models[gm_id].fx_colour = StringConverter::parseColourValue(kvalue);
+                else if (kname == "fx_particle_amount") m_ground_models[gm_id].fx_particle_amount = StringConverter::parseInt(kvalue);
+                else if (kname == "fx_particle_min_velo") m_ground_models[gm_id].fx_particle_min_velo = StringConverter::parseReal(kvalue);
+                else if (kname == "fx_particle_max_velo") m_ground_models[gm_id].fx_particle_max_velo = StringConverter::parseReal(kvalue);
+                else if (kname == "fx_particle_fade") m_ground_models[gm_id].fx_particle_fade = StringConverter::parseReal(kvalue);
+                else if (kname == "fx_particle_timedelta") m_ground_models[gm_id].fx_particle_timedelta = StringConverter::parseReal(kvalue);
+                else if (kname == "fx_particle_velo_factor") m_ground_models[gm_id].fx_particle_velo_factor = StringConverter::parseReal(kvalue);
+                else if (kname == "fx_particle_ttl") m_ground_models[gm_id].fx_particle_ttl = StringConverter::parseReal(kvalue);
+
+
+                else if (kname == "fluid density") m_ground_models[gm_id].fluid_density = StringConverter::parseReal(kvalue);
+                else if (kname == "flow consistency index") m_ground_models[gm_id].flow_consistency_index = StringConverter::parseReal(kvalue);
+                else if (kname == "flow behavior index") m_ground_models[gm_id].flow_behavior_index = StringConverter::parseReal(kvalue);
+                else if (kname == "solid ground level") m_ground_models[gm_id].solid_ground_level = StringConverter::parseReal(kvalue);
+                else if (kname == "drag anisotropy") m_ground_models[gm_id].drag_anisotropy = StringConverter::parseReal(kvalue);
 
             }
         }
@@ -344,12 +272,13 @@ void Collisions::removeCollisionBox(int number)
 {
     if (number > -1 && number < m_collision_boxes.size())
     {
+        if (m_collision_boxes[number].enabled)
+            this->unregisterCollisionBox(number);
         m_collision_boxes[number].enabled = false;
         if (m_collision_boxes[number].eventsourcenum >= 0 && m_collision_boxes[number].eventsourcenum < free_eventsource)
         {
             eventsources[m_collision_boxes[number].eventsourcenum].es_enabled = false;
         }
-        // Is it worth to update the hashmap? ~ ulteq 01/19
     }
 }
 
@@ -357,45 +286,109 @@ void Collisions::removeCollisionTri(int number)
 {
     if (number > -1 && number < m_collision_tris.size())
     {
+        if (m_collision_tris[number].enabled)
+            this->unregisterCollisionTri(number);
         m_collision_tris[number].enabled = false;
-        // Is it worth to update the hashmap? ~ ulteq 01/19
     }
 }
 
-ground_model_t *Collisions::getGroundModelByString(const String name)
+void Collisions::moveCollisionBox(int number, Ogre::Vector3 const& offset)
 {
-    if (!ground_models.size() || ground_models.find(name) == ground_models.end())
-        return 0;
+    if (number < 0 || number >= m_collision_boxes.size() || !m_collision_boxes[number].enabled)
+        return;
 
-    return &ground_models[name];
+    this->unregisterCollisionBox(number);
+    collision_box_t& coll_box = m_collision_boxes[number];
+    coll_box.center += offset;
+    coll_box.lo += offset;
+    coll_box.hi += offset;
+    coll_box.campos += offset;
+    this->registerCollisionBox(number);
 }
 
-unsigned int Collisions::hashfunc(unsigned int cellid)
+int Collisions::moveCollisionTri(int number, Ogre::Vector3 const& offset)
 {
-    unsigned int hash = 0;
-    for (int i=0; i < 4; i++)
+    if (number < 0 || number >= m_collision_tris.size() || !m_collision_tris[number].enabled)
+        return number;
+
+    this->unregisterCollisionTri(number);
+
+    // Tris in the raycast BVH can't move without invalidating its bounds;
+    // they're moved out of it once, later moves update the copy in place.
+    if (number < (int)m_tri_bvh_num_tris)
     {
-        hash ^= sbox[((unsigned char*)&cellid)[i]];
-        hash *= 3;
+        collision_tri_t copy = m_collision_tris[number];
+        m_collision_tris[number].enabled = false;
+        number = (int)m_collision_tris.size();
+        m_collision_tris.push_back(copy);
+    }
+
+    // The coordinate change matrices only depend on the edges, translating keeps them valid
+    collision_tri_t& tri = m_collision_tris[number];
+    tri.a += offset;
+    tri.b += offset;
+    tri.c += offset;
+    tri.aab.setExtents(tri.aab.getMinimum() + offset, tri.aab.getMaximum() + offset);
+    this->registerCollisionTri(number);
+    return number;
+}
+
+GroundModelID_t Collisions::getGroundModelID(std::string const& name) const
+{
+    auto found = m_ground_model_ids.find(name);
+    return (found != m_ground_model_ids.end()) ? found->second : GROUNDMODELID_INVALID;
+}
+
+unsigned int Collisions::hashfunc(int cell_x, int cell_z)
+{
+    // Tile the table over the terrain, so that neighbouring cells are neighbours in memory too.
+    // Cells further apart than the tile size share entries, they're told apart by the cell ID.
+    const unsigned int TILE_BITS = HASH_POWER / 2;
+    const unsigned int TILE_MASK = (1u << TILE_BITS) - 1;
+    return ((static_cast<unsigned int>(cell_x) & TILE_MASK) << TILE_BITS) | (static_cast<unsigned int>(cell_z) & TILE_MASK);
+}
+
+void Collisions::hash_remove(int cell_x, int cell_z, int value)
+{
+    const unsigned int cell_id = (cell_x << 16) + cell_z;
+    hash_bucket_t& bucket = hashtable[hashfunc(cell_x, cell_z)];
+    hash_coll_element_t* elements = m_hash_elements.data() + bucket.begin;
+    for (uint32_t i = 0; i < bucket.size; i++)
+    {
+        if (elements[i].cell_id == cell_id && elements[i].element_index == value)
+        {
+            // Order within a bucket doesn't matter; the cell height is left as an upper bound
+            elements[i] = elements[bucket.size - 1];
+            bucket.size--;
+            return;
+        }
     }
-    return hash&hashmask;
 }
 
 void Collisions::hash_add(int cell_x, int cell_z, int value, float h)
 {
     unsigned int cell_id = (cell_x << 16) + cell_z;
-    unsigned int pos    = hashfunc(cell_id);
+    unsigned int pos    = hashfunc(cell_x, cell_z);
 
-    hashtable[pos].emplace_back(cell_id, value);
+    hash_bucket_t& bucket = hashtable[pos];
+    if (bucket.size == bucket.capacity)
+    {
+        // Move the bucket to the end of the pool, with room to grow
+        const uint32_t new_begin = static_cast<uint32_t>(m_hash_elements.size());
+        bucket.capacity = std::max(4u, bucket.capacity * 2);
+        m_hash_elements.resize(new_begin + bucket.capacity);
+        std::copy(m_hash_elements.begin() + bucket.begin, m_hash_elements.begin() + bucket.begin + bucket.size,
+            m_hash_elements.begin() + new_begin);
+        bucket.begin = new_begin;
+    }
+    m_hash_elements[bucket.begin + bucket.size] = hash_coll_element_t(cell_id, value);
+    bucket.size++;
     hashtable_height[pos] = std::max(hashtable_height[pos], h);
 }
 
 int Collisions::hash_find(int cell_x, int cell_z)
 {
-    unsigned int cellid = (cell_x << 16) + cell_z;
-    unsigned int pos    = hashfunc(cellid);
-
-    return static_cast<int>(pos);
+    return static_cast<int>(hashfunc(cell_x, cell_z));
 }
 
 int Collisions::addCollisionBox(bool rotating, bool virt, Vector3 pos, Ogre::Vector3 rot, Ogre::Vector3 l, Ogre::Vector3 h, Ogre::Vector3 sr, const Ogre::String &eventname, const Ogre::String &instancename, bool forcecam, Ogre::Vector3 campos, Ogre::Vector3 sc /* = Vector3::UNIT_SCALE */, Ogre::Vector3 dr /* = Vector3::ZERO */, CollisionEventFilter event_filter /* = EVENT_ALL */, int scripthandler /* = -1 */)
@@ -525,32 +518,83 @@ int Collisions::addCollisionBox(bool rotating, bool virt, Vector3 pos, Ogre::Vec
         coll_box.debug_verts[7] = coll_box.relo; coll_box.debug_verts[7].x += d.x; coll_box.debug_verts[7].y += d.y; coll_box.debug_verts[7].z += d.z;
     }
 
-    // register this collision box in the index
-    Vector3 ilo = Ogre::Vector3(coll_box.lo / Ogre::Real(CELL_SIZE));
-    Vector3 ihi = Ogre::Vector3(coll_box.hi / Ogre::Real(CELL_SIZE));
-    
+    m_collision_boxes.push_back(coll_box);
+    this->registerCollisionBox(coll_box_index);
+    return coll_box_index;
+}
+
+void Collisions::getCellRange(Ogre::Vector3 const& lo, Ogre::Vector3 const& hi, Ogre::Vector3& out_ilo, Ogre::Vector3& out_ihi)
+{
+    out_ilo = Ogre::Vector3(lo / Ogre::Real(CELL_SIZE));
+    out_ihi = Ogre::Vector3(hi / Ogre::Real(CELL_SIZE));
+
     // clamp between 0 and MAXIMUM_CELL;
-    ilo.makeCeil(Ogre::Vector3(0.0f));
-    ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
-    ihi.makeCeil(Ogre::Vector3(0.0f));
-    ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+    out_ilo.makeCeil(Ogre::Vector3(0.0f));
+    out_ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+    out_ihi.makeCeil(Ogre::Vector3(0.0f));
+    out_ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+}
+
+void Collisions::registerCollisionBox(int box_index)
+{
+    collision_box_t const& coll_box = m_collision_boxes[box_index];
+
+    // register this collision box in the index
+    Vector3 ilo, ihi;
+    this->getCellRange(coll_box.lo, coll_box.hi, ilo, ihi);
 
+    const bool event_only = coll_box.virt && !coll_box.camforced;
     for (int i = ilo.x; i <= ihi.x; i++)
     {
         for (int j = ilo.z; j <= ihi.z; j++)
         {
-            hash_add(i, j, coll_box_index,coll_box.hi.y);
+            if (event_only)
+                m_event_box_cells[(i << 16) + j].push_back(box_index);
+            else
+                hash_add(i, j, box_index, coll_box.hi.y);
         }
     }
 
     m_collision_aab.merge(AxisAlignedBox(coll_box.lo, coll_box.hi));
-    m_collision_boxes.push_back(coll_box);
-    return coll_box_index;
+}
+
+void Collisions::unregisterCollisionBox(int box_index)
+{
+    collision_box_t const& coll_box = m_collision_boxes[box_index];
+
+    // The cells are recomputed from the box, same as when it was registered
+    Vector3 ilo, ihi;
+    this->getCellRange(coll_box.lo, coll_box.hi, ilo, ihi);
+
+    const bool event_only = coll_box.virt && !coll_box.camforced;
+    for (int i = ilo.x; i <= ihi.x; i++)
+    {
+        for (int j = ilo.z; j <= ihi.z; j++)
+        {
+            if (event_only)
+            {
+                auto found = m_event_box_cells.find((i << 16) + j);
+                if (found != m_event_box_cells.end())
+                    found->second.erase(std::remove(found->second.begin(), found->second.end(), box_index), found->second.end());
+            }
+            else
+            {
+                hash_remove(i, j, box_index);
+            }
+        }
+    }
 }
 
 int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model_t* gm)
 {
     int new_tri_index = (int)m_collision_tris.size();
+    m_collision_tris.push_back(makeCollisionTri(p1, p2, p3, gm));
+    this->registerCollisionTri(new_tri_index);
+    return new_tri_index;
+}
+
+collision_tri_t Collisions::makeCollisionTri(Vector3 const& p1, Vector3 const& p2, Vector3 const& p3, ground_model_t* gm)
+{
     collision_tri_t new_tri;
     new_tri.a=p1;
     new_tri.b=p2;
@@ -575,28 +619,42 @@ int Collisions::addCollisionTri(Vector3 p1, Vector3 p2, Vector3 p3, ground_model
     new_tri.aab.merge(p3);
     new_tri.aab.setMinimum(new_tri.aab.getMinimum() - 0.1f);
     new_tri.aab.setMaximum(new_tri.aab.getMaximum() + 0.1f);
-    
+    return new_tri;
+}
+
+void Collisions::registerCollisionTri(int tri_index)
+{
+    collision_tri_t const& new_tri = m_collision_tris[tri_index];
+
     // register this collision tri in the index
-    Ogre::Vector3 ilo(new_tri.aab.getMinimum() / Ogre::Real(CELL_SIZE));
-    Ogre::Vector3 ihi(new_tri.aab.getMaximum() / Ogre::Real(CELL_SIZE));
-    
-    // clamp between 0 and MAXIMUM_CELL;
-    ilo.makeCeil(Ogre::Vector3(0.0f));
-    ilo.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
-    ihi.makeCeil(Ogre::Vector3(0.0f));
-    ihi.makeFloor(Ogre::Vector3(MAXIMUM_CELL));
+    Ogre::Vector3 ilo, ihi;
+    this->getCellRange(new_tri.aab.getMinimum(), new_tri.aab.getMaximum(), ilo, ihi);
     
     for (int i = ilo.x; i <= ihi.x; i++)
     {
         for (int j = ilo.z; j<=ihi.z; j++)
         {
-            hash_add(i, j, new_tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, new_tri.aab.getMaximum().y);
+            hash_add(i, j, tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX, new_tri.aab.getMaximum().y);
         }
     }
 
     m_collision_aab.merge(new_tri.aab);
-    m_collision_tris.push_back(new_tri);
-    return new_tri_index;
+}
+
+void Collisions::unregisterCollisionTri(int tri_index)
+{
+    collision_tri_t const& tri = m_collision_tris[tri_index];
+
+    Ogre::Vector3 ilo, ihi;
+    this->getCellRange(tri.aab.getMinimum(), tri.aab.getMaximum(), ilo, ihi);
+
+    for (int i = ilo.x; i <= ihi.x; i++)
+    {
+        for (int j = ilo.z; j <= ihi.z; j++)
+        {
+            hash_remove(i, j, tri_index + hash_coll_element_t::ELEMENT_TRI_BASE_INDEX);
+        }
+    }
 }
 
 void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
@@ -625,47 +683,84 @@ void Collisions::envokeScriptCallback(collision_box_t *cbox, node_t *node)
 #endif //USE_ANGELSCRIPT
 }
 
-std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
+static bool IntersectsSegmentBox(Vector3 const& origin, Vector3 const& inv_dir, Vector3 const& lo, Vector3 const& hi, float t_max)
 {
-    int steps = ray.getDirection().length() / (float)CELL_SIZE;
-
-    int lhash = -1;
-
-    for (int i = 0; i <= steps; i++)
+    float t_enter = 0.0f;
+    float t_exit = t_max;
+    for (int axis = 0; axis < 3; axis++)
     {
-        Vector3 pos = ray.getPoint((float)i / (float)steps);
-
-        // find the correct cell
-        int refx = (int)(pos.x / (float)CELL_SIZE);
-        int refz = (int)(pos.z / (float)CELL_SIZE);
-        int hash = hash_find(refx, refz);
+        float t_lo = (lo[axis] - origin[axis]) * inv_dir[axis];
+        float t_hi = (hi[axis] - origin[axis]) * inv_dir[axis];
+        if (t_lo > t_hi)
+            std::swap(t_lo, t_hi);
+        t_enter = std::max(t_enter, t_lo);
+        t_exit = std::min(t_exit, t_hi);
+        if (t_enter > t_exit)
+            return false;
+    }
+    return true;
+}
 
-        if (hash == lhash)
-            continue;
+std::pair<bool, Ogre::Real> Collisions::intersectsTris(Ogre::Ray ray)
+{
+    // The ray is a segment: direction is not normalized, hits are accepted up to `ray.getPoint(1.f)`
+    const Vector3 origin = ray.getOrigin();
+    const Vector3 dir = ray.getDirection();
+    const Vector3 inv_dir(1.0f / dir.x, 1.0f / dir.y, 1.0f / dir.z);
 
-        lhash = hash;
+    bool hit = false;
+    float nearest = 1.0f;
 
-        size_t num_elements = hashtable[hash].size();
-        for (size_t k = 0; k < num_elements; k++)
+    if (!m_tri_bvh_nodes.empty())
+    {
+        uint32_t stack[64];
+        int stack_size = 0;
+        stack[stack_size++] = 0;
+        while (stack_size > 0)
         {
-            if (hashtable[hash][k].IsCollisionTri())
+            const uint32_t node_index = stack[--stack_size];
+            const tri_bvh_node_t& node = m_tri_bvh_nodes[node_index];
+            if (!IntersectsSegmentBox(origin, inv_dir, node.lo, node.hi, nearest))
+                continue;
+
+            if (node.count == 0)
             {
-                const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
-                collision_tri_t *ctri = &m_collision_tris[ctri_index];
+                stack[stack_size++] = node.first;
+                stack[stack_size++] = node_index + 1;
+                continue;
+            }
 
-                if (!ctri->enabled)
+            for (uint32_t i = node.first; i < node.first + node.count; i++)
+            {
+                const collision_tri_t& ctri = m_collision_tris[m_tri_bvh_indices[i]];
+                if (!ctri.enabled)
                     continue;
 
-                auto result = Ogre::Math::intersects(ray, ctri->a, ctri->b, ctri->c);
-                if (result.first && result.second < 1.0f)
+                auto result = Ogre::Math::intersects(ray, ctri.a, ctri.b, ctri.c);
+                if (result.first && result.second < nearest)
                 {
-                    return result;
+                    hit = true;
+                    nearest = result.second;
                 }
             }
         }
     }
 
-    return std::make_pair(false, 0.0f);
+    for (size_t i = m_tri_bvh_num_tris; i < m_collision_tris.size(); i++)
+    {
+        const collision_tri_t& ctri = m_collision_tris[i];
+        if (!ctri.enabled || !IntersectsSegmentBox(origin, inv_dir, ctri.aab.getMinimum(), ctri.aab.getMaximum(), nearest))
+            continue;
+
+        auto result = Ogre::Math::intersects(ray, ctri.a, ctri.b, ctri.c);
+        if (result.first && result.second < nearest)
+        {
+            hit = true;
+            nearest = result.second;
+        }
+    }
+
+    return (hit) ? std::make_pair(true, nearest) : std::make_pair(false, 0.0f);
 }
 
 float Collisions::getSurfaceHeight(float x, float z)
@@ -685,12 +780,13 @@ float Collisions::getSurfaceHeightBelow(float x, float z, float height)
     Vector3 origin = Vector3(x, hashtable_height[hash], z);
     Ray ray(origin, -Vector3::UNIT_Y);
 
-    size_t num_elements = hashtable[hash].size();
+    const hash_coll_element_t* elements = hash_elements(hash);
+    size_t num_elements = hashtable[hash].size;
     for (size_t k = 0; k < num_elements; k++)
     {
-        if (hashtable[hash][k].IsCollisionBox())
+        if (elements[k].IsCollisionBox())
         {
-            collision_box_t* cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+            collision_box_t* cbox = &m_collision_boxes[elements[k].element_index];
 
             if (!cbox->enabled)
                 continue;
@@ -736,7 +832,7 @@ float Collisions::getSurfaceHeightBelow(float x, float z, float height)
         }
         else // The element is a triangle
         {
-            const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+            const int ctri_index = elements[k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
             collision_tri_t *ctri = &m_collision_tris[ctri_index];
 
             if (!ctri->enabled)
@@ -770,6 +866,26 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     int refz = (int)(refpos->z / (float)CELL_SIZE);
     int hash = hash_find(refx, refz);
 
+    bool isScriptCallbackEnvoked = false;
+
+    if (envokeScriptCallbacks)
+    {
+        // event-only boxes are not in the hashtable, see `m_event_box_cells`
+        auto found = m_event_box_cells.find((refx << 16) + refz);
+        if (found != m_event_box_cells.end())
+        {
+            for (int cbox_index: found->second)
+            {
+                collision_box_t* cbox = &m_collision_boxes[cbox_index];
+                if (cbox->enabled && cbox->eventsourcenum != -1 && permitEvent(nullptr, cbox->event_filter) && isInside(*refpos, cbox))
+                {
+                    envokeScriptCallback(cbox);
+                    isScriptCallbackEnvoked = true;
+                }
+            }
+        }
+    }
+
     if (refpos->y > hashtable_height[hash])
         return false;
 
@@ -778,14 +894,14 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
     Vector3 minctripoint;
 
     bool contacted = false;
-    bool isScriptCallbackEnvoked = false;
 
-    size_t num_elements = hashtable[hash].size();
+    const hash_coll_element_t* elements = hash_elements(hash);
+    size_t num_elements = hashtable[hash].size;
     for (size_t k = 0; k < num_elements; k++)
     {
-        if (hashtable[hash][k].IsCollisionBox())
+        if (elements[k].IsCollisionBox())
         {
-            collision_box_t* cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+            collision_box_t* cbox = &m_collision_boxes[elements[k].element_index];
 
             if (!cbox->enabled)
                 continue;
@@ -865,7 +981,7 @@ bool Collisions::collisionCorrect(Vector3 *refpos, bool envokeScriptCallbacks)
         }
         else // The element is a triangle
         {
-            const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+            const int ctri_index = elements[k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
             collision_tri_t *ctri = &m_collision_tris[ctri_index];
             if (!ctri->enabled)
                 continue;
@@ -942,16 +1058,17 @@ bool Collisions::nodeCollision(node_t *node, float dt)
     bool contacted = false;
     bool isScriptCallbackEnvoked = false;
 
-    size_t num_elements = hashtable[hash].size();
+    const hash_coll_element_t* elements = hash_elements(hash);
+    size_t num_elements = hashtable[hash].size;
     for (size_t k=0; k < num_elements; k++)
     {
-        if (hashtable[hash][k].cell_id != cell_id)
+        if (elements[k].cell_id != cell_id)
         {
             continue;
         }
-        else if (hashtable[hash][k].IsCollisionBox())
+        else if (elements[k].IsCollisionBox())
         {
-            collision_box_t *cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+            collision_box_t *cbox = &m_collision_boxes[elements[k].element_index];
 
             if (!cbox->enabled)
                 continue;
@@ -1047,7 +1164,7 @@ bool Collisions::nodeCollision(node_t *node, float dt)
         else
         {
             // tri collision
-            const int ctri_index = hashtable[hash][k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
+            const int ctri_index = elements[k].element_index - hash_coll_element_t::ELEMENT_TRI_BASE_INDEX;
             collision_tri_t *ctri = &m_collision_tris[ctri_index];
             if (!ctri->enabled)
                 continue;
@@ -1107,16 +1224,31 @@ void Collisions::findPotentialEventBoxes(Actor* actor, CollisionBoxPtrVec& out_b
             const int hash = this->hash_find(refx, refz);
             const unsigned int cell_id = (refx << 16) + refz;
 
+            // Find eligible event-only boxes in the cell
+            auto found = m_event_box_cells.find(cell_id);
+            if (found != m_event_box_cells.end())
+            {
+                for (int cbox_index: found->second)
+                {
+                    collision_box_t* cbox = &m_collision_boxes[cbox_index];
+                    if (cbox->enabled && cbox->eventsourcenum != -1 && this->permitEvent(actor, cbox->event_filter))
+                    {
+                        out_boxes.push_back(cbox);
+                    }
+                }
+            }
+
             // Find eligible event boxes in the cell
-            for (size_t k = 0; k < hashtable[hash].size(); k++)
+            const hash_coll_element_t* elements = hash_elements(hash);
+            for (size_t k = 0; k < hashtable[hash].size; k++)
             {
-                if (hashtable[hash][k].cell_id != cell_id)
+                if (elements[k].cell_id != cell_id)
                 {
                     continue;
                 }
-                else if (hashtable[hash][k].IsCollisionBox())
+                else if (elements[k].IsCollisionBox())
                 {
-                    collision_box_t* cbox = &m_collision_boxes[hashtable[hash][k].element_index];
+                    collision_box_t* cbox = &m_collision_boxes[elements[k].element_index];
 
                     if (!cbox->enabled)
                         continue;
@@ -1212,10 +1344,21 @@ bool Collisions::isInside(Ogre::Vector3 pos, collision_box_t *cbox, float border
 
 bool Collisions::groundCollision(node_t *node, float dt)
 {
-    Real v = App::GetGameContext()->GetTerrain()->GetHeightAt(node->AbsPosition.x, node->AbsPosition.z);
+    return this->groundCollision(node, dt, App::GetGameContext()->GetTerrain()->GetHeightAt(node->AbsPosition.x, node->AbsPosition.z));
+}
+
+bool Collisions::groundCollision(node_t *node, float dt, float ground_height)
+{
+    ground_model_t* landuse_gm = (landuse && ground_height > node->AbsPosition.y) ? landuse->getGroundModelAt(node->AbsPosition.x, node->AbsPosition.z) : nullptr;
+    return this->groundCollision(node, dt, ground_height, landuse_gm);
+}
+
+bool Collisions::groundCollision(node_t *node, float dt, float ground_height, ground_model_t* landuse_gm)
+{
+    Real v = ground_height;
     if (v > node->AbsPosition.y)
     {
-        ground_model_t* ogm = landuse ? landuse->getGroundModelAt(node->AbsPosition.x, node->AbsPosition.z) : nullptr;
+        ground_model_t* ogm = landuse_gm;
         // when landuse fails or we don't have it, use the default value
         if (!ogm) ogm = defaultgroundgm;
         Ogre::Vector3 normal = App::GetGameContext()->GetTerrain()->GetNormalAt(node->AbsPosition.x, v, node->AbsPosition.z);
@@ -1316,122 +1459,115 @@ void Collisions::createCollisionDebugVisualization(Ogre::SceneNode* root_node, O
 {
     LOG("COLL: Creating collision debug visualization ...");
 
+    // Cells are batched into square blocks - one manual object (with a section per usage material)
+    // and one scene node per block, instead of per cell. Blocks still get distance-culled.
+    const int BLOCK_CELLS = 8;
+    const int block_size = BLOCK_CELLS * CELL_SIZE;
+    const float half = CELL_SIZE / 2.f;
+    std::map<String, std::vector<Ogre::Vector3>> cells_by_material; // Cell centers relative to the block
 
-
-    for (int x=0; x<(int)(m_terrain_size.x); x+=(int)CELL_SIZE)
+    for (int bx=0; bx<(int)(m_terrain_size.x); bx+=block_size)
     {
-        for (int z=0; z<(int)(m_terrain_size.z); z+=(int)CELL_SIZE)
+        for (int bz=0; bz<(int)(m_terrain_size.z); bz+=block_size)
         {
-            
-            if (!area_limit.contains(Ogre::Vector3(x, 0.f, z)))
-                continue;
-
-            int cellx = (int)(x/(float)CELL_SIZE);
-            int cellz = (int)(z/(float)CELL_SIZE);
-            const int hash = hash_find(cellx, cellz);
+            cells_by_material.clear();
+            float min_height = std::numeric_limits<float>::max();
+            float max_height = -std::numeric_limits<float>::max();
 
-            bool used = std::find_if(hashtable[hash].begin(), hashtable[hash].end(), [&](hash_coll_element_t const &c) {
-                    return c.cell_id == (cellx << 16) + cellz;
-            }) != hashtable[hash].end();
-
-            if (used)
+            for (int x=bx; x<bx+block_size && x<(int)(m_terrain_size.x); x+=(int)CELL_SIZE)
             {
-                float groundheight = -9999;
-                float x2 = x+CELL_SIZE;
-                float z2 = z+CELL_SIZE;
+                for (int z=bz; z<bz+block_size && z<(int)(m_terrain_size.z); z+=(int)CELL_SIZE)
+                {
+                    if (!area_limit.contains(Ogre::Vector3(x, 0.f, z)))
+                        continue;
 
-                // find a good ground height for all corners of the cell ...
-                groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x, z));
-                groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x2, z));
-                groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x, z2));
-                groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x2, z2));
-                groundheight += 0.1; // 10 cm hover
+                    int cellx = (int)(x/(float)CELL_SIZE);
+                    int cellz = (int)(z/(float)CELL_SIZE);
+                    const int hash = hash_find(cellx, cellz);
 
-                float percentd = static_cast<float>(hashtable[hash].size()) / static_cast<float>(CELL_BLOCKSIZE);
-                if (percentd > 1) percentd = 1;
+                    const hash_coll_element_t* elements_end = hash_elements(hash) + hashtable[hash].size;
+                    bool used = std::find_if(hash_elements(hash), elements_end, [&](hash_coll_element_t const &c) {
+                            return c.cell_id == (cellx << 16) + cellz;
+                    }) != elements_end;
 
-                // see `RoR::GUI::CollisionsDebug::GenerateCellDebugMaterials()`
-                String matName = "mat-coll-dbg-"+TOSTRING((int)(percentd*100));
-                String cell_name="("+TOSTRING(cellx)+","+ TOSTRING(cellz)+")";
+                    if (!used)
+                        continue;
 
-                ManualObject *mo =  App::GetGfxScene()->GetSceneManager()->createManualObject("collisionDebugVisualization"+cell_name);
-                SceneNode *mo_node = root_node->createChildSceneNode("collisionDebugVisualization_node"+cell_name);
+                    float groundheight = -9999;
+                    float x2 = x+CELL_SIZE;
+                    float z2 = z+CELL_SIZE;
+
+                    // find a good ground height for all corners of the cell ...
+                    groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x, z));
+                    groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x2, z));
+                    groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x, z2));
+                    groundheight = std::max(groundheight, App::GetGameContext()->GetTerrain()->GetHeightAt(x2, z2));
+                    groundheight += 0.1; // 10 cm hover
+
+                    float percentd = static_cast<float>(hashtable[hash].size) / static_cast<float>(CELL_BLOCKSIZE);
+                    if (percentd > 1) percentd = 1;
+
+                    // see `RoR::GUI::CollisionsDebug::GenerateCellDebugMaterials()`
+                    String matName = "mat-coll-dbg-"+TOSTRING((int)(percentd*100));
+                    cells_by_material[matName].push_back(Vector3(x - bx + half, groundheight, z - bz + half));
+                    min_height = std::min(min_height, groundheight);
+                    max_height = std::max(max_height, groundheight);
+                }
+            }
 
-                mo->begin(matName, Ogre::RenderOperation::OT_TRIANGLE_LIST);
+            if (cells_by_material.empty())
+                continue;
 
-                // 1st tri
-                mo->position(-CELL_SIZE/(float)2.0, 0, -CELL_SIZE/(float)2.0);
-                mo->textureCoord(0,0);
+            String block_name="("+TOSTRING(bx/block_size)+","+ TOSTRING(bz/block_size)+")";
+            ManualObject *mo =  App::GetGfxScene()->GetSceneManager()->createManualObject("collisionDebugVisualization"+block_name);
+            SceneNode *mo_node = root_node->createChildSceneNode("collisionDebugVisualization_node"+block_name);
 
-                mo->position(CELL_SIZE/(float)2.0, 0, CELL_SIZE/(float)2.0);
-                mo->textureCoord(1,1);
+            for (auto& entry: cells_by_material)
+            {
+                mo->begin(entry.first, Ogre::RenderOperation::OT_TRIANGLE_LIST);
+                for (Vector3 const& c: entry.second)
+                {
+                    // 1st tri
+                    mo->position(c.x - half, c.y, c.z - half);
+                    mo->textureCoord(0,0);
 
-                mo->position(CELL_SIZE/(float)2.0, 0, -CELL_SIZE/(float)2.0);
-                mo->textureCoord(1,0);
+                    mo->position(c.x + half, c.y, c.z + half);
+                    mo->textureCoord(1,1);
 
-                // 2nd tri
-                mo->position(-CELL_SIZE/(float)2.0, 0, CELL_SIZE/(float)2.0);
-                mo->textureCoord(0,1);
+                    mo->position(c.x + half, c.y, c.z - half);
+                    mo->textureCoord(1,0);
 
-                mo->position(CELL_SIZE/(float)2.0, 0, CELL_SIZE/(float)2.0);
-                mo->textureCoord(1,1);
+                    // 2nd tri
+                    mo->position(c.x - half, c.y, c.z + half);
+                    mo->textureCoord(0,1);
 
-                mo->position(-CELL_SIZE/(float)2.0, 0, -CELL_SIZE/(float)2.0);
-                mo->textureCoord(0,0);
+                    mo->position(c.x + half, c.y, c.z + half);
+                    mo->textureCoord(1,1);
 
+                    mo->position(c.x - half, c.y, c.z - half);
+                    mo->textureCoord(0,0);
+                }
                 mo->end();
-                mo->setBoundingBox(AxisAlignedBox(0, 0, 0, CELL_SIZE, 1, CELL_SIZE));
-                mo->setRenderingDistance(200.f);
-                mo_node->attachObject(mo);
-
-#if 0
-                // setup the label
-                String labelName = "label_"+cell_name;
-                String labelCaption = cell_name+" "+TOSTRING(percent*100,2) + "% usage ("+TOSTRING(cc)+"/"+TOSTRING(CELL_BLOCKSIZE)+") DEEP: " + TOSTRING(deep);
-                MovableText *mt = new MovableText(labelName, labelCaption);
-                mt->setTextAlignment(MovableText::H_CENTER, MovableText::V_ABOVE);
-                mt->setFontName("CyberbitEnglish");
-                mt->setAdditionalHeight(1);
-                mt->setCharacterHeight(0.3);
-                mt->setColor(ColourValue::White);
-                mo_node->attachObject(mt);
-#endif
-
-                mo_node->setVisible(true);
-                mo_node->setPosition(Vector3(x+CELL_SIZE/(float)2.0, groundheight, z+CELL_SIZE/(float)2.0));
-                
-                out_nodes.push_back(mo_node);
             }
+
+            mo->setBoundingBox(AxisAlignedBox(0, min_height, 0, block_size, max_height + 1, block_size));
+            mo->setRenderingDistance(200.f);
+            mo_node->attachObject(mo);
+            mo_node->setVisible(true);
+            mo_node->setPosition(Vector3(bx, 0.f, bz));
+
+            out_nodes.push_back(mo_node);
         }
     }
 }
 
 void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t *gm, std::vector<int> *collTris)
 {
-    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
-    ent->setMaterialName("tracks/debug/collision/mesh");
-
     if (!gm)
     {
         gm = getGroundModelByString("concrete");
     }
 
-    // Analyze the mesh
-    size_t vertex_count,index_count;
-    Vector3* vertices;
-    unsigned* indices;
-
-    getMeshInformation(ent->getMesh().getPointer(),vertex_count,vertices,index_count,indices, pos, q, scale);
-
-    // Generate collision triangles
-    int collision_tri_start = (int)m_collision_tris.size();
-    for (int i=0; i<(int)index_count/3; i++)
-    {
-        int triID = addCollisionTri(vertices[indices[i*3]], vertices[indices[i*3+1]], vertices[indices[i*3+2]], gm);
-        if (collTris)
-            collTris->push_back(triID);
-    }
-
     // Submit the mesh record
     collision_mesh_t rec;
     rec.mesh_name = meshname;
@@ -1440,17 +1576,331 @@ void Collisions::addCollisionMesh(Ogre::String const& srcname, Ogre::String cons
     rec.orientation = q;
     rec.scale = scale;
     rec.ground_model = gm;
-    rec.num_verts = vertex_count;
-    rec.num_indices = index_count;
-    rec.collision_tri_start = collision_tri_start;
-    rec.collision_tri_count = (int)m_collision_tris.size() - collision_tri_start;
-    rec.bounding_box = ent->getMesh()->getBounds();
+
+    queued_collision_mesh_t queued;
+    queued.mesh_record = m_collision_meshes.size();
+    queued.cached_mesh = this->matchCachedCollisionMesh(rec);
+    if (queued.cached_mesh != -1)
+    {
+        collision_mesh_t const& cached = m_cached_collision_meshes[queued.cached_mesh];
+        rec.num_verts = cached.num_verts;
+        rec.num_indices = cached.num_indices;
+        rec.collision_tri_count = cached.collision_tri_count;
+        rec.bounding_box = cached.bounding_box;
+    }
+    else
+    {
+        queued.geometry = this->getCollisionMeshGeometry(meshname);
+        rec.num_verts = (int)queued.geometry->vertices.size();
+        rec.num_indices = (int)queued.geometry->indices.size();
+        rec.collision_tri_count = rec.num_indices / 3;
+        rec.bounding_box = queued.geometry->bounding_box;
+    }
+
+    // Reserve the collision triangles right away, so that their indices don't depend on batching
+    rec.collision_tri_start = (int)m_collision_tris.size();
+    m_collision_tris.resize(rec.collision_tri_start + rec.collision_tri_count);
+    if (collTris)
+    {
+        for (int i = 0; i < rec.collision_tri_count; i++)
+            collTris->push_back(rec.collision_tri_start + i);
+    }
     m_collision_meshes.push_back(rec);
 
+    // Generate collision triangles
+    m_queued_collision_meshes.push_back(queued);
+    if (!m_collision_mesh_batch)
+    {
+        this->buildQueuedCollisionMeshes();
+        m_queued_collision_meshes.clear();
+        m_collision_mesh_geometry.clear();
+    }
+}
+
+void Collisions::beginCollisionMeshBatch(std::string const& cache_path)
+{
+    m_collision_mesh_batch = true;
+    m_collision_mesh_cache_path = cache_path;
+    this->loadCollisionMeshCache();
+}
+
+void Collisions::endCollisionMeshBatch()
+{
+    m_collision_mesh_batch = false;
+
+    // The cache is only good if the very same meshes were added, in the same order
+    const bool cache_hit = !m_cached_collision_meshes.empty() && m_collision_mesh_cache_pos == m_cached_collision_meshes.size();
+    if (!cache_hit)
+    {
+        for (queued_collision_mesh_t& queued : m_queued_collision_meshes)
+        {
+            if (queued.cached_mesh != -1)
+            {
+                queued.geometry = this->getCollisionMeshGeometry(m_collision_meshes[queued.mesh_record].mesh_name);
+                queued.cached_mesh = -1;
+            }
+        }
+    }
+
+    this->buildQueuedCollisionMeshes();
+
+    if (!cache_hit)
+    {
+        this->saveCollisionMeshCache();
+    }
+
+    m_queued_collision_meshes.clear();
+    m_collision_mesh_geometry.clear();
+    m_cached_collision_meshes.clear();
+    m_cached_collision_tris.clear();
+    m_collision_mesh_cache_pos = 0;
+    m_collision_mesh_cache_path = "";
+}
+
+const Collisions::collision_mesh_geometry_t* Collisions::getCollisionMeshGeometry(Ogre::String const& meshname)
+{
+    auto search_res = m_collision_mesh_geometry.find(meshname);
+    if (search_res != m_collision_mesh_geometry.end())
+    {
+        return &search_res->second;
+    }
+
+    Entity *ent = App::GetGfxScene()->GetSceneManager()->createEntity(meshname);
+
+    // Analyze the mesh
+    size_t vertex_count,index_count;
+    Vector3* vertices;
+    unsigned* indices;
+
+    getMeshInformation(ent->getMesh().getPointer(),vertex_count,vertices,index_count,indices);
+
+    collision_mesh_geometry_t& geometry = m_collision_mesh_geometry[meshname];
+    geometry.vertices.assign(vertices, vertices + vertex_count);
+    geometry.indices.assign(indices, indices + index_count);
+    geometry.bounding_box = ent->getMesh()->getBounds();
+
     // Clean up
     delete[] vertices;
     delete[] indices;
     App::GetGfxScene()->GetSceneManager()->destroyEntity(ent);
+    return &geometry;
+}
+
+void Collisions::buildQueuedCollisionMeshes()
+{
+    // Triangles only depend on their own mesh instance; the lookup must be filled in order
+    App::GetThreadPool()->ParallelFor(m_queued_collision_meshes.size(), [this](size_t i)
+    {
+        queued_collision_mesh_t const& queued = m_queued_collision_meshes[i];
+        collision_mesh_t const& rec = m_collision_meshes[queued.mesh_record];
+        if (queued.cached_mesh != -1)
+        {
+            collision_mesh_t const& cached = m_cached_collision_meshes[queued.cached_mesh];
+            for (int j = 0; j < rec.collision_tri_count; j++)
+            {
+                collision_tri_t& tri = m_collision_tris[rec.collision_tri_start + j];
+                tri = m_cached_collision_tris[cached.collision_tri_start + j];
+                tri.gm = rec.ground_model;
+                tri.enabled = true;
+            }
+            return;
+        }
+
+        std::vector<Vector3> vertices(queued.geometry->vertices.size());
+        for (size_t j = 0; j < vertices.size(); j++)
+        {
+            vertices[j] = (rec.orientation * (queued.geometry->vertices[j] * rec.scale)) + rec.position;
+        }
+
+        std::vector<unsigned> const& indices = queued.geometry->indices;
+        for (int j = 0; j < rec.collision_tri_count; j++)
+        {
+            m_collision_tris[rec.collision_tri_start + j] = makeCollisionTri(
+                vertices[indices[j*3]], vertices[indices[j*3+1]], vertices[indices[j*3+2]], rec.ground_model);
+        }
+    });
+
+    for (queued_collision_mesh_t const& queued : m_queued_collision_meshes)
+    {
+        collision_mesh_t const& rec = m_collision_meshes[queued.mesh_record];
+        for (int i = 0; i < rec.collision_tri_count; i++)
+        {
+            this->registerCollisionTri(rec.collision_tri_start + i);
+        }
+    }
+}
+
+// Collision mesh cache file: signature, version, mesh count, then for each mesh
+// its record (see `writeCollisionMeshRecord()`) followed by its world-space tris.
+
+static const char*    COLLMESH_CACHE_SIGNATURE = "RoR CollMesh";
+static const uint32_t COLLMESH_CACHE_VERSION   = 1;
+
+template <typename T> static bool ReadCacheValue(FILE* f, T& value) { return fread(&value, sizeof(T), 1, f) == 1; }
+template <typename T> static void WriteCacheValue(FILE* f, T const& value) { fwrite(&value, sizeof(T), 1, f); }
+
+static bool ReadCacheString(FILE* f, std::string& str)
+{
+    uint32_t len = 0;
+    if (!ReadCacheValue(f, len) || len > 1000)
+        return false;
+    str.resize(len);
+    return len == 0 || fread(&str[0], 1, len, f) == len;
+}
+
+static void WriteCacheString(FILE* f, std::string const& str)
+{
+    WriteCacheValue(f, (uint32_t)str.size());
+    fwrite(str.data(), 1, str.size(), f);
+}
+
+static bool ReadCacheBox(FILE* f, AxisAlignedBox& box)
+{
+    int32_t extent = 0;
+    Vector3 min, max;
+    if (!ReadCacheValue(f, extent) || !ReadCacheValue(f, min) || !ReadCacheValue(f, max))
+        return false;
+    switch (extent)
+    {
+    case AxisAlignedBox::EXTENT_FINITE:   box.setExtents(min, max); break;
+    case AxisAlignedBox::EXTENT_INFINITE: box.setInfinite();        break;
+    default:                              box.setNull();
+    }
+    return true;
+}
+
+static void WriteCacheBox(FILE* f, AxisAlignedBox const& box)
+{
+    WriteCacheValue(f, (int32_t)box.getExtent());
+    WriteCacheValue(f, (box.isFinite()) ? box.getMinimum() : Vector3::ZERO);
+    WriteCacheValue(f, (box.isFinite()) ? box.getMaximum() : Vector3::ZERO);
+}
+
+void Collisions::loadCollisionMeshCache()
+{
+    m_cached_collision_meshes.clear();
+    m_cached_collision_tris.clear();
+    m_collision_mesh_cache_pos = 0;
+    if (m_collision_mesh_cache_path.empty())
+    {
+        return;
+    }
+
+    FILE* f = fopen(m_collision_mesh_cache_path.c_str(), "rb");
+    if (f == nullptr)
+    {
+        return; // Not created yet
+    }
+
+    bool ok = true;
+    char signature[32] = {};
+    uint32_t version = 0, num_meshes = 0;
+    ok = fread(signature, 1, strlen(COLLMESH_CACHE_SIGNATURE), f) == strlen(COLLMESH_CACHE_SIGNATURE)
+        && strncmp(signature, COLLMESH_CACHE_SIGNATURE, strlen(COLLMESH_CACHE_SIGNATURE)) == 0
+        && ReadCacheValue(f, version) && version == COLLMESH_CACHE_VERSION
+        && ReadCacheValue(f, num_meshes);
+
+    for (uint32_t i = 0; ok && i < num_meshes; i++)
+    {
+        collision_mesh_t rec;
+        std::string gm_name;
+        int32_t num_verts = 0, num_indices = 0, num_tris = 0;
+        ok = ReadCacheString(f, rec.mesh_name)
+            && ReadCacheValue(f, rec.position) && ReadCacheValue(f, rec.orientation) && ReadCacheValue(f, rec.scale)
+            && ReadCacheString(f, gm_name)
+            && ReadCacheValue(f, num_verts) && ReadCacheValue(f, num_indices) && ReadCacheValue(f, num_tris) && num_tris >= 0
+            && ReadCacheBox(f, rec.bounding_box);
+        rec.ground_model = this->getGroundModelByString(gm_name); // The cache stores names, IDs depend on the terrain's configs
+        rec.num_verts = num_verts;
+        rec.num_indices = num_indices;
+        rec.collision_tri_start = (int)m_cached_collision_tris.size();
+        rec.collision_tri_count = num_tris;
+
+        for (int32_t j = 0; ok && j < num_tris; j++)
+        {
+            collision_tri_t tri;
+            Vector3 aab_min, aab_max;
+            ok = ReadCacheValue(f, tri.a) && ReadCacheValue(f, tri.b) && ReadCacheValue(f, tri.c)
+                && ReadCacheValue(f, aab_min) && ReadCacheValue(f, aab_max)
+                && ReadCacheValue(f, tri.forward) && ReadCacheValue(f, tri.reverse);
+            tri.aab.setExtents(aab_min, aab_max);
+            tri.gm = nullptr;
+            tri.enabled = true;
+            m_cached_collision_tris.push_back(tri);
+        }
+        m_cached_collision_meshes.push_back(rec);
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        LOG(fmt::format("[RoR|Collisions] Ignoring invalid collision mesh cache '{}'", m_collision_mesh_cache_path));
+        m_cached_collision_meshes.clear();
+        m_cached_collision_tris.clear();
+    }
+}
+
+void Collisions::saveCollisionMeshCache()
+{
+    if (m_collision_mesh_cache_path.empty() || m_queued_collision_meshes.empty())
+    {
+        return;
+    }
+
+    FILE* f = fopen(m_collision_mesh_cache_path.c_str(), "wb");
+    if (f == nullptr)
+    {
+        LOG(fmt::format("[RoR|Collisions] Cannot write collision mesh cache '{}'", m_collision_mesh_cache_path));
+        return;
+    }
+
+    fwrite(COLLMESH_CACHE_SIGNATURE, 1, strlen(COLLMESH_CACHE_SIGNATURE), f);
+    WriteCacheValue(f, COLLMESH_CACHE_VERSION);
+    WriteCacheValue(f, (uint32_t)m_queued_collision_meshes.size());
+    for (queued_collision_mesh_t const& queued : m_queued_collision_meshes)
+    {
+        collision_mesh_t const& rec = m_collision_meshes[queued.mesh_record];
+        WriteCacheString(f, rec.mesh_name);
+        WriteCacheValue(f, rec.position);
+        WriteCacheValue(f, rec.orientation);
+        WriteCacheValue(f, rec.scale);
+        WriteCacheString(f, rec.ground_model->name);
+        WriteCacheValue(f, (int32_t)rec.num_verts);
+        WriteCacheValue(f, (int32_t)rec.num_indices);
+        WriteCacheValue(f, (int32_t)rec.collision_tri_count);
+        WriteCacheBox(f, rec.bounding_box);
+
+        for (int i = 0; i < rec.collision_tri_count; i++)
+        {
+            collision_tri_t const& tri = m_collision_tris[rec.collision_tri_start + i];
+            WriteCacheValue(f, tri.a);
+            WriteCacheValue(f, tri.b);
+            WriteCacheValue(f, tri.c);
+            WriteCacheValue(f, tri.aab.getMinimum());
+            WriteCacheValue(f, tri.aab.getMaximum());
+            WriteCacheValue(f, tri.forward);
+            WriteCacheValue(f, tri.reverse);
+        }
+    }
+    fclose(f);
+}
+
+int Collisions::matchCachedCollisionMesh(collision_mesh_t const& rec)
+{
+    if (m_collision_mesh_cache_pos >= m_cached_collision_meshes.size())
+    {
+        return -1;
+    }
+
+    collision_mesh_t const& cached = m_cached_collision_meshes[m_collision_mesh_cache_pos];
+    if (cached.mesh_name != rec.mesh_name || cached.position != rec.position || cached.orientation != rec.orientation ||
+        cached.scale != rec.scale || cached.ground_model != rec.ground_model)
+    {
+        // Something changed; stop consulting the cache, the batch will be built from the meshes and saved again
+        m_collision_mesh_cache_pos = m_cached_collision_meshes.size() + 1;
+        return -1;
+    }
+    return (int)m_collision_mesh_cache_pos++;
 }
 
 void Collisions::registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count)
@@ -1585,4 +2035,81 @@ void Collisions::getMeshInformation(Mesh* mesh,size_t &vertex_count,Ogre::Vector
 
 void Collisions::finishLoadingTerrain()
 {
+    // Pack the buckets in table order; drops the slack left by growing buckets during load
+    // and keeps elements of neighbouring cells close together. Elements added later (i.e. by scripts)
+    // are appended to the pool as usual.
+    size_t num_elements = 0;
+    for (const hash_bucket_t& bucket: hashtable)
+    {
+        num_elements += bucket.size;
+    }
+
+    std::vector<hash_coll_element_t> packed;
+    packed.reserve(num_elements);
+    for (hash_bucket_t& bucket: hashtable)
+    {
+        const uint32_t begin = static_cast<uint32_t>(packed.size());
+        packed.insert(packed.end(), m_hash_elements.begin() + bucket.begin, m_hash_elements.begin() + bucket.begin + bucket.size);
+        bucket.begin = begin;
+        bucket.capacity = bucket.size;
+    }
+    m_hash_elements.swap(packed);
+
+    this->buildTriBvh();
+}
+
+void Collisions::buildTriBvh()
+{
+    m_tri_bvh_nodes.clear();
+    m_tri_bvh_indices.resize(m_collision_tris.size());
+    m_tri_bvh_num_tris = m_collision_tris.size();
+    if (m_collision_tris.empty())
+        return;
+
+    std::vector<Vector3> centroids(m_collision_tris.size());
+    for (size_t i = 0; i < m_collision_tris.size(); i++)
+    {
+        const collision_tri_t& ctri = m_collision_tris[i];
+        centroids[i] = (ctri.a + ctri.b + ctri.c) / 3.0f;
+        m_tri_bvh_indices[i] = static_cast<int>(i);
+    }
+
+    m_tri_bvh_nodes.reserve(2 * m_collision_tris.size() / TRI_BVH_LEAF_SIZE + 1);
+    this->buildTriBvhNode(centroids, 0, static_cast<uint32_t>(m_collision_tris.size()));
+}
+
+uint32_t Collisions::buildTriBvhNode(std::vector<Ogre::Vector3> const& centroids, uint32_t begin, uint32_t end)
+{
+    const uint32_t node_index = static_cast<uint32_t>(m_tri_bvh_nodes.size());
+    m_tri_bvh_nodes.emplace_back();
+
+    AxisAlignedBox bounds;
+    AxisAlignedBox centroid_bounds;
+    for (uint32_t i = begin; i < end; i++)
+    {
+        bounds.merge(m_collision_tris[m_tri_bvh_indices[i]].aab);
+        centroid_bounds.merge(centroids[m_tri_bvh_indices[i]]);
+    }
+    m_tri_bvh_nodes[node_index].lo = bounds.getMinimum();
+    m_tri_bvh_nodes[node_index].hi = bounds.getMaximum();
+
+    // Split along the longest axis of the centroids, at the median
+    const Vector3 extent = centroid_bounds.getSize();
+    const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : ((extent.y >= extent.z) ? 1 : 2);
+    if (end - begin <= TRI_BVH_LEAF_SIZE || extent[axis] <= 0.0f)
+    {
+        m_tri_bvh_nodes[node_index].first = begin;
+        m_tri_bvh_nodes[node_index].count = end - begin;
+        return node_index;
+    }
+
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(m_tri_bvh_indices.begin() + begin, m_tri_bvh_indices.begin() + mid, m_tri_bvh_indices.begin() + end,
+        [&centroids, axis](int lhs, int rhs) { return centroids[lhs][axis] < centroids[rhs][axis]; });
+
+    this->buildTriBvhNode(centroids, begin, mid); // First child directly follows
+    const uint32_t second = this->buildTriBvhNode(centroids, mid, end);
+    m_tri_bvh_nodes[node_index].first = second;
+    m_tri_bvh_nodes[node_index].count = 0;
+    return node_index;
 }
@@ -25,9 +25,11 @@
 #include "Application.h"
 #include "SimData.h" // for collision_box_t
 
+#include <deque>
 #include <mutex>
 #include <Ogre.h>
 #include <string>
+#include <unordered_map>
 
 namespace RoR {
 
@@ -101,10 +103,12 @@ private:
     /// -------------------------------------
     /// Terrain is split into equal-size 'cells' of dimension CELL_SIZE, identified by CellID
     /// A hash table aggregates elements from multiple cells in one entry
+    /// All elements are stored in one pool (`m_hash_elements`), each table entry is a range in it.
     struct hash_coll_element_t
     {
         static const int ELEMENT_TRI_BASE_INDEX = 1000000; // Effectively a maximum number of collision boxes
 
+        inline hash_coll_element_t(): cell_id(0), element_index(0) {}
         inline hash_coll_element_t(unsigned int cell_id_, int value): cell_id(cell_id_), element_index(value) {}
 
         inline bool IsCollisionBox() const { return element_index < ELEMENT_TRI_BASE_INDEX; }
@@ -117,8 +121,18 @@ private:
         int element_index;
     };
 
+    /// A range of `m_hash_elements`. While loading, a bucket which runs out of capacity is moved to the end of the pool;
+    /// `finishLoadingTerrain()` then packs all buckets tightly in table order.
+    struct hash_bucket_t
+    {
+        uint32_t begin = 0;
+        uint32_t size = 0;
+        uint32_t capacity = 0;
+    };
+
     static const int LATEST_GROUND_MODEL_VERSION = 3;
     static const int MAX_EVENT_SOURCE = 500;
+    static const uint32_t TRI_BVH_LEAF_SIZE = 4;
 
     // this is a power of two, change with caution
     static const int HASH_POWER = 20;
@@ -140,10 +154,16 @@ private:
 
     // collision hashtable
     std::array<float, HASH_SIZE> hashtable_height;
-    std::vector<hash_coll_element_t> hashtable[HASH_SIZE];
+    std::array<hash_bucket_t, HASH_SIZE> hashtable;
+    std::vector<hash_coll_element_t> m_hash_elements;
 
-    // ground models
-    std::map<Ogre::String, ground_model_t> ground_models;
+    // virtual event boxes which don't force the camera only generate events - they're kept out of the
+    // hashtable so that they don't slow down node collisions; see `addCollisionBox()`
+    std::unordered_map<unsigned int, std::vector<int>> m_event_box_cells; //!< CellID -> indices to `m_collision_boxes`
+
+    // ground models; the ID is the index to `m_ground_models`, names are only used by config files and scripts
+    std::deque<ground_model_t> m_ground_models; // Deque keeps the pointers held by tris/nodes valid when terrain configs add more models
+    std::unordered_map<std::string, GroundModelID_t> m_ground_model_ids;
 
     // event sources
     eventsource_t eventsources[MAX_EVENT_SOURCE];
@@ -153,17 +173,71 @@ private:
 
     Landusemap* landuse;
     int collision_version;
-    unsigned int hashmask;
 
     const Ogre::Vector3 m_terrain_size;
 
     void hash_add(int cell_x, int cell_z, int value, float h);
+    void hash_remove(int cell_x, int cell_z, int value);
     int hash_find(int cell_x, int cell_z); /// Returns index to 'hashtable'
-    unsigned int hashfunc(unsigned int cellid);
+    unsigned int hashfunc(int cell_x, int cell_z);
+    const hash_coll_element_t* hash_elements(int hash) const { return m_hash_elements.data() + hashtable[hash].begin; }
     void parseGroundConfig(Ogre::ConfigFile* cfg, Ogre::String groundModel = "");
 
     Ogre::Vector3 calcCollidedSide(const Ogre::Vector3& pos, const Ogre::Vector3& lo, const Ogre::Vector3& hi);
 
+    // collision mesh building, see `beginCollisionMeshBatch()`
+    struct collision_mesh_geometry_t //!< Mesh-space, read from the mesh once per batch
+    {
+        std::vector<Ogre::Vector3> vertices;
+        std::vector<unsigned> indices;
+        Ogre::AxisAlignedBox bounding_box;
+    };
+
+    struct queued_collision_mesh_t
+    {
+        size_t mesh_record = 0; //!< Index to `m_collision_meshes`; slots in `m_collision_tris` are reserved when queued
+        const collision_mesh_geometry_t* geometry = nullptr;
+        int cached_mesh = -1;   //!< Index to `m_cached_collision_meshes`, the tris are copied instead of built
+    };
+
+    std::unordered_map<std::string, collision_mesh_geometry_t> m_collision_mesh_geometry;
+    std::vector<queued_collision_mesh_t> m_queued_collision_meshes;
+    bool m_collision_mesh_batch = false;
+
+    // collision mesh cache, see `beginCollisionMeshBatch()`
+    std::string m_collision_mesh_cache_path;
+    CollisionMeshVec m_cached_collision_meshes; //!< `collision_tri_start` indexes `m_cached_collision_tris`
+    CollisionTriVec m_cached_collision_tris;
+    size_t m_collision_mesh_cache_pos = 0;      //!< Next cached mesh expected to be added; past the end once the cache is outdated
+
+    const collision_mesh_geometry_t* getCollisionMeshGeometry(Ogre::String const& meshname);
+    void buildQueuedCollisionMeshes();
+    void loadCollisionMeshCache();
+    void saveCollisionMeshCache();
+    int matchCachedCollisionMesh(collision_mesh_t const& rec); //!< Returns index to `m_cached_collision_meshes` or -1
+
+    // static triangle BVH for raycasts, built by `finishLoadingTerrain()`; see `intersectsTris()`
+    struct tri_bvh_node_t
+    {
+        Ogre::Vector3 lo;
+        Ogre::Vector3 hi;
+        uint32_t first = 0; //!< Leaf: index to `m_tri_bvh_indices`; inner node: index of the second child (the first child directly follows)
+        uint32_t count = 0; //!< Number of tris in a leaf, 0 for inner nodes
+    };
+
+    std::vector<tri_bvh_node_t> m_tri_bvh_nodes;
+    std::vector<int> m_tri_bvh_indices;         //!< Indices to `m_collision_tris`, grouped by leaf
+    size_t m_tri_bvh_num_tris = 0;              //!< Tris added later (i.e. by scripts) are tested one by one
+
+    void buildTriBvh();
+    uint32_t buildTriBvhNode(std::vector<Ogre::Vector3> const& centroids, uint32_t begin, uint32_t end); //!< Returns index to `m_tri_bvh_nodes`
+    static collision_tri_t makeCollisionTri(Ogre::Vector3 const& p1, Ogre::Vector3 const& p2, Ogre::Vector3 const& p3, ground_model_t* gm);
+    void registerCollisionTri(int tri_index); //!< Adds an already built tri to the lookup
+    void unregisterCollisionTri(int tri_index); //!< Removes a tri from the lookup; its cells are recomputed from `aab`
+    void registerCollisionBox(int box_index);
+    void unregisterCollisionBox(int box_index);
+    static void getCellRange(Ogre::Vector3 const& lo, Ogre::Vector3 const& hi, Ogre::Vector3& out_ilo, Ogre::Vector3& out_ihi);
+
 public:
 
     // how many elements per cell? power of 2 minus 2 is better
@@ -183,6 +257,8 @@ public:
     float getSurfaceHeightBelow(float x, float z, float height);
     bool collisionCorrect(Ogre::Vector3* refpos, bool envokeScriptCallbacks = true);
     bool groundCollision(node_t* node, float dt);
+    bool groundCollision(node_t* node, float dt, float ground_height); //!< With terrain height already known, see `Terrain::GetHeightsAt()`
+    bool groundCollision(node_t* node, float dt, float ground_height, ground_model_t* landuse_gm); //!< With landuse already known too, see `Landusemap::getGroundModelsAt()`
     bool isInside(Ogre::Vector3 pos, const Ogre::String& inst, const Ogre::String& box, float border = 0);
     bool isInside(Ogre::Vector3 pos, collision_box_t* cbox, float border = 0);
     bool nodeCollision(node_t* node, float dt);
@@ -195,9 +271,15 @@ public:
     void addCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::Quaternion const& q, Ogre::Vector3 const& scale, ground_model_t* gm = 0, std::vector<int>* collTris = 0); //!< generate collision tris from existing mesh resource
     void registerCollisionMesh(Ogre::String const& srcname, Ogre::String const& meshname, Ogre::Vector3 const& pos, Ogre::AxisAlignedBox bounding_box, ground_model_t* gm, int ctri_start, int ctri_count); //!< Mark already generated collision tris as belonging to (virtual) mesh.
     int addCollisionTri(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, ground_model_t* gm);
+    /// Until `endCollisionMeshBatch()`, collision meshes are only queued (tri indices are final) and then built together on the thread pool.
+    /// @param cache_path Binary file with the world-space tris of the batch; if the same meshes are added again, they're read from it instead of the meshes.
+    void beginCollisionMeshBatch(std::string const& cache_path = "");
+    void endCollisionMeshBatch();
     void createCollisionDebugVisualization(Ogre::SceneNode* root_node, Ogre::AxisAlignedBox const& area_limit, std::vector<Ogre::SceneNode*>& out_nodes);
     void removeCollisionBox(int number);
     void removeCollisionTri(int number);
+    void moveCollisionBox(int number, Ogre::Vector3 const& offset);
+    int  moveCollisionTri(int number, Ogre::Vector3 const& offset); //!< Returns the new index of the tri; tris in the raycast BVH are moved out of it
     void clearEventCache() { m_last_called_cboxes.clear(); }
 
     Ogre::AxisAlignedBox getCollisionAAB() { return m_collision_aab; };
@@ -205,9 +287,11 @@ public:
     // ground models things
     int loadDefaultModels();
     int loadGroundModelsConfigFile(Ogre::String filename);
-    std::map<Ogre::String, ground_model_t>* getGroundModels() { return &ground_models; };
+    size_t getNumGroundModels() const { return m_ground_models.size(); }
+    ground_model_t* getGroundModel(GroundModelID_t id) { return (id >= 0 && id < (int)m_ground_models.size()) ? &m_ground_models[id] : nullptr; }
+    GroundModelID_t getGroundModelID(std::string const& name) const; //!< For configs and scripts; per-frame code should keep the ID or pointer
     void setupLandUse(const char* configfile);
-    ground_model_t* getGroundModelByString(const Ogre::String name);
+    ground_model_t* getGroundModelByString(const Ogre::String name) { return this->getGroundModel(this->getGroundModelID(name)); }
 
     void getMeshInformation(Ogre::Mesh* mesh, size_t& vertex_count, Ogre::Vector3* & vertices,
         size_t& index_count, unsigned* & indices,
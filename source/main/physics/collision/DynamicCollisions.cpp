@@ -24,6 +24,7 @@
 #include "Application.h"
 #include "Actor.h"
 #include "SimData.h"
+#include "CabTriangleBvh.h"
 #include "CartesianToTriangleTransform.h"
 #include "Collisions.h"
 #include "GameContext.h"
@@ -115,12 +116,124 @@ void ResolveCollisionForces(const float penetration_depth,
 }
 
 
+/// Test one contacter of another actor against a cab triangle and resolve the collision; returns true on contact.
+static bool ResolveInterActorHit(const float dt, const Triangle &triangle, const CartesianToTriangleTransform &transform,
+        node_t &na, node_t &nb, node_t &no,
+        Actor* hit_actor, const NodeNum_t hitnode_num,
+        const float collrange,
+        ground_model_t &submesh_ground_model)
+{
+    node_t& hitnode = hit_actor->ar_nodes[hitnode_num];
+
+    // transform point to triangle local coordinates
+    const auto local_point = transform(hitnode.AbsPosition);
+
+    // collision test
+    if (!InsideTriangleTest(local_point, collrange))
+    {
+        return false;
+    }
+
+    const auto coord = local_point.barycentric;
+    auto distance   = local_point.distance;
+    auto normal     = triangle.normal();
+
+    // adapt in case the collision is occuring on the backface of the triangle
+    const auto& neighbour_node_ids = hit_actor->ar_node_to_node_connections[hitnode_num];
+    const bool is_backface = BackfaceCollisionTest(distance, normal, no, neighbour_node_ids, hit_actor->ar_nodes);
+    if (is_backface)
+    {
+        // flip surface normal and distance to triangle plane
+        normal   = -normal;
+        distance = -distance;
+    }
+
+    const auto penetration_depth = collrange - distance;
+
+    const bool remote = (hit_actor->ar_state == ActorState::NETWORKED_OK);
+
+    ResolveCollisionForces(penetration_depth, hitnode, na, nb, no, coord.alpha,
+            coord.beta, coord.gamma, normal, dt, remote, submesh_ground_model);
+
+    hitnode.nd_last_collision_gm = &submesh_ground_model;
+    hitnode.nd_has_mesh_contact = true;
+    na.nd_has_mesh_contact = true;
+    nb.nd_has_mesh_contact = true;
+    no.nd_has_mesh_contact = true;
+    return true;
+}
+
+/// Test one of the actor's own contacters against its cab triangle and resolve the collision; returns true on contact.
+static bool ResolveIntraActorHit(const float dt, const Triangle &triangle, const CartesianToTriangleTransform &transform,
+        node_t &na, node_t &nb, node_t &no, node_t &hitnode,
+        const float collrange,
+        ground_model_t &submesh_ground_model)
+{
+    //ignore wheel/chassis self contact
+    if (hitnode.nd_tyre_node) return false;
+    if (&no == &hitnode || &na == &hitnode || &nb == &hitnode) return false;
+
+    // transform point to triangle local coordinates
+    const auto local_point = transform(hitnode.AbsPosition);
+
+    // collision test
+    if (!InsideTriangleTest(local_point, collrange))
+    {
+        return false;
+    }
+
+    const auto coord = local_point.barycentric;
+    auto distance = local_point.distance;
+    auto normal   = triangle.normal();
+
+    // adapt in case the collision is occuring on the backface of the triangle
+    if (distance < 0) 
+    {
+        // flip surface normal and distance to triangle plane
+        normal   = -normal;
+        distance = -distance;
+    }
+
+    const auto penetration_depth = collrange - distance;
+
+    ResolveCollisionForces(penetration_depth, hitnode, na, nb, no, coord.alpha,
+            coord.beta, coord.gamma, normal, dt, false, submesh_ground_model);
+    return true;
+}
+
+
 void RoR::ResolveInterActorCollisions(const float dt, PointColDetector &interPointCD,
         const int free_collcab, int collcabs[], int cabs[],
         collcab_rate_t inter_collcabrate[], node_t nodes[],
         const float collrange,
-        ground_model_t &submesh_ground_model)
+        ground_model_t &submesh_ground_model,
+        CabTriangleBvh* bvh)
 {
+    if (bvh != nullptr)
+    {
+        // Every triangle near a contacter is tested every step, no rate limiting needed
+        bvh->Update(free_collcab, collcabs, cabs, nodes);
+        bvh->ForEachCandidate(interPointCD, collrange, [&](int i, const std::vector<PointidID_t>& hits)
+            {
+                int tmpv = collcabs[i]*3;
+                node_t& no = nodes[cabs[tmpv]];
+                node_t& na = nodes[cabs[tmpv+1]];
+                node_t& nb = nodes[cabs[tmpv+2]];
+
+                // setup transformation of points to triangle local coordinates
+                const Triangle triangle(na.AbsPosition, nb.AbsPosition, no.AbsPosition);
+                const CartesianToTriangleTransform transform(triangle);
+
+                for (PointidID_t h : hits)
+                {
+                    ResolveInterActorHit(dt, triangle, transform, na, nb, no,
+                        interPointCD.getPointActor(h), interPointCD.hit_pointid_list[h].nodenum,
+                        collrange, submesh_ground_model);
+                }
+            });
+        return;
+    }
+
     for (int i=0; i<free_collcab; i++)
     {
         if (inter_collcabrate[i].rate > 0)
@@ -157,44 +270,11 @@ void RoR::ResolveInterActorCollisions(const float dt, PointColDetector &interPoi
                     if (interPointCD.hit_pointid_list[h].actorid != actorid)
                         continue;
 
-                    NodeNum_t hitnode_num = interPointCD.hit_pointid_list[h].nodenum;
-                    node_t& hitnode = hit_actor->ar_nodes[hitnode_num];
-
-                    // transform point to triangle local coordinates
-                    const auto local_point = transform(hitnode.AbsPosition);
-
-                    // collision test
-                    const bool is_colliding = InsideTriangleTest(local_point, collrange);
-                    if (is_colliding)
+                    if (ResolveInterActorHit(dt, triangle, transform, *na, *nb, *no,
+                            hit_actor.GetRef(), interPointCD.hit_pointid_list[h].nodenum,
+                            collrange, submesh_ground_model))
                     {
                         inter_collcabrate[i].rate = 0;
-
-                        const auto coord = local_point.barycentric;
-                        auto distance   = local_point.distance;
-                        auto normal     = triangle.normal();
-
-                        // adapt in case the collision is occuring on the backface of the triangle
-                        const auto neighbour_node_ids = hit_actor->ar_node_to_node_connections[hitnode_num];
-                        const bool is_backface = BackfaceCollisionTest(distance, normal, *no, neighbour_node_ids, hit_actor->ar_nodes);
-                        if (is_backface)
-                        {
-                            // flip surface normal and distance to triangle plane
-                            normal   = -normal;
-                            distance = -distance;
-                        }
-
-                        const auto penetration_depth = collrange - distance;
-
-                        const bool remote = (hit_actor->ar_state == ActorState::NETWORKED_OK);
-
-                        ResolveCollisionForces(penetration_depth, hitnode, *na, *nb, *no, coord.alpha,
-                                coord.beta, coord.gamma, normal, dt, remote, submesh_ground_model);
-
-                        hitnode.nd_last_collision_gm = &submesh_ground_model;
-                        hitnode.nd_has_mesh_contact = true;
-                        na->nd_has_mesh_contact = true;
-                        nb->nd_has_mesh_contact = true;
-                        no->nd_has_mesh_contact = true;
                     }
                 }
             }
@@ -211,8 +291,33 @@ void RoR::ResolveIntraActorCollisions(const float dt, PointColDetector &intraPoi
         const int free_collcab, int collcabs[], int cabs[],
         collcab_rate_t intra_collcabrate[], node_t nodes[],
         const float collrange,
-        ground_model_t &submesh_ground_model)
+        ground_model_t &submesh_ground_model,
+        CabTriangleBvh* bvh)
 {
+    if (bvh != nullptr)
+    {
+        // Every triangle near a contacter is tested every step, no rate limiting needed
+        bvh->Update(free_collcab, collcabs, cabs, nodes);
+        bvh->ForEachCandidate(intraPointCD, collrange, [&](int i, const std::vector<PointidID_t>& hits)
+            {
+                int tmpv = collcabs[i]*3;
+                node_t& no = nodes[cabs[tmpv]];
+                node_t& na = nodes[cabs[tmpv+1]];
+                node_t& nb = nodes[cabs[tmpv+2]];
+
+                // setup transformation of points to triangle local coordinates
+                const Triangle triangle(na.AbsPosition, nb.AbsPosition, no.AbsPosition);
+                const CartesianToTriangleTransform transform(triangle);
+
+                for (PointidID_t h : hits)
+                {
+                    ResolveIntraActorHit(dt, triangle, transform, na, nb, no,
+                        nodes[intraPointCD.hit_pointid_list[h].nodenum], collrange, submesh_ground_model);
+                }
+            });
+        return;
+    }
+
     for (int i=0; i<free_collcab; i++)
     {
         if (intra_collcabrate[i].rate > 0)
@@ -246,38 +351,10 @@ void RoR::ResolveIntraActorCollisions(const float dt, PointColDetector &intraPoi
 
             for (PointidID_t h : intraPointCD.hit_list)
             {
-                NodeNum_t hitnode_num = intraPointCD.hit_pointid_list[h].nodenum;
-                node_t& hitnode = nodes[hitnode_num];
-
-                //ignore wheel/chassis self contact
-                if (hitnode.nd_tyre_node) continue;
-                if (no == &hitnode || na == &hitnode || nb == &hitnode) continue;
-
-                // transform point to triangle local coordinates
-                const auto local_point = transform(hitnode.AbsPosition);
-
-                // collision test
-                const bool is_colliding = InsideTriangleTest(local_point, collrange);
-                if (is_colliding)
+                node_t& hitnode = nodes[intraPointCD.hit_pointid_list[h].nodenum];
+                if (ResolveIntraActorHit(dt, triangle, transform, *na, *nb, *no, hitnode, collrange, submesh_ground_model))
                 {
                     collision = true;
-
-                    const auto coord = local_point.barycentric;
-                    auto distance = local_point.distance;
-                    auto normal   = triangle.normal();
-
-                    // adapt in case the collision is occuring on the backface of the triangle
-                    if (distance < 0) 
-                    {
-                        // flip surface normal and distance to triangle plane
-                        normal   = -normal;
-                        distance = -distance;
-                    }
-
-                    const auto penetration_depth = collrange - distance;
-
-                    ResolveCollisionForces(penetration_depth, hitnode, *na, *nb, *no, coord.alpha,
-                            coord.beta, coord.gamma, normal, dt, false, submesh_ground_model);
                 }
             }
         }
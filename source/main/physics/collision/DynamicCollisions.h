@@ -36,13 +36,15 @@ void ResolveInterActorCollisions(const float dt, PointColDetector &interPointCD,
         const int free_collcab, int collcabs[], int cabs[],
         collcab_rate_t inter_collcabrate[], node_t nodes[],
         const float collrange,
-        ground_model_t &submesh_ground_model);
+        ground_model_t &submesh_ground_model,
+        CabTriangleBvh* bvh); //!< Optional, replaces the collcab rate limiting
 
 void ResolveIntraActorCollisions(const float dt, PointColDetector &intraPointCD,
         const int free_collcab, int collcabs[], int cabs[],
         collcab_rate_t intra_collcabrate[], node_t nodes[],
         const float collrange,
-        ground_model_t &submesh_ground_model);
+        ground_model_t &submesh_ground_model,
+        CabTriangleBvh* bvh); //!< Optional, replaces the collcab rate limiting
 
 /// @} // addtogroup Collisions
 /// @} // addtogroup Physics
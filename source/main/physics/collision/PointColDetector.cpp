@@ -50,37 +50,48 @@ void PointColDetector::UpdateIntraPoint(bool contactables)
 
 void PointColDetector::UpdateInterPoint(bool ignorestate)
 {
-    int contacters_size = 0;
-    std::vector<ActorInstanceID_t> collision_partners;
+    m_partner_scratch.clear();
     for (ActorPtr& actor : App::GetGameContext()->GetActorManager()->GetActors())
     {
         if (actor != m_actor && (ignorestate || actor->ar_update_physics) &&
                 m_actor->ar_bounding_box.intersects(actor->ar_bounding_box))
         {
-            collision_partners.push_back(actor->ar_instance_id);
-            bool is_linked = std::find(m_actor->ar_linked_actors.begin(), m_actor->ar_linked_actors.end(), actor) != m_actor->ar_linked_actors.end();
-            contacters_size += is_linked ? actor->ar_num_contacters : actor->ar_num_contactable_nodes;
-            if (m_actor->ar_nodes[0].Velocity.squaredDistance(actor->ar_nodes[0].Velocity) > 16)
+            m_partner_scratch.push_back(actor.GetRef());
+        }
+    }
+
+    this->UpdateInterPoint(m_partner_scratch);
+}
+
+void PointColDetector::UpdateInterPoint(const std::vector<Actor*>& partners)
+{
+    int contacters_size = 0;
+    m_collision_partners_new.clear();
+    for (Actor* actor : partners)
+    {
+        m_collision_partners_new.push_back(actor->ar_instance_id);
+        bool is_linked = std::find(m_actor->ar_linked_actors.begin(), m_actor->ar_linked_actors.end(), actor) != m_actor->ar_linked_actors.end();
+        contacters_size += is_linked ? actor->ar_num_contacters : actor->ar_num_contactable_nodes;
+        if (m_actor->ar_nodes[0].Velocity.squaredDistance(actor->ar_nodes[0].Velocity) > 16)
+        {
+            for (int i = 0; i < m_actor->ar_num_collcabs; i++)
+            {
+                m_actor->ar_intra_collcabrate[i].rate = 0;
+                m_actor->ar_inter_collcabrate[i].rate = 0;
+            }
+            for (int i = 0; i < actor->ar_num_collcabs; i++)
             {
-                for (int i = 0; i < m_actor->ar_num_collcabs; i++)
-                {
-                    m_actor->ar_intra_collcabrate[i].rate = 0;
-                    m_actor->ar_inter_collcabrate[i].rate = 0;
-                }
-                for (int i = 0; i < actor->ar_num_collcabs; i++)
-                {
-                    actor->ar_intra_collcabrate[i].rate = 0;
-                    actor->ar_inter_collcabrate[i].rate = 0;
-                }
+                actor->ar_intra_collcabrate[i].rate = 0;
+                actor->ar_inter_collcabrate[i].rate = 0;
             }
         }
     }
 
     m_actor->ar_collision_relevant = (contacters_size > 0);
 
-    if (collision_partners != m_collision_partners || contacters_size != m_object_list_size)
+    if (m_collision_partners_new != m_collision_partners || contacters_size != m_object_list_size)
     {
-        m_collision_partners = collision_partners;
+        std::swap(m_collision_partners, m_collision_partners_new);
         m_object_list_size = contacters_size;
         update_structures_for_contacters(false);
     }
@@ -97,6 +108,8 @@ void PointColDetector::UpdateInterPoint(bool ignorestate)
 void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
 {
     m_ref_list.resize(m_object_list_size);
+    m_ref_nodes.resize(m_object_list_size);
+    m_ref_actors.resize(m_object_list_size);
     hit_pointid_list.resize(m_object_list_size);
 
     // Insert all contacters into the list of points to consider when building the kdtree
@@ -113,6 +126,8 @@ void PointColDetector::update_structures_for_contacters(bool ignoreinternal)
             {
                 hit_pointid_list[refi].actorid = actor->ar_instance_id;
                 hit_pointid_list[refi].nodenum = static_cast<NodeNum_t>(i);
+                m_ref_nodes[refi] = &actor->ar_nodes[i];
+                m_ref_actors[refi] = actor.GetRef();
                 m_ref_list[refi].pidrefid = refi;
                 m_ref_list[refi].setPoint(actor->ar_nodes[i].AbsPosition);
                 refi++;
@@ -156,6 +171,16 @@ void PointColDetector::query(const Vector3 &vec1, const Vector3 &vec2, const Vec
     queryrec(0, 0);
 }
 
+void PointColDetector::query(const Vector3 &bbmin, const Vector3 &bbmax)
+{
+    m_bbmin = bbmin;
+    m_bbmax = bbmax;
+
+    hit_list.clear();
+    hit_list_actorset.clear();
+    queryrec(0, 0);
+}
+
 void PointColDetector::queryrec(int kdindex, int axis)
 {
     for (;;)
@@ -342,17 +367,11 @@ void PointColDetector::partintwo(const int start, const int median, const int en
 void PointColDetector::refresh_node_positions()
 {
     // Because the reflist contains cached node positions, we must update it on each tick.
-    // To avoid repeated lookup in actormanager, we loop actors first.
+    // The node pointers stay valid as long as the partner list doesn't change (it's rebuilt otherwise).
     // ----------------------------------------------------------------------------------
 
-    for (ActorPtr& actor: App::GetGameContext()->GetActorManager()->GetActors())
+    for (refelem_t& refelem: m_ref_list)
     {
-        for (refelem_t& refelem: m_ref_list)
-        {
-            if (hit_pointid_list[refelem.pidrefid].actorid == actor->ar_instance_id)
-            {
-                refelem.setPoint(actor->ar_nodes[hit_pointid_list[refelem.pidrefid].nodenum].AbsPosition);
-            }
-        }
+        refelem.setPoint(m_ref_nodes[refelem.pidrefid]->AbsPosition);
     }
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include "Application.h"
+#include "SimData.h"
 
 namespace RoR {
 
@@ -46,8 +47,13 @@ public:
     PointColDetector(ActorPtr actor): m_actor(actor), m_object_list_size(-1) {};
 
     void UpdateIntraPoint(bool contactables = false);
-    void UpdateInterPoint(bool ignorestate = false);
+    void UpdateInterPoint(bool ignorestate = false);            //!< Finds collision partners by testing all actors' bounding boxes
+    void UpdateInterPoint(const std::vector<Actor*>& partners); //!< Uses collision partners found by the broad phase in ActorManager
     void query(const Ogre::Vector3& vec1, const Ogre::Vector3& vec2, const Ogre::Vector3& vec3, const float enlargeBB);
+    void query(const Ogre::Vector3& bbmin, const Ogre::Vector3& bbmax); //!< Finds points within an axis-aligned box
+
+    const Ogre::Vector3& getPointPosition(PointidID_t id) const { return m_ref_nodes[id]->AbsPosition; }
+    Actor*               getPointActor(PointidID_t id) const { return m_ref_actors[id]; }
 
 private:
 
@@ -70,7 +76,11 @@ private:
 
     ActorPtr                 m_actor;
     std::vector<ActorInstanceID_t>    m_collision_partners; //!< IntraPoint: always just owning actor; InterPoint: all colliding actors
+    std::vector<ActorInstanceID_t>    m_collision_partners_new; //!< InterPoint: scratch buffer, reused to avoid allocations
+    std::vector<Actor*>    m_partner_scratch;  //!< InterPoint: scratch buffer for the full bounding box scan
     std::vector<refelem_t> m_ref_list;
+    std::vector<node_t*>   m_ref_nodes;        //!< Source node for each `hit_pointid_list` entry (indexed by PointidID_t)
+    std::vector<Actor*>    m_ref_actors;       //!< Source actor for each `hit_pointid_list` entry (indexed by PointidID_t)
     
     std::vector<kdnode_t>  m_kdtree;
     Ogre::Vector3          m_bbmin = Ogre::Vector3::ZERO;
@@ -27,6 +27,9 @@
 #include "SimData.h"
 #include "GfxActor.h"
 
+#include <algorithm>
+#include <cmath>
+
 using namespace RoR;
 
 float refairfoilpos[90]={
@@ -74,6 +77,8 @@ float refairfoilpos[90]={
 
 using namespace Ogre;
 
+static const float GFX_SHAPE_EPSILON_SQ = 0.001f * 0.001f; // Panels deformed or turned by less than 1mm keep their vertices
+
 FlexAirfoil::FlexAirfoil(Ogre::String const & name, ActorPtr actor, NodeNum_t pnfld, NodeNum_t pnfrd, NodeNum_t pnflu, NodeNum_t pnfru, NodeNum_t pnbld, NodeNum_t pnbrd, NodeNum_t pnblu, NodeNum_t pnbru, std::string const & texband, Vector2 texlf, Vector2 texrf, Vector2 texlb, Vector2 texrb, char mtype, float controlratio, float mind, float maxd, Ogre::String const & afname, float lift_coef, bool break_able)
     :nfld(pnfld)
     ,nfrd(pnfrd)
@@ -452,6 +457,25 @@ Vector3 FlexAirfoil::updateVerticesGfx(RoR::GfxActor* gfx_actor)
     Vector3 vyr=gfx_nodes[nfru].AbsPosition-gfx_nodes[nfrd].AbsPosition;
     Vector3 vzr=gfx_nodes[nbrd].AbsPosition-gfx_nodes[nfrd].AbsPosition;
 
+    // Unchanged shape - the panel at most moved as a whole, which the scene node takes care of
+    const Vector3 shape[7] = { vx, vyl, vzl, vyr, vzr,
+        gfx_nodes[nblu].AbsPosition-gfx_nodes[nfld].AbsPosition, gfx_nodes[nbru].AbsPosition-gfx_nodes[nfrd].AbsPosition };
+    if (gfx_shape_valid && deflection == gfx_shape_deflection && broken == gfx_shape_broken)
+    {
+        bool deformed = false;
+        for (i=0; i<7 && !deformed; i++)
+        {
+            deformed = shape[i].squaredDistance(gfx_shape[i]) > GFX_SHAPE_EPSILON_SQ;
+        }
+        if (!deformed)
+            return center;
+    }
+    std::copy(shape, shape + 7, gfx_shape);
+    gfx_shape_deflection = deflection;
+    gfx_shape_broken = broken;
+    gfx_shape_valid = true;
+    gfx_vertices_dirty = true;
+
     Vector3 facenormal=vx;
     facenormal.normalise();
 
@@ -562,7 +586,11 @@ Vector3 FlexAirfoil::updateVerticesGfx(RoR::GfxActor* gfx_actor)
 
 void FlexAirfoil::uploadVertices()
 {
+    if (!gfx_vertices_dirty)
+        return;
+
     vbuf->writeData(0, vbuf->getSizeInBytes(), vertices, true);
+    gfx_vertices_dirty = false;
 }
 
 
@@ -615,12 +643,12 @@ void FlexAirfoil::updateForces()
     //calculate angle of attack
     Vector3 pwind;
     pwind=Plane(Vector3::ZERO, normv, chordv).projectVector(-wind);
-    Vector3 dumb;
-    Degree daoa;
-    chordv.getRotationTo(-pwind).ToAngleAxis(daoa, dumb);
-    aoa=daoa.valueDegrees();
-    float raoa=daoa.valueRadians();
-    if (dumb.dotProduct(spanv)>0) {aoa=-aoa; raoa=-raoa;};
+    // Angle between chord and projected wind, negative if it turns along the span; same as
+    // `getRotationTo().ToAngleAxis()` without building a quaternion
+    Vector3 rotv=chordv.crossProduct(-pwind);
+    float raoa=std::atan2(rotv.length(), chordv.dotProduct(-pwind));
+    if (rotv.dotProduct(spanv)>0) raoa=-raoa;
+    aoa=Radian(raoa).valueDegrees();
 
     //get airfoil data
     float cz, cx, cm;
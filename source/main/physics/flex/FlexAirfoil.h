@@ -43,8 +43,8 @@ public:
 
     // DEV NOTE: original `updateVertices()` updated both physics state + visuals.
     void updateVerticesPhysics();
-    Ogre::Vector3 updateVerticesGfx(RoR::GfxActor* gfx_actor);
-    void uploadVertices();
+    Ogre::Vector3 updateVerticesGfx(RoR::GfxActor* gfx_actor); //!< Returns the panel position; vertices are only recomputed if the shape changed. Doesn't touch OGRE.
+    void uploadVertices(); //!< Only if `updateVerticesGfx()` recomputed them since the last upload
 
     void setControlDeflection(float val);
 
@@ -127,6 +127,13 @@ private:
     float idArea;
     bool idLeft;
 
+    // Edge vectors (relative to the leading corners) the vertices were last computed from
+    Ogre::Vector3 gfx_shape[7];
+    float gfx_shape_deflection = 0.f;
+    bool gfx_shape_broken = false;
+    bool gfx_shape_valid = false;
+    bool gfx_vertices_dirty = false; //!< Recomputed, not uploaded yet
+
     Airfoil* airfoil;
     AeroEngine** aeroengines;
     int free_wash;
@@ -29,12 +29,115 @@
 #include "GfxActor.h"
 #include "GfxScene.h"
 #include "RigDef_File.h"
+#include "ThreadPool.h"
 
 #include <Ogre.h>
 
+#include <algorithm>
+#include <map>
+
 using namespace Ogre;
 using namespace RoR;
 
+static const float FLEXBODY_RIGID_EPSILON = 0.001f; // Meters; nodes moving less than this relative to the flexit frame don't deform the mesh
+
+/// K-d tree over the forset node positions, for assigning vertices to their nearest nodes.
+/// Gives the same answers as a linear scan, including ties (lowest position in the forset wins).
+class FlexNodeIndex
+{
+public:
+    FlexNodeIndex(RoR::NodeSB* nodes, std::vector<unsigned int> const& node_indices)
+    {
+        m_points.reserve(node_indices.size());
+        for (unsigned int node_index : node_indices)
+        {
+            m_points.push_back(nodes[node_index].AbsPosition);
+        }
+        m_tree.resize(m_points.size());
+        for (int i = 0; i < (int)m_tree.size(); i++)
+        {
+            m_tree[i] = i;
+        }
+        m_axes.resize(m_points.size());
+        this->Build(0, (int)m_tree.size());
+    }
+
+    /// @return Position in the forset of the closest node accepted by `filter(position)`, or -1.
+    template<typename F> int FindNearest(Vector3 const& pos, F const& filter) const
+    {
+        Query<F> q{pos, filter, std::numeric_limits<float>::max(), -1};
+        this->Search(q, 0, (int)m_tree.size());
+        return q.best_index;
+    }
+
+private:
+    template<typename F> struct Query
+    {
+        Vector3 const& pos;
+        F const&       filter;
+        float          best_distance;
+        int            best_index;
+    };
+
+    void Build(int begin, int end) // Median split along the longest extent
+    {
+        if (end - begin < 2)
+            return;
+
+        Vector3 min = m_points[m_tree[begin]], max = min;
+        for (int i = begin + 1; i < end; i++)
+        {
+            min.makeFloor(m_points[m_tree[i]]);
+            max.makeCeil(m_points[m_tree[i]]);
+        }
+        const Vector3 extent = max - min;
+        const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : ((extent.y >= extent.z) ? 1 : 2);
+
+        const int mid = (begin + end) / 2;
+        std::nth_element(m_tree.begin() + begin, m_tree.begin() + mid, m_tree.begin() + end,
+            [this, axis](int a, int b) { return m_points[a][axis] < m_points[b][axis]; });
+        m_axes[mid] = axis;
+        this->Build(begin, mid);
+        this->Build(mid + 1, end);
+    }
+
+    template<typename F> void Search(Query<F>& q, int begin, int end) const
+    {
+        if (begin >= end)
+            return;
+
+        const int mid = (begin + end) / 2;
+        const int index = m_tree[mid];
+        const float distance = q.pos.squaredDistance(m_points[index]);
+        if ((distance < q.best_distance || (distance == q.best_distance && index < q.best_index)) && q.filter(index))
+        {
+            q.best_distance = distance;
+            q.best_index = index;
+        }
+        if (end - begin == 1)
+            return;
+
+        // Nearer half first; the farther one only if the splitting plane is within reach
+        const float plane_distance = q.pos[m_axes[mid]] - m_points[index][m_axes[mid]];
+        if (plane_distance < 0.f)
+        {
+            this->Search(q, begin, mid);
+            if (plane_distance * plane_distance <= q.best_distance)
+                this->Search(q, mid + 1, end);
+        }
+        else
+        {
+            this->Search(q, mid + 1, end);
+            if (plane_distance * plane_distance <= q.best_distance)
+                this->Search(q, begin, mid);
+        }
+    }
+
+    std::vector<Vector3> m_points; //!< Node positions, in forset order
+    std::vector<int>     m_tree;   //!< Positions in forset; each range's median is its split point
+    std::vector<char>    m_axes;   //!< Split axis, indexed like `m_tree`
+};
+
 FlexBody::FlexBody(
     RigDef::Flexbody* def,
     RoR::FlexBodyCacheData* preloaded_from_cache,
@@ -62,7 +165,10 @@ FlexBody::FlexBody(
     , m_dst_normals(nullptr)
     , m_dst_pos(nullptr)
     , m_src_colors(nullptr)
+    , m_content_hash(0)
     , m_gfx_actor(gfx_actor)
+    , m_flexit_orientation(Ogre::Quaternion::IDENTITY)
+    , m_mesh_changed(true)
 {
     ROR_ASSERT(m_node_x != NODENUM_INVALID);
     ROR_ASSERT(m_node_y != NODENUM_INVALID);
@@ -102,6 +208,28 @@ FlexBody::FlexBody(
     Ogre::MeshPtr mesh=ent->getMesh();
     m_orig_mesh_info = RoR::PrintMeshInfo("Original", mesh); // For diagnostics only
     int num_submeshes = static_cast<int>(mesh->getNumSubMeshes());
+
+    // Defragmentation reorders this instance's mesh to match the locators, so its data is never shared.
+    // For simplicity, only take 1-submesh meshes (almost always the case anyway)
+    const bool defrag_enabled = App::GetConsole()->cVarGet("flexbody_defrag_enabled", CVAR_TYPE_BOOL)->getBool()
+        && num_submeshes == 1;
+
+    m_content_hash = FlexBody::computeContentHash(def, mesh, nodes, node_indices, position, orientation, ref, nx, ny);
+    if (preloaded_from_cache != nullptr && preloaded_from_cache->header.content_hash != m_content_hash)
+    {
+        LOG("FLEXBODY Warning: cache entry doesn't match mesh "+def->mesh_name+", recomputing");
+        free(preloaded_from_cache->dst_pos);
+        free(preloaded_from_cache->src_colors);
+        preloaded_from_cache->dst_pos = nullptr;
+        preloaded_from_cache->src_colors = nullptr;
+        preloaded_from_cache = nullptr;
+    }
+    if (preloaded_from_cache == nullptr && !defrag_enabled)
+    {
+        m_shared_data = FlexFactory::FindSharedData(m_content_hash);
+    }
+    const bool compute_vertex_data = (preloaded_from_cache == nullptr && !m_shared_data);
+
     if (preloaded_from_cache == nullptr)
     {
         //determine if we have texture coordinates everywhere
@@ -218,6 +346,11 @@ FlexBody::FlexBody(
         }
     }
 
+    if (!defrag_enabled)
+    {
+        this->shareStaticBuffers(mesh, def->mesh_name);
+    }
+
     //print mesh information
     //LOG("FLEXBODY Printing modififed mesh informations:");
     //printMeshInfo(ent->getMesh().getPointer());
@@ -257,9 +390,12 @@ FlexBody::FlexBody(
     double stat_located_time = -1;
     if (preloaded_from_cache != nullptr)
     {
+        m_shared_data = (defrag_enabled)
+            ? preloaded_from_cache->shared_data
+            : FlexFactory::RegisterSharedData(preloaded_from_cache->shared_data);
         m_dst_pos     = preloaded_from_cache->dst_pos;
-        m_src_normals = preloaded_from_cache->src_normals;
-        m_locators    = preloaded_from_cache->locators;
+        m_src_normals = m_shared_data->src_normals.data();
+        m_locators    = m_shared_data->locators.data();
         m_dst_normals = (Vector3*)malloc(sizeof(Vector3)*m_vertex_count); // Use malloc() for compatibility
 
         if (m_has_texture_blend)
@@ -310,9 +446,17 @@ FlexBody::FlexBody(
     }
     else
     {
-        vertices=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
+        if (compute_vertex_data)
+        {
+            vertices=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
+            m_shared_data = std::make_shared<FlexBodySharedData>();
+            m_shared_data->content_hash = m_content_hash;
+            m_shared_data->locators.resize(m_vertex_count);
+            m_shared_data->src_normals.resize(m_vertex_count);
+        }
+        m_locators=m_shared_data->locators.data();
+        m_src_normals=m_shared_data->src_normals.data();
         m_dst_pos=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
-        m_src_normals=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
         m_dst_normals=(Vector3*)malloc(sizeof(Vector3)*m_vertex_count);
         if (m_has_texture_blend)
         {
@@ -327,13 +471,16 @@ FlexBody::FlexBody(
             //vertices
             int source=mesh->sharedVertexData->vertexDeclaration->findElementBySemantic(VES_POSITION)->getSource();
             m_shared_vbuf_pos=mesh->sharedVertexData->vertexBufferBinding->getBuffer(source);
-            m_shared_vbuf_pos->readData(0, mesh->sharedVertexData->vertexCount*sizeof(Vector3), (void*)vpt);
-            vpt+=mesh->sharedVertexData->vertexCount;
             //normals
             source=mesh->sharedVertexData->vertexDeclaration->findElementBySemantic(VES_NORMAL)->getSource();
             m_shared_vbuf_norm=mesh->sharedVertexData->vertexBufferBinding->getBuffer(source);
-            m_shared_vbuf_norm->readData(0, mesh->sharedVertexData->vertexCount*sizeof(Vector3), (void*)npt);
-            npt+=mesh->sharedVertexData->vertexCount;
+            if (compute_vertex_data)
+            {
+                m_shared_vbuf_pos->readData(0, mesh->sharedVertexData->vertexCount*sizeof(Vector3), (void*)vpt);
+                vpt+=mesh->sharedVertexData->vertexCount;
+                m_shared_vbuf_norm->readData(0, mesh->sharedVertexData->vertexCount*sizeof(Vector3), (void*)npt);
+                npt+=mesh->sharedVertexData->vertexCount;
+            }
             //colors
             if (m_has_texture_blend)
             {
@@ -356,13 +503,16 @@ FlexBody::FlexBody(
             //vertices
             int source = vertex_data->vertexDeclaration->findElementBySemantic(VES_POSITION)->getSource();
             m_submesh_vbufs_pos[cursubmesh]=vertex_data->vertexBufferBinding->getBuffer(source);
-            m_submesh_vbufs_pos[cursubmesh]->readData(0, vertex_count*sizeof(Vector3), (void*)vpt);
-            vpt += vertex_count;
             //normals
             source = vertex_data->vertexDeclaration->findElementBySemantic(VES_NORMAL)->getSource();
             m_submesh_vbufs_norm[cursubmesh]=vertex_data->vertexBufferBinding->getBuffer(source);
-            m_submesh_vbufs_norm[cursubmesh]->readData(0, vertex_count*sizeof(Vector3), (void*)npt);
-            npt += vertex_count;
+            if (compute_vertex_data)
+            {
+                m_submesh_vbufs_pos[cursubmesh]->readData(0, vertex_count*sizeof(Vector3), (void*)vpt);
+                vpt += vertex_count;
+                m_submesh_vbufs_norm[cursubmesh]->readData(0, vertex_count*sizeof(Vector3), (void*)npt);
+                npt += vertex_count;
+            }
             //colors
             if (m_has_texture_blend)
             {
@@ -373,103 +523,68 @@ FlexBody::FlexBody(
             cursubmesh++;
         }
 
-        //transform
-        for (int i=0; i<(int)m_vertex_count; i++)
-        {
-            vertices[i]=(orientation*vertices[i])+position;
-        }
-
-        m_locators = new Locator_t[m_vertex_count];
-        for (int i=0; i<(int)m_vertex_count; i++)
+        if (compute_vertex_data)
         {
-            //search nearest node as the local origin
-            float closest_node_distance = std::numeric_limits<float>::max();
-            int closest_node_index = -1;
-            for (auto node_index : node_indices)
+            //transform
+            for (int i=0; i<(int)m_vertex_count; i++)
             {
-                float node_distance = vertices[i].squaredDistance(nodes[node_index].AbsPosition);
-                if (node_distance < closest_node_distance)
-                {
-                    closest_node_distance = node_distance;
-                    closest_node_index = node_index;
-                }
-            }
-            if (closest_node_index == -1)
-            {
-                LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": REF node not found");
-                closest_node_index = 0;
+                vertices[i]=(orientation*vertices[i])+position;
             }
-            m_locators[i].ref=closest_node_index;
 
-            //search the second nearest node as the X vector
-            closest_node_distance = std::numeric_limits<float>::max();
-            closest_node_index = -1;
-            for (auto node_index : node_indices)
-            {
-                if (node_index == m_locators[i].ref)
+            // Each vertex is independent; the expensive part of spawning big meshes
+            const FlexNodeIndex node_index(nodes, node_indices);
+            App::GetThreadPool()->ParallelFor(m_vertex_count, [&](size_t i)
                 {
-                    continue;
-                }
-                float node_distance = vertices[i].squaredDistance(nodes[node_index].AbsPosition);
-                if (node_distance < closest_node_distance)
-                {
-                    closest_node_distance = node_distance;
-                    closest_node_index = node_index;
-                }
-            }
-            if (closest_node_index == -1)
-            {
-                LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VX node not found");
-                closest_node_index = 0;
-            }
-            m_locators[i].nx=closest_node_index;
+                    //search nearest node as the local origin
+                    int closest = node_index.FindNearest(vertices[i], [](int) { return true; });
+                    if (closest == -1)
+                    {
+                        LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": REF node not found");
+                    }
+                    m_locators[i].ref = (closest == -1) ? 0 : node_indices[closest];
 
-            //search another close, orthogonal node as the Y vector
-            closest_node_distance = std::numeric_limits<float>::max();
-            closest_node_index = -1;
-            Vector3 vx = (nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition).normalisedCopy();
-            for (auto node_index : node_indices)
-            {
-                if (node_index == m_locators[i].ref || node_index == m_locators[i].nx)
-                {
-                    continue;
-                }
-                float node_distance = vertices[i].squaredDistance(nodes[node_index].AbsPosition);
-                if (node_distance < closest_node_distance)
-                {
-                    Vector3 vt = (nodes[node_index].AbsPosition - nodes[m_locators[i].ref].AbsPosition).normalisedCopy();
-                    float cost = vx.dotProduct(vt);
-                    if (std::abs(cost) > std::sqrt(2.0f) / 2.0f)
+                    //search the second nearest node as the X vector
+                    closest = node_index.FindNearest(vertices[i], [&](int k) { return node_indices[k] != m_locators[i].ref; });
+                    if (closest == -1)
                     {
-                        continue; //rejection, fails the orthogonality criterion (+-45 degree)
+                        LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VX node not found");
                     }
-                    closest_node_distance = node_distance;
-                    closest_node_index = node_index;
-                }
-            }
-            if (closest_node_index == -1)
-            {
-                LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VY node not found");
-                closest_node_index = 0;
-            }
-            m_locators[i].ny=closest_node_index;
+                    m_locators[i].nx = (closest == -1) ? 0 : node_indices[closest];
+
+                    //search another close, orthogonal node as the Y vector
+                    Vector3 vx = (nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition).normalisedCopy();
+                    closest = node_index.FindNearest(vertices[i], [&](int k)
+                        {
+                            if (node_indices[k] == m_locators[i].ref || node_indices[k] == m_locators[i].nx)
+                            {
+                                return false;
+                            }
+                            Vector3 vt = (nodes[node_indices[k]].AbsPosition - nodes[m_locators[i].ref].AbsPosition).normalisedCopy();
+                            float cost = vx.dotProduct(vt);
+                            return std::abs(cost) <= std::sqrt(2.0f) / 2.0f; //rejection, fails the orthogonality criterion (+-45 degree)
+                        });
+                    if (closest == -1)
+                    {
+                        LOG("FLEXBODY ERROR on mesh "+def->mesh_name+": VY node not found");
+                    }
+                    m_locators[i].ny = (closest == -1) ? 0 : node_indices[closest];
 
-            Matrix3 mat;
-            Vector3 diffX = nodes[m_locators[i].nx].AbsPosition-nodes[m_locators[i].ref].AbsPosition;
-            Vector3 diffY = nodes[m_locators[i].ny].AbsPosition-nodes[m_locators[i].ref].AbsPosition;
+                    Matrix3 mat;
+                    Vector3 diffX = nodes[m_locators[i].nx].AbsPosition-nodes[m_locators[i].ref].AbsPosition;
+                    Vector3 diffY = nodes[m_locators[i].ny].AbsPosition-nodes[m_locators[i].ref].AbsPosition;
 
-            mat.SetColumn(0, diffX);
-            mat.SetColumn(1, diffY);
-            mat.SetColumn(2, (diffX.crossProduct(diffY)).normalisedCopy()); // Old version: mat.SetColumn(2, nodes[loc.nz].AbsPosition-nodes[loc.ref].AbsPosition);
+                    mat.SetColumn(0, diffX);
+                    mat.SetColumn(1, diffY);
+                    mat.SetColumn(2, (diffX.crossProduct(diffY)).normalisedCopy()); // Old version: mat.SetColumn(2, nodes[loc.nz].AbsPosition-nodes[loc.ref].AbsPosition);
 
-            mat = mat.Inverse();
+                    mat = mat.Inverse();
 
-            //compute coordinates in the newly formed Euclidean basis
-            m_locators[i].coords = mat * (vertices[i] - nodes[m_locators[i].ref].AbsPosition);
+                    //compute coordinates in the newly formed Euclidean basis
+                    m_locators[i].coords = mat * (vertices[i] - nodes[m_locators[i].ref].AbsPosition);
 
-            // that's it!
+                    // that's it!
+                });
         }
-
     } // if (preloaded_from_cache == nullptr)
 
     //adjusting bounds
@@ -494,7 +609,7 @@ FlexBody::FlexBody(
     m_scene_node->attachObject(ent);
     m_scene_node->setPosition(position);
 
-    if (preloaded_from_cache == nullptr)
+    if (compute_vertex_data)
     {
         for (int i=0; i<(int)m_vertex_count; i++)
         {
@@ -521,20 +636,41 @@ FlexBody::FlexBody(
         m_forset_nodes.push_back((NodeNum_t)nodenum);
     }
 
-    if (App::GetConsole()->cVarGet("flexbody_defrag_enabled", CVAR_TYPE_BOOL)->getBool()
-        // For simplicity, only take 1-submesh meshes (almost always the case anyway)
-        && m_scene_entity->getMesh()->getNumSubMeshes() == 1)
+    // Nodes which determine the mesh shape
+    for (int i = 0; i < (int)m_vertex_count; i++)
+    {
+        m_locator_nodes.push_back(m_locators[i].ref);
+        m_locator_nodes.push_back(m_locators[i].nx);
+        m_locator_nodes.push_back(m_locators[i].ny);
+    }
+    if (m_node_center >= 0)
+    {
+        m_locator_nodes.push_back(m_node_center);
+        m_locator_nodes.push_back(m_node_x);
+        m_locator_nodes.push_back(m_node_y);
+    }
+    std::sort(m_locator_nodes.begin(), m_locator_nodes.end());
+    m_locator_nodes.erase(std::unique(m_locator_nodes.begin(), m_locator_nodes.end()), m_locator_nodes.end());
+    if (!m_locator_nodes.empty())
+    {
+        m_node_local_pos.resize(m_locator_nodes.back() + 1);
+    }
+
+    if (defrag_enabled)
     {
         this->defragmentFlexbodyMesh();
     }
+    else if (compute_vertex_data)
+    {
+        FlexFactory::RegisterSharedData(m_shared_data);
+    }
+
+    this->buildLocatorTriplets();
 }
 
 FlexBody::~FlexBody()
 {
-    // Stuff using <new>
-    if (m_locators != nullptr) { delete[] m_locators; }
     // Stuff using malloc()
-    if (m_src_normals != nullptr) { free(m_src_normals); }
     if (m_dst_normals != nullptr) { free(m_dst_normals); }
     if (m_dst_pos     != nullptr) { free(m_dst_pos    ); }
     if (m_src_colors  != nullptr) { free(m_src_colors ); }
@@ -553,6 +689,124 @@ FlexBody::~FlexBody()
     Ogre::MeshManager::getSingleton().remove(mesh->getHandle());
 }
 
+size_t FlexBody::GetMemoryUsage() const
+{
+    size_t bytes = 0;
+    bytes += m_vertex_count * sizeof(Vector3) * 2; // `m_dst_pos`, `m_dst_normals`
+    if (m_src_colors)
+        bytes += m_vertex_count * sizeof(ARGB);
+    if (m_shared_data)
+        bytes += m_shared_data->locators.capacity() * sizeof(Locator_t) + m_shared_data->src_normals.capacity() * sizeof(Vector3);
+    bytes += m_locator_nodes.capacity() * sizeof(NodeNum_t);
+    bytes += (m_locator_nodes_local.capacity() + m_node_local_pos.capacity()) * sizeof(Vector3);
+    bytes += m_triplets.capacity() * sizeof(Locator_t);
+    bytes += m_vertex_triplets.capacity() * sizeof(uint32_t);
+    bytes += m_triplet_bases.capacity() * sizeof(TripletBasis);
+    bytes += m_forset_nodes.capacity() * sizeof(NodeNum_t);
+    return bytes;
+}
+
+void FlexBody::shareStaticBuffers(Ogre::MeshPtr mesh, std::string const& mesh_name)
+{
+    const std::string mesh_key = m_gfx_actor->GetResourceGroup() + "/" + mesh_name;
+    m_static_buffers = FlexFactory::FindStaticBuffers(mesh_key);
+    const bool is_new = !m_static_buffers;
+    if (is_new)
+    {
+        m_static_buffers = std::make_shared<FlexBodyStaticBuffers>();
+        m_static_buffers->mesh_key = mesh_key;
+    }
+
+    // Either record this instance's buffers, or swap them for the recorded ones - the copies get released.
+    size_t texcoord_idx = 0;
+    auto share_texcoords = [this, is_new, &texcoord_idx](Ogre::VertexData* vertex_data)
+    {
+        const VertexElement* elem = vertex_data->vertexDeclaration->findElementBySemantic(VES_TEXTURE_COORDINATES);
+        if (elem == nullptr)
+        {
+            return;
+        }
+        if (is_new)
+        {
+            m_static_buffers->texcoord_bufs.push_back(vertex_data->vertexBufferBinding->getBuffer(elem->getSource()));
+        }
+        else if (texcoord_idx < m_static_buffers->texcoord_bufs.size()
+            && m_static_buffers->texcoord_bufs[texcoord_idx]->getNumVertices() == vertex_data->vertexCount)
+        {
+            vertex_data->vertexBufferBinding->setBinding(elem->getSource(), m_static_buffers->texcoord_bufs[texcoord_idx]);
+        }
+        texcoord_idx++;
+    };
+
+    if (mesh->sharedVertexData)
+    {
+        share_texcoords(mesh->sharedVertexData);
+    }
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); i++)
+    {
+        SubMesh* submesh = mesh->getSubMesh(i);
+        if (!submesh->useSharedVertices)
+        {
+            share_texcoords(submesh->vertexData);
+        }
+
+        if (is_new)
+        {
+            m_static_buffers->index_bufs.push_back(submesh->indexData->indexBuffer);
+        }
+        else if (i < m_static_buffers->index_bufs.size()
+            && m_static_buffers->index_bufs[i]->getNumIndexes() == submesh->indexData->indexBuffer->getNumIndexes())
+        {
+            submesh->indexData->indexBuffer = m_static_buffers->index_bufs[i];
+        }
+    }
+
+    if (is_new)
+    {
+        FlexFactory::RegisterStaticBuffers(m_static_buffers);
+    }
+}
+
+uint64_t FlexBody::computeContentHash(RigDef::Flexbody* def, Ogre::MeshPtr mesh, RoR::NodeSB* nodes, std::vector<unsigned int> const& node_indices,
+    Ogre::Vector3 const& position, Ogre::Quaternion const& orientation, NodeNum_t ref, NodeNum_t nx, NodeNum_t ny)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    auto hash_bytes = [&hash](const void* data, size_t len)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < len; i++)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    auto hash_int = [&hash_bytes](int32_t val) { hash_bytes(&val, sizeof(val)); };
+
+    hash_bytes(def->mesh_name.c_str(), def->mesh_name.size());
+    hash_int((mesh->sharedVertexData) ? (int32_t)mesh->sharedVertexData->vertexCount : 0);
+    for (unsigned short i = 0; i < mesh->getNumSubMeshes(); i++)
+    {
+        const Ogre::SubMesh* submesh = mesh->getSubMesh(i);
+        hash_int((submesh->useSharedVertices) ? -1 : (int32_t)submesh->vertexData->vertexCount);
+    }
+    hash_int(ref);
+    hash_int(nx);
+    hash_int(ny);
+
+    // Node positions relative to the flexbody, rounded to millimeters - the spawn position/rotation doesn't matter.
+    const Ogre::Quaternion inv_orientation = orientation.Inverse();
+    for (unsigned int node_index : node_indices)
+    {
+        const Ogre::Vector3 local = inv_orientation * (nodes[node_index].AbsPosition - position);
+        hash_int((int32_t)node_index);
+        hash_int((int32_t)std::round(local.x * 1000.f));
+        hash_int((int32_t)std::round(local.y * 1000.f));
+        hash_int((int32_t)std::round(local.z * 1000.f));
+    }
+    return hash;
+}
+
 void FlexBody::setVisible(bool visible)
 {
     if (m_scene_node)
@@ -565,12 +819,22 @@ void FlexBody::setFlexbodyCastShadow(bool val)
 }
 
 void FlexBody::computeFlexbody()
+{
+    if (this->prepareFlexbody())
+    {
+        this->beginDeformation();
+        this->computeFlexbodyVertices(0, (int)m_vertex_count);
+    }
+}
+
+bool FlexBody::prepareFlexbody()
 {
     if (m_has_texture_blend) updateBlend();
 
     RoR::NodeSB* nodes = m_gfx_actor->GetSimNodeBuffer();
 
-    // compute the local center
+    // compute the local center and orientation
+    Ogre::Matrix3 world_to_local = Ogre::Matrix3::IDENTITY;
     if (m_node_center >= 0)
     {
         Vector3 diffX = nodes[m_node_x].AbsPosition - nodes[m_node_center].AbsPosition;
@@ -579,49 +843,109 @@ void FlexBody::computeFlexbody()
 
         m_flexit_center = nodes[m_node_center].AbsPosition + m_center_offset.x * diffX + m_center_offset.y * diffY;
         m_flexit_center += m_center_offset.z * flexit_normal;
+
+        const Vector3 axis_x = diffX.normalisedCopy();
+        const Vector3 axis_z = axis_x.crossProduct(diffY).normalisedCopy();
+        const Vector3 axis_y = axis_z.crossProduct(axis_x);
+        Ogre::Matrix3 local_to_world;
+        local_to_world.FromAxes(axis_x, axis_y, axis_z);
+        m_flexit_orientation = Ogre::Quaternion(local_to_world);
+        world_to_local = local_to_world.Transpose();
     }
     else
     {
         m_flexit_center = nodes[0].AbsPosition;
     }
 
-    for (int i=0; i<(int)m_vertex_count; i++)
+    // Only recompute vertices if the nodes moved relative to the flexit frame
+    bool deformed = !this->hasShape();
+    for (size_t i = 0; i < m_locator_nodes.size(); i++)
     {
-        Vector3 diffX = nodes[m_locators[i].nx].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 diffY = nodes[m_locators[i].ny].AbsPosition - nodes[m_locators[i].ref].AbsPosition;
-        Vector3 nCross = fast_normalise(diffX.crossProduct(diffY)); //nCross.normalise();
+        const NodeNum_t n = m_locator_nodes[i];
+        m_node_local_pos[n] = world_to_local * (nodes[n].AbsPosition - m_flexit_center);
+        deformed = deformed || (m_node_local_pos[n].squaredDistance(m_locator_nodes_local[i]) > FLEXBODY_RIGID_EPSILON * FLEXBODY_RIGID_EPSILON);
+    }
+    m_mesh_changed = false; // Until beginDeformation()
+    return deformed;
+}
 
-        m_dst_pos[i].x = diffX.x * m_locators[i].coords.x + diffY.x * m_locators[i].coords.y + nCross.x * m_locators[i].coords.z;
-        m_dst_pos[i].y = diffX.y * m_locators[i].coords.x + diffY.y * m_locators[i].coords.y + nCross.y * m_locators[i].coords.z;
-        m_dst_pos[i].z = diffX.z * m_locators[i].coords.x + diffY.z * m_locators[i].coords.y + nCross.z * m_locators[i].coords.z;
+void FlexBody::beginDeformation()
+{
+    m_mesh_changed = true;
+    m_locator_nodes_local.resize(m_locator_nodes.size());
+    for (size_t i = 0; i < m_locator_nodes.size(); i++)
+    {
+        m_locator_nodes_local[i] = m_node_local_pos[m_locator_nodes[i]];
+    }
 
-        m_dst_pos[i] += nodes[m_locators[i].ref].AbsPosition - m_flexit_center;
+    // One basis per locator triplet; many vertices share each
+    const Vector3* local_pos = m_node_local_pos.data();
+    for (size_t t = 0; t < m_triplets.size(); t++)
+    {
+        TripletBasis& basis = m_triplet_bases[t];
+        basis.origin = local_pos[m_triplets[t].ref];
+        basis.axis_x = local_pos[m_triplets[t].nx] - basis.origin;
+        basis.axis_y = local_pos[m_triplets[t].ny] - basis.origin;
+        basis.axis_z = fast_normalise(basis.axis_x.crossProduct(basis.axis_y));
+    }
+}
 
-        m_dst_normals[i].x = diffX.x * m_src_normals[i].x + diffY.x * m_src_normals[i].y + nCross.x * m_src_normals[i].z;
-        m_dst_normals[i].y = diffX.y * m_src_normals[i].x + diffY.y * m_src_normals[i].y + nCross.y * m_src_normals[i].z;
-        m_dst_normals[i].z = diffX.z * m_src_normals[i].x + diffY.z * m_src_normals[i].y + nCross.z * m_src_normals[i].z;
+void FlexBody::computeFlexbodyVertices(int begin, int end)
+{
+    // Plain multiply-adds from here, no gathers from the node buffer
+    const uint32_t* vertex_triplets = m_vertex_triplets.data();
+    const TripletBasis* bases = m_triplet_bases.data();
+    for (int i=begin; i<end; i++)
+    {
+        const TripletBasis& basis = bases[vertex_triplets[i]];
+        const Vector3& coords = m_locators[i].coords;
+        const Vector3& normal = m_src_normals[i];
 
-        m_dst_normals[i] = fast_normalise(m_dst_normals[i]);
+        m_dst_pos[i] = basis.origin + basis.axis_x * coords.x + basis.axis_y * coords.y + basis.axis_z * coords.z;
+        m_dst_normals[i] = fast_normalise(basis.axis_x * normal.x + basis.axis_y * normal.y + basis.axis_z * normal.z);
     }
 }
 
-void FlexBody::updateFlexbodyVertexBuffers()
+void FlexBody::buildLocatorTriplets()
 {
-    Vector3 *ppt = m_dst_pos;
-    Vector3 *npt = m_dst_normals;
-    if (m_uses_shared_vertex_data)
+    std::map<uint64_t, uint32_t> lookup;
+    m_triplets.clear();
+    m_vertex_triplets.resize(m_vertex_count);
+    for (int i = 0; i < (int)m_vertex_count; i++)
     {
-        m_shared_vbuf_pos->writeData(0, m_shared_buf_num_verts*sizeof(Vector3), ppt, true);
-        ppt += m_shared_buf_num_verts;
-        m_shared_vbuf_norm->writeData(0, m_shared_buf_num_verts*sizeof(Vector3), npt, true);
-        npt += m_shared_buf_num_verts;
+        const uint64_t key = (uint64_t(m_locators[i].ref) << 32) | (uint64_t(m_locators[i].nx) << 16) | uint64_t(m_locators[i].ny);
+        auto found = lookup.find(key);
+        if (found == lookup.end())
+        {
+            found = lookup.insert(std::make_pair(key, static_cast<uint32_t>(m_triplets.size()))).first;
+            m_triplets.push_back(m_locators[i]);
+        }
+        m_vertex_triplets[i] = found->second;
     }
-    for (int i=0; i<m_num_submesh_vbufs; i++)
+    m_triplet_bases.resize(m_triplets.size());
+}
+
+void FlexBody::updateFlexbodyVertexBuffers()
+{
+    // On rigid motion only, the buffers still hold valid vertices relative to the flexit frame
+    if (m_mesh_changed)
     {
-        m_submesh_vbufs_pos[i]->writeData(0, m_submesh_vbufs_vertex_counts[i]*sizeof(Vector3), ppt, true);
-        ppt += m_submesh_vbufs_vertex_counts[i];
-        m_submesh_vbufs_norm[i]->writeData(0, m_submesh_vbufs_vertex_counts[i]*sizeof(Vector3), npt, true);
-        npt += m_submesh_vbufs_vertex_counts[i];
+        Vector3 *ppt = m_dst_pos;
+        Vector3 *npt = m_dst_normals;
+        if (m_uses_shared_vertex_data)
+        {
+            m_shared_vbuf_pos->writeData(0, m_shared_buf_num_verts*sizeof(Vector3), ppt, true);
+            ppt += m_shared_buf_num_verts;
+            m_shared_vbuf_norm->writeData(0, m_shared_buf_num_verts*sizeof(Vector3), npt, true);
+            npt += m_shared_buf_num_verts;
+        }
+        for (int i=0; i<m_num_submesh_vbufs; i++)
+        {
+            m_submesh_vbufs_pos[i]->writeData(0, m_submesh_vbufs_vertex_counts[i]*sizeof(Vector3), ppt, true);
+            ppt += m_submesh_vbufs_vertex_counts[i];
+            m_submesh_vbufs_norm[i]->writeData(0, m_submesh_vbufs_vertex_counts[i]*sizeof(Vector3), npt, true);
+            npt += m_submesh_vbufs_vertex_counts[i];
+        }
     }
 
     if (m_blend_changed)
@@ -631,6 +955,7 @@ void FlexBody::updateFlexbodyVertexBuffers()
     }
 
     m_scene_node->setPosition(m_flexit_center);
+    m_scene_node->setOrientation(m_flexit_orientation);
 }
 
 void FlexBody::reset()
@@ -23,6 +23,7 @@
 
 #include "RigDef_Prerequisites.h"
 #include "Application.h"
+#include "FlexFactory.h"
 #include "Locator_t.h"
 #include "SimData.h"
 #include "RigDef_File.h"
@@ -38,7 +39,9 @@ namespace RoR {
 /// @addtogroup Flex
 /// @{
 
-/// Flexbody = A deformable mesh; updated on CPU every frame, then uploaded to video memory
+/// Flexbody = A deformable mesh; updated on CPU every frame, then uploaded to video memory.
+/// Vertices are kept in a frame attached to the ref/x/y nodes; while the mesh only moves rigidly
+/// with that frame, just the scene node transform is updated and the vertex buffers stay as they are.
 class FlexBody
 {
     friend class RoR::FlexFactory;
@@ -70,6 +73,12 @@ public:
     int getCameraMode() { return m_camera_mode; };
 
     void computeFlexbody(); //!< Updates mesh deformation; works on CPU using local copy of vertex data.
+    bool prepareFlexbody(); //!< First part of `computeFlexbody()`, O(nodes): moves the mesh with its nodes, returns true if it's also deformed.
+    void beginDeformation(); //!< Second part, O(nodes); if skipped, the mesh keeps its old shape and the deformation is picked up later.
+    void computeFlexbodyVertices(int begin, int end); //!< Third part; disjoint ranges may run in parallel.
+    bool hasShape() const { return m_locator_nodes_local.size() == m_locator_nodes.size(); } //!< False until deformed for the first time
+    float getBoundingRadius() { return m_scene_entity->getBoundingRadius(); }
+    Ogre::Vector3 getFlexitCenter() { return m_flexit_center; }
     void updateFlexbodyVertexBuffers();
 
     void setVisible(bool visible);
@@ -77,8 +86,9 @@ public:
     void setFlexbodyCastShadow(bool val);
 
     int getVertexCount() { return static_cast<int>(m_vertex_count); };
-    Locator_t& getVertexLocator(int vert) { ROR_ASSERT((size_t)vert < m_vertex_count); return m_locators[vert]; }
-    Ogre::Vector3 getVertexPos(int vert) { ROR_ASSERT((size_t)vert < m_vertex_count); return m_dst_pos[vert] + m_flexit_center; }
+    size_t GetMemoryUsage() const; //!< Bytes of CPU-side vertex and locator data
+    const Locator_t& getVertexLocator(int vert) { ROR_ASSERT((size_t)vert < m_vertex_count); return m_locators[vert]; }
+    Ogre::Vector3 getVertexPos(int vert) { ROR_ASSERT((size_t)vert < m_vertex_count); return m_flexit_center + m_flexit_orientation * m_dst_pos[vert]; }
     Ogre::Entity* getEntity() { return m_scene_entity; }
     std::string getOrigMeshName();
     std::vector<NodeNum_t>& getForsetNodes() { return m_forset_nodes; };
@@ -92,16 +102,46 @@ public:
 private:
 
     void defragmentFlexbodyMesh();
+    void shareStaticBuffers(Ogre::MeshPtr mesh, std::string const& mesh_name); //!< Binds texcoord/index buffers of an identical mesh instead of this copy's own; call after reorganising the buffers.
+    static uint64_t computeContentHash(RigDef::Flexbody* def, Ogre::MeshPtr mesh, RoR::NodeSB* nodes, std::vector<unsigned int> const& node_indices,
+        Ogre::Vector3 const& position, Ogre::Quaternion const& orientation, NodeNum_t ref, NodeNum_t nx, NodeNum_t ny);
+    void buildLocatorTriplets(); //!< Groups vertices by their ref/nx/ny nodes; must run after locators are final.
+
+    struct TripletBasis //!< Per-frame basis of one ref/nx/ny triplet, in the flexit frame
+    {
+        Ogre::Vector3 origin; //!< ref node
+        Ogre::Vector3 axis_x; //!< nx - ref
+        Ogre::Vector3 axis_y; //!< ny - ref
+        Ogre::Vector3 axis_z; //!< normalized cross product
+    };
 
     RoR::GfxActor*    m_gfx_actor;
     size_t            m_vertex_count;
     Ogre::Vector3     m_flexit_center; //!< Updated per frame
+    Ogre::Quaternion  m_flexit_orientation; //!< Updated per frame; basis of the ref/x/y nodes, vertices are relative to it.
+
+    // Rigid motion detection
+    std::vector<NodeNum_t>     m_locator_nodes;        //!< Unique nodes used by locators and the ref/x/y triplet
+    std::vector<Ogre::Vector3> m_locator_nodes_local;  //!< Node positions relative to the flexit frame when vertices were last computed
+    std::vector<Ogre::Vector3> m_node_local_pos;       //!< Scratch, indexed by node number
+    bool                       m_mesh_changed;         //!< Vertices were recomputed this frame and need upload
+
+    // Vertices sharing a locator triplet share one basis
+    std::vector<Locator_t>     m_triplets;             //!< Unique ref/nx/ny combinations; `coords` unused
+    std::vector<uint32_t>      m_vertex_triplets;      //!< Index into `m_triplets`, per vertex
+    std::vector<TripletBasis>  m_triplet_bases;        //!< Scratch, per triplet
 
     Ogre::Vector3*    m_dst_pos;
-    Ogre::Vector3*    m_src_normals;
+    Ogre::Vector3*    m_src_normals; //!< Points into `m_shared_data`
     Ogre::Vector3*    m_dst_normals;
     Ogre::ARGB*       m_src_colors;
-    Locator_t*        m_locators; //!< 1 loc per vertex
+    Locator_t*        m_locators; //!< 1 loc per vertex; points into `m_shared_data`
+
+    // Locators and source normals only depend on the mesh and the node setup - identical flexbodies share them.
+    // Read-only once the constructor finishes.
+    FlexBodySharedDataPtr m_shared_data;
+    FlexBodyStaticBuffersPtr m_static_buffers; //!< Texcoord/index buffers bound to this instance's mesh; null if not shared (defragmented mesh)
+    uint64_t              m_content_hash; //!< Of mesh, placement and forset node positions relative to the flexbody
 
     NodeNum_t         m_node_center;
     NodeNum_t         m_node_x;
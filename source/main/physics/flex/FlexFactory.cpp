@@ -50,6 +50,8 @@ using namespace RoR;
 
 // Static
 const char * FlexBodyFileIO::SIGNATURE = "RoR FlexBody";
+std::map<uint64_t, std::weak_ptr<FlexBodySharedData>> FlexFactory::s_shared_data;
+std::map<std::string, std::weak_ptr<FlexBodyStaticBuffers>> FlexFactory::s_static_buffers;
 
 FlexFactory::FlexFactory(ActorSpawner* rig_spawner):
     m_rig_spawner(rig_spawner),
@@ -202,6 +204,7 @@ void FlexBodyFileIO::WriteFlexbodyHeader(FlexBody* flexbody)
     header.camera_mode             = flexbody->m_camera_mode            ;
     header.shared_buf_num_verts    = flexbody->m_shared_buf_num_verts   ;
     header.num_submesh_vbufs       = flexbody->m_num_submesh_vbufs      ;
+    header.content_hash            = flexbody->m_content_hash           ;
 
     if (flexbody->m_uses_shared_vertex_data) BITMASK_SET_1(header.flags, FlexBodyRecordHeader::USES_SHARED_VERTEX_DATA);
     if (flexbody->m_has_texture            ) BITMASK_SET_1(header.flags, FlexBodyRecordHeader::HAS_TEXTURE);
@@ -226,10 +229,13 @@ void FlexBodyFileIO::WriteFlexbodyLocatorList(FlexBody* flexbody)
 void FlexBodyFileIO::ReadFlexbodyLocatorList(FlexBodyCacheData* data)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    // Alloc. Use <new> - experiment
-    data->locators = new Locator_t[data->header.vertex_count];
-    // Read
-    this->ReadFromFile((void*)data->locators, sizeof(Locator_t) * data->header.vertex_count);
+    if (!data->shared_data)
+    {
+        data->shared_data = std::make_shared<FlexBodySharedData>();
+        data->shared_data->content_hash = data->header.content_hash;
+    }
+    data->shared_data->locators.resize(data->header.vertex_count);
+    this->ReadFromFile((void*)data->shared_data->locators.data(), sizeof(Locator_t) * data->header.vertex_count);
 }
 
 void FlexBodyFileIO::WriteFlexbodyNormalsBuffer(FlexBody* flexbody)
@@ -241,11 +247,9 @@ void FlexBodyFileIO::WriteFlexbodyNormalsBuffer(FlexBody* flexbody)
 void FlexBodyFileIO::ReadFlexbodyNormalsBuffer(FlexBodyCacheData* data)
 {
     FLEX_DEBUG_LOG(__FUNCTION__);
-    const int vertex_count = data->header.vertex_count;
-    // Alloc. Use malloc() because that's how flexbodies were implemented.
-    data->src_normals=(Ogre::Vector3*)malloc(sizeof(Ogre::Vector3) * vertex_count);
-    // Read
-    this->ReadFromFile((void*)data->src_normals, sizeof(Ogre::Vector3) * vertex_count);
+    ROR_ASSERT(data->shared_data);
+    data->shared_data->src_normals.resize(data->header.vertex_count);
+    this->ReadFromFile((void*)data->shared_data->src_normals.data(), sizeof(Ogre::Vector3) * data->header.vertex_count);
 }
 
 void FlexBodyFileIO::WriteFlexbodyPositionsBuffer(FlexBody* flexbody)
@@ -410,3 +414,57 @@ void FlexFactory::SaveFlexbodiesToCache()
     }
 }
 
+FlexBodySharedDataPtr FlexFactory::FindSharedData(uint64_t content_hash)
+{
+    auto itor = s_shared_data.find(content_hash);
+    if (itor != s_shared_data.end())
+    {
+        return itor->second.lock(); // Null if expired
+    }
+    return nullptr;
+}
+
+FlexBodySharedDataPtr FlexFactory::RegisterSharedData(FlexBodySharedDataPtr data)
+{
+    FlexBodySharedDataPtr existing = FlexFactory::FindSharedData(data->content_hash);
+    if (existing)
+    {
+        return existing;
+    }
+
+    // Purge entries of despawned actors
+    for (auto itor = s_shared_data.begin(); itor != s_shared_data.end();)
+    {
+        if (itor->second.expired())
+            itor = s_shared_data.erase(itor);
+        else
+            ++itor;
+    }
+
+    s_shared_data[data->content_hash] = data;
+    return data;
+}
+
+FlexBodyStaticBuffersPtr FlexFactory::FindStaticBuffers(std::string const& mesh_key)
+{
+    auto itor = s_static_buffers.find(mesh_key);
+    if (itor != s_static_buffers.end())
+    {
+        return itor->second.lock(); // Null if expired
+    }
+    return nullptr;
+}
+
+void FlexFactory::RegisterStaticBuffers(FlexBodyStaticBuffersPtr buffers)
+{
+    // Purge entries of despawned actors
+    for (auto itor = s_static_buffers.begin(); itor != s_static_buffers.end();)
+    {
+        if (itor->second.expired())
+            itor = s_static_buffers.erase(itor);
+        else
+            ++itor;
+    }
+
+    s_static_buffers[buffers->mesh_key] = buffers;
+}
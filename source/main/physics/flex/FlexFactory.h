@@ -34,6 +34,10 @@
 
 #include <OgreVector3.h>
 #include <OgreColourValue.h>
+#include <OgreHardwareIndexBuffer.h>
+#include <OgreHardwareVertexBuffer.h>
+#include <map>
+#include <memory>
 #include <vector>
 
 namespace RoR
@@ -55,6 +59,7 @@ struct FlexBodyRecordHeader
     int            camera_mode;
     int            shared_buf_num_verts;
     int            num_submesh_vbufs;
+    uint64_t       content_hash;   //!< @see FlexBody::m_content_hash
     BitMask_t      flags = 0;
 
     static const BitMask_t IS_FAULTY                = BITMASK(1);
@@ -63,23 +68,42 @@ struct FlexBodyRecordHeader
     static const BitMask_t HAS_TEXTURE_BLEND        = BITMASK(4);
 };
 
+/// Read-only vertex data of a flexbody, shared by all instances with the same content hash
+/// (i.e. the same mesh placed on the same nodes - typically multiple spawns of one vehicle).
+struct FlexBodySharedData
+{
+    uint64_t                   content_hash = 0;
+    std::vector<Locator_t>     locators;    //!< 1 loc per vertex
+    std::vector<Ogre::Vector3> src_normals; //!< 1 per vertex, in the locator's basis
+};
+
+typedef std::shared_ptr<FlexBodySharedData> FlexBodySharedDataPtr;
+
+/// GPU buffers which flexbodies never write - texture coordinates and indices - shared by all instances
+/// of one mesh, so that only positions, normals and colors are duplicated per spawn.
+struct FlexBodyStaticBuffers
+{
+    std::string                                       mesh_key; //!< Resource group + mesh name
+    std::vector<Ogre::HardwareVertexBufferSharedPtr>  texcoord_bufs; //!< Shared vertex data first, then submeshes with own vertex data
+    std::vector<Ogre::HardwareIndexBufferSharedPtr>   index_bufs;    //!< 1 per submesh
+};
+
+typedef std::shared_ptr<FlexBodyStaticBuffers> FlexBodyStaticBuffersPtr;
+
 struct FlexBodyCacheData
 {
     FlexBodyCacheData():
         dst_pos(nullptr),
-        src_normals(nullptr),
-        src_colors(nullptr),
-        locators(nullptr)
+        src_colors(nullptr)
     {}
 
     // NOTE: No freeing of memory needed, pointers will be copied to FlexBody instances.
 
     FlexBodyRecordHeader header;
 
-    Ogre::Vector3*    dst_pos;
-    Ogre::Vector3*    src_normals;
-    Ogre::ARGB*       src_colors;
-    Locator_t*        locators; //!< 1 loc per vertex
+    Ogre::Vector3*        dst_pos;
+    Ogre::ARGB*           src_colors;
+    FlexBodySharedDataPtr shared_data; //!< Locators + normals
 };
 
 /// Enables saving and loading flexbodies from/to binary file.
@@ -110,7 +134,7 @@ public:
     };
 
     static const char*        SIGNATURE;
-    static const unsigned int FILE_FORMAT_VERSION = 1;
+    static const unsigned int FILE_FORMAT_VERSION = 2; //!< 2: Added content hash to record header
 
     FlexBodyFileIO();
 
@@ -190,8 +214,17 @@ public:
     void  CheckAndLoadFlexbodyCache();
     void  SaveFlexbodiesToCache();
 
+    /// Registry of shared flexbody data; entries live as long as any flexbody uses them.
+    static FlexBodySharedDataPtr FindSharedData(uint64_t content_hash);
+    static FlexBodySharedDataPtr RegisterSharedData(FlexBodySharedDataPtr data); //!< Returns the already registered instance if there's one.
+    static FlexBodyStaticBuffersPtr FindStaticBuffers(std::string const& mesh_key);
+    static void                     RegisterStaticBuffers(FlexBodyStaticBuffersPtr buffers);
+
 private:
 
+    static std::map<uint64_t, std::weak_ptr<FlexBodySharedData>>       s_shared_data;
+    static std::map<std::string, std::weak_ptr<FlexBodyStaticBuffers>> s_static_buffers;
+
     ActorSpawner*             m_rig_spawner;
 
     FlexBodyFileIO          m_flexbody_cache;
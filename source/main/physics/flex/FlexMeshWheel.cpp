@@ -191,12 +191,14 @@ Vector3 FlexMeshWheel::updateVertices()
     Vector3 axis = all_nodes[m_axis_node0_idx].AbsPosition - all_nodes[m_axis_node1_idx].AbsPosition;
 
     axis.normalise();
-    
+
+    // Positions first - the tire side normals need the next ray's vertices of this frame
+    const Plane pl0=Plane(axis, all_nodes[m_axis_node0_idx].AbsPosition);
+    const Plane pl1=Plane(-axis, all_nodes[m_axis_node1_idx].AbsPosition);
     for (size_t i=0; i<m_num_rays; i++)
     {
-        Plane pl=Plane(axis, all_nodes[m_axis_node0_idx].AbsPosition);
         ray=all_nodes[m_start_node_idx+i*2].AbsPosition-all_nodes[m_axis_node0_idx].AbsPosition;
-        ray=pl.projectVector(ray);
+        ray=pl0.projectVector(ray);
         ray.normalise();
         m_vertices[i*6  ].position=all_nodes[m_axis_node0_idx].AbsPosition+m_rim_radius*ray-center;
 
@@ -205,17 +207,20 @@ Vector3 FlexMeshWheel::updateVertices()
         m_vertices[i*6+3].position=all_nodes[m_start_node_idx+i*2+1].AbsPosition-0.1 *(all_nodes[m_start_node_idx+i*2+1].AbsPosition-all_nodes[m_start_node_idx+i*2].AbsPosition)-center;
         m_vertices[i*6+4].position=all_nodes[m_start_node_idx+i*2+1].AbsPosition-0.05*(all_nodes[m_start_node_idx+i*2+1].AbsPosition-all_nodes[m_axis_node1_idx].AbsPosition)-center;
 
-        pl=Plane(-axis, all_nodes[m_axis_node1_idx].AbsPosition);
         ray=all_nodes[m_start_node_idx+i*2+1].AbsPosition-all_nodes[m_axis_node1_idx].AbsPosition;
-        ray=pl.projectVector(ray);
+        ray=pl1.projectVector(ray);
         ray.normalise();
         m_vertices[i*6+5].position=all_nodes[m_axis_node1_idx].AbsPosition+m_rim_radius*ray-center;
 
-        //normals
-        m_vertices[i*6  ].normal=axis;
-        m_vertices[i*6+1].normal=(m_vertices[i*6].position-m_vertices[i*6+1].position).crossProduct(m_vertices[i*6].position-m_vertices[((i+1)%m_num_rays)*6+1].position)/m_norm_y;
         m_vertices[i*6+2].normal=ray;
         m_vertices[i*6+3].normal=ray;
+    }
+
+    //normals
+    for (size_t i=0; i<m_num_rays; i++)
+    {
+        m_vertices[i*6  ].normal=axis;
+        m_vertices[i*6+1].normal=(m_vertices[i*6].position-m_vertices[i*6+1].position).crossProduct(m_vertices[i*6].position-m_vertices[((i+1)%m_num_rays)*6+1].position)/m_norm_y;
         m_vertices[i*6+4].normal=(m_vertices[i*6+4].position-m_vertices[i*6+5].position).crossProduct(m_vertices[i*6+4].position-m_vertices[((i+1)%m_num_rays)*6+4].position)/m_norm_y;
         m_vertices[i*6+5].normal=-axis;
     }
@@ -22,13 +22,17 @@
 #include "FlexObj.h"
 
 #include "ApproxMath.h" // fast_normalise()
+#include "Application.h"
 #include "GfxActor.h"
+#include "ThreadPool.h"
 
 #include <Ogre.h>
 
 using namespace Ogre;
 using namespace RoR;
 
+static const size_t FLEXOBJ_CHUNK_SIZE = 2048; // Triangles or vertices per ParallelFor item, like flexbody chunks in `GfxScene`
+
 FlexObj::FlexObj(RoR::GfxActor* gfx_actor, node_t* all_nodes, std::vector<CabTexcoord>& texcoords, int numtriangles, 
                  int* triangles, std::vector<CabSubmesh>& submesh_defs, 
                  char* texname, const char* name, char* backtexname, char* transtexname):
@@ -83,7 +87,26 @@ FlexObj::FlexObj(RoR::GfxActor* gfx_actor, node_t* all_nodes, std::vector<CabTex
         m_s_ref[i]=v1.crossProduct(v2).length()*2.0;
     }
 
-    this->UpdateMesh(); // Initialize the dynamic mesh
+    // Triangles adjacent to each vertex, ordered like the old per-triangle accumulation
+    m_vertex_tri_offsets.assign(m_vertex_count + 1, 0);
+    for (size_t i = 0; i < m_index_count; i++)
+    {
+        m_vertex_tri_offsets[m_indices[i] + 1]++;
+    }
+    for (size_t i = 0; i < m_vertex_count; i++)
+    {
+        m_vertex_tri_offsets[i + 1] += m_vertex_tri_offsets[i];
+    }
+    m_vertex_tri_list.resize(m_index_count);
+    std::vector<int> fill(m_vertex_tri_offsets.begin(), m_vertex_tri_offsets.end() - 1);
+    for (size_t i = 0; i < m_index_count; i++)
+    {
+        m_vertex_tri_list[fill[m_indices[i]]++] = static_cast<int>(i / 3);
+    }
+    m_tri_normals.resize(numtriangles);
+    m_tri_oversized.resize(numtriangles);
+
+    this->ComputeFlexObj(); // Initialize the dynamic mesh
 
     // Create vertex data structure for vertices shared between submeshes
     m_mesh->sharedVertexData = new VertexData();
@@ -183,19 +206,10 @@ int FlexObj::ComputeVertexPos(int tidx, int v, std::vector<CabSubmesh>& submeshe
     return 0;
 }
 
-Vector3 FlexObj::UpdateMesh()
+void FlexObj::ComputeTriangles(size_t begin, size_t end)
 {
     RoR::NodeSB* all_nodes = m_gfx_actor->GetSimNodeBuffer();
-    Ogre::Vector3 center=(all_nodes[m_vertex_nodes[0]].AbsPosition+all_nodes[m_vertex_nodes[1]].AbsPosition)/2.0;
-    for (size_t i=0; i<m_vertex_count; i++)
-    {
-        //set position
-        m_vertices[i].position=all_nodes[m_vertex_nodes[i]].AbsPosition-center;
-        //reset normals
-        m_vertices[i].normal=Vector3::ZERO;
-    }
-    //accumulate normals per triangle
-    for (size_t i=0; i<m_index_count/3; i++)
+    for (size_t i=begin; i<end; i++)
     {
         Vector3 v1, v2;
         v1=all_nodes[m_vertex_nodes[m_indices[i*3+1]]].AbsPosition-all_nodes[m_vertex_nodes[m_indices[i*3]]].AbsPosition;
@@ -204,34 +218,73 @@ Vector3 FlexObj::UpdateMesh()
         float s=v1.length();
 
         //avoid large tris
-        if (s>m_s_ref[i])
+        m_tri_oversized[i] = (s>m_s_ref[i]);
+
+        m_tri_normals[i] = (s == 0) ? Vector3::ZERO : v1/s;
+    }
+}
+
+void FlexObj::ComputeVertices(size_t begin, size_t end, Ogre::Vector3 const& center)
+{
+    RoR::NodeSB* all_nodes = m_gfx_actor->GetSimNodeBuffer();
+    for (size_t i=begin; i<end; i++)
+    {
+        m_vertices[i].position=all_nodes[m_vertex_nodes[i]].AbsPosition-center;
+
+        Vector3 normal = Vector3::ZERO;
+        for (int t = m_vertex_tri_offsets[i]; t < m_vertex_tri_offsets[i + 1]; t++)
+        {
+            normal += m_tri_normals[m_vertex_tri_list[t]];
+        }
+        m_vertices[i].normal = approx_normalise(normal);
+    }
+}
+
+void FlexObj::FixOversizedTriangles()
+{
+    // Each fix may move a vertex used by a later triangle - keep the original order
+    for (int i=0; i<m_triangle_count; i++)
+    {
+        if (m_tri_oversized[i])
         {
             m_vertices[m_indices[i*3+1]].position=m_vertices[m_indices[i*3]].position+Vector3(0.1,0,0);
             m_vertices[m_indices[i*3+2]].position=m_vertices[m_indices[i*3]].position+Vector3(0,0,0.1);
         }
+    }
+}
 
-        if (s == 0)
-            continue;
+void FlexObj::ComputeFlexObj()
+{
+    RoR::NodeSB* all_nodes = m_gfx_actor->GetSimNodeBuffer();
+    const Ogre::Vector3 center=(all_nodes[m_vertex_nodes[0]].AbsPosition+all_nodes[m_vertex_nodes[1]].AbsPosition)/2.0;
+    const size_t num_tris = static_cast<size_t>(m_triangle_count);
 
-        v1=v1/s;
-        m_vertices[m_indices[i*3]].normal+=v1;
-        m_vertices[m_indices[i*3+1]].normal+=v1;
-        m_vertices[m_indices[i*3+2]].normal+=v1;
+    if (num_tris <= FLEXOBJ_CHUNK_SIZE && m_vertex_count <= FLEXOBJ_CHUNK_SIZE)
+    {
+        this->ComputeTriangles(0, num_tris);
+        this->ComputeVertices(0, m_vertex_count, center);
     }
-    //normalize
-    for (size_t i=0; i<m_vertex_count; i++)
+    else
     {
-        m_vertices[i].normal = approx_normalise(m_vertices[i].normal);
+        // Big cabs would otherwise keep a single worker busy; called from `GfxActor::ComputeVisuals()` on the threadpool already
+        App::GetThreadPool()->ParallelFor((num_tris + FLEXOBJ_CHUNK_SIZE - 1) / FLEXOBJ_CHUNK_SIZE, [this, num_tris](size_t chunk)
+            {
+                this->ComputeTriangles(chunk * FLEXOBJ_CHUNK_SIZE, std::min((chunk + 1) * FLEXOBJ_CHUNK_SIZE, num_tris));
+            });
+        App::GetThreadPool()->ParallelFor((m_vertex_count + FLEXOBJ_CHUNK_SIZE - 1) / FLEXOBJ_CHUNK_SIZE, [this, &center](size_t chunk)
+            {
+                this->ComputeVertices(chunk * FLEXOBJ_CHUNK_SIZE, std::min((chunk + 1) * FLEXOBJ_CHUNK_SIZE, m_vertex_count), center);
+            });
     }
 
-    return center;
+    this->FixOversizedTriangles();
+    m_center = center;
 }
 
-Vector3 FlexObj::UpdateFlexObj()
+Vector3 FlexObj::UploadFlexObj()
 {
-    Ogre::Vector3 center = this->UpdateMesh();
     m_hw_vbuf->writeData(0, m_hw_vbuf->getSizeInBytes(), m_vertices_raw, true);
-    return center;
+    return m_center;
 }
 
 FlexObj::~FlexObj()
@@ -74,7 +74,8 @@ public:
 
     ~FlexObj();
 
-    Ogre::Vector3   UpdateFlexObj();
+    void            ComputeFlexObj(); //!< Updates the CPU copy of vertices; doesn't touch OGRE, safe to run on a worker thread. Big meshes are split across the threadpool.
+    Ogre::Vector3   UploadFlexObj(); //!< Main thread only; returns the mesh center.
     void            ScaleFlexObj(float factor);
 
 private:
@@ -88,13 +89,16 @@ private:
 
     /// Compute vertex position in the vertexbuffer (0-based offset) for node `v` of triangle `tidx`
     int             ComputeVertexPos(int tidx, int v, std::vector<CabSubmesh>& submeshes);
-    Ogre::Vector3   UpdateMesh();
+    void            ComputeTriangles(size_t begin, size_t end); //!< Unit normals and size check; disjoint ranges may run in parallel.
+    void            ComputeVertices(size_t begin, size_t end, Ogre::Vector3 const& center); //!< Positions and gathered normals; disjoint ranges may run in parallel.
+    void            FixOversizedTriangles(); //!< Serial, in triangle order
 
     Ogre::MeshPtr               m_mesh;
     std::vector<Ogre::SubMesh*> m_submeshes;
     RoR::GfxActor*              m_gfx_actor;
     float*                      m_s_ref;
 
+    Ogre::Vector3               m_center = Ogre::Vector3::ZERO; //!< Computed along with vertices
     size_t                      m_vertex_count;
     int*                        m_vertex_nodes;
     Ogre::VertexDeclaration*    m_vertex_format;
@@ -108,6 +112,12 @@ private:
     size_t                      m_index_count;
     unsigned short*             m_indices;
     int                         m_triangle_count;	
+
+    // Normals are gathered per vertex instead of scattered per triangle, so vertex ranges are independent
+    std::vector<int>            m_vertex_tri_offsets;  //!< Per vertex (+1), index into `m_vertex_tri_list`
+    std::vector<int>            m_vertex_tri_list;     //!< Adjacent triangles, in triangle order
+    std::vector<Ogre::Vector3>  m_tri_normals;         //!< Scratch; zero for degenerate triangles
+    std::vector<char>           m_tri_oversized;       //!< Scratch; stretched beyond `m_s_ref`
 };
 
 /// @} // addtogroup Flex
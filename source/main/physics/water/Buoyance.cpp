@@ -28,6 +28,7 @@
 #include "DustPool.h"
 #include "Terrain.h"
 #include "Water.h"
+#include "WaveField.h"
 
 using namespace Ogre;
 using namespace RoR;
@@ -51,7 +52,7 @@ inline float Buoyance::computeVolume(Vector3 o, Vector3 a, Vector3 b, Vector3 c)
 }
 
 //compute pressure and drag force on a submerged triangle
-Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vector3 vel, int type)
+Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, float ha, float hb, float hc, Vector3 vel, int type)
 {
     //compute normal vector
     Vector3 normal = (b - a).crossProduct(c - a);
@@ -64,9 +65,9 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
     if (type != BUOY_DRAGONLY)
     {
         //compute pression prism points
-        Vector3 ap = a + (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a) - a.y) * 9810 * normal;
-        Vector3 bp = b + (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b) - b.y) * 9810 * normal;
-        Vector3 cp = c + (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c) - c.y) * 9810 * normal;
+        Vector3 ap = a + (ha - a.y) * 9810 * normal;
+        Vector3 bp = b + (hb - b.y) * 9810 * normal;
+        Vector3 cp = c + (hc - c.y) * 9810 * normal;
         //find centroid
         Vector3 ctd = (a + b + c + ap + bp + cp) / 6.0;
         //compute volume
@@ -86,7 +87,7 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
         //take in account the wave speed
         //compute center
         Vector3 tc = (a + b + c) / 3.0;
-        vel = vel - App::GetGameContext()->GetTerrain()->getWater()->CalcWavesVelocity(tc);
+        vel = vel - m_waves->CalcWavesVelocity(tc);
         float vell = vel.length();
         if (vell > 0.01)
         {
@@ -104,13 +105,13 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
                     if (fxdir.y < 0)
                         fxdir.y = -fxdir.y;
 
-                    if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a) - a.y < 0.1)
+                    if (ha - a.y < 0.1)
                         splashp->malloc(a, fxdir);
 
-                    else if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b) - b.y < 0.1)
+                    else if (hb - b.y < 0.1)
                         splashp->malloc(b, fxdir);
 
-                    else if (App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c) - c.y < 0.1)
+                    else if (hc - c.y < 0.1)
                         splashp->malloc(c, fxdir);
                 }
             }
@@ -123,9 +124,10 @@ Vector3 Buoyance::computePressureForceSub(Vector3 a, Vector3 b, Vector3 c, Vecto
 }
 
 //compute pressure and drag forces on a random triangle
-Vector3 Buoyance::computePressureForce(Vector3 a, Vector3 b, Vector3 c, Vector3 vel, int type)
+//`ha`, `hb` and `hc` are the wave heights at the corners; only the points where the waterline cuts the triangle are queried
+Vector3 Buoyance::computePressureForce(Vector3 a, Vector3 b, Vector3 c, float ha, float hb, float hc, Vector3 vel, int type)
 {
-    float wha = App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight((a + b + c) / 3.0);
+    float wha = m_waves->CalcWavesHeight((a + b + c) / 3.0);
     //check if fully emerged
     if (a.y > wha && b.y > wha && c.y > wha)
         return Vector3::ZERO;
@@ -136,52 +138,66 @@ Vector3 Buoyance::computePressureForce(Vector3 a, Vector3 b, Vector3 c, Vector3
         //one dip
         if (a.y < wha && b.y > wha && c.y > wha)
         {
-            return computePressureForceSub(a, a + (wha - a.y) / (b.y - a.y) * (b - a), a + (wha - a.y) / (c.y - a.y) * (c - a), vel, type);
+            Vector3 tb = a + (wha - a.y) / (b.y - a.y) * (b - a);
+            Vector3 tc = a + (wha - a.y) / (c.y - a.y) * (c - a);
+            return computePressureForceSub(a, tb, tc, ha, m_waves->CalcWavesHeight(tb), m_waves->CalcWavesHeight(tc), vel, type);
         }
         if (b.y < wha && c.y > wha && a.y > wha)
         {
-            return computePressureForceSub(b, b + (wha - b.y) / (c.y - b.y) * (c - b), b + (wha - b.y) / (a.y - b.y) * (a - b), vel, type);
+            Vector3 tc = b + (wha - b.y) / (c.y - b.y) * (c - b);
+            Vector3 ta = b + (wha - b.y) / (a.y - b.y) * (a - b);
+            return computePressureForceSub(b, tc, ta, hb, m_waves->CalcWavesHeight(tc), m_waves->CalcWavesHeight(ta), vel, type);
         }
         if (c.y < wha && a.y > wha && b.y > wha)
         {
-            return computePressureForceSub(c, c + (wha - c.y) / (a.y - c.y) * (a - c), c + (wha - c.y) / (b.y - c.y) * (b - c), vel, type);
+            Vector3 ta = c + (wha - c.y) / (a.y - c.y) * (a - c);
+            Vector3 tb = c + (wha - c.y) / (b.y - c.y) * (b - c);
+            return computePressureForceSub(c, ta, tb, hc, m_waves->CalcWavesHeight(ta), m_waves->CalcWavesHeight(tb), vel, type);
         }
         //two dips
         if (a.y > wha && b.y < wha && c.y < wha)
         {
             Vector3 tb = a + (wha - a.y) / (b.y - a.y) * (b - a);
             Vector3 tc = a + (wha - a.y) / (c.y - a.y) * (c - a);
-            Vector3 f = computePressureForceSub(tb, b, tc, vel, type);
-            return f + computePressureForceSub(tc, b, c, vel, type);
+            float htb = m_waves->CalcWavesHeight(tb);
+            float htc = m_waves->CalcWavesHeight(tc);
+            Vector3 f = computePressureForceSub(tb, b, tc, htb, hb, htc, vel, type);
+            return f + computePressureForceSub(tc, b, c, htc, hb, hc, vel, type);
         }
         if (b.y > wha && c.y < wha && a.y < wha)
         {
             Vector3 tc = b + (wha - b.y) / (c.y - b.y) * (c - b);
             Vector3 ta = b + (wha - b.y) / (a.y - b.y) * (a - b);
-            Vector3 f = computePressureForceSub(tc, c, ta, vel, type);
-            return f + computePressureForceSub(ta, c, a, vel, type);
+            float htc = m_waves->CalcWavesHeight(tc);
+            float hta = m_waves->CalcWavesHeight(ta);
+            Vector3 f = computePressureForceSub(tc, c, ta, htc, hc, hta, vel, type);
+            return f + computePressureForceSub(ta, c, a, hta, hc, ha, vel, type);
         }
         if (c.y > wha && a.y < wha && b.y < wha)
         {
             Vector3 ta = c + (wha - c.y) / (a.y - c.y) * (a - c);
             Vector3 tb = c + (wha - c.y) / (b.y - c.y) * (b - c);
-            Vector3 f = computePressureForceSub(ta, a, tb, vel, type);
-            return f + computePressureForceSub(tb, a, b, vel, type);
+            float hta = m_waves->CalcWavesHeight(ta);
+            float htb = m_waves->CalcWavesHeight(tb);
+            Vector3 f = computePressureForceSub(ta, a, tb, hta, ha, htb, vel, type);
+            return f + computePressureForceSub(tb, a, b, htb, ha, hb, vel, type);
         }
         return Vector3::ZERO;
     }
     else
     {
         //fully submerged case
-        return computePressureForceSub(a, b, c, vel, type);
+        return computePressureForceSub(a, b, c, ha, hb, hc, vel, type);
     }
 }
 
-void Buoyance::computeNodeForce(node_t* a, node_t* b, node_t* c, bool doUpdate, int type)
+void Buoyance::computeNodeForce(node_t* a, node_t* b, node_t* c, float ha, float hb, float hc, bool doUpdate, int type, WaveField const& waves)
 {
-    if (a->AbsPosition.y > App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(a->AbsPosition) &&
-        b->AbsPosition.y > App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(b->AbsPosition) &&
-        c->AbsPosition.y > App::GetGameContext()->GetTerrain()->getWater()->CalcWavesHeight(c->AbsPosition))
+    m_waves = &waves;
+
+    if (a->AbsPosition.y > ha &&
+        b->AbsPosition.y > hb &&
+        c->AbsPosition.y > hc)
         return;
 
     update = doUpdate;
@@ -205,8 +221,14 @@ void Buoyance::computeNodeForce(node_t* a, node_t* b, node_t* c, bool doUpdate,
     Vector3 mca = (c->AbsPosition + a->AbsPosition) / 2.0;
     Vector3 vel = (a->Velocity + b->Velocity + c->Velocity) / 3.0;
 
+    //the 6 sub-triangles share these points
+    float hm = m_waves->CalcWavesHeight(m);
+    float hmab = m_waves->CalcWavesHeight(mab);
+    float hmbc = m_waves->CalcWavesHeight(mbc);
+    float hmca = m_waves->CalcWavesHeight(mca);
+
     //apply forces
-    a->Forces += computePressureForce(a->AbsPosition, mab, m, vel, type) + computePressureForce(a->AbsPosition, m, mca, vel, type);
-    b->Forces += computePressureForce(b->AbsPosition, mbc, m, vel, type) + computePressureForce(b->AbsPosition, m, mab, vel, type);
-    c->Forces += computePressureForce(c->AbsPosition, mca, m, vel, type) + computePressureForce(c->AbsPosition, m, mbc, vel, type);
+    a->Forces += computePressureForce(a->AbsPosition, mab, m, ha, hmab, hm, vel, type) + computePressureForce(a->AbsPosition, m, mca, ha, hm, hmca, vel, type);
+    b->Forces += computePressureForce(b->AbsPosition, mbc, m, hb, hmbc, hm, vel, type) + computePressureForce(b->AbsPosition, m, mab, hb, hm, hmab, vel, type);
+    c->Forces += computePressureForce(c->AbsPosition, mca, m, hc, hmca, hm, vel, type) + computePressureForce(c->AbsPosition, m, mbc, hc, hm, hmbc, vel, type);
 }
@@ -34,7 +34,9 @@ public:
     Buoyance(DustPool* splash, DustPool* ripple);
     ~Buoyance();
 
-    void computeNodeForce(node_t *a, node_t *b, node_t *c, bool doUpdate, int type);
+    /// @param ha,hb,hc Wave heights at the nodes; nodes are shared by several cabs, the caller samples each once per step.
+    /// @param waves Must be updated for this step, see `WaveField::UpdateWaveField()`
+    void computeNodeForce(node_t *a, node_t *b, node_t *c, float ha, float hb, float hc, bool doUpdate, int type, WaveField const& waves);
 
     enum { BUOY_NORMAL, BUOY_DRAGONLY, BUOY_DRAGLESS };
 
@@ -46,13 +48,14 @@ private:
     inline float computeVolume(Ogre::Vector3 o, Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c);
 
     //compute pressure and drag force on a submerged triangle
-    Ogre::Vector3 computePressureForceSub(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, Ogre::Vector3 vel, int type);
+    Ogre::Vector3 computePressureForceSub(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, float ha, float hb, float hc, Ogre::Vector3 vel, int type);
     
     //compute pressure and drag forces on a random triangle
-    Ogre::Vector3 computePressureForce(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, Ogre::Vector3 vel, int type);
+    Ogre::Vector3 computePressureForce(Ogre::Vector3 a, Ogre::Vector3 b, Ogre::Vector3 c, float ha, float hb, float hc, Ogre::Vector3 vel, int type);
     
     DustPool *splashp, *ripplep;
     bool update;
+    WaveField const* m_waves = nullptr; //!< Set by `computeNodeForce()`
 };
 
 /// @} // addtogroup Physics
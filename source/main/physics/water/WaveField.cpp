@@ -0,0 +1,154 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "WaveField.h"
+
+#include "IWater.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Ogre;
+using namespace RoR;
+
+// Bilinear error is about (cell * PI / wavelength)^2 / 2 of the amplitude;
+// with the stock 'wavefield.cfg' that's ~1cm at 0.5m and ~5cm at 1m cells.
+static const float WAVEFIELD_CELL_SIZE     = 0.5f;
+static const float WAVEFIELD_MAX_CELL_SIZE = 1.0f;
+static const float WAVEFIELD_MARGIN        = 1.0f; // Nodes move a little during the step
+
+void WaveField::UpdateWaveField(IWater* water, Ogre::AxisAlignedBox const& area, size_t expected_queries, bool with_velocity)
+{
+    m_water = water;
+    m_active = false;
+    if (!water || !water->AreWavesEnabled() || area.isNull() || expected_queries == 0)
+    {
+        return;
+    }
+
+    // Nodes high above the waves never query them
+    const Vector3 min = area.getMinimum() - WAVEFIELD_MARGIN;
+    const Vector3 max = area.getMaximum() + WAVEFIELD_MARGIN;
+    if (min.y > water->GetStaticWaterHeight() + water->GetMaxWavesAmplitude())
+    {
+        return;
+    }
+
+    // Coarsen the grid until it's cheaper than querying the water directly, or give up
+    const int samples_per_query = (with_velocity) ? 2 : 1;
+    float cell_size = WAVEFIELD_CELL_SIZE;
+    int num_x = 0, num_z = 0;
+    for (;;)
+    {
+        num_x = std::max(1, static_cast<int>(std::ceil((max.x - min.x) / cell_size)));
+        num_z = std::max(1, static_cast<int>(std::ceil((max.z - min.z) / cell_size)));
+        if (static_cast<size_t>((num_x + 1) * (num_z + 1) * samples_per_query) <= expected_queries)
+            break;
+        cell_size *= 2.f;
+        if (cell_size > WAVEFIELD_MAX_CELL_SIZE)
+            return;
+    }
+
+    m_origin_x = min.x;
+    m_origin_z = min.z;
+    m_inv_cell_size = 1.f / cell_size;
+    m_num_cells_x = num_x;
+    m_num_cells_z = num_z;
+    m_has_velocity = with_velocity;
+    m_heights.resize((num_x + 1) * (num_z + 1));
+    m_velocities.resize((with_velocity) ? m_heights.size() : 0);
+
+    // Sample just below the water, so that `IWater` doesn't skip the waves for points above them
+    const float sample_y = water->GetStaticWaterHeight() - water->GetMaxWavesAmplitude();
+    size_t index = 0;
+    for (int z = 0; z <= num_z; z++)
+    {
+        for (int x = 0; x <= num_x; x++, index++)
+        {
+            const Vector3 pos(m_origin_x + x * cell_size, sample_y, m_origin_z + z * cell_size);
+            m_heights[index] = water->CalcWavesHeight(pos);
+            if (with_velocity)
+            {
+                m_velocities[index] = water->CalcWavesVelocity(pos);
+            }
+        }
+    }
+    m_active = true;
+}
+
+bool WaveField::LocateCell(Ogre::Vector3 const& pos, size_t& out_index, float& out_fx, float& out_fz) const
+{
+    if (!m_active)
+        return false;
+
+    const float gx = (pos.x - m_origin_x) * m_inv_cell_size;
+    const float gz = (pos.z - m_origin_z) * m_inv_cell_size;
+    if (gx < 0.f || gz < 0.f || gx >= m_num_cells_x || gz >= m_num_cells_z)
+        return false;
+
+    const int cx = static_cast<int>(gx);
+    const int cz = static_cast<int>(gz);
+    out_index = cz * (m_num_cells_x + 1) + cx;
+    out_fx = gx - cx;
+    out_fz = gz - cz;
+    return true;
+}
+
+float WaveField::CalcWavesHeight(Ogre::Vector3 const& pos) const
+{
+    size_t i; float fx, fz;
+    if (!this->LocateCell(pos, i, fx, fz))
+        return m_water->CalcWavesHeight(pos);
+
+    if (pos.y > m_water->GetStaticWaterHeight() + m_water->GetMaxWavesAmplitude())
+        return m_water->GetStaticWaterHeight(); // Same shortcut as `Water::CalcWavesHeight()`
+
+    const size_t row = m_num_cells_x + 1;
+    const float h0 = m_heights[i]       + (m_heights[i + 1]       - m_heights[i])       * fx;
+    const float h1 = m_heights[i + row] + (m_heights[i + row + 1] - m_heights[i + row]) * fx;
+    return h0 + (h1 - h0) * fz;
+}
+
+Ogre::Vector3 WaveField::CalcWavesVelocity(Ogre::Vector3 const& pos) const
+{
+    size_t i; float fx, fz;
+    if (!m_has_velocity || !this->LocateCell(pos, i, fx, fz))
+        return m_water->CalcWavesVelocity(pos);
+
+    if (pos.y > m_water->GetStaticWaterHeight() + m_water->GetMaxWavesAmplitude())
+        return Vector3::ZERO; // Same shortcut as `Water::CalcWavesVelocity()`
+
+    const size_t row = m_num_cells_x + 1;
+    const Vector3 v0 = m_velocities[i]       + (m_velocities[i + 1]       - m_velocities[i])       * fx;
+    const Vector3 v1 = m_velocities[i + row] + (m_velocities[i + row + 1] - m_velocities[i + row]) * fx;
+    return v0 + (v1 - v0) * fz;
+}
+
+bool WaveField::IsUnderWater(Ogre::Vector3 const& pos) const
+{
+    if (!m_active)
+        return m_water->IsUnderWater(pos);
+
+    if (pos.y > m_water->GetStaticWaterHeight() + m_water->GetMaxWavesAmplitude())
+        return false; // Above the highest possible wave, see `Water::IsUnderWater()`
+
+    return pos.y < this->CalcWavesHeight(pos);
+}
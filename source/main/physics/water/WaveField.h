@@ -0,0 +1,65 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <Ogre.h>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Physics
+/// @{
+
+/// Waves sampled on a grid around one actor, refreshed once per physics step.
+/// Buoyancy and the per-node under-water test query the water many times per step
+/// within a small area; each `IWater` query sums all wave trains, the grid is
+/// sampled bilinearly instead. Queries outside the grid go to `IWater` directly.
+class WaveField
+{
+public:
+    /// @param expected_queries Rough number of queries in this step; the grid is only built if it's cheaper than that.
+    void           UpdateWaveField(IWater* water, Ogre::AxisAlignedBox const& area, size_t expected_queries, bool with_velocity);
+
+    float          CalcWavesHeight(Ogre::Vector3 const& pos) const;
+    Ogre::Vector3  CalcWavesVelocity(Ogre::Vector3 const& pos) const;
+    bool           IsUnderWater(Ogre::Vector3 const& pos) const;
+
+private:
+    bool           LocateCell(Ogre::Vector3 const& pos, size_t& out_index, float& out_fx, float& out_fz) const;
+
+    IWater*                    m_water = nullptr;
+    bool                       m_active = false;
+    bool                       m_has_velocity = false;
+    float                      m_origin_x = 0.f;
+    float                      m_origin_z = 0.f;
+    float                      m_inv_cell_size = 0.f;
+    int                        m_num_cells_x = 0;
+    int                        m_num_cells_z = 0;
+    std::vector<float>         m_heights;    //!< (m_num_cells_x + 1) * (m_num_cells_z + 1) samples, X-major rows
+    std::vector<Ogre::Vector3> m_velocities; //!< Same layout as `m_heights`
+};
+
+/// @} // addtogroup Physics
+
+} // namespace RoR
@@ -37,11 +37,13 @@
 #include "GfxScene.h"
 #include "Language.h"
 #include "PlatformUtils.h"
+#include "RigDef_BinarySerializer.h"
 #include "RigDef_Parser.h"
 
 #include "SkinFileFormat.h"
 #include "Terrain.h"
 #include "Terrn2FileFormat.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 
 #include <OgreFileSystem.h>
@@ -49,51 +51,51 @@
 #include <rapidjson/istreamwrapper.h>
 #include <rapidjson/ostreamwrapper.h>
 #include <rapidjson/writer.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <iterator>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
 
 using namespace Ogre;
 using namespace RoR;
 
+static const size_t FUZZY_SEARCH_MIN_LENGTH = 5;    // Shorter queries match exactly or not at all
+static const float  FUZZY_SEARCH_MIN_HITS   = 0.6f; // Portion of the query's trigrams which a fuzzy match must contain
+static const size_t FUZZY_SEARCH_SCORE      = 1000; // Ranks fuzzy matches below exact ones
+
+static const std::string* InternCacheString(std::string const& str)
+{
+    static std::mutex pool_mutex; // Entries are filled in on the thread pool, see `FlushPendingEntries()`
+    static std::unordered_set<std::string> pool; // Node-based, pooled strings never move
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    return &*pool.insert(str).first;
+}
+
+CacheString::CacheString()
+{
+    static const std::string* empty_str = InternCacheString("");
+    m_str = empty_str;
+}
+
+CacheString::CacheString(std::string const& str):
+    m_str(InternCacheString(str))
+{
+}
+
 CacheEntry::CacheEntry() :
     addtimestamp(0),
-    beamcount(0),
     categoryid(0),
-    commandscount(0),
-    custom_particles(false),
-    customtach(false),
     deleted(false),
+    details_bin_index(CACHE_BIN_INDEX_NONE),
     driveable(NOT_DRIVEABLE),
-    enginetype('t'), // enginetype = t = truck is default
-    exhaustscount(0),
-    fileformatversion(0),
     filetime(0),
-    fixescount(0),
-    flarescount(0),
-    flexbodiescount(0),
-    forwardcommands(false),
-    hasSubmeshs(false),
-    hydroscount(0),
-    importcommands(false),
-    loadmass(0),
-    maxrpm(0),
-    minrpm(0),
-    nodecount(0),
     number(0),
-    numgears(0),
-    propscount(0),
-    propwheelcount(0),
-    rescuer(false),
-    rotatorscount(0),
-    shockcount(0),
-    soundsourcescount(0),
-    torque(0),
-    truckmass(0),
-    turbojetcount(0),
-    turbopropscount(0),
     usagecounter(0),
-    version(0),
-    wheelcount(0),
-    wingscount(0)
+    version(0)
 {
 }
 
@@ -135,11 +137,13 @@ void CacheSystem::LoadModCache(CacheValidity validity)
         App::diag_log_console_echo->setVal(false);
         this->ParseZipArchives(RGN_CONTENT);
         this->ParseKnownFiles(RGN_CONTENT);
+        this->FlushPendingEntries();
         App::diag_log_console_echo->setVal(orig_echo);
         this->DetectDuplicates();
         this->WriteCacheFileJson();
+        this->WriteCacheFileBinary();
 
-        this->LoadCacheFileJson();
+        this->LoadCacheFile();
     }
 
     RoR::Log("[RoR|ModCache] Cache loaded");
@@ -180,7 +184,7 @@ CacheValidity CacheSystem::EvaluateCacheValidity()
     this->GenerateHashFromFilenames();
 
     // Load cache file
-    CacheValidity validity = this->LoadCacheFileJson();
+    CacheValidity validity = this->LoadCacheFile();
 
     if (validity != CacheValidity::VALID)
     {
@@ -195,15 +199,9 @@ CacheValidity CacheSystem::EvaluateCacheValidity()
         return CacheValidity::NEEDS_UPDATE;
     }
 
-    for (auto& entry : m_entries)
+    for (auto& fingerprint : m_bundle_fingerprints)
     {
-        std::string fn = entry.resource_bundle_path;
-        if (entry.resource_bundle_type == "FileSystem")
-        {
-            fn = PathCombine(fn, entry.fname);
-        }
-
-        if ((entry.filetime != RoR::GetFileLastModifiedTime(fn)))
+        if (!this->CheckBundleFingerprint(fingerprint.first))
         {
             return CacheValidity::NEEDS_UPDATE;
         }
@@ -215,6 +213,9 @@ CacheValidity CacheSystem::EvaluateCacheValidity()
 
 void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & out_entry)
 {
+    out_entry.details = std::make_shared<CacheEntryDetails>();
+    CacheEntryDetails& details = *out_entry.details;
+
     // Common details
     out_entry.usagecounter =           j_entry["usagecounter"].GetInt();
     out_entry.addtimestamp =           j_entry["addtimestamp"].GetInt();
@@ -234,14 +235,7 @@ void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & ou
     Ogre::StringUtil::trim(out_entry.guid);
 
     // Category
-    int category_id = j_entry["categoryid"].GetInt();
-    auto category_itor = m_categories.find(category_id);
-    if (category_itor == m_categories.end() || category_id >= CID_Max)
-    {
-        category_itor = m_categories.find(CID_Unsorted);
-    }
-    out_entry.categoryname = category_itor->second;
-    out_entry.categoryid = category_itor->first;
+    this->SetEntryCategory(out_entry, j_entry["categoryid"].GetInt());
 
      // Common - Authors
     for (rapidjson::Value& j_author: j_entry["authors"].GetArray())
@@ -253,45 +247,45 @@ void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & ou
         author.email =  j_author["email"].GetString();
         author.id    =  j_author["id"].GetInt();
 
-        out_entry.authors.push_back(author);
+        details.authors.push_back(author);
     }
 
     // Vehicle details
-    out_entry.description =       j_entry["description"].GetString();
-    out_entry.tags =              j_entry["tags"].GetString();
+    details.description =         j_entry["description"].GetString();
+    details.tags =                j_entry["tags"].GetString();
     out_entry.default_skin =      j_entry["default_skin"].GetString();
-    out_entry.fileformatversion = j_entry["fileformatversion"].GetInt();
-    out_entry.hasSubmeshs =       j_entry["hasSubmeshs"].GetBool();
-    out_entry.nodecount =         j_entry["nodecount"].GetInt();
-    out_entry.beamcount =         j_entry["beamcount"].GetInt();
-    out_entry.shockcount =        j_entry["shockcount"].GetInt();
-    out_entry.fixescount =        j_entry["fixescount"].GetInt();
-    out_entry.hydroscount =       j_entry["hydroscount"].GetInt();
-    out_entry.wheelcount =        j_entry["wheelcount"].GetInt();
-    out_entry.propwheelcount =    j_entry["propwheelcount"].GetInt();
-    out_entry.commandscount =     j_entry["commandscount"].GetInt();
-    out_entry.flarescount =       j_entry["flarescount"].GetInt();
-    out_entry.propscount =        j_entry["propscount"].GetInt();
-    out_entry.wingscount =        j_entry["wingscount"].GetInt();
-    out_entry.turbopropscount =   j_entry["turbopropscount"].GetInt();
-    out_entry.turbojetcount =     j_entry["turbojetcount"].GetInt();
-    out_entry.rotatorscount =     j_entry["rotatorscount"].GetInt();
-    out_entry.exhaustscount =     j_entry["exhaustscount"].GetInt();
-    out_entry.flexbodiescount =   j_entry["flexbodiescount"].GetInt();
-    out_entry.soundsourcescount = j_entry["soundsourcescount"].GetInt();
-    out_entry.truckmass =         j_entry["truckmass"].GetFloat();
-    out_entry.loadmass =          j_entry["loadmass"].GetFloat();
-    out_entry.minrpm =            j_entry["minrpm"].GetFloat();
-    out_entry.maxrpm =            j_entry["maxrpm"].GetFloat();
-    out_entry.torque =            j_entry["torque"].GetFloat();
-    out_entry.customtach =        j_entry["customtach"].GetBool();
-    out_entry.custom_particles =  j_entry["custom_particles"].GetBool();
-    out_entry.forwardcommands =   j_entry["forwardcommands"].GetBool();
-    out_entry.importcommands =    j_entry["importcommands"].GetBool();
-    out_entry.rescuer =           j_entry["rescuer"].GetBool();
+    details.fileformatversion =   j_entry["fileformatversion"].GetInt();
+    details.hasSubmeshs =         j_entry["hasSubmeshs"].GetBool();
+    details.nodecount =           j_entry["nodecount"].GetInt();
+    details.beamcount =           j_entry["beamcount"].GetInt();
+    details.shockcount =          j_entry["shockcount"].GetInt();
+    details.fixescount =          j_entry["fixescount"].GetInt();
+    details.hydroscount =         j_entry["hydroscount"].GetInt();
+    details.wheelcount =          j_entry["wheelcount"].GetInt();
+    details.propwheelcount =      j_entry["propwheelcount"].GetInt();
+    details.commandscount =       j_entry["commandscount"].GetInt();
+    details.flarescount =         j_entry["flarescount"].GetInt();
+    details.propscount =          j_entry["propscount"].GetInt();
+    details.wingscount =          j_entry["wingscount"].GetInt();
+    details.turbopropscount =     j_entry["turbopropscount"].GetInt();
+    details.turbojetcount =       j_entry["turbojetcount"].GetInt();
+    details.rotatorscount =       j_entry["rotatorscount"].GetInt();
+    details.exhaustscount =       j_entry["exhaustscount"].GetInt();
+    details.flexbodiescount =     j_entry["flexbodiescount"].GetInt();
+    details.soundsourcescount =   j_entry["soundsourcescount"].GetInt();
+    details.truckmass =           j_entry["truckmass"].GetFloat();
+    details.loadmass =            j_entry["loadmass"].GetFloat();
+    details.minrpm =              j_entry["minrpm"].GetFloat();
+    details.maxrpm =              j_entry["maxrpm"].GetFloat();
+    details.torque =              j_entry["torque"].GetFloat();
+    details.customtach =          j_entry["customtach"].GetBool();
+    details.custom_particles =    j_entry["custom_particles"].GetBool();
+    details.forwardcommands =     j_entry["forwardcommands"].GetBool();
+    details.importcommands =      j_entry["importcommands"].GetBool();
+    details.rescuer =             j_entry["rescuer"].GetBool();
     out_entry.driveable =         ActorType(j_entry["driveable"].GetInt());
-    out_entry.numgears =          j_entry["numgears"].GetInt();
-    out_entry.enginetype =        static_cast<char>(j_entry["enginetype"].GetInt());
+    details.numgears =            j_entry["numgears"].GetInt();
+    details.enginetype =          static_cast<char>(j_entry["enginetype"].GetInt());
 
     // Vehicle 'section-configs' (aka Modules in RigDef namespace)
     for (rapidjson::Value& j_module_name: j_entry["sectionconfigs"].GetArray())
@@ -303,7 +297,8 @@ void CacheSystem::ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & ou
 CacheValidity CacheSystem::LoadCacheFileJson()
 {
     // Clear existing entries
-    m_entries.clear();
+    this->ClearEntries();
+    m_bundle_fingerprints.clear();
 
     rapidjson::Document j_doc;
     if (!App::GetContentManager()->LoadAndParseJson(CACHE_FILE, RGN_CACHE, j_doc) ||
@@ -323,8 +318,17 @@ CacheValidity CacheSystem::LoadCacheFileJson()
     {
         CacheEntry entry;
         this->ImportEntryFromJson(j_entry, entry);
-        entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
-        m_entries.push_back(entry);
+        this->AddEntry(entry);
+    }
+
+    if (j_doc.HasMember("bundles") && j_doc["bundles"].IsArray())
+    {
+        for (rapidjson::Value& j_bundle: j_doc["bundles"].GetArray())
+        {
+            BundleFingerprint& fingerprint = m_bundle_fingerprints[j_bundle["path"].GetString()];
+            fingerprint.size = j_bundle["size"].GetUint64();
+            fingerprint.filetime = static_cast<std::time_t>(j_bundle["filetime"].GetInt64());
+        }
     }
 
     m_filenames_hash_loaded = j_doc["global_hash"].GetString();
@@ -334,9 +338,23 @@ CacheValidity CacheSystem::LoadCacheFileJson()
 
 void CacheSystem::PruneCache()
 {
-    this->LoadCacheFileJson();
+    this->LoadCacheFile();
+
+    // Unchanged files are kept verbatim, removed or modified ones are forgotten and (re)scanned
+    for (auto itor = m_bundle_fingerprints.begin(); itor != m_bundle_fingerprints.end(); )
+    {
+        if (this->CheckBundleFingerprint(itor->first))
+        {
+            m_resource_paths.insert(itor->first);
+            ++itor;
+        }
+        else
+        {
+            RoR::LogFormat("[RoR|ModCache] Removing '%s'", itor->first.c_str());
+            itor = m_bundle_fingerprints.erase(itor);
+        }
+    }
 
-    std::vector<String> paths;
     for (auto& entry : m_entries)
     {
         std::string fn = entry.resource_bundle_path;
@@ -345,26 +363,34 @@ void CacheSystem::PruneCache()
             fn = PathCombine(fn, entry.fname);
         }
 
-        if (!RoR::FileExists(fn.c_str()) || (entry.filetime != RoR::GetFileLastModifiedTime(fn)))
+        if (m_resource_paths.find(fn) == m_resource_paths.end())
         {
             if (!entry.deleted)
             {
-                if (std::find(paths.begin(), paths.end(), fn) == paths.end())
-                {
-                    RoR::LogFormat("[RoR|ModCache] Removing '%s'", fn.c_str());
-                    paths.push_back(fn);
-                }
                 this->RemoveFileCache(entry);
             }
             entry.deleted = true;
         }
-        else
-        {
-            m_resource_paths.insert(fn);
-        }
     }
 }
 
+std::time_t CacheSystem::UpdateBundleFingerprint(std::string const& path)
+{
+    BundleFingerprint& fingerprint = m_bundle_fingerprints[path];
+    fingerprint.size = RoR::GetFileSizeBytes(path);
+    fingerprint.filetime = RoR::GetFileLastModifiedTime(path);
+    return fingerprint.filetime;
+}
+
+bool CacheSystem::CheckBundleFingerprint(std::string const& path) const
+{
+    auto itor = m_bundle_fingerprints.find(path);
+    return itor != m_bundle_fingerprints.end() &&
+           RoR::FileExists(path) &&
+           RoR::GetFileSizeBytes(path) == itor->second.size && // Cheap, check first
+           RoR::GetFileLastModifiedTime(path) == itor->second.filetime;
+}
+
 void CacheSystem::ClearResourceGroups()
 {
     for (auto& entry : m_entries)
@@ -378,63 +404,120 @@ void CacheSystem::ClearResourceGroups()
     }
 }
 
-void CacheSystem::DetectDuplicates()
+static uint32_t MakeSearchTrigram(const char* str)
 {
-    RoR::Log("[RoR|ModCache] Searching for duplicates ...");
-    std::map<String, String> possible_duplicates;
-    for (int i=0; i<m_entries.size(); i++) 
-    {
-        if (m_entries[i].deleted)
-            continue;
+    return  static_cast<uint32_t>(static_cast<uint8_t>(str[0]))        |
+           (static_cast<uint32_t>(static_cast<uint8_t>(str[1])) << 8)  |
+           (static_cast<uint32_t>(static_cast<uint8_t>(str[2])) << 16);
+}
+
+static std::string ToLowerCaseCopy(std::string str)
+{
+    Ogre::StringUtil::toLowerCase(str);
+    return str;
+}
+
+void CacheSystem::AddEntry(CacheEntry& entry)
+{
+    const uint32_t index = static_cast<uint32_t>(m_entries.size());
+    entry.number = static_cast<int>(index + 1); // Let's number mods from 1
+    m_duplicate_index[CacheSystem::GetDuplicateKey(entry)].push_back(index);
 
-        String dnameA = m_entries[i].dname;
-        StringUtil::toLowerCase(dnameA);
-        StringUtil::trim(dnameA);
-        String dirA = m_entries[i].resource_bundle_path;
-        StringUtil::toLowerCase(dirA);
-        String basenameA, basepathA;
-        StringUtil::splitFilename(dirA, basenameA, basepathA);
-        String filenameWUIDA = m_entries[i].fname_without_uid;
-        StringUtil::toLowerCase(filenameWUIDA);
+    CacheEntryDetails const& details = this->GetEntryDetails(entry);
+    SearchFields fields;
+    fields.dname          = ToLowerCaseCopy(entry.dname);
+    fields.fname          = ToLowerCaseCopy(entry.fname);
+    fields.description    = ToLowerCaseCopy(details.description);
+    fields.guid           = ToLowerCaseCopy(entry.guid);
+    fields.wheelcount     = details.wheelcount;
+    fields.propwheelcount = details.propwheelcount;
+    for (AuthorInfo const& author: details.authors)
+    {
+        fields.author_names.push_back(ToLowerCaseCopy(author.name));
+        fields.author_emails.push_back(ToLowerCaseCopy(author.email));
+    }
 
-        for (int j=i+1; j<m_entries.size(); j++) 
+    auto index_text = [this, index](std::string const& text)
+    {
+        for (size_t i = 0; i + 3 <= text.size(); i++)
         {
-            if (m_entries[j].deleted)
-                continue;
+            std::vector<uint32_t>& entries = m_search_trigrams[MakeSearchTrigram(&text[i])];
+            if (entries.empty() || entries.back() != index)
+            {
+                entries.push_back(index);
+            }
+        }
+    };
+    index_text(fields.dname);
+    index_text(fields.fname);
+    index_text(fields.description);
+    for (std::string const& name: fields.author_names)
+        index_text(name);
+    for (std::string const& email: fields.author_emails)
+        index_text(email);
+
+    m_search_fields.push_back(fields);
+    m_entries.push_back(entry);
+}
 
-            String filenameWUIDB = m_entries[j].fname_without_uid;
-            StringUtil::toLowerCase(filenameWUIDB);
-            if (filenameWUIDA != filenameWUIDB)
-                continue;
+void CacheSystem::ClearEntries()
+{
+    m_entries.clear();
+    m_duplicate_index.clear();
+    m_search_fields.clear();
+    m_search_trigrams.clear();
+}
 
-            String dnameB = m_entries[j].dname;
-            StringUtil::toLowerCase(dnameB);
-            StringUtil::trim(dnameB);
-            if (dnameA != dnameB)
-                continue;
+std::string CacheSystem::GetDuplicateKey(CacheEntry const& entry)
+{
+    String filename_wuid = entry.fname_without_uid;
+    StringUtil::toLowerCase(filename_wuid);
+
+    String dname = entry.dname;
+    StringUtil::toLowerCase(dname);
+    StringUtil::trim(dname);
+
+    String dir = entry.resource_bundle_path;
+    StringUtil::toLowerCase(dir);
+    String basename, basepath;
+    StringUtil::splitFilename(dir, basename, basepath);
+    basename = Ogre::StringUtil::replaceAll(basename, " ", "_");
+    basename = Ogre::StringUtil::replaceAll(basename, "-", "_");
+
+    return filename_wuid + '\n' + dname + '\n' + StripSHA1fromString(basename);
+}
 
-            String dirB = m_entries[j].resource_bundle_path;
-            StringUtil::toLowerCase(dirB);
-            String basenameB, basepathB;
-            StringUtil::splitFilename(dirB, basenameB, basepathB);
-            basenameA = Ogre::StringUtil::replaceAll(basenameA, " ", "_");
-            basenameA = Ogre::StringUtil::replaceAll(basenameA, "-", "_");
-            basenameB = Ogre::StringUtil::replaceAll(basenameB, " ", "_");
-            basenameB = Ogre::StringUtil::replaceAll(basenameB, "-", "_");
-            if (StripSHA1fromString(basenameA) != StripSHA1fromString(basenameB))
+void CacheSystem::DetectDuplicates()
+{
+    RoR::Log("[RoR|ModCache] Searching for duplicates ...");
+    std::map<String, String> possible_duplicates;
+    for (auto& bucket : m_duplicate_index)
+    {
+        std::vector<size_t> const& indices = bucket.second;
+        for (size_t a = 0; a < indices.size(); a++)
+        {
+            const size_t i = indices[a];
+            if (m_entries[i].deleted)
                 continue;
 
-            if (m_entries[i].resource_bundle_path == m_entries[j].resource_bundle_path)
-            {
-                LOG("- duplicate: " + m_entries[i].fpath + m_entries[i].fname
-                             + " <--> " + m_entries[j].fpath + m_entries[j].fname);
-                LOG("  - " + m_entries[j].resource_bundle_path);
-                int idx = m_entries[i].fpath.size() < m_entries[j].fpath.size() ? i : j;
-                m_entries[idx].deleted = true;
-            }
-            else
+            for (size_t b = a + 1; b < indices.size(); b++)
             {
-                possible_duplicates[m_entries[i].resource_bundle_path] = m_entries[j].resource_bundle_path;
+                const size_t j = indices[b];
+                if (m_entries[j].deleted)
+                    continue;
+
+                if (m_entries[i].resource_bundle_path == m_entries[j].resource_bundle_path)
+                {
+                    LOG("- duplicate: " + m_entries[i].fpath + m_entries[i].fname
+                                 + " <--> " + m_entries[j].fpath + m_entries[j].fname);
+                    LOG("  - " + m_entries[j].resource_bundle_path.str());
+                    size_t idx = m_entries[i].fpath.size() < m_entries[j].fpath.size() ? i : j;
+                    m_entries[idx].deleted = true;
+                }
+                else
+                {
+                    possible_duplicates[m_entries[i].resource_bundle_path] = m_entries[j].resource_bundle_path.str();
+                }
             }
         }
     }
@@ -482,6 +565,7 @@ std::string CacheSystem::ActorTypeToName(ActorType driveable)
 
 void CacheSystem::ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Document& j_doc, CacheEntry const & entry)
 {
+    CacheEntryDetails const& details = this->GetEntryDetails(entry);
     rapidjson::Value j_entry(rapidjson::kObjectType);
 
     // Common details
@@ -503,7 +587,7 @@ void CacheSystem::ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Docu
 
     // Common - Authors
     rapidjson::Value j_authors(rapidjson::kArrayType);
-    for (AuthorInfo const& author: entry.authors)
+    for (AuthorInfo const& author: details.authors)
     {
         rapidjson::Value j_author(rapidjson::kObjectType);
 
@@ -517,41 +601,41 @@ void CacheSystem::ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Docu
     j_entry.AddMember("authors", j_authors, j_doc.GetAllocator());
 
     // Vehicle details
-    j_entry.AddMember("description",         rapidjson::StringRef(entry.description.c_str()),       j_doc.GetAllocator());
-    j_entry.AddMember("tags",                rapidjson::StringRef(entry.tags.c_str()),              j_doc.GetAllocator());
+    j_entry.AddMember("description",         rapidjson::StringRef(details.description.c_str()),     j_doc.GetAllocator());
+    j_entry.AddMember("tags",                rapidjson::StringRef(details.tags.c_str()),            j_doc.GetAllocator());
     j_entry.AddMember("default_skin",        rapidjson::StringRef(entry.default_skin.c_str()),      j_doc.GetAllocator());
-    j_entry.AddMember("fileformatversion",   entry.fileformatversion, j_doc.GetAllocator());
-    j_entry.AddMember("hasSubmeshs",         entry.hasSubmeshs,       j_doc.GetAllocator());
-    j_entry.AddMember("nodecount",           entry.nodecount,         j_doc.GetAllocator());
-    j_entry.AddMember("beamcount",           entry.beamcount,         j_doc.GetAllocator());
-    j_entry.AddMember("shockcount",          entry.shockcount,        j_doc.GetAllocator());
-    j_entry.AddMember("fixescount",          entry.fixescount,        j_doc.GetAllocator());
-    j_entry.AddMember("hydroscount",         entry.hydroscount,       j_doc.GetAllocator());
-    j_entry.AddMember("wheelcount",          entry.wheelcount,        j_doc.GetAllocator());
-    j_entry.AddMember("propwheelcount",      entry.propwheelcount,    j_doc.GetAllocator());
-    j_entry.AddMember("commandscount",       entry.commandscount,     j_doc.GetAllocator());
-    j_entry.AddMember("flarescount",         entry.flarescount,       j_doc.GetAllocator());
-    j_entry.AddMember("propscount",          entry.propscount,        j_doc.GetAllocator());
-    j_entry.AddMember("wingscount",          entry.wingscount,        j_doc.GetAllocator());
-    j_entry.AddMember("turbopropscount",     entry.turbopropscount,   j_doc.GetAllocator());
-    j_entry.AddMember("turbojetcount",       entry.turbojetcount,     j_doc.GetAllocator());
-    j_entry.AddMember("rotatorscount",       entry.rotatorscount,     j_doc.GetAllocator());
-    j_entry.AddMember("exhaustscount",       entry.exhaustscount,     j_doc.GetAllocator());
-    j_entry.AddMember("flexbodiescount",     entry.flexbodiescount,   j_doc.GetAllocator());
-    j_entry.AddMember("soundsourcescount",   entry.soundsourcescount, j_doc.GetAllocator());
-    j_entry.AddMember("truckmass",           entry.truckmass,         j_doc.GetAllocator());
-    j_entry.AddMember("loadmass",            entry.loadmass,          j_doc.GetAllocator());
-    j_entry.AddMember("minrpm",              entry.minrpm,            j_doc.GetAllocator());
-    j_entry.AddMember("maxrpm",              entry.maxrpm,            j_doc.GetAllocator());
-    j_entry.AddMember("torque",              entry.torque,            j_doc.GetAllocator());
-    j_entry.AddMember("customtach",          entry.customtach,        j_doc.GetAllocator());
-    j_entry.AddMember("custom_particles",    entry.custom_particles,  j_doc.GetAllocator());
-    j_entry.AddMember("forwardcommands",     entry.forwardcommands,   j_doc.GetAllocator());
-    j_entry.AddMember("importcommands",      entry.importcommands,    j_doc.GetAllocator());
-    j_entry.AddMember("rescuer",             entry.rescuer,           j_doc.GetAllocator());
+    j_entry.AddMember("fileformatversion",   details.fileformatversion, j_doc.GetAllocator());
+    j_entry.AddMember("hasSubmeshs",         details.hasSubmeshs,     j_doc.GetAllocator());
+    j_entry.AddMember("nodecount",           details.nodecount,       j_doc.GetAllocator());
+    j_entry.AddMember("beamcount",           details.beamcount,       j_doc.GetAllocator());
+    j_entry.AddMember("shockcount",          details.shockcount,      j_doc.GetAllocator());
+    j_entry.AddMember("fixescount",          details.fixescount,      j_doc.GetAllocator());
+    j_entry.AddMember("hydroscount",         details.hydroscount,     j_doc.GetAllocator());
+    j_entry.AddMember("wheelcount",          details.wheelcount,      j_doc.GetAllocator());
+    j_entry.AddMember("propwheelcount",      details.propwheelcount,  j_doc.GetAllocator());
+    j_entry.AddMember("commandscount",       details.commandscount,   j_doc.GetAllocator());
+    j_entry.AddMember("flarescount",         details.flarescount,     j_doc.GetAllocator());
+    j_entry.AddMember("propscount",          details.propscount,      j_doc.GetAllocator());
+    j_entry.AddMember("wingscount",          details.wingscount,      j_doc.GetAllocator());
+    j_entry.AddMember("turbopropscount",     details.turbopropscount, j_doc.GetAllocator());
+    j_entry.AddMember("turbojetcount",       details.turbojetcount,   j_doc.GetAllocator());
+    j_entry.AddMember("rotatorscount",       details.rotatorscount,   j_doc.GetAllocator());
+    j_entry.AddMember("exhaustscount",       details.exhaustscount,   j_doc.GetAllocator());
+    j_entry.AddMember("flexbodiescount",     details.flexbodiescount, j_doc.GetAllocator());
+    j_entry.AddMember("soundsourcescount",   details.soundsourcescount, j_doc.GetAllocator());
+    j_entry.AddMember("truckmass",           details.truckmass,       j_doc.GetAllocator());
+    j_entry.AddMember("loadmass",            details.loadmass,        j_doc.GetAllocator());
+    j_entry.AddMember("minrpm",              details.minrpm,          j_doc.GetAllocator());
+    j_entry.AddMember("maxrpm",              details.maxrpm,          j_doc.GetAllocator());
+    j_entry.AddMember("torque",              details.torque,          j_doc.GetAllocator());
+    j_entry.AddMember("customtach",          details.customtach,      j_doc.GetAllocator());
+    j_entry.AddMember("custom_particles",    details.custom_particles, j_doc.GetAllocator());
+    j_entry.AddMember("forwardcommands",     details.forwardcommands, j_doc.GetAllocator());
+    j_entry.AddMember("importcommands",      details.importcommands,  j_doc.GetAllocator());
+    j_entry.AddMember("rescuer",             details.rescuer,         j_doc.GetAllocator());
     j_entry.AddMember("driveable",           entry.driveable,         j_doc.GetAllocator());
-    j_entry.AddMember("numgears",            entry.numgears,          j_doc.GetAllocator());
-    j_entry.AddMember("enginetype",          entry.enginetype,        j_doc.GetAllocator());
+    j_entry.AddMember("numgears",            details.numgears,        j_doc.GetAllocator());
+    j_entry.AddMember("enginetype",          details.enginetype,      j_doc.GetAllocator());
 
     // Vehicle 'section-configs' (aka Modules in RigDef namespace)
     rapidjson::Value j_sectionconfigs(rapidjson::kArrayType);
@@ -584,6 +668,18 @@ void CacheSystem::WriteCacheFileJson()
     }
     j_doc.AddMember("entries", j_entries, j_doc.GetAllocator());
 
+    // Fingerprints of scanned files
+    rapidjson::Value j_bundles(rapidjson::kArrayType);
+    for (auto& fingerprint : m_bundle_fingerprints)
+    {
+        rapidjson::Value j_bundle(rapidjson::kObjectType);
+        j_bundle.AddMember("path",     rapidjson::StringRef(fingerprint.first.c_str()),   j_doc.GetAllocator());
+        j_bundle.AddMember("size",     fingerprint.second.size,                            j_doc.GetAllocator());
+        j_bundle.AddMember("filetime", static_cast<int64_t>(fingerprint.second.filetime), j_doc.GetAllocator());
+        j_bundles.PushBack(j_bundle, j_doc.GetAllocator());
+    }
+    j_doc.AddMember("bundles", j_bundles, j_doc.GetAllocator());
+
     // Write to file
     if (App::GetContentManager()->SerializeAndWriteJson(CACHE_FILE, RGN_CACHE, j_doc)) // Logs errors
     {
@@ -591,9 +687,548 @@ void CacheSystem::WriteCacheFileJson()
     }
 }
 
+// Binary cache file: header, string table (offsets + character data), then fixed-size
+// records - entries, authors, section config names and bundle fingerprints - which
+// refer to strings by index. Much cheaper to load than the JSON DOM.
+
+static const char CACHE_BIN_SIGNATURE[] = "RoR ModCache";
+
+struct CacheBinHeader
+{
+    char     signature[sizeof(CACHE_BIN_SIGNATURE)];
+    uint32_t format_version;     //!< CACHE_FILE_FORMAT
+    uint64_t json_file_size;     //!< Size of CACHE_FILE written along with this file; a mismatch means this file is stale.
+    uint32_t global_hash;        //!< String index
+    uint32_t num_strings;
+    uint32_t string_data_size;
+    uint32_t num_entries;
+    uint32_t num_authors;
+    uint32_t num_sectionconfigs; //!< String indices
+    uint32_t num_bundles;
+};
+
+struct CacheBinEntry
+{
+    int64_t  addtimestamp;
+    int64_t  filetime;
+    uint32_t fpath, fname, fname_without_uid, dname, uniqueid, guid, fext; // String indices
+    uint32_t resource_bundle_type, resource_bundle_path, filecachename, description, tags, default_skin;
+    uint32_t authors_start, authors_count, sectionconfigs_start, sectionconfigs_count;
+    int32_t  categoryid, version, usagecounter, fileformatversion;
+    int32_t  nodecount, beamcount, shockcount, fixescount, hydroscount, wheelcount, propwheelcount, commandscount, flarescount;
+    int32_t  propscount, wingscount, turbopropscount, turbojetcount, rotatorscount, exhaustscount, flexbodiescount, soundsourcescount;
+    int32_t  driveable, numgears;
+    float    truckmass, loadmass, minrpm, maxrpm, torque;
+    uint8_t  hasSubmeshs, customtach, custom_particles, forwardcommands, importcommands, rescuer;
+    int8_t   enginetype;
+};
+
+struct CacheBinAuthor
+{
+    uint32_t type, name, email; // String indices
+    int32_t  id;
+};
+
+struct CacheBinBundle
+{
+    uint32_t path; // String index
+    uint64_t size;
+    int64_t  filetime;
+};
+
+template <typename T> static void AppendCacheBin(std::string& buf, T const& value)
+{
+    buf.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/// Shared by `LoadCacheFileBinary()` (whole file in memory) and `LoadEntryDetailsBinary()` (reads from disk)
+template <typename GetStringFn, typename GetAuthorFn>
+static void ImportCacheBinDetails(CacheBinEntry const& rec, CacheEntryDetails& details, GetStringFn get_string, GetAuthorFn get_author)
+{
+    details.description        = get_string(rec.description);
+    details.tags               = get_string(rec.tags);
+    details.fileformatversion  = rec.fileformatversion;
+    details.nodecount          = rec.nodecount;
+    details.beamcount          = rec.beamcount;
+    details.shockcount         = rec.shockcount;
+    details.fixescount         = rec.fixescount;
+    details.hydroscount        = rec.hydroscount;
+    details.wheelcount         = rec.wheelcount;
+    details.propwheelcount     = rec.propwheelcount;
+    details.commandscount      = rec.commandscount;
+    details.flarescount        = rec.flarescount;
+    details.propscount         = rec.propscount;
+    details.wingscount         = rec.wingscount;
+    details.turbopropscount    = rec.turbopropscount;
+    details.turbojetcount      = rec.turbojetcount;
+    details.rotatorscount      = rec.rotatorscount;
+    details.exhaustscount      = rec.exhaustscount;
+    details.flexbodiescount    = rec.flexbodiescount;
+    details.soundsourcescount  = rec.soundsourcescount;
+    details.numgears           = rec.numgears;
+    details.truckmass          = rec.truckmass;
+    details.loadmass           = rec.loadmass;
+    details.minrpm             = rec.minrpm;
+    details.maxrpm             = rec.maxrpm;
+    details.torque             = rec.torque;
+    details.hasSubmeshs        = rec.hasSubmeshs != 0;
+    details.customtach         = rec.customtach != 0;
+    details.custom_particles   = rec.custom_particles != 0;
+    details.forwardcommands    = rec.forwardcommands != 0;
+    details.importcommands     = rec.importcommands != 0;
+    details.rescuer            = rec.rescuer != 0;
+    details.enginetype         = static_cast<char>(rec.enginetype);
+
+    for (uint32_t j = rec.authors_start; j < rec.authors_start + rec.authors_count; j++)
+    {
+        CacheBinAuthor author_rec = get_author(j);
+        AuthorInfo author;
+        author.type  = get_string(author_rec.type);
+        author.name  = get_string(author_rec.name);
+        author.email = get_string(author_rec.email);
+        author.id    = author_rec.id;
+        details.authors.push_back(author);
+    }
+}
+
+void CacheSystem::WriteCacheFileBinary()
+{
+    // String table, deduplicated - bundle paths, types and author names repeat a lot
+    std::unordered_map<std::string, uint32_t> string_lookup;
+    std::vector<uint32_t> string_offsets;
+    std::string string_data;
+    auto add_string = [&](std::string const& str) -> uint32_t
+    {
+        auto itor = string_lookup.find(str);
+        if (itor != string_lookup.end())
+        {
+            return itor->second;
+        }
+        const uint32_t index = static_cast<uint32_t>(string_offsets.size());
+        string_offsets.push_back(static_cast<uint32_t>(string_data.size()));
+        string_data += str;
+        string_lookup.insert(std::make_pair(str, index));
+        return index;
+    };
+
+    std::vector<CacheBinEntry> entries;
+    std::vector<CacheBinAuthor> authors;
+    std::vector<uint32_t> sectionconfigs;
+    for (CacheEntry const& entry : m_entries)
+    {
+        if (entry.deleted)
+        {
+            continue;
+        }
+
+        CacheEntryDetails const& details = this->GetEntryDetails(entry);
+        CacheBinEntry rec = {};
+        rec.addtimestamp         = static_cast<int64_t>(entry.addtimestamp);
+        rec.filetime             = static_cast<int64_t>(entry.filetime);
+        rec.fpath                = add_string(entry.fpath);
+        rec.fname                = add_string(entry.fname);
+        rec.fname_without_uid    = add_string(entry.fname_without_uid);
+        rec.dname                = add_string(entry.dname);
+        rec.uniqueid             = add_string(entry.uniqueid);
+        rec.guid                 = add_string(entry.guid);
+        rec.fext                 = add_string(entry.fext);
+        rec.resource_bundle_type = add_string(entry.resource_bundle_type);
+        rec.resource_bundle_path = add_string(entry.resource_bundle_path);
+        rec.filecachename        = add_string(entry.filecachename);
+        rec.description          = add_string(details.description);
+        rec.tags                 = add_string(details.tags);
+        rec.default_skin         = add_string(entry.default_skin);
+        rec.authors_start        = static_cast<uint32_t>(authors.size());
+        rec.authors_count        = static_cast<uint32_t>(details.authors.size());
+        rec.sectionconfigs_start = static_cast<uint32_t>(sectionconfigs.size());
+        rec.sectionconfigs_count = static_cast<uint32_t>(entry.sectionconfigs.size());
+        rec.categoryid           = entry.categoryid;
+        rec.version              = entry.version;
+        rec.usagecounter         = entry.usagecounter;
+        rec.fileformatversion    = details.fileformatversion;
+        rec.nodecount            = details.nodecount;
+        rec.beamcount            = details.beamcount;
+        rec.shockcount           = details.shockcount;
+        rec.fixescount           = details.fixescount;
+        rec.hydroscount          = details.hydroscount;
+        rec.wheelcount           = details.wheelcount;
+        rec.propwheelcount       = details.propwheelcount;
+        rec.commandscount        = details.commandscount;
+        rec.flarescount          = details.flarescount;
+        rec.propscount           = details.propscount;
+        rec.wingscount           = details.wingscount;
+        rec.turbopropscount      = details.turbopropscount;
+        rec.turbojetcount        = details.turbojetcount;
+        rec.rotatorscount        = details.rotatorscount;
+        rec.exhaustscount        = details.exhaustscount;
+        rec.flexbodiescount      = details.flexbodiescount;
+        rec.soundsourcescount    = details.soundsourcescount;
+        rec.driveable            = static_cast<int32_t>(entry.driveable);
+        rec.numgears             = details.numgears;
+        rec.truckmass            = details.truckmass;
+        rec.loadmass             = details.loadmass;
+        rec.minrpm               = details.minrpm;
+        rec.maxrpm               = details.maxrpm;
+        rec.torque               = details.torque;
+        rec.hasSubmeshs          = details.hasSubmeshs;
+        rec.customtach           = details.customtach;
+        rec.custom_particles     = details.custom_particles;
+        rec.forwardcommands      = details.forwardcommands;
+        rec.importcommands       = details.importcommands;
+        rec.rescuer              = details.rescuer;
+        rec.enginetype           = static_cast<int8_t>(details.enginetype);
+        entries.push_back(rec);
+
+        for (AuthorInfo const& author : details.authors)
+        {
+            CacheBinAuthor author_rec;
+            author_rec.type  = add_string(author.type);
+            author_rec.name  = add_string(author.name);
+            author_rec.email = add_string(author.email);
+            author_rec.id    = author.id;
+            authors.push_back(author_rec);
+        }
+        for (std::string const& module_name : entry.sectionconfigs)
+        {
+            sectionconfigs.push_back(add_string(module_name));
+        }
+    }
+
+    std::vector<CacheBinBundle> bundles;
+    for (auto& fingerprint : m_bundle_fingerprints)
+    {
+        CacheBinBundle rec;
+        rec.path     = add_string(fingerprint.first);
+        rec.size     = fingerprint.second.size;
+        rec.filetime = static_cast<int64_t>(fingerprint.second.filetime);
+        bundles.push_back(rec);
+    }
+
+    CacheBinHeader header = {};
+    std::memcpy(header.signature, CACHE_BIN_SIGNATURE, sizeof(CACHE_BIN_SIGNATURE));
+    header.format_version     = CACHE_FILE_FORMAT;
+    header.json_file_size     = GetFileSizeBytes(PathCombine(App::sys_cache_dir->getStr(), CACHE_FILE));
+    header.global_hash        = add_string(m_filenames_hash_generated);
+    header.num_strings        = static_cast<uint32_t>(string_offsets.size());
+    header.string_data_size   = static_cast<uint32_t>(string_data.size());
+    header.num_entries        = static_cast<uint32_t>(entries.size());
+    header.num_authors        = static_cast<uint32_t>(authors.size());
+    header.num_sectionconfigs = static_cast<uint32_t>(sectionconfigs.size());
+    header.num_bundles        = static_cast<uint32_t>(bundles.size());
+    string_offsets.push_back(header.string_data_size); // End of the last string
+
+    std::string buf;
+    AppendCacheBin(buf, header);
+    buf.append(reinterpret_cast<const char*>(string_offsets.data()), string_offsets.size() * sizeof(uint32_t));
+    buf += string_data;
+    buf.append(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(CacheBinEntry));
+    buf.append(reinterpret_cast<const char*>(authors.data()), authors.size() * sizeof(CacheBinAuthor));
+    buf.append(reinterpret_cast<const char*>(sectionconfigs.data()), sectionconfigs.size() * sizeof(uint32_t));
+    buf.append(reinterpret_cast<const char*>(bundles.data()), bundles.size() * sizeof(CacheBinBundle));
+
+    try
+    {
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().createResource(CACHE_FILE_BINARY, RGN_CACHE, /*overwrite=*/true);
+        if (stream->write(buf.data(), buf.size()) == buf.size())
+        {
+            RoR::LogFormat("[RoR|ModCache] File '%s' written OK", CACHE_FILE_BINARY);
+        }
+        else
+        {
+            RoR::LogFormat("[RoR|ModCache] Error writing file '%s'", CACHE_FILE_BINARY);
+        }
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error writing file '%s', message: '%s'", CACHE_FILE_BINARY, e.what());
+    }
+}
+
+CacheValidity CacheSystem::LoadCacheFileBinary()
+{
+    this->ClearEntries();
+    m_bundle_fingerprints.clear();
+    m_bin_layout = CacheBinLayout();
+
+    if (!FileExists(PathCombine(App::sys_cache_dir->getStr(), CACHE_FILE_BINARY)))
+    {
+        return CacheValidity::NEEDS_REBUILD;
+    }
+
+    std::vector<char> buf;
+    try
+    {
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(CACHE_FILE_BINARY, RGN_CACHE);
+        buf.resize(stream->size());
+        if (stream->read(buf.data(), buf.size()) != buf.size())
+        {
+            return CacheValidity::NEEDS_REBUILD;
+        }
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error reading file '%s', message: '%s'", CACHE_FILE_BINARY, e.what());
+        return CacheValidity::NEEDS_REBUILD;
+    }
+
+    // Validate the layout up front, records are then read without further checks
+    CacheBinHeader header;
+    if (buf.size() < sizeof(header))
+    {
+        return CacheValidity::NEEDS_REBUILD;
+    }
+    std::memcpy(&header, buf.data(), sizeof(header));
+    if (std::memcmp(header.signature, CACHE_BIN_SIGNATURE, sizeof(CACHE_BIN_SIGNATURE)) != 0 ||
+        header.format_version != CACHE_FILE_FORMAT ||
+        header.json_file_size != GetFileSizeBytes(PathCombine(App::sys_cache_dir->getStr(), CACHE_FILE)))
+    {
+        RoR::Log("[RoR|ModCache] Binary cache file is outdated");
+        return CacheValidity::NEEDS_REBUILD;
+    }
+
+    const size_t offsets_pos   = sizeof(header);
+    const size_t strings_pos   = offsets_pos + (header.num_strings + 1) * sizeof(uint32_t);
+    const size_t entries_pos   = strings_pos + header.string_data_size;
+    const size_t authors_pos   = entries_pos + header.num_entries * sizeof(CacheBinEntry);
+    const size_t sections_pos  = authors_pos + header.num_authors * sizeof(CacheBinAuthor);
+    const size_t bundles_pos   = sections_pos + header.num_sectionconfigs * sizeof(uint32_t);
+    const size_t end_pos       = bundles_pos + header.num_bundles * sizeof(CacheBinBundle);
+    if (end_pos != buf.size())
+    {
+        RoR::Log("[RoR|ModCache] Binary cache file is corrupted");
+        return CacheValidity::NEEDS_REBUILD;
+    }
+
+    std::vector<uint32_t> string_offsets(header.num_strings + 1);
+    std::memcpy(string_offsets.data(), &buf[offsets_pos], string_offsets.size() * sizeof(uint32_t));
+    for (uint32_t i = 0; i < header.num_strings; i++)
+    {
+        if (string_offsets[i] > string_offsets[i + 1] || string_offsets[i + 1] > header.string_data_size)
+        {
+            RoR::Log("[RoR|ModCache] Binary cache file is corrupted");
+            return CacheValidity::NEEDS_REBUILD;
+        }
+    }
+    auto get_string = [&](uint32_t index) -> std::string
+    {
+        if (index >= header.num_strings)
+            return std::string();
+        return std::string(&buf[strings_pos + string_offsets[index]], string_offsets[index + 1] - string_offsets[index]);
+    };
+    auto get_author = [&](uint32_t index) -> CacheBinAuthor
+    {
+        CacheBinAuthor author_rec;
+        std::memcpy(&author_rec, &buf[authors_pos + index * sizeof(CacheBinAuthor)], sizeof(author_rec));
+        return author_rec;
+    };
+
+    m_entries.reserve(header.num_entries);
+    for (uint32_t i = 0; i < header.num_entries; i++)
+    {
+        CacheBinEntry rec;
+        std::memcpy(&rec, &buf[entries_pos + i * sizeof(CacheBinEntry)], sizeof(rec));
+        if (static_cast<uint64_t>(rec.authors_start) + rec.authors_count > header.num_authors ||
+            static_cast<uint64_t>(rec.sectionconfigs_start) + rec.sectionconfigs_count > header.num_sectionconfigs)
+        {
+            RoR::Log("[RoR|ModCache] Binary cache file is corrupted");
+            this->ClearEntries();
+            return CacheValidity::NEEDS_REBUILD;
+        }
+
+        CacheEntry entry;
+        entry.addtimestamp         = static_cast<std::time_t>(rec.addtimestamp);
+        entry.filetime             = static_cast<std::time_t>(rec.filetime);
+        entry.fpath                = get_string(rec.fpath);
+        entry.fname                = get_string(rec.fname);
+        entry.fname_without_uid    = get_string(rec.fname_without_uid);
+        entry.dname                = get_string(rec.dname);
+        entry.uniqueid             = get_string(rec.uniqueid);
+        entry.guid                 = get_string(rec.guid);
+        entry.fext                 = get_string(rec.fext);
+        entry.resource_bundle_type = get_string(rec.resource_bundle_type);
+        entry.resource_bundle_path = get_string(rec.resource_bundle_path);
+        entry.filecachename        = get_string(rec.filecachename);
+        entry.default_skin         = get_string(rec.default_skin);
+        entry.version              = rec.version;
+        entry.usagecounter         = rec.usagecounter;
+        entry.driveable            = ActorType(rec.driveable);
+        entry.details_bin_index    = i;
+        this->SetEntryCategory(entry, rec.categoryid);
+
+        // Needed for the search index, dropped afterwards - see `GetEntryDetails()`
+        entry.details = std::make_shared<CacheEntryDetails>();
+        ImportCacheBinDetails(rec, *entry.details, get_string, get_author);
+
+        for (uint32_t j = rec.sectionconfigs_start; j < rec.sectionconfigs_start + rec.sectionconfigs_count; j++)
+        {
+            uint32_t module_name = 0;
+            std::memcpy(&module_name, &buf[sections_pos + j * sizeof(uint32_t)], sizeof(module_name));
+            entry.sectionconfigs.push_back(get_string(module_name));
+        }
+
+        this->AddEntry(entry);
+        m_entries.back().details = nullptr;
+    }
+
+    for (uint32_t i = 0; i < header.num_bundles; i++)
+    {
+        CacheBinBundle rec;
+        std::memcpy(&rec, &buf[bundles_pos + i * sizeof(CacheBinBundle)], sizeof(rec));
+        BundleFingerprint& fingerprint = m_bundle_fingerprints[get_string(rec.path)];
+        fingerprint.size = rec.size;
+        fingerprint.filetime = static_cast<std::time_t>(rec.filetime);
+    }
+
+    m_filenames_hash_loaded = get_string(header.global_hash);
+
+    m_bin_layout.file_size      = buf.size();
+    m_bin_layout.strings_pos    = strings_pos;
+    m_bin_layout.entries_pos    = entries_pos;
+    m_bin_layout.authors_pos    = authors_pos;
+    m_bin_layout.string_offsets = std::move(string_offsets);
+
+    return CacheValidity::VALID;
+}
+
+void CacheSystem::LoadEntryDetailsBinary(uint32_t bin_index, CacheEntryDetails& out_details)
+{
+    try
+    {
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(CACHE_FILE_BINARY, RGN_CACHE);
+        if (stream->size() != m_bin_layout.file_size)
+        {
+            RoR::LogFormat("[RoR|ModCache] File '%s' changed since it was loaded, entry details are not available", CACHE_FILE_BINARY);
+            return;
+        }
+
+        auto read_at = [&stream](size_t pos, void* dst, size_t size)
+        {
+            stream->seek(pos);
+            if (stream->read(dst, size) != size)
+            {
+                throw std::runtime_error("unexpected end of file");
+            }
+        };
+        auto get_string = [&](uint32_t index) -> std::string
+        {
+            std::vector<uint32_t> const& offsets = m_bin_layout.string_offsets;
+            if (index + 1 >= offsets.size())
+                return std::string();
+            std::string str(offsets[index + 1] - offsets[index], '\0');
+            read_at(m_bin_layout.strings_pos + offsets[index], &str[0], str.size());
+            return str;
+        };
+        auto get_author = [&](uint32_t index) -> CacheBinAuthor
+        {
+            CacheBinAuthor author_rec;
+            read_at(m_bin_layout.authors_pos + index * sizeof(CacheBinAuthor), &author_rec, sizeof(author_rec));
+            return author_rec;
+        };
+
+        CacheBinEntry rec;
+        read_at(m_bin_layout.entries_pos + bin_index * sizeof(CacheBinEntry), &rec, sizeof(rec));
+        ImportCacheBinDetails(rec, out_details, get_string, get_author);
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error reading file '%s', message: '%s'", CACHE_FILE_BINARY, e.what());
+    }
+}
+
+CacheEntryDetails const& CacheSystem::GetEntryDetails(CacheEntry const& entry)
+{
+    if (!entry.details)
+    {
+        entry.details = std::make_shared<CacheEntryDetails>();
+        if (entry.details_bin_index != CACHE_BIN_INDEX_NONE)
+        {
+            this->LoadEntryDetailsBinary(entry.details_bin_index, *entry.details);
+        }
+    }
+    return *entry.details;
+}
+
+CacheValidity CacheSystem::LoadCacheFile()
+{
+    if (this->LoadCacheFileBinary() == CacheValidity::VALID)
+    {
+        return CacheValidity::VALID;
+    }
+    return this->LoadCacheFileJson();
+}
+
+RigDef::DocumentPtr CacheSystem::LoadCachedActorDef(std::string const& file_hash)
+{
+    const std::string filename = file_hash + CACHE_ACTORDEF_EXT;
+    if (file_hash.empty() || !FileExists(PathCombine(App::sys_cache_dir->getStr(), filename)))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().openResource(filename, RGN_CACHE);
+        std::vector<char> buf(stream->size());
+        if (stream->read(buf.data(), buf.size()) != buf.size())
+        {
+            return nullptr;
+        }
+        RigDef::DocumentPtr def = RigDef::DeserializeBinary(buf.data(), buf.size());
+        if (def == nullptr || def->hash != file_hash)
+        {
+            RoR::LogFormat("[RoR|ModCache] Cached actor definition '%s' is outdated", filename.c_str());
+            return nullptr;
+        }
+        return def;
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error reading file '%s', message: '%s'", filename.c_str(), e.what());
+        return nullptr;
+    }
+}
+
+void CacheSystem::SaveCachedActorDef(RigDef::DocumentPtr def)
+{
+    const std::string filename = def->hash + CACHE_ACTORDEF_EXT;
+    const std::string buf = RigDef::SerializeBinary(def);
+    try
+    {
+        DataStreamPtr stream = ResourceGroupManager::getSingleton().createResource(filename, RGN_CACHE, /*overwrite=*/true);
+        if (stream->write(buf.data(), buf.size()) != buf.size())
+        {
+            RoR::LogFormat("[RoR|ModCache] Error writing file '%s'", filename.c_str());
+        }
+    }
+    catch (std::exception& e)
+    {
+        RoR::LogFormat("[RoR|ModCache] Error writing file '%s', message: '%s'", filename.c_str(), e.what());
+    }
+}
+
+void CacheSystem::SetEntryCategory(CacheEntry& entry, int category_id)
+{
+    auto category_itor = m_categories.find(category_id);
+    if (category_itor == m_categories.end() || category_id >= CID_Max)
+    {
+        category_itor = m_categories.find(CID_Unsorted);
+    }
+    entry.categoryname = category_itor->second;
+    entry.categoryid = category_itor->first;
+}
+
 void CacheSystem::ClearCache()
 {
     App::GetContentManager()->DeleteDiskFile(CACHE_FILE, RGN_CACHE);
+    if (FileExists(PathCombine(App::sys_cache_dir->getStr(), CACHE_FILE_BINARY)))
+    {
+        App::GetContentManager()->DeleteDiskFile(CACHE_FILE_BINARY, RGN_CACHE);
+    }
+    StringVectorPtr actordef_files = ResourceGroupManager::getSingleton().findResourceNames(RGN_CACHE, "*" CACHE_ACTORDEF_EXT);
+    for (std::string const& filename : *actordef_files)
+    {
+        App::GetContentManager()->DeleteDiskFile(filename, RGN_CACHE);
+    }
     for (auto& entry : m_entries)
     {
         String group = entry.resource_group;
@@ -604,7 +1239,8 @@ void CacheSystem::ClearCache()
         }
         this->RemoveFileCache(entry);
     }
-    m_entries.clear();
+    this->ClearEntries();
+    m_bundle_fingerprints.clear();
 }
 
 Ogre::String CacheSystem::StripUIDfromString(Ogre::String uidstr)
@@ -639,7 +1275,15 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
         DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(f.filename, group);
         // ds closes automatically, so do _not_ close it explicitly below
 
-        std::vector<CacheEntry> new_entries;
+        // Zip archives are fingerprinted by `ParseSingleZip()`
+        const std::string bundle_file = (type == "Zip") ? path : PathCombine(path, f.filename);
+        auto fingerprint = m_bundle_fingerprints.find(bundle_file);
+        const std::time_t filetime = (type == "Zip" && fingerprint != m_bundle_fingerprints.end())
+            ? fingerprint->second.filetime
+            : this->UpdateBundleFingerprint(bundle_file);
+
+        PendingEntries pending;
+        std::vector<CacheEntry>& new_entries = pending.entries;
         if (ext == "terrn2")
         {
             new_entries.resize(1);
@@ -651,17 +1295,18 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
             for (auto skin_def: new_skins)
             {
                 CacheEntry entry;
+                entry.details = std::make_shared<CacheEntryDetails>();
                 if (!skin_def->author_name.empty())
                 {
                     AuthorInfo a;
                     a.id = skin_def->author_id;
                     a.name = skin_def->author_name;
-                    entry.authors.push_back(a);
+                    entry.details->authors.push_back(a);
                 }
 
                 entry.dname       = skin_def->name;
                 entry.guid        = skin_def->guid;
-                entry.description = skin_def->description;
+                entry.details->description = skin_def->description;
                 entry.categoryid  = -1;
                 entry.skin_def    = skin_def; // Needed to generate preview image
 
@@ -670,38 +1315,81 @@ void CacheSystem::AddFile(String group, Ogre::FileInfo f, String ext)
         }
         else
         {
+            // Parsed later on the thread pool, see `FlushPendingEntries()`; the archive may be closed by then
             new_entries.resize(1);
-            FillTruckDetailInfo(new_entries.back(), ds, f.filename, group);
+            pending.truck_stream = DataStreamPtr(OGRE_NEW MemoryDataStream(f.filename, ds));
+            pending.truck_group = group;
+            m_num_pending_trucks++;
         }
 
         for (auto& entry: new_entries)
         {
-            Ogre::StringUtil::toLowerCase(entry.guid); // Important for comparsion
             entry.fpath = f.path;
             entry.fname = f.filename;
             entry.fname_without_uid = StripUIDfromString(f.filename);
             entry.fext = ext;
-            if (type == "Zip")
-            {
-                entry.filetime = RoR::GetFileLastModifiedTime(path);
-            }
-            else
-            {
-                entry.filetime = RoR::GetFileLastModifiedTime(PathCombine(path, f.filename));
-            }
+            entry.filetime = filetime;
             entry.resource_bundle_type = type;
             entry.resource_bundle_path = path;
-            entry.number = static_cast<int>(m_entries.size() + 1); // Let's number mods from 1
             entry.addtimestamp = m_update_time;
             this->GenerateFileCache(entry, group);
-            m_entries.push_back(entry);
         }
+        m_pending_entries.push_back(pending);
     }
     catch (Ogre::Exception& e)
     {
         RoR::LogFormat("[RoR|CacheSystem] Error processing file '%s', message :%s",
             f.filename.c_str(), e.getFullDescription().c_str());
     }
+
+    if (m_num_pending_trucks >= MAX_PENDING_TRUCKS)
+    {
+        this->FlushPendingEntries();
+    }
+}
+
+void CacheSystem::FlushPendingEntries()
+{
+    // Parsing truck files is the bulk of the work and doesn't need the resource system
+    App::GetThreadPool()->ParallelFor(m_pending_entries.size(), [this](size_t i)
+    {
+        PendingEntries& pending = m_pending_entries[i];
+        if (!pending.truck_stream)
+        {
+            return;
+        }
+        try
+        {
+            this->FillTruckDetailInfo(pending.entries[0], pending.truck_stream, pending.entries[0].fname, pending.truck_group);
+        }
+        catch (Ogre::Exception& e)
+        {
+            pending.error = e.getFullDescription();
+        }
+        catch (std::exception& e)
+        {
+            pending.error = e.what();
+        }
+    });
+
+    // Add in the order the files were found, so that the numbering doesn't depend on threading
+    for (PendingEntries& pending : m_pending_entries)
+    {
+        if (!pending.error.empty())
+        {
+            RoR::LogFormat("[RoR|CacheSystem] Error processing file '%s', message :%s",
+                pending.entries[0].fname.c_str(), pending.error.c_str());
+            this->RemoveFileCache(pending.entries[0]);
+            continue;
+        }
+        for (CacheEntry& entry : pending.entries)
+        {
+            Ogre::StringUtil::toLowerCase(entry.guid); // Important for comparsion
+            this->AddEntry(entry);
+        }
+    }
+    m_pending_entries.clear();
+    m_num_pending_trucks = 0;
 }
 
 void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr stream, String file_name, String group)
@@ -716,6 +1404,8 @@ void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr str
     /* RETRIEVE DATA */
 
     RigDef::DocumentPtr def = parser.GetFile();
+    entry.details = std::make_shared<CacheEntryDetails>();
+    CacheEntryDetails& details = *entry.details;
 
     /* Name */
     if (!def->name.empty())
@@ -731,7 +1421,7 @@ void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr str
     std::vector<Ogre::String>::iterator desc_itor = def->root_module->description.begin();
     for (; desc_itor != def->root_module->description.end(); desc_itor++)
     {
-        entry.description += *desc_itor + "\n";
+        details.description += *desc_itor + "\n";
     }
 
     /* Authors */
@@ -744,7 +1434,7 @@ void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr str
         author.name = author_itor->name;
         author.type = author_itor->type;
 
-        entry.authors.push_back(author);
+        details.authors.push_back(author);
     }
 
     /* Default skin */
@@ -765,14 +1455,14 @@ void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr str
     if (def->root_module->engine.size() > 0)
     {
         RigDef::Engine& engine = def->root_module->engine[def->root_module->engine.size() - 1];
-        entry.numgears = static_cast<int>(engine.gear_ratios.size());
-        entry.minrpm = engine.shift_down_rpm;
-        entry.maxrpm = engine.shift_up_rpm;
-        entry.torque = engine.torque;
-        entry.enginetype = 't'; /* Truck (default) */
+        details.numgears = static_cast<int>(engine.gear_ratios.size());
+        details.minrpm = engine.shift_down_rpm;
+        details.maxrpm = engine.shift_up_rpm;
+        details.torque = engine.torque;
+        details.enginetype = 't'; /* Truck (default) */
         if (def->root_module->engoption.size() > 0)
         {
-            entry.enginetype = (char)def->root_module->engoption[def->root_module->engoption.size() - 1].type;
+            details.enginetype = (char)def->root_module->engoption[def->root_module->engoption.size() - 1].type;
         }
     }
 
@@ -831,77 +1521,77 @@ void CacheSystem::FillTruckDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr str
 
     if (def->root_module->globals.size() > 0)
     {
-        entry.truckmass = def->root_module->globals[def->root_module->globals.size() - 1].dry_mass;
-        entry.loadmass = def->root_module->globals[def->root_module->globals.size() - 1].cargo_mass;
+        details.truckmass = def->root_module->globals[def->root_module->globals.size() - 1].dry_mass;
+        details.loadmass = def->root_module->globals[def->root_module->globals.size() - 1].cargo_mass;
     }
     
-    entry.forwardcommands = def->forward_commands;
-    entry.importcommands = def->import_commands;
-    entry.rescuer = def->rescuer;
+    details.forwardcommands = def->forward_commands;
+    details.importcommands = def->import_commands;
+    details.rescuer = def->rescuer;
     if (def->root_module->guid.size() > 0)
     {
         entry.guid = def->root_module->guid[def->root_module->guid.size() - 1].guid;
     }
-    entry.fileformatversion = 0;
+    details.fileformatversion = 0;
     if (def->root_module->fileformatversion.size() > 0)
     {
-        entry.fileformatversion = def->root_module->fileformatversion[def->root_module->fileformatversion.size() - 1].version;
+        details.fileformatversion = def->root_module->fileformatversion[def->root_module->fileformatversion.size() - 1].version;
     }
-    entry.hasSubmeshs = static_cast<int>(def->root_module->submeshes.size() > 0);
-    entry.nodecount = static_cast<int>(def->root_module->nodes.size());
-    entry.beamcount = static_cast<int>(def->root_module->beams.size());
-    entry.shockcount = static_cast<int>(def->root_module->shocks.size() + def->root_module->shocks2.size());
-    entry.fixescount = static_cast<int>(def->root_module->fixes.size());
-    entry.hydroscount = static_cast<int>(def->root_module->hydros.size());
+    details.hasSubmeshs =   static_cast<int>(def->root_module->submeshes.size() > 0);
+    details.nodecount =   static_cast<int>(def->root_module->nodes.size());
+    details.beamcount =   static_cast<int>(def->root_module->beams.size());
+    details.shockcount =   static_cast<int>(def->root_module->shocks.size() + def->root_module->shocks2.size());
+    details.fixescount =   static_cast<int>(def->root_module->fixes.size());
+    details.hydroscount =   static_cast<int>(def->root_module->hydros.size());
     entry.driveable = vehicle_type;
-    entry.commandscount = static_cast<int>(def->root_module->commands2.size());
-    entry.flarescount = static_cast<int>(def->root_module->flares2.size());
-    entry.propscount = static_cast<int>(def->root_module->props.size());
-    entry.wingscount = static_cast<int>(def->root_module->wings.size());
-    entry.turbopropscount = static_cast<int>(def->root_module->turboprops2.size());
-    entry.rotatorscount = static_cast<int>(def->root_module->rotators.size() + def->root_module->rotators2.size());
-    entry.exhaustscount = static_cast<int>(def->root_module->exhausts.size());
-    entry.custom_particles = def->root_module->particles.size() > 0;
-    entry.turbojetcount = static_cast<int>(def->root_module->turbojets.size());
-    entry.flexbodiescount = static_cast<int>(def->root_module->flexbodies.size());
-    entry.soundsourcescount = static_cast<int>(def->root_module->soundsources.size() + def->root_module->soundsources.size());
-
-    entry.wheelcount = 0;
-    entry.propwheelcount = 0;
+    details.commandscount =   static_cast<int>(def->root_module->commands2.size());
+    details.flarescount =   static_cast<int>(def->root_module->flares2.size());
+    details.propscount =   static_cast<int>(def->root_module->props.size());
+    details.wingscount =   static_cast<int>(def->root_module->wings.size());
+    details.turbopropscount =   static_cast<int>(def->root_module->turboprops2.size());
+    details.rotatorscount =   static_cast<int>(def->root_module->rotators.size() + def->root_module->rotators2.size());
+    details.exhaustscount =   static_cast<int>(def->root_module->exhausts.size());
+    details.custom_particles = def->root_module->particles.size() > 0;
+    details.turbojetcount =   static_cast<int>(def->root_module->turbojets.size());
+    details.flexbodiescount =   static_cast<int>(def->root_module->flexbodies.size());
+    details.soundsourcescount =   static_cast<int>(def->root_module->soundsources.size() + def->root_module->soundsources.size());
+
+    details.wheelcount = 0;
+    details.propwheelcount = 0;
     for (const auto& w : def->root_module->wheels)
     {
-        entry.wheelcount++;
+        details.wheelcount++;
         if (w.propulsion != RigDef::WheelPropulsion::NONE)
-            entry.propwheelcount++;
+            details.propwheelcount++;
     }
     for (const auto& w : def->root_module->wheels2)
     {
-        entry.wheelcount++;
+        details.wheelcount++;
         if (w.propulsion != RigDef::WheelPropulsion::NONE)
-            entry.propwheelcount++;
+            details.propwheelcount++;
     }
     for (const auto& w : def->root_module->meshwheels)
     {
-        entry.wheelcount++;
+        details.wheelcount++;
         if (w.propulsion != RigDef::WheelPropulsion::NONE)
-            entry.propwheelcount++;
+            details.propwheelcount++;
     }
     for (const auto& w : def->root_module->meshwheels2)
     {
-        entry.wheelcount++;
+        details.wheelcount++;
         if (w.propulsion != RigDef::WheelPropulsion::NONE)
-            entry.propwheelcount++;
+            details.propwheelcount++;
     }
     for (const auto& w : def->root_module->flexbodywheels)
     {
-        entry.wheelcount++;
+        details.wheelcount++;
         if (w.propulsion != RigDef::WheelPropulsion::NONE)
-            entry.propwheelcount++;
+            details.propwheelcount++;
     }
 
     if (!def->root_module->axles.empty())
     {
-        entry.propwheelcount = static_cast<int>(def->root_module->axles.size() * 2);
+        details.propwheelcount = static_cast<int>(def->root_module->axles.size() * 2);
     }
 
     /* NOTE: std::shared_ptr cleans everything up. */
@@ -1008,6 +1698,7 @@ void CacheSystem::ParseSingleZip(String path)
     if (std::find(m_resource_paths.begin(), m_resource_paths.end(), path) == m_resource_paths.end())
     {
         RoR::LogFormat("[RoR|ModCache] Adding archive '%s'", path.c_str());
+        this->UpdateBundleFingerprint(path); // Also if there's no usable content, so it's not opened again on update
         ResourceGroupManager::getSingleton().createResourceGroup(RGN_TEMP, false);
         try
         {
@@ -1053,13 +1744,15 @@ void CacheSystem::FillTerrainDetailInfo(CacheEntry& entry, Ogre::DataStreamPtr d
     Terrn2Parser parser;
     parser.LoadTerrn2(def, ds);
 
+    entry.details = std::make_shared<CacheEntryDetails>();
+    CacheEntryDetails& details = *entry.details;
     for (Terrn2Author& author : def.authors)
     {
         AuthorInfo a;
         a.id = -1;
         a.name = author.name;
         a.type = author.type;
-        entry.authors.push_back(a);
+        details.authors.push_back(a);
     }
 
     entry.dname      = def.name;
@@ -1108,6 +1801,35 @@ bool CacheSystem::CheckResourceLoaded(Ogre::String & filename, Ogre::String& gro
     return false;
 }
 
+std::shared_ptr<Task> CacheSystem::PrefetchResource(CacheEntry const& t)
+{
+    // Only ZIPs are worth it - reading the central directory and inflating scripts/meshes is what stalls.
+    if (t.resource_group != "" || t.resource_bundle_type != "Zip")
+    {
+        return nullptr;
+    }
+
+    auto found = m_prefetch_tasks.find(t.resource_bundle_path);
+    if (found != m_prefetch_tasks.end())
+    {
+        return found->second;
+    }
+
+    // Plain file IO, not Ogre's archives - those aren't safe to use outside main thread.
+    // The data is thrown away; the point is to have it in the OS file cache when `LoadResource()` opens the ZIP.
+    const std::string path = t.resource_bundle_path;
+    std::shared_ptr<Task> task = App::GetThreadPool()->RunTask([path]()
+        {
+            std::ifstream file(path, std::ios::binary);
+            std::vector<char> buf(1024 * 1024);
+            while (file.read(buf.data(), buf.size()) || file.gcount() > 0)
+            {
+            }
+        }, TaskPriority::BACKGROUND);
+    m_prefetch_tasks[path] = task;
+    return task;
+}
+
 void CacheSystem::LoadResource(CacheEntry& t)
 {
     // Check if already loaded for this entry.
@@ -1115,8 +1837,9 @@ void CacheSystem::LoadResource(CacheEntry& t)
     {
         return;
     }
+    m_prefetch_tasks.erase(t.resource_bundle_path); // Whatever it managed to read already helps
 
-    Ogre::String group = "bundle " + t.resource_bundle_path; // Compose group name from full path.
+    Ogre::String group = "bundle " + t.resource_bundle_path.str(); // Compose group name from full path.
 
     // Load now.
     try
@@ -1263,12 +1986,59 @@ std::shared_ptr<SkinDef> CacheSystem::FetchSkinDef(CacheEntry* cache_entry)
     }
 }
 
+void CacheSystem::FindSearchCandidates(std::string const& query, std::vector<uint32_t>& out_candidates) const
+{
+    out_candidates.clear();
+    std::vector<std::vector<uint32_t> const*> trigram_entries;
+    for (size_t i = 0; i + 3 <= query.size(); i++)
+    {
+        auto itor = m_search_trigrams.find(MakeSearchTrigram(&query[i]));
+        if (itor == m_search_trigrams.end())
+        {
+            return; // No entry contains this trigram
+        }
+        trigram_entries.push_back(&itor->second);
+    }
+
+    // Start with the rarest trigram, the intersection only shrinks
+    std::sort(trigram_entries.begin(), trigram_entries.end(),
+        [](std::vector<uint32_t> const* a, std::vector<uint32_t> const* b) { return a->size() < b->size(); });
+    out_candidates = *trigram_entries[0];
+    std::vector<uint32_t> intersection;
+    for (size_t i = 1; i < trigram_entries.size() && !out_candidates.empty(); i++)
+    {
+        intersection.clear();
+        std::set_intersection(out_candidates.begin(), out_candidates.end(),
+            trigram_entries[i]->begin(), trigram_entries[i]->end(), std::back_inserter(intersection));
+        out_candidates.swap(intersection);
+    }
+}
+
 size_t CacheSystem::Query(CacheQuery& query)
 {
     Ogre::StringUtil::toLowerCase(query.cqy_search_string);
+    std::string const& search = query.cqy_search_string;
+
+    // Entries which can match at all, according to the trigram index; the index covers all fields these methods search
+    const bool use_candidates = search.size() >= 3 &&
+        (query.cqy_search_method == CacheSearchMethod::FULLTEXT ||
+         query.cqy_search_method == CacheSearchMethod::AUTHORS ||
+         query.cqy_search_method == CacheSearchMethod::FILENAME);
+    std::vector<uint32_t> candidates;
+    if (use_candidates)
+    {
+        this->FindSearchCandidates(search, candidates);
+    }
+    size_t next_candidate = 0;
+
+    const bool use_fuzzy = query.cqy_search_method == CacheSearchMethod::FULLTEXT && search.size() >= FUZZY_SEARCH_MIN_LENGTH;
+    std::vector<uint32_t> unmatched; // Entries which passed the filters but not the search
+
     std::time_t cur_time = std::time(nullptr);
-    for (CacheEntry& entry: m_entries)
+    for (uint32_t i = 0; i < static_cast<uint32_t>(m_entries.size()); i++)
     {
+        CacheEntry& entry = m_entries[i];
+
         // Filter by GUID
         if (!query.cqy_filter_guid.empty() && entry.guid != query.cqy_filter_guid)
         {
@@ -1317,42 +2087,58 @@ size_t CacheSystem::Query(CacheQuery& query)
             continue;
         }
 
+        // Skip entries which can't match
+        if (use_candidates)
+        {
+            while (next_candidate < candidates.size() && candidates[next_candidate] < i)
+            {
+                next_candidate++;
+            }
+            if (next_candidate == candidates.size() || candidates[next_candidate] != i)
+            {
+                if (use_fuzzy)
+                    unmatched.push_back(i);
+                continue;
+            }
+        }
+
         // Search
+        SearchFields const& fields = m_search_fields[i];
         size_t score = 0;
         bool match = false;
         Str<100> wheels_str;
         switch (query.cqy_search_method)
         {
         case CacheSearchMethod::FULLTEXT:
-            if (match = this->Match(score, entry.dname,       query.cqy_search_string, 0))   { break; }
-            if (match = this->Match(score, entry.fname,       query.cqy_search_string, 100)) { break; }
-            if (match = this->Match(score, entry.description, query.cqy_search_string, 200)) { break; }
-            for (AuthorInfo const& author: entry.authors)
+            if (match = this->Match(score, fields.dname,       search, 0))   { break; }
+            if (match = this->Match(score, fields.fname,       search, 100)) { break; }
+            if (match = this->Match(score, fields.description, search, 200)) { break; }
+            for (size_t j = 0; j < fields.author_names.size(); j++)
             {
-                if (match = this->Match(score, author.name,  query.cqy_search_string, 300)) { break; }
-                if (match = this->Match(score, author.email, query.cqy_search_string, 400)) { break; }
+                if (match = this->Match(score, fields.author_names[j],  search, 300)) { break; }
+                if (match = this->Match(score, fields.author_emails[j], search, 400)) { break; }
             }
             break;
 
         case CacheSearchMethod::GUID:
-            match = this->Match(score, entry.guid, query.cqy_search_string, 0);
+            match = this->Match(score, fields.guid, search, 0);
             break;
 
         case CacheSearchMethod::AUTHORS:
-            for (AuthorInfo const& author: entry.authors)
+            for (size_t j = 0; j < fields.author_names.size(); j++)
             {
-                if (match = this->Match(score, author.name,  query.cqy_search_string, 0)) { break; }
-                if (match = this->Match(score, author.email, query.cqy_search_string, 0)) { break; }
+                if (match = this->Match(score, fields.author_names[j],  search, 0)) { break; }
+                if (match = this->Match(score, fields.author_emails[j], search, 0)) { break; }
             }
             break;
 
         case CacheSearchMethod::WHEELS:
-            wheels_str << entry.wheelcount << "x" << entry.propwheelcount;
-            match = this->Match(score, wheels_str.ToCStr(), query.cqy_search_string, 0);
+            wheels_str << fields.wheelcount << "x" << fields.propwheelcount;
+            match = this->Match(score, wheels_str.ToCStr(), search, 0);
             break;
 
         case CacheSearchMethod::FILENAME:
-            match = this->Match(score, entry.fname, query.cqy_search_string, 100);
+            match = this->Match(score, fields.fname, search, 100);
             break;
 
         default: // CacheSearchMethod::NONE
@@ -1365,15 +2151,52 @@ size_t CacheSystem::Query(CacheQuery& query)
             query.cqy_results.emplace_back(&entry, score);
             query.cqy_res_last_update = std::max(query.cqy_res_last_update, entry.addtimestamp);
         }
+        else if (use_fuzzy)
+        {
+            unmatched.push_back(i);
+        }
+    }
+
+    // No exact match, maybe a typo: rank names and filenames by how many trigrams of the query they contain
+    if (query.cqy_results.empty() && use_fuzzy)
+    {
+        const size_t num_trigrams = search.size() - 2;
+        const size_t min_hits = static_cast<size_t>(std::ceil(num_trigrams * FUZZY_SEARCH_MIN_HITS));
+        for (uint32_t i : unmatched)
+        {
+            SearchFields const& fields = m_search_fields[i];
+            size_t hits = 0;
+            for (size_t j = 0; j < num_trigrams; j++)
+            {
+                if (fields.dname.find(search.c_str() + j, 0, 3) != std::string::npos ||
+                    fields.fname.find(search.c_str() + j, 0, 3) != std::string::npos)
+                {
+                    hits++;
+                }
+            }
+            if (hits >= min_hits)
+            {
+                query.cqy_results.emplace_back(&m_entries[i], FUZZY_SEARCH_SCORE + (num_trigrams - hits));
+                query.cqy_res_last_update = std::max(query.cqy_res_last_update, m_entries[i].addtimestamp);
+            }
+        }
     }
 
-    std::sort(query.cqy_results.begin(), query.cqy_results.end());
+    // Same order as `CacheQueryResult::operator<`, but with the names already lowercase
+    std::sort(query.cqy_results.begin(), query.cqy_results.end(),
+        [this](CacheQueryResult const& a, CacheQueryResult const& b)
+        {
+            if (a.cqr_score == b.cqr_score)
+            {
+                return m_search_fields[a.cqr_entry->number - 1].dname < m_search_fields[b.cqr_entry->number - 1].dname;
+            }
+            return a.cqr_score < b.cqr_score;
+        });
     return query.cqy_results.size();
 }
 
-bool CacheSystem::Match(size_t& out_score, std::string data, std::string const& query, size_t score)
+bool CacheSystem::Match(size_t& out_score, std::string const& data, std::string const& query, size_t score)
 {
-    Ogre::StringUtil::toLowerCase(data);
     size_t pos = data.find(query);
     if (pos != std::string::npos)
     {
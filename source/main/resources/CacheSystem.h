@@ -33,22 +33,99 @@
 
 #include <Ogre.h>
 #include <rapidjson/document.h>
+#include <limits>
+#include <memory>
 #include <string>
+#include <unordered_map>
 
 #define CACHE_FILE "mods.cache"
-#define CACHE_FILE_FORMAT 12
+#define CACHE_FILE_BINARY "mods.bincache" // Compact copy of CACHE_FILE, loaded in its place
+#define CACHE_FILE_FORMAT 13
 #define CACHE_FILE_FRESHNESS 86400 // 60*60*24 = one day
+#define CACHE_ACTORDEF_EXT ".actordef" // Parsed truckfiles, named by SHA1 of the file
 
 namespace RoR {
 
+/// A string which repeats across many cache entries (bundle paths and types, extensions, authors, categories).
+/// All equal strings share one pooled instance, so they're stored once and compare by pointer.
+/// The pool only grows; it holds the distinct values, which are few compared to the entries.
+class CacheString
+{
+public:
+    CacheString();
+    CacheString(std::string const& str);
+    CacheString& operator=(std::string const& str) { return *this = CacheString(str); }
+
+    std::string const& str() const { return *m_str; }
+    operator std::string const&() const { return *m_str; }
+    const char* c_str() const { return m_str->c_str(); }
+    bool empty() const { return m_str->empty(); }
+
+    bool operator==(CacheString const& other) const { return m_str == other.m_str; }
+    bool operator!=(CacheString const& other) const { return m_str != other.m_str; }
+    bool operator==(std::string const& other) const { return *m_str == other; }
+    bool operator!=(std::string const& other) const { return *m_str != other; }
+    bool operator==(const char* other) const { return *m_str == other; }
+    bool operator!=(const char* other) const { return *m_str != other; }
+
+private:
+    const std::string* m_str; //!< Owned by the pool, see `CacheString::CacheString()`
+};
+
 struct AuthorInfo
 {
     int id;
-    Ogre::String type;
-    Ogre::String name;
-    Ogre::String email;
+    CacheString type;
+    CacheString name;
+    CacheString email;
+};
+
+/// Information only displayed by the selector or written to the cache file.
+/// Entries loaded from CACHE_FILE_BINARY leave it on disk until `CacheSystem::GetEntryDetails()`.
+struct CacheEntryDetails
+{
+    std::vector<AuthorInfo> authors;    //!< authors
+    Ogre::String description;
+    Ogre::String tags;
+
+    // following all TRUCK detail information:
+    int fileformatversion = 0;
+    bool hasSubmeshs = false;
+    int nodecount = 0;
+    int beamcount = 0;
+    int shockcount = 0;
+    int fixescount = 0;
+    int hydroscount = 0;
+    int wheelcount = 0;
+    int propwheelcount = 0;
+    int commandscount = 0;
+    int flarescount = 0;
+    int propscount = 0;
+    int wingscount = 0;
+    int turbopropscount = 0;
+    int turbojetcount = 0;
+    int rotatorscount = 0;
+    int exhaustscount = 0;
+    int flexbodiescount = 0;
+    int soundsourcescount = 0;
+
+    float truckmass = 0.f;
+    float loadmass = 0.f;
+    float minrpm = 0.f;
+    float maxrpm = 0.f;
+    float torque = 0.f;
+    bool customtach = false;
+    bool custom_particles = false;
+    bool forwardcommands = false;
+    bool importcommands = false;
+    bool rescuer = false;
+
+    int numgears = 0;
+    char enginetype = 't'; // enginetype = t = truck is default
 };
 
+static const uint32_t CACHE_BIN_INDEX_NONE = std::numeric_limits<uint32_t>::max();
+
 class CacheEntry
 {
 
@@ -63,21 +140,20 @@ public:
     Ogre::String dname;                 //!< name parsed from the file
 
     int categoryid;                     //!< category id
-    Ogre::String categoryname;          //!< category name
+    CacheString categoryname;           //!< category name
 
     std::time_t addtimestamp;           //!< timestamp when this file was added to the cache
 
     Ogre::String uniqueid;              //!< file's unique id
     Ogre::String guid;                  //!< global unique id
     int version;                        //!< file's version
-    Ogre::String fext;                  //!< file's extension
-    std::string resource_bundle_type;   //!< Archive type recognized by OGRE resource system: 'FileSystem' or 'Zip'
-    std::string resource_bundle_path;   //!< Path of ZIP or directory which contains the media. Shared between CacheEntries, loaded only once.
+    CacheString fext;                   //!< file's extension
+    CacheString resource_bundle_type;   //!< Archive type recognized by OGRE resource system: 'FileSystem' or 'Zip'
+    CacheString resource_bundle_path;   //!< Path of ZIP or directory which contains the media. Shared between CacheEntries, loaded only once.
     int number;                         //!< Sequential number, assigned internally, used by Selector-GUI
     std::time_t filetime;               //!< filetime
     bool deleted;                       //!< is this mod deleted?
     int usagecounter;                   //!< how much it was used already
-    std::vector<AuthorInfo> authors;    //!< authors
     Ogre::String filecachename;         //!< preview image filename
 
     Ogre::String resource_group;        //!< Resource group of the loaded bundle. Empty if not loaded yet.
@@ -85,44 +161,12 @@ public:
     RigDef::DocumentPtr actor_def; //!< Cached actor definition (aka truckfile) after first spawn
     std::shared_ptr<RoR::SkinDef> skin_def;  //!< Cached skin info, added on first use or during cache rebuild
 
-    // following all TRUCK detail information:
-    Ogre::String description;
-    Ogre::String tags;
-    std::string default_skin;
-    int fileformatversion;
-    bool hasSubmeshs;
-    int nodecount;
-    int beamcount;
-    int shockcount;
-    int fixescount;
-    int hydroscount;
-    int wheelcount;
-    int propwheelcount;
-    int commandscount;
-    int flarescount;
-    int propscount;
-    int wingscount;
-    int turbopropscount;
-    int turbojetcount;
-    int rotatorscount;
-    int exhaustscount;
-    int flexbodiescount;
-    int soundsourcescount;
-
-    float truckmass;
-    float loadmass;
-    float minrpm;
-    float maxrpm;
-    float torque;
-    bool customtach;
-    bool custom_particles;
-    bool forwardcommands;
-    bool importcommands;
-    bool rescuer;
+    mutable std::shared_ptr<CacheEntryDetails> details; //!< Null until needed, use `CacheSystem::GetEntryDetails()`
+    uint32_t details_bin_index;         //!< Record in CACHE_FILE_BINARY which has the details; CACHE_BIN_INDEX_NONE if they're in memory only
 
+    // following TRUCK information needed for spawning; the rest is in `details`
+    std::string default_skin;
     ActorType driveable;
-    int numgears;
-    char enginetype;
     std::vector<Ogre::String> sectionconfigs;
 };
 
@@ -184,9 +228,13 @@ enum class CacheValidity
 ///    RoR users usually have A LOT of content installed. Traversing it all on every game startup would be a pain.
 /// HOW IT WORKS:
 ///    For each recognized resource type (vehicle, terrain, skin...) an instance of 'CacheEntry' is created.
-///       These entries are persisted in file CACHE_FILE (see above)
+///       These entries are persisted in file CACHE_FILE (see above); for quick startup, also in binary CACHE_FILE_BINARY.
 ///    Associated media live in a "resource bundle" (ZIP archive or subdirectory) in content directory (ROR_HOME/mods) and subdirectories.
 ///       If multiple CacheEntries share a bundle, the bundle is loaded only once. Each bundle has dedicated OGRE resource group.
+///    Each scanned ZIP archive and loose file has a fingerprint (size + modification time) in CACHE_FILE;
+///       on update, only files with missing or changed fingerprints are (re)scanned.
+///    Parsed actor definitions are saved next to CACHE_FILE (binary, see RigDef_BinarySerializer.h), so respawning
+///       an actor in a later session doesn't need to parse the truckfile again.
 class CacheSystem
 {
 public:
@@ -198,9 +246,10 @@ public:
     CacheEntry*           FindEntryByFilename(RoR::LoaderType type, bool partial, std::string filename); //!< Returns NULL if none found
     CacheEntry*           FetchSkinByName(std::string const & skin_name);
     CacheValidity         EvaluateCacheValidity();
-    size_t                Query(CacheQuery& query);
+    size_t                Query(CacheQuery& query); //!< Read-only, may run on a worker thread while the cache isn't being updated.
 
     void LoadResource(CacheEntry& t); //!< Loads the associated resource bundle if not already done.
+    std::shared_ptr<Task> PrefetchResource(CacheEntry const& t); //!< Reads the bundle's ZIP file in background, so `LoadResource()` doesn't wait for the disk. Null if there's nothing to do.
     bool CheckResourceLoaded(Ogre::String &in_out_filename); //!< Finds + loads the associated resource bundle if not already done.
     bool CheckResourceLoaded(Ogre::String &in_out_filename, Ogre::String &out_group); //!< Finds given resource, outputs group name. Also loads the associated resource bundle if not already done.
     void ReLoadResource(CacheEntry& t); //!< Forces reloading the associated bundle.
@@ -208,19 +257,28 @@ public:
 
     const std::vector<CacheEntry>   &GetEntries()        const { return m_entries; }
     const CategoryIdNameMap         &GetCategories()     const { return m_categories; }
+    CacheEntryDetails const&        GetEntryDetails(CacheEntry const& entry); //!< Loads them from CACHE_FILE_BINARY on first use; main thread only.
 
     std::shared_ptr<RoR::SkinDef> FetchSkinDef(CacheEntry* cache_entry); //!< Loads+parses the .skin file once
 
+    RigDef::DocumentPtr   LoadCachedActorDef(std::string const& file_hash); //!< Returns NULL if not cached or outdated.
+    void                  SaveCachedActorDef(RigDef::DocumentPtr def); //!< Keyed by `def->hash`.
+
     CacheEntry *GetEntry(int modid);
     Ogre::String GetPrettyName(Ogre::String fname);
     std::string ActorTypeToName(ActorType driveable);
 
 private:
 
+    CacheValidity LoadCacheFile(); //!< Loads CACHE_FILE_BINARY, or CACHE_FILE if the binary one is missing or stale.
     void WriteCacheFileJson();
     void ExportEntryToJson(rapidjson::Value& j_entries, rapidjson::Document& j_doc, CacheEntry const & entry);
     CacheValidity LoadCacheFileJson();
     void ImportEntryFromJson(rapidjson::Value& j_entry, CacheEntry & out_entry);
+    void WriteCacheFileBinary(); //!< Must be called right after `WriteCacheFileJson()`
+    CacheValidity LoadCacheFileBinary();
+    void LoadEntryDetailsBinary(uint32_t bin_index, CacheEntryDetails& out_details); //!< Reads only the entry's records and strings, see `m_bin_layout`
+    void SetEntryCategory(CacheEntry& entry, int category_id); //!< Unknown categories become 'Unsorted'
 
     static Ogre::String StripUIDfromString(Ogre::String uidstr); 
     static Ogre::String StripSHA1fromString(Ogre::String sha1str);
@@ -234,8 +292,15 @@ private:
     void ClearResourceGroups();
 
     void AddFile(Ogre::String group, Ogre::FileInfo f, Ogre::String ext);
+    void FlushPendingEntries(); //!< Parses the queued truck files on the thread pool, then adds all pending entries in order.
 
     void DetectDuplicates();
+    std::time_t UpdateBundleFingerprint(std::string const& path); //!< Records size + modification time of a scanned file, returns the time.
+    bool CheckBundleFingerprint(std::string const& path) const; //!< Is the file unchanged since it was scanned?
+    void AddEntry(CacheEntry& entry); //!< Numbers the entry, appends it to `m_entries` and indexes it for `DetectDuplicates()` and `Query()`
+    void ClearEntries();              //!< Clears `m_entries` and the indices
+    void FindSearchCandidates(std::string const& query, std::vector<uint32_t>& out_candidates) const; //!< Entries containing all trigrams of the query (sorted)
+    static std::string GetDuplicateKey(CacheEntry const& entry); //!< Normalized filename without UID + name + bundle name without SHA1
 
     void FillTerrainDetailInfo(CacheEntry &entry, Ogre::DataStreamPtr ds, Ogre::String fname);
     void FillTruckDetailInfo(CacheEntry &entry, Ogre::DataStreamPtr ds, Ogre::String fname, Ogre::String group);
@@ -245,14 +310,63 @@ private:
     void GenerateFileCache(CacheEntry &entry, Ogre::String group);
     void RemoveFileCache(CacheEntry &entry);
 
-    bool Match(size_t& out_score, std::string data, std::string const& query, size_t );
+    bool Match(size_t& out_score, std::string const& data, std::string const& query, size_t ); //!< Expects lowercase `data`
+
+    /// Lowercase texts of an entry for searching, see `Query()`
+    struct SearchFields
+    {
+        std::string              dname;
+        std::string              fname;
+        std::string              description;
+        std::string              guid;
+        std::vector<std::string> author_names;
+        std::vector<std::string> author_emails;
+        int                      wheelcount = 0;
+        int                      propwheelcount = 0;
+    };
+
+    /// Where the records of CACHE_FILE_BINARY are, kept by `LoadCacheFileBinary()` for `LoadEntryDetailsBinary()`
+    struct CacheBinLayout
+    {
+        size_t                file_size = 0;   //!< A different size means the file was rewritten since
+        size_t                strings_pos = 0;
+        size_t                entries_pos = 0;
+        size_t                authors_pos = 0;
+        std::vector<uint32_t> string_offsets;  //!< Start of each string relative to `strings_pos`, plus the end of the last one
+    };
+
+    /// Entries found by `AddFile()`, waiting for `FlushPendingEntries()`
+    struct PendingEntries
+    {
+        std::vector<CacheEntry> entries;
+        Ogre::DataStreamPtr     truck_stream; //!< In-memory copy of the truck file to parse into `entries[0]`; null if the entries are complete
+        std::string             truck_group;
+        std::string             error;        //!< Set if parsing failed, the entries are then dropped
+    };
+
+    struct BundleFingerprint
+    {
+        uint64_t    size = 0;
+        std::time_t filetime = 0;
+    };
+
+    static const size_t MAX_PENDING_TRUCKS = 200; //!< Limits memory held by the in-memory truck files
+
+    std::vector<PendingEntries>          m_pending_entries;
+    size_t                               m_num_pending_trucks = 0;
 
     std::time_t                          m_update_time;      //!< Ensures that all inserted files share the same timestamp
     std::string                          m_filenames_hash_loaded;   //!< hash from cachefile, for quick update detection
     std::string                          m_filenames_hash_generated;   //!< stores hash over the content, for quick update detection
     std::vector<CacheEntry>              m_entries;
+    CacheBinLayout                       m_bin_layout;
+    std::map<std::string, BundleFingerprint> m_bundle_fingerprints; //!< By path of the ZIP archive or loose file
+    std::unordered_map<std::string, std::vector<size_t>> m_duplicate_index; //!< Entries (indices into `m_entries`) by `GetDuplicateKey()`
+    std::vector<SearchFields>            m_search_fields;    //!< Same indices as `m_entries`
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_search_trigrams; //!< Entries (sorted indices into `m_entries`) by lowercase trigram in name, filename, description or authors
     std::vector<Ogre::String>            m_known_extensions; //!< the extensions we track in the cache system
     std::set<Ogre::String>               m_resource_paths;   //!< A temporary list of existing resource paths
+    std::map<std::string, std::shared_ptr<Task>> m_prefetch_tasks; //!< By bundle path; until the bundle gets loaded
     std::map<int, Ogre::String>          m_categories = {
             // these are the category numbers from the repository. do not modify them!
 
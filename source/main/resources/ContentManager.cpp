@@ -34,6 +34,7 @@
 #include "SkinFileFormat.h"
 #include "Language.h"
 #include "PlatformUtils.h"
+#include "ShaderCache.h"
 
 #include "CacheSystem.h"
 
@@ -387,6 +388,10 @@ void ContentManager::LoadGameplayResources()
         this->AddResourcePack(ContentManager::ResourcePack::OVERLAYS);
         this->AddResourcePack(ContentManager::ResourcePack::PARTICLES);
 
+        // Compile the shared shaders behind the loading screen rather than when the first actor shows up
+        ShaderCache::PrecompilePrograms(RGN_MANAGED_MATS);
+        ShaderCache::PrecompilePrograms(ContentManager::ResourcePack::MATERIALS.resource_group_name);
+
         m_base_resource_loaded = true;
     }
 
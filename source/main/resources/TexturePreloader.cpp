@@ -0,0 +1,202 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "TexturePreloader.h"
+
+#include "Application.h"
+#include "ThreadPool.h"
+
+#include <OgreMaterialManager.h>
+#include <OgrePass.h>
+#include <OgreResourceGroupManager.h>
+#include <OgreTechnique.h>
+#include <OgreTextureManager.h>
+#include <OgreTextureUnitState.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fmt/format.h>
+#include <set>
+
+using namespace RoR;
+
+std::shared_ptr<TexturePreloader> TexturePreloader::Start(std::string const& resource_group)
+{
+    if (resource_group.empty())
+    {
+        return nullptr;
+    }
+
+    // Only textures the group's materials actually use - bundles often carry unused skins.
+    std::set<std::string> names;
+    Ogre::ResourceManager::ResourceMapIterator mat_itor = Ogre::MaterialManager::getSingleton().getResourceIterator();
+    while (mat_itor.hasMoreElements())
+    {
+        Ogre::MaterialPtr mat = mat_itor.getNext().staticCast<Ogre::Material>();
+        if (mat->getGroup() != resource_group)
+        {
+            continue;
+        }
+        for (Ogre::Technique* tech: mat->getTechniques())
+        {
+            for (Ogre::Pass* pass: tech->getPasses())
+            {
+                for (Ogre::TextureUnitState* tus: pass->getTextureUnitStates())
+                {
+                    // Cubemaps and gamma-corrected textures need other load parameters; leave them to OGRE.
+                    if (tus->getTextureType() != Ogre::TEX_TYPE_2D || tus->isHardwareGammaEnabled())
+                    {
+                        continue;
+                    }
+                    for (unsigned int i = 0; i < tus->getNumFrames(); ++i)
+                    {
+                        names.insert(tus->getFrameTextureName(i));
+                    }
+                }
+            }
+        }
+    }
+
+    auto items = std::make_shared<std::vector<Item>>();
+    Ogre::ResourceGroupManager& rgm = Ogre::ResourceGroupManager::getSingleton();
+    for (std::string const& name: names)
+    {
+        if (name.empty() ||
+            Ogre::TextureManager::getSingleton().resourceExists(name, resource_group) ||
+            !rgm.resourceExists(resource_group, name))
+        {
+            continue;
+        }
+
+        Item item;
+        item.name = name;
+        std::string basename;
+        Ogre::StringUtil::splitBaseFilename(name, basename, item.ext);
+        Ogre::StringUtil::toLowerCase(item.ext);
+        try
+        {
+            Ogre::DataStreamPtr file = rgm.openResource(name, resource_group);
+            item.data = Ogre::DataStreamPtr(OGRE_NEW Ogre::MemoryDataStream(file));
+        }
+        catch (Ogre::Exception&)
+        {
+            continue; // OGRE will report it when the material loads
+        }
+        items->push_back(item);
+    }
+
+    if (items->empty())
+    {
+        return nullptr;
+    }
+
+    auto preloader = std::make_shared<TexturePreloader>();
+    preloader->m_group = resource_group;
+    preloader->m_items = items;
+    const int max_size = App::gfx_texture_max_size->getInt();
+    preloader->m_task = App::GetThreadPool()->RunTask([items, max_size]()
+        {
+            App::GetThreadPool()->ParallelFor(items->size(), [items, max_size](size_t i)
+                {
+                    Item& item = (*items)[i];
+                    try
+                    {
+                        item.image.load(item.data, item.ext);
+                        ReduceImage(item.image, max_size);
+                        item.decoded = true;
+                    }
+                    catch (Ogre::Exception&)
+                    {
+                        // Leave it to OGRE, it will report the problem when the material loads
+                    }
+                    item.data.reset();
+                });
+        });
+    return preloader;
+}
+
+bool TexturePreloader::IsFinished() const
+{
+    return m_task->is_finished();
+}
+
+void TexturePreloader::CreateTextures()
+{
+    m_task->join();
+
+    int num_created = 0;
+    for (Item& item: *m_items)
+    {
+        if (!item.decoded || Ogre::TextureManager::getSingleton().resourceExists(item.name, m_group))
+        {
+            continue;
+        }
+
+        try
+        {
+            // The texture keeps its file name, so OGRE can reload it from the bundle if the device is lost.
+            Ogre::TextureManager::getSingleton().loadImage(item.name, m_group, item.image);
+            ++num_created;
+        }
+        catch (Ogre::Exception& e)
+        {
+            LOG(fmt::format("[RoR|TexturePreloader] Could not create texture '{}', message: {}", item.name, e.getFullDescription()));
+        }
+        item.image = Ogre::Image(); // Free the pixels, the GPU has them now
+    }
+
+    LOG(fmt::format("[RoR|TexturePreloader] Created {} textures in group '{}'", num_created, m_group));
+}
+
+void TexturePreloader::ReduceImage(Ogre::Image& image, int max_size)
+{
+    const Ogre::uint32 size = std::max(image.getWidth(), image.getHeight());
+    if (max_size <= 0 || size <= (Ogre::uint32)max_size || image.getNumFaces() != 1 || image.getDepth() != 1)
+    {
+        return;
+    }
+
+    if (image.getNumMipmaps() > 0)
+    {
+        // Skip the top mip levels; works for compressed formats too.
+        // With a single face the mips are stored one after another, so the rest is a contiguous tail.
+        Ogre::uint32 skip = 0;
+        while ((size >> skip) > (Ogre::uint32)max_size && skip < image.getNumMipmaps())
+        {
+            ++skip;
+        }
+        const Ogre::PixelBox top = image.getPixelBox(0, skip);
+        const size_t num_bytes = image.getSize() - (static_cast<Ogre::uchar*>(top.data) - image.getData());
+        Ogre::uchar* data = OGRE_ALLOC_T(Ogre::uchar, num_bytes, Ogre::MEMCATEGORY_GENERAL);
+        memcpy(data, top.data, num_bytes);
+
+        Ogre::Image reduced;
+        reduced.loadDynamicImage(data, top.getWidth(), top.getHeight(), 1, image.getFormat(),
+            /*autoDelete=*/true, /*numFaces=*/1, image.getNumMipmaps() - skip);
+        image = reduced;
+    }
+    else if (!Ogre::PixelUtil::isCompressed(image.getFormat()))
+    {
+        const float scale = static_cast<float>(max_size) / static_cast<float>(size);
+        image.resize(static_cast<Ogre::ushort>(image.getWidth() * scale), static_cast<Ogre::ushort>(image.getHeight() * scale));
+    }
+}
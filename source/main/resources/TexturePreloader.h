@@ -0,0 +1,70 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/// @file
+/// @brief Decodes an actor's textures on the thread pool before it's spawned.
+
+#pragma once
+
+#include "ForwardDeclarations.h"
+
+#include <OgreDataStream.h>
+#include <OgreImage.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// Reads the textures used by materials of a resource group and decodes them on the thread pool,
+/// so that spawning the actor only uploads them instead of stalling on PNG/JPG/DDS decoding.
+/// Textures larger than 'gfx_texture_max_size' are reduced on the way: DDS files by skipping
+/// their top mip levels, other formats by resizing.
+class TexturePreloader
+{
+public:
+    /// Main thread; reads the files (Ogre's archives aren't thread-safe) and starts decoding.
+    /// @return Null if there's nothing to preload.
+    static std::shared_ptr<TexturePreloader> Start(std::string const& resource_group);
+
+    bool                 IsFinished() const;
+    void                 CreateTextures(); //!< Main thread; waits for decoding, then creates the textures which don't exist yet.
+
+private:
+    struct Item
+    {
+        std::string         name;
+        std::string         ext;
+        Ogre::DataStreamPtr data;    //!< File contents; released after decoding
+        Ogre::Image         image;
+        bool                decoded = false;
+    };
+
+    static void          ReduceImage(Ogre::Image& image, int max_size);
+
+    std::string                        m_group;
+    std::shared_ptr<std::vector<Item>> m_items; //!< Shared with `m_task`, which may outlive a cancelled spawn
+    std::shared_ptr<Task>              m_task;
+};
+
+} // namespace RoR
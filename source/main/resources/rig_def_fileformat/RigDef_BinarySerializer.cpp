@@ -0,0 +1,1474 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+
+#include "RigDef_BinarySerializer.h"
+
+#include "RigDef_File.h"
+#include "RoRVersion.h"
+
+#include <cstring>
+#include <list>
+#include <map>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+namespace RigDef
+{
+
+static const char     BINARY_SIGNATURE[] = "RoR ActorDef";
+static const uint32_t BINARY_FORMAT_VERSION = 3; //!< Bump when changing the `Visit()` functions below.
+
+struct BinaryHeader
+{
+    char     signature[sizeof(BINARY_SIGNATURE)];
+    uint32_t format_version;
+    uint32_t layout_fingerprint;
+    uint32_t build_fingerprint; //!< Cached documents skip the validator, so one written by another build of the parser must not be loaded.
+};
+
+// --------------------------------------------------------------------------
+// Archives; each `Visit()` function below lists fields of one struct, the same list is used for writing and reading.
+// --------------------------------------------------------------------------
+
+template<class T> struct IsPlainValue: std::integral_constant<bool, std::is_arithmetic<T>::value || std::is_enum<T>::value> {};
+
+/// Element to read into; not all structs have a default constructor.
+template<class T> T MakeBlank()                                { return T(); }
+template<> Node::Range MakeBlank<Node::Range>()                { return Node::Range(Node::Ref()); }
+template<> Document::Module MakeBlank<Document::Module>()      { return Document::Module(""); }
+
+static unsigned GetNodeRefFlags(Node::Ref const& ref)
+{
+    unsigned flags = 0;
+    if (ref.GetImportState_IsValid())             { flags |= Node::Ref::IMPORT_STATE_IS_VALID; }
+    if (ref.GetImportState_MustCheckNamedFirst()) { flags |= Node::Ref::IMPORT_STATE_MUST_CHECK_NAMED_FIRST; }
+    if (ref.GetImportState_IsResolvedNamed())     { flags |= Node::Ref::IMPORT_STATE_IS_RESOLVED_NAMED; }
+    if (ref.GetImportState_IsResolvedNumbered())  { flags |= Node::Ref::IMPORT_STATE_IS_RESOLVED_NUMBERED; }
+    if (ref.GetRegularState_IsValid())            { flags |= Node::Ref::REGULAR_STATE_IS_VALID; }
+    if (ref.GetRegularState_IsNamed())            { flags |= Node::Ref::REGULAR_STATE_IS_NAMED; }
+    if (ref.GetRegularState_IsNumbered())         { flags |= Node::Ref::REGULAR_STATE_IS_NUMBERED; }
+    return flags;
+}
+
+enum class NodeIdType: uint8_t
+{
+    INVALID,
+    NUMBERED,
+    NAMED
+};
+
+class BinaryWriter
+{
+public:
+    template<class T> void Field(T& v)  { this->FieldImpl(v, IsPlainValue<T>()); }
+
+    void Field(std::string& v)
+    {
+        this->WriteCount(v.size());
+        m_buf.append(v);
+    }
+
+    void Field(Ogre::Vector3& v)        { this->Raw(v.ptr(), sizeof(float) * 3); }
+    void Field(Ogre::ColourValue& v)    { this->Raw(v.ptr(), sizeof(float) * 4); }
+
+    void Field(Node::Id& v)
+    {
+        NodeIdType type = (v.IsTypeNumbered()) ? NodeIdType::NUMBERED : ((v.IsTypeNamed()) ? NodeIdType::NAMED : NodeIdType::INVALID);
+        unsigned num = v.Num();
+        std::string str = v.Str();
+        this->Field(type);
+        this->Field(num);
+        this->Field(str);
+    }
+
+    void Field(Node::Ref& v)
+    {
+        std::string str = v.Str();
+        unsigned num = v.Num();
+        unsigned flags = GetNodeRefFlags(v);
+        unsigned line = v.GetLineNumber();
+        this->Field(str);
+        this->Field(num);
+        this->Field(flags);
+        this->Field(line);
+    }
+
+    template<class T, size_t N> void Field(T (&arr)[N])
+    {
+        for (T& item: arr)
+        {
+            this->Field(item);
+        }
+    }
+
+    template<class T> void Field(std::vector<T>& v)
+    {
+        this->WriteCount(v.size());
+        for (T& item: v)
+        {
+            this->Field(item);
+        }
+    }
+
+    template<class T> void Field(std::list<T>& v)
+    {
+        this->WriteCount(v.size());
+        for (T& item: v)
+        {
+            this->Field(item);
+        }
+    }
+
+    template<class T> void Field(std::map<std::string, T>& v)
+    {
+        this->WriteCount(v.size());
+        for (auto& pair: v)
+        {
+            std::string key = pair.first;
+            this->Field(key);
+            this->Field(pair.second);
+        }
+    }
+
+    /// Shared defaults are written once, on first use; later uses only refer to them.
+    template<class T> void Field(std::shared_ptr<T>& ptr)
+    {
+        uint32_t id = 0; // Null
+        if (ptr != nullptr)
+        {
+            auto itor = m_shared_ids.find(ptr.get());
+            if (itor != m_shared_ids.end())
+            {
+                id = itor->second;
+                this->Field(id);
+                return;
+            }
+            id = static_cast<uint32_t>(m_shared_ids.size() + 1);
+            m_shared_ids.insert(std::make_pair(ptr.get(), id));
+        }
+        this->Field(id);
+        if (ptr != nullptr)
+        {
+            this->Field(*ptr);
+        }
+    }
+
+    void Raw(const void* src, size_t len) { m_buf.append(static_cast<const char*>(src), len); }
+    std::string& GetBuffer() { return m_buf; }
+
+private:
+    template<class T> void FieldImpl(T& v, std::true_type)  { this->Raw(&v, sizeof(T)); }
+    template<class T> void FieldImpl(T& v, std::false_type) { Visit(*this, v); }
+
+    void WriteCount(size_t count)
+    {
+        uint32_t count32 = static_cast<uint32_t>(count);
+        this->Field(count32);
+    }
+
+    std::string                     m_buf;
+    std::map<const void*, uint32_t> m_shared_ids;
+};
+
+class BinaryReader
+{
+public:
+    BinaryReader(const char* data, size_t size): m_data(data), m_size(size) {}
+
+    template<class T> void Field(T& v)  { this->FieldImpl(v, IsPlainValue<T>()); }
+
+    void Field(std::string& v)
+    {
+        const uint32_t len = this->ReadCount();
+        v.assign(m_data + m_pos, len);
+        m_pos += len;
+    }
+
+    void Field(Ogre::Vector3& v)        { this->Raw(v.ptr(), sizeof(float) * 3); }
+    void Field(Ogre::ColourValue& v)    { this->Raw(v.ptr(), sizeof(float) * 4); }
+
+    void Field(Node::Id& v)
+    {
+        NodeIdType type = NodeIdType::INVALID;
+        unsigned num = 0;
+        std::string str;
+        this->Field(type);
+        this->Field(num);
+        this->Field(str);
+        switch (type)
+        {
+        case NodeIdType::NUMBERED: v.SetNum(num);  break;
+        case NodeIdType::NAMED:    v.setStr(str); break;
+        default:                   v.Invalidate();
+        }
+    }
+
+    void Field(Node::Ref& v)
+    {
+        std::string str;
+        unsigned num = 0;
+        unsigned flags = 0;
+        unsigned line = 0;
+        this->Field(str);
+        this->Field(num);
+        this->Field(flags);
+        this->Field(line);
+        v = Node::Ref(str, num, flags, line);
+    }
+
+    template<class T, size_t N> void Field(T (&arr)[N])
+    {
+        for (T& item: arr)
+        {
+            this->Field(item);
+        }
+    }
+
+    template<class T> void Field(std::vector<T>& v)
+    {
+        const uint32_t count = this->ReadCount();
+        v.clear();
+        v.reserve(count);
+        for (uint32_t i = 0; i < count && !m_error; i++)
+        {
+            v.push_back(MakeBlank<T>());
+            this->Field(v.back());
+        }
+    }
+
+    template<class T> void Field(std::list<T>& v)
+    {
+        const uint32_t count = this->ReadCount();
+        v.clear();
+        for (uint32_t i = 0; i < count && !m_error; i++)
+        {
+            v.push_back(MakeBlank<T>());
+            this->Field(v.back());
+        }
+    }
+
+    template<class T> void Field(std::map<std::string, T>& v)
+    {
+        const uint32_t count = this->ReadCount();
+        v.clear();
+        for (uint32_t i = 0; i < count && !m_error; i++)
+        {
+            std::string key;
+            T value = MakeBlank<T>();
+            this->Field(key);
+            this->Field(value);
+            v[key] = value;
+        }
+    }
+
+    template<class T> void Field(std::shared_ptr<T>& ptr)
+    {
+        uint32_t id = 0;
+        this->Field(id);
+        ptr = nullptr;
+        if (id == 0)
+        {
+            return;
+        }
+        if (id == m_shared.size() + 1) // First use
+        {
+            ptr = std::make_shared<T>(MakeBlank<T>());
+            m_shared.push_back(SharedObject{ ptr, &typeid(T) });
+            this->Field(*ptr);
+        }
+        else if (id <= m_shared.size() && *m_shared[id - 1].type == typeid(T))
+        {
+            ptr = std::static_pointer_cast<T>(m_shared[id - 1].ptr);
+        }
+        else
+        {
+            m_error = true;
+        }
+    }
+
+    void Raw(void* dst, size_t len)
+    {
+        if (m_error || len > m_size - m_pos)
+        {
+            m_error = true;
+            std::memset(dst, 0, len);
+            return;
+        }
+        std::memcpy(dst, m_data + m_pos, len);
+        m_pos += len;
+    }
+
+    bool IsOk() const { return !m_error && m_pos == m_size; }
+
+private:
+    struct SharedObject
+    {
+        std::shared_ptr<void> ptr;
+        const std::type_info* type;
+    };
+
+    template<class T> void FieldImpl(T& v, std::true_type)  { this->Raw(&v, sizeof(T)); }
+    template<class T> void FieldImpl(T& v, std::false_type) { Visit(*this, v); }
+
+    /// Every element takes at least 1 byte, larger counts mean damaged data.
+    uint32_t ReadCount()
+    {
+        uint32_t count = 0;
+        this->Field(count);
+        if (count > m_size - m_pos)
+        {
+            m_error = true;
+            return 0;
+        }
+        return count;
+    }
+
+    const char*                m_data;
+    size_t                     m_size;
+    size_t                     m_pos = 0;
+    bool                       m_error = false;
+    std::vector<SharedObject>  m_shared;
+};
+
+// --------------------------------------------------------------------------
+// Fields of the document; must list every member of every struct, see RigDef_File.h
+// --------------------------------------------------------------------------
+
+template<class AR> void Visit(AR& ar, AeroAnimator& d)
+{
+    ar.Field(d.flags);
+    ar.Field(d.engine_idx);
+}
+
+template<class AR> void Visit(AR& ar, BaseWheel& d)
+{
+    ar.Field(d.width);
+    ar.Field(d.num_rays);
+    ar.Field(d.nodes);
+    ar.Field(d.rigidity_node);
+    ar.Field(d.braking);
+    ar.Field(d.propulsion);
+    ar.Field(d.reference_arm_node);
+    ar.Field(d.mass);
+    ar.Field(d.node_defaults);
+    ar.Field(d.beam_defaults);
+}
+
+template<class AR> void Visit(AR& ar, BaseMeshWheel& d)
+{
+    Visit(ar, static_cast<BaseWheel&>(d));
+    ar.Field(d.side);
+    ar.Field(d.mesh_name);
+    ar.Field(d.material_name);
+    ar.Field(d.rim_radius);
+    ar.Field(d.tyre_radius);
+    ar.Field(d.spring);
+    ar.Field(d.damping);
+}
+
+template<class AR> void Visit(AR& ar, BaseWheel2& d)
+{
+    Visit(ar, static_cast<BaseWheel&>(d));
+    ar.Field(d.rim_radius);
+    ar.Field(d.tyre_radius);
+    ar.Field(d.tyre_springiness);
+    ar.Field(d.tyre_damping);
+}
+
+template<class AR> void Visit(AR& ar, Inertia& d)
+{
+    ar.Field(d.start_delay_factor);
+    ar.Field(d.stop_delay_factor);
+    ar.Field(d.start_function);
+    ar.Field(d.stop_function);
+}
+
+template<class AR> void Visit(AR& ar, Airbrake& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.x_axis_node);
+    ar.Field(d.y_axis_node);
+    ar.Field(d.aditional_node);
+    ar.Field(d.offset);
+    ar.Field(d.width);
+    ar.Field(d.height);
+    ar.Field(d.max_inclination_angle);
+    ar.Field(d.texcoord_x1);
+    ar.Field(d.texcoord_x2);
+    ar.Field(d.texcoord_y1);
+    ar.Field(d.texcoord_y2);
+    ar.Field(d.lift_coefficient);
+}
+
+template<class AR> void Visit(AR& ar, Animation::MotorSource& d)
+{
+    ar.Field(d.source);
+    ar.Field(d.motor);
+}
+
+template<class AR> void Visit(AR& ar, Animation& d)
+{
+    ar.Field(d.ratio);
+    ar.Field(d.lower_limit);
+    ar.Field(d.upper_limit);
+    ar.Field(d.source);
+    ar.Field(d.motor_sources);
+    ar.Field(d.mode);
+    ar.Field(d.event_name);
+}
+
+template<class AR> void Visit(AR& ar, Animator& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.lenghtening_factor);
+    ar.Field(d.flags);
+    ar.Field(d.short_limit);
+    ar.Field(d.long_limit);
+    ar.Field(d.aero_animator);
+    ar.Field(d.inertia_defaults);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, AntiLockBrakes& d)
+{
+    ar.Field(d.regulation_force);
+    ar.Field(d.min_speed);
+    ar.Field(d.pulse_per_sec);
+    ar.Field(d.attr_is_on);
+    ar.Field(d.attr_no_dashboard);
+    ar.Field(d.attr_no_toggle);
+}
+
+template<class AR> void Visit(AR& ar, Author& d)
+{
+    ar.Field(d.type);
+    ar.Field(d.forum_account_id);
+    ar.Field(d.name);
+    ar.Field(d.email);
+    ar.Field(d._has_forum_account);
+}
+
+template<class AR> void Visit(AR& ar, Axle& d)
+{
+    ar.Field(d.wheels);
+    ar.Field(d.options);
+}
+
+template<class AR> void Visit(AR& ar, Beam& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.options);
+    ar.Field(d.extension_break_limit);
+    ar.Field(d._has_extension_break_limit);
+    ar.Field(d.detacher_group);
+    ar.Field(d.defaults);
+}
+
+template<class AR> void Visit(AR& ar, BeamDefaultsScale& d)
+{
+    ar.Field(d.springiness);
+    ar.Field(d.damping_constant);
+    ar.Field(d.deformation_threshold_constant);
+    ar.Field(d.breaking_threshold_constant);
+}
+
+template<class AR> void Visit(AR& ar, BeamDefaults& d)
+{
+    ar.Field(d.springiness);
+    ar.Field(d.damping_constant);
+    ar.Field(d.deformation_threshold);
+    ar.Field(d.breaking_threshold);
+    ar.Field(d.visual_beam_diameter);
+    ar.Field(d.beam_material_name);
+    ar.Field(d.plastic_deform_coef);
+    ar.Field(d._enable_advanced_deformation);
+    ar.Field(d._is_plastic_deform_coef_user_defined);
+    ar.Field(d._is_user_defined);
+    ar.Field(d.scale);
+}
+
+template<class AR> void Visit(AR& ar, Brakes& d)
+{
+    ar.Field(d.default_braking_force);
+    ar.Field(d.parking_brake_force);
+}
+
+template<class AR> void Visit(AR& ar, Cab& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.options);
+}
+
+template<class AR> void Visit(AR& ar, Camera& d)
+{
+    ar.Field(d.center_node);
+    ar.Field(d.back_node);
+    ar.Field(d.left_node);
+}
+
+template<class AR> void Visit(AR& ar, CameraRail& d)
+{
+    ar.Field(d.nodes);
+}
+
+template<class AR> void Visit(AR& ar, CameraSettings& d)
+{
+    ar.Field(d.mode);
+}
+
+template<class AR> void Visit(AR& ar, Cinecam& d)
+{
+    ar.Field(d.position);
+    ar.Field(d.nodes);
+    ar.Field(d.spring);
+    ar.Field(d.damping);
+    ar.Field(d.node_mass);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.node_defaults);
+}
+
+template<class AR> void Visit(AR& ar, CollisionBox& d)
+{
+    ar.Field(d.nodes);
+}
+
+template<class AR> void Visit(AR& ar, CollisionRange& d)
+{
+    ar.Field(d.node_collision_range);
+}
+
+template<class AR> void Visit(AR& ar, Command2& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.shorten_rate);
+    ar.Field(d.lengthen_rate);
+    ar.Field(d.max_contraction);
+    ar.Field(d.max_extension);
+    ar.Field(d.contract_key);
+    ar.Field(d.extend_key);
+    ar.Field(d.description);
+    ar.Field(d.inertia);
+    ar.Field(d.affect_engine);
+    ar.Field(d.needs_engine);
+    ar.Field(d.plays_sound);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.inertia_defaults);
+    ar.Field(d.detacher_group);
+    ar.Field(d.option_i_invisible);
+    ar.Field(d.option_r_rope);
+    ar.Field(d.option_c_auto_center);
+    ar.Field(d.option_f_not_faster);
+    ar.Field(d.option_p_1press);
+    ar.Field(d.option_o_1press_center);
+}
+
+template<class AR> void Visit(AR& ar, CruiseControl& d)
+{
+    ar.Field(d.min_speed);
+    ar.Field(d.autobrake);
+}
+
+template<class AR> void Visit(AR& ar, DefaultMinimass& d)
+{
+    ar.Field(d.min_mass_Kg);
+}
+
+template<class AR> void Visit(AR& ar, DefaultSkin& d)
+{
+    ar.Field(d.skin_name);
+}
+
+template<class AR> void Visit(AR& ar, Engine& d)
+{
+    ar.Field(d.shift_down_rpm);
+    ar.Field(d.shift_up_rpm);
+    ar.Field(d.torque);
+    ar.Field(d.global_gear_ratio);
+    ar.Field(d.reverse_gear_ratio);
+    ar.Field(d.neutral_gear_ratio);
+    ar.Field(d.gear_ratios);
+}
+
+template<class AR> void Visit(AR& ar, Engoption& d)
+{
+    ar.Field(d.inertia);
+    ar.Field(d.type);
+    ar.Field(d.clutch_force);
+    ar.Field(d.shift_time);
+    ar.Field(d.clutch_time);
+    ar.Field(d.post_shift_time);
+    ar.Field(d.idle_rpm);
+    ar.Field(d.stall_rpm);
+    ar.Field(d.max_idle_mixture);
+    ar.Field(d.min_idle_mixture);
+    ar.Field(d.braking_torque);
+}
+
+template<class AR> void Visit(AR& ar, Engturbo& d)
+{
+    ar.Field(d.version);
+    ar.Field(d.tinertiaFactor);
+    ar.Field(d.nturbos);
+    ar.Field(d.param1);
+    ar.Field(d.param2);
+    ar.Field(d.param3);
+    ar.Field(d.param4);
+    ar.Field(d.param5);
+    ar.Field(d.param6);
+    ar.Field(d.param7);
+    ar.Field(d.param8);
+    ar.Field(d.param9);
+    ar.Field(d.param10);
+    ar.Field(d.param11);
+}
+
+template<class AR> void Visit(AR& ar, Exhaust& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.direction_node);
+    ar.Field(d.particle_name);
+}
+
+template<class AR> void Visit(AR& ar, ExtCamera& d)
+{
+    ar.Field(d.mode);
+    ar.Field(d.node);
+}
+
+template<class AR> void Visit(AR& ar, FileFormatVersion& d)
+{
+    ar.Field(d.version);
+}
+
+template<class AR> void Visit(AR& ar, Fileinfo& d)
+{
+    ar.Field(d.unique_id);
+    ar.Field(d.category_id);
+    ar.Field(d.file_version);
+}
+
+template<class AR> void Visit(AR& ar, Flare2& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.node_axis_x);
+    ar.Field(d.node_axis_y);
+    ar.Field(d.offset);
+    ar.Field(d.type);
+    ar.Field(d.control_number);
+    ar.Field(d.dashboard_link);
+    ar.Field(d.blink_delay_milis);
+    ar.Field(d.size);
+    ar.Field(d.material_name);
+}
+
+template<class AR> void Visit(AR& ar, Flare3& d)
+{
+    Visit(ar, static_cast<Flare2&>(d));
+    ar.Field(d.inertia_defaults);
+}
+
+template<class AR> void Visit(AR& ar, Flexbody& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.x_axis_node);
+    ar.Field(d.y_axis_node);
+    ar.Field(d.offset);
+    ar.Field(d.rotation);
+    ar.Field(d.mesh_name);
+    ar.Field(d.animations);
+    ar.Field(d.node_list_to_import);
+    ar.Field(d.node_list);
+    ar.Field(d.camera_settings);
+}
+
+template<class AR> void Visit(AR& ar, FlexBodyWheel& d)
+{
+    Visit(ar, static_cast<BaseWheel2&>(d));
+    ar.Field(d.side);
+    ar.Field(d.rim_springiness);
+    ar.Field(d.rim_damping);
+    ar.Field(d.rim_mesh_name);
+    ar.Field(d.tyre_mesh_name);
+}
+
+template<class AR> void Visit(AR& ar, Fusedrag& d)
+{
+    ar.Field(d.autocalc);
+    ar.Field(d.front_node);
+    ar.Field(d.rear_node);
+    ar.Field(d.approximate_width);
+    ar.Field(d.airfoil_name);
+    ar.Field(d.area_coefficient);
+}
+
+template<class AR> void Visit(AR& ar, Globals& d)
+{
+    ar.Field(d.dry_mass);
+    ar.Field(d.cargo_mass);
+    ar.Field(d.material_name);
+}
+
+template<class AR> void Visit(AR& ar, Guid& d)
+{
+    ar.Field(d.guid);
+}
+
+template<class AR> void Visit(AR& ar, GuiSettings& d)
+{
+    ar.Field(d.key);
+    ar.Field(d.value);
+}
+
+template<class AR> void Visit(AR& ar, Help& d)
+{
+    ar.Field(d.material);
+}
+
+template<class AR> void Visit(AR& ar, Hook& d)
+{
+    ar.Field(d.node);
+    ar.Field(d.option_hook_range);
+    ar.Field(d.option_speed_coef);
+    ar.Field(d.option_max_force);
+    ar.Field(d.option_hookgroup);
+    ar.Field(d.option_lockgroup);
+    ar.Field(d.option_timer);
+    ar.Field(d.option_min_range_meters);
+    bool flags[] = { d.flag_self_lock, d.flag_auto_lock, d.flag_no_disable, d.flag_no_rope, d.flag_visible }; // Bit fields
+    ar.Field(flags);
+    d.flag_self_lock = flags[0];
+    d.flag_auto_lock = flags[1];
+    d.flag_no_disable = flags[2];
+    d.flag_no_rope = flags[3];
+    d.flag_visible = flags[4];
+}
+
+template<class AR> void Visit(AR& ar, Hydro& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.lenghtening_factor);
+    ar.Field(d.options);
+    ar.Field(d.inertia);
+    ar.Field(d.inertia_defaults);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, InterAxle& d)
+{
+    ar.Field(d.a1);
+    ar.Field(d.a2);
+    ar.Field(d.options);
+}
+
+template<class AR> void Visit(AR& ar, Lockgroup& d)
+{
+    ar.Field(d.number);
+    ar.Field(d.nodes);
+}
+
+template<class AR> void Visit(AR& ar, ManagedMaterialsOptions& d)
+{
+    ar.Field(d.double_sided);
+}
+
+template<class AR> void Visit(AR& ar, ManagedMaterial& d)
+{
+    ar.Field(d.name);
+    ar.Field(d.type);
+    ar.Field(d.options);
+    ar.Field(d.diffuse_map);
+    ar.Field(d.damaged_diffuse_map);
+    ar.Field(d.specular_map);
+}
+
+template<class AR> void Visit(AR& ar, MaterialFlareBinding& d)
+{
+    ar.Field(d.flare_number);
+    ar.Field(d.material_name);
+}
+
+template<class AR> void Visit(AR& ar, Minimass& d)
+{
+    ar.Field(d.global_min_mass_Kg);
+    ar.Field(d.option);
+}
+
+template<class AR> void Visit(AR& ar, MeshWheel& d)
+{
+    Visit(ar, static_cast<BaseMeshWheel&>(d));
+}
+
+template<class AR> void Visit(AR& ar, MeshWheel2& d)
+{
+    Visit(ar, static_cast<BaseMeshWheel&>(d));
+}
+
+template<class AR> void Visit(AR& ar, NodeDefaults& d)
+{
+    ar.Field(d.load_weight);
+    ar.Field(d.friction);
+    ar.Field(d.volume);
+    ar.Field(d.surface);
+    ar.Field(d.options);
+}
+
+template<class AR> void Visit(AR& ar, Node::Range& d)
+{
+    ar.Field(d.start);
+    ar.Field(d.end);
+}
+
+template<class AR> void Visit(AR& ar, Node& d)
+{
+    ar.Field(d.id);
+    ar.Field(d.position);
+    ar.Field(d.options);
+    ar.Field(d.load_weight_override);
+    ar.Field(d._has_load_weight_override);
+    ar.Field(d.node_defaults);
+    ar.Field(d.default_minimass);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, Particle& d)
+{
+    ar.Field(d.emitter_node);
+    ar.Field(d.reference_node);
+    ar.Field(d.particle_system_name);
+}
+
+template<class AR> void Visit(AR& ar, Pistonprop& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.axis_node);
+    ar.Field(d.blade_tip_nodes);
+    ar.Field(d.couple_node);
+    ar.Field(d.turbine_power_kW);
+    ar.Field(d.pitch);
+    ar.Field(d.airfoil);
+}
+
+template<class AR> void Visit(AR& ar, Prop::DashboardSpecial& d)
+{
+    ar.Field(d.offset);
+    ar.Field(d._offset_is_set);
+    ar.Field(d.rotation_angle);
+    ar.Field(d.mesh_name);
+}
+
+template<class AR> void Visit(AR& ar, Prop::BeaconSpecial& d)
+{
+    ar.Field(d.flare_material_name);
+    ar.Field(d.color);
+}
+
+template<class AR> void Visit(AR& ar, Prop& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.x_axis_node);
+    ar.Field(d.y_axis_node);
+    ar.Field(d.offset);
+    ar.Field(d.rotation);
+    ar.Field(d.mesh_name);
+    ar.Field(d.animations);
+    ar.Field(d.camera_settings);
+    ar.Field(d.special);
+    ar.Field(d.special_prop_beacon);
+    ar.Field(d.special_prop_dashboard);
+}
+
+template<class AR> void Visit(AR& ar, RailGroup& d)
+{
+    ar.Field(d.id);
+    ar.Field(d.node_list);
+}
+
+template<class AR> void Visit(AR& ar, Ropable& d)
+{
+    ar.Field(d.node);
+    ar.Field(d.group);
+    ar.Field(d.has_multilock);
+}
+
+template<class AR> void Visit(AR& ar, Rope& d)
+{
+    ar.Field(d.root_node);
+    ar.Field(d.end_node);
+    ar.Field(d.invisible);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, Rotator& d)
+{
+    ar.Field(d.axis_nodes);
+    ar.Field(d.base_plate_nodes);
+    ar.Field(d.rotating_plate_nodes);
+    ar.Field(d.rate);
+    ar.Field(d.spin_left_key);
+    ar.Field(d.spin_right_key);
+    ar.Field(d.inertia);
+    ar.Field(d.inertia_defaults);
+    ar.Field(d.engine_coupling);
+    ar.Field(d.needs_engine);
+}
+
+template<class AR> void Visit(AR& ar, Rotator2& d)
+{
+    Visit(ar, static_cast<Rotator&>(d));
+    ar.Field(d.rotating_force);
+    ar.Field(d.tolerance);
+    ar.Field(d.description);
+}
+
+template<class AR> void Visit(AR& ar, Screwprop& d)
+{
+    ar.Field(d.prop_node);
+    ar.Field(d.back_node);
+    ar.Field(d.top_node);
+    ar.Field(d.power);
+}
+
+template<class AR> void Visit(AR& ar, Script& d)
+{
+    ar.Field(d.filename);
+}
+
+template<class AR> void Visit(AR& ar, Shock& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.spring_rate);
+    ar.Field(d.damping);
+    ar.Field(d.short_bound);
+    ar.Field(d.long_bound);
+    ar.Field(d.precompression);
+    ar.Field(d.options);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, Shock2& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.spring_in);
+    ar.Field(d.damp_in);
+    ar.Field(d.progress_factor_spring_in);
+    ar.Field(d.progress_factor_damp_in);
+    ar.Field(d.spring_out);
+    ar.Field(d.damp_out);
+    ar.Field(d.progress_factor_spring_out);
+    ar.Field(d.progress_factor_damp_out);
+    ar.Field(d.short_bound);
+    ar.Field(d.long_bound);
+    ar.Field(d.precompression);
+    ar.Field(d.options);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, Shock3& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.spring_in);
+    ar.Field(d.damp_in);
+    ar.Field(d.spring_out);
+    ar.Field(d.damp_out);
+    ar.Field(d.damp_in_slow);
+    ar.Field(d.split_vel_in);
+    ar.Field(d.damp_in_fast);
+    ar.Field(d.damp_out_slow);
+    ar.Field(d.split_vel_out);
+    ar.Field(d.damp_out_fast);
+    ar.Field(d.short_bound);
+    ar.Field(d.long_bound);
+    ar.Field(d.precompression);
+    ar.Field(d.options);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, SkeletonSettings& d)
+{
+    ar.Field(d.visibility_range_meters);
+    ar.Field(d.beam_thickness_meters);
+}
+
+template<class AR> void Visit(AR& ar, SlideNode& d)
+{
+    ar.Field(d.slide_node);
+    ar.Field(d.rail_node_ranges);
+    ar.Field(d.constraint_flags);
+    ar.Field(d.spring_rate);
+    ar.Field(d._spring_rate_set);
+    ar.Field(d.break_force);
+    ar.Field(d._break_force_set);
+    ar.Field(d.tolerance);
+    ar.Field(d._tolerance_set);
+    ar.Field(d.attachment_rate);
+    ar.Field(d._attachment_rate_set);
+    ar.Field(d.railgroup_id);
+    ar.Field(d._railgroup_id_set);
+    ar.Field(d.max_attach_dist);
+    ar.Field(d._max_attach_dist_set);
+}
+
+template<class AR> void Visit(AR& ar, SoundSource& d)
+{
+    ar.Field(d.node);
+    ar.Field(d.sound_script_name);
+}
+
+template<class AR> void Visit(AR& ar, SoundSource2& d)
+{
+    Visit(ar, static_cast<SoundSource&>(d));
+    ar.Field(d.mode);
+}
+
+template<class AR> void Visit(AR& ar, SpeedLimiter& d)
+{
+    ar.Field(d.max_speed);
+    ar.Field(d.is_enabled);
+}
+
+template<class AR> void Visit(AR& ar, Submesh& d)
+{
+    ar.Field(d.backmesh);
+    ar.Field(d.texcoords);
+    ar.Field(d.cab_triangles);
+}
+
+template<class AR> void Visit(AR& ar, Texcoord& d)
+{
+    ar.Field(d.node);
+    ar.Field(d.u);
+    ar.Field(d.v);
+}
+
+template<class AR> void Visit(AR& ar, Tie& d)
+{
+    ar.Field(d.root_node);
+    ar.Field(d.max_reach_length);
+    ar.Field(d.auto_shorten_rate);
+    ar.Field(d.min_length);
+    ar.Field(d.max_length);
+    ar.Field(d.options);
+    ar.Field(d.max_stress);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+    ar.Field(d.group);
+}
+
+template<class AR> void Visit(AR& ar, TorqueCurve::Sample& d)
+{
+    ar.Field(d.power);
+    ar.Field(d.torque_percent);
+}
+
+template<class AR> void Visit(AR& ar, TorqueCurve& d)
+{
+    ar.Field(d.samples);
+    ar.Field(d.predefined_func_name);
+}
+
+template<class AR> void Visit(AR& ar, TractionControl& d)
+{
+    ar.Field(d.regulation_force);
+    ar.Field(d.wheel_slip);
+    ar.Field(d.fade_speed);
+    ar.Field(d.pulse_per_sec);
+    ar.Field(d.attr_is_on);
+    ar.Field(d.attr_no_dashboard);
+    ar.Field(d.attr_no_toggle);
+}
+
+template<class AR> void Visit(AR& ar, TransferCase& d)
+{
+    ar.Field(d.a1);
+    ar.Field(d.a2);
+    ar.Field(d.has_2wd);
+    ar.Field(d.has_2wd_lo);
+    ar.Field(d.gear_ratios);
+}
+
+template<class AR> void Visit(AR& ar, Trigger& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.contraction_trigger_limit);
+    ar.Field(d.expansion_trigger_limit);
+    ar.Field(d.options);
+    ar.Field(d.boundary_timer);
+    ar.Field(d.beam_defaults);
+    ar.Field(d.detacher_group);
+    ar.Field(d.shortbound_trigger_action);
+    ar.Field(d.longbound_trigger_action);
+}
+
+template<class AR> void Visit(AR& ar, Turbojet& d)
+{
+    ar.Field(d.front_node);
+    ar.Field(d.back_node);
+    ar.Field(d.side_node);
+    ar.Field(d.is_reversable);
+    ar.Field(d.dry_thrust);
+    ar.Field(d.wet_thrust);
+    ar.Field(d.front_diameter);
+    ar.Field(d.back_diameter);
+    ar.Field(d.nozzle_length);
+}
+
+template<class AR> void Visit(AR& ar, Turboprop2& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.axis_node);
+    ar.Field(d.blade_tip_nodes);
+    ar.Field(d.turbine_power_kW);
+    ar.Field(d.airfoil);
+    ar.Field(d.couple_node);
+}
+
+template<class AR> void Visit(AR& ar, VideoCamera& d)
+{
+    ar.Field(d.reference_node);
+    ar.Field(d.left_node);
+    ar.Field(d.bottom_node);
+    ar.Field(d.alt_reference_node);
+    ar.Field(d.alt_orientation_node);
+    ar.Field(d.offset);
+    ar.Field(d.rotation);
+    ar.Field(d.field_of_view);
+    ar.Field(d.texture_width);
+    ar.Field(d.texture_height);
+    ar.Field(d.min_clip_distance);
+    ar.Field(d.max_clip_distance);
+    ar.Field(d.camera_role);
+    ar.Field(d.camera_mode);
+    ar.Field(d.material_name);
+    ar.Field(d.camera_name);
+}
+
+template<class AR> void Visit(AR& ar, Wheel& d)
+{
+    Visit(ar, static_cast<BaseWheel&>(d));
+    ar.Field(d.radius);
+    ar.Field(d.springiness);
+    ar.Field(d.damping);
+    ar.Field(d.face_material_name);
+    ar.Field(d.band_material_name);
+}
+
+template<class AR> void Visit(AR& ar, Wheel2& d)
+{
+    Visit(ar, static_cast<BaseWheel2&>(d));
+    ar.Field(d.rim_springiness);
+    ar.Field(d.rim_damping);
+    ar.Field(d.face_material_name);
+    ar.Field(d.band_material_name);
+}
+
+template<class AR> void Visit(AR& ar, WheelDetacher& d)
+{
+    ar.Field(d.wheel_id);
+    ar.Field(d.detacher_group);
+}
+
+template<class AR> void Visit(AR& ar, Wing& d)
+{
+    ar.Field(d.nodes);
+    ar.Field(d.tex_coords);
+    ar.Field(d.control_surface);
+    ar.Field(d.chord_point);
+    ar.Field(d.min_deflection);
+    ar.Field(d.max_deflection);
+    ar.Field(d.airfoil);
+    ar.Field(d.efficacy_coef);
+}
+
+template<class AR> void Visit(AR& ar, Document::Module& d)
+{
+    ar.Field(d.name);
+    ar.Field(d.airbrakes);
+    ar.Field(d.animators);
+    ar.Field(d.antilockbrakes);
+    ar.Field(d.author);
+    ar.Field(d.axles);
+    ar.Field(d.beams);
+    ar.Field(d.brakes);
+    ar.Field(d.cameras);
+    ar.Field(d.camerarail);
+    ar.Field(d.collisionboxes);
+    ar.Field(d.cinecam);
+    ar.Field(d.commands2);
+    ar.Field(d.cruisecontrol);
+    ar.Field(d.contacters);
+    ar.Field(d.default_skin);
+    ar.Field(d.description);
+    ar.Field(d.engine);
+    ar.Field(d.engoption);
+    ar.Field(d.engturbo);
+    ar.Field(d.exhausts);
+    ar.Field(d.extcamera);
+    ar.Field(d.fileformatversion);
+    ar.Field(d.fixes);
+    ar.Field(d.fileinfo);
+    ar.Field(d.flares2);
+    ar.Field(d.flares3);
+    ar.Field(d.flexbodies);
+    ar.Field(d.flexbodywheels);
+    ar.Field(d.fusedrag);
+    ar.Field(d.globals);
+    ar.Field(d.guid);
+    ar.Field(d.guisettings);
+    ar.Field(d.help);
+    ar.Field(d.hooks);
+    ar.Field(d.hydros);
+    ar.Field(d.interaxles);
+    ar.Field(d.lockgroups);
+    ar.Field(d.managedmaterials);
+    ar.Field(d.materialflarebindings);
+    ar.Field(d.meshwheels);
+    ar.Field(d.meshwheels2);
+    ar.Field(d.minimass);
+    ar.Field(d.nodes);
+    ar.Field(d.particles);
+    ar.Field(d.pistonprops);
+    ar.Field(d.props);
+    ar.Field(d.railgroups);
+    ar.Field(d.ropables);
+    ar.Field(d.ropes);
+    ar.Field(d.rotators);
+    ar.Field(d.rotators2);
+    ar.Field(d.screwprops);
+    ar.Field(d.scripts);
+    ar.Field(d.shocks);
+    ar.Field(d.shocks2);
+    ar.Field(d.shocks3);
+    ar.Field(d.set_collision_range);
+    ar.Field(d.set_skeleton_settings);
+    ar.Field(d.slidenodes);
+    ar.Field(d.soundsources);
+    ar.Field(d.soundsources2);
+    ar.Field(d.speedlimiter);
+    ar.Field(d.submesh_groundmodel);
+    ar.Field(d.submeshes);
+    ar.Field(d.ties);
+    ar.Field(d.torquecurve);
+    ar.Field(d.tractioncontrol);
+    ar.Field(d.transfercase);
+    ar.Field(d.triggers);
+    ar.Field(d.turbojets);
+    ar.Field(d.turboprops2);
+    ar.Field(d.videocameras);
+    ar.Field(d.wheeldetachers);
+    ar.Field(d.wheels);
+    ar.Field(d.wheels2);
+    ar.Field(d.wings);
+}
+
+template<class AR> void Visit(AR& ar, Document& d)
+{
+    ar.Field(d.hide_in_chooser);
+    ar.Field(d.enable_advanced_deformation);
+    ar.Field(d.slide_nodes_connect_instantly);
+    ar.Field(d.rollon);
+    ar.Field(d.forward_commands);
+    ar.Field(d.import_commands);
+    ar.Field(d.lockgroup_default_nolock);
+    ar.Field(d.rescuer);
+    ar.Field(d.disable_default_sounds);
+    ar.Field(d.implicit_solver);
+    ar.Field(d.name);
+    ar.Field(d.hash);
+    ar.Field(d.root_module);
+    ar.Field(d.user_modules);
+}
+
+// --------------------------------------------------------------------------
+// Public interface
+// --------------------------------------------------------------------------
+
+/// Changes whenever a struct in RigDef_File.h gains or loses a member, in case `BINARY_FORMAT_VERSION` wasn't bumped.
+static uint32_t GetLayoutFingerprint()
+{
+    const size_t sizes[] =
+    {
+        sizeof(AeroAnimator),
+        sizeof(BaseWheel),
+        sizeof(BaseMeshWheel),
+        sizeof(BaseWheel2),
+        sizeof(Inertia),
+        sizeof(Airbrake),
+        sizeof(Animation::MotorSource),
+        sizeof(Animation),
+        sizeof(Animator),
+        sizeof(AntiLockBrakes),
+        sizeof(Author),
+        sizeof(Axle),
+        sizeof(Beam),
+        sizeof(BeamDefaultsScale),
+        sizeof(BeamDefaults),
+        sizeof(Brakes),
+        sizeof(Cab),
+        sizeof(Camera),
+        sizeof(CameraRail),
+        sizeof(CameraSettings),
+        sizeof(Cinecam),
+        sizeof(CollisionBox),
+        sizeof(CollisionRange),
+        sizeof(Command2),
+        sizeof(CruiseControl),
+        sizeof(DefaultMinimass),
+        sizeof(DefaultSkin),
+        sizeof(Engine),
+        sizeof(Engoption),
+        sizeof(Engturbo),
+        sizeof(Exhaust),
+        sizeof(ExtCamera),
+        sizeof(FileFormatVersion),
+        sizeof(Fileinfo),
+        sizeof(Flare2),
+        sizeof(Flare3),
+        sizeof(Flexbody),
+        sizeof(FlexBodyWheel),
+        sizeof(Fusedrag),
+        sizeof(Globals),
+        sizeof(Guid),
+        sizeof(GuiSettings),
+        sizeof(Help),
+        sizeof(Hook),
+        sizeof(Hydro),
+        sizeof(InterAxle),
+        sizeof(Lockgroup),
+        sizeof(ManagedMaterialsOptions),
+        sizeof(ManagedMaterial),
+        sizeof(MaterialFlareBinding),
+        sizeof(Minimass),
+        sizeof(MeshWheel),
+        sizeof(MeshWheel2),
+        sizeof(NodeDefaults),
+        sizeof(Particle),
+        sizeof(Pistonprop),
+        sizeof(Prop::DashboardSpecial),
+        sizeof(Prop::BeaconSpecial),
+        sizeof(Prop),
+        sizeof(RailGroup),
+        sizeof(Ropable),
+        sizeof(Rope),
+        sizeof(Rotator),
+        sizeof(Rotator2),
+        sizeof(Screwprop),
+        sizeof(Script),
+        sizeof(Shock),
+        sizeof(Shock2),
+        sizeof(Shock3),
+        sizeof(SkeletonSettings),
+        sizeof(SlideNode),
+        sizeof(SoundSource),
+        sizeof(SoundSource2),
+        sizeof(SpeedLimiter),
+        sizeof(Submesh),
+        sizeof(Texcoord),
+        sizeof(Tie),
+        sizeof(TorqueCurve::Sample),
+        sizeof(TorqueCurve),
+        sizeof(TractionControl),
+        sizeof(TransferCase),
+        sizeof(Trigger),
+        sizeof(Turbojet),
+        sizeof(Turboprop2),
+        sizeof(VideoCamera),
+        sizeof(Wheel),
+        sizeof(Wheel2),
+        sizeof(WheelDetacher),
+        sizeof(Wing),
+        sizeof(Document::Module),
+        sizeof(Node),
+        sizeof(Node::Ref),
+        sizeof(Node::Id)
+    };
+
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (size_t size: sizes)
+    {
+        hash = (hash ^ static_cast<uint32_t>(size)) * 16777619u;
+    }
+    return hash;
+}
+
+/// The version string includes the git hash, the build time covers builds from a modified tree.
+static uint32_t GetBuildFingerprint()
+{
+    const char* const parts[] = { ROR_VERSION_STRING, ROR_BUILD_DATE, ROR_BUILD_TIME };
+
+    uint32_t hash = 2166136261u; // FNV-1a
+    for (const char* part: parts)
+    {
+        for (const char* c = part; *c != '\0'; ++c)
+        {
+            hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+        }
+        hash = (hash ^ 0u) * 16777619u; // Separator
+    }
+    return hash;
+}
+
+std::string SerializeBinary(DocumentPtr doc)
+{
+    BinaryHeader header = {};
+    std::memcpy(header.signature, BINARY_SIGNATURE, sizeof(BINARY_SIGNATURE));
+    header.format_version = BINARY_FORMAT_VERSION;
+    header.layout_fingerprint = GetLayoutFingerprint();
+    header.build_fingerprint = GetBuildFingerprint();
+
+    BinaryWriter writer;
+    writer.Raw(&header, sizeof(header));
+    Visit(writer, *doc);
+    return writer.GetBuffer();
+}
+
+DocumentPtr DeserializeBinary(const char* data, size_t size)
+{
+    BinaryHeader header;
+    if (size < sizeof(header))
+    {
+        return nullptr;
+    }
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.signature, BINARY_SIGNATURE, sizeof(BINARY_SIGNATURE)) != 0 ||
+        header.format_version != BINARY_FORMAT_VERSION ||
+        header.layout_fingerprint != GetLayoutFingerprint() ||
+        header.build_fingerprint != GetBuildFingerprint())
+    {
+        return nullptr;
+    }
+
+    DocumentPtr doc = std::make_shared<Document>();
+    BinaryReader reader(data + sizeof(header), size - sizeof(header));
+    Visit(reader, *doc);
+    return (reader.IsOk()) ? doc : nullptr;
+}
+
+} // namespace RigDef
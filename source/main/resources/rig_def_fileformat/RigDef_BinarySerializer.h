@@ -0,0 +1,41 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Compact binary form of RigDef::Document, for the parsed actor definition cache.
+
+#pragma once
+
+#include "RigDef_Prerequisites.h"
+
+#include <string>
+
+namespace RigDef
+{
+
+/// The format is native (byte order, struct layout, enum values) and only meant to be read back
+/// by the same build of the game, see `CacheSystem::LoadCachedActorDef()`.
+std::string   SerializeBinary(DocumentPtr doc);
+
+/// @return nullptr if the data are damaged or were written by a different version.
+DocumentPtr   DeserializeBinary(const char* data, size_t size);
+
+} // namespace RigDef
@@ -226,6 +226,7 @@ const char * KeywordToString(Keyword keyword)
         case Keyword::HOOKGROUP:            return "hookgroup";
         case Keyword::HOOKS:                return "hooks";
         case Keyword::HYDROS:               return "hydros";
+        case Keyword::IMPLICITSOLVER:       return "implicitsolver";
         case Keyword::IMPORTCOMMANDS:       return "importcommands";
         case Keyword::INTERAXLES:           return "interaxles";
         case Keyword::LOCKGROUPS:           return "lockgroups";
@@ -304,6 +305,7 @@ Document::Document():
     lockgroup_default_nolock(false),
     rescuer(false),
     disable_default_sounds(false),
+    implicit_solver(false),
     slide_nodes_connect_instantly(false)
 {
     root_module = std::make_shared<Document::Module>(ROOT_MODULE_NAME); // Required to exist.
@@ -61,7 +61,7 @@ extern const char* ROOT_MODULE_NAME;
 // --------------------------------
 // Enums which only carry value
 
-// IMPORTANT! If you add a value here, you must also modify Regexes::IDENTIFY_KEYWORD, it relies on numeric values of this enum.
+// IMPORTANT! If you add a value here, you must also add it to `KEYWORD_DEFS` in RigDef_Parser.cpp.
 enum class Keyword
 {
     INVALID = 0,
@@ -120,6 +120,7 @@ enum class Keyword
     HOOKGROUP, // obsolete, ignored
     HOOKS,
     HYDROS,
+    IMPLICITSOLVER,
     IMPORTCOMMANDS,
     INTERAXLES,
     LOCKGROUPS,
@@ -1563,6 +1564,7 @@ struct Document
     bool lockgroup_default_nolock;
     bool rescuer;
     bool disable_default_sounds;
+    bool implicit_solver;
     Ogre::String name;
 
     // File hash
@@ -31,7 +31,6 @@
 #include "CacheSystem.h"
 #include "Console.h"
 #include "RigDef_File.h"
-#include "RigDef_Regexes.h"
 #include "Utils.h"
 
 #include <OgreException.h>
@@ -40,6 +39,9 @@
 #include <OgreStringConverter.h>
 
 #include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <unordered_map>
 
 using namespace RoR;
 
@@ -66,6 +68,263 @@ inline bool StrEqualsNocase(std::string const & s1, std::string const & s2)
     return true;
 }
 
+// --------------------------------------------------------------------------
+// Keyword identification
+// --------------------------------------------------------------------------
+
+enum class KeywordSyntax
+{
+    BLOCK,  //!< Keyword alone on the line (trailing blanks allowed)
+    INLINE, //!< Keyword followed by separator(s) and arguments
+    PREFIX  //!< Anything starting with the keyword; hack for `forset` which doesn't require a separator from args, see BEWARE OF QUIRKS in `ParseDirectiveForset()`
+};
+
+struct KeywordDef
+{
+    Keyword       keyword;
+    const char*   name;
+    KeywordSyntax syntax;
+};
+
+static const KeywordDef KEYWORD_DEFS[] =
+{
+    { Keyword::ADD_ANIMATION,                "add_animation",                KeywordSyntax::INLINE },
+    { Keyword::AIRBRAKES,                    "airbrakes",                    KeywordSyntax::BLOCK },
+    { Keyword::ANIMATORS,                    "animators",                    KeywordSyntax::BLOCK },
+    { Keyword::ANTILOCKBRAKES,               "AntiLockBrakes",               KeywordSyntax::INLINE },
+    { Keyword::AUTHOR,                       "author",                       KeywordSyntax::INLINE },
+    { Keyword::AXLES,                        "axles",                        KeywordSyntax::BLOCK },
+    { Keyword::BACKMESH,                     "backmesh",                     KeywordSyntax::BLOCK },
+    { Keyword::BEAMS,                        "beams",                        KeywordSyntax::BLOCK },
+    { Keyword::BRAKES,                       "brakes",                       KeywordSyntax::BLOCK },
+    { Keyword::CAB,                          "cab",                          KeywordSyntax::BLOCK },
+    { Keyword::CAMERARAIL,                   "camerarail",                   KeywordSyntax::BLOCK },
+    { Keyword::CAMERAS,                      "cameras",                      KeywordSyntax::BLOCK },
+    { Keyword::CINECAM,                      "cinecam",                      KeywordSyntax::BLOCK },
+    { Keyword::COLLISIONBOXES,               "collisionboxes",               KeywordSyntax::BLOCK },
+    { Keyword::COMMANDS,                     "commands",                     KeywordSyntax::BLOCK },
+    { Keyword::COMMANDS2,                    "commands2",                    KeywordSyntax::BLOCK },
+    { Keyword::COMMENT,                      "comment",                      KeywordSyntax::BLOCK },
+    { Keyword::CONTACTERS,                   "contacters",                   KeywordSyntax::BLOCK },
+    { Keyword::CRUISECONTROL,                "cruisecontrol",                KeywordSyntax::INLINE },
+    { Keyword::DEFAULT_SKIN,                 "default_skin",                 KeywordSyntax::INLINE },
+    { Keyword::DESCRIPTION,                  "description",                  KeywordSyntax::BLOCK },
+    { Keyword::DETACHER_GROUP,               "detacher_group",               KeywordSyntax::INLINE },
+    { Keyword::DISABLEDEFAULTSOUNDS,         "disabledefaultsounds",         KeywordSyntax::BLOCK },
+    { Keyword::ENABLE_ADVANCED_DEFORMATION,  "enable_advanced_deformation",  KeywordSyntax::BLOCK },
+    { Keyword::END,                          "end",                          KeywordSyntax::BLOCK },
+    { Keyword::END_COMMENT,                  "end_comment",                  KeywordSyntax::BLOCK },
+    { Keyword::END_DESCRIPTION,              "end_description",              KeywordSyntax::BLOCK },
+    { Keyword::END_SECTION,                  "end_section",                  KeywordSyntax::BLOCK },
+    { Keyword::ENGINE,                       "engine",                       KeywordSyntax::BLOCK },
+    { Keyword::ENGOPTION,                    "engoption",                    KeywordSyntax::BLOCK },
+    { Keyword::ENGTURBO,                     "engturbo",                     KeywordSyntax::BLOCK },
+    { Keyword::ENVMAP,                       "envmap",                       KeywordSyntax::BLOCK },
+    { Keyword::EXHAUSTS,                     "exhausts",                     KeywordSyntax::BLOCK },
+    { Keyword::EXTCAMERA,                    "extcamera",                    KeywordSyntax::INLINE },
+    { Keyword::FILEFORMATVERSION,            "fileformatversion",            KeywordSyntax::INLINE },
+    { Keyword::FILEINFO,                     "fileinfo",                     KeywordSyntax::INLINE },
+    { Keyword::FIXES,                        "fixes",                        KeywordSyntax::BLOCK },
+    { Keyword::FLARES,                       "flares",                       KeywordSyntax::BLOCK },
+    { Keyword::FLARES2,                      "flares2",                      KeywordSyntax::BLOCK },
+    { Keyword::FLARES3,                      "flares3",                      KeywordSyntax::BLOCK },
+    { Keyword::FLEXBODIES,                   "flexbodies",                   KeywordSyntax::BLOCK },
+    { Keyword::FLEXBODY_CAMERA_MODE,         "flexbody_camera_mode",         KeywordSyntax::INLINE },
+    { Keyword::FLEXBODYWHEELS,               "flexbodywheels",               KeywordSyntax::BLOCK },
+    { Keyword::FORSET,                       "forset",                       KeywordSyntax::PREFIX },
+    { Keyword::FORWARDCOMMANDS,              "forwardcommands",              KeywordSyntax::BLOCK },
+    { Keyword::FUSEDRAG,                     "fusedrag",                     KeywordSyntax::BLOCK },
+    { Keyword::GLOBALS,                      "globals",                      KeywordSyntax::BLOCK },
+    { Keyword::GUID,                         "guid",                         KeywordSyntax::INLINE },
+    { Keyword::GUISETTINGS,                  "guisettings",                  KeywordSyntax::BLOCK },
+    { Keyword::HELP,                         "help",                         KeywordSyntax::BLOCK },
+    { Keyword::HIDEINCHOOSER,                "hideInChooser",                KeywordSyntax::BLOCK },
+    { Keyword::HOOKGROUP,                    "hookgroup",                    KeywordSyntax::BLOCK },
+    { Keyword::HOOKS,                        "hooks",                        KeywordSyntax::BLOCK },
+    { Keyword::HYDROS,                       "hydros",                       KeywordSyntax::BLOCK },
+    { Keyword::IMPLICITSOLVER,               "implicitsolver",               KeywordSyntax::BLOCK },
+    { Keyword::IMPORTCOMMANDS,               "importcommands",               KeywordSyntax::BLOCK },
+    { Keyword::INTERAXLES,                   "interaxles",                   KeywordSyntax::BLOCK },
+    { Keyword::LOCKGROUPS,                   "lockgroups",                   KeywordSyntax::BLOCK },
+    { Keyword::LOCKGROUP_DEFAULT_NOLOCK,     "lockgroup_default_nolock",     KeywordSyntax::BLOCK },
+    { Keyword::MANAGEDMATERIALS,             "managedmaterials",             KeywordSyntax::BLOCK },
+    { Keyword::MATERIALFLAREBINDINGS,        "materialflarebindings",        KeywordSyntax::BLOCK },
+    { Keyword::MESHWHEELS,                   "meshwheels",                   KeywordSyntax::BLOCK },
+    { Keyword::MESHWHEELS2,                  "meshwheels2",                  KeywordSyntax::BLOCK },
+    { Keyword::MINIMASS,                     "minimass",                     KeywordSyntax::BLOCK },
+    { Keyword::NODECOLLISION,                "nodecollision",                KeywordSyntax::BLOCK },
+    { Keyword::NODES,                        "nodes",                        KeywordSyntax::BLOCK },
+    { Keyword::NODES2,                       "nodes2",                       KeywordSyntax::BLOCK },
+    { Keyword::PARTICLES,                    "particles",                    KeywordSyntax::BLOCK },
+    { Keyword::PISTONPROPS,                  "pistonprops",                  KeywordSyntax::BLOCK },
+    { Keyword::PROP_CAMERA_MODE,             "prop_camera_mode",             KeywordSyntax::INLINE },
+    { Keyword::PROPS,                        "props",                        KeywordSyntax::BLOCK },
+    { Keyword::RAILGROUPS,                   "railgroups",                   KeywordSyntax::BLOCK },
+    { Keyword::RESCUER,                      "rescuer",                      KeywordSyntax::BLOCK },
+    { Keyword::RIGIDIFIERS,                  "rigidifiers",                  KeywordSyntax::BLOCK },
+    { Keyword::ROLLON,                       "rollon",                       KeywordSyntax::BLOCK },
+    { Keyword::ROPABLES,                     "ropables",                     KeywordSyntax::BLOCK },
+    { Keyword::ROPES,                        "ropes",                        KeywordSyntax::BLOCK },
+    { Keyword::ROTATORS,                     "rotators",                     KeywordSyntax::BLOCK },
+    { Keyword::ROTATORS2,                    "rotators2",                    KeywordSyntax::BLOCK },
+    { Keyword::SCREWPROPS,                   "screwprops",                   KeywordSyntax::BLOCK },
+    { Keyword::SCRIPTS,                      "scripts",                      KeywordSyntax::BLOCK },
+    { Keyword::SECTION,                      "section",                      KeywordSyntax::INLINE },
+    { Keyword::SECTIONCONFIG,                "sectionconfig",                KeywordSyntax::INLINE },
+    { Keyword::SET_BEAM_DEFAULTS,            "set_beam_defaults",            KeywordSyntax::INLINE },
+    { Keyword::SET_BEAM_DEFAULTS_SCALE,      "set_beam_defaults_scale",      KeywordSyntax::INLINE },
+    { Keyword::SET_COLLISION_RANGE,          "set_collision_range",          KeywordSyntax::INLINE },
+    { Keyword::SET_DEFAULT_MINIMASS,         "set_default_minimass",         KeywordSyntax::INLINE },
+    { Keyword::SET_INERTIA_DEFAULTS,         "set_inertia_defaults",         KeywordSyntax::INLINE },
+    { Keyword::SET_MANAGEDMATERIALS_OPTIONS, "set_managedmaterials_options", KeywordSyntax::INLINE },
+    { Keyword::SET_NODE_DEFAULTS,            "set_node_defaults",            KeywordSyntax::INLINE },
+    { Keyword::SET_SHADOWS,                  "set_shadows",                  KeywordSyntax::BLOCK },
+    { Keyword::SET_SKELETON_SETTINGS,        "set_skeleton_settings",        KeywordSyntax::INLINE },
+    { Keyword::SHOCKS,                       "shocks",                       KeywordSyntax::BLOCK },
+    { Keyword::SHOCKS2,                      "shocks2",                      KeywordSyntax::BLOCK },
+    { Keyword::SHOCKS3,                      "shocks3",                      KeywordSyntax::BLOCK },
+    { Keyword::SLIDENODE_CONNECT_INSTANTLY,  "slidenode_connect_instantly",  KeywordSyntax::BLOCK },
+    { Keyword::SLIDENODES,                   "slidenodes",                   KeywordSyntax::BLOCK },
+    { Keyword::SLOPE_BRAKE,                  "SlopeBrake",                   KeywordSyntax::INLINE },
+    { Keyword::SOUNDSOURCES,                 "soundsources",                 KeywordSyntax::BLOCK },
+    { Keyword::SOUNDSOURCES2,                "soundsources2",                KeywordSyntax::BLOCK },
+    { Keyword::SPEEDLIMITER,                 "speedlimiter",                 KeywordSyntax::INLINE },
+    { Keyword::SUBMESH,                      "submesh",                      KeywordSyntax::BLOCK },
+    { Keyword::SUBMESH_GROUNDMODEL,          "submesh_groundmodel",          KeywordSyntax::INLINE },
+    { Keyword::TEXCOORDS,                    "texcoords",                    KeywordSyntax::BLOCK },
+    { Keyword::TIES,                         "ties",                         KeywordSyntax::BLOCK },
+    { Keyword::TORQUECURVE,                  "torquecurve",                  KeywordSyntax::BLOCK },
+    { Keyword::TRACTIONCONTROL,              "TractionControl",              KeywordSyntax::INLINE },
+    { Keyword::TRANSFERCASE,                 "transfercase",                 KeywordSyntax::BLOCK },
+    { Keyword::TRIGGERS,                     "triggers",                     KeywordSyntax::BLOCK },
+    { Keyword::TURBOJETS,                    "turbojets",                    KeywordSyntax::BLOCK },
+    { Keyword::TURBOPROPS,                   "turboprops",                   KeywordSyntax::BLOCK },
+    { Keyword::TURBOPROPS2,                  "turboprops2",                  KeywordSyntax::BLOCK },
+    { Keyword::VIDEOCAMERA,                  "videocamera",                  KeywordSyntax::BLOCK },
+    { Keyword::WHEELDETACHERS,               "wheeldetachers",               KeywordSyntax::BLOCK },
+    { Keyword::WHEELS,                       "wheels",                       KeywordSyntax::BLOCK },
+    { Keyword::WHEELS2,                      "wheels2",                      KeywordSyntax::BLOCK },
+    { Keyword::WINGS,                        "wings",                        KeywordSyntax::BLOCK },
+};
+
+/// Lookup tables by exact and lowercase keyword name; built on first use (thread-safe), the parser runs on worker threads.
+struct KeywordLookup
+{
+    KeywordLookup()
+    {
+        for (KeywordDef const& def: KEYWORD_DEFS)
+        {
+            std::string name = def.name;
+            by_name[name] = &def;
+            std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+            by_lowercase_name[name] = &def;
+        }
+    }
+
+    std::unordered_map<std::string, const KeywordDef*> by_name;
+    std::unordered_map<std::string, const KeywordDef*> by_lowercase_name;
+};
+
+static KeywordLookup const& GetKeywordLookup()
+{
+    static const KeywordLookup lookup;
+    return lookup;
+}
+
+/// Checks what follows the keyword name on the line
+static bool CheckKeywordSyntax(KeywordDef const& def, const char* rest)
+{
+    switch (def.syntax)
+    {
+    case KeywordSyntax::BLOCK:
+        while (IsWhitespace(*rest))
+        {
+            ++rest;
+        }
+        return *rest == '\0';
+
+    case KeywordSyntax::INLINE:
+        return IsSeparator(*rest);
+
+    default: // KeywordSyntax::PREFIX
+        return true;
+    }
+}
+
+static bool StartsWithNocase(const char* str, const char* prefix)
+{
+    for (; *prefix != '\0'; ++str, ++prefix)
+    {
+        if (tolower(*str) != tolower(*prefix)) { return false; }
+    }
+    return true;
+}
+
+// --------------------------------------------------------------------------
+// Section-specific tokenizers
+// --------------------------------------------------------------------------
+
+/// One comma-separated property of 'axles'/'interaxles': `w1(node node)` and/or `d(olsv)`, optionally followed by a comment.
+struct AxleProperty
+{
+    int         wheel_number = 0; //!< 1 or 2; 0 if not specified
+    std::string wheel_nodes[2];
+    bool        has_differential = false;
+    std::string differential_modes;
+};
+
+static bool ParseAxleProperty(std::string const& token, AxleProperty& out_prop)
+{
+    const char* c = token.c_str();
+    auto skip_blanks = [&c]()
+    {
+        while (IsWhitespace(*c)) { ++c; }
+    };
+    auto read_node_id = [&c](std::string& out_id) -> bool
+    {
+        const char* start = c;
+        while (isalnum(static_cast<unsigned char>(*c)) || *c == '_' || *c == '-') { ++c; }
+        out_id.assign(start, c);
+        return c != start;
+    };
+
+    skip_blanks();
+    if (c[0] == 'w' && (c[1] == '1' || c[1] == '2') && c[2] == '(')
+    {
+        out_prop.wheel_number = c[1] - '0';
+        c += 3;
+        if (!read_node_id(out_prop.wheel_nodes[0]) || !IsWhitespace(*c)) { return false; }
+        skip_blanks();
+        if (!read_node_id(out_prop.wheel_nodes[1]) || *c != ')') { return false; }
+        ++c;
+        skip_blanks();
+    }
+    if (c[0] == 'd' && c[1] == '(')
+    {
+        c += 2;
+        const char* start = c;
+        while (*c == 'o' || *c == 'l' || *c == 's' || *c == 'v') { ++c; }
+        if (*c != ')') { return false; }
+        out_prop.differential_modes.assign(start, c);
+        out_prop.has_differential = true;
+        ++c;
+        skip_blanks();
+    }
+    return (*c == '\0') || (*c == ';') || (c[0] == '/' && c[1] == '/');
+}
+
+/// Aero animator option with engine number, i.e. `throttle1`; outputs the option name and the 1-based engine number.
+static bool ParseAeroAnimatorOption(std::string const& token, std::string& out_name, unsigned& out_engine_number)
+{
+    if (token.size() < 2 || !isdigit(static_cast<unsigned char>(token.back())))
+    {
+        return false;
+    }
+    out_name = token.substr(0, token.size() - 1);
+    out_engine_number = static_cast<unsigned>(token.back() - '0');
+    return out_name == "throttle" || out_name == "rpm" || out_name == "aerotorq" || out_name == "aeropit" || out_name == "aerostatus";
+}
+
 Parser::Parser()
 {
     // Push defaults 
@@ -109,6 +368,7 @@ void Parser::ProcessCurrentLine()
         case Keyword::ENABLE_ADVANCED_DEFORMATION:
         case Keyword::FORWARDCOMMANDS:
         case Keyword::HIDEINCHOOSER:
+        case Keyword::IMPLICITSOLVER:
         case Keyword::IMPORTCOMMANDS:
         case Keyword::LOCKGROUP_DEFAULT_NOLOCK:
         case Keyword::RESCUER:
@@ -634,6 +894,7 @@ void Parser::ProcessGlobalDirective(Keyword keyword)   // Directives that should
     case Keyword::FORWARDCOMMANDS:           m_definition->forward_commands = true;              return;
     case Keyword::IMPORTCOMMANDS:           m_definition->import_commands = true;              return;
     case Keyword::HIDEINCHOOSER:           m_definition->hide_in_chooser = true;               return;
+    case Keyword::IMPLICITSOLVER:            m_definition->implicit_solver = true;               return;
     case Keyword::LOCKGROUP_DEFAULT_NOLOCK:  m_definition->lockgroup_default_nolock = true;      return;
     case Keyword::RESCUER:                   m_definition->rescuer = true;                       return;
     case Keyword::ROLLON:                    m_definition->rollon = true;                        return;
@@ -1549,23 +1810,22 @@ void Parser::ParseAxles()
     Ogre::StringVector::iterator iter = tokens.begin();
     for ( ; iter != tokens.end(); iter++)
     {
-        std::smatch results;
-        if (! std::regex_search(*iter, results, Regexes::SECTION_AXLES_PROPERTY))
+        AxleProperty prop;
+        if (! ParseAxleProperty(*iter, prop))
         {
             this->LogMessage(Console::CONSOLE_SYSTEM_ERROR, "Invalid property, ignoring whole line...");
             return;
         }
-        // NOTE: Positions in 'results' array match E_CAPTURE*() positions (starting with 1) in the respective regex. 
 
-        if (results[1].matched)
+        if (prop.wheel_number != 0)
         {
-            unsigned int wheel_index = PARSEINT(results[2]) - 1;
-            axle.wheels[wheel_index][0] = _ParseNodeRef(results[3]);
-            axle.wheels[wheel_index][1] = _ParseNodeRef(results[4]);
+            unsigned int wheel_index = prop.wheel_number - 1;
+            axle.wheels[wheel_index][0] = _ParseNodeRef(prop.wheel_nodes[0]);
+            axle.wheels[wheel_index][1] = _ParseNodeRef(prop.wheel_nodes[1]);
         }
-        else if (results[5].matched)
+        else if (prop.has_differential)
         {
-            this->_ParseDifferentialTypes(axle.options, results[6].str());
+            this->_ParseDifferentialTypes(axle.options, prop.differential_modes);
         }
     }
 
@@ -1582,17 +1842,16 @@ void Parser::ParseInterAxles()
     interaxle.a1 = this->ParseArgInt(args[0].c_str()) - 1;
     interaxle.a2 = this->ParseArgInt(args[1].c_str()) - 1;
 
-    std::smatch results;
-    if (! std::regex_search(args[2], results, Regexes::SECTION_AXLES_PROPERTY))
+    AxleProperty prop;
+    if (! ParseAxleProperty(args[2], prop))
     {
         this->LogMessage(Console::CONSOLE_SYSTEM_ERROR, "Invalid property, ignoring whole line...");
         return;
     }
-    // NOTE: Positions in 'results' array match E_CAPTURE*() positions (starting with 1) in the respective regex. 
 
-    if (results[5].matched)
+    if (prop.has_differential)
     {
-        this->_ParseDifferentialTypes(interaxle.options, results[6].str());
+        this->_ParseDifferentialTypes(interaxle.options, prop.differential_modes);
     }
 
     m_current_module->interaxles.push_back(interaxle);
@@ -2549,19 +2808,20 @@ void Parser::ParseAnimator()
     {
         Ogre::String token = *itor;
         Ogre::StringUtil::trim(token);
-        std::smatch results;
+        std::string aero_option;
+        unsigned engine_number = 0;
         bool is_shortlimit = false;
 
         // Numbered keywords 
-        if (std::regex_search(token, results, Regexes::PARSE_ANIMATORS_NUMBERED_KEYWORD))
+        if (ParseAeroAnimatorOption(token, aero_option, engine_number))
         {
-                 if (results[1] == "throttle")   animator.aero_animator.flags |= AeroAnimator::OPTION_THROTTLE;
-            else if (results[1] == "rpm")        animator.aero_animator.flags |= AeroAnimator::OPTION_RPM;
-            else if (results[1] == "aerotorq")   animator.aero_animator.flags |= AeroAnimator::OPTION_TORQUE;
-            else if (results[1] == "aeropit")    animator.aero_animator.flags |= AeroAnimator::OPTION_PITCH;
-            else if (results[1] == "aerostatus") animator.aero_animator.flags |= AeroAnimator::OPTION_STATUS;
+                 if (aero_option == "throttle")   animator.aero_animator.flags |= AeroAnimator::OPTION_THROTTLE;
+            else if (aero_option == "rpm")        animator.aero_animator.flags |= AeroAnimator::OPTION_RPM;
+            else if (aero_option == "aerotorq")   animator.aero_animator.flags |= AeroAnimator::OPTION_TORQUE;
+            else if (aero_option == "aeropit")    animator.aero_animator.flags |= AeroAnimator::OPTION_PITCH;
+            else if (aero_option == "aerostatus") animator.aero_animator.flags |= AeroAnimator::OPTION_STATUS;
 
-            animator.aero_animator.engine_idx = this->ParseArgUint(results[2].str().c_str()) - 1;
+            animator.aero_animator.engine_idx = engine_number - 1;
         }
         else if ((is_shortlimit = (token.compare(0, 10, "shortlimit") == 0)) || (token.compare(0, 9, "longlimit") == 0))
         {
@@ -2652,35 +2912,37 @@ Keyword Parser::IdentifyKeywordInCurrentLine()
         return Keyword::INVALID;
     }
 
+    // Keyword names only consist of letters, digits and underscores
+    size_t name_len = 0;
+    while (isalnum(static_cast<unsigned char>(m_current_line[name_len])) || m_current_line[name_len] == '_')
+    {
+        ++name_len;
+    }
+    std::string name(m_current_line, name_len);
+    const char* rest = m_current_line + name_len;
+    KeywordLookup const& lookup = GetKeywordLookup();
+
     // Search with correct lettercase
-    std::smatch results;
-    std::string line(m_current_line);
-    std::regex_search(line, results, Regexes::IDENTIFY_KEYWORD_RESPECT_CASE); // Always returns true.
-    Keyword keyword = FindKeywordMatch(results);
-    if (keyword != Keyword::INVALID)
+    auto itor = lookup.by_name.find(name);
+    if (itor != lookup.by_name.end() && CheckKeywordSyntax(*itor->second, rest))
     {
-        return keyword;
+        return itor->second->keyword;
+    }
+    if (strncmp(m_current_line, "forset", 6) == 0)
+    {
+        return Keyword::FORSET;
     }
 
     // Search and ignore lettercase
-    std::regex_search(line, results, Regexes::IDENTIFY_KEYWORD_IGNORE_CASE); // Always returns true.
-    keyword = FindKeywordMatch(results);
-    return keyword;
-}
-
-Keyword Parser::FindKeywordMatch(std::smatch& search_results)
-{
-    // The 'results' array contains a complete match at positon [0] and sub-matches starting with [1], 
-    //    so we get exact positions in Regexes::IDENTIFY_KEYWORD, which again match Keyword enum members
-
-    for (unsigned int i = 1; i < search_results.size(); i++)
+    std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+    itor = lookup.by_lowercase_name.find(name);
+    if (itor != lookup.by_lowercase_name.end() && CheckKeywordSyntax(*itor->second, rest))
     {
-        std::ssub_match sub  = search_results[i];
-        if (sub.matched)
-        {
-            // Build enum value directly from result offset
-            return Keyword(i);
-        }
+        return itor->second->keyword;
+    }
+    if (StartsWithNocase(m_current_line, "forset"))
+    {
+        return Keyword::FORSET;
     }
     return Keyword::INVALID;
 }
@@ -33,7 +33,6 @@
 
 #include <memory>
 #include <string>
-#include <regex>
 
 namespace RigDef
 {
@@ -233,9 +232,6 @@ private:
     unsigned           ParseArgUint       (const std::string& s);
     float              ParseArgFloat      (const std::string& s);
 
-    /// Keyword scan utility function. 
-    Keyword FindKeywordMatch(std::smatch& search_results);
-
     /// Adds a message to console
     void LogMessage(RoR::Console::MessageType type, std::string const& msg);
 
@@ -52,8 +52,9 @@ Serializer::~Serializer()
 
 void Serializer::Serialize()
 {
-    // Open file
-    m_stream.open(m_file_path);
+    // Reset the output
+    m_stream.str("");
+    m_stream.clear();
     m_stream.precision(m_float_precision); // Permanent
 
     // Write header
@@ -154,7 +155,10 @@ void Serializer::Serialize()
     
     // Finalize
     m_stream << "end" << endl;
-    m_stream.close();
+
+    // Write file - one big write instead of a flush per line (`endl` above)
+    std::ofstream file(m_file_path);
+    file << m_stream.rdbuf();
 }
 
 void Serializer::ProcessPistonprops(Document::Module* module)
@@ -2534,6 +2538,10 @@ void Serializer::WriteFlags()
     {
         m_stream << "rescuer" << endl << endl;
     }
+    if (m_rig_def->implicit_solver)
+    {
+        m_stream << "implicitsolver" << endl << endl;
+    }
     if (m_rig_def->disable_default_sounds)
     {
         m_stream << "disabledefaultsounds" << endl << endl;
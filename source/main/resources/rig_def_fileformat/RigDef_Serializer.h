@@ -27,6 +27,8 @@
 
 #include "RigDef_File.h"
 
+#include <sstream>
+
 namespace RigDef
 {
 
@@ -157,7 +159,7 @@ protected:
 
     void ExportBaseMeshWheel(BaseMeshWheel& def);
 
-    std::ofstream                     m_stream;
+    std::ostringstream                m_stream; //!< The whole file is formatted in memory, then written at once
     Ogre::String                      m_file_path;
     RigDef::DocumentPtr   m_rig_def;
     int                               m_float_precision;
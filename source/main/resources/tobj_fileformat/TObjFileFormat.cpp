@@ -401,3 +401,125 @@ void TObjParser::FlushProceduralObject()
     m_cur_procedural_obj_start_line = -1;
     m_road2_num_blocks = 0;
 }
+
+// --------------------------------
+// Binary cache
+
+// Cache file: signature, version, grid, then each section as a count followed by the raw
+// structs (all fixed-size, strings are char arrays); procedural roads are written point by point.
+
+static const char*    TOBJ_CACHE_SIGNATURE = "RoR TObj";
+static const uint32_t TOBJ_CACHE_VERSION   = 1;
+static const uint32_t TOBJ_CACHE_MAX_COUNT = 10000000; // Sanity limit against damaged files
+
+template <typename T> static bool ReadTObjCacheValue(FILE* f, T& value) { return fread(&value, sizeof(T), 1, f) == 1; }
+template <typename T> static void WriteTObjCacheValue(FILE* f, T const& value) { fwrite(&value, sizeof(T), 1, f); }
+
+template <typename T> static bool ReadTObjCacheArray(FILE* f, std::vector<T>& vec)
+{
+    uint32_t count = 0;
+    if (!ReadTObjCacheValue(f, count) || count > TOBJ_CACHE_MAX_COUNT)
+        return false;
+    vec.resize(count);
+    return count == 0 || fread(vec.data(), sizeof(T), count, f) == count;
+}
+
+template <typename T> static void WriteTObjCacheArray(FILE* f, std::vector<T> const& vec)
+{
+    WriteTObjCacheValue(f, (uint32_t)vec.size());
+    fwrite(vec.data(), sizeof(T), vec.size(), f);
+}
+
+bool RoR::LoadTObjCache(std::string const& path, TObjFile& out_def)
+{
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr)
+    {
+        return false; // Not created yet
+    }
+
+    char signature[32] = {};
+    uint32_t version = 0, num_proc_objects = 0;
+    bool ok = fread(signature, 1, strlen(TOBJ_CACHE_SIGNATURE), f) == strlen(TOBJ_CACHE_SIGNATURE)
+        && strncmp(signature, TOBJ_CACHE_SIGNATURE, strlen(TOBJ_CACHE_SIGNATURE)) == 0
+        && ReadTObjCacheValue(f, version) && version == TOBJ_CACHE_VERSION
+        && ReadTObjCacheValue(f, out_def.grid_position)
+        && ReadTObjCacheValue(f, out_def.grid_enabled)
+        && ReadTObjCacheArray(f, out_def.trees)
+        && ReadTObjCacheArray(f, out_def.grass)
+        && ReadTObjCacheArray(f, out_def.vehicles)
+        && ReadTObjCacheArray(f, out_def.objects)
+        && ReadTObjCacheValue(f, num_proc_objects) && num_proc_objects <= TOBJ_CACHE_MAX_COUNT;
+
+    for (uint32_t i = 0; ok && i < num_proc_objects; i++)
+    {
+        ProceduralObjectPtr po = new ProceduralObject();
+        uint32_t name_len = 0, num_points = 0;
+        ok = ReadTObjCacheValue(f, name_len) && name_len <= TObj::LINE_BUF_LEN;
+        if (ok)
+        {
+            po->name.resize(name_len);
+            ok = name_len == 0 || fread(&po->name[0], 1, name_len, f) == name_len;
+        }
+        ok = ok && ReadTObjCacheValue(f, po->smoothing_num_splits)
+            && ReadTObjCacheValue(f, num_points) && num_points <= TOBJ_CACHE_MAX_COUNT;
+
+        for (uint32_t j = 0; ok && j < num_points; j++)
+        {
+            ProceduralPointPtr pp = new ProceduralPoint();
+            ok = ReadTObjCacheValue(f, pp->position) && ReadTObjCacheValue(f, pp->rotation)
+                && ReadTObjCacheValue(f, pp->type) && ReadTObjCacheValue(f, pp->width)
+                && ReadTObjCacheValue(f, pp->bwidth) && ReadTObjCacheValue(f, pp->bheight)
+                && ReadTObjCacheValue(f, pp->pillartype);
+            po->points.push_back(pp);
+        }
+        out_def.proc_objects.push_back(po);
+    }
+    fclose(f);
+
+    if (!ok)
+    {
+        LOGSTREAM << "Ignoring damaged or outdated cache '" << path << "'";
+        out_def = TObjFile();
+    }
+    return ok;
+}
+
+void RoR::SaveTObjCache(std::string const& path, TObjFile const& def)
+{
+    FILE* f = fopen(path.c_str(), "wb");
+    if (f == nullptr)
+    {
+        LOGSTREAM << "Cannot write cache '" << path << "'";
+        return;
+    }
+
+    fwrite(TOBJ_CACHE_SIGNATURE, 1, strlen(TOBJ_CACHE_SIGNATURE), f);
+    WriteTObjCacheValue(f, TOBJ_CACHE_VERSION);
+    WriteTObjCacheValue(f, def.grid_position);
+    WriteTObjCacheValue(f, def.grid_enabled);
+    WriteTObjCacheArray(f, def.trees);
+    WriteTObjCacheArray(f, def.grass);
+    WriteTObjCacheArray(f, def.vehicles);
+    WriteTObjCacheArray(f, def.objects);
+
+    WriteTObjCacheValue(f, (uint32_t)def.proc_objects.size());
+    for (ProceduralObjectPtr const& po : def.proc_objects)
+    {
+        WriteTObjCacheValue(f, (uint32_t)po->name.size());
+        fwrite(po->name.data(), 1, po->name.size(), f);
+        WriteTObjCacheValue(f, po->smoothing_num_splits);
+        WriteTObjCacheValue(f, (uint32_t)po->points.size());
+        for (ProceduralPointPtr const& pp : po->points)
+        {
+            WriteTObjCacheValue(f, pp->position);
+            WriteTObjCacheValue(f, pp->rotation);
+            WriteTObjCacheValue(f, pp->type);
+            WriteTObjCacheValue(f, pp->width);
+            WriteTObjCacheValue(f, pp->bwidth);
+            WriteTObjCacheValue(f, pp->bheight);
+            WriteTObjCacheValue(f, pp->pillartype);
+        }
+    }
+    fclose(f);
+}
@@ -167,6 +167,12 @@ struct TObjFile
     std::vector<ProceduralObjectPtr> proc_objects;
 };
 
+// -----------------------------------------------------------------------------
+/// Binary snapshot of a parsed TOBJ file, so repeated terrain loads skip the text parsing.
+/// The path must change whenever the source does, see `TerrainObjectManager::LoadTObjFile()`.
+bool LoadTObjCache(std::string const& path, TObjFile& out_def);
+void SaveTObjCache(std::string const& path, TObjFile const& def);
+
 // -----------------------------------------------------------------------------
 class TObjParser
 {
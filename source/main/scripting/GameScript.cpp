@@ -289,7 +289,7 @@ void GameScript::registerForEvent(int eventValue)
         ScriptUnitId_t unit_id = App::GetScriptEngine()->getCurrentlyExecutingScriptUnit();
         if (unit_id != SCRIPTUNITID_INVALID)
         {
-            App::GetScriptEngine()->getScriptUnit(unit_id).eventMask |= eventValue;
+            App::GetScriptEngine()->setEventMask(unit_id, App::GetScriptEngine()->getScriptUnit(unit_id).eventMask | eventValue);
         }
     }
 }
@@ -301,7 +301,7 @@ void GameScript::unRegisterEvent(int eventValue)
         ScriptUnitId_t unit_id = App::GetScriptEngine()->getCurrentlyExecutingScriptUnit();
         if (unit_id != SCRIPTUNITID_INVALID)
         {
-            App::GetScriptEngine()->getScriptUnit(unit_id).eventMask &= ~eventValue;
+            App::GetScriptEngine()->setEventMask(unit_id, App::GetScriptEngine()->getScriptUnit(unit_id).eventMask & ~eventValue);
         }
     }
 }
@@ -317,7 +317,7 @@ BitMask_t GameScript::getRegisteredEventsMask(ScriptUnitId_t nid)
 void GameScript::setRegisteredEventsMask(ScriptUnitId_t nid, BitMask_t eventMask)
 {
     if (App::GetScriptEngine()->scriptUnitExists(nid))
-        App::GetScriptEngine()->getScriptUnit(nid).eventMask = eventMask;
+        App::GetScriptEngine()->setEventMask(nid, eventMask);
 }
 
 void GameScript::flashMessage(String& txt, float time, float charHeight)
@@ -415,6 +415,17 @@ void GameScript::moveObjectVisuals(const String& instanceName, const Vector3& po
     }
 }
 
+void GameScript::moveObject(const String& instanceName, const Vector3& pos)
+{
+    if (!this->HaveSimTerrain(__FUNCTION__))
+        return;
+
+    if (App::GetGameContext()->GetTerrain()->getObjectManager())
+    {
+        App::GetGameContext()->GetTerrain()->getObjectManager()->MoveObject(instanceName, pos);
+    }
+}
+
 void GameScript::spawnObject(const String& objectName, const String& instanceName, const Vector3& pos, const Vector3& rot, const String& eventhandler, bool uniquifyMaterials)
 {
     if (!this->HaveSimTerrain(__FUNCTION__))
@@ -1022,6 +1033,11 @@ AngelScript::CScriptDictionary* GameScript::getScriptDetails(ScriptUnitId_t nid)
     return dict;
 }
 
+ScriptUnitId_t GameScript::getCurrentScriptUnit()
+{
+    return App::GetScriptEngine()->getCurrentlyExecutingScriptUnit();
+}
+
 VehicleAIPtr GameScript::getCurrentTruckAI()
 {
     VehicleAIPtr result = nullptr;
@@ -1455,6 +1471,7 @@ bool GameScript::pushMessage(MsgType type, AngelScript::CScriptDictionary* dict)
             return false;
         }
         this->GetValueFromDict(log_msg, dict, /*required:*/false, "category", "ScriptCategory", rq->lsr_category);
+        this->GetValueFromDict(log_msg, dict, /*required:*/false, "worker_lane", "bool", rq->lsr_worker_lane);
         if (rq->lsr_category == ScriptCategory::ACTOR)
         {
             int64_t instance_id; // AngelScript's `Dictionary` converts all ints int `int64`
@@ -261,6 +261,11 @@ public:
     */
     AngelScript::CScriptDictionary* getScriptDetails(ScriptUnitId_t nid);
 
+    /**
+    * Returns ScriptUnitID of the script being executed; scripts normally use the global var `thisScript` which is initialized by it.
+    */
+    ScriptUnitId_t getCurrentScriptUnit();
+
     /// @}
 
     /// @name Terrain
@@ -336,6 +341,13 @@ public:
     */
     void moveObjectVisuals(const Ogre::String& instanceName, const Ogre::Vector3& pos);
 
+    /**
+    * This moves an object to a new position, including its collision boxes and triangles
+    * @param instanceName The unique name that you chose when spawning this object
+    * @param pos The position where the object should be moved to
+    */
+    void moveObject(const Ogre::String& instanceName, const Ogre::Vector3& pos);
+
     /**
     * This destroys an object
     * @param instanceName The unique name that you chose when spawning this object
@@ -26,8 +26,45 @@
 #include "ContentManager.h"
 #include "PlatformUtils.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
 using namespace RoR;
 
+static const char*    LOCALSTORAGE_LOG_SIGNATURE = "RoR-ASDB";
+static const uint32_t LOCALSTORAGE_LOG_VERSION = 1;
+static const uint8_t  LOCALSTORAGE_REC_SET = 1;
+static const uint8_t  LOCALSTORAGE_REC_ERASE = 2;
+static const size_t   LOCALSTORAGE_COMPACT_MIN_RECORDS = 64; // Small logs are never worth rewriting
+
+template <typename T> static bool ReadLogValue(FILE* f, T& value) { return fread(&value, sizeof(T), 1, f) == 1; }
+template <typename T> static void WriteLogValue(FILE* f, T const& value) { fwrite(&value, sizeof(T), 1, f); }
+
+static bool ReadLogString(FILE* f, std::string& str)
+{
+    uint32_t len = 0;
+    if (!ReadLogValue(f, len) || len > 0x1000000)
+        return false;
+    str.resize(len);
+    return len == 0 || fread(&str[0], 1, len, f) == len;
+}
+
+static void WriteLogString(FILE* f, std::string const& str)
+{
+    WriteLogValue(f, (uint32_t)str.size());
+    fwrite(str.data(), 1, str.size(), f);
+}
+
+static void WriteLogRecord(FILE* f, uint8_t op, std::string const& section, std::string const& key, std::string const& value)
+{
+    WriteLogValue(f, op);
+    WriteLogString(f, section);
+    WriteLogString(f, key);
+    if (op == LOCALSTORAGE_REC_SET)
+        WriteLogString(f, value);
+}
+
 
 /* class that implements the localStorage interface for the scripts */
 LocalStorage::LocalStorage(std::string fileName_in, const std::string& sectionName_in, const std::string &resource_group = RGN_CACHE)
@@ -42,11 +79,10 @@ LocalStorage::LocalStorage(std::string fileName_in, const std::string& sectionNa
     sectionName = sectionName_in.substr(0, sectionName_in.find(".", 0));
     
     m_filename = fileName_in + ".asdata";
+    m_log_filename = fileName_in + ".asdb";
     m_resource_group = resource_group;
     this->separators = "=";
-    loadDict();
-    
-    saved = true;
+    // The file is loaded on first access, see `loadIfNeeded()`
 }
 
 LocalStorage::~LocalStorage()
@@ -57,7 +93,10 @@ LocalStorage::~LocalStorage()
 
 void LocalStorage::copyFrom(LocalStoragePtr other)
 {
+    this->loadIfNeeded();
     m_filename = other->getFilename();
+    m_log_filename = other->m_log_filename;
+    m_needs_snapshot = true; // We have taken over a different file
     sectionName = other->getSection();
     SettingsBySection::iterator secIt;
     SettingsBySection osettings = other->getSettings();
@@ -89,7 +128,7 @@ void LocalStorage::set(std::string key, const std::string &value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 int LocalStorage::getInt(std::string key)
@@ -104,7 +143,7 @@ void LocalStorage::set(std::string key, const int value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 float LocalStorage::getFloat(std::string key)
@@ -119,7 +158,7 @@ void LocalStorage::set(std::string key, const float value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 bool LocalStorage::getBool(std::string key)
@@ -134,7 +173,7 @@ void LocalStorage::set(std::string key, const bool value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 Ogre::Vector3 LocalStorage::getVector3(std::string key)
@@ -149,7 +188,7 @@ void LocalStorage::set(std::string key, const Ogre::Vector3 &value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 Ogre::Quaternion LocalStorage::getQuaternion(std::string key)
@@ -164,7 +203,7 @@ void LocalStorage::set(std::string key, const Ogre::Quaternion &value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 Ogre::Radian LocalStorage::getRadian(std::string key)
@@ -179,7 +218,7 @@ void LocalStorage::set(std::string key, const Ogre::Radian &value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, value, sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 Ogre::Degree LocalStorage::getDegree(std::string key)
@@ -194,31 +233,45 @@ void LocalStorage::set(std::string key, const Ogre::Degree &value)
     std::string sec;
     parseKey(key, sec);
     setSetting(key, Ogre::Radian(value), sec);
-    saved = false;
+    m_pending.insert(SectionKey(sec, key));
 }
 
 void LocalStorage::saveDict()
 {
-    if (this->saved)
+    if (!m_loaded || (m_pending.empty() && !m_needs_snapshot))
     {
-        return;
+        return; // Nothing was changed
     }
 
-    try
-    {
-        this->saveImprovedCfg(m_filename, RGN_CACHE);
-        this->saved = true;
-    }
-    catch (std::exception& e)
+    // Rewrite the log once overwritten records take up most of it
+    const size_t num_settings = this->countSettings();
+    const bool compact = m_log_records + m_pending.size() > std::max(LOCALSTORAGE_COMPACT_MIN_RECORDS, num_settings * 2);
+    const bool ok = (m_needs_snapshot || compact) ? this->writeLogSnapshot() : this->appendPendingToLog();
+    if (!ok)
     {
         RoR::LogFormat("[RoR|Scripting|LocalStorage]"
-                       "Error saving file '%s' (resource group '%s'), message: '%s'",
-                        m_filename.c_str(), RGN_CACHE, e.what());
+                       "Error saving file '%s' (resource group '%s')",
+                        m_log_filename.c_str(), RGN_CACHE);
+        return;
     }
+    m_pending.clear();
+    m_needs_snapshot = false;
 }
 
 bool LocalStorage::loadDict()
 {
+    m_loaded = true;
+    m_pending.clear();
+    m_log_records = 0;
+    this->clear();
+
+    if (FileExists(PathCombine(App::sys_cache_dir->getStr(), m_log_filename)))
+    {
+        return this->replayLog();
+    }
+
+    // No log yet - read the legacy text file and convert it on first save
+    m_needs_snapshot = true;
     try
     {
         this->loadImprovedCfg(m_filename, RGN_CACHE);
@@ -230,17 +283,141 @@ bool LocalStorage::loadDict()
                         m_filename.c_str(), RGN_CACHE, e.what());
         return false;
     }
-    saved = true;
     return true;
 }
 
+bool LocalStorage::replayLog()
+{
+    const std::string path = PathCombine(App::sys_cache_dir->getStr(), m_log_filename);
+    FILE* f = fopen(path.c_str(), "rb");
+    if (f == nullptr)
+    {
+        m_needs_snapshot = true;
+        return false;
+    }
+
+    char signature[16] = {};
+    uint32_t version = 0;
+    bool ok = fread(signature, 1, strlen(LOCALSTORAGE_LOG_SIGNATURE), f) == strlen(LOCALSTORAGE_LOG_SIGNATURE)
+        && strncmp(signature, LOCALSTORAGE_LOG_SIGNATURE, strlen(LOCALSTORAGE_LOG_SIGNATURE)) == 0
+        && ReadLogValue(f, version) && version == LOCALSTORAGE_LOG_VERSION;
+
+    uint8_t op = 0;
+    while (ok && ReadLogValue(f, op))
+    {
+        std::string section, key, value;
+        ok = (op == LOCALSTORAGE_REC_SET || op == LOCALSTORAGE_REC_ERASE)
+            && ReadLogString(f, section) && ReadLogString(f, key)
+            && (op == LOCALSTORAGE_REC_ERASE || ReadLogString(f, value));
+        if (!ok)
+        {
+            break;
+        }
+
+        if (op == LOCALSTORAGE_REC_SET)
+        {
+            this->setSetting(key, value, section);
+        }
+        else if (mSettingsPtr.find(section) != mSettingsPtr.end())
+        {
+            mSettingsPtr[section]->erase(key);
+        }
+        m_log_records++;
+    }
+    fclose(f);
+
+    // A damaged tail (i.e. the game crashed while saving) loses only the records in it;
+    // the log is rewritten on next save so that new records don't end up behind the damage.
+    m_needs_snapshot = !ok;
+    if (!ok)
+    {
+        RoR::LogFormat("[RoR|Scripting|LocalStorage]"
+                       "File '%s' is damaged, recovered %d records",
+                        m_log_filename.c_str(), (int)m_log_records);
+    }
+    return ok;
+}
+
+bool LocalStorage::appendPendingToLog()
+{
+    const std::string path = PathCombine(App::sys_cache_dir->getStr(), m_log_filename);
+    FILE* f = fopen(path.c_str(), "ab");
+    if (f == nullptr)
+    {
+        return false;
+    }
+
+    for (SectionKey const& sk: m_pending)
+    {
+        SettingsBySection::iterator secIt = mSettingsPtr.find(sk.first);
+        SettingsMultiMap::iterator setIt;
+        if (secIt != mSettingsPtr.end() && (setIt = secIt->second->find(sk.second)) != secIt->second->end())
+            WriteLogRecord(f, LOCALSTORAGE_REC_SET, sk.first, sk.second, setIt->second);
+        else
+            WriteLogRecord(f, LOCALSTORAGE_REC_ERASE, sk.first, sk.second, "");
+        m_log_records++;
+    }
+    const bool ok = ferror(f) == 0;
+    fclose(f);
+    return ok;
+}
+
+bool LocalStorage::writeLogSnapshot()
+{
+    // Write aside and swap, so that a crash can't take the old data with it
+    const std::string path = PathCombine(App::sys_cache_dir->getStr(), m_log_filename);
+    const std::string tmp_path = path + ".tmp";
+    FILE* f = fopen(tmp_path.c_str(), "wb");
+    if (f == nullptr)
+    {
+        return false;
+    }
+
+    fwrite(LOCALSTORAGE_LOG_SIGNATURE, 1, strlen(LOCALSTORAGE_LOG_SIGNATURE), f);
+    WriteLogValue(f, LOCALSTORAGE_LOG_VERSION);
+    size_t num_records = 0;
+    for (SettingsBySection::iterator secIt = mSettingsPtr.begin(); secIt != mSettingsPtr.end(); secIt++)
+    {
+        for (SettingsMultiMap::iterator setIt = secIt->second->begin(); setIt != secIt->second->end(); setIt++)
+        {
+            WriteLogRecord(f, LOCALSTORAGE_REC_SET, secIt->first, setIt->first, setIt->second);
+            num_records++;
+        }
+    }
+    const bool ok = ferror(f) == 0;
+    fclose(f);
+
+    if (!ok)
+    {
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    std::remove(path.c_str()); // `rename()` doesn't overwrite on Windows
+    if (std::rename(tmp_path.c_str(), path.c_str()) != 0)
+    {
+        return false;
+    }
+    m_log_records = num_records;
+    return true;
+}
+
+size_t LocalStorage::countSettings()
+{
+    size_t count = 0;
+    for (SettingsBySection::iterator secIt = mSettingsPtr.begin(); secIt != mSettingsPtr.end(); secIt++)
+    {
+        count += secIt->second->size();
+    }
+    return count;
+}
+
 void LocalStorage::eraseKey(std::string key)
 {
     std::string sec;
     parseKey(key, sec);
     if (mSettingsPtr.find(sec) != mSettingsPtr.end() && mSettingsPtr[sec]->find(key) != mSettingsPtr[sec]->end())
         if (mSettingsPtr[sec]->erase(key) > 0)
-            saved = false;
+            m_pending.insert(SectionKey(sec, key));
 }
 
 void LocalStorage::deleteAll()
@@ -250,6 +427,8 @@ void LocalStorage::deleteAll()
 
 void LocalStorage::parseKey(std::string& key, std::string &section)
 {
+    this->loadIfNeeded();
+
     size_t dot = key.find(".", 0);
     if ( dot != std::string::npos )
     {
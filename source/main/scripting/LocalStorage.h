@@ -26,6 +26,8 @@
 #include "RefCountingObject.h"
 
 #include <angelscript.h>
+#include <set>
+#include <utility>
 
 namespace RoR {
 
@@ -34,6 +36,11 @@ namespace RoR {
 
 /**
  *  @brief A class that allows scripts to store data persistently
+ *
+ *  Data is kept in a binary append-only log '<name>.asdb' in the cache directory:
+ *  the file is only read on first access and saving appends just the keys changed since
+ *  the last save. The log is rewritten as a compact snapshot once it's mostly stale records.
+ *  Legacy text files '<name>.asdata' are read if there's no log yet.
  */
 class LocalStorage : public ImprovedConfigFile, public RefCountingObject<LocalStorage>
 {
@@ -84,15 +91,27 @@ public:
     // parses a key
     void parseKey(std::string& inout_key, std::string& out_section);
 
-    SettingsBySection getSettings() { return mSettingsPtr; }
+    SettingsBySection getSettings() { this->loadIfNeeded(); return mSettingsPtr; }
     std::string getFilename() { return m_filename; }
     std::string getSection() { return sectionName; }
 
 protected:
-    std::string m_filename;
+    typedef std::pair<std::string, std::string> SectionKey;
+
+    void loadIfNeeded() { if (!m_loaded) { this->loadDict(); } }
+    bool replayLog();
+    bool appendPendingToLog();
+    bool writeLogSnapshot();
+    size_t countSettings();
+
+    std::string m_filename;          //!< Legacy text file
+    std::string m_log_filename;
     std::string m_resource_group;
-    bool saved; //!< Inverted 'dirty flag'
     std::string sectionName;
+    bool m_loaded = false;
+    bool m_needs_snapshot = false;   //!< The log is missing or not fit for appending
+    size_t m_log_records = 0;        //!< Records in the log file, including overwritten ones
+    std::set<SectionKey> m_pending;  //!< Keys modified or erased since last save
 };
 
 /// @}   //addtogroup Scripting
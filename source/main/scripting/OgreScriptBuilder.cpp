@@ -76,6 +76,9 @@ int OgreScriptBuilder::LoadScriptSection(const char* full_path_cstr)
 
     const std::string& code = ds->getAsString();
     hash = RoR::Sha1Hash(code);
+    loaded_code += filename;
+    loaded_code += '\n';
+    loaded_code += code;
 
     return ProcessScriptSection(code.c_str(), static_cast<unsigned int>(code.length()), filename.c_str(), 0);
 }
@@ -40,8 +40,10 @@ class OgreScriptBuilder : public AngelScript::CScriptBuilder
 {
 public:
     Ogre::String GetHash() { return hash; };
+    std::string const& GetLoadedCode() { return loaded_code; }; //!< All files loaded so far, including `#include`-d ones; for the bytecode cache.
 protected:
     Ogre::String hash;
+    std::string loaded_code;
     int LoadScriptSection(const char* filename);
 };
 
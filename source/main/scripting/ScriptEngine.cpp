@@ -41,18 +41,23 @@
 #endif //USE_CURL
 
 #include <cfloat>
+#include <cstring>
 
 #include "Application.h"
 #include "Actor.h"
 #include "ActorManager.h"
 #include "Collisions.h"
 #include "Console.h"
+#include "ContentManager.h"
+#include "FrameArena.h"
 #include "GameContext.h"
 #include "GameScript.h"
 #include "LocalStorage.h"
 #include "OgreScriptBuilder.h"
 #include "PlatformUtils.h"
 #include "ScriptEvents.h"
+#include "SimProfiler.h"
+#include "ThreadPool.h"
 #include "Utils.h"
 #include "VehicleAI.h"
 
@@ -95,6 +100,15 @@ ScriptEngine::ScriptEngine() :
 ScriptEngine::~ScriptEngine()
 {
     // Clean up
+    this->syncWorkerLane();
+    for (auto& pair: m_script_units)
+    {
+        if (pair.second.frameStepContext)
+        {
+            pair.second.frameStepContext->Abort();
+            engine->ReturnContext(pair.second.frameStepContext);
+        }
+    }
     if (engine)  engine->Release();
     if (context) context->Release();
 }
@@ -110,7 +124,8 @@ void ScriptEngine::init()
     SLOG("ScriptEngine initializing ...");
     int result;
 
-    // Create the script engine
+    // Create the script engine; worker lane scripts execute on the thread pool - see `ScriptUnit::workerLane`
+    AngelScript::asPrepareMultithread();
     engine = AngelScript::asCreateScriptEngine(ANGELSCRIPT_VERSION);
 
     engine->SetEngineProperty(AngelScript::asEP_ALLOW_UNSAFE_REFERENCES, true); // Needed for ImGui
@@ -140,6 +155,8 @@ void ScriptEngine::init()
     // string type for C++ applications. Every developer is free to register it's own string type.
     // The SDK do however provide a standard add-on for registering a string type, so it's not
     // necessary to register your own string type if you don't want to.
+    // -- Thread-safe API first, available to worker lane scripts; see `ScriptUnit::workerLane`.
+    engine->SetDefaultAccessMask(SCRIPT_ACCESS_MAIN_THREAD | SCRIPT_ACCESS_WORKER_LANE);
     AngelScript::RegisterScriptArray(engine, true);
     AngelScript::RegisterStdString(engine);
     AngelScript::RegisterStdStringUtils(engine);
@@ -154,9 +171,15 @@ void ScriptEngine::init()
     // some useful global functions
     result = engine->RegisterGlobalFunction("void log(const string &in)", AngelScript::asFUNCTION(logString), AngelScript::asCALL_CDECL); ROR_ASSERT( result >= 0 );
     result = engine->RegisterGlobalFunction("void print(const string &in)", AngelScript::asFUNCTION(logString), AngelScript::asCALL_CDECL); ROR_ASSERT( result >= 0 );
+    result = engine->RegisterGlobalFunction("int getCurrentScriptUnit()", AngelScript::asMETHOD(ScriptEngine, getCurrentlyExecutingScriptUnit), AngelScript::asCALL_THISCALL_ASGLOBAL, this); ROR_ASSERT( result >= 0 );
 
     RegisterOgreObjects(engine);   // vector2/3, degree, radian, quaternion, color
     RegisterLocalStorage(engine);  // LocalStorage
+    RegisterMessageQueue(engine);  // enum MsgType
+    result = engine->RegisterGlobalFunction("void queueMessage(MsgType, dictionary@)", AngelScript::asMETHOD(ScriptEngine, queueMessage), AngelScript::asCALL_THISCALL_ASGLOBAL, this); ROR_ASSERT( result >= 0 );
+
+    // -- Everything else works with game state owned by the main thread.
+    engine->SetDefaultAccessMask(SCRIPT_ACCESS_MAIN_THREAD);
     RegisterInputEngine(engine);   // InputEngineClass, inputEvents
     RegisterImGuiBindings(engine); // ImGUi::
     RegisterVehicleAi(engine);     // VehicleAIClass, aiEvents, AiValues
@@ -164,7 +187,6 @@ void ScriptEngine::init()
     RegisterActor(engine);         // BeamClass
     RegisterProceduralRoad(engine);// procedural_point, ProceduralRoadClass, ProceduralObjectClass, ProceduralManagerClass
     RegisterTerrain(engine);       // TerrainClass
-    RegisterMessageQueue(engine);  // enum MsgType
     RegisterSoundScript(engine);   // SoundTriggers, ModulationSource, SoundScriptTemplate...
     RegisterGameScript(engine);    // GameScriptClass
     RegisterScriptEvents(engine);  // scriptEvents
@@ -201,6 +223,17 @@ std::string ptr2str(const char* ptr) { if (ptr) return ptr; else return ""; }
 
 void ScriptEngine::lineCallback(AngelScript::asIScriptContext* ctx)
 {
+    // Checking the clock on every statement would cost more than the statements; budgets are in milliseconds anyway.
+    if (m_line_callback_deadline_us >= 0
+        && (++m_line_callback_counter % 64) == 0
+        && SimProfiler::GetTimestampUs() > m_line_callback_deadline_us)
+    {
+        ctx->Suspend();
+    }
+
+    if (!m_line_callback_events)
+        return;
+
     std::string funcName, funcObjTypeName, objName;
     if (ctx->GetFunction())
     {
@@ -261,22 +294,33 @@ void ScriptEngine::forwardExceptionAsScriptEvent(const std::string& from)
     catch (...) { TRIGGER_EVENT_ASYNC(SE_GENERIC_EXCEPTION_CAUGHT, m_currently_executing_script_unit,0,0,0, from); }
 }
 
-int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid)
+int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid, AngelScript::asIScriptContext* ctx /*= nullptr*/, int64_t deadline_us /*= -1*/)
 {
     // Helper for executing any script function/snippet;
-    // * sets LineCallback (on demand - when script registers for SE_ANGELSCRIPT_LINECALLBACK event)
+    // * sets LineCallback (on demand - when script registers for SE_ANGELSCRIPT_LINECALLBACK event or a deadline is given)
     // * sets ExceptionCallback (on demand - when script registers for SE_ANGELSCRIPT_EXCEPTIONCALLBACK event)
     // * sets currently executed NID;
+    // * measures the time spent, see `ScriptUnit::frameTimeMs`;
     // IMPORTANT: The `asIScriptContext::Prepare()` must be already done (this enables programmer to set args).
     // IMPORTANT: `m_currently_executing_event_trigger` must be set externally!
     // =========================================================================================================
 
+    if (!ctx)
+    {
+        ctx = context;
+    }
+
     // Automatically attach the LineCallback if the script registered for the event.
     // (except if we're about to run that callback - that would trap us in loop)
-    if (m_currently_executing_event_trigger != SE_ANGELSCRIPT_LINECALLBACK
-        && m_script_units[nid].eventMask & SE_ANGELSCRIPT_LINECALLBACK)
+    // Executions may nest (script -> application -> script), so the callback's state is saved.
+    const int64_t prev_deadline_us = m_line_callback_deadline_us;
+    const bool prev_events = m_line_callback_events;
+    m_line_callback_deadline_us = deadline_us;
+    m_line_callback_events = m_currently_executing_event_trigger != SE_ANGELSCRIPT_LINECALLBACK
+        && m_script_units[nid].eventMask & SE_ANGELSCRIPT_LINECALLBACK;
+    if (m_line_callback_events || deadline_us >= 0)
     {
-        int result = context->SetLineCallback(asMETHOD(ScriptEngine, lineCallback), this, asCALL_THISCALL);
+        int result = ctx->SetLineCallback(asMETHOD(ScriptEngine, lineCallback), this, asCALL_THISCALL);
         if (result < 0)
         {
             SLOG(fmt::format("Warning: Could not attach LineCallback to NID {}, error code {}; continuing without it...", result, nid));
@@ -286,7 +330,7 @@ int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid)
     // Attach the ExceptionCallback if the script registered for the event.
     if (m_script_units[nid].eventMask & SE_ANGELSCRIPT_EXCEPTIONCALLBACK)
     {
-        int result = context->SetExceptionCallback(asMETHOD(ScriptEngine, exceptionCallback), this, asCALL_THISCALL);
+        int result = ctx->SetExceptionCallback(asMETHOD(ScriptEngine, exceptionCallback), this, asCALL_THISCALL);
         if (result < 0)
         {
             SLOG(fmt::format("Warning: Could not attach ExceptionCallback to NID {}, error code {}; continuing without it...", result, nid));
@@ -294,10 +338,34 @@ int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid)
     }
 
     // Run the script
+    const int64_t start_us = SimProfiler::GetTimestampUs();
     m_currently_executing_script_unit = nid;
-    int result = context->Execute();
+    int result = ctx->Execute();
     m_currently_executing_script_unit = SCRIPTUNITID_INVALID;
+    m_line_callback_deadline_us = prev_deadline_us;
+    m_line_callback_events = prev_events;
+
+    // The script may have unloaded itself.
+    auto found = m_script_units.find(nid);
+    if (found != m_script_units.end())
+    {
+        found->second.frameTimeAccumMs += (SimProfiler::GetTimestampUs() - start_us) / 1000.f;
+    }
+
+    if (result != AngelScript::asEXECUTION_SUSPENDED) // Ran out of time, see `framestep()`
+    {
+        this->logExecutionResult(result, ctx, nid);
+    }
+
+    // Clear the callbacks so they don't intercept unrelated operations.
+    ctx->ClearLineCallback();
+    ctx->ClearExceptionCallback();
+
+    return result;
+}
 
+void ScriptEngine::logExecutionResult(int result, AngelScript::asIScriptContext* ctx, ScriptUnitId_t nid)
+{
     if ( result != AngelScript::asEXECUTION_FINISHED )
     {
         // The execution didn't complete as expected. Determine what happened.
@@ -311,9 +379,9 @@ int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid)
             // NOTE: this result is only reported if exception callback is not registered, see `SetExceptionCallback()`
             SLOG("The script ended with exception; details below:");
             // Write some information about the script exception
-            SLOG("\tcontext.ExceptionLineNumber: " + TOSTRING(context->GetExceptionLineNumber()));
-            SLOG("\tcontext.ExceptionString: " + ptr2str(context->GetExceptionString()));
-            AngelScript::asIScriptFunction* func = context->GetExceptionFunction();
+            SLOG("\tcontext.ExceptionLineNumber: " + TOSTRING(ctx->GetExceptionLineNumber()));
+            SLOG("\tcontext.ExceptionString: " + ptr2str(ctx->GetExceptionString()));
+            AngelScript::asIScriptFunction* func = ctx->GetExceptionFunction();
             if (func)
             {
                 SLOG("\tcontext.ExceptionFunction.Declaration: " + ptr2str(func->GetDeclaration()));
@@ -324,10 +392,10 @@ int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid)
         }
         else if (result == AngelScript::asCONTEXT_NOT_PREPARED)
         {
-            if (context->GetFunction())
+            if (ctx->GetFunction())
             {
                 SLOG(fmt::format("The script ended with error code asCONTEXT_NOT_PREPARED; Function to execute: {},currently triggered event: {}, NID: {}",
-                    context->GetFunction()->GetName(), fmt::underlying(m_currently_executing_event_trigger), nid));
+                    ctx->GetFunction()->GetName(), fmt::underlying(m_currently_executing_event_trigger), nid));
             }
             else
             {
@@ -340,12 +408,6 @@ int ScriptEngine::executeContextAndHandleErrors(ScriptUnitId_t nid)
             SLOG("The script ended for some unforeseen reason " + TOSTRING(result));
         }
     }
-
-    // Clear the callbacks so they don't intercept unrelated operations.
-    context->ClearLineCallback();
-    context->ClearExceptionCallback();
-
-    return result;
 }
 
 bool ScriptEngine::prepareContextAndHandleErrors(ScriptUnitId_t nid, int asFunctionID)
@@ -357,6 +419,11 @@ bool ScriptEngine::prepareContextAndHandleErrors(ScriptUnitId_t nid, int asFunct
         return false;
     }
 
+    return this->prepareContextAndHandleErrors(nid, scriptFunc);
+}
+
+bool ScriptEngine::prepareContextAndHandleErrors(ScriptUnitId_t nid, asIScriptFunction* scriptFunc)
+{
     int result = this->context->Prepare(scriptFunc);
     if (result < 0)
     {
@@ -370,31 +437,143 @@ bool ScriptEngine::prepareContextAndHandleErrors(ScriptUnitId_t nid, int asFunct
 
 void ScriptEngine::framestep(Real dt)
 {
+    ROR_PROFILE_ZONE("ScriptEngine::framestep", -1);
+
     // Check if we need to execute any strings
-    std::vector<String> tmpQueue;
+    FrameVector<String> tmpQueue;
     stringExecutionQueue.pull(tmpQueue);
-    std::vector<String>::iterator it;
-    for (it=tmpQueue.begin(); it!=tmpQueue.end();it++)
+    for (String const& str: tmpQueue)
     {
-        executeString(*it);
+        executeString(str);
     }
 
     // framestep stuff below
     if (!engine || !context) return;
 
+    // Collect the worker lane from last frame first - it reports times and queued messages
+    this->syncWorkerLane();
+
+    const float budget_ms = App::app_script_frame_budget_ms->getFloat();
     for (auto& pair: m_script_units)
     {
         ScriptUnitId_t nid = pair.first;
-        if (m_script_units[nid].frameStepFunctionPtr)
+        ScriptUnit& unit = pair.second;
+        unit.frameTimeMs = unit.frameTimeAccumMs;
+        unit.frameTimeAccumMs = 0.f;
+        if (unit.frameStepFunctionPtr && !unit.workerLane)
         {
-            // Set the function pointer and arguments
-            context->Prepare(m_script_units[nid].frameStepFunctionPtr);
-            context->SetArgFloat(0, dt);
+            // Each unit steps in its own context (from the engine's pool), so that
+            // one which runs out of time can be suspended and resumed next frame
+            // without blocking events on the shared context.
+            // A resumed `frameStep()` doesn't receive the new dt; it simply continues.
+            asIScriptContext* ctx = unit.frameStepContext;
+            if (!ctx)
+            {
+                ctx = engine->RequestContext();
+                if (!ctx || ctx->Prepare(unit.frameStepFunctionPtr) < 0)
+                {
+                    if (ctx)
+                        engine->ReturnContext(ctx);
+                    continue;
+                }
+                ctx->SetArgFloat(0, dt);
+            }
 
             // Run the context via helper
-            this->executeContextAndHandleErrors(nid);
+            const int64_t deadline_us = (budget_ms > 0.f)
+                ? SimProfiler::GetTimestampUs() + static_cast<int64_t>(budget_ms * 1000.f)
+                : -1;
+            int result = this->executeContextAndHandleErrors(nid, ctx, deadline_us);
+            if (result == AngelScript::asEXECUTION_SUSPENDED)
+            {
+                unit.frameStepContext = ctx;
+                unit.frameStepSuspendCount++;
+            }
+            else
+            {
+                unit.frameStepContext = nullptr;
+                engine->ReturnContext(ctx);
+            }
         }
     }
+
+    this->startWorkerLane(dt);
+}
+
+void ScriptEngine::startWorkerLane(float dt)
+{
+    ROR_ASSERT(!m_worker_lane_task);
+    for (auto& pair: m_script_units)
+    {
+        if (pair.second.workerLane && pair.second.frameStepFunctionPtr)
+        {
+            asIScriptContext* ctx = engine->RequestContext();
+            if (!ctx || ctx->Prepare(pair.second.frameStepFunctionPtr) < 0)
+            {
+                if (ctx)
+                    engine->ReturnContext(ctx);
+                continue;
+            }
+            ctx->SetArgFloat(0, dt);
+            m_worker_lane_jobs.push_back(WorkerLaneJob{ pair.first, ctx, 0, 0.f });
+        }
+    }
+
+    if (m_worker_lane_jobs.empty())
+        return;
+
+    // The units run one after another, in a single task. Nothing but the contexts is touched,
+    // the main thread keeps the jobs and modules intact until `syncWorkerLane()`.
+    std::vector<WorkerLaneJob>* jobs = &m_worker_lane_jobs;
+    m_worker_lane_task = App::GetThreadPool()->RunTask([jobs]()
+        {
+            for (WorkerLaneJob& job: *jobs)
+            {
+                const int64_t start_us = SimProfiler::GetTimestampUs();
+                job.result = job.ctx->Execute();
+                job.time_ms = (SimProfiler::GetTimestampUs() - start_us) / 1000.f;
+            }
+            AngelScript::asThreadCleanup(); // Pool threads are shared, don't keep AngelScript's thread-local data around
+        });
+}
+
+void ScriptEngine::syncWorkerLane()
+{
+    if (m_worker_lane_task)
+    {
+        m_worker_lane_task->join();
+        m_worker_lane_task = nullptr;
+
+        for (WorkerLaneJob& job: m_worker_lane_jobs)
+        {
+            auto found = m_script_units.find(job.nid);
+            if (found != m_script_units.end())
+            {
+                found->second.frameTimeAccumMs += job.time_ms;
+            }
+            this->logExecutionResult(job.result, job.ctx, job.nid);
+            engine->ReturnContext(job.ctx);
+        }
+        m_worker_lane_jobs.clear();
+    }
+
+    std::vector<std::pair<MsgType, CScriptDictionary*>> msgs;
+    {
+        std::lock_guard<std::mutex> lock(m_worker_lane_msg_mutex);
+        msgs.swap(m_worker_lane_msgs);
+    }
+    for (auto& msg: msgs)
+    {
+        m_game_script.pushMessage(msg.first, msg.second);
+        if (msg.second)
+            msg.second->Release();
+    }
+}
+
+void ScriptEngine::queueMessage(MsgType type, AngelScript::CScriptDictionary* dict)
+{
+    std::lock_guard<std::mutex> lock(m_worker_lane_msg_mutex);
+    m_worker_lane_msgs.push_back(std::make_pair(type, dict));
 }
 
 int ScriptEngine::fireEvent(std::string instanceName, float intensity)
@@ -402,13 +581,15 @@ int ScriptEngine::fireEvent(std::string instanceName, float intensity)
     if (!engine || !context)
         return 0;
 
-    for (auto& pair: m_script_units)
+    this->updateEventSubscribers();
+    for (size_t i = 0; i < m_fire_event_subscribers.size(); i++) // The handler may load/unload scripts
     {
-        ScriptUnitId_t id = pair.first;
-        AngelScript::asIScriptFunction* func = m_script_units[id].scriptModule->GetFunctionByDecl(
-            "void fireEvent(string, float)"); // TODO: this shouldn't be hard coded --neorej16
+        ScriptUnitId_t id = m_fire_event_subscribers[i];
+        auto found = m_script_units.find(id);
+        if (found == m_script_units.end() || !found->second.fireEventFunctionPtr)
+            continue;
 
-        context->Prepare(func);
+        context->Prepare(found->second.fireEventFunctionPtr);
 
         // Set the function arguments
         context->SetArgObject(0, &instanceName);
@@ -436,17 +617,33 @@ void ScriptEngine::envokeCallback(int _functionId, eventsource_t *source, NodeNu
     if (!engine || !context)
         return;
 
+    // Resolve once, not per script unit
+    asIScriptFunction* func = nullptr;
+    if (_functionId > 0)
+    {
+        func = engine->GetFunctionById(_functionId);
+        if (!func)
+        {
+            SLOG(fmt::format("Cannot execute script function with ID {} - not found", _functionId));
+            return;
+        }
+    }
+
     for (auto& pair: m_script_units)
     {
         ScriptUnitId_t id = pair.first;
-        int functionId = _functionId;
-        if (functionId <= 0 && (m_script_units[id].defaultEventCallbackFunctionPtr != nullptr))
+        if (pair.second.workerLane)
+            continue; // Its module may be executing right now
+        asIScriptFunction* callback = func;
+        if (!callback)
         {
             // use the default event handler instead then
-            functionId = m_script_units[id].defaultEventCallbackFunctionPtr->GetId();
+            callback = pair.second.defaultEventCallbackFunctionPtr;
         }
+        if (!callback)
+            continue; // No handler in this unit
 
-        if (this->prepareContextAndHandleErrors(id, functionId))
+        if (this->prepareContextAndHandleErrors(id, callback))
         {
             // Set the function arguments
             context->SetArgDWord (0, type);
@@ -527,6 +724,11 @@ int ScriptEngine::addFunction(const String &arg)
             if (m_script_units[m_terrain_script_unit].eventCallbackExFunctionPtr == nullptr)
                 m_script_units[m_terrain_script_unit].eventCallbackExFunctionPtr = func;
         }
+        else if (func == mod->GetFunctionByDecl("void fireEvent(string, float)"))
+        {
+            if (m_script_units[m_terrain_script_unit].fireEventFunctionPtr == nullptr)
+                m_script_units[m_terrain_script_unit].fireEventFunctionPtr = func;
+        }
         // THIS IS OBSOLETE - Use `eventCallbackEx()` and `SE_EVENTBOX_ENTER` instead. See commentary in `envokeCallback()`
         else if (func == this->getFunctionByDeclAndLogCandidates(
                 m_terrain_script_unit, GETFUNCFLAG_OPTIONAL,
@@ -535,6 +737,7 @@ int ScriptEngine::addFunction(const String &arg)
             if (m_script_units[m_terrain_script_unit].defaultEventCallbackFunctionPtr == nullptr)
                 m_script_units[m_terrain_script_unit].defaultEventCallbackFunctionPtr = func;
         }
+        m_event_subscribers_dirty = true;
     }
 
     // We must release the function object
@@ -612,6 +815,11 @@ int ScriptEngine::deleteFunction(const String &arg)
         if ( m_script_units[m_terrain_script_unit].defaultEventCallbackFunctionPtr == func )
             m_script_units[m_terrain_script_unit].defaultEventCallbackFunctionPtr = nullptr;
 
+        if (m_script_units[m_terrain_script_unit].fireEventFunctionPtr == func)
+            m_script_units[m_terrain_script_unit].fireEventFunctionPtr = nullptr;
+
+        m_event_subscribers_dirty = true;
+
         return func->GetId();
     }
     else
@@ -700,25 +908,47 @@ void ScriptEngine::triggerEvent(scriptEvents eventnum, int arg1, int arg2ex, int
 {
     if (!engine || !context || !m_events_enabled) return;
 
-    for (auto& pair: m_script_units)
+    if (eventnum == SE_NO_EVENTS)
+        return;
+
+    // Events are single bits; only the units registered for it are visited. Combinations (from scripts) go to all units.
+    int bit = 0;
+    if ((eventnum & (eventnum - 1)) == 0)
     {
-        ScriptUnitId_t id = pair.first;
-        asIScriptFunction* callback = m_script_units[id].eventCallbackExFunctionPtr;
+        while (!(eventnum & (1u << bit)))
+        {
+            bit++;
+        }
+    }
+    else
+    {
+        bit = NUM_EVENT_BITS;
+    }
+
+    this->updateEventSubscribers();
+    for (size_t i = 0; i < m_event_subscribers[bit].size(); i++) // The handler may (un)register events, which rebuilds the list
+    {
+        ScriptUnitId_t id = m_event_subscribers[bit][i];
+        auto found = m_script_units.find(id);
+        if (found == m_script_units.end())
+            continue;
+
+        asIScriptFunction* callback = found->second.eventCallbackExFunctionPtr;
         if (!callback)
-            callback = m_script_units[id].eventCallbackFunctionPtr;
+            callback = found->second.eventCallbackFunctionPtr;
         if (!callback)
             continue;
 
-        if (m_script_units[id].eventMask & eventnum)
+        if (found->second.eventMask & eventnum)
         {
             // script registered for that event, so sent it
-            if (this->prepareContextAndHandleErrors(id, callback->GetId()))
+            if (this->prepareContextAndHandleErrors(id, callback))
             {
 
                 // Set the function arguments
                 context->SetArgDWord(0, eventnum);
                 context->SetArgDWord(1, arg1);
-                if (callback == m_script_units[id].eventCallbackExFunctionPtr)
+                if (callback == found->second.eventCallbackExFunctionPtr)
                 {
                     // Extended arguments
                     context->SetArgDWord(2, arg2ex);
@@ -738,6 +968,43 @@ void ScriptEngine::triggerEvent(scriptEvents eventnum, int arg1, int arg2ex, int
     }
 }
 
+void ScriptEngine::setEventMask(ScriptUnitId_t nid, unsigned int eventMask)
+{
+    m_script_units[nid].eventMask = eventMask;
+    m_event_subscribers_dirty = true;
+}
+
+void ScriptEngine::updateEventSubscribers()
+{
+    if (!m_event_subscribers_dirty)
+        return;
+
+    for (std::vector<ScriptUnitId_t>& subscribers: m_event_subscribers)
+    {
+        subscribers.clear();
+    }
+    m_fire_event_subscribers.clear();
+
+    for (auto& pair: m_script_units)
+    {
+        ScriptUnit& unit = pair.second;
+        if (unit.eventCallbackExFunctionPtr || unit.eventCallbackFunctionPtr)
+        {
+            for (int bit = 0; bit < NUM_EVENT_BITS; bit++)
+            {
+                if (unit.eventMask & (1u << bit))
+                    m_event_subscribers[bit].push_back(pair.first);
+            }
+            m_event_subscribers[NUM_EVENT_BITS].push_back(pair.first);
+        }
+        if (unit.fireEventFunctionPtr)
+        {
+            m_fire_event_subscribers.push_back(pair.first);
+        }
+    }
+    m_event_subscribers_dirty = false;
+}
+
 String ScriptEngine::composeModuleName(String const& scriptName, ScriptCategory origin, ScriptUnitId_t id)
 {
     return fmt::format("{}(category:{},unique ID:{})", scriptName, ScriptCategoryToString(origin), id);
@@ -745,7 +1012,7 @@ String ScriptEngine::composeModuleName(String const& scriptName, ScriptCategory
 
 ScriptUnitId_t ScriptEngine::loadScript(
     String scriptName, ScriptCategory category/* = ScriptCategory::TERRAIN*/,
-    ActorPtr associatedActor /*= nullptr*/, std::string buffer /* =""*/)
+    ActorPtr associatedActor /*= nullptr*/, std::string buffer /* =""*/, bool workerLane /*= false*/)
 {
     // This function creates a new script unit, tries to set it up and removes it if setup fails.
     // -----------------------------------------------------------------------------------------
@@ -760,6 +1027,14 @@ ScriptUnitId_t ScriptEngine::loadScript(
     m_script_units[unit_id].scriptName = scriptName;
     m_script_units[unit_id].scriptCategory = category;
     m_script_units[unit_id].scriptBuffer = buffer;
+    if (workerLane && category != ScriptCategory::CUSTOM)
+    {
+        // Terrain scripts live on events and `game.addScriptFunction()` etc. modify their module;
+        // actor scripts get `BeamClass@ thisActor` which isn't thread-safe API.
+        SLOG(fmt::format("Script '{}' ({}) can't run on worker lane, running on main thread.", scriptName, ScriptCategoryToString(category)));
+        workerLane = false;
+    }
+    m_script_units[unit_id].workerLane = workerLane;
     if (category == ScriptCategory::TERRAIN)
     {
         m_terrain_script_unit = unit_id;
@@ -778,6 +1053,8 @@ ScriptUnitId_t ScriptEngine::loadScript(
         CvarAddFileToList(App::app_recent_scripts, scriptName);
     }
 
+    m_event_subscribers_dirty = true;
+
     // If setup failed, remove the unit.
     if (result != 0)
     {
@@ -814,6 +1091,10 @@ int ScriptEngine::setupScriptUnit(int unit_id)
         return result;
     }
     m_script_units[unit_id].scriptModule = engine->GetModule(moduleName.c_str(), AngelScript::asGM_ONLY_IF_EXISTS);
+    if (m_script_units[unit_id].workerLane)
+    {
+        m_script_units[unit_id].scriptModule->SetAccessMask(SCRIPT_ACCESS_WORKER_LANE); // Compile errors instead of data races
+    }
 
     // For actor scripts, add global var `thisActor` to the module
     if (m_script_units[unit_id].scriptCategory == ScriptCategory::ACTOR)
@@ -827,9 +1108,10 @@ int ScriptEngine::setupScriptUnit(int unit_id)
         }
     }
 
-    // add global var `thisScript` to the module (initialized in place).
+    // add global var `thisScript` to the module (initialized when globals are).
+    // Not a literal, the module's bytecode must not depend on the unit ID - see `composeByteCodeCacheName()`.
     result = m_script_units[unit_id].scriptModule->AddScriptSection(m_script_units[unit_id].scriptName.c_str(), 
-        fmt::format("const int thisScript = {};", unit_id).c_str());
+        "const int thisScript = getCurrentScriptUnit();");
     if (result < 0)
     {
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR,
@@ -860,18 +1142,30 @@ int ScriptEngine::setupScriptUnit(int unit_id)
         }
     }
 
-    // Build the AngelScript module - this loads `#include`-d scripts
-    // and runs any global statements, for example constructors of
-    // global objects like raceManager in 'races.as'. For this reason,
-    // the game must already be aware of the script, but only temporarily.
-    m_currently_executing_script_unit = unit_id; // for `BuildModule()` below.
-    result = builder.BuildModule();
-    m_currently_executing_script_unit = SCRIPTUNITID_INVALID; // Tidy up.
-    if ( result < 0 )
+    // All code is known now (`#include`-s are processed when adding sections); skip compiling if it's cached.
+    const std::string bytecodeName = this->composeByteCodeCacheName(unit_id, m_script_units[unit_id].scriptBuffer + builder.GetLoadedCode());
+    AngelScript::asIScriptModule* cachedModule = this->loadByteCodeCache(unit_id, moduleName, bytecodeName);
+    if (cachedModule)
     {
-        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR,
-            fmt::format("Could not load script '{}' - failed to build module. See 'Angelscript.log' for more info.", moduleName));
-        return result;
+        m_script_units[unit_id].scriptModule = cachedModule;
+    }
+    else
+    {
+        // Build the AngelScript module - this loads `#include`-d scripts
+        // and runs any global statements, for example constructors of
+        // global objects like raceManager in 'races.as'. For this reason,
+        // the game must already be aware of the script, but only temporarily.
+        m_currently_executing_script_unit = unit_id; // for `BuildModule()` below.
+        result = builder.BuildModule();
+        m_currently_executing_script_unit = SCRIPTUNITID_INVALID; // Tidy up.
+        if ( result < 0 )
+        {
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR,
+                fmt::format("Could not load script '{}' - failed to build module. See 'Angelscript.log' for more info.", moduleName));
+            return result;
+        }
+
+        this->saveByteCodeCache(unit_id, bytecodeName);
     }
 
     String scriptHash;
@@ -881,12 +1175,19 @@ int ScriptEngine::setupScriptUnit(int unit_id)
     // get some other optional functions
     m_script_units[unit_id].frameStepFunctionPtr = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void frameStep(float)");
 
-    m_script_units[unit_id].eventCallbackFunctionPtr = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void eventCallback(int, int)");
-    m_script_units[unit_id].eventCallbackExFunctionPtr = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void eventCallbackEx(scriptEvents,   int, int, int, int,   string, string, string, string)");
+    // Worker lane units get no events - they'd run on the main thread while `frameStep()` runs on the worker.
+    if (!m_script_units[unit_id].workerLane)
+    {
+        m_script_units[unit_id].eventCallbackFunctionPtr = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void eventCallback(int, int)");
+        m_script_units[unit_id].eventCallbackExFunctionPtr = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void eventCallbackEx(scriptEvents,   int, int, int, int,   string, string, string, string)");
 
-    // THIS IS OBSOLETE - Use `eventCallbackEx()` and `SE_EVENTBOX_ENTER` instead. See commentary in `envokeCallback()`
-    m_script_units[unit_id].defaultEventCallbackFunctionPtr = this->getFunctionByDeclAndLogCandidates(
-        unit_id, GETFUNCFLAG_OPTIONAL, GETFUNC_DEFAULTEVENTCALLBACK_NAME, GETFUNC_DEFAULTEVENTCALLBACK_SIGFMT);
+        // THIS IS OBSOLETE - Use `eventCallbackEx()` and `SE_EVENTBOX_ENTER` instead. See commentary in `envokeCallback()`
+        m_script_units[unit_id].defaultEventCallbackFunctionPtr = this->getFunctionByDeclAndLogCandidates(
+            unit_id, GETFUNCFLAG_OPTIONAL, GETFUNC_DEFAULTEVENTCALLBACK_NAME, GETFUNC_DEFAULTEVENTCALLBACK_SIGFMT);
+
+        m_script_units[unit_id].fireEventFunctionPtr = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void fireEvent(string, float)");
+    }
+    m_event_subscribers_dirty = true; // `main()` below may already trigger events
 
     // Find the function that is to be called.
     auto main_func = m_script_units[unit_id].scriptModule->GetFunctionByDecl("void main()");
@@ -975,13 +1276,168 @@ int ScriptEngine::setupScriptUnit(int unit_id)
     return 0;
 }
 
+// In-memory `asIBinaryStream` for `SaveByteCode()`/`LoadByteCode()`; files go through OGRE resource system.
+class ByteCodeStream: public AngelScript::asIBinaryStream
+{
+public:
+    int Write(const void* ptr, AngelScript::asUINT size) override
+    {
+        data.append(static_cast<const char*>(ptr), size);
+        return 0;
+    }
+
+    int Read(void* ptr, AngelScript::asUINT size) override
+    {
+        if (size > data.size() - pos)
+            return -1;
+        std::memcpy(ptr, data.data() + pos, size);
+        pos += size;
+        return 0;
+    }
+
+    std::string data;
+    size_t pos = 0;
+};
+
+std::string const& ScriptEngine::getRegistrationHash()
+{
+    // Bytecode refers to registered functions/types by declaration; if any of them
+    // changed (new game version), loading would fail or worse, silently use a different enum value.
+    if (m_registration_hash.empty())
+    {
+        std::string decls = ANGELSCRIPT_VERSION_STRING "\n";
+        for (asUINT i = 0; i < engine->GetObjectTypeCount(); i++)
+        {
+            asITypeInfo* type = engine->GetObjectTypeByIndex(i);
+            decls += fmt::format("type {} {}\n", type->GetName(), type->GetFlags());
+            for (asUINT j = 0; j < type->GetBehaviourCount(); j++)
+            {
+                asEBehaviours behaviour;
+                decls += fmt::format("{} {}\n", type->GetBehaviourByIndex(j, &behaviour)->GetDeclaration(true, true, true), static_cast<int>(behaviour));
+            }
+            for (asUINT j = 0; j < type->GetFactoryCount(); j++)
+                decls += fmt::format("{}\n", type->GetFactoryByIndex(j)->GetDeclaration(true, true, true));
+            for (asUINT j = 0; j < type->GetMethodCount(); j++)
+                decls += fmt::format("{}\n", type->GetMethodByIndex(j)->GetDeclaration(true, true, true));
+            for (asUINT j = 0; j < type->GetPropertyCount(); j++)
+                decls += fmt::format("{}\n", type->GetPropertyDeclaration(j, true));
+        }
+        for (asUINT i = 0; i < engine->GetEnumCount(); i++)
+        {
+            asITypeInfo* type = engine->GetEnumByIndex(i);
+            decls += fmt::format("enum {}\n", type->GetName());
+            for (asUINT j = 0; j < type->GetEnumValueCount(); j++)
+            {
+                int value = 0;
+                const char* name = type->GetEnumValueByIndex(j, &value);
+                decls += fmt::format("{}={}\n", name, value);
+            }
+        }
+        for (asUINT i = 0; i < engine->GetFuncdefCount(); i++)
+            decls += fmt::format("{}\n", engine->GetFuncdefByIndex(i)->GetFuncdefSignature()->GetDeclaration(true, true, true));
+        for (asUINT i = 0; i < engine->GetGlobalFunctionCount(); i++)
+            decls += fmt::format("{}\n", engine->GetGlobalFunctionByIndex(i)->GetDeclaration(true, true, true));
+        for (asUINT i = 0; i < engine->GetGlobalPropertyCount(); i++)
+        {
+            const char* name = nullptr;
+            const char* nameSpace = nullptr;
+            int typeId = 0;
+            bool isConst = false;
+            engine->GetGlobalPropertyByIndex(i, &name, &nameSpace, &typeId, &isConst);
+            decls += fmt::format("{} {}::{} {}\n", engine->GetTypeDeclaration(typeId, true), nameSpace, name, isConst);
+        }
+        m_registration_hash = Sha1Hash(decls);
+    }
+    return m_registration_hash;
+}
+
+std::string ScriptEngine::composeByteCodeCacheName(ScriptUnitId_t nid, std::string const& code)
+{
+    ScriptUnit& unit = m_script_units[nid];
+    std::string key = fmt::format("{}\n{}\n{}\n{}\n", this->getRegistrationHash(), static_cast<int>(unit.scriptCategory), unit.workerLane, unit.scriptName);
+    return fmt::format("script_{}.asbc", Sha1Hash(key + code));
+}
+
+asIScriptModule* ScriptEngine::loadByteCodeCache(ScriptUnitId_t nid, std::string const& moduleName, std::string const& filename)
+{
+    if (!FileExists(PathCombine(App::sys_cache_dir->getStr(), filename)))
+        return nullptr;
+
+    ByteCodeStream stream;
+    try
+    {
+        Ogre::DataStreamPtr ds = Ogre::ResourceGroupManager::getSingleton().openResource(filename, RGN_CACHE);
+        stream.data = ds->getAsString();
+    }
+    catch (std::exception& e)
+    {
+        SLOG(fmt::format("Could not read bytecode cache '{}', message: '{}'", filename, e.what()));
+        return nullptr;
+    }
+
+    // Load into a separate module - the source module (with the sections added) is kept in case this fails.
+    // Global variables are initialized by `LoadByteCode()`, same as by `Build()`.
+    asIScriptModule* module = engine->GetModule((moduleName + ":bytecode").c_str(), asGM_ALWAYS_CREATE);
+    if (m_script_units[nid].workerLane)
+    {
+        module->SetAccessMask(SCRIPT_ACCESS_WORKER_LANE);
+    }
+    m_currently_executing_script_unit = nid; // for `LoadByteCode()` below.
+    int result = module->LoadByteCode(&stream);
+    m_currently_executing_script_unit = SCRIPTUNITID_INVALID; // Tidy up.
+    if (result < 0)
+    {
+        SLOG(fmt::format("Could not load bytecode cache '{}', error code {}; compiling the script instead.", filename, result));
+        module->Discard();
+        App::GetContentManager()->DeleteDiskFile(filename, RGN_CACHE);
+        return nullptr;
+    }
+
+    engine->DiscardModule(moduleName.c_str());
+    module->SetName(moduleName.c_str());
+    SLOG(fmt::format("Loaded '{}' from bytecode cache '{}'", moduleName, filename));
+    return module;
+}
+
+void ScriptEngine::saveByteCodeCache(ScriptUnitId_t nid, std::string const& filename)
+{
+    // Debug info is kept, line numbers are needed for error reports and SE_ANGELSCRIPT_LINECALLBACK.
+    ByteCodeStream stream;
+    int result = m_script_units[nid].scriptModule->SaveByteCode(&stream, /*stripDebugInfo=*/false);
+    if (result < 0)
+    {
+        SLOG(fmt::format("Could not save bytecode of '{}', error code {}", m_script_units[nid].scriptName, result));
+        return;
+    }
+
+    try
+    {
+        Ogre::DataStreamPtr ds = Ogre::ResourceGroupManager::getSingleton().createResource(filename, RGN_CACHE, /*overwrite=*/true);
+        if (ds->write(stream.data.data(), stream.data.size()) != stream.data.size())
+        {
+            SLOG(fmt::format("Error writing bytecode cache '{}'", filename));
+        }
+    }
+    catch (std::exception& e)
+    {
+        SLOG(fmt::format("Error writing bytecode cache '{}', message: '{}'", filename, e.what()));
+    }
+}
+
 void ScriptEngine::unloadScript(ScriptUnitId_t id)
 {
     ROR_ASSERT(id != SCRIPTUNITID_INVALID);
     ROR_ASSERT(m_currently_executing_script_unit == SCRIPTUNITID_INVALID);
 
+    this->syncWorkerLane(); // The module may be executing
+    if (m_script_units[id].frameStepContext)
+    {
+        m_script_units[id].frameStepContext->Abort();
+        engine->ReturnContext(m_script_units[id].frameStepContext);
+    }
     engine->DiscardModule(m_script_units[id].scriptModule->GetName());
     m_script_units.erase(id);
+    m_event_subscribers_dirty = true;
     if (m_terrain_script_unit == id)
     {
         m_terrain_script_unit = SCRIPTUNITID_INVALID;
@@ -41,12 +41,19 @@
 #include "scriptbuilder/scriptbuilder.h"
 
 #include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace RoR {
 
 /// @addtogroup Scripting
 /// @{
 
+/// Access masks of the registered API, see `asIScriptEngine::SetDefaultAccessMask()` and `ScriptUnit::workerLane`.
+static const AngelScript::asDWORD SCRIPT_ACCESS_MAIN_THREAD = BITMASK(1);
+static const AngelScript::asDWORD SCRIPT_ACCESS_WORKER_LANE = BITMASK(2); //!< Thread-safe API: math, strings, containers, value types, LocalStorage, `queueMessage()`
+
 /// Asynchronously (via `MSG_SIM_SCRIPT_EVENT_TRIGGERED`) invoke script function `eventCallbackEx()`, if registered, otherwise fall back to `eventCallback()`
 inline void TRIGGER_EVENT_ASYNC(scriptEvents type, int arg1, int arg2ex = 0, int arg3ex = 0, int arg4ex = 0, std::string arg5ex = "", std::string arg6ex = "", std::string arg7ex = "", std::string arg8ex = "")
 {
@@ -76,6 +83,12 @@ struct ScriptUnit
     AngelScript::asIScriptFunction* eventCallbackFunctionPtr = nullptr; //!< script function pointer to the event callback function
     AngelScript::asIScriptFunction* eventCallbackExFunctionPtr = nullptr; //!< script function pointer to the event callback function
     AngelScript::asIScriptFunction* defaultEventCallbackFunctionPtr = nullptr; //!< script function pointer for spawner events
+    AngelScript::asIScriptFunction* fireEventFunctionPtr = nullptr; //!< script function pointer to `fireEvent(string, float)`
+    AngelScript::asIScriptContext* frameStepContext = nullptr; //!< Holds `frameStep()` suspended for running over 'app_script_frame_budget_ms', resumed next frame.
+    int frameStepSuspendCount = 0;
+    float frameTimeMs = 0.f; //!< Time spent executing this unit in the last frame, including event callbacks.
+    float frameTimeAccumMs = 0.f; //!< Time spent in the current frame so far.
+    bool workerLane = false; //!< Opt-in: `frameStep()` runs on a worker thread, concurrently with rendering. Compiled with SCRIPT_ACCESS_WORKER_LANE only and receives no events; `main()` still runs on the main thread.
     ActorPtr associatedActor; //!< For ScriptCategory::ACTOR
     Ogre::String scriptName;
     Ogre::String scriptHash;
@@ -90,6 +103,7 @@ struct LoadScriptRequest
     std::string lsr_buffer; //!< Load from memory buffer.
     ScriptCategory lsr_category = ScriptCategory::TERRAIN;
     ActorInstanceID_t lsr_associated_actor = ACTORINSTANCEID_INVALID; //!< For ScriptCategory::ACTOR
+    bool lsr_worker_lane = false; //!< See `ScriptUnit::workerLane`
 };
 
 struct ScriptCallbackArgs
@@ -128,10 +142,11 @@ public:
      * @param category How to treat the script?
      * @param associatedActor Only for category ACTOR
      * @param buffer String with full script body; if empty, a file will be loaded as usual.
+     * @param workerLane See `ScriptUnit::workerLane`; only for category CUSTOM.
      * @return Unique ID of the script unit (because one script file can be loaded multiple times).
      */
     ScriptUnitId_t loadScript(Ogre::String scriptname, ScriptCategory category = ScriptCategory::TERRAIN,
-        ActorPtr associatedActor = nullptr, std::string buffer = "");
+        ActorPtr associatedActor = nullptr, std::string buffer = "", bool workerLane = false);
 
     /**
      * Unloads a script
@@ -145,6 +160,18 @@ public:
      */
     void framestep(Ogre::Real dt);
 
+    /**
+     * Waits for worker lane `frameStep()`s to finish and forwards messages queued by `queueMessage()`.
+     * Done automatically in `framestep()`; call before touching worker lane modules otherwise.
+     */
+    void syncWorkerLane();
+
+    /**
+     * Script API, thread-safe: like `game.pushMessage()`, but the message is processed on the main thread at the next `framestep()`.
+     * @param dict Takes over the reference.
+     */
+    void queueMessage(MsgType type, AngelScript::CScriptDictionary* dict);
+
     void setForwardScriptLogToConsole(bool doForward);
 
     /**
@@ -155,6 +182,8 @@ public:
 
     void setEventsEnabled(bool val) { m_events_enabled = val; }
 
+    void setEventMask(ScriptUnitId_t nid, unsigned int eventMask); //!< Use instead of writing `ScriptUnit::eventMask` directly, keeps the subscriber lists up to date.
+
     /**
      * executes a string (useful for the console)
      * @param command string to execute
@@ -252,17 +281,36 @@ protected:
     */
     int setupScriptUnit(int unit_id);
 
+    /**
+    * Bytecode cache for `setupScriptUnit()`, stored in 'sys_cache_dir'.
+    * The key covers the source code, the script category (it determines the generated sections) and `getRegistrationHash()`.
+    */
+    std::string composeByteCodeCacheName(ScriptUnitId_t nid, std::string const& code);
+    AngelScript::asIScriptModule* loadByteCodeCache(ScriptUnitId_t nid, std::string const& moduleName, std::string const& filename);
+    void saveByteCodeCache(ScriptUnitId_t nid, std::string const& filename);
+    std::string const& getRegistrationHash(); //!< Hash of all declarations registered to the engine; bytecode is only valid with the same.
+
     /**
     * Helper for executing any script function/snippet; does `asIScriptContext::Prepare()` and reports any error.
     * @return true on success, false on error.
     */
     bool prepareContextAndHandleErrors(ScriptUnitId_t nid, int asFunctionID);
+    bool prepareContextAndHandleErrors(ScriptUnitId_t nid, AngelScript::asIScriptFunction* scriptFunc);
 
     /**
     * Helper for executing any script function/snippet; registers Line/Exception callbacks (on demand) and set currently executed NID; The `asIScriptContext::Prepare()` and setting args must be already done.
+    * @param ctx Defaults to the shared context.
+    * @param deadline_us Suspends the execution when `SimProfiler::GetTimestampUs()` passes it; -1 = no limit.
     * @return 0 on success, anything else on error.
     */
-    int executeContextAndHandleErrors(ScriptUnitId_t nid);
+    int executeContextAndHandleErrors(ScriptUnitId_t nid, AngelScript::asIScriptContext* ctx = nullptr, int64_t deadline_us = -1);
+
+    /**
+    * Runs `frameStep()` of worker lane units on the thread pool; see `ScriptUnit::workerLane`.
+    */
+    void startWorkerLane(float dt);
+
+    void logExecutionResult(int result, AngelScript::asIScriptContext* ctx, ScriptUnitId_t nid); //!< Reports failed `Execute()`
 
     /// @}
 
@@ -288,6 +336,10 @@ protected:
 
     /// @}
 
+    void updateEventSubscribers(); //!< Rebuilds the subscriber lists if script units, callbacks or event masks changed.
+
+    static const int NUM_EVENT_BITS = 32;
+
     AngelScript::asIScriptEngine* engine; //!< instance of the scripting engine
     AngelScript::asIScriptContext* context; //!< context in which all scripting happens
     Ogre::Log*      scriptLog;
@@ -297,6 +349,25 @@ protected:
     ScriptUnitId_t  m_currently_executing_script_unit = SCRIPTUNITID_INVALID;
     scriptEvents    m_currently_executing_event_trigger = SE_NO_EVENTS;
     bool            m_events_enabled = true; //!< Hack to enable fast shutdown without cleanup
+    std::vector<ScriptUnitId_t> m_event_subscribers[NUM_EVENT_BITS + 1]; //!< By bit index of `scriptEvents`; units with an event callback and the event in their mask. The last has all units with a callback.
+    std::vector<ScriptUnitId_t> m_fire_event_subscribers; //!< Units which implement `fireEvent()`
+    bool            m_event_subscribers_dirty = true;
+    int64_t         m_line_callback_deadline_us = -1; //!< Of the execution in progress, see `executeContextAndHandleErrors()`
+    bool            m_line_callback_events = false;   //!< Does the execution in progress want SE_ANGELSCRIPT_LINECALLBACK?
+    unsigned int    m_line_callback_counter = 0;
+    std::string     m_registration_hash; //!< Lazy-initialized, see `getRegistrationHash()`
+
+    struct WorkerLaneJob
+    {
+        ScriptUnitId_t nid;
+        AngelScript::asIScriptContext* ctx;
+        int result;
+        float time_ms;
+    };
+    std::vector<WorkerLaneJob> m_worker_lane_jobs; //!< Owned by `m_worker_lane_task` while it runs
+    std::shared_ptr<Task> m_worker_lane_task;
+    std::mutex      m_worker_lane_msg_mutex;
+    std::vector<std::pair<MsgType, AngelScript::CScriptDictionary*>> m_worker_lane_msgs; //!< Protected by `m_worker_lane_msg_mutex`
 
     InterThreadStoreVector<Ogre::String> stringExecutionQueue; //!< The string execution queue \see queueStringForExecution
 };
@@ -23,8 +23,71 @@
 #include "AngelScriptBindings.h"
 #include "SimData.h"
 #include <angelscript.h>
+#include "scriptarray/scriptarray.h"
+
+#include <algorithm>
 
 using namespace AngelScript;
+using namespace RoR;
+
+// Bulk accessors - a script inspecting all nodes would otherwise pay for one native call per node.
+// The output array is resized to the range and may be reused across frames to avoid reallocating.
+
+static int ClampBulkRange(int total, int& first, int& count)
+{
+    first = std::max(0, std::min(first, total));
+    if (count < 0 || count > total - first)
+    {
+        count = total - first;
+    }
+    return count;
+}
+
+static int Actor_getNodePositions(Actor* self, CScriptArray& buf, int first, int count)
+{
+    buf.Resize(ClampBulkRange(self->ar_num_nodes, first, count));
+    Ogre::Vector3* dst = static_cast<Ogre::Vector3*>(buf.GetBuffer());
+    if (self->GetGfxActor())
+    {
+        // The simbuffer - same positions as are being rendered.
+        NodeSB* nodes = self->GetGfxActor()->GetSimNodeBuffer();
+        for (int i = 0; i < count; i++)
+            dst[i] = nodes[first + i].AbsPosition;
+    }
+    else
+    {
+        for (int i = 0; i < count; i++)
+            dst[i] = self->ar_nodes[first + i].AbsPosition;
+    }
+    return count;
+}
+
+static int Actor_getNodeVelocities(Actor* self, CScriptArray& buf, int first, int count)
+{
+    buf.Resize(ClampBulkRange(self->ar_num_nodes, first, count));
+    Ogre::Vector3* dst = static_cast<Ogre::Vector3*>(buf.GetBuffer());
+    for (int i = 0; i < count; i++)
+        dst[i] = self->ar_nodes[first + i].Velocity;
+    return count;
+}
+
+static int Actor_getNodeForces(Actor* self, CScriptArray& buf, int first, int count)
+{
+    buf.Resize(ClampBulkRange(self->ar_num_nodes, first, count));
+    Ogre::Vector3* dst = static_cast<Ogre::Vector3*>(buf.GetBuffer());
+    for (int i = 0; i < count; i++)
+        dst[i] = self->ar_nodes[first + i].Forces;
+    return count;
+}
+
+static int Actor_getBeamStresses(Actor* self, CScriptArray& buf, int first, int count)
+{
+    buf.Resize(ClampBulkRange(self->ar_num_beams, first, count));
+    float* dst = static_cast<float*>(buf.GetBuffer());
+    for (int i = 0; i < count; i++)
+        dst[i] = self->ar_beams[first + i].stress;
+    return count;
+}
 
 void RoR::RegisterActor(asIScriptEngine *engine)
 {
@@ -93,6 +156,11 @@ void RoR::RegisterActor(asIScriptEngine *engine)
     result = engine->RegisterObjectMethod("BeamClass", "float getTotalMass(bool)", asMETHOD(Actor,getTotalMass), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "int getNodeCount()", asMETHOD(Actor,getNodeCount), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "vector3 getNodePosition(int)", asMETHOD(Actor,getNodePosition), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "int getNodePositions(array<vector3>&inout buf, int first = 0, int count = -1)", asFUNCTION(Actor_getNodePositions), asCALL_CDECL_OBJFIRST); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "int getNodeVelocities(array<vector3>&inout buf, int first = 0, int count = -1)", asFUNCTION(Actor_getNodeVelocities), asCALL_CDECL_OBJFIRST); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "int getNodeForces(array<vector3>&inout buf, int first = 0, int count = -1)", asFUNCTION(Actor_getNodeForces), asCALL_CDECL_OBJFIRST); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "int getBeamCount()", asMETHOD(Actor,getBeamCount), asCALL_THISCALL); ROR_ASSERT(result>=0);
+    result = engine->RegisterObjectMethod("BeamClass", "int getBeamStresses(array<float>&inout buf, int first = 0, int count = -1)", asFUNCTION(Actor_getBeamStresses), asCALL_CDECL_OBJFIRST); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "int getWheelNodeCount()", asMETHOD(Actor,getWheelNodeCount), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "float getWheelSpeed()", asMETHOD(Actor,getWheelSpeed), asCALL_THISCALL); ROR_ASSERT(result>=0);
     result = engine->RegisterObjectMethod("BeamClass", "void reset(bool)", asMETHOD(Actor,reset), asCALL_THISCALL); ROR_ASSERT(result>=0);
@@ -46,7 +46,12 @@ enum {
     OPT_TRUCKCONFIG,
     OPT_RUNSCRIPT,
     OPT_ENTERTRUCK,
-    OPT_JOINMPSERVER
+    OPT_JOINMPSERVER,
+    OPT_BENCHMARK,
+    OPT_BENCHMARKTIME,
+    OPT_RECORD,
+    OPT_REPLAY,
+    OPT_HEADLESS
 };
 
 // option array
@@ -65,6 +70,11 @@ CSimpleOpt::SOption cmdline_options[] = {
     { OPT_CHECKCACHE,     ("-checkcache"),  SO_NONE    },
     { OPT_VER,            ("-version"),     SO_NONE    },
     { OPT_JOINMPSERVER,   ("-joinserver"),  SO_REQ_CMB },
+    { OPT_BENCHMARK,      ("-benchmark"),   SO_REQ_SEP },
+    { OPT_BENCHMARKTIME,  ("-benchmark-time"), SO_REQ_SEP },
+    { OPT_RECORD,         ("-record"),      SO_REQ_SEP },
+    { OPT_REPLAY,         ("-replay"),      SO_REQ_SEP },
+    { OPT_HEADLESS,       ("-headless"),    SO_NONE    },
     SO_END_OF_OPTIONS
 };
 
@@ -134,6 +144,29 @@ void Console::processCommandLine(int argc, char *argv[])
         {
             App::cli_preset_veh_enter->setVal(true);
         }
+        else if (args.OptionId() == OPT_BENCHMARK)
+        {
+            App::cli_benchmark_steps->setVal(Ogre::StringConverter::parseInt(args.OptionArg()));
+            App::sim_deterministic->setVal(true);
+        }
+        else if (args.OptionId() == OPT_BENCHMARKTIME)
+        {
+            App::cli_benchmark_seconds->setVal(Ogre::StringConverter::parseReal(args.OptionArg()));
+        }
+        else if (args.OptionId() == OPT_RECORD)
+        {
+            App::cli_input_record->setStr(args.OptionArg());
+            App::sim_deterministic->setVal(true);
+        }
+        else if (args.OptionId() == OPT_REPLAY)
+        {
+            App::cli_input_replay->setStr(args.OptionArg());
+            App::sim_deterministic->setVal(true);
+        }
+        else if (args.OptionId() == OPT_HEADLESS)
+        {
+            App::cli_headless->setVal(true);
+        }
         else if (args.OptionId() == OPT_JOINMPSERVER)
         {
             std::string server_args = args.OptionArg();
@@ -175,6 +208,11 @@ void Console::showCommandLineUsage()
             "-version shows the version information"                "\n"
             "-joinserver=<server>:<port> (join multiplayer server)" "\n"
             "-runscript <filename> (load script, can be repeated)"  "\n"
+            "-benchmark <steps> (runs physics steps, saves stats, quits)" "\n"
+            "-benchmark-time <seconds> (runs with a camera path, saves frame time stats, quits)" "\n"
+            "-record <file> (saves input to the profiler dir, for -replay)" "\n"
+            "-replay <file> (plays recorded input back; combine with -benchmark-time)" "\n"
+            "-headless (hidden window, nothing rendered; use with -map or -joinserver)" "\n"
             "For example: RoR.exe -map simple2 -pos '518 0 518' -rot 45 -truck semi.truck -enter"));
 }
 
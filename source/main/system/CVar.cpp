@@ -34,6 +34,7 @@ void Console::cVarSetupBuiltins()
     App::app_skip_main_menu      = this->cVarCreate("app_skip_main_menu",      "SkipMainMenu",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::app_async_physics       = this->cVarCreate("app_async_physics",       "AsyncPhysics",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::app_num_workers         = this->cVarCreate("app_num_workers",         "NumWorkerThreads",           CVAR_ARCHIVE | CVAR_TYPE_INT);
+    App::app_pin_threads         = this->cVarCreate("app_pin_threads",         "PinThreads",                 CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::app_screenshot_format   = this->cVarCreate("app_screenshot_format",   "Screenshot Format",          CVAR_ARCHIVE,                     "png");
     App::app_rendersys_override  = this->cVarCreate("app_rendersys_override",  "Render system",              CVAR_ARCHIVE);
     App::app_extra_mod_path      = this->cVarCreate("app_extra_mod_path",      "Extra mod path",             CVAR_ARCHIVE);
@@ -43,6 +44,7 @@ void Console::cVarSetupBuiltins()
     App::app_config_long_names   = this->cVarCreate("app_config_long_names",   "Config uses long names",     CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::app_custom_scripts      = this->cVarCreate("app_custom_scripts",      "",                           CVAR_ARCHIVE,                     "");
     App::app_recent_scripts      = this->cVarCreate("app_recent_scripts",      "",                           CVAR_ARCHIVE,                     "");
+    App::app_script_frame_budget_ms = this->cVarCreate("app_script_frame_budget_ms", "",                     CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "10");
 
     App::sim_state               = this->cVarCreate("sim_state",               "",                                          CVAR_TYPE_INT,     "0"/*(int)SimState::OFF*/);
     App::sim_terrain_name        = this->cVarCreate("sim_terrain_name",        "",                           0);
@@ -58,7 +60,17 @@ void Console::cVarSetupBuiltins()
     App::sim_gearbox_mode        = this->cVarCreate("sim_gearbox_mode",        "GearboxMode",                CVAR_ARCHIVE | CVAR_TYPE_INT);
     App::sim_soft_reset_mode     = this->cVarCreate("sim_soft_reset_mode",     "",                                          CVAR_TYPE_BOOL,    "false");
     App::sim_quickload_dialog    = this->cVarCreate("sim_quickload_dialog",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_savegame_json       = this->cVarCreate("sim_savegame_json",       "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::sim_autosave_interval   = this->cVarCreate("sim_autosave_interval",   "AutosaveInterval",           CVAR_ARCHIVE | CVAR_TYPE_INT,     "0");
     App::sim_live_repair_interval = this->cVarCreate("sim_live_repair_interval", "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "2.f");
+    App::sim_parallel_beams_min  = this->cVarCreate("sim_parallel_beams_min",  "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "3000");
+    App::sim_deterministic       = this->cVarCreate("sim_deterministic",       "",                           CVAR_TYPE_BOOL,                   "false");
+    App::sim_deterministic_steps = this->cVarCreate("sim_deterministic_steps", "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "33");
+    App::sim_step_budget_ms      = this->cVarCreate("sim_step_budget_ms",      "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "25");
+    App::sim_cab_bvh             = this->cVarCreate("sim_cab_bvh",             "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::sim_step_tier_distance  = this->cVarCreate("sim_step_tier_distance",  "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "200");
+    App::sim_implicit_iterations = this->cVarCreate("sim_implicit_iterations", "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "4");
+    App::sim_physics_lod_distance = this->cVarCreate("sim_physics_lod_distance", "",                         CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "500");
 
     App::mp_state                = this->cVarCreate("mp_state",                "",                                          CVAR_TYPE_INT,     "0"/*(int)MpState::DISABLED*/);
     App::mp_join_on_startup      = this->cVarCreate("mp_join_on_startup",      "Auto connect",               CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
@@ -73,6 +85,9 @@ void Console::cVarSetupBuiltins()
     App::mp_player_token         = this->cVarCreate("mp_player_token",         "User Token",                 CVAR_ARCHIVE | CVAR_NO_LOG);
     App::mp_api_url              = this->cVarCreate("mp_api_url",              "Online API URL",             CVAR_ARCHIVE,                     "http://api.rigsofrods.org");
     App::mp_cyclethru_net_actors = this->cVarCreate("mp_cyclethru_net_actors", "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::mp_net_send_budget      = this->cVarCreate("mp_net_send_budget",      "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "256");
+    App::mp_net_playout_delay    = this->cVarCreate("mp_net_playout_delay",    "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "100");
+    App::mp_net_detail_distance  = this->cVarCreate("mp_net_detail_distance",  "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "300");
 
     App::remote_query_url        = this->cVarCreate("remote_query_url",        "",                           CVAR_ARCHIVE,                     "https://v2.api.rigsofrods.org");
 
@@ -100,8 +115,11 @@ void Console::cVarSetupBuiltins()
     App::diag_hide_wheel_info    = this->cVarCreate("diag_hide_wheel_info",    "Hide wheel info",            CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::diag_hide_wheels        = this->cVarCreate("diag_hide_wheels",        "Hide wheels",                CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_hide_nodes         = this->cVarCreate("diag_hide_nodes",         "Hide nodes",                 CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::diag_declutter_labels   = this->cVarCreate("diag_declutter_labels",   "Declutter labels",           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::diag_terrn_log_roads    = this->cVarCreate("diag_terrn_log_roads",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::diag_actor_dump         = this->cVarCreate("diag_actor_dump",         "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::diag_startup_profile    = this->cVarCreate("diag_startup_profile",    "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::diag_log_rate_limit     = this->cVarCreate("diag_log_rate_limit",     "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "1000");
 
     App::sys_process_dir         = this->cVarCreate("sys_process_dir",         "",                           0);
     App::sys_user_dir            = this->cVarCreate("sys_user_dir",            "",                           0);
@@ -126,6 +144,11 @@ void Console::cVarSetupBuiltins()
     App::cli_force_cache_update  = this->cVarCreate("cli_force_cache_update",  "",                                          CVAR_TYPE_BOOL,    "false");
     App::cli_resume_autosave     = this->cVarCreate("cli_resume_autosave",     "",                                          CVAR_TYPE_BOOL,    "false");
     App::cli_custom_scripts      = this->cVarCreate("cli_custom_scripts",      "",                           0,                                "");
+    App::cli_benchmark_steps     = this->cVarCreate("cli_benchmark_steps",     "",                                          CVAR_TYPE_INT,     "0");
+    App::cli_benchmark_seconds   = this->cVarCreate("cli_benchmark_seconds",   "",                                          CVAR_TYPE_FLOAT,   "0");
+    App::cli_input_record        = this->cVarCreate("cli_input_record",        "",                                          0,                 "");
+    App::cli_input_replay        = this->cVarCreate("cli_input_replay",        "",                                          0,                 "");
+    App::cli_headless            = this->cVarCreate("cli_headless",            "",                                          CVAR_TYPE_BOOL,    "false");
 
     App::io_analog_smoothing     = this->cVarCreate("io_analog_smoothing",     "Analog Input Smoothing",     CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "1.0");
     App::io_analog_sensitivity   = this->cVarCreate("io_analog_sensitivity",   "Analog Input Sensitivity",   CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "1.0");
@@ -135,6 +158,7 @@ void Console::cVarSetupBuiltins()
     App::io_ffb_center_gain      = this->cVarCreate("io_ffb_center_gain",      "Force Feedback Centering",   CVAR_ARCHIVE | CVAR_TYPE_FLOAT);   
     App::io_ffb_master_gain      = this->cVarCreate("io_ffb_master_gain",      "Force Feedback Gain",        CVAR_ARCHIVE | CVAR_TYPE_FLOAT);   
     App::io_ffb_stress_gain      = this->cVarCreate("io_ffb_stress_gain",      "Force Feedback Stress",      CVAR_ARCHIVE | CVAR_TYPE_FLOAT);   
+    App::io_ffb_rate             = this->cVarCreate("io_ffb_rate",             "Force Feedback Rate",        CVAR_ARCHIVE | CVAR_TYPE_INT,     "200");
     App::io_input_grab_mode      = this->cVarCreate("io_input_grab_mode",      "Input Grab",                 CVAR_ARCHIVE | CVAR_TYPE_INT,     "1"/*(int)IoInputGrabMode::ALL*/);
     App::io_arcade_controls      = this->cVarCreate("io_arcade_controls",      "ArcadeControls",             CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::io_hydro_coupling       = this->cVarCreate("io_hydro_coupling",  "Keyboard Steering Speed Coupling",CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
@@ -143,6 +167,7 @@ void Console::cVarSetupBuiltins()
     App::io_outgauge_port        = this->cVarCreate("io_outgauge_port",        "OutGauge Port",              CVAR_ARCHIVE | CVAR_TYPE_INT,      "1337");
     App::io_outgauge_delay       = this->cVarCreate("io_outgauge_delay",       "OutGauge Delay",             CVAR_ARCHIVE | CVAR_TYPE_FLOAT,    "10.0");
     App::io_outgauge_id          = this->cVarCreate("io_outgauge_id",          "OutGauge ID",                CVAR_ARCHIVE | CVAR_TYPE_INT);
+    App::io_outsim_port          = this->cVarCreate("io_outsim_port",          "OutSim Port",                CVAR_ARCHIVE | CVAR_TYPE_INT,      "0");    // 0 = disabled
     App::io_discord_rpc          = this->cVarCreate("io_discord_rpc",          "Discord Rich Presence",      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
 
     App::audio_master_volume     = this->cVarCreate("audio_master_volume",     "Sound Volume",               CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "1.0");
@@ -163,6 +188,7 @@ void Console::cVarSetupBuiltins()
     App::gfx_anisotropy          = this->cVarCreate("gfx_anisotropy",          "Anisotropy",                 CVAR_ARCHIVE | CVAR_TYPE_INT,     "4");
     App::gfx_water_waves         = this->cVarCreate("gfx_water_waves",         "Waves",                      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_particles_mode      = this->cVarCreate("gfx_particles_mode",      "Particles",                  CVAR_ARCHIVE | CVAR_TYPE_INT);
+    App::gfx_particles_cull_distance = this->cVarCreate("gfx_particles_cull_distance", "",                   CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "300");
     App::gfx_enable_videocams    = this->cVarCreate("gfx_enable_videocams",    "gfx_enable_videocams",       CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_window_videocams    = this->cVarCreate("gfx_window_videocams",    "UseVideocameraWindows",      CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_surveymap_icons     = this->cVarCreate("gfx_surveymap_icons",     "Overview map icons",         CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
@@ -183,9 +209,27 @@ void Console::cVarSetupBuiltins()
     App::gfx_speedo_digital      = this->cVarCreate("gfx_speedo_digital",      "DigitalSpeedo",              CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::gfx_speedo_imperial     = this->cVarCreate("gfx_speedo_imperial",     "gfx_speedo_imperial",        CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_flexbody_cache      = this->cVarCreate("gfx_flexbody_cache",      "Flexbody_UseCache",          CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::gfx_flexbody_lod_full   = this->cVarCreate("gfx_flexbody_lod_full",   "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0.1");
+    App::gfx_flexbody_lod_frozen = this->cVarCreate("gfx_flexbody_lod_frozen", "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0.01");
+    App::gfx_flexbody_vertex_budget = this->cVarCreate("gfx_flexbody_vertex_budget", "",                     CVAR_ARCHIVE | CVAR_TYPE_INT,     "0");
+    App::gfx_actor_lod_full      = this->cVarCreate("gfx_actor_lod_full",      "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0.05");
+    App::gfx_occlusion_culling   = this->cVarCreate("gfx_occlusion_culling",   "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
+    App::gfx_frame_budget_ms     = this->cVarCreate("gfx_frame_budget_ms",     "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0");
+    App::gfx_water_grid_lod_height = this->cVarCreate("gfx_water_grid_lod_height", "",                       CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0");
+    App::gfx_water_reflection_interval = this->cVarCreate("gfx_water_reflection_interval", "",               CVAR_ARCHIVE | CVAR_TYPE_INT,     "1");
+    App::gfx_water_refraction_interval = this->cVarCreate("gfx_water_refraction_interval", "",               CVAR_ARCHIVE | CVAR_TYPE_INT,     "1");
+    App::gfx_water_still_reflection_interval = this->cVarCreate("gfx_water_still_reflection_interval", "",   CVAR_ARCHIVE | CVAR_TYPE_INT,     "0");
+    App::gfx_terrain_page_distance = this->cVarCreate("gfx_terrain_page_distance", "",                       CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "0");
+    App::gfx_terrain_max_pages   = this->cVarCreate("gfx_terrain_max_pages",   "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "0");
+    App::gfx_static_batch_size   = this->cVarCreate("gfx_static_batch_size",   "",                           CVAR_ARCHIVE | CVAR_TYPE_FLOAT,   "200");
+    App::gfx_renderdash_fps      = this->cVarCreate("gfx_renderdash_fps",      "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "30");
+    App::gfx_videocam_fps        = this->cVarCreate("gfx_videocam_fps",        "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "30");
+    App::gfx_flares_light_budget = this->cVarCreate("gfx_flares_light_budget", "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "0");
     App::gfx_reduce_shadows      = this->cVarCreate("gfx_reduce_shadows",      "Shadow optimizations",       CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
     App::gfx_enable_rtshaders    = this->cVarCreate("gfx_enable_rtshaders",    "Use RTShader System",        CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "false");
     App::gfx_alt_actor_materials = this->cVarCreate("gfx_alt_actor_materials", "Use alternate vehicle materials", CVAR_ARCHIVE | CVAR_TYPE_BOOL, "false");
+    App::gfx_shader_cache        = this->cVarCreate("gfx_shader_cache",        "",                           CVAR_ARCHIVE | CVAR_TYPE_BOOL,    "true");
+    App::gfx_texture_max_size    = this->cVarCreate("gfx_texture_max_size",    "",                           CVAR_ARCHIVE | CVAR_TYPE_INT,     "0");
 
     App::flexbody_defrag_enabled           = this->cVarCreate("flexbody_defrag_enabled",           "", CVAR_TYPE_BOOL);
     App::flexbody_defrag_const_penalty     = this->cVarCreate("flexbody_defrag_const_penalty",     "", CVAR_TYPE_INT, "7");
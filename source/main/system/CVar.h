@@ -26,6 +26,7 @@
 #include "BitFlags.h"
 
 #include <Ogre.h>
+#include <cstdint>
 #include <string>
 
 namespace RoR {
@@ -77,6 +78,7 @@ public:
             this->logUpdate(str);
             m_value_num = (float)val;
             m_value_str = str;
+            m_version++;
         }
     }
 
@@ -87,6 +89,7 @@ public:
             this->logUpdate(str);
             m_value_num = 0;
             m_value_str = str;
+            m_version++;
         }
     }
 
@@ -98,6 +101,9 @@ public:
     bool                    getBool() const  { return (bool)m_value_num; }
     template<typename T> T  getEnum() const  { return (T)this->getInt(); }
 
+    /// Incremented on every change; keep the last seen value to react to changes instead of re-applying the setting every frame.
+    uint32_t                getVersion() const { return m_version; }
+
     // Info getters
 
     std::string const&      getName() const       { return m_name; }
@@ -116,6 +122,7 @@ private:
     std::string        m_value_str;
     float              m_value_num;
     int                m_flags;
+    uint32_t           m_version = 0;
 };
 
 /// @} // addtogroup Console
@@ -92,6 +92,11 @@ void Console::handleMessage(MessageArea area, MessageType type, std::string cons
     // Lock and update message list
     std::lock_guard<std::mutex> lock(m_messages_mutex); // Scoped lock
     m_messages.emplace_back(area, type, msg, this->queryMessageTimer(), net_userid, icon);
+    m_messages_total++;
+    if (m_messages.size() > MAX_MESSAGES)
+    {
+        m_messages.pop_front();
+    }
 }
 
 void Console::putMessage(MessageArea area, MessageType type, std::string const& msg, std::string icon)
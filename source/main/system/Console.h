@@ -27,6 +27,8 @@
 #include "ConsoleCmd.h"
 
 #include <Ogre.h>
+#include <deque>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -79,17 +81,25 @@ public:
         std::string cm_icon;
     };
 
+    typedef std::deque<Message> MessageDeque;
+
+    /// Oldest messages are dropped once the history reaches this size.
+    static const size_t MAX_MESSAGES = 10000;
+
     struct MsgLockGuard
     {
         MsgLockGuard(Console& console)
-            : lock(console.m_messages_mutex), messages(console.m_messages)
+            : lock(console.m_messages_mutex), messages(console.m_messages),
+              total(console.m_messages_total), revision(console.m_messages_revision)
         {}
         MsgLockGuard(Console* console)
             : MsgLockGuard(*console)
         {}
 
-        std::vector<Message> & messages;
         std::lock_guard<std::mutex> lock;
+        MessageDeque & messages;
+        size_t       & total;    //!< Number of messages ever added, including dropped ones.
+        size_t       & revision; //!< Must be bumped when `messages` is modified other than by appending.
     };
 
     void putMessage(MessageArea area, MessageType type, std::string const& msg, std::string icon = "");
@@ -153,7 +163,9 @@ private:
 
     void handleMessage(MessageArea area, MessageType type, std::string const& msg, int net_id = 0, std::string icon = "");
 
-    std::vector<Message>     m_messages;
+    MessageDeque             m_messages;          //!< Bounded by `MAX_MESSAGES`
+    size_t                   m_messages_total = 0;
+    size_t                   m_messages_revision = 0;
     std::mutex               m_messages_mutex;
     Ogre::Timer              m_msg_timer;
     CVarPtrMap               m_cvars;
@@ -32,14 +32,19 @@
 #include "Language.h"
 #include "Network.h"
 #include "OverlayWrapper.h"
+#include "PlatformUtils.h"
+#include "Replay.h"
 #include "RoRnet.h"
 #include "RoRVersion.h"
 #include "ScriptEngine.h"
+#include "SimProfiler.h"
 #include "Terrain.h"
 #include "TerrainObjectManager.h"
 #include "Utils.h"
 
 #include <algorithm>
+#include <ctime>
+#include <iomanip>
 #include <Ogre.h>
 #include <fmt/core.h>
 
@@ -433,6 +438,280 @@ public:
     }
 };
 
+class SimProfilerCmd: public ConsoleCmd
+{
+public:
+    SimProfilerCmd(): ConsoleCmd("simprofiler", "[start/stop]", _L("simprofiler - records simulation zones and saves them as Chrome trace (chrome://tracing, ui.perfetto.dev)")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        Str<500> reply;
+        reply << m_name << ": ";
+        Console::MessageType reply_type = Console::CONSOLE_SYSTEM_REPLY;
+
+        if (args.size() == 2 && args[1] == "start")
+        {
+            SimProfiler::StartCapture();
+            reply << _L("capture started");
+        }
+        else if (args.size() == 2 && args[1] == "stop" && SimProfiler::IsCapturing())
+        {
+            const std::time_t time = std::time(nullptr);
+            std::stringstream filename;
+            filename << "simprofile_" << std::put_time(std::localtime(&time), "%Y-%m-%d_%H-%M-%S") << ".json";
+            CreateFolder(App::sys_profiler_dir->getStr());
+            const std::string path = PathCombine(App::sys_profiler_dir->getStr(), filename.str());
+
+            std::string summary;
+            if (SimProfiler::StopCapture(path, summary))
+            {
+                reply << _L("trace saved to ") << path;
+            }
+            else
+            {
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+                reply << _L("could not write ") << path;
+            }
+            RoR::Log(summary.c_str()); // Can be long; goes to RoR.log
+        }
+        else
+        {
+            reply_type = Console::CONSOLE_HELP;
+            reply << _L("usage: ") << m_name << " " << m_usage
+                  << (SimProfiler::IsCapturing() ? _L(" (capture running)") : "");
+        }
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, reply_type, reply.ToCStr());
+    }
+};
+
+class MemStatsCmd: public ConsoleCmd
+{
+public:
+    MemStatsCmd(): ConsoleCmd("memstats", "", _L("memstats - prints memory used by each actor and by loaded meshes and textures")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        if (!this->CheckAppState(AppState::SIMULATION))
+            return;
+
+        // Actor data is modified by the simulation thread
+        App::GetGameContext()->GetActorManager()->SyncWithSimThread();
+
+        ActorMemoryUsage total;
+        for (ActorPtr& actor: App::GetGameContext()->GetActorManager()->GetActors())
+        {
+            const ActorMemoryUsage usage = actor->GetMemoryUsage();
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+                fmt::format("memstats: #{} '{}' - {:.1f} KiB (simulation {:.1f}, replay {:.1f}, flexbodies {:.1f}, meshes {:.1f})",
+                    actor->ar_instance_id, actor->getTruckName(), usage.GetTotal() / 1024.f,
+                    usage.amu_simulation / 1024.f, usage.amu_replay / 1024.f, usage.amu_flexbodies / 1024.f, usage.amu_meshes / 1024.f));
+            total.amu_simulation += usage.amu_simulation;
+            total.amu_replay += usage.amu_replay;
+            total.amu_flexbodies += usage.amu_flexbodies;
+            total.amu_meshes += usage.amu_meshes;
+        }
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+            fmt::format("memstats: all actors - {:.1f} MiB (simulation {:.1f}, replay {:.1f}, flexbodies {:.1f}, meshes {:.1f})",
+                total.GetTotal() / 1048576.f, total.amu_simulation / 1048576.f, total.amu_replay / 1048576.f,
+                total.amu_flexbodies / 1048576.f, total.amu_meshes / 1048576.f));
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+            fmt::format("memstats: loaded meshes {:.1f} MiB, textures {:.1f} MiB",
+                Ogre::MeshManager::getSingleton().getMemoryUsage() / 1048576.f,
+                Ogre::TextureManager::getSingleton().getMemoryUsage() / 1048576.f));
+    }
+};
+
+#ifdef USE_SOCKETW
+class NetStatsCmd: public ConsoleCmd
+{
+public:
+    NetStatsCmd(): ConsoleCmd("netstats", "", _L("netstats - prints multiplayer traffic per stream")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        if (App::mp_state->getEnum<MpState>() != MpState::CONNECTED)
+        {
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_ERROR, _L("netstats: not connected"));
+            return;
+        }
+
+        const float elapsed = std::max(App::GetNetwork()->GetStreamStatsTime(), 1.f);
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+            fmt::format("netstats: {:.0f}s connected, queued packets: {} send / {} receive",
+                elapsed, App::GetNetwork()->GetSendQueueSize(), App::GetNetwork()->GetRecvQueueSize()));
+        for (NetStreamStats const& stats: App::GetNetwork()->GetStreamStats())
+        {
+            App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_REPLY,
+                fmt::format("  {} {}:{} - {:.1f} KiB ({:.2f} KiB/s avg), {} packets, largest {} B, {} dropped",
+                    (stats.outgoing ? "out" : "in "), stats.source_id, stats.stream_id,
+                    stats.num_bytes / 1024.f, stats.num_bytes / 1024.f / elapsed,
+                    stats.num_packets, stats.max_packet_size, stats.num_dropped));
+        }
+    }
+};
+
+class NetRecordCmd: public ConsoleCmd
+{
+public:
+    NetRecordCmd(): ConsoleCmd("netrecord", "[start/stop]", _L("netrecord - saves incoming multiplayer traffic for `netreplay`")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        Str<500> reply;
+        reply << m_name << ": ";
+        Console::MessageType reply_type = Console::CONSOLE_SYSTEM_REPLY;
+
+        if (args.size() == 2 && args[1] == "start" &&
+            App::mp_state->getEnum<MpState>() == MpState::CONNECTED && !App::GetNetwork()->IsPlayingBack())
+        {
+            const std::time_t time = std::time(nullptr);
+            std::stringstream filename;
+            filename << "netrecord_" << std::put_time(std::localtime(&time), "%Y-%m-%d_%H-%M-%S") << ".rornet";
+            CreateFolder(App::sys_profiler_dir->getStr());
+            const std::string path = PathCombine(App::sys_profiler_dir->getStr(), filename.str());
+
+            if (App::GetNetwork()->StartRecording(path))
+            {
+                reply << _L("recording to ") << path;
+            }
+            else
+            {
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+                reply << _L("could not write ") << path;
+            }
+        }
+        else if (args.size() == 2 && args[1] == "stop" && App::GetNetwork()->IsRecording())
+        {
+            App::GetNetwork()->StopRecording();
+            reply << _L("recording stopped");
+        }
+        else
+        {
+            reply_type = Console::CONSOLE_HELP;
+            reply << _L("usage: ") << m_name << " " << m_usage << _L(" (only while connected)")
+                  << (App::GetNetwork()->IsRecording() ? _L(" (recording)") : "");
+        }
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, reply_type, reply.ToCStr());
+    }
+};
+
+class ReplayCmd: public ConsoleCmd
+{
+public:
+    ReplayCmd(): ConsoleCmd("replay", "[record <name>/stop/play <name>]", _L("replay - saves the replays of all actors to files, or plays them back")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        if (!this->CheckAppState(AppState::SIMULATION))
+            return;
+
+        Str<500> reply;
+        reply << m_name << ": ";
+        Console::MessageType reply_type = Console::CONSOLE_SYSTEM_REPLY;
+
+        // The recorder runs on the simulation thread
+        App::GetGameContext()->GetActorManager()->SyncWithSimThread();
+        ActorPtrVec& actors = App::GetGameContext()->GetActorManager()->GetActors();
+
+        if (args.size() == 3 && args[1] == "record")
+        {
+            CreateFolder(App::sys_profiler_dir->getStr());
+            int count = 0;
+            for (ActorPtr& actor: actors)
+            {
+                if (actor->getReplay() && actor->getReplay()->StartSpill(this->GetFilename(args[2], actor)))
+                    count++;
+            }
+            reply << _L("recording actors: ") << count;
+        }
+        else if (args.size() == 2 && args[1] == "stop")
+        {
+            for (ActorPtr& actor: actors)
+            {
+                if (actor->getReplay())
+                    actor->getReplay()->StopSpill();
+            }
+            reply << _L("recording stopped");
+        }
+        else if (args.size() == 3 && args[1] == "play")
+        {
+            int count = 0;
+            for (ActorPtr& actor: actors)
+            {
+                if (actor->getReplay() && actor->getReplay()->StartPlayback(this->GetFilename(args[2], actor)))
+                {
+                    actor->ar_state = ActorState::LOCAL_REPLAY;
+                    count++;
+                }
+            }
+            if (count == 0)
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+            reply << _L("playing back actors: ") << count << _L(" (leave replay mode to stop)");
+        }
+        else
+        {
+            reply_type = Console::CONSOLE_HELP;
+            reply << _L("usage: ") << m_name << " " << m_usage;
+        }
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, reply_type, reply.ToCStr());
+    }
+
+private:
+    std::string GetFilename(std::string const& name, ActorPtr const& actor)
+    {
+        // Session files match actors by spawn order; one file per actor
+        return PathCombine(App::sys_profiler_dir->getStr(), name + "_" + TOSTRING(actor->ar_vector_index) + ".rorreplay");
+    }
+};
+
+class NetReplayCmd: public ConsoleCmd
+{
+public:
+    NetReplayCmd(): ConsoleCmd("netreplay", "[<filename>/stop]", _L("netreplay - plays back a `netrecord` file offline and reports frame times")) {}
+
+    void Run(Ogre::StringVector const& args) override
+    {
+        if (!this->CheckAppState(AppState::SIMULATION))
+            return;
+
+        Str<500> reply;
+        reply << m_name << ": ";
+        Console::MessageType reply_type = Console::CONSOLE_SYSTEM_REPLY;
+
+        if (args.size() == 2 && args[1] == "stop" && App::GetNetwork()->IsPlayingBack())
+        {
+            App::GetNetwork()->StopPlayback();
+            reply << _L("stopping");
+        }
+        else if (args.size() == 2 && App::mp_state->getEnum<MpState>() == MpState::DISABLED)
+        {
+            // Bare filenames are looked up in the profiler directory, where `netrecord` saves them
+            const std::string path = FileExists(args[1]) ? args[1] : PathCombine(App::sys_profiler_dir->getStr(), args[1]);
+            if (App::GetNetwork()->StartPlayback(path))
+            {
+                reply << _L("playing back ") << path;
+            }
+            else
+            {
+                reply_type = Console::CONSOLE_SYSTEM_ERROR;
+                reply << _L("could not read recording ") << path;
+            }
+        }
+        else
+        {
+            reply_type = Console::CONSOLE_HELP;
+            reply << _L("usage: ") << m_name << " " << m_usage << _L(" (only in singleplayer)");
+        }
+
+        App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, reply_type, reply.ToCStr());
+    }
+};
+#endif // USE_SOCKETW
+
 // -------------------------------------------------------------------------------------
 // CVar (builtin) console commmands
 
@@ -600,6 +879,7 @@ public:
         {
             Console::MsgLockGuard lock(App::GetConsole());
             lock.messages.clear();
+            lock.revision++;
         }
         else
         {
@@ -638,6 +918,7 @@ public:
             auto erase_begin = std::remove_if(lock.messages.begin(), lock.messages.end(), filter_fn);
             // Erase unwanted
             lock.messages.erase(erase_begin, lock.messages.end());
+            lock.revision++;
         }
     }
 };
@@ -666,6 +947,14 @@ void Console::regBuiltinCommands()
     // Additions
     cmd = new ClearCmd();                 m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new LoadScriptCmd();            m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new SimProfilerCmd();           m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new MemStatsCmd();              m_commands.insert(std::make_pair(cmd->getName(), cmd));
+#ifdef USE_SOCKETW
+    cmd = new NetStatsCmd();              m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new NetRecordCmd();             m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new NetReplayCmd();             m_commands.insert(std::make_pair(cmd->getName(), cmd));
+    cmd = new ReplayCmd();                m_commands.insert(std::make_pair(cmd->getName(), cmd));
+#endif // USE_SOCKETW
     // CVars
     cmd = new SetCmd();                   m_commands.insert(std::make_pair(cmd->getName(), cmd));
     cmd = new SetstringCmd();             m_commands.insert(std::make_pair(cmd->getName(), cmd));
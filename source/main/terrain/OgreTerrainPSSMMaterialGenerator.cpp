@@ -38,6 +38,8 @@ THE SOFTWARE.
 #include <OgreShadowCameraSetupPSSM.h>
 #include <OgreHighLevelGpuProgram.h>
 
+#include "ShaderCache.h"
+
 namespace Ogre {
 //---------------------------------------------------------------------
 TerrainPSSMMaterialGenerator::TerrainPSSMMaterialGenerator()
@@ -450,7 +452,10 @@ TerrainPSSMMaterialGenerator::SM2Profile::ShaderHelper::generateVertexProgram(
     StringUtil::StrStreamType sourceStr;
     generateVertexProgramSource(prof, terrain, tt, sourceStr);
     ret->setSource(sourceStr.str());
-    ret->load();
+    {
+        RoR::ShaderCacheBypass bypass; // Generated source; the name only depends on the terrain instance
+        ret->load();
+    }
     defaultVpParams(prof, terrain, tt, ret);
 #if 0
 			LogManager::getSingleton().stream(LML_TRIVIAL) << "*** Terrain Vertex Program: "
@@ -470,7 +475,10 @@ TerrainPSSMMaterialGenerator::SM2Profile::ShaderHelper::generateFragmentProgram(
     StringUtil::StrStreamType sourceStr;
     generateFragmentProgramSource(prof, terrain, tt, sourceStr);
     ret->setSource(sourceStr.str());
-    ret->load();
+    {
+        RoR::ShaderCacheBypass bypass; // Generated source; the name only depends on the terrain instance
+        ret->load();
+    }
     defaultFpParams(prof, terrain, tt, ret);
 
 #if 0
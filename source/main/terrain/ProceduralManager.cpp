@@ -23,6 +23,7 @@
 
 #include "Application.h"
 #include "ProceduralRoad.h"
+#include "ThreadPool.h"
 
 using namespace Ogre;
 using namespace RoR;
@@ -80,6 +81,12 @@ ProceduralObjectPtr ProceduralManager::getObject(int pos)
 
 void ProceduralManager::removeAllObjects()
 {
+    for (PendingBuild& pending : m_pending_builds)
+    {
+        pending.task->join();
+    }
+    m_pending_builds.clear();
+
     for (ProceduralObjectPtr obj : pObjects)
     {
         this->deleteObject(obj);
@@ -89,6 +96,8 @@ void ProceduralManager::removeAllObjects()
 
 void ProceduralManager::deleteObject(ProceduralObjectPtr po)
 {
+    this->cancelPendingBuild(po);
+
     if (po->road)
     {
         // loaded already, delete (unreference) old object
@@ -107,14 +116,9 @@ void ProceduralManager::removeObject(ProceduralObjectPtr po)
     }
 }
 
-void ProceduralManager::updateObject(ProceduralObjectPtr po)
+std::vector<ProceduralRoad::BlockParams> ProceduralManager::computeBlocks(ProceduralObjectPtr po)
 {
-    if (po->road)
-        this->deleteObject(po);
-
-    po->road = new ProceduralRoad();
-    // In diagnostic mode, disable collisions (speeds up terrain loading)
-    po->road->setCollisionEnabled(!App::diag_terrn_log_roads->getBool());
+    std::vector<ProceduralRoad::BlockParams> blocks;
 
     Ogre::SimpleSpline spline;
     if (po->smoothing_num_splits > 0)
@@ -140,7 +144,7 @@ void ProceduralManager::updateObject(ProceduralObjectPtr po)
             {
                 if (i_point == 0)
                 {
-                    po->road->addBlock(pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype);
+                    blocks.push_back({pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype});
                 }
                 else
                 {
@@ -153,17 +157,80 @@ void ProceduralManager::updateObject(ProceduralObjectPtr po)
                     const float smooth_bwidth = Math::lerp(prev_pp->bwidth, pp->bwidth, progress);
                     const float smooth_bheight = Math::lerp(prev_pp->bheight, pp->bheight, progress);
 
-                    po->road->addBlock(smooth_pos, smooth_rot, pp->type, smooth_width, smooth_bwidth, smooth_bheight, pp->pillartype);
+                    blocks.push_back({smooth_pos, smooth_rot, pp->type, smooth_width, smooth_bwidth, smooth_bheight, pp->pillartype});
                 }
             }
         }
         else
         {
             // smoothing off
-            po->road->addBlock(pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype);
+            blocks.push_back({pp->position, pp->rotation, pp->type, pp->width, pp->bwidth, pp->bheight, pp->pillartype});
         }
     }
-    po->road->finish();
+    return blocks;
+}
+
+void ProceduralManager::updateObject(ProceduralObjectPtr po)
+{
+    this->cancelPendingBuild(po);
+
+    // The points are snapshotted here, scripts may keep editing them while the build runs.
+    std::vector<ProceduralRoad::BlockParams> blocks = computeBlocks(po);
+
+    PendingBuild pending;
+    pending.po = po;
+    pending.road = new ProceduralRoad();
+    // In diagnostic mode, disable collisions (speeds up terrain loading)
+    pending.road->setCollisionEnabled(!App::diag_terrn_log_roads->getBool());
+    pending.previous = po->road;
+
+    ProceduralRoad* road = pending.road.GetRef();
+    ProceduralRoad* previous = pending.previous.GetRef();
+    pending.task = App::GetThreadPool()->RunTask([road, previous, blocks]()
+    {
+        road->buildBlocks(blocks, previous);
+    });
+    m_pending_builds.push_back(pending);
+}
+
+void ProceduralManager::cancelPendingBuild(ProceduralObjectPtr po)
+{
+    for (size_t i = 0; i < m_pending_builds.size(); i++)
+    {
+        if (m_pending_builds[i].po == po)
+        {
+            m_pending_builds[i].task->join();
+            m_pending_builds.erase(m_pending_builds.begin() + i);
+            return;
+        }
+    }
+}
+
+void ProceduralManager::updatePendingObjects()
+{
+    for (size_t i = 0; i < m_pending_builds.size(); )
+    {
+        PendingBuild& pending = m_pending_builds[i];
+        if (pending.task->is_finished())
+        {
+            pending.road->commit();
+            pending.po->road = pending.road; // Unreferences the old road, which removes its mesh and collision
+            m_pending_builds.erase(m_pending_builds.begin() + i);
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+void ProceduralManager::finishPendingObjects()
+{
+    for (PendingBuild& pending : m_pending_builds)
+    {
+        pending.task->join();
+    }
+    this->updatePendingObjects();
 }
 
 void ProceduralManager::addObject(ProceduralObjectPtr po)
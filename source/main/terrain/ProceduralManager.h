@@ -81,7 +81,7 @@ class ProceduralManager: public RefCountingObject<ProceduralManager>
 public:
     virtual ~ProceduralManager() override;
 
-    /// Generates road mesh and adds to internal list
+    /// Generates road mesh in background and adds to internal list; the mesh appears once `updatePendingObjects()` commits it
     void addObject(ProceduralObjectPtr po);
 
     /// Clears road mesh and removes from internal list
@@ -95,13 +95,32 @@ public:
 
     void removeAllObjects();
 
+    /// Commits roads whose background build has finished; call once per frame
+    void updatePendingObjects();
+
+    /// Waits for all background builds and commits them, i.e. during terrain loading
+    void finishPendingObjects();
+
 private:
-    /// Rebuilds the road mesh
+    struct PendingBuild
+    {
+        ProceduralObjectPtr   po;
+        ProceduralRoadPtr     road;     //!< Being generated by `task`
+        ProceduralRoadPtr     previous; //!< Kept alive because `task` copies unchanged segments from it
+        std::shared_ptr<Task> task;
+    };
+
+    /// Rebuilds the road mesh on the thread pool; only segments around changed points are regenerated
     void updateObject(ProceduralObjectPtr po);
     /// Deletes the road mesh
     void deleteObject(ProceduralObjectPtr po);
+    /// Waits for and discards a build superseded by a newer edit or deletion
+    void cancelPendingBuild(ProceduralObjectPtr po);
+
+    static std::vector<ProceduralRoad::BlockParams> computeBlocks(ProceduralObjectPtr po);
 
     std::vector<ProceduralObjectPtr> pObjects;
+    std::vector<PendingBuild> m_pending_builds;
 };
 
 /// @} // addtogroup Terrain
@@ -38,6 +38,12 @@ static int id_counter = 0;
 ProceduralRoad::ProceduralRoad()
 {
     mid = id_counter++;
+
+    if (App::GetGameContext()->GetTerrain())
+    {
+        m_gm_concrete = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("concrete");
+        m_gm_asphalt = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("asphalt");
+    }
 }
 
 ProceduralRoad::~ProceduralRoad()
@@ -60,11 +66,32 @@ ProceduralRoad::~ProceduralRoad()
 
 void ProceduralRoad::finish()
 {
+    this->finishGeometry();
+    this->commit();
+}
+
+void ProceduralRoad::finishGeometry()
+{
+    m_geometry_vertex_end = vertexcount;
+    m_geometry_tri_end = tricount;
+    m_geometry_coll_end = (int)m_coll_quads.size();
+
     Vector3 pts[8];
     computePoints(pts, lastpos, lastrot, lasttype, lastwidth, lastbwidth, lastbheight);
     addQuad(pts[7], pts[6], pts[5], pts[4], TextureFit::TEXFIT_NONE, lastpos, lastpos, lastwidth);
     addQuad(pts[7], pts[4], pts[3], pts[0], TextureFit::TEXFIT_NONE, lastpos, lastpos, lastwidth);
     addQuad(pts[3], pts[2], pts[1], pts[0], TextureFit::TEXFIT_NONE, lastpos, lastpos, lastwidth);
+}
+
+void ProceduralRoad::commit()
+{
+    if (m_defer_collision)
+    {
+        for (CollisionQuad const& q : m_coll_quads)
+        {
+            this->registerCollisionQuad(q);
+        }
+    }
 
     createMesh();
     String entity_name = String("RoadSystem_Instance-").append(StringConverter::toString(mid));
@@ -73,14 +100,113 @@ void ProceduralRoad::finish()
     snode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
     snode->attachObject(ec);
 
-    App::GetGameContext()->GetTerrain()->GetCollisions()->registerCollisionMesh(
-        "RoadSystem", mesh_name, 
-        ec->getBoundingBox().getCenter(), ec->getMesh()->getBounds(),
-        /*groundmodel:*/nullptr, registeredCollTris[0], (int)registeredCollTris.size());
+    if (!registeredCollTris.empty())
+    {
+        App::GetGameContext()->GetTerrain()->GetCollisions()->registerCollisionMesh(
+            "RoadSystem", mesh_name, 
+            ec->getBoundingBox().getCenter(), ec->getMesh()->getBounds(),
+            /*groundmodel:*/nullptr, registeredCollTris[0], (int)registeredCollTris.size());
+    }
+}
+
+void ProceduralRoad::buildBlocks(std::vector<BlockParams> const& blocks, ProceduralRoad* previous)
+{
+    m_defer_collision = true;
+    const int num_blocks = (int)blocks.size();
+
+    // Only blocks whose parameters changed are regenerated, plus the block following the last change
+    // because each block is stitched to its predecessor. Edits which add or remove points rebuild everything.
+    int rebuild_begin = 0;
+    int rebuild_end = num_blocks;
+    if (previous && previous->collision == collision && (int)previous->m_blocks.size() == num_blocks)
+    {
+        while (rebuild_begin < num_blocks && blocks[rebuild_begin] == previous->m_blocks[rebuild_begin].params)
+            rebuild_begin++;
+        int last_changed = num_blocks - 1;
+        while (last_changed >= rebuild_begin && blocks[last_changed] == previous->m_blocks[last_changed].params)
+            last_changed--;
+        rebuild_end = std::min(last_changed + 2, num_blocks);
+
+        this->copyBlocks(*previous, 0, rebuild_begin);
+    }
+    else
+    {
+        previous = nullptr;
+    }
+
+    for (int i = rebuild_begin; i < num_blocks; i++)
+    {
+        // Keep going past the changed range if the monorail pillar pattern shifted
+        if (previous && i >= rebuild_end && m_pillar_counter == previous->m_blocks[i - 1].pillar_counter)
+        {
+            this->copyBlocks(*previous, i, num_blocks);
+            break;
+        }
+        BlockParams const& b = blocks[i];
+        this->addBlock(b.pos, b.rot, b.type, b.width, b.bwidth, b.bheight, b.pillartype);
+    }
+
+    this->finishGeometry();
+}
+
+void ProceduralRoad::copyBlocks(ProceduralRoad const& src, int begin, int end)
+{
+    if (begin >= end)
+        return;
+
+    const int num_src_blocks = (int)src.m_blocks.size();
+    const int vertex_begin = src.m_blocks[begin].vertex_start;
+    const int vertex_end = (end < num_src_blocks) ? src.m_blocks[end].vertex_start : src.m_geometry_vertex_end;
+    const int tri_begin = src.m_blocks[begin].tri_start;
+    const int tri_end = (end < num_src_blocks) ? src.m_blocks[end].tri_start : src.m_geometry_tri_end;
+    const int coll_begin = src.m_blocks[begin].coll_start;
+    const int coll_end = (end < num_src_blocks) ? src.m_blocks[end].coll_start : src.m_geometry_coll_end;
+
+    if (vertexcount + (vertex_end - vertex_begin) >= (int)MAX_VERTEX || (tricount + (tri_end - tri_begin)) * 3 >= (int)MAX_TRIS * 3)
+        return;
+
+    const int vertex_offset = vertexcount - vertex_begin;
+    const int tri_offset = tricount - tri_begin;
+    const int coll_offset = (int)m_coll_quads.size() - coll_begin;
+
+    std::copy(src.vertex + vertex_begin, src.vertex + vertex_end, vertex + vertexcount);
+    std::copy(src.tex + vertex_begin, src.tex + vertex_end, tex + vertexcount);
+    for (int i = tri_begin * 3; i < tri_end * 3; i++)
+    {
+        tris[i + tri_offset * 3] = static_cast<uint16_t>(src.tris[i] + vertex_offset);
+    }
+    m_coll_quads.insert(m_coll_quads.end(), src.m_coll_quads.begin() + coll_begin, src.m_coll_quads.begin() + coll_end);
+    vertexcount += vertex_end - vertex_begin;
+    tricount += tri_end - tri_begin;
+
+    for (int i = begin; i < end; i++)
+    {
+        BlockRecord record = src.m_blocks[i];
+        record.vertex_start += vertex_offset;
+        record.tri_start += tri_offset;
+        record.coll_start += coll_offset;
+        m_blocks.push_back(record);
+    }
+
+    BlockRecord const& last = src.m_blocks[end - 1];
+    lastpos = last.resolved.pos;
+    lastrot = last.resolved.rot;
+    lasttype = last.resolved.type;
+    lastwidth = last.resolved.width;
+    lastbwidth = last.resolved.bwidth;
+    lastbheight = last.resolved.bheight;
+    m_pillar_counter = last.pillar_counter;
+    first = false;
 }
 
 void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float width, float bwidth, float bheight, int pillartype)
 {
+    BlockRecord record;
+    record.params = { pos, rot, type, width, bwidth, bheight, pillartype };
+    record.vertex_start = vertexcount;
+    record.tri_start = tricount;
+    record.coll_start = (int)m_coll_quads.size();
+
     if (type == RoadType::ROAD_AUTOMATIC)
     {
         width = 10.0;
@@ -185,15 +311,14 @@ void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float
                     sidefactor = 0.2;
             }
 
-            static int pillarcounter = 0;
-            pillarcounter++;
+            m_pillar_counter++;
 
             if (pillartype == 2)
             {
                 // always in the middle
                 sidefactor = 0.5;
                 // only build every fifth pillar
-                if (pillarcounter % 5)
+                if (m_pillar_counter % 5)
                     builtpillars = false;
             }
 
@@ -257,6 +382,10 @@ void ProceduralRoad::addBlock(Vector3 pos, Quaternion rot, RoadType type, float
     lastbheight = bheight;
     lasttype = type;
 
+    record.resolved = { pos, rot, type, width, bwidth, bheight, pillartype };
+    record.pillar_counter = m_pillar_counter;
+    m_blocks.push_back(record);
+
     if (App::diag_terrn_log_roads->getBool())
     {
         Str<2000> msg; msg << "[RoR] Road Block |";
@@ -392,9 +521,9 @@ void ProceduralRoad::addQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, Tex
     }
     if (collision)
     {
-        ground_model_t* gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("concrete");
+        ground_model_t* gm = m_gm_concrete;
         if (texfit == TextureFit::TEXFIT_ROAD || texfit == TextureFit::TEXFIT_ROADS1 || texfit == TextureFit::TEXFIT_ROADS2 || texfit == TextureFit::TEXFIT_ROADS3 || texfit == TextureFit::TEXFIT_ROADS4)
-            gm = App::GetGameContext()->GetTerrain()->GetCollisions()->getGroundModelByString("asphalt");
+            gm = m_gm_asphalt;
         addCollisionQuad(p1, p2, p3, p4, gm, flip);
     }
     tricount += 2;
@@ -537,25 +666,34 @@ void ProceduralRoad::textureFit(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4,
 }
 
 void ProceduralRoad::addCollisionQuad(Vector3 p1, Vector3 p2, Vector3 p3, Vector3 p4, ground_model_t* gm, bool flip)
+{
+    CollisionQuad q = { p1, p2, p3, p4, gm, flip };
+    if (m_defer_collision)
+        m_coll_quads.push_back(q);
+    else
+        this->registerCollisionQuad(q);
+}
+
+void ProceduralRoad::registerCollisionQuad(CollisionQuad const& q)
 {
     int triID = 0;
-    if (flip)
+    if (q.flip)
     {
-        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(p1, p2, p4, gm);
+        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(q.p1, q.p2, q.p4, q.gm);
         if (triID >= 0)
             registeredCollTris.push_back(triID);
 
-        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(p4, p2, p3, gm);
+        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(q.p4, q.p2, q.p3, q.gm);
         if (triID >= 0)
             registeredCollTris.push_back(triID);
     }
     else
     {
-        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(p1, p2, p3, gm);
+        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(q.p1, q.p2, q.p3, q.gm);
         if (triID >= 0)
             registeredCollTris.push_back(triID);
 
-        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(p1, p3, p4, gm);
+        triID = App::GetGameContext()->GetTerrain()->GetCollisions()->addCollisionTri(q.p1, q.p3, q.p4, q.gm);
         if (triID >= 0)
             registeredCollTris.push_back(triID);
     }
@@ -61,9 +61,33 @@ class ProceduralRoad : public RefCountingObject<ProceduralRoad>
 {
 public:
 
+    /// Arguments of one `addBlock()` call.
+    struct BlockParams
+    {
+        Ogre::Vector3 pos;
+        Ogre::Quaternion rot;
+        RoadType type;
+        float width;
+        float bwidth;
+        float bheight;
+        int pillartype;
+
+        bool operator==(BlockParams const& o) const
+        {
+            return pos == o.pos && rot == o.rot && type == o.type && width == o.width
+                && bwidth == o.bwidth && bheight == o.bheight && pillartype == o.pillartype;
+        }
+    };
+
     ProceduralRoad();
     virtual ~ProceduralRoad() override;
 
+    /// Generates the geometry without touching Ogre or the collision grid, so it can run on a worker thread;
+    /// collision is queued until `commit()`. Blocks which equal those of `previous` are copied instead of regenerated.
+    void buildBlocks(std::vector<BlockParams> const& blocks, ProceduralRoad* previous);
+    /// Creates the mesh and registers the collision; main thread only. `finish()` does both steps at once.
+    void commit();
+
     void addBlock(Ogre::Vector3 pos, Ogre::Quaternion rot, RoadType type, float width, float bwidth, float bheight, int pillartype = 1);
     /**
      * @param p1 Top left point.
@@ -81,6 +105,27 @@ public:
 
 private:
 
+    struct CollisionQuad
+    {
+        Ogre::Vector3 p1, p2, p3, p4;
+        ground_model_t* gm;
+        bool flip;
+    };
+
+    /// Bookkeeping of one `addBlock()` call, for splicing unchanged blocks in `buildBlocks()`.
+    struct BlockRecord
+    {
+        BlockParams params;   //!< As passed to `addBlock()`
+        BlockParams resolved; //!< Automatic type and monorail offset applied; becomes the `last*` state
+        int vertex_start;
+        int tri_start;
+        int coll_start;
+        int pillar_counter;   //!< Value after the block
+    };
+
+    void finishGeometry();
+    void copyBlocks(ProceduralRoad const& src, int begin, int end); //!< Appends `src` blocks [begin, end) with indices rebased
+    void registerCollisionQuad(CollisionQuad const& q);
     inline Ogre::Vector3 baseOf(Ogre::Vector3 p);
     void computePoints(Ogre::Vector3* pts, Ogre::Vector3 pos, Ogre::Quaternion rot, RoadType type, float width, float bwidth, float bheight);
     void textureFit(Ogre::Vector3 p1, Ogre::Vector3 p2, Ogre::Vector3 p3, Ogre::Vector3 p4, TextureFit texfit, Ogre::Vector2* texc, Ogre::Vector3 pos, Ogre::Vector3 lastpos, float width);
@@ -112,6 +157,16 @@ private:
     int mid = 0;
     bool collision = true; //!< Register collision triangles?
     std::vector<int> registeredCollTris;
+
+    ground_model_t* m_gm_concrete = nullptr;   //!< Resolved at construction so generation doesn't query `Collisions`
+    ground_model_t* m_gm_asphalt = nullptr;
+    int m_pillar_counter = 0;                  //!< For monorail pillars, which are only built every fifth block
+    bool m_defer_collision = false;            //!< Queue collision in `m_coll_quads` instead of registering it
+    std::vector<CollisionQuad> m_coll_quads;
+    std::vector<BlockRecord> m_blocks;
+    int m_geometry_vertex_end = 0;             //!< Counts before the end cap added by `finishGeometry()`
+    int m_geometry_tri_end = 0;
+    int m_geometry_coll_end = 0;
 };
 
 /// @} // addtogroup Terrain
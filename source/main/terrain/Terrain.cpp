@@ -496,11 +496,21 @@ float RoR::Terrain::GetHeightAt(float x, float z)
     return m_geometry_manager->getHeightAt(x, z);
 }
 
+void RoR::Terrain::GetHeightsAt(const Ogre::Vector3* positions, size_t count, size_t stride, float* out_heights)
+{
+    m_geometry_manager->getHeightsAt(positions, count, stride, out_heights);
+}
+
 Ogre::Vector3 RoR::Terrain::GetNormalAt(float x, float y, float z)
 {
     return m_geometry_manager->getNormalAt(x, y, z);
 }
 
+float RoR::Terrain::GetHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal)
+{
+    return m_geometry_manager->getHeightAndNormalAt(x, z, out_normal);
+}
+
 SkyManager* RoR::Terrain::getSkyManager()
 {
     return m_sky_manager;
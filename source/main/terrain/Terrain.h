@@ -95,7 +95,9 @@ public:
     void                    setGravity(float value);
     float                   getGravity() const            { return m_cur_gravity; }
     float                   GetHeightAt(float x, float z);
+    void                    GetHeightsAt(const Ogre::Vector3* positions, size_t count, size_t stride, float* out_heights); //!< Batched `GetHeightAt()`, see `TerrainGeometryManager::getHeightsAt()`
     Ogre::Vector3           GetNormalAt(float x, float y, float z);
+    float                   GetHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal); //!< See `TerrainGeometryManager::getHeightAndNormalAt()`
     Ogre::Vector3           getMaxTerrainSize();
     Ogre::AxisAlignedBox    getTerrainCollisionAAB();
     /// @}
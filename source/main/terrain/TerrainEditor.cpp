@@ -150,6 +150,7 @@ void TerrainEditor::UpdateInputEvents(float dt)
     }
     if (m_object_index != -1 && update)
     {
+        App::GetGameContext()->GetTerrain()->getObjectManager()->BreakStaticBatch(object_list[m_object_index].node);
         String ssmsg = _L("Selected object: [") + TOSTRING(m_object_index) + "/" + TOSTRING(object_list.size()) + "] (" + object_list[m_object_index].name + ")";
         App::GetConsole()->putMessage(Console::CONSOLE_MSGTYPE_INFO, Console::CONSOLE_SYSTEM_NOTICE, ssmsg, "information.png");
         if (m_object_tracking)
@@ -162,7 +163,7 @@ void TerrainEditor::UpdateInputEvents(float dt)
         SceneNode* sn = object_list[m_object_index].node;
 
         object_list[m_object_index].position = object_list[m_object_index].initial_position;
-        sn->setPosition(object_list[m_object_index].position);
+        this->MoveSelectedObject(object_list[m_object_index].position);
 
         object_list[m_object_index].rotation = object_list[m_object_index].initial_rotation;
         Vector3 rot = object_list[m_object_index].rotation;
@@ -216,7 +217,7 @@ void TerrainEditor::UpdateInputEvents(float dt)
             scale *= App::GetInputEngine()->isKeyDown(OIS::KC_LCONTROL) ? 10.0f : 1.0f;
 
             object_list[m_object_index].position += translation * scale * dt;
-            sn->setPosition(object_list[m_object_index].position);
+            this->MoveSelectedObject(object_list[m_object_index].position);
 
             object_list[m_object_index].rotation[m_rotation_axis] += rotation * scale * dt;
             Vector3 rot = object_list[m_object_index].rotation;
@@ -231,7 +232,7 @@ void TerrainEditor::UpdateInputEvents(float dt)
         else if (m_object_tracking && App::GetGameContext()->GetPlayerCharacter()->getPosition() != sn->getPosition())
         {
             object_list[m_object_index].position = App::GetGameContext()->GetPlayerCharacter()->getPosition();
-            sn->setPosition(App::GetGameContext()->GetPlayerCharacter()->getPosition());
+            this->MoveSelectedObject(object_list[m_object_index].position);
         }
         if (App::GetInputEngine()->getEventBoolValue(EV_COMMON_REMOVE_CURRENT_TRUCK))
         {
@@ -317,6 +318,16 @@ void TerrainEditor::WriteOutputFile()
     }
 }
 
+void TerrainEditor::MoveSelectedObject(Ogre::Vector3 const& pos)
+{
+    auto& object_list = App::GetGameContext()->GetTerrain()->getObjectManager()->GetEditorObjects();
+    if (!App::GetGameContext()->GetTerrain()->getObjectManager()->MoveObject(object_list[m_object_index].instance_name, pos))
+    {
+        // Instance names aren't unique (i.e. objects spawned from console); move at least the visuals
+        object_list[m_object_index].node->setPosition(pos);
+    }
+}
+
 void TerrainEditor::ClearSelection()
 {
     m_object_index = -1;
@@ -41,6 +41,8 @@ public:
     void ClearSelection();
 
 private:
+    void                MoveSelectedObject(Ogre::Vector3 const& pos); //!< Moves the collision along, see `TerrainObjectManager::MoveObject()`
+
     bool                m_object_tracking = true;
     int                 m_rotation_axis = 1;        //!< 0=X, 1=Y, 2=Z
     std::string         m_last_object_name;
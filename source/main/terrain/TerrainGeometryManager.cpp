@@ -23,6 +23,7 @@
 
 #include "Actor.h"
 #include "Application.h"
+#include "CameraManager.h"
 #include "ContentManager.h"
 #include "Language.h"
 #include "GfxScene.h"
@@ -36,11 +37,16 @@
 #include <OgreLight.h>
 #include <Terrain/OgreTerrainGroup.h>
 
+#include <algorithm>
+
 using namespace Ogre;
 using namespace RoR;
 
 #define CUSTOM_MAT_PROFILE_NAME "Terrn2CustomMat"
 
+static const int   PAGING_MAX_PENDING_LOADS = 2;     // Keep the load queue short, so the nearest missing pages are always requested next
+static const float PAGING_UNLOAD_HYSTERESIS = 1.25f; // Pages unload a bit further out than they load, to avoid thrashing at the border
+
 /// @author: http://www.ogre3d.org/forums/viewtopic.php?f=5&t=72455
 class Terrn2CustomMaterial : public Ogre::TerrainMaterialGenerator
 {
@@ -155,7 +161,7 @@ TerrainGeometryManager::~TerrainGeometryManager()
 }
 
 /// @author Ported from OGRE engine, www.ogre3d.org, file OgreTerrain.cpp
-float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
+float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y, Ogre::Vector3* out_plane_normal/*=nullptr*/)
 {
     // get left / bottom points (rounded down)
     Real factor = (Real)mSize - 1.0f;
@@ -224,6 +230,11 @@ float TerrainGeometryManager::getHeightAtTerrainPosition(Real x, Real y)
         }
     }
 
+    if (out_plane_normal)
+    {
+        *out_plane_normal = normal;
+    }
+
     // Solve plane equation for z
     return (-normal.x * x - normal.y * y - d) / normal.z;
 }
@@ -244,11 +255,67 @@ float TerrainGeometryManager::getHeightAt(float x, float z)
     return getHeightAtTerrainPosition(tx, ty);
 }
 
+void TerrainGeometryManager::getHeightsAt(const Ogre::Vector3* positions, size_t count, size_t stride, float* out_heights)
+{
+    if (m_spec->is_flat)
+    {
+        std::fill(out_heights, out_heights + count, 0.0f);
+        return;
+    }
+
+    // Same as `getHeightAt()`, with the per-terrain values computed once
+    const float inv_x = 1.0f / ((mSize - 1) *  mScale);
+    const float inv_z = 1.0f / ((mSize - 1) * -mScale);
+    const float offset_x = -mBase - mPos.x;
+    const float offset_z =  mBase - mPos.z;
+    const float outside_height = terrainManager->GetDef().water_bottom_height;
+    const char* pos_ptr = reinterpret_cast<const char*>(positions);
+    for (size_t i = 0; i < count; i++, pos_ptr += stride)
+    {
+        const Ogre::Vector3& pos = *reinterpret_cast<const Ogre::Vector3*>(pos_ptr);
+        float tx = (pos.x + offset_x) * inv_x;
+        float ty = (pos.z + offset_z) * inv_z;
+
+        if (tx <= 0.0f || ty <= 0.0f || tx >= 1.0f || ty >= 1.0f)
+            out_heights[i] = outside_height;
+        else if (mIsFlat)
+            out_heights[i] = mMinHeight;
+        else
+            out_heights[i] = getHeightAtTerrainPosition(tx, ty);
+    }
+}
+
+float TerrainGeometryManager::getHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal)
+{
+    out_normal = Vector3::UNIT_Y;
+    if (m_spec->is_flat)
+        return 0.0f;
+
+    const float size_x = (mSize - 1) *  mScale;
+    const float size_z = (mSize - 1) * -mScale;
+    float tx = (x - mBase - mPos.x) / size_x;
+    float ty = (z + mBase - mPos.z) / size_z;
+
+    if (tx <= 0.0f || ty <= 0.0f || tx >= 1.0f || ty >= 1.0f)
+        return terrainManager->GetDef().water_bottom_height;
+    else if (mIsFlat)
+        return mMinHeight;
+
+    Vector3 plane_normal;
+    const float height = getHeightAtTerrainPosition(tx, ty, &plane_normal);
+
+    // The height is linear within the triangle; convert its slope from terrain space (0-1) to world space
+    const float slope_x = -plane_normal.x / (plane_normal.z * size_x);
+    const float slope_z = -plane_normal.y / (plane_normal.z * size_z);
+    out_normal = Vector3(-slope_x, 1.0f, -slope_z);
+    out_normal.normalise();
+    return height;
+}
+
 Ogre::Vector3 TerrainGeometryManager::getNormalAt(float x, float y, float z)
 {
-    const float precision = 0.1f;
-    Vector3 normal(getHeightAt(x - precision, z) - y, precision, y - getHeightAt(x, z + precision));
-    normal.normalise();
+    Vector3 normal;
+    this->getHeightAndNormalAt(x, z, normal);
     return normal;
 }
 
@@ -324,9 +391,24 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
         this->SetupGeometry(page, m_spec->is_flat);
     }
 
-    // sync load since we want everything in place when we start
+    // Streaming needs every page in the cache; freshly imported pages need their blendmaps set up and saved,
+    // so the first load of a terrain always loads everything.
+    m_paging_enabled = App::gfx_terrain_page_distance->getFloat() > 0.f && !m_was_new_geometry_generated;
+
     App::GetGuiManager()->LoadingWindow.SetProgress(44, _L("Loading terrain pages ..."));
-    m_ogre_terrain_group->loadAllTerrains(true);
+    if (m_paging_enabled)
+    {
+        // Only the page with the collision heights in sync, the rest is streamed in by `UpdatePaging()`
+        if (m_ogre_terrain_group->getTerrainSlot(0, 0) != nullptr)
+        {
+            m_ogre_terrain_group->loadTerrain(0, 0, /*synchronous=*/true);
+        }
+    }
+    else
+    {
+        // sync load since we want everything in place when we start
+        m_ogre_terrain_group->loadAllTerrains(true);
+    }
 
     Ogre::Terrain* terrain = m_ogre_terrain_group->getTerrain(0, 0);
 
@@ -387,18 +469,119 @@ bool TerrainGeometryManager::InitTerrain(std::string otc_filename)
 
 void TerrainGeometryManager::updateLightMap()
 {
+    // Pages still waiting keep their place; the others were lit by the old sun and go to the back, nearest first.
+    const Vector3 focus = App::GetCameraManager()->GetCameraNode()->_getDerivedPosition();
+    std::vector<std::pair<float, std::pair<long, long>>> pages;
     TerrainGroup::TerrainIterator ti = m_ogre_terrain_group->getTerrainIterator();
-
     while (ti.hasMoreElements())
     {
-        Ogre::Terrain* terrain = ti.getNext()->instance;
-        if (!terrain)
+        TerrainGroup::TerrainSlot* slot = ti.getNext();
+        if (!slot->instance || !slot->instance->isLoaded())
             continue;
 
-        if (!terrain->isDerivedDataUpdateInProgress())
+        const std::pair<long, long> pos(slot->x, slot->y);
+        if (std::find(m_lightmap_queue.begin(), m_lightmap_queue.end(), pos) != m_lightmap_queue.end())
+            continue;
+
+        Vector3 offset = slot->instance->getPosition() - focus;
+        offset.y = 0.f;
+        pages.push_back(std::make_pair(offset.squaredLength(), pos));
+    }
+
+    std::sort(pages.begin(), pages.end());
+    for (auto& page : pages)
+    {
+        m_lightmap_queue.push_back(page.second);
+    }
+}
+
+void TerrainGeometryManager::ProcessLightmapQueue()
+{
+    if (m_lightmap_busy)
+    {
+        Ogre::Terrain* terrain = m_ogre_terrain_group->getTerrain(m_lightmap_slot.first, m_lightmap_slot.second);
+        if (terrain && terrain->isLoaded() && terrain->isDerivedDataUpdateInProgress())
+            return; // One page at a time - the finished lightmap is uploaded (and the composite map re-rendered) on the main thread
+
+        m_lightmap_busy = false;
+    }
+
+    while (!m_lightmap_queue.empty())
+    {
+        const std::pair<long, long> pos = m_lightmap_queue.front();
+        m_lightmap_queue.pop_front();
+
+        Ogre::Terrain* terrain = m_ogre_terrain_group->getTerrain(pos.first, pos.second);
+        if (!terrain || !terrain->isLoaded())
+            continue; // Unloaded by paging meanwhile
+
+        if (terrain->isDerivedDataUpdateInProgress())
+        {
+            m_lightmap_queue.push_back(pos); // Still finishing its load; retry later
+            return;
+        }
+
+        // Normals and deltas don't depend on the sun; only the lightmap is recomputed.
+        terrain->dirtyLightmap();
+        terrain->updateDerivedData(/*synchronous=*/false, Ogre::Terrain::DERIVED_DATA_LIGHTMAP);
+        m_lightmap_slot = pos;
+        m_lightmap_busy = true;
+        return;
+    }
+}
+
+void TerrainGeometryManager::UpdatePaging(Ogre::Vector3 const& focus)
+{
+    if (!m_paging_enabled)
+        return;
+
+    struct PageDistance
+    {
+        OTCPage*       page;
+        float          distance; //!< From `focus` to the page's edge, 0 if inside
+        Ogre::Terrain* terrain;  //!< Null if not loaded; `isLoaded()` is false while loading in the background
+    };
+
+    std::vector<PageDistance> pages;
+    pages.reserve(m_spec->pages.size());
+    const float half_size = m_spec->world_size * 0.5f;
+    int num_pending = 0;
+    for (OTCPage& page : m_spec->pages)
+    {
+        Vector3 center;
+        m_ogre_terrain_group->convertTerrainSlotToWorldPosition(page.pos_x, page.pos_z, &center);
+        const float dx = std::max(0.f, std::abs(focus.x - center.x) - half_size);
+        const float dz = std::max(0.f, std::abs(focus.z - center.z) - half_size);
+        Ogre::Terrain* terrain = m_ogre_terrain_group->getTerrain(page.pos_x, page.pos_z);
+        if (terrain && !terrain->isLoaded())
+        {
+            num_pending++;
+        }
+        pages.push_back({&page, std::sqrt(dx * dx + dz * dz), terrain});
+    }
+    std::sort(pages.begin(), pages.end(), [](PageDistance const& a, PageDistance const& b) { return a.distance < b.distance; });
+
+    const float load_distance = App::gfx_terrain_page_distance->getFloat();
+    const int max_pages = App::gfx_terrain_max_pages->getInt();
+    int num_wanted = 0;
+    for (PageDistance& p : pages)
+    {
+        // The page at (0,0) holds the collision heights, see `InitTerrain()`; it stays loaded.
+        const bool is_collision_page = (p.page->pos_x == 0 && p.page->pos_z == 0);
+        const bool within_budget = (max_pages <= 0 || num_wanted < max_pages);
+        if (is_collision_page || (p.distance <= load_distance && within_budget))
+        {
+            num_wanted++;
+            if (p.terrain == nullptr && num_pending < PAGING_MAX_PENDING_LOADS)
+            {
+                m_ogre_terrain_group->loadTerrain(p.page->pos_x, p.page->pos_z, /*synchronous=*/false);
+                num_pending++;
+            }
+        }
+        else if (p.terrain != nullptr && p.terrain->isLoaded() &&
+                 (!within_budget || p.distance > load_distance * PAGING_UNLOAD_HYSTERESIS))
         {
-            terrain->dirtyLightmap();
-            terrain->updateDerivedData();
+            m_ogre_terrain_group->unloadTerrain(p.page->pos_x, p.page->pos_z);
         }
     }
 }
@@ -414,6 +597,7 @@ void TerrainGeometryManager::UpdateMainLightPosition()
     }
     terrainOptions->setCompositeMapAmbient(App::GetGfxScene()->GetSceneManager()->getAmbientLight());
 
+    this->ProcessLightmapQueue();
     m_ogre_terrain_group->update();
 }
 
@@ -494,7 +678,8 @@ void TerrainGeometryManager::configureTerrainDefaults()
 
     if (custom_mat.empty())
     {
-        if (matProfile->getReceiveDynamicShadowsPSSM())
+        if (matProfile->getReceiveDynamicShadowsPSSM() &&
+            !terrainManager->getShadowManager()->IsTerrainShadowFromLightmap(matProfile))
         {
             terrainOptions->setCastsDynamicShadows(true);
         }
@@ -29,6 +29,9 @@
 #include <Terrain/OgreTerrain.h>
 #include <Terrain/OgreTerrainGroup.h>
 
+#include <deque>
+#include <utility>
+
 namespace RoR {
 
 /// @addtogroup Terrain
@@ -47,18 +50,31 @@ public:
 
     float getHeightAt(float x, float z);
 
-    Ogre::Vector3 getNormalAt(float x, float y, float z);
+    /// Same as `getHeightAt()` for many positions at once; `stride` is the distance in bytes
+    /// between consecutive positions, so it can read i.e. `node_t::AbsPosition` in place.
+    void getHeightsAt(const Ogre::Vector3* positions, size_t count, size_t stride, float* out_heights);
+
+    /// Height and surface normal from a single heightmap cell; the normal is the exact slope of the terrain triangle.
+    float getHeightAndNormalAt(float x, float z, Ogre::Vector3& out_normal);
+
+    Ogre::Vector3 getNormalAt(float x, float y, float z); //!< `y` is unused, kept for compatibility; see `getHeightAndNormalAt()`
 
     Ogre::Vector3 getMaxTerrainSize();
 
     bool isFlat() { return mIsFlat; };
 
-    void UpdateMainLightPosition();
+    void UpdateMainLightPosition(); //!< Call every frame; also hands queued pages to the lightmap update, see `updateLightMap()`
+    /// Queues the loaded pages for a lightmap update after the sun moved, nearest first.
+    /// Pages are updated one at a time by Ogre's background workers; each keeps showing
+    /// its old lightmap until the new one is finished.
     void updateLightMap();
 
+    /// Streams pages in (nearest first) and out around `focus`; only when 'gfx_terrain_page_distance' was set at terrain load.
+    void UpdatePaging(Ogre::Vector3 const& focus);
+
 private:
 
-    float getHeightAtTerrainPosition(float x, float z);
+    float getHeightAtTerrainPosition(float x, float z, Ogre::Vector3* out_plane_normal = nullptr); //!< Plane normal is in terrain space (x, z, height)
 
     bool getTerrainImage(int x, int y, Ogre::Image& img);
     bool loadTerrainConfig(Ogre::String filename);
@@ -68,11 +84,16 @@ private:
     void initTerrain();
     void SetupLayers(RoR::OTCPage& page, Ogre::Terrain *terrain);
     Ogre::DataStreamPtr getPageConfig(int x, int z);
+    void ProcessLightmapQueue();
 
     std::shared_ptr<RoR::OTCFile> m_spec;
     RoR::Terrain*      terrainManager;
     Ogre::TerrainGroup*  m_ogre_terrain_group;
     bool                 m_was_new_geometry_generated;
+    bool                 m_paging_enabled = false;
+    std::deque<std::pair<long, long>> m_lightmap_queue; //!< Terrain slots waiting for a lightmap update
+    std::pair<long, long> m_lightmap_slot;              //!< Page being updated, if `m_lightmap_busy`
+    bool                 m_lightmap_busy = false;
 
     // Terrn position lookup - ported from OGRE engine.
     Ogre::Vector3 mPos = Ogre::Vector3::ZERO;
@@ -39,12 +39,15 @@
 #include "SoundScriptManager.h"
 #include "TerrainGeometryManager.h"
 #include "Terrain.h"
+#include "ThreadPool.h"
 #include "TObjFileFormat.h"
 #include "Utils.h"
 #include "WriteTextToTexture.h"
 
 #include <RTShaderSystem/OgreRTShaderSystem.h>
 #include <Overlay/OgreFontManager.h>
+#include <random>
+#include <set>
 
 #ifdef USE_ANGELSCRIPT
 #    include "ExtinguishableFireAffector.h"
@@ -62,6 +65,11 @@ inline float getTerrainHeight(Real x, Real z, void* unused = 0)
     return App::GetGameContext()->GetTerrain()->GetHeightAt(x, z);
 }
 
+#ifdef USE_PAGED
+static const int   PAGED_PREFETCH_NUM_PAGES  = 3;     //!< How many pages beyond the load range are preloaded in the direction of travel
+static const float PAGED_PREFETCH_MIN_SPEED  = 20.f;  //!< m/s; slower movement loads few enough pages per frame
+#endif //USE_PAGED
+
 TerrainObjectManager::TerrainObjectManager(Terrain* terrainManager) :
     terrainManager(terrainManager)
 {
@@ -75,6 +83,10 @@ TerrainObjectManager::TerrainObjectManager(Terrain* terrainManager) :
 
 TerrainObjectManager::~TerrainObjectManager()
 {
+    for (auto& batch : m_static_batches)
+    {
+        App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry(batch.second.geometry);
+    }
     for (MeshObject* mo : m_mesh_objects)
     {
         if (mo)
@@ -149,15 +161,25 @@ void GenerateGridAndPutToScene(Ogre::Vector3 position)
 
 void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
 {
-    std::shared_ptr<TObjFile> tobj;
+    // Parsed TOBJ and collision meshes are cached per terrain bundle version
+    const CacheEntry* terrn_entry = terrainManager->getCacheEntry();
+    const std::string cache_key = fmt::format("{}|{}|{}", terrn_entry->fname, terrn_entry->filetime, tobj_name);
+    const std::string cache_hash = HashData(cache_key.c_str(), (int)cache_key.length());
+    const std::string tobj_cache_path = PathCombine(App::sys_cache_dir->getStr(), fmt::format("tobj_{}.dat", cache_hash));
+
+    std::shared_ptr<TObjFile> tobj = std::make_shared<TObjFile>();
     try
     {
-        DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
-            tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
-        TObjParser parser;
-        parser.Prepare();
-        parser.ProcessOgreStream(stream_ptr.get());
-        tobj = parser.Finalize();
+        if (!LoadTObjCache(tobj_cache_path, *tobj))
+        {
+            DataStreamPtr stream_ptr = ResourceGroupManager::getSingleton().openResource(
+                tobj_name, Ogre::ResourceGroupManager::AUTODETECT_RESOURCE_GROUP_NAME);
+            TObjParser parser;
+            parser.Prepare();
+            parser.ProcessOgreStream(stream_ptr.get());
+            tobj = parser.Finalize();
+            SaveTObjCache(tobj_cache_path, *tobj);
+        }
     }
     catch (Ogre::Exception& e)
     {
@@ -173,6 +195,10 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     int mapsizex = terrainManager->getGeometryManager()->getMaxTerrainSize().x;
     int mapsizez = terrainManager->getGeometryManager()->getMaxTerrainSize().z;
 
+    // Collision meshes of trees and objects are built together at the end, or read from the cache
+    const std::string collmesh_cache_path = PathCombine(App::sys_cache_dir->getStr(), fmt::format("collmesh_{}.dat", cache_hash));
+    terrainManager->GetCollisions()->beginCollisionMeshBatch(collmesh_cache_path);
+
     // Section 'grid'
     if (tobj->grid_enabled)
     {
@@ -212,6 +238,7 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     {
         m_procedural_manager->addObject(po);
     }
+    m_procedural_manager->finishPendingObjects();
 
     // Vehicles
     for (TObjVehicle veh : tobj->vehicles)
@@ -241,10 +268,16 @@ void TerrainObjectManager::LoadTObjFile(Ogre::String tobj_name)
     }
 
     // Entries
+    this->PrefetchODefs(tobj->objects);
+    m_collect_static_batch_candidates = true;
     for (TObjEntry entry : tobj->objects)
     {
         this->LoadTerrainObject(entry.odef_name, entry.position, entry.rotation, entry.instance_name, entry.type, entry.rendering_distance);
     }
+    m_collect_static_batch_candidates = false;
+    this->BuildStaticBatches();
+
+    terrainManager->GetCollisions()->endCollisionMeshBatch();
 
     if (App::diag_terrn_log_roads->getBool())
     {
@@ -298,9 +331,11 @@ void TerrainObjectManager::ProcessTree(
         max = 10;
 
     // Check if farther details level is greater than closer
+    float far_range = min;
     if (max / 10 > min / 2)
     {
         geom->addDetailLevel<ImpostorPage>(max, max / 10);
+        far_range = max;
     }
 
     TreeLoader2D *treeLoader = new TreeLoader2D(geom, TBounds(0, 0, mapsizex, mapsizez));
@@ -315,65 +350,82 @@ void TerrainObjectManager::ProcessTree(
 
     Entity* curTree = App::GetGfxScene()->GetSceneManager()->createEntity(String("paged_") + treemesh + TOSTRING(m_paged_geometry.size()), treemesh);
 
-    if (gridspacing > 0)
+    struct TreePlacement
+    {
+        Vector3 pos;
+        float yaw;
+        float scale;
+    };
+
+    // Density sampling, random placement and terrain heights are generated per grid column
+    // on the thread pool; the loader and the collision grid are filled below, in order.
+    const bool grid_style = gridspacing > 0;
+    const float gridsize = (gridspacing != 0) ? std::abs(gridspacing) : 10.f;
+    const bool has_collmesh = strlen(treeCollmesh) > 0;
+    const float detail_factor = terrainManager->getPagedDetailFactor();
+    const int num_columns = (int)std::ceil(mapsizex / gridsize);
+    std::vector<std::vector<TreePlacement>> columns(num_columns);
+    App::GetThreadPool()->ParallelFor(num_columns, [&](size_t column)
     {
-        // grid style
-        for (float x=0; x < mapsizex; x += gridspacing)
+        // `Math::RangeRandom()` isn't thread safe; seed per column to keep placement independent of scheduling
+        std::mt19937 rng(static_cast<unsigned>(column) * 2654435761u + static_cast<unsigned>(m_paged_geometry.size()));
+        std::uniform_real_distribution<float> unit(0.f, 1.f);
+        auto range_random = [&](float from, float to) { return from + (to - from) * unit(rng); };
+
+        const float x = column * gridsize;
+        for (float z=0; z < mapsizez; z += gridsize)
         {
-            for (float z=0; z < mapsizez; z += gridspacing)
+            float density = densityMap->_getDensityAt_Unfiltered(x, z, bounds);
+            if (grid_style)
             {
-                float density = densityMap->_getDensityAt_Unfiltered(x, z, bounds);
+                // grid style
                 if (density < 0.8f) continue;
-                float nx = x + gridspacing * 0.5f;
-                float nz = z + gridspacing * 0.5f;
-                float yaw = Math::RangeRandom(yawfrom, yawto);
-                float scale = Math::RangeRandom(scalefrom, scaleto);
-                Vector3 pos = Vector3(nx, 0, nz);
-                treeLoader->addTree(curTree, pos, Degree(yaw), (Ogre::Real)scale);
-                if (strlen(treeCollmesh))
+                TreePlacement tree;
+                tree.pos = Vector3(x + gridsize * 0.5f, 0, z + gridsize * 0.5f);
+                tree.yaw = range_random(yawfrom, yawto);
+                tree.scale = range_random(scalefrom, scaleto);
+                columns[column].push_back(tree);
+            }
+            else
+            {
+                // normal style, random
+                float hd = (highdens < 0) ? range_random(0, -highdens) : highdens;
+                int numTreesToPlace = (int)((float)(hd) * density * detail_factor);
+                while(numTreesToPlace-->0)
                 {
-                    pos.y = terrainManager->GetHeightAt(pos.x, pos.z);
-                    scale *= 0.1f;
-                    terrainManager->GetCollisions()->addCollisionMesh(curTree->getName(), String(treeCollmesh), pos, Quaternion(Degree(yaw), Vector3::UNIT_Y), Vector3(scale, scale, scale));
+                    TreePlacement tree;
+                    tree.pos = Vector3(range_random(x, x + gridsize), 0, range_random(z, z + gridsize));
+                    tree.yaw = range_random(yawfrom, yawto);
+                    tree.scale = range_random(scalefrom, scaleto);
+                    columns[column].push_back(tree);
                 }
             }
         }
-    }
-    else
-    {
-        float gridsize = 10;
-        if (gridspacing < 0 && gridspacing != 0)
+        if (has_collmesh)
         {
-            gridsize = -gridspacing;
+            for (TreePlacement& tree : columns[column])
+                tree.pos.y = terrainManager->GetHeightAt(tree.pos.x, tree.pos.z);
         }
-        float hd = highdens;
-        // normal style, random
-        for (float x=0; x < mapsizex; x += gridsize)
+    });
+
+    for (std::vector<TreePlacement>& column : columns)
+    {
+        for (TreePlacement& tree : column)
         {
-            for (float z=0; z < mapsizez; z += gridsize)
+            treeLoader->addTree(curTree, Vector3(tree.pos.x, 0, tree.pos.z), Degree(tree.yaw), (Ogre::Real)tree.scale);
+            if (has_collmesh && grid_style)
             {
-                if (highdens < 0) hd = Math::RangeRandom(0, -highdens);
-                float density = densityMap->_getDensityAt_Unfiltered(x, z, bounds);
-                int numTreesToPlace = (int)((float)(hd) * density * terrainManager->getPagedDetailFactor());
-                float nx=0, nz=0;
-                while(numTreesToPlace-->0)
-                {
-                    nx = Math::RangeRandom(x, x + gridsize);
-                    nz = Math::RangeRandom(z, z + gridsize);
-                    float yaw = Math::RangeRandom(yawfrom, yawto);
-                    float scale = Math::RangeRandom(scalefrom, scaleto);
-                    Vector3 pos = Vector3(nx, 0, nz);
-                    treeLoader->addTree(curTree, pos, Degree(yaw), (Ogre::Real)scale);
-                    if (strlen(treeCollmesh))
-                    {
-                        pos.y = terrainManager->GetHeightAt(pos.x, pos.z);
-                        terrainManager->GetCollisions()->addCollisionMesh(treemesh, String(treeCollmesh),pos, Quaternion(Degree(yaw), Vector3::UNIT_Y), Vector3(scale, scale, scale));
-                    }
-                }
+                float scale = tree.scale * 0.1f;
+                terrainManager->GetCollisions()->addCollisionMesh(curTree->getName(), String(treeCollmesh), tree.pos, Quaternion(Degree(tree.yaw), Vector3::UNIT_Y), Vector3(scale, scale, scale));
+            }
+            else if (has_collmesh)
+            {
+                terrainManager->GetCollisions()->addCollisionMesh(treemesh, String(treeCollmesh), tree.pos, Quaternion(Degree(tree.yaw), Vector3::UNIT_Y), Vector3(tree.scale, tree.scale, tree.scale));
             }
         }
     }
     m_paged_geometry.push_back(geom);
+    m_paged_far_range.push_back(far_range);
 #endif //USE_PAGED
 }
 
@@ -442,6 +494,7 @@ void TerrainObjectManager::ProcessGrass(
             grassLayer->setFadeTechnique(FADETECH_ALPHA);
 
         m_paged_geometry.push_back(grass);
+        m_paged_far_range.push_back(range * terrainManager->getPagedDetailFactor());
     } 
     catch(...)
     {
@@ -463,9 +516,34 @@ void TerrainObjectManager::MoveObjectVisuals(const String& instancename, const O
     if (!obj.enabled)
         return;
 
+    this->BreakStaticBatch(obj.sceneNode);
     obj.sceneNode->setPosition(pos);
 }
 
+bool TerrainObjectManager::MoveObject(const String& instancename, const Ogre::Vector3& pos)
+{
+    auto found = m_static_objects.find(instancename);
+    if (found == m_static_objects.end() || !found->second.enabled)
+        return false;
+
+    StaticObject& obj = found->second;
+    const Vector3 offset = pos - obj.sceneNode->getPosition();
+
+    this->BreakStaticBatch(obj.sceneNode);
+    obj.sceneNode->setPosition(pos);
+
+    // Only the cells covered by the object's own elements are updated
+    for (int& tri : obj.collTris)
+    {
+        tri = terrainManager->GetCollisions()->moveCollisionTri(tri, offset);
+    }
+    for (int box : obj.collBoxes)
+    {
+        terrainManager->GetCollisions()->moveCollisionBox(box, offset);
+    }
+    return true;
+}
+
 void TerrainObjectManager::unloadObject(const String& instancename)
 {
     if (m_static_objects.find(instancename) == m_static_objects.end())
@@ -488,6 +566,7 @@ void TerrainObjectManager::unloadObject(const String& instancename)
         terrainManager->GetCollisions()->removeCollisionBox(box);
     }
 
+    this->BreakStaticBatch(obj.sceneNode);
     obj.sceneNode->detachAllObjects();
     obj.sceneNode->setVisible(false);
     obj.enabled = false;
@@ -538,6 +617,64 @@ ODefFile* TerrainObjectManager::FetchODef(std::string const & odef_name)
     }
 }
 
+void TerrainObjectManager::PrefetchODefs(std::vector<TObjEntry> const& entries)
+{
+    struct PendingODef
+    {
+        std::string odef_name;
+        Ogre::DataStreamPtr stream;
+        std::shared_ptr<ODefFile> odef;
+    };
+
+    // Resource lookup stays on the main thread, only the parsing is spread over the pool
+    std::vector<PendingODef> pending;
+    std::set<std::string> seen;
+    for (TObjEntry const& entry : entries)
+    {
+        if (m_odef_cache.find(entry.odef_name) != m_odef_cache.end() || !seen.insert(entry.odef_name).second)
+        {
+            continue;
+        }
+        try
+        {
+            const std::string filename = std::string(entry.odef_name) + ".odef";
+            const std::string group_name = Ogre::ResourceGroupManager::getSingleton().findGroupContainingResource(filename);
+            Ogre::DataStreamPtr ds = ResourceGroupManager::getSingleton().openResource(filename, group_name);
+            PendingODef p;
+            p.odef_name = entry.odef_name;
+            p.stream = Ogre::DataStreamPtr(OGRE_NEW Ogre::MemoryDataStream(ds)); // Read it whole, archives aren't thread safe
+            pending.push_back(p);
+        }
+        catch (...)
+        {
+            // `FetchODef()` will report it
+        }
+    }
+
+    App::GetThreadPool()->ParallelFor(pending.size(), [&pending](size_t i)
+    {
+        try
+        {
+            ODefParser parser;
+            parser.Prepare();
+            parser.ProcessOgreStream(pending[i].stream.get());
+            pending[i].odef = parser.Finalize();
+        }
+        catch (...)
+        {
+            // `FetchODef()` will report it
+        }
+    });
+
+    for (PendingODef& p : pending)
+    {
+        if (p.odef)
+        {
+            m_odef_cache.insert(std::make_pair(p.odef_name, p.odef));
+        }
+    }
+}
+
 bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, const Ogre::String& instancename, const Ogre::String& type, float rendering_distance /* = 0 */, bool enable_collisions /* = true */, int scripthandler /* = -1 */, bool uniquifyMaterial /* = false */)
 {
     if (type == "grid")
@@ -570,15 +707,20 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
     SceneNode* tenode = App::GetGfxScene()->GetSceneManager()->getRootSceneNode()->createChildSceneNode();
 
     MeshObject* mo = nullptr;
+    Entity* batch_entity = nullptr;
     if (odef->header.mesh_name != "none")
     {
         Str<100> ebuf; ebuf << m_entity_counter++ << "-" << odef->header.mesh_name;
-        mo = new MeshObject(odef->header.mesh_name, m_resource_group, ebuf.ToCStr(), tenode);
-        if (mo->getEntity())
+        // Objects spawned mid-game (scripts, console) read their mesh in background to avoid a hitch;
+        // TOBJ objects load synchronously because static batching needs the entity right away.
+        const bool background = !m_collect_static_batch_candidates;
+        mo = new MeshObject(odef->header.mesh_name, m_resource_group, ebuf.ToCStr(), tenode, background);
+        if (mo->getEntity() || mo->isLoading())
         {
-            mo->getEntity()->setCastShadows(odef->header.cast_shadows);
-            mo->getEntity()->setRenderingDistance(rendering_distance);
+            mo->setCastShadows(odef->header.cast_shadows);
+            mo->setRenderingDistance(rendering_distance);
             m_mesh_objects.push_back(mo);
+            batch_entity = mo->getEntity();
         }
         else
         {
@@ -621,14 +763,7 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
 
     if (mo && uniquifyMaterial && !instancename.empty())
     {
-        for (unsigned int i = 0; i < mo->getEntity()->getNumSubEntities(); i++)
-        {
-            SubEntity* se = mo->getEntity()->getSubEntity(i);
-            String matname = se->getMaterialName();
-            String newmatname = matname + "/" + instancename;
-            se->getMaterial()->clone(newmatname);
-            se->setMaterialName(newmatname);
-        }
+        mo->uniquifyMaterials(instancename);
     }
 
     for (LocalizerType type : odef->localizers)
@@ -909,9 +1044,88 @@ bool TerrainObjectManager::LoadTerrainObject(const Ogre::String& name, const Ogr
         sn->attachObject(lflare);
     }
 
+    // Anything that may move, animate or get swapped out stays a separate entity
+    const bool has_events = std::any_of(odef->collision_boxes.begin(), odef->collision_boxes.end(),
+        [](ODefCollisionBox const& cbox) { return !cbox.event_name.empty(); });
+    if (m_collect_static_batch_candidates && batch_entity && odef->animations.empty() && !has_events &&
+        !race_event && scripthandler == -1 && !uniquifyMaterial)
+    {
+        StaticBatchCandidate candidate;
+        candidate.entity = batch_entity;
+        candidate.rendering_distance = rendering_distance;
+        m_static_batch_candidates.push_back(candidate);
+    }
+
     return true;
 }
 
+void TerrainObjectManager::BuildStaticBatches()
+{
+    const float region_size = App::gfx_static_batch_size->getFloat();
+    if (region_size <= 0.f)
+    {
+        m_static_batch_candidates.clear();
+        return;
+    }
+
+    // Group by region, and by what `Ogre::StaticGeometry` can only set for the whole batch
+    std::map<std::string, std::vector<StaticBatchCandidate>> groups;
+    for (StaticBatchCandidate& candidate : m_static_batch_candidates)
+    {
+        const Vector3 pos = candidate.entity->getParentSceneNode()->_getDerivedPosition();
+        groups[fmt::format("{}|{}|{}|{}|{}", (int)std::floor(pos.x / region_size), (int)std::floor(pos.z / region_size),
+            candidate.rendering_distance, candidate.entity->getCastShadows(), candidate.entity->getVisibilityFlags())].push_back(candidate);
+    }
+    m_static_batch_candidates.clear();
+
+    for (auto& group : groups)
+    {
+        if (group.second.size() < 2)
+        {
+            continue; // Nothing to gain
+        }
+
+        const std::string batch_name = fmt::format("StaticBatch-{}-{}", m_static_batches.size(), group.first);
+        StaticBatch& batch = m_static_batches[batch_name];
+        batch.geometry = App::GetGfxScene()->GetSceneManager()->createStaticGeometry(batch_name);
+        batch.geometry->setRegionDimensions(Vector3(region_size));
+        batch.geometry->setRenderingDistance(group.second[0].rendering_distance);
+        batch.geometry->setCastShadows(group.second[0].entity->getCastShadows());
+        batch.geometry->setVisibilityFlags(group.second[0].entity->getVisibilityFlags());
+        for (StaticBatchCandidate& candidate : group.second)
+        {
+            SceneNode* node = candidate.entity->getParentSceneNode();
+            batch.geometry->addEntity(candidate.entity, node->_getDerivedPosition(), node->_getDerivedOrientation(), node->_getDerivedScale());
+            candidate.entity->setVisible(false);
+            batch.entities.push_back(candidate.entity);
+            batch.nodes.push_back(node);
+            m_static_batch_lookup[node] = batch_name;
+        }
+        batch.geometry->build();
+    }
+}
+
+void TerrainObjectManager::BreakStaticBatch(Ogre::SceneNode* node)
+{
+    auto lookup_res = m_static_batch_lookup.find(node);
+    if (lookup_res == m_static_batch_lookup.end())
+    {
+        return;
+    }
+
+    auto batch_res = m_static_batches.find(lookup_res->second);
+    for (Entity* entity : batch_res->second.entities)
+    {
+        entity->setVisible(true);
+    }
+    for (SceneNode* batched_node : batch_res->second.nodes)
+    {
+        m_static_batch_lookup.erase(batched_node);
+    }
+    App::GetGfxScene()->GetSceneManager()->destroyStaticGeometry(batch_res->second.geometry);
+    m_static_batches.erase(batch_res);
+}
+
 bool TerrainObjectManager::UpdateAnimatedObjects(float dt)
 {
     if (m_animated_objects.size() == 0)
@@ -946,6 +1160,15 @@ void TerrainObjectManager::LoadPredefinedActors()
         return;
     }
 
+    // Parse all the definitions at once - terrains may park dozens of vehicles, many of them the same
+    std::vector<std::string> filenames;
+    for (PredefinedActor const& pa: m_predefined_actors)
+    {
+        filenames.push_back(pa.name);
+    }
+    App::GetGameContext()->GetActorManager()->PrepareActorDefs(filenames, /*predefined_on_terrain=*/true);
+
+    // The spawns themselves create scene objects, they're done by the main loop
     for (unsigned int i = 0; i < m_predefined_actors.size(); i++)
     {
         ActorSpawnRequest* rq = new ActorSpawnRequest;
@@ -962,16 +1185,61 @@ void TerrainObjectManager::LoadPredefinedActors()
 bool TerrainObjectManager::UpdateTerrainObjects(float dt)
 {
 #ifdef USE_PAGED
+    this->PrefetchPagedGeometry(dt);
     for (auto geom : m_paged_geometry)
     {
         geom->update();
     }
 #endif //USE_PAGED
     this->UpdateAnimatedObjects(dt);
+    m_procedural_manager->updatePendingObjects();
 
     return true;
 }
 
+void TerrainObjectManager::PrefetchPagedGeometry(float dt)
+{
+#ifdef USE_PAGED
+    if (m_paged_geometry.empty() || dt <= 0.f)
+        return;
+
+    const Vector3 cam_pos = App::GetCameraManager()->GetCameraNode()->_getDerivedPosition();
+    Vector3 velocity = (cam_pos - m_paged_prefetch_cam_pos) / dt;
+    m_paged_prefetch_cam_pos = cam_pos;
+    velocity.y = 0.f;
+    if (velocity.length() < PAGED_PREFETCH_MIN_SPEED)
+        return;
+
+    // Restart whenever the camera enters another cell; pages pinned by the previous round
+    // are released to the regular range-based unloading.
+    const float cell_size = m_paged_geometry[0]->getPageSize();
+    const int cell_x = (int)std::floor(cam_pos.x / cell_size);
+    const int cell_z = (int)std::floor(cam_pos.z / cell_size);
+    if (cell_x != m_paged_prefetch_cell_x || cell_z != m_paged_prefetch_cell_z)
+    {
+        for (PagedGeometry* geom : m_paged_geometry)
+        {
+            geom->resetPreloadedGeometry();
+        }
+        m_paged_prefetch_cell_x = cell_x;
+        m_paged_prefetch_cell_z = cell_z;
+        m_paged_prefetch_step = 0;
+    }
+
+    if (m_paged_prefetch_step >= PAGED_PREFETCH_NUM_PAGES)
+        return;
+
+    const Vector3 dir = velocity.normalisedCopy();
+    for (size_t i = 0; i < m_paged_geometry.size(); i++)
+    {
+        const float page_size = m_paged_geometry[i]->getPageSize();
+        const Vector3 ahead = cam_pos + dir * (m_paged_far_range[i] + page_size * (m_paged_prefetch_step + 0.5f));
+        m_paged_geometry[i]->preloadGeometry(TBounds(ahead.x, ahead.z, ahead.x + 1.f, ahead.z + 1.f));
+    }
+    m_paged_prefetch_step++;
+#endif //USE_PAGED
+}
+
 void TerrainObjectManager::ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params, bool race_event)
 {
     for (ODefCollisionBox& cbox : odef->collision_boxes)
@@ -28,6 +28,7 @@
 #include "MeshObject.h"
 #include "ProceduralManager.h"
 #include "SurveyMapEntity.h"
+#include "TObjFileFormat.h"
 
 #ifdef USE_PAGED
 #include "PagedGeometry.h"
@@ -72,7 +73,9 @@ public:
     void           LoadTObjFile(Ogre::String filename);
     bool           LoadTerrainObject(const Ogre::String& name, const Ogre::Vector3& pos, const Ogre::Vector3& rot, const Ogre::String& instancename, const Ogre::String& type, float rendering_distance = 0, bool enable_collisions = true, int scripthandler = -1, bool uniquifyMaterial = false);
     void           MoveObjectVisuals(const Ogre::String& instancename, const Ogre::Vector3& pos);
+    bool           MoveObject(const Ogre::String& instancename, const Ogre::Vector3& pos); //!< Moves the visuals together with the collision boxes and tris; false if not found
     void           unloadObject(const Ogre::String& instancename);
+    void           BreakStaticBatch(Ogre::SceneNode* node); //!< Makes the object and the rest of its batch (if any) individually movable again, see 'gfx_static_batch_size'.
     void           LoadTelepoints();
     void           LoadPredefinedActors();
     bool           HasPredefinedActors() { return !m_predefined_actors.empty(); };
@@ -142,14 +145,31 @@ protected:
         std::vector<int> collTris;
     };
 
+    /// Terrain objects in one region, drawn as one `Ogre::StaticGeometry`; the entities are only hidden.
+    struct StaticBatch
+    {
+        Ogre::StaticGeometry* geometry = nullptr;
+        std::vector<Ogre::Entity*> entities;
+        std::vector<Ogre::SceneNode*> nodes;
+    };
+
+    struct StaticBatchCandidate
+    {
+        Ogre::Entity* entity = nullptr;
+        float rendering_distance = 0.f;
+    };
+
     // ODef processing functions
 
     RoR::ODefFile* FetchODef(std::string const & odef_name);
+    void           PrefetchODefs(std::vector<TObjEntry> const& entries); //!< Parses all not yet cached ODEF files in parallel.
     void           ProcessODefCollisionBoxes(StaticObject* obj, ODefFile* odef, const EditorObject& params, bool race_event);
 
     // Misc functions
 
     bool           UpdateAnimatedObjects(float dt);
+    void           BuildStaticBatches();
+    void           PrefetchPagedGeometry(float dt);  //!< Preloads pages ahead of the camera, one per frame, so they don't all load in one frame
 
     // Variables
 
@@ -164,10 +184,19 @@ protected:
     Terrain*           terrainManager;
     ProceduralManagerPtr      m_procedural_manager;
     int                       m_entity_counter = 0;
+    bool                      m_collect_static_batch_candidates = false; //!< Only objects placed by TOBJ files are batched
+    std::vector<StaticBatchCandidate>                  m_static_batch_candidates;
+    std::map<std::string, StaticBatch>                 m_static_batches;
+    std::unordered_map<Ogre::SceneNode*, std::string>  m_static_batch_lookup;
     std::string               m_resource_group;
 
 #ifdef USE_PAGED
     std::vector<Forests::PagedGeometry*> m_paged_geometry;
+    std::vector<float>                   m_paged_far_range;       //!< Per `m_paged_geometry`; distance up to which pages are loaded anyway
+    Ogre::Vector3                        m_paged_prefetch_cam_pos = Ogre::Vector3::ZERO;
+    int                                  m_paged_prefetch_cell_x = 0; //!< Camera cell when the prefetch was (re)started
+    int                                  m_paged_prefetch_cell_z = 0;
+    int                                  m_paged_prefetch_step = 0;
 #endif //USE_PAGED
 };
 
@@ -20,7 +20,9 @@ along with Rigs of Rods.  If not, see <http://www.gnu.org/licenses/>.
 #pragma once
 
 #include "Application.h"
+#include "PlatformUtils.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <functional>
@@ -33,6 +35,14 @@ along with Rigs of Rods.  If not, see <http://www.gnu.org/licenses/>.
 
 namespace RoR {
 
+/// Scheduling class of a task submitted to ThreadPool
+enum class TaskPriority
+{
+    HIGH,      //!< Physics and frame-critical work which is waited for within the frame; always picked first.
+    NORMAL,    //!< Work the user is waiting for (spawning, queries); can't occupy every worker, one stays free for HIGH tasks.
+    BACKGROUND //!< Cache, prefetching, disk writes; runs on separate low-priority threads and never occupies the regular workers.
+};
+
 /** /brief Handle for a task executed by ThreadPool
  *
  * Returned by ThreadPool instance when submitting a new task to run.
@@ -66,6 +76,14 @@ class Task
         m_finish_cv.wait(lock, [this]{ return m_is_finished; });
     }
 
+    /// Check without blocking whether the task has finished; for polling once per frame.
+    bool is_finished() const
+    {
+        // The mutex is held while the task runs, so failing to lock means it's not done yet
+        std::unique_lock<std::mutex> lock(m_task_mutex, std::try_to_lock);
+        return lock.owns_lock() && m_is_finished;
+    }
+
     private:
     // Only constructable by friend class ThreadPool
     Task(std::function<void()> task_func) : m_task_func(task_func) {}
@@ -100,6 +118,12 @@ class Task
  *  tp.Parallelize({task1, task2});  // Run tasks in parallel and wait until all have finished
  * \endcode
  *
+ * Usage example 3:
+ * \code
+ *  ThreadPool tp;
+ *  tp.ParallelFor(items.size(), [&items](size_t i){ items[i].Update(); });  // Fork/join over a range
+ * \endcode
+ *
  * \see Task
  */
 class ThreadPool {
@@ -107,89 +131,114 @@ public:
     static ThreadPool* DetectNumWorkersAndCreate()
     {
         // Create general-purpose thread pool
-        int logical_cores = std::thread::hardware_concurrency();
+        const CpuTopology& topo = GetCpuTopology();
+        const bool pinned = App::app_pin_threads->getBool() && topo.hybrid;
 
         int num_threads = App::app_num_workers->getInt();
-        if (num_threads < 1 || num_threads > logical_cores)
+        if (num_threads < 1 || num_threads > topo.logical_cores)
         {
-            num_threads = Ogre::Math::Clamp(logical_cores - 1, 1, 8);
+            // One worker per physical core besides the main thread; SMT siblings add little to physics, which is memory-bound.
+            // When pinned, efficiency cores are left out. The upper limit only keeps huge servers from spawning idle threads.
+            const int usable_cores = pinned ? std::min(topo.physical_cores, static_cast<int>(topo.performance_cpus.size())) : topo.physical_cores;
+            num_threads = Ogre::Math::Clamp(usable_cores - 1, 1, 32);
             App::app_num_workers->setVal(num_threads);
         }
 
-        RoR::LogFormat("[RoR|ThreadPool] Found %d logical CPU cores, creating %d worker threads",
-                  logical_cores, num_threads);
+        RoR::LogFormat("[RoR|ThreadPool] Found %d logical / %d physical CPU cores%s, creating %d worker threads%s",
+                  topo.logical_cores, topo.physical_cores,
+                  topo.hybrid ? fmt::format(" ({} logical on performance cores)", topo.performance_cpus.size()).c_str() : "",
+                  num_threads, pinned ? " pinned to performance cores" : "");
+
+        // Background lane: a few threads of its own, so cache rebuilds or disk writes can't delay physics
+        const int num_background = Ogre::Math::Clamp(num_threads / 4, 1, 4);
+        RoR::LogFormat("[RoR|ThreadPool] Creating %d background threads", num_background);
 
-        return new ThreadPool(num_threads);
+        return new ThreadPool(num_threads, ThreadPriority::NORMAL, num_background);
+    }
+
+    /// Applies the placement settings to the calling thread: `app_pin_threads` and the OS priority.
+    static void ConfigureCurrentThread(ThreadPriority priority)
+    {
+        // Background threads are left to the OS - efficiency cores are good enough for them
+        if (App::app_pin_threads->getBool() && GetCpuTopology().hybrid && priority != ThreadPriority::BACKGROUND)
+        {
+            PinCurrentThread(GetCpuTopology().performance_cpus);
+        }
+        if (priority != ThreadPriority::NORMAL && !SetCurrentThreadPriority(priority))
+        {
+            RoR::Log("[RoR|ThreadPool] Could not change worker thread priority, keeping the default");
+        }
     }
 
     /** \brief Construct thread pool and launch worker threads.
      *
      * @param num_threads Number of worker threads to use
+     * @param priority OS scheduling priority of the worker threads
+     * @param num_background_threads Number of extra low-priority threads serving `TaskPriority::BACKGROUND`; with 0, such tasks run as NORMAL.
      */
-    ThreadPool(int num_threads)
+    ThreadPool(int num_threads, ThreadPriority priority = ThreadPriority::NORMAL, int num_background_threads = 0)
     {
         ROR_ASSERT(num_threads > 0);
 
-        // Generic function (to be run on a separate thread) within which submitted tasks
-        // are executed. It implements an endless loop (only returning when the ThreadPool
-        // instance itself is destructed) which constantly checks the task queue, grabbing
-        // and executing the frontmost task while the queue is not empty.
-        auto thread_body = [this]{ 
-            while (true) {
-                // Get next task from queue (synchronized access via taskqueue_mutex).
-                // If the queue is empty wait until either
-                //   - being signaled about an available task.
-                //   - the terminate flag is true (i.e. the ThreadPool instance is being destructed).
-                //     In this case return from the running thread.
-                std::unique_lock<std::mutex> queue_lock(m_taskqueue_mutex);
-                while (m_taskqueue.empty()) {
-                    if (m_terminate.load()) { return; }
-                    m_task_available_cv.wait(queue_lock);
-                }
-                const auto current_task = m_taskqueue.front();
-                m_taskqueue.pop();
-                queue_lock.unlock();
-
-                // Execute the actual task and signal the associated Task instance when finished.
-                {
-                    std::lock_guard<std::mutex> task_lock(current_task->m_task_mutex);
-                    current_task->m_task_func();
-                    current_task->m_is_finished = true;
-                }
-                current_task->m_finish_cv.notify_all();
-            }
-        };
+        // Keep one worker free for HIGH tasks, unless there's only one
+        m_normal_limit = std::max(1, num_threads - 1);
 
         // Launch the specified number of threads
         for (int i = 0; i < num_threads; ++i) {
-            m_threads.emplace_back(thread_body);
+            m_threads.emplace_back([this, priority]{
+                ConfigureCurrentThread(priority);
+                this->WorkerLoop(/*background:*/false);
+            });
+        }
+        for (int i = 0; i < num_background_threads; ++i) {
+            m_background_threads.emplace_back([this]{
+                ConfigureCurrentThread(ThreadPriority::BACKGROUND);
+                BackgroundThreadFlag() = true;
+                this->WorkerLoop(/*background:*/true);
+            });
         }
     }
 
     ~ThreadPool() {
         // Indicate termination and signal potential waiting threads to wake up.
         // Then wait for all threads to finish their work and return properly.
-        m_terminate = true;
+        {
+            std::lock_guard<std::mutex> lock(m_taskqueue_mutex);
+            m_terminate = true;
+        }
         m_task_available_cv.notify_all();
+        m_background_available_cv.notify_all();
         for (auto &t : m_threads) { t.join(); }
+        for (auto &t : m_background_threads) { t.join(); }
     }
 
+    int GetNumWorkers() const { return static_cast<int>(m_threads.size()); } //!< Regular workers only, without the background lane.
+
     /// Submit new asynchronous task to thread pool and return Task handle to allow for synchronization.
-    std::shared_ptr<Task> RunTask(const std::function<void()> &task_func) {
+    std::shared_ptr<Task> RunTask(const std::function<void()> &task_func, TaskPriority priority = TaskPriority::NORMAL) {
+        if (priority == TaskPriority::BACKGROUND && m_background_threads.empty())
+        {
+            priority = TaskPriority::NORMAL;
+        }
+
         // Wrap provided task callable object in task handle. Then append it to the task queue and
         // notify a waiting worker thread (if any) about the newly available task
         auto task = std::shared_ptr<Task>(new Task(task_func));
         {
             std::lock_guard<std::mutex> lock(m_taskqueue_mutex);
-            m_taskqueue.push(task);
+            m_taskqueues[static_cast<int>(priority)].push(task);
         }
-        m_task_available_cv.notify_one();
+        if (priority == TaskPriority::BACKGROUND)
+            m_background_available_cv.notify_one();
+        else
+            m_task_available_cv.notify_one();
 
         // Return task handle for later synchronization
         return task;
     }
 
     /// Run collection of tasks in parallel and wait until all have finished.
+    /// The tasks run as HIGH priority, or BACKGROUND when called from the background lane.
     void Parallelize(const std::vector<std::function<void()>> &task_funcs)
     {
         if (task_funcs.empty()) return;
@@ -200,7 +249,7 @@ public:
         std::vector<std::shared_ptr<Task>> handles;
         for(; it != end(task_funcs); ++it)
         { 
-            handles.push_back(RunTask(*it));
+            handles.push_back(RunTask(*it, this->GetForkPriority()));
         }
 
         // Run the first task locally on the current thread
@@ -210,11 +259,157 @@ public:
         for(const auto &h : handles) { h->join(); }
     }
 
+    /** \brief Run `func(i)` for every `i` in range [0, count) and wait until all have finished.
+     *
+     * Indices are handed out one at a time from a shared counter, to the worker threads and the calling thread alike,
+     * so uneven workloads balance themselves and the caller never idles while work is left.
+     * Only one helper task per worker thread is submitted, regardless of `count`.
+     * Unlike `Parallelize()`, the caller doesn't wait for helpers which didn't get to start - busy workers cannot stall it.
+     * Helpers run as HIGH priority, or BACKGROUND when called from the background lane.
+     */
+    void ParallelFor(size_t count, const std::function<void(size_t)> &func)
+    {
+        if (count == 0) return;
+        if (count == 1 || m_threads.empty()) 
+        {
+            for (size_t i = 0; i < count; ++i) { func(i); }
+            return;
+        }
+
+        // Shared with the helper tasks, which may outlive this call if they start after all items were processed.
+        auto batch = std::make_shared<ParallelForBatch>();
+        batch->count = count;
+        batch->func = &func; // Only dereferenced while there are unprocessed items, i.e. while this call is waiting.
+
+        auto work = [batch]
+        {
+            size_t i;
+            while ((i = batch->next.fetch_add(1)) < batch->count)
+            {
+                (*batch->func)(i);
+                if (batch->done.fetch_add(1) + 1 == batch->count)
+                {
+                    { std::lock_guard<std::mutex> lock(batch->done_mutex); } // Prevent lost wakeup
+                    batch->done_cv.notify_all();
+                }
+            }
+        };
+
+        const size_t num_helpers = std::min(count - 1, m_threads.size());
+        for (size_t i = 0; i < num_helpers; ++i)
+        {
+            this->RunTask(work, this->GetForkPriority());
+        }
+
+        // Participate, then wait for items being processed by helpers.
+        work();
+        std::unique_lock<std::mutex> lock(batch->done_mutex);
+        batch->done_cv.wait(lock, [&batch]{ return batch->done.load() == batch->count; });
+    }
+
+private:
+
+    /// Tasks forked by a running task stay in its lane; the caller already waits on them, so anywhere else they're urgent.
+    TaskPriority GetForkPriority() const
+    {
+        return BackgroundThreadFlag() ? TaskPriority::BACKGROUND : TaskPriority::HIGH;
+    }
+
+    static bool& BackgroundThreadFlag() { thread_local bool flag = false; return flag; } //!< Set on background lane threads.
+
+    /// Takes the next task this thread may run; call with `m_taskqueue_mutex` locked.
+    std::shared_ptr<Task> PopTask(bool background, TaskPriority& out_priority)
+    {
+        std::shared_ptr<Task> task;
+        std::queue<std::shared_ptr<Task>>* queue = nullptr;
+        if (background)
+        {
+            out_priority = TaskPriority::BACKGROUND;
+        }
+        else if (!m_taskqueues[static_cast<int>(TaskPriority::HIGH)].empty())
+        {
+            out_priority = TaskPriority::HIGH;
+        }
+        else if (m_normal_running < m_normal_limit)
+        {
+            out_priority = TaskPriority::NORMAL;
+        }
+        else
+        {
+            return nullptr;
+        }
+        queue = &m_taskqueues[static_cast<int>(out_priority)];
+        if (!queue->empty())
+        {
+            task = queue->front();
+            queue->pop();
+        }
+        return task;
+    }
+
+    bool IsLaneEmpty(bool background) const //!< Call with `m_taskqueue_mutex` locked.
+    {
+        return background
+            ? m_taskqueues[static_cast<int>(TaskPriority::BACKGROUND)].empty()
+            : m_taskqueues[static_cast<int>(TaskPriority::HIGH)].empty() && m_taskqueues[static_cast<int>(TaskPriority::NORMAL)].empty();
+    }
+
+    /// Runs on each worker thread until the ThreadPool instance is destructed, grabbing and executing
+    /// tasks of its lane in priority order. On destruction, the remaining tasks are finished first.
+    void WorkerLoop(bool background)
+    {
+        std::condition_variable& available_cv = background ? m_background_available_cv : m_task_available_cv;
+        std::unique_lock<std::mutex> queue_lock(m_taskqueue_mutex);
+        while (true) {
+            // Get next task from queue (synchronized access via taskqueue_mutex).
+            // If there's nothing this thread may run, wait until either
+            //   - being signaled about an available task.
+            //   - the terminate flag is true and the lane is drained. In this case return from the running thread.
+            // A NORMAL task held back by the concurrency limit gets picked up by the worker finishing a NORMAL task.
+            std::shared_ptr<Task> current_task;
+            TaskPriority priority = TaskPriority::NORMAL;
+            available_cv.wait(queue_lock, [&]{
+                current_task = this->PopTask(background, priority);
+                return current_task || (m_terminate.load() && this->IsLaneEmpty(background));
+            });
+            if (!current_task) { return; }
+            if (priority == TaskPriority::NORMAL) { m_normal_running++; }
+            queue_lock.unlock();
+
+            // Execute the actual task and signal the associated Task instance when finished.
+            {
+                std::lock_guard<std::mutex> task_lock(current_task->m_task_mutex);
+                current_task->m_task_func();
+                current_task->m_is_finished = true;
+            }
+            current_task->m_finish_cv.notify_all();
+
+            queue_lock.lock();
+            if (priority == TaskPriority::NORMAL) { m_normal_running--; }
+        }
+    }
+
+    struct ParallelForBatch //!< Shared state of a single `ParallelFor()` call
+    {
+        std::atomic<size_t>                  next{0};       //!< Next index to process
+        std::atomic<size_t>                  done{0};       //!< Number of processed indices
+        size_t                               count = 0;
+        const std::function<void(size_t)>*   func = nullptr;
+        std::mutex                           done_mutex;
+        std::condition_variable              done_cv;
+    };
+
+public:
+
     std::atomic_bool m_terminate{false};            //!< Indicates destruction of ThreadPool instance to worker threads
-    std::vector<std::thread> m_threads;             //!< Collection of worker threads to run tasks
-    std::queue<std::shared_ptr<Task>> m_taskqueue;  //!< Queue of submitted tasks pending for execution
-    std::mutex m_taskqueue_mutex;                   //!< Protects task queue from concurrent access.
-    std::condition_variable m_task_available_cv;    //!< Used to signal threads that a new task was submitted and is ready to run.
+    std::vector<std::thread> m_threads;             //!< Collection of worker threads to run HIGH and NORMAL tasks
+    std::vector<std::thread> m_background_threads;  //!< Low-priority threads to run BACKGROUND tasks
+    std::queue<std::shared_ptr<Task>> m_taskqueues[3]; //!< Queues of submitted tasks pending for execution, indexed by `TaskPriority`
+    int m_normal_running = 0;                       //!< NORMAL tasks being executed; protected by `m_taskqueue_mutex`
+    int m_normal_limit = 1;                         //!< Max. NORMAL tasks executed at once
+    std::mutex m_taskqueue_mutex;                   //!< Protects task queues from concurrent access.
+    std::condition_variable m_task_available_cv;    //!< Used to signal regular workers that a new task was submitted and is ready to run.
+    std::condition_variable m_background_available_cv; //!< Same for the background lane.
 };
 
 } // namespace RoR
\ No newline at end of file
@@ -0,0 +1,175 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "AsyncLogWriter.h"
+
+#include "Application.h"
+
+#include <chrono>
+#include <fmt/format.h>
+#include <iomanip>
+#include <iostream>
+
+using namespace RoR;
+
+static const std::chrono::milliseconds WRITE_INTERVAL(20); // How long the writer sleeps when the ring is empty
+
+AsyncLogWriter::AsyncLogWriter(std::string const& filename, bool echo_stdout):
+    m_file(filename, std::ios::out | std::ios::trunc),
+    m_echo_stdout(echo_stdout)
+{
+    m_ring.Reset(RING_CAPACITY);
+    m_thread = std::thread(&AsyncLogWriter::WriterThreadMain, this);
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    m_exit = true;
+    m_thread.join(); // Writes out whatever is left
+}
+
+void AsyncLogWriter::messageLogged(const Ogre::String& message, Ogre::LogMessageLevel lml, bool maskDebug, const Ogre::String& logName, bool& skipThisMessage)
+{
+    const std::time_t now = std::time(nullptr);
+    const bool critical = (lml == Ogre::LML_CRITICAL);
+    {
+        std::lock_guard<std::mutex> lock(m_push_mutex);
+
+        if (message == m_last_message && !critical)
+        {
+            m_num_repeats++;
+            return;
+        }
+        this->PushRepeatNotice(now);
+        m_last_message = message;
+
+        if (now != m_window_start)
+        {
+            m_window_start = now;
+            m_window_lines = 0;
+            if (m_num_dropped > 0)
+            {
+                const size_t num_dropped = m_num_dropped;
+                m_num_dropped = 0;
+                this->PushLine(now, fmt::format("[RoR|Log] {} messages were dropped (log flood)", num_dropped));
+            }
+        }
+
+        const int rate_limit = App::diag_log_rate_limit->getInt();
+        if (rate_limit > 0 && ++m_window_lines > (size_t)rate_limit && !critical)
+        {
+            m_num_dropped++;
+            return;
+        }
+
+        this->PushLine(now, message);
+    }
+
+    if (critical)
+    {
+        this->Flush();
+    }
+}
+
+void AsyncLogWriter::PushRepeatNotice(std::time_t time)
+{
+    if (m_num_repeats > 0)
+    {
+        const size_t num_repeats = m_num_repeats;
+        m_num_repeats = 0;
+        this->PushLine(time, fmt::format("[RoR|Log] Previous message repeated {} more times", num_repeats));
+    }
+}
+
+void AsyncLogWriter::PushLine(std::time_t time, std::string const& text)
+{
+    Line* line = m_ring.BeginPush();
+    if (!line)
+    {
+        m_num_dropped++; // The writer can't keep up; don't block the logging thread
+        return;
+    }
+    line->time = time;
+    line->text.assign(text); // Reuses the slot's capacity
+    m_ring.EndPush();
+}
+
+void AsyncLogWriter::Flush()
+{
+    if (std::this_thread::get_id() == m_thread.get_id())
+    {
+        return; // Would wait for itself
+    }
+    {
+        // Don't keep a repeat count waiting for the next different message
+        std::lock_guard<std::mutex> lock(m_push_mutex);
+        this->PushRepeatNotice(std::time(nullptr));
+    }
+    while (m_ring.Size() > 0) // Lines are popped only after the file was flushed
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void AsyncLogWriter::WriterThreadMain()
+{
+    while (true)
+    {
+        const bool exit = m_exit; // Read before draining, so nothing logged before the request is lost
+        size_t num_written = 0;
+        while (Line* line = m_ring.Peek(num_written))
+        {
+            // Same format as OGRE's own log output
+            const std::tm* tm = std::localtime(&line->time);
+            m_file << std::setw(2) << std::setfill('0') << tm->tm_hour << ":"
+                   << std::setw(2) << std::setfill('0') << tm->tm_min << ":"
+                   << std::setw(2) << std::setfill('0') << tm->tm_sec << ": "
+                   << line->text << '\n';
+            if (m_echo_stdout)
+            {
+                std::cout << line->text << '\n';
+            }
+            num_written++;
+        }
+
+        if (num_written > 0)
+        {
+            m_file.flush();
+            if (m_echo_stdout)
+            {
+                std::cout.flush();
+            }
+            for (size_t i = 0; i < num_written; i++)
+            {
+                m_ring.Pop();
+            }
+        }
+        else if (exit)
+        {
+            return;
+        }
+        else
+        {
+            std::this_thread::sleep_for(WRITE_INTERVAL);
+        }
+    }
+}
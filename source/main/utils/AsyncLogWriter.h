@@ -0,0 +1,92 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/// @file
+/// @brief Writes RoR.log on a background thread.
+
+#pragma once
+
+#include "SpscRing.h"
+
+#include <OgreLog.h>
+
+#include <atomic>
+#include <ctime>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Replaces OGRE's synchronous file output (which flushes every line) for the main log.
+/// Messages go into a preallocated ring and a background thread writes them out in batches.
+/// Identical consecutive messages are collapsed into a "repeated N times" line, and lines
+/// beyond 'diag_log_rate_limit' per second are dropped and counted, so that a flooding mod
+/// can't stall the thread which logs. Critical messages bypass the limit and are flushed before
+/// `messageLogged()` returns, since a crash may follow right after. Safe to log from any thread.
+class AsyncLogWriter: public Ogre::LogListener
+{
+public:
+    AsyncLogWriter(std::string const& filename, bool echo_stdout);
+    ~AsyncLogWriter();
+
+    void                 Flush(); //!< Blocks until everything logged so far is written; no-op on the writer thread.
+
+    // Ogre::LogListener
+    virtual void         messageLogged(const Ogre::String& message, Ogre::LogMessageLevel lml, bool maskDebug, const Ogre::String& logName, bool& skipThisMessage) override;
+
+private:
+    struct Line
+    {
+        std::time_t      time;
+        std::string      text;
+    };
+
+    static const size_t  RING_CAPACITY = 4096;
+
+    void                 PushLine(std::time_t time, std::string const& text); //!< Producer side; `m_push_mutex` must be locked.
+    void                 PushRepeatNotice(std::time_t time);                 //!< Producer side; `m_push_mutex` must be locked.
+    void                 WriterThreadMain();
+
+    // Producers (any thread, serialized by the mutex)
+    std::mutex           m_push_mutex;
+    std::string          m_last_message;
+    size_t               m_num_repeats = 0;       //!< Identical messages swallowed since `m_last_message` was written
+    std::time_t          m_window_start = 0;      //!< Rate limiting: current 1-second window
+    size_t               m_window_lines = 0;
+    size_t               m_num_dropped = 0;       //!< Over the rate limit or ring full; reported once writable again
+
+    // Consumer (writer thread)
+    SpscRing<Line>       m_ring;
+    std::ofstream        m_file;
+    bool                 m_echo_stdout;
+    std::atomic<bool>    m_exit{false};
+    std::thread          m_thread;
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
@@ -30,8 +30,16 @@
 #include <OISForceFeedback.h>
 #include <OgreString.h>
 
+#include <chrono>
+#include <cmath>
+
 namespace RoR {
 
+ForceFeedback::~ForceFeedback()
+{
+    this->StopOutputThread();
+}
+
 void ForceFeedback::Setup()
 {
     using namespace Ogre;
@@ -48,11 +56,23 @@ void ForceFeedback::Setup()
     //do not load effect now, its too early
 }
 
-void ForceFeedback::SetForces(float roll, float pitch, float wspeed, float dircommand, float stress)
+void ForceFeedback::PublishForces(Actor* actor)
+{
+    const float wspeed = actor->ar_wheel_speed;
+    const float stress_gain = App::io_ffb_stress_gain->getFloat();
+    const float centering_gain = App::io_ffb_center_gain->getFloat();
+    float ff = -actor->GetFFbHydroForces() * stress_gain + actor->ar_hydro_dir_command * 100.0 * centering_gain * wspeed * wspeed;
+    if (ff > 10000)
+        ff = 10000;
+    if (ff < -10000)
+        ff = -10000;
+    m_published_level.store(ff, std::memory_order_relaxed);
+}
+
+void ForceFeedback::SendLevel(float level)
 {
     if (!m_device) { return; }
 
-    //LOG(String("ForceFeedback: R=")+TOSTRING(roll)+" D="+TOSTRING(dir)+" S="+TOSTRING(wspeed)+" H="+TOSTRING(stress));
     if (!m_hydro_effect)
     {
         //we create effect at the last moment, because it does not works otherwise
@@ -78,14 +98,7 @@ void ForceFeedback::SetForces(float roll, float pitch, float wspeed, float dirco
     OIS::ConstantEffect* hydroConstForce = dynamic_cast<OIS::ConstantEffect*>(m_hydro_effect->getForceEffect());
     if (hydroConstForce != nullptr)
     {
-        float stress_gain = App::io_ffb_stress_gain->getFloat();
-        float centering_gain = App::io_ffb_center_gain->getFloat();
-        float ff = -stress * stress_gain + dircommand * 100.0 * centering_gain * wspeed * wspeed;
-        if (ff > 10000)
-            ff = 10000;
-        if (ff < -10000)
-            ff = -10000;
-        hydroConstForce->level = ff; //-10K to +10k
+        hydroConstForce->level = level; //-10K to +10k
     }
     m_device->modify(m_hydro_effect);
 }
@@ -96,12 +109,73 @@ void ForceFeedback::SetEnabled(bool b)
 
     if (b != m_enabled)
     {
-        float gain = (b) ? App::io_ffb_master_gain->getFloat() : 0.f;
-        m_device->setMasterGain(gain);
+        if (!b)
+        {
+            this->StopOutputThread();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_device_mutex);
+            float gain = (b) ? App::io_ffb_master_gain->getFloat() : 0.f;
+            m_device->setMasterGain(gain);
+        }
+
+        if (b && App::io_ffb_enabled->getBool())
+        {
+            this->StartOutputThread();
+        }
     }
     m_enabled = b;
 }
 
+void ForceFeedback::StartOutputThread()
+{
+    const int rate_hz = App::io_ffb_rate->getInt();
+    if (rate_hz <= 0 || m_output_thread.joinable())
+    {
+        return; // Per-frame output from `Update()`
+    }
+
+    m_output_running = true;
+    m_output_thread = std::thread([this, rate_hz]() { this->OutputThreadMain(rate_hz); });
+}
+
+void ForceFeedback::StopOutputThread()
+{
+    m_output_running = false;
+    if (m_output_thread.joinable())
+    {
+        m_output_thread.join();
+    }
+}
+
+void ForceFeedback::OutputThreadMain(int rate_hz)
+{
+    // The sim thread publishes once per batch of physics steps (= per frame), so the level jumps
+    // at frame rate; ease towards it at the device rate to turn the jumps into a ramp.
+    const float SMOOTHING_TIME = 0.01f; // seconds
+    const float tick = 1.f / rate_hz;
+    const float blend = 1.f - std::exp(-tick / SMOOTHING_TIME);
+    const auto interval = std::chrono::microseconds(static_cast<long long>(tick * 1000000.f));
+
+    float level = m_published_level.load(std::memory_order_relaxed);
+    float sent_level = level + 1.f; // Force the first send
+    auto next = std::chrono::steady_clock::now();
+    while (m_output_running)
+    {
+        level += (m_published_level.load(std::memory_order_relaxed) - level) * blend;
+        if (std::abs(level - sent_level) >= 1.f) // The device has integer resolution
+        {
+            std::lock_guard<std::mutex> lock(m_device_mutex);
+            this->SendLevel(level);
+            sent_level = level;
+        }
+
+        next += interval;
+        std::this_thread::sleep_until(next);
+    }
+}
+
 void ForceFeedback::Update()
 {
     if (!m_device)
@@ -112,16 +186,16 @@ void ForceFeedback::Update()
         return;
     }
 
+    if (m_output_thread.joinable())
+    {
+        return; // The output thread feeds the device
+    }
+
     ActorPtr player_actor = App::GetGameContext()->GetPlayerActor();
     if (player_actor && player_actor->ar_driveable == TRUCK)
     {
-        Ogre::Vector3 ff_vehicle = player_actor->GetFFbBodyForces();
-        this->SetForces(
-            -ff_vehicle.dotProduct(player_actor->GetCameraRoll()) / 10000.0,
-             ff_vehicle.dotProduct(player_actor->GetCameraDir())  / 10000.0,
-            player_actor->ar_wheel_speed,
-            player_actor->ar_hydro_dir_command,
-            player_actor->GetFFbHydroForces());
+        std::lock_guard<std::mutex> lock(m_device_mutex);
+        this->SendLevel(m_published_level.load(std::memory_order_relaxed));
     }
 }
 
@@ -21,30 +21,50 @@
 
 #pragma once
 
+#include "ForwardDeclarations.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+
 // Forward decl.
 namespace OIS { class ForceFeedback; class Effect; }
 
 namespace RoR {
 
+/// The sim thread publishes the latest force level into an atomic slot (`PublishForces()`);
+/// the device is fed either from a dedicated output thread at a fixed rate (cvar 'io_ffb_rate')
+/// or, with 'io_ffb_rate' set to 0, from the main thread once per frame (`Update()`).
 class ForceFeedback
 {
 public:
+    ~ForceFeedback();
+
     void Setup();
     void SetEnabled(bool v);
 
-    /// Reads data from simulation
+    /// Sim thread, after each batch of physics steps; we take here :
+    /// -wheel speed and direction command, for the artificial auto-centering (which is wheel speed dependant)
+    /// -hydro beam stress, the ideal data source for FF wheels
+    void PublishForces(Actor* actor);
+
+    /// Main thread, per frame; sends the published level unless the output thread does it
     void Update();
 
 private:
-    /// Called by Update(); we take here :
-    /// -roll and pitch inertial forces at the camera: this is not used currently, but it can be used for 2 axes force feedback devices, like FF joysticks, to render shocks
-    /// -wheel speed and direction command, for the artificial auto-centering (which is wheel speed dependant)
-    /// -hydro beam stress, the ideal data source for FF wheels
-    void SetForces(float roll, float pitch, float wspeed, float dircommand, float stress);
+    void SendLevel(float level);  //!< Device access; caller must hold `m_device_mutex`
+    void StartOutputThread();
+    void StopOutputThread();
+    void OutputThreadMain(int rate_hz);
 
     OIS::ForceFeedback* m_device = nullptr;
     OIS::Effect*        m_hydro_effect = nullptr;
     bool                m_enabled = false; /// Disables FF when not in vehicle
+
+    std::atomic<float>  m_published_level{0.f};  //!< Written by sim thread, -10K to +10k
+    std::atomic<bool>   m_output_running{false};
+    std::thread         m_output_thread;
+    std::mutex          m_device_mutex;          //!< OIS device isn't thread safe
 };
 
 } // namespace RoR
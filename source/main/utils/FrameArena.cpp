@@ -0,0 +1,128 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+#include "FrameArena.h"
+
+#include "SimProfiler.h"
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace RoR;
+
+const size_t FRAME_ARENA_BLOCK_SIZE = 64 * 1024; // Initial size, grows with the workload
+
+FrameArena& FrameArena::Get()
+{
+    thread_local FrameArena arena;
+    return arena;
+}
+
+void* FrameArena::Allocate(size_t bytes, size_t align)
+{
+    if (m_blocks.empty())
+    {
+        this->AddBlock(std::max(bytes + align, FRAME_ARENA_BLOCK_SIZE));
+    }
+
+    for (;;)
+    {
+        Block& block = m_blocks[m_current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data.get());
+        const uintptr_t start = (base + block.used + align - 1) & ~(uintptr_t)(align - 1);
+        if (start + bytes <= base + block.size)
+        {
+            block.used = (start + bytes) - base;
+            SimProfiler::CountArenaAllocation(bytes, /*heap_block:*/false);
+            return reinterpret_cast<void*>(start);
+        }
+
+        // Move on to the next block - reuse one left over from a rewind, or add one
+        if (m_current + 1 < m_blocks.size() && m_blocks[m_current + 1].size >= bytes + align)
+        {
+            m_current++;
+            m_blocks[m_current].used = 0;
+        }
+        else
+        {
+            m_blocks.resize(m_current + 1); // Drop too small leftovers, keeps blocks ordered by use
+            this->AddBlock(std::max(bytes + align, block.size * 2));
+        }
+    }
+}
+
+void FrameArena::Deallocate(void* ptr, size_t bytes)
+{
+    if (m_blocks.empty())
+        return;
+
+    Block& block = m_blocks[m_current];
+    if (static_cast<char*>(ptr) + bytes == block.data.get() + block.used)
+    {
+        block.used -= bytes;
+    }
+}
+
+void FrameArena::Reset()
+{
+    if (m_blocks.size() > 1)
+    {
+        // Overflowed since the last reset - replace the chain with a single block big enough for all of it
+        const size_t capacity = this->GetCapacity();
+        m_blocks.clear();
+        this->AddBlock(capacity);
+    }
+    m_current = 0;
+    if (!m_blocks.empty())
+    {
+        m_blocks[0].used = 0;
+    }
+}
+
+void FrameArena::Rewind(Mark const& mark)
+{
+    if (m_blocks.empty())
+        return;
+
+    m_current = mark.block;
+    m_blocks[m_current].used = mark.used;
+}
+
+size_t FrameArena::GetCapacity() const
+{
+    size_t capacity = 0;
+    for (Block const& block: m_blocks)
+    {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+void FrameArena::AddBlock(size_t min_size)
+{
+    Block block;
+    block.size = min_size;
+    block.data.reset(new char[min_size]);
+    m_blocks.push_back(std::move(block));
+    m_current = m_blocks.size() - 1;
+    SimProfiler::CountArenaAllocation(min_size, /*heap_block:*/true);
+}
@@ -0,0 +1,106 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+
+/// @file
+/// @brief Per-thread linear allocator for containers that only live within one frame or physics step.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Bump allocator owned by a single thread; allocating is a pointer increment and
+/// freeing is a no-op, all memory is reclaimed at once by `Reset()` or `FrameArenaScope`.
+/// When the current block runs out another one is added; `Reset()` then merges them
+/// into one block sized for the peak, so a steady workload stops touching the heap after a few frames.
+class FrameArena
+{
+public:
+    struct Mark
+    {
+        size_t block;
+        size_t used;
+    };
+
+    static FrameArena& Get(); //!< The calling thread's arena.
+
+    void*  Allocate(size_t bytes, size_t align);
+    void   Deallocate(void* ptr, size_t bytes); //!< Only reclaims the most recent allocation of this arena, anything else waits for the reset.
+    void   Reset();                             //!< Frees everything; only call where no arena-backed container is alive (e.g. top of the main loop).
+    Mark   GetMark() const { return Mark{ m_current, m_blocks.empty() ? 0 : m_blocks[m_current].used }; }
+    void   Rewind(Mark const& mark);            //!< Frees everything allocated after `mark`.
+    size_t GetCapacity() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> data;
+        size_t                  size = 0;
+        size_t                  used = 0;
+    };
+
+    void   AddBlock(size_t min_size);
+
+    std::vector<Block> m_blocks;
+    size_t             m_current = 0; //!< Index of the block being filled
+};
+
+/// Rewinds the calling thread's arena at the end of the scope; nests safely.
+class FrameArenaScope
+{
+public:
+    FrameArenaScope(): m_arena(FrameArena::Get()), m_mark(m_arena.GetMark()) {}
+    ~FrameArenaScope() { m_arena.Rewind(m_mark); }
+
+private:
+    FrameArena&      m_arena;
+    FrameArena::Mark m_mark;
+};
+
+/// STL allocator drawing from the calling thread's `FrameArena`.
+/// Containers using it must be local to a function running between two resets of that thread's arena.
+template <class T>
+struct FrameAllocator
+{
+    typedef T value_type;
+
+    FrameAllocator() noexcept {}
+    template <class U> FrameAllocator(FrameAllocator<U> const&) noexcept {}
+
+    T* allocate(size_t n) { return static_cast<T*>(FrameArena::Get().Allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T* ptr, size_t n) noexcept { FrameArena::Get().Deallocate(ptr, n * sizeof(T)); }
+};
+
+template <class T, class U> bool operator==(FrameAllocator<T> const&, FrameAllocator<U> const&) { return true; }
+template <class T, class U> bool operator!=(FrameAllocator<T> const&, FrameAllocator<U> const&) { return false; }
+
+template <class T> using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+/// @} // addtogroup Application
+
+} // namespace RoR
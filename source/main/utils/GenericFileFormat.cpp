@@ -23,6 +23,7 @@
 #include "Console.h"
 
 #include <algorithm>
+#include <cmath>
 
 using namespace RoR;
 using namespace Ogre;
@@ -864,10 +865,56 @@ void DocumentParser::FlushStringishToken(RoR::TokenType type)
     partial_tok_type = PartialToken::NONE;
 }
 
+/// Locale-independent conversion of a token already validated by `UpdateNumber()`,
+/// i.e. `[-]digits[.digits][(e|E)[-]digits]`. Avoids the stringstream round-trip of `StringConverter::parseReal()`.
+static float ParseNumericToken(const char* str)
+{
+    bool negative = false;
+    if (*str == '-')
+    {
+        negative = true;
+        str++;
+    }
+
+    double mantissa = 0.0;
+    int exponent = 0;
+    for (; *str >= '0' && *str <= '9'; str++)
+    {
+        mantissa = (mantissa * 10.0) + (*str - '0');
+    }
+    if (*str == '.')
+    {
+        for (str++; *str >= '0' && *str <= '9'; str++)
+        {
+            mantissa = (mantissa * 10.0) + (*str - '0');
+            exponent--;
+        }
+    }
+    if (*str == 'e' || *str == 'E')
+    {
+        str++;
+        bool exp_negative = false;
+        if (*str == '-')
+        {
+            exp_negative = true;
+            str++;
+        }
+        int exp_value = 0;
+        for (; *str >= '0' && *str <= '9'; str++)
+        {
+            exp_value = std::min((exp_value * 10) + (*str - '0'), 1000);
+        }
+        exponent += (exp_negative) ? -exp_value : exp_value;
+    }
+
+    const double result = (exponent < 0) ? mantissa / std::pow(10.0, -exponent) : mantissa * std::pow(10.0, exponent);
+    return static_cast<float>((negative) ? -result : result);
+}
+
 void DocumentParser::FlushNumericToken()
 {
     tok.push_back('\0');
-    doc.tokens.push_back({ TokenType::NUMBER, (float)Ogre::StringConverter::parseReal(tok.data()) });
+    doc.tokens.push_back({ TokenType::NUMBER, ParseNumericToken(tok.data()) });
     tok.clear();
     partial_tok_type = PartialToken::NONE;
 }
@@ -881,12 +928,23 @@ void GenericDocument::loadFromDataStream(Ogre::DataStreamPtr datastream, const B
     // Prepare context
     DocumentParser parser(*this, options, datastream);
     const size_t LINE_BUF_MAX = 10 * 1024; // 10Kb
-    char buf[LINE_BUF_MAX];
+
+    // Read the whole file in one go if the size is known (fall back to chunks otherwise),
+    // and pre-size the outputs - a token per ~4 bytes of text is a generous estimate for rig defs.
+    const size_t stream_size = datastream->size();
+    std::vector<char> buf(std::max(stream_size, LINE_BUF_MAX));
+    tokens.reserve(stream_size / 4);
+    string_pool.reserve(stream_size / 2);
+    parser.tok.reserve(256);
 
     // Parse the text
     while (!datastream->eof())
     {
-        size_t buf_len = datastream->read(buf, LINE_BUF_MAX);
+        size_t buf_len = datastream->read(buf.data(), buf.size());
+        if (buf_len == 0)
+        {
+            break;
+        }
         for (size_t i = 0; i < buf_len; i++)
         {
             const char c = buf[i];
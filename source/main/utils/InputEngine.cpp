@@ -26,6 +26,7 @@
 #include "Console.h"
 #include "ContentManager.h"
 #include "GUIManager.h"
+#include "InputRecorder.h"
 #include "Language.h"
 
 #include <regex>
@@ -424,6 +425,9 @@ InputEngine::InputEngine() :
     for (int i = 0; i < MAX_JOYSTICKS; i++)
         mJoy[i] = 0;
 
+    m_event_values.resize(EV_MODE_LAST, 0.f);
+    m_event_values_stamps.resize(EV_MODE_LAST, 0);
+
     LOG("*** Loading OIS ***");
 
     initAllKeys();
@@ -619,6 +623,7 @@ String InputEngine::getKeyNameForKeyCode(OIS::KeyCode keycode)
 
 void InputEngine::Capture()
 {
+    this->invalidateEventValues();
     mKeyboard->capture();
     mMouse->capture();
 
@@ -669,23 +674,27 @@ void InputEngine::ProcessJoystickEvent(const OIS::JoyStickEvent& arg)
     if (i < 0 || i >= MAX_JOYSTICKS)
         i = 0;
     joyState[i] = arg.state;
+    this->invalidateEventValues();
 }
 
 /* --- Key Events ------------------------------------------ */
 void InputEngine::ProcessKeyPress(const OIS::KeyEvent& arg)
 {
     keyState[arg.key] = 1;
+    this->invalidateEventValues();
 }
 
 void InputEngine::ProcessKeyRelease(const OIS::KeyEvent& arg)
 {
     keyState[arg.key] = 0;
+    this->invalidateEventValues();
 }
 
 /* --- Mouse Events ------------------------------------------ */
 void InputEngine::ProcessMouseEvent(const OIS::MouseEvent& arg)
 {
     mouseState = arg.state;
+    this->invalidateEventValues();
 }
 
 /* --- Custom Methods ------------------------------------------ */
@@ -695,6 +704,7 @@ void InputEngine::resetKeys()
     {
         iter->second = false;
     }
+    this->invalidateEventValues();
 }
 
 bool InputEngine::getEventBoolValue(int eventID)
@@ -850,10 +860,10 @@ std::string InputEngine::composeEventConfigString(event_trigger_t const& trig)
 
 bool InputEngine::isEventDefined(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    if (t_vec.size() > 0)
+    auto itor = events.find(eventID);
+    if (itor != events.end() && itor->second.size() > 0)
     {
-        if (t_vec[0].eventtype != ET_NONE) // TODO: handle multiple mappings for one event code - currently we only check the first one.
+        if (itor->second[0].eventtype != ET_NONE) // TODO: handle multiple mappings for one event code - currently we only check the first one.
             return true;
     }
     return false;
@@ -861,10 +871,11 @@ bool InputEngine::isEventDefined(int eventID)
 
 int InputEngine::getKeboardKeyForCommand(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
-    for (std::vector<event_trigger_t>::iterator i = t_vec.begin(); i != t_vec.end(); i++)
+    auto itor = events.find(eventID);
+    if (itor == events.end())
+        return -1;
+    for (event_trigger_t const& t: itor->second)
     {
-        event_trigger_t t = *i;
         if (t.eventtype == ET_Keyboard)
             return t.keyCode;
     }
@@ -873,7 +884,10 @@ int InputEngine::getKeboardKeyForCommand(int eventID)
 
 bool InputEngine::isEventAnalog(int eventID)
 {
-    std::vector<event_trigger_t> t_vec = events[eventID];
+    auto itor = events.find(eventID);
+    if (itor == events.end())
+        return false;
+    const TriggerVec& t_vec = itor->second;
     if (t_vec.size() > 0)
     {
         //loop through all eventtypes, because we want to find a analog device wether it is the first device or not
@@ -900,12 +914,32 @@ bool InputEngine::isEventAnalog(int eventID)
 
 float InputEngine::getEventValue(int eventID, bool pure, InputSourceType valueSource /*= InputSourceType::IST_ANY*/)
 {
+    if (!pure && InputRecorder::IsReplaying())
+        return InputRecorder::GetReplayedEventValue(eventID, valueSource);
+
+    // The common query is cached; devices only change state within `Capture()`, so each event is evaluated once per frame
+    if (!pure && valueSource == InputSourceType::IST_ANY && eventID >= 0 && eventID < (int)m_event_values.size())
+    {
+        if (m_event_values_stamps[eventID] != m_event_values_generation)
+        {
+            m_event_values[eventID] = this->evaluateEvent(eventID, pure, valueSource);
+            m_event_values_stamps[eventID] = m_event_values_generation;
+        }
+        return m_event_values[eventID];
+    }
+    return this->evaluateEvent(eventID, pure, valueSource);
+}
+
+float InputEngine::evaluateEvent(int eventID, bool pure, InputSourceType valueSource)
+{
+    auto itor = events.find(eventID);
+    if (itor == events.end())
+        return 0.f;
+
     float returnValue = 0;
-    std::vector<event_trigger_t> t_vec = events[eventID];
     float value = 0;
-    for (std::vector<event_trigger_t>::iterator i = t_vec.begin(); i != t_vec.end(); i++)
+    for (event_trigger_t const& t: itor->second)
     {
-        event_trigger_t t = *i;
 
         if (valueSource == InputSourceType::IST_DIGITAL || valueSource == InputSourceType::IST_ANY)
         {
@@ -1186,6 +1220,7 @@ void InputEngine::addEvent(int eventID, event_trigger_t& t)
         events[eventID].clear();
     }
     events[eventID].push_back(t);
+    this->invalidateEventValues();
 }
 
 void InputEngine::addEventDefault(int eventID, int deviceID /*= -1*/)
@@ -1209,6 +1244,7 @@ void InputEngine::updateEvent(int eventID, const event_trigger_t& t)
         events[eventID].clear();
     }
     events[eventID].push_back(t);
+    this->invalidateEventValues();
 }
 
 void InputEngine::eraseEvent(int eventID, const event_trigger_t* t)
@@ -1221,6 +1257,7 @@ void InputEngine::eraseEvent(int eventID, const event_trigger_t* t)
             if (t == &triggers[i])
             {
                 triggers.erase(triggers.begin() + i);
+                this->invalidateEventValues();
                 return;
             }
         }
@@ -1232,6 +1269,7 @@ void InputEngine::clearEvents(int eventID)
     if (events.find(eventID) != events.end())
     {
         events[eventID].clear();
+        this->invalidateEventValues();
     }
 }
 
@@ -1251,6 +1289,7 @@ void InputEngine::clearEventsByDevice(int deviceID)
             }
         }
     }
+    this->invalidateEventValues();
 }
 
 void InputEngine::clearAllEvents()
@@ -574,6 +574,13 @@ protected:
     // define event aliases
     std::map<int, std::vector<event_trigger_t>> events;
     std::map<int, float> event_times;
+
+    // Results of `getEventValue()` with default arguments, indexed by event ID.
+    // An entry is valid while its stamp matches the generation, which is bumped by
+    // `Capture()`, every device callback and every binding change.
+    std::vector<float>    m_event_values;
+    std::vector<uint32_t> m_event_values_stamps;
+    uint32_t              m_event_values_generation = 1;
     std::string m_loaded_configs[MAX_JOYSTICKS];
     bool loadMapping(Ogre::String fileName, int deviceID);
     bool saveMapping(Ogre::String fileName, int deviceID);
@@ -588,6 +595,8 @@ protected:
     float axisLinearity(float axisValue, float linearity);
 
     float logval(float val);
+    float evaluateEvent(int eventID, bool pure, InputSourceType valueSource); //!< Walks the triggers, see `getEventValue()`
+    void  invalidateEventValues() { m_event_values_generation++; }
     std::string getEventGroup(Ogre::String eventName);
     std::string composeEventConfigString(event_trigger_t const& trig);
     std::string composeEventCommandString(event_trigger_t const& trig);
@@ -0,0 +1,268 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "InputRecorder.h"
+
+#include "Application.h"
+#include "GameContext.h"
+#include "PlatformUtils.h"
+#include "SimBenchmark.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace RoR;
+
+bool         InputRecorder::s_recording = false;
+bool         InputRecorder::s_replaying = false;
+int          InputRecorder::s_frame = 0;
+std::fstream InputRecorder::s_file;
+std::string  InputRecorder::s_pending_line;
+std::vector<InputRecorder::EventValues> InputRecorder::s_values;
+std::vector<std::pair<int, std::string>> InputRecorder::s_pending_messages;
+
+static thread_local bool s_gui_scope = false;
+
+static const char* FILE_MAGIC = "rorinput 1";
+
+// File layout, one record per line:
+//   rorinput 1 | terrain <name> | vehicle <file> | steps <n>   (header)
+//   f <frame> <dt>                                             (starts a frame)
+//   e <event name> <any> <digital> <analog>                    (event values changed)
+//   m <type> <type name> <description>                         (payload-free GUI message)
+
+bool InputRecorder::Start()
+{
+    CreateFolder(App::sys_profiler_dir->getStr());
+    s_values.assign(EV_MODE_LAST, EventValues());
+    s_pending_messages.clear();
+    s_pending_line.clear();
+    s_frame = 0;
+
+    if (App::cli_input_record->getStr() != "")
+    {
+        const std::string path = PathCombine(App::sys_profiler_dir->getStr(), App::cli_input_record->getStr());
+        s_file.open(path, std::ios::out | std::ios::trunc);
+        if (!s_file.is_open())
+        {
+            RoR::LogFormat("[RoR|InputRecorder] Could not write '%s'", path.c_str());
+            return false;
+        }
+        s_file << std::setprecision(9); // Floats round-trip exactly
+        s_file << FILE_MAGIC << "\n";
+        s_file << "terrain " << App::sim_terrain_name->getStr() << "\n";
+        s_file << "vehicle " << App::cli_preset_vehicle->getStr() << "\n";
+        s_file << "steps " << App::sim_deterministic_steps->getInt() << "\n";
+        RoR::LogFormat("[RoR|InputRecorder] Recording to '%s'", path.c_str());
+        s_recording = true;
+        return true;
+    }
+
+    const std::string path = PathCombine(App::sys_profiler_dir->getStr(), App::cli_input_replay->getStr());
+    s_file.open(path, std::ios::in);
+    std::string line;
+    if (!s_file.is_open() || !std::getline(s_file, line) || line != FILE_MAGIC)
+    {
+        RoR::LogFormat("[RoR|InputRecorder] '%s' is not an input recording", path.c_str());
+        s_file.close();
+        return false;
+    }
+    while (std::getline(s_file, line) && line.compare(0, 2, "f ") != 0)
+    {
+        std::string key, value;
+        std::istringstream header(line);
+        header >> key;
+        std::getline(header >> std::ws, value);
+        if (key == "terrain" && value != App::sim_terrain_name->getStr())
+        {
+            RoR::LogFormat("[RoR|InputRecorder] Warning: recorded on terrain '%s', replaying on '%s'",
+                value.c_str(), App::sim_terrain_name->getStr().c_str());
+        }
+        else if (key == "vehicle" && value != App::cli_preset_vehicle->getStr())
+        {
+            RoR::LogFormat("[RoR|InputRecorder] Warning: recorded with vehicle '%s', replaying with '%s'",
+                value.c_str(), App::cli_preset_vehicle->getStr().c_str());
+        }
+        else if (key == "steps")
+        {
+            App::sim_deterministic_steps->setVal(Ogre::StringConverter::parseInt(value));
+        }
+    }
+    s_pending_line = line;
+    RoR::LogFormat("[RoR|InputRecorder] Replaying '%s'", path.c_str());
+    s_replaying = true;
+    return true;
+}
+
+bool InputRecorder::ReadFrame()
+{
+    if (s_pending_line.compare(0, 2, "f ") != 0)
+        return false;
+
+    s_pending_messages.clear();
+    std::string line;
+    while (std::getline(s_file, line) && line.compare(0, 2, "f ") != 0)
+    {
+        std::istringstream record(line.substr(2));
+        if (line.compare(0, 2, "e ") == 0)
+        {
+            std::string name;
+            EventValues values;
+            record >> name >> values.any >> values.digital >> values.analog;
+            const int event_id = InputEngine::resolveEventName(name);
+            if (event_id >= 0 && event_id < (int)s_values.size())
+            {
+                s_values[event_id] = values;
+            }
+        }
+        else if (line.compare(0, 2, "m ") == 0)
+        {
+            int type = MSG_INVALID;
+            std::string type_name, description;
+            record >> type >> type_name;
+            std::getline(record, description);
+            s_pending_messages.emplace_back(type, (description.empty()) ? "" : description.substr(1));
+        }
+    }
+    s_pending_line = (s_file) ? line : "";
+    return true;
+}
+
+void InputRecorder::Stop()
+{
+    RoR::LogFormat("[RoR|InputRecorder] %s finished after %d frames", (s_recording) ? "Recording" : "Replay", s_frame);
+    s_file.close();
+    s_recording = false;
+    s_replaying = false;
+    App::cli_input_record->setStr("");
+    App::cli_input_replay->setStr("");
+}
+
+float InputRecorder::UpdateFrameTime(float dt)
+{
+    if (!s_recording && !s_replaying)
+    {
+        if ((App::cli_input_record->getStr() == "" && App::cli_input_replay->getStr() == "") ||
+            !SimBenchmark::IsSceneReady())
+        {
+            return dt;
+        }
+        if (!InputRecorder::Start())
+        {
+            App::cli_input_record->setStr("");
+            App::cli_input_replay->setStr("");
+            return dt;
+        }
+    }
+
+    if (App::app_state->getEnum<AppState>() != AppState::SIMULATION)
+    {
+        InputRecorder::Stop(); // Terrain was left, the session is over
+        return dt;
+    }
+
+    if (s_recording)
+    {
+        s_file << "f " << ++s_frame << " " << dt << "\n";
+        return dt;
+    }
+
+    std::istringstream header(s_pending_line.substr(2));
+    int frame = 0;
+    float recorded_dt = dt;
+    header >> frame >> recorded_dt;
+    if (!InputRecorder::ReadFrame())
+    {
+        InputRecorder::Stop();
+        return dt;
+    }
+    s_frame = frame;
+    for (auto& msg: s_pending_messages)
+    {
+        App::GetGameContext()->PushMessage(Message(static_cast<MsgType>(msg.first), msg.second));
+    }
+    return recorded_dt;
+}
+
+void InputRecorder::RecordEvents()
+{
+    if (!s_recording)
+        return;
+
+    for (int i = 0; i < (int)s_values.size(); i++)
+    {
+        EventValues values;
+        values.any     = App::GetInputEngine()->getEventValue(i);
+        values.digital = App::GetInputEngine()->getEventValue(i, false, InputSourceType::IST_DIGITAL);
+        values.analog  = App::GetInputEngine()->getEventValue(i, false, InputSourceType::IST_ANALOG);
+        if (values.any != s_values[i].any || values.digital != s_values[i].digital || values.analog != s_values[i].analog)
+        {
+            s_file << "e " << InputEngine::eventIDToName(i) << " " << values.any << " " << values.digital << " " << values.analog << "\n";
+            s_values[i] = values;
+        }
+    }
+}
+
+bool InputRecorder::FilterMessage(Message const& m)
+{
+    // Input events are replayed as such and re-create their messages, so only GUI clicks need recording
+    if (!s_gui_scope)
+        return true;
+
+    if (s_recording)
+    {
+        if (m.payload != nullptr)
+        {
+            RoR::LogFormat("[RoR|InputRecorder] Warning: frame %d, message %d carries data and can't be recorded, the replay will differ",
+                s_frame, static_cast<int>(m.type));
+        }
+        else
+        {
+            std::string description = m.description;
+            std::replace(description.begin(), description.end(), '\n', ' ');
+            const std::string type_name = MsgTypeToString(m.type);
+            s_file << "m " << static_cast<int>(m.type) << " " << ((type_name.empty()) ? "?" : type_name) << " " << description << "\n";
+        }
+        return true;
+    }
+
+    return !s_replaying; // The recording has them
+}
+
+void InputRecorder::SetGuiScope(bool active)
+{
+    s_gui_scope = active;
+}
+
+float InputRecorder::GetReplayedEventValue(int eventID, InputSourceType valueSource)
+{
+    if (eventID < 0 || eventID >= (int)s_values.size())
+        return 0.f;
+
+    switch (valueSource)
+    {
+    case InputSourceType::IST_DIGITAL: return s_values[eventID].digital;
+    case InputSourceType::IST_ANALOG:  return s_values[eventID].analog;
+    default:                           return s_values[eventID].any;
+    }
+}
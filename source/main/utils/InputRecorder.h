@@ -0,0 +1,78 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include "InputEngine.h"
+
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace RoR {
+
+struct Message;
+
+/// @addtogroup Application
+/// @{
+
+/// Input recording requested by command line option `-record <file>`, played back by `-replay <file>`.
+/// Both run in `sim_deterministic` mode and start once the terrain and the preset vehicle are in
+/// (see `SimBenchmark::IsSceneReady()`), then count frames. Each frame stores the frame time,
+/// the input event values which changed (any/digital/analog, see `InputSourceType`) and the
+/// messages pushed by GUI clicks, which aren't input events. On replay, these replace the live
+/// values, so together with `-benchmark-time` a reported slowdown can be profiled repeatedly.
+/// Files are plain text in the profiler directory.
+class InputRecorder
+{
+public:
+    static float       UpdateFrameTime(float dt); //!< Call once per frame with the measured frame time, returns the one to use.
+    static void        RecordEvents();            //!< Call after `InputEngine::Capture()`
+    static bool        FilterMessage(Message const& m); //!< Called by `GameContext::PushMessage()`; false = drop.
+    static void        SetGuiScope(bool active);  //!< Marks messages pushed on this thread as coming from the GUI.
+    static bool        IsReplaying() { return s_replaying; }
+    static float       GetReplayedEventValue(int eventID, InputSourceType valueSource);
+
+private:
+    struct EventValues
+    {
+        float any = 0.f;
+        float digital = 0.f;
+        float analog = 0.f;
+    };
+
+    static bool        Start();
+    static bool        ReadFrame();
+    static void        Stop();
+
+    static bool        s_recording;
+    static bool        s_replaying;
+    static int         s_frame;
+    static std::fstream s_file;
+    static std::string s_pending_line; //!< Replay: the next frame's header, already read.
+    static std::vector<EventValues> s_values;
+    static std::vector<std::pair<int, std::string>> s_pending_messages; //!< Replay: GUI messages of the current frame, type + description.
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
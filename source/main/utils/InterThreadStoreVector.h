@@ -36,10 +36,11 @@ public:
         store.push_back(v);
     }
 
-    void pull(std::vector<T>& res)
+    template <class Alloc>
+    void pull(std::vector<T, Alloc>& res)
     {
         std::lock_guard<std::mutex> lock(m_vector_mutex);
-        res = store;
+        res.assign(std::make_move_iterator(store.begin()), std::make_move_iterator(store.end()));
         store.clear();
     }
 
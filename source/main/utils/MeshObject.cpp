@@ -32,14 +32,136 @@
 using namespace Ogre;
 using namespace RoR;
 
-MeshObject::MeshObject(Ogre::String meshName, Ogre::String entityRG, Ogre::String entityName, Ogre::SceneNode* m_scene_node)
+/// Meshes being prepared (read from disk) by `Ogre::ResourceBackgroundQueue`, with all objects waiting for them.
+/// The queue reports completion on the main thread, where the mesh is loaded once and the entities are created.
+class MeshBackgroundLoader: public ResourceBackgroundQueue::Listener
+{
+public:
+    void Enqueue(MeshObject* mo, std::string const& mesh_name, std::string const& group)
+    {
+        const std::string key = group + "/" + mesh_name;
+        auto found = m_waiters.find(key);
+        if (found != m_waiters.end())
+        {
+            found->second.push_back(mo);
+            return;
+        }
+
+        m_waiters[key].push_back(mo);
+        BackgroundProcessTicket ticket = ResourceBackgroundQueue::getSingleton().prepare(
+            MeshManager::getSingleton().getResourceType(), mesh_name, group, false, nullptr, nullptr, this);
+        m_tickets[ticket] = key;
+    }
+
+    void Cancel(MeshObject* mo)
+    {
+        for (auto& waiters : m_waiters)
+        {
+            waiters.second.erase(std::remove(waiters.second.begin(), waiters.second.end(), mo), waiters.second.end());
+        }
+    }
+
+    void operationCompleted(BackgroundProcessTicket ticket, const BackgroundProcessResult& result) override
+    {
+        auto found_ticket = m_tickets.find(ticket);
+        if (found_ticket == m_tickets.end())
+            return;
+
+        auto found = m_waiters.find(found_ticket->second);
+        std::vector<MeshObject*> waiters = std::move(found->second);
+        m_waiters.erase(found);
+        m_tickets.erase(found_ticket);
+
+        if (result.error)
+        {
+            LogFormat("[RoR] Error preparing mesh in background, message: %s", result.message.c_str());
+        }
+        for (MeshObject* mo : waiters)
+        {
+            mo->finishBackgroundLoad(!result.error);
+        }
+    }
+
+private:
+    std::unordered_map<std::string, std::vector<MeshObject*>> m_waiters; //!< Key: 'group/mesh'
+    std::map<BackgroundProcessTicket, std::string> m_tickets;
+};
+
+static MeshBackgroundLoader g_mesh_background_loader;
+
+MeshObject::MeshObject(Ogre::String meshName, Ogre::String entityRG, Ogre::String entityName, Ogre::SceneNode* m_scene_node, bool background)
     : m_scene_node(m_scene_node)
     , m_entity(nullptr)
     , m_cast_shadows(true)
+    , m_mesh_name(meshName)
+    , m_entity_rg(entityRG)
+    , m_entity_name(entityName)
 {
+    MeshPtr existing = MeshManager::getSingleton().getByName(meshName, entityRG);
+    if (background && m_scene_node && (!existing || !existing->isLoaded()))
+    {
+        m_loading = true;
+        g_mesh_background_loader.Enqueue(this, meshName, entityRG);
+        return;
+    }
+
     this->createEntity(meshName, entityRG, entityName);
 }
 
+MeshObject::~MeshObject()
+{
+    if (m_loading)
+    {
+        g_mesh_background_loader.Cancel(this);
+    }
+}
+
+void MeshObject::finishBackgroundLoad(bool success)
+{
+    m_loading = false;
+    if (success)
+    {
+        // The file is already in memory; this only parses it and creates the buffers
+        this->createEntity(m_mesh_name, m_entity_rg, m_entity_name);
+    }
+}
+
+void MeshObject::setRenderingDistance(float dist)
+{
+    m_rendering_distance = dist;
+    if (m_entity)
+    {
+        m_entity->setRenderingDistance(dist);
+    }
+}
+
+void MeshObject::uniquifyMaterials(std::string const& suffix)
+{
+    m_material_suffix = suffix;
+    if (m_entity)
+    {
+        this->applyEntitySettings();
+    }
+}
+
+void MeshObject::applyEntitySettings()
+{
+    m_entity->setCastShadows(m_cast_shadows);
+    m_entity->setRenderingDistance(m_rendering_distance);
+
+    if (!m_material_suffix.empty())
+    {
+        for (unsigned int i = 0; i < m_entity->getNumSubEntities(); i++)
+        {
+            SubEntity* se = m_entity->getSubEntity(i);
+            String newmatname = se->getMaterialName() + "/" + m_material_suffix;
+            se->getMaterial()->clone(newmatname);
+            se->setMaterialName(newmatname);
+        }
+        m_material_suffix.clear(); // Don't clone the clones
+    }
+}
+
 void MeshObject::setMaterialName(Ogre::String m)
 {
     if (m_entity)
@@ -51,7 +173,11 @@ void MeshObject::setMaterialName(Ogre::String m)
 void MeshObject::setCastShadows(bool b)
 {
     m_cast_shadows = b;
-    if (m_scene_node && m_scene_node->numAttachedObjects())
+    if (m_entity)
+    {
+        m_entity->setCastShadows(b);
+    }
+    else if (m_scene_node && m_scene_node->numAttachedObjects())
     {
         m_scene_node->getAttachedObject(0)->setCastShadows(b);
     }
@@ -111,7 +237,7 @@ void MeshObject::createEntity(Ogre::String meshName, Ogre::String entityRG, Ogre
         // now create an entity around the mesh and attach it to the scene graph
 
         m_entity = App::GetGfxScene()->GetSceneManager()->createEntity(entityName, meshName, entityRG);
-        m_entity->setCastShadows(m_cast_shadows);
+        this->applyEntitySettings();
 
         m_scene_node->attachObject(m_entity);
         m_scene_node->setVisible(true);
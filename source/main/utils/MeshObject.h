@@ -35,22 +35,37 @@
 class MeshObject
 {
 public:
-    MeshObject(Ogre::String meshName, Ogre::String entityRG, Ogre::String entityName, Ogre::SceneNode* sceneNode);
+    /// @param background If the mesh isn't loaded yet, read it via `Ogre::ResourceBackgroundQueue` and create the entity
+    ///                   once it's ready (see `isLoading()`); objects waiting for the same mesh share one request.
+    MeshObject(Ogre::String meshName, Ogre::String entityRG, Ogre::String entityName, Ogre::SceneNode* sceneNode, bool background = false);
+    ~MeshObject();
 
     void setMaterialName(Ogre::String m);
     void setCastShadows(bool b);
     void setVisible(bool b);
+    void setRenderingDistance(float dist);                  //!< Applied once the entity exists
+    void uniquifyMaterials(std::string const& suffix);       //!< Clones the materials as 'name/suffix'; applied once the entity exists
+    bool isLoading() const { return m_loading; }
     inline Ogre::Entity*    getEntity() { return m_entity; };
     inline Ogre::SceneNode* GetSceneNode() { return m_scene_node; }
     inline Ogre::MeshPtr    getLoadedMesh() { return m_mesh; }
 
+    void finishBackgroundLoad(bool success); //!< Called by the background queue listener, main thread
+
 protected:
     Ogre::SceneNode* m_scene_node = nullptr;
     Ogre::Entity* m_entity = nullptr;
     Ogre::MeshPtr m_mesh;
     bool m_cast_shadows = false;
+    bool m_loading = false;
+    float m_rendering_distance = 0.f;
+    std::string m_material_suffix;
+    std::string m_mesh_name;
+    std::string m_entity_rg;
+    std::string m_entity_name;
 
     void createEntity(Ogre::String meshName, Ogre::String entityRG, Ogre::String entityName);
+    void applyEntitySettings();
 };
 
 /// @} // @addtogroup Gfx
@@ -32,6 +32,10 @@
     #include <shlobj.h> // SHGetFolderPathW()
     #include <shellapi.h> // ShellExecute()
 #else
+    #include <pthread.h> // pthread_setaffinity_np()
+    #include <sched.h>
+    #include <sys/resource.h> // setpriority()
+    #include <sys/syscall.h>
     #include <sys/types.h>
     #include <sys/stat.h>
     #include <unistd.h> // readlink()
@@ -39,7 +43,13 @@
 
 #include <OgrePlatform.h>
 #include <OgreFileSystem.h>
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <set>
 #include <string>
+#include <thread>
 
 namespace RoR {
 
@@ -122,6 +132,22 @@ void CreateFolder(const char* path)
     }
 }
 
+uint64_t GetFileSizeBytes(const char* path)
+{
+    if (path == nullptr || path[0] == 0)
+    {
+        return 0;
+    }
+
+    std::wstring wpath = MSW_Utf8ToWchar(path);
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExW(wpath.c_str(), GetFileExInfoStandard, &data))
+    {
+        return 0;
+    }
+    return (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+}
+
 std::string GetUserHomeDirectory()
 {
     std::wstring out_wstr(MAX_PATH, 0); // Length limit imposed by the function, see https://msdn.microsoft.com/en-us/library/windows/desktop/bb762181(v=vs.85).aspx
@@ -154,6 +180,77 @@ void OpenUrlInDefaultBrowser(std::string const& url)
     ::ShellExecute(0, 0, url.c_str(), 0, 0 , SW_SHOW );
 }
 
+// -------------------------- CPU topology for MS Windows --------------------------
+
+static CpuTopology DetectCpuTopology()
+{
+    CpuTopology topo;
+    topo.logical_cores = static_cast<int>(std::thread::hardware_concurrency());
+
+    DWORD len = 0;
+    ::GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &len);
+    std::vector<char> buf(len);
+    if (len == 0 || !::GetLogicalProcessorInformationEx(RelationProcessorCore, (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)buf.data(), &len))
+    {
+        return topo;
+    }
+
+    // One entry per physical core; `EfficiencyClass` is 0 everywhere unless the CPU is hybrid, higher is faster.
+    // Only processor group 0 is considered, the same as the default affinity of a process.
+    std::vector<std::pair<int, KAFFINITY>> cores;
+    for (DWORD offset = 0; offset < len; )
+    {
+        auto* info = (PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX)(buf.data() + offset);
+        if (info->Relationship == RelationProcessorCore && info->Processor.GroupMask[0].Group == 0)
+        {
+            cores.push_back(std::make_pair(static_cast<int>(info->Processor.EfficiencyClass), info->Processor.GroupMask[0].Mask));
+        }
+        offset += info->Size;
+    }
+
+    int max_class = 0, min_class = INT_MAX;
+    for (auto& core: cores)
+    {
+        max_class = std::max(max_class, core.first);
+        min_class = std::min(min_class, core.first);
+    }
+    topo.physical_cores = static_cast<int>(cores.size());
+    topo.hybrid = !cores.empty() && max_class != min_class;
+    for (auto& core: cores)
+    {
+        for (int cpu = 0; cpu < static_cast<int>(sizeof(KAFFINITY) * 8); cpu++)
+        {
+            if (core.first == max_class && (core.second & ((KAFFINITY)1 << cpu)))
+                topo.performance_cpus.push_back(cpu);
+        }
+    }
+    std::sort(topo.performance_cpus.begin(), topo.performance_cpus.end());
+    return topo;
+}
+
+bool PinCurrentThread(std::vector<int> const& cpus)
+{
+    DWORD_PTR mask = 0;
+    for (int cpu: cpus)
+    {
+        if (cpu < static_cast<int>(sizeof(DWORD_PTR) * 8))
+            mask |= (DWORD_PTR)1 << cpu;
+    }
+    return mask != 0 && ::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0;
+}
+
+bool SetCurrentThreadPriority(ThreadPriority priority)
+{
+    int value = THREAD_PRIORITY_NORMAL;
+    switch (priority)
+    {
+    case ThreadPriority::BACKGROUND: value = THREAD_PRIORITY_BELOW_NORMAL; break;
+    case ThreadPriority::HIGH:       value = THREAD_PRIORITY_ABOVE_NORMAL; break;
+    default:;
+    }
+    return ::SetThreadPriority(::GetCurrentThread(), value) != 0;
+}
+
 #else
 
 // -------------------------- File/path utils for Linux/*nix --------------------------
@@ -177,6 +274,12 @@ void CreateFolder(const char* path)
     mkdir(path, S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
 }
 
+uint64_t GetFileSizeBytes(const char* path)
+{
+    struct stat st;
+    return (stat(path, &st) == 0) ? static_cast<uint64_t>(st.st_size) : 0;
+}
+
 std::string GetUserHomeDirectory()
 {
     return getenv("HOME");
@@ -202,6 +305,105 @@ void OpenUrlInDefaultBrowser(std::string const& url)
     ::system(buf.c_str());
 }
 
+// -------------------------- CPU topology for Linux --------------------------
+
+static bool ReadSysfsInt(std::string const& path, int& out_value)
+{
+    std::ifstream file(path);
+    return static_cast<bool>(file >> out_value);
+}
+
+/// Parses kernel CPU lists like "0-7,16-23"
+static std::vector<int> ReadSysfsCpuList(std::string const& path)
+{
+    std::vector<int> cpus;
+    std::ifstream file(path);
+    std::string list;
+    if (!std::getline(file, list))
+        return cpus;
+
+    size_t pos = 0;
+    while (pos < list.size())
+    {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+            end = list.size();
+        const std::string range = list.substr(pos, end - pos);
+        const size_t dash = range.find('-');
+        const int first = std::atoi(range.c_str());
+        const int last = (dash != std::string::npos) ? std::atoi(range.c_str() + dash + 1) : first;
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+static CpuTopology DetectCpuTopology()
+{
+    CpuTopology topo;
+    topo.logical_cores = static_cast<int>(std::thread::hardware_concurrency());
+
+    std::set<std::pair<int, int>> cores; // (package, core)
+    std::vector<int> capacities;
+    for (int cpu = 0; cpu < topo.logical_cores; cpu++)
+    {
+        const std::string dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+        int package = 0, core = cpu, capacity = 0;
+        ReadSysfsInt(dir + "/topology/physical_package_id", package);
+        ReadSysfsInt(dir + "/topology/core_id", core);
+        cores.insert(std::make_pair(package, core));
+        capacities.push_back(ReadSysfsInt(dir + "/cpu_capacity", capacity) ? capacity : 0);
+    }
+    topo.physical_cores = static_cast<int>(cores.size());
+
+    // Intel hybrid CPUs expose the core types as separate PMUs; big.LITTLE reports per-CPU capacity instead.
+    const std::vector<int> intel_pcores = ReadSysfsCpuList("/sys/devices/cpu_core/cpus");
+    const int max_capacity = capacities.empty() ? 0 : *std::max_element(capacities.begin(), capacities.end());
+    if (!intel_pcores.empty() && FileExists("/sys/devices/cpu_atom/cpus"))
+    {
+        topo.hybrid = true;
+        topo.performance_cpus = intel_pcores;
+    }
+    else
+    {
+        for (int cpu = 0; cpu < topo.logical_cores; cpu++)
+        {
+            if (capacities[cpu] == max_capacity)
+                topo.performance_cpus.push_back(cpu);
+        }
+        topo.hybrid = static_cast<int>(topo.performance_cpus.size()) < topo.logical_cores;
+    }
+    return topo;
+}
+
+bool PinCurrentThread(std::vector<int> const& cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu: cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+    }
+    return CPU_COUNT(&set) > 0 && pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+}
+
+bool SetCurrentThreadPriority(ThreadPriority priority)
+{
+    // Linux threads have their own nice value; going below 0 needs CAP_SYS_NICE or a raised RLIMIT_NICE.
+    int nice = 0;
+    switch (priority)
+    {
+    case ThreadPriority::BACKGROUND: nice = 5;  break;
+    case ThreadPriority::HIGH:       nice = -5; break;
+    default:;
+    }
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), nice) == 0;
+}
+
 #endif // _MSC_VER
 
 // -------------------------- File/path common utils --------------------------
@@ -243,4 +445,26 @@ std::time_t GetFileLastModifiedTime(std::string const & path)
     factory.destroyInstance(fs_archive);
     return time;
 }
+
+// -------------------------- CPU topology common utils --------------------------
+
+CpuTopology const& GetCpuTopology()
+{
+    static const CpuTopology topo = []
+    {
+        CpuTopology t = DetectCpuTopology();
+        // Fill the gaps if the OS didn't tell us
+        t.logical_cores = std::max(t.logical_cores, 1);
+        if (t.physical_cores < 1 || t.physical_cores > t.logical_cores)
+            t.physical_cores = t.logical_cores;
+        if (t.performance_cpus.empty())
+        {
+            t.hybrid = false;
+            for (int cpu = 0; cpu < t.logical_cores; cpu++)
+                t.performance_cpus.push_back(cpu);
+        }
+        return t;
+    }();
+    return topo;
+}
 } // namespace RoR
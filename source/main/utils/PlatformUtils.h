@@ -27,8 +27,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <ctime>
+#include <vector>
 
 namespace RoR {
 
@@ -41,9 +43,12 @@ bool FileExists(const char* path);   //!< Path must be UTF-8 encoded.
 bool FolderExists(const char* path); //!< Path must be UTF-8 encoded.
 void CreateFolder(const char* path); //!< Path must be UTF-8 encoded.
 
+uint64_t GetFileSizeBytes(const char* path); //!< Path must be UTF-8 encoded. Returns 0 if there's no such file.
+
 inline bool FileExists(std::string const& path)   { return FileExists(path.c_str()); }
 inline bool FolderExists(std::string const& path) { return FolderExists(path.c_str()); }
 inline void CreateFolder(std::string const& path) { CreateFolder(path.c_str()); }
+inline uint64_t GetFileSizeBytes(std::string const& path) { return GetFileSizeBytes(path.c_str()); }
 
 inline std::string PathCombine(std::string a, std::string b) { return a + PATH_SLASH + b; };
 
@@ -55,6 +60,27 @@ std::time_t GetFileLastModifiedTime(std::string const & path);
 
 void OpenUrlInDefaultBrowser(std::string const& url);
 
+// -------------------------- CPU topology and thread placement --------------------------
+
+struct CpuTopology
+{
+    int              logical_cores = 0;
+    int              physical_cores = 0;
+    std::vector<int> performance_cpus; //!< Logical CPU indices on performance cores; all of them unless the CPU is hybrid.
+    bool             hybrid = false;   //!< Has both performance and efficiency cores.
+};
+
+enum class ThreadPriority
+{
+    BACKGROUND, //!< Loading, caching - may wait
+    NORMAL,
+    HIGH        //!< Simulation - usually needs elevated privileges on Linux, then it's ignored.
+};
+
+CpuTopology const& GetCpuTopology(); //!< Detected on first use.
+bool PinCurrentThread(std::vector<int> const& cpus); //!< Restricts the calling thread to the given logical CPUs; returns false on failure.
+bool SetCurrentThreadPriority(ThreadPriority priority); //!< Returns false on failure.
+
 /// @} // addtogroup Application
 
 } // namespace RoR
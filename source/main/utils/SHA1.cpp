@@ -34,6 +34,18 @@
 
 #include "SHA1.h"
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SHA1_X86_SHA_EXTENSIONS
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SHA1_TARGET_SHA_EXTENSIONS
+#else
+#include <cpuid.h>
+#include <immintrin.h>
+#define SHA1_TARGET_SHA_EXTENSIONS __attribute__((target("sha,sse4.1,ssse3")))
+#endif
+#endif
+
 using namespace RoR;
 
 #ifdef SHA1_UTILITY_FUNCTIONS
@@ -66,6 +78,89 @@ using namespace RoR;
 #define _R3(v,w,x,y,z,i) { z+=(((w|x)&y)|(w&x))+SHABLK(i)+0x8F1BBCDC+ROL32(v,5); w=ROL32(w,30); }
 #define _R4(v,w,x,y,z,i) { z+=(w^x^y)+SHABLK(i)+0xCA62C1D6+ROL32(v,5); w=ROL32(w,30); }
 
+#ifdef SHA1_X86_SHA_EXTENSIONS
+
+// Intel SHA extensions (SHA-NI); available on AMD Zen and Intel since Goldmont/Ice Lake.
+// The hardware does 4 rounds per instruction and schedules the message itself;
+// `Ea`/`Eb` alternate, `Mc` is the current message quad, `Mn`/`Mnn`/`Mp` the next/after-next/previous.
+#define _RNI(Ea,Eb,Mc,Mn,Mnn,Mp,f) { Ea=_mm_sha1nexte_epu32(Ea,Mc); Eb=abcd; Mn=_mm_sha1msg2_epu32(Mn,Mc); \
+    abcd=_mm_sha1rnds4_epu32(abcd,Ea,f); Mp=_mm_sha1msg1_epu32(Mp,Mc); Mnn=_mm_xor_si128(Mnn,Mc); }
+
+static bool DetectShaExtensions()
+{
+    // SSSE3 and SSE4.1 are implied by every CPU with SHA extensions, but check anyway
+    int leaf1[4] = {}, leaf7[4] = {};
+#ifdef _MSC_VER
+    __cpuid(leaf1, 0);
+    if (leaf1[0] < 7)
+        return false;
+    __cpuid(leaf1, 1);
+    __cpuidex(leaf7, 7, 0);
+#else
+    if (__get_cpuid_max(0, nullptr) < 7)
+        return false;
+    __cpuid(1, leaf1[0], leaf1[1], leaf1[2], leaf1[3]);
+    __cpuid_count(7, 0, leaf7[0], leaf7[1], leaf7[2], leaf7[3]);
+#endif
+    const bool ssse3 = (leaf1[2] & (1 << 9)) != 0;
+    const bool sse41 = (leaf1[2] & (1 << 19)) != 0;
+    const bool sha = (leaf7[1] & (1 << 29)) != 0;
+    return ssse3 && sse41 && sha;
+}
+
+static const bool s_has_sha_extensions = DetectShaExtensions();
+
+SHA1_TARGET_SHA_EXTENSIONS
+static void TransformShaExtensions(uint32_t* state, const uint8_t* data, uint32_t num_blocks)
+{
+    const __m128i byteswap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    __m128i abcd = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)state), 0x1B);
+    __m128i e0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+    __m128i e1, m0, m1, m2, m3;
+
+    for (uint32_t n = 0; n < num_blocks; n++, data += 64)
+    {
+        const __m128i abcd_saved = abcd;
+        const __m128i e0_saved = e0;
+
+        // Rounds 0-15 also load the message
+        m0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data +  0)), byteswap);
+        e0 = _mm_add_epi32(e0, m0);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+
+        m1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 16)), byteswap);
+        e1 = _mm_sha1nexte_epu32(e1, m1);
+        e0 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e1, 0);
+        m0 = _mm_sha1msg1_epu32(m0, m1);
+
+        m2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 32)), byteswap);
+        e0 = _mm_sha1nexte_epu32(e0, m2);
+        e1 = abcd;
+        abcd = _mm_sha1rnds4_epu32(abcd, e0, 0);
+        m1 = _mm_sha1msg1_epu32(m1, m2);
+        m0 = _mm_xor_si128(m0, m2);
+
+        m3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(data + 48)), byteswap);
+        _RNI(e1,e0,m3,m0,m1,m2,0);
+
+        // Rounds 16-79; the message schedule of the last few is computed but not used
+        _RNI(e0,e1,m0,m1,m2,m3,0); _RNI(e1,e0,m1,m2,m3,m0,1); _RNI(e0,e1,m2,m3,m0,m1,1); _RNI(e1,e0,m3,m0,m1,m2,1);
+        _RNI(e0,e1,m0,m1,m2,m3,1); _RNI(e1,e0,m1,m2,m3,m0,1); _RNI(e0,e1,m2,m3,m0,m1,2); _RNI(e1,e0,m3,m0,m1,m2,2);
+        _RNI(e0,e1,m0,m1,m2,m3,2); _RNI(e1,e0,m1,m2,m3,m0,2); _RNI(e0,e1,m2,m3,m0,m1,2); _RNI(e1,e0,m3,m0,m1,m2,3);
+        _RNI(e0,e1,m0,m1,m2,m3,3); _RNI(e1,e0,m1,m2,m3,m0,3); _RNI(e0,e1,m2,m3,m0,m1,3); _RNI(e1,e0,m3,m0,m1,m2,3);
+
+        e0 = _mm_sha1nexte_epu32(e0, e0_saved);
+        abcd = _mm_add_epi32(abcd, abcd_saved);
+    }
+
+    _mm_storeu_si128((__m128i*)state, _mm_shuffle_epi32(abcd, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(e0, 3);
+}
+
+#endif // SHA1_X86_SHA_EXTENSIONS
+
 CSHA1::CSHA1()
 {
     m_block = (SHA1_WORKSPACE_BLOCK *)m_workspace;
@@ -139,6 +234,21 @@ void CSHA1::Transform(uint32_t *state, uint8_t *buffer)
 #endif
 }
 
+void CSHA1::TransformBlocks(uint8_t *data, uint32_t num_blocks)
+{
+#ifdef SHA1_X86_SHA_EXTENSIONS
+    if (s_has_sha_extensions)
+    {
+        TransformShaExtensions(m_state, data, num_blocks);
+        return;
+    }
+#endif
+    for (uint32_t i = 0; i < num_blocks; i++)
+    {
+        Transform(m_state, &data[i * 64]);
+    }
+}
+
 // Use this function to hash in binary data and strings
 void CSHA1::UpdateHash(uint8_t *data, uint32_t len)
 {
@@ -154,9 +264,12 @@ void CSHA1::UpdateHash(uint8_t *data, uint32_t len)
     {
         i = 64 - j;
         memcpy(&m_buffer[j], data, i);
-        Transform(m_state, m_buffer);
+        TransformBlocks(m_buffer, 1);
 
-        for ( ; i + 63 < len; i += 64) Transform(m_state, &data[i]);
+        // All whole blocks in one go, so the accelerated path keeps the state in registers
+        const uint32_t num_blocks = (len - i) / 64;
+        TransformBlocks(&data[i], num_blocks);
+        i += num_blocks * 64;
 
         j = 0;
     }
@@ -174,10 +287,10 @@ void CSHA1::Final()
         finalcount[i] = (uint8_t)((m_count[((i >= 4) ? 0 : 1)]
             >> ((3 - (i & 3)) * 8) ) & 255); // Endian independent
 
-    UpdateHash((uint8_t *)"\200", 1);
-
-    while ((m_count[0] & 504) != 448)
-        UpdateHash((uint8_t *)"\0", 1);
+    // Pad with 0x80 and zeros up to 56 bytes modulo 64, in one update
+    uint8_t padding[64] = { 0x80 };
+    const uint32_t used = (m_count[0] >> 3) & 63;
+    UpdateHash(padding, (used < 56) ? (56 - used) : (120 - used));
 
     UpdateHash(finalcount, 8); // Cause a SHA1Transform()
 
@@ -193,7 +306,7 @@ void CSHA1::Final()
     memset(m_state, 0, 20);
     memset(m_count, 0, 8);
     memset(finalcount, 0, 8);
-    Transform(m_state, m_buffer);
+    memset(m_workspace, 0, 64);
 #endif
 }
 
@@ -113,6 +113,7 @@ public:
 private:
     // Private SHA-1 transformation
     void Transform(uint32_t* state, uint8_t* buffer);
+    void TransformBlocks(uint8_t* data, uint32_t num_blocks); // Uses the CPU's SHA extensions if available
 
     // Member variables
     uint8_t m_workspace[64];
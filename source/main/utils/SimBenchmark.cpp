@@ -0,0 +1,296 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SimBenchmark.h"
+
+#include "Actor.h"
+#include "ActorManager.h"
+#include "Application.h"
+#include "CameraManager.h"
+#include "Character.h"
+#include "GameContext.h"
+#include "PlatformUtils.h"
+#include "SimProfiler.h"
+#include "Terrain.h"
+#include "Utils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#ifdef _WIN32
+#   include <windows.h>
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+using namespace RoR;
+
+bool    SimBenchmark::s_running = false;
+int64_t SimBenchmark::s_begin_us = 0;
+int64_t SimBenchmark::s_begin_steps = 0;
+int64_t SimBenchmark::s_last_frame_us = 0;
+std::vector<float> SimBenchmark::s_frame_ms;
+std::vector<float> SimBenchmark::s_render_ms;
+
+static const float CAMERA_ORBIT_SEC = 20.f;   // One circle around the player
+static const float CAMERA_MIN_RADIUS = 15.f;  // Close to the vehicle, near the ground...
+static const float CAMERA_MAX_RADIUS = 150.f; // ...to a wide overview; once per run
+static const float CAMERA_MIN_HEIGHT = 3.f;
+static const float CAMERA_MAX_HEIGHT = 80.f;
+static const float HISTOGRAM_EDGES_MS[] = { 4.f, 8.f, 12.f, 16.7f, 20.f, 25.f, 33.3f, 50.f, 100.f };
+
+static int64_t GetPeakMemoryKb()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return static_cast<int64_t>(counters.PeakWorkingSetSize / 1024);
+    return -1;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+#   ifdef __APPLE__
+    return static_cast<int64_t>(usage.ru_maxrss / 1024); // Bytes on macOS
+#   else
+    return static_cast<int64_t>(usage.ru_maxrss);
+#   endif
+#endif
+}
+
+static float GetPercentile(std::vector<float> samples, float percentile)
+{
+    if (samples.empty())
+        return 0.f;
+
+    const size_t n = std::min(samples.size() - 1, static_cast<size_t>(percentile * samples.size()));
+    std::nth_element(samples.begin(), samples.begin() + n, samples.end());
+    return samples[n];
+}
+
+static void WriteTimeStats(rapidjson::Writer<rapidjson::StringBuffer>& j, std::vector<float> const& samples_ms)
+{
+    double sum = 0.0;
+    for (float ms: samples_ms)
+        sum += ms;
+
+    j.StartObject();
+    j.Key("mean"); j.Double(samples_ms.empty() ? 0.0 : sum / samples_ms.size());
+    j.Key("p50");  j.Double(GetPercentile(samples_ms, 0.50f));
+    j.Key("p95");  j.Double(GetPercentile(samples_ms, 0.95f));
+    j.Key("p99");  j.Double(GetPercentile(samples_ms, 0.99f));
+    j.Key("max");  j.Double(samples_ms.empty() ? 0.0 : *std::max_element(samples_ms.begin(), samples_ms.end()));
+    j.EndObject();
+}
+
+bool SimBenchmark::IsActive()
+{
+    return App::cli_benchmark_steps->getInt() > 0 || App::cli_benchmark_seconds->getFloat() > 0.f;
+}
+
+bool SimBenchmark::IsSceneReady()
+{
+    if (App::app_state->getEnum<AppState>() != AppState::SIMULATION ||
+        App::sim_state->getEnum<SimState>() != SimState::RUNNING)
+    {
+        return false;
+    }
+
+    // The preset vehicle is spawned via message queue, a few frames after the terrain
+    return App::cli_preset_vehicle->getStr() == "" ||
+           !App::GetGameContext()->GetActorManager()->GetActors().empty();
+}
+
+void SimBenchmark::Update()
+{
+    if (!SimBenchmark::IsActive())
+        return;
+
+    const int target_steps = App::cli_benchmark_steps->getInt();
+    const float target_sec = App::cli_benchmark_seconds->getFloat();
+    ActorManager* actor_manager = App::GetGameContext()->GetActorManager();
+    if (!s_running)
+    {
+        if (!IsSceneReady())
+            return;
+
+        if (target_steps > 0)
+            RoR::LogFormat("[RoR|Benchmark] Running %d physics steps", target_steps);
+        if (target_sec > 0.f)
+            RoR::LogFormat("[RoR|Benchmark] Running for %.1f seconds", target_sec);
+        SimProfiler::StartCapture();
+        s_running = true;
+        s_begin_us = SimProfiler::GetTimestampUs();
+        s_begin_steps = actor_manager->GetTotalSteps();
+        s_last_frame_us = s_begin_us;
+        s_frame_ms.clear();
+        s_render_ms.clear();
+        return;
+    }
+
+    const int64_t now_us = SimProfiler::GetTimestampUs();
+    s_frame_ms.push_back((now_us - s_last_frame_us) / 1000.f);
+    s_last_frame_us = now_us;
+
+    const float elapsed_sec = (now_us - s_begin_us) / 1000000.f;
+    SimBenchmark::UpdateCamera(elapsed_sec);
+
+    if ((target_steps > 0 && actor_manager->GetTotalSteps() - s_begin_steps >= target_steps) ||
+        (target_sec > 0.f && elapsed_sec >= target_sec))
+    {
+        actor_manager->SyncWithSimThread(); // The last steps may still be running
+        SimBenchmark::Finish();
+        App::cli_benchmark_steps->setVal(0);
+        App::cli_benchmark_seconds->setVal(0.f);
+        s_running = false;
+        App::GetGameContext()->PushMessage(Message(MSG_APP_SHUTDOWN_REQUESTED));
+    }
+}
+
+void SimBenchmark::ReportRenderTime(int64_t us)
+{
+    if (s_running)
+        s_render_ms.push_back(us / 1000.f);
+}
+
+void SimBenchmark::UpdateCamera(float elapsed_sec)
+{
+    // Nothing to see headless; with a custom script, the script drives the camera (i.e. `game.setCameraPosition()`)
+    if (App::cli_headless->getBool() || App::cli_custom_scripts->getStr() != "")
+        return;
+
+    const ActorPtr& player_actor = App::GetGameContext()->GetPlayerActor();
+    const Ogre::Vector3 focus = (player_actor != nullptr)
+        ? player_actor->getPosition()
+        : App::GetGameContext()->GetPlayerCharacter()->getPosition();
+
+    // Circles the player while moving out to an overview and back over the whole run,
+    // so both close-up detail and far terrain/water get drawn. Follows wall time, so runs
+    // of equal length see the same path regardless of the frame rate.
+    const float run_sec = (App::cli_benchmark_seconds->getFloat() > 0.f) ? App::cli_benchmark_seconds->getFloat() : CAMERA_ORBIT_SEC * 3.f;
+    const float angle = Ogre::Math::TWO_PI * elapsed_sec / CAMERA_ORBIT_SEC;
+    const float rise = 0.5f * (1.f - std::cos(Ogre::Math::TWO_PI * elapsed_sec / run_sec));
+    const float radius = CAMERA_MIN_RADIUS + (CAMERA_MAX_RADIUS - CAMERA_MIN_RADIUS) * rise;
+
+    Ogre::Vector3 pos = focus + Ogre::Vector3(std::cos(angle) * radius, 0.f, std::sin(angle) * radius);
+    pos.y = std::max(focus.y, App::GetGameContext()->GetTerrain()->GetHeightAt(pos.x, pos.z))
+        + CAMERA_MIN_HEIGHT + (CAMERA_MAX_HEIGHT - CAMERA_MIN_HEIGHT) * rise;
+
+    App::GetCameraManager()->GetCameraNode()->setPosition(pos);
+    App::GetCameraManager()->GetCameraNode()->lookAt(focus, Ogre::Node::TS_WORLD);
+}
+
+void SimBenchmark::Finish()
+{
+    ActorManager* actor_manager = App::GetGameContext()->GetActorManager();
+    const int64_t steps = actor_manager->GetTotalSteps() - s_begin_steps;
+    const double wall_sec = (SimProfiler::GetTimestampUs() - s_begin_us) / 1000000.0;
+
+    const std::time_t time = std::time(nullptr);
+    std::stringstream timestamp;
+    timestamp << std::put_time(std::localtime(&time), "%Y-%m-%d_%H-%M-%S");
+    CreateFolder(App::sys_profiler_dir->getStr());
+    const std::string trace_path  = PathCombine(App::sys_profiler_dir->getStr(), "benchmark_trace_" + timestamp.str() + ".json");
+    const std::string result_path = PathCombine(App::sys_profiler_dir->getStr(), "benchmark_" + timestamp.str() + ".json");
+
+    std::string summary;
+    std::vector<SimProfiler::ZoneTotal> zones;
+    SimProfiler::StopCapture(trace_path, summary, &zones);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> j(buffer);
+    j.StartObject();
+    j.Key("terrain");          j.String(App::sim_terrain_name->getStr().c_str());
+    j.Key("vehicle");          j.String(App::cli_preset_vehicle->getStr().c_str());
+    j.Key("steps");            j.Int64(steps);
+    j.Key("wall_seconds");     j.Double(wall_sec);
+    j.Key("steps_per_second"); j.Double((wall_sec > 0.0) ? steps / wall_sec : 0.0);
+    j.Key("peak_memory_kb");   j.Int64(GetPeakMemoryKb());
+    j.Key("frames");           j.Uint64(s_frame_ms.size());
+    j.Key("frame_ms");         WriteTimeStats(j, s_frame_ms);
+    j.Key("render_ms");        WriteTimeStats(j, s_render_ms); // Includes waiting for the GPU
+    j.Key("frame_ms_histogram");
+    j.StartArray();
+    const size_t num_edges = sizeof(HISTOGRAM_EDGES_MS) / sizeof(float);
+    std::vector<size_t> buckets(num_edges + 1, 0);
+    for (float ms: s_frame_ms)
+    {
+        buckets[std::upper_bound(HISTOGRAM_EDGES_MS, HISTOGRAM_EDGES_MS + num_edges, ms) - HISTOGRAM_EDGES_MS]++;
+    }
+    for (size_t i = 0; i <= num_edges; i++)
+    {
+        j.StartObject();
+        j.Key("below_ms"); (i < num_edges) ? j.Double(HISTOGRAM_EDGES_MS[i]) : j.Null();
+        j.Key("count");    j.Uint64(buckets[i]);
+        j.EndObject();
+    }
+    j.EndArray();
+    j.Key("actors");
+    j.StartArray();
+    for (ActorPtr& actor: actor_manager->GetActors())
+    {
+        j.StartObject();
+        j.Key("file");  j.String(actor->ar_filename.c_str());
+        j.Key("nodes"); j.Int(actor->ar_num_nodes);
+        j.Key("beams"); j.Int(actor->ar_num_beams);
+        j.EndObject();
+    }
+    j.EndArray();
+    for (SimProfiler::ZoneTotal const& zone: zones)
+    {
+        if (zone.name == "ActorManager::UpdatePhysicsSimulation")
+        {
+            j.Key("physics_step_us"); j.Double((steps > 0) ? zone.total_us / static_cast<double>(steps) : 0.0);
+        }
+    }
+    j.Key("zones");
+    j.StartArray();
+    for (SimProfiler::ZoneTotal const& zone: zones)
+    {
+        j.StartObject();
+        j.Key("name");     j.String(zone.name.c_str());
+        j.Key("total_ms"); j.Double(zone.total_us / 1000.0);
+        j.Key("count");    j.Uint64(zone.count);
+        j.EndObject();
+    }
+    j.EndArray();
+    j.EndObject();
+
+    std::ofstream out(result_path);
+    out << buffer.GetString() << std::endl;
+    if (out.good())
+    {
+        RoR::LogFormat("[RoR|Benchmark] %.0f steps/sec, frame time p50 %.2f / p99 %.2f ms, results saved to '%s'",
+            (wall_sec > 0.0) ? steps / wall_sec : 0.0, GetPercentile(s_frame_ms, 0.50f), GetPercentile(s_frame_ms, 0.99f), result_path.c_str());
+    }
+    else
+    {
+        RoR::LogFormat("[RoR|Benchmark] Could not write '%s'", result_path.c_str());
+    }
+    RoR::Log(summary.c_str());
+}
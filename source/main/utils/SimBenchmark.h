@@ -0,0 +1,60 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Benchmark run requested by command line option `-benchmark <steps>` and/or `-benchmark-time <seconds>`.
+/// Once the terrain and the preset vehicle are in, runs until the given number of physics steps
+/// (in `sim_deterministic` mode) or the given time has passed, with `SimProfiler` capturing.
+/// Meanwhile the camera circles the player, unless a `-runscript` script moves it.
+/// Writes steps/sec, frame and render time percentiles with a histogram, per-zone totals
+/// and peak memory as JSON to the profiler directory, then quits the game.
+class SimBenchmark
+{
+public:
+    static void        Update(); //!< Call once per frame, after `GameContext::UpdateActors()`
+    static void        ReportRenderTime(int64_t us); //!< Time `Ogre::Root::renderOneFrame()` took, including waiting for the GPU.
+    static bool        IsActive(); //!< Requested on command line and not finished yet.
+    static bool        IsSceneReady(); //!< Terrain loaded, preset vehicle (if any) spawned and simulation running.
+
+private:
+    static void        UpdateCamera(float elapsed_sec);
+    static void        Finish();
+
+    static bool        s_running;
+    static int64_t     s_begin_us;
+    static int64_t     s_begin_steps;
+    static int64_t     s_last_frame_us;
+    static std::vector<float> s_frame_ms;
+    static std::vector<float> s_render_ms;
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
@@ -0,0 +1,220 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SimProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <vector>
+
+using namespace RoR;
+
+namespace {
+
+struct ZoneEvent
+{
+    const char* name;
+    int         actor_id;
+    int64_t     begin_us;
+    int64_t     end_us;
+};
+
+/// Each thread appends to its own buffer; the lock is only contended while starting/stopping a capture.
+struct ThreadBuffer
+{
+    std::mutex             mutex;
+    std::vector<ZoneEvent> events;
+    int                    thread_index = 0;
+};
+
+const size_t MAX_EVENTS_PER_THREAD = 1000000; // Keeps a forgotten capture from eating all memory
+
+std::mutex                                 g_buffers_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> g_buffers; // Never shrinks; threads keep a pointer to their buffer.
+thread_local ThreadBuffer*                 t_buffer = nullptr;
+
+const std::chrono::steady_clock::time_point g_epoch = std::chrono::steady_clock::now();
+
+ThreadBuffer* GetThreadBuffer()
+{
+    if (!t_buffer)
+    {
+        std::lock_guard<std::mutex> lock(g_buffers_mutex);
+        g_buffers.push_back(std::unique_ptr<ThreadBuffer>(new ThreadBuffer()));
+        t_buffer = g_buffers.back().get();
+        t_buffer->thread_index = static_cast<int>(g_buffers.size());
+    }
+    return t_buffer;
+}
+
+void WriteJsonString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (const char* c = str; *c; c++)
+    {
+        if (*c == '"' || *c == '\\')
+            out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::atomic<bool>     SimProfiler::s_capturing(false);
+std::atomic<uint64_t> SimProfiler::s_arena_allocations(0);
+std::atomic<uint64_t> SimProfiler::s_arena_bytes(0);
+std::atomic<uint64_t> SimProfiler::s_arena_heap_blocks(0);
+std::atomic<uint64_t> SimProfiler::s_arena_heap_bytes(0);
+
+int64_t SimProfiler::GetTimestampUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - g_epoch).count();
+}
+
+void SimProfiler::RecordZone(const char* name, int actor_id, int64_t begin_us, int64_t end_us)
+{
+    if (!IsCapturing())
+        return;
+
+    ThreadBuffer* buf = GetThreadBuffer();
+    std::lock_guard<std::mutex> lock(buf->mutex);
+    if (buf->events.size() < MAX_EVENTS_PER_THREAD)
+    {
+        buf->events.push_back(ZoneEvent{ name, actor_id, begin_us, end_us });
+    }
+}
+
+void SimProfiler::StartCapture()
+{
+    {
+        std::lock_guard<std::mutex> lock(g_buffers_mutex);
+        for (auto& buf: g_buffers)
+        {
+            std::lock_guard<std::mutex> buf_lock(buf->mutex);
+            buf->events.clear();
+        }
+    }
+    s_arena_allocations.store(0);
+    s_arena_bytes.store(0);
+    s_arena_heap_blocks.store(0);
+    s_arena_heap_bytes.store(0);
+    s_capturing.store(true);
+}
+
+bool SimProfiler::StopCapture(std::string const& filename, std::string& out_summary, std::vector<ZoneTotal>* out_totals)
+{
+    s_capturing.store(false);
+
+    struct ZoneStats
+    {
+        int64_t total_us = 0;
+        size_t  count = 0;
+    };
+    std::map<std::string, ZoneStats> zone_stats;
+    std::map<int, std::map<std::string, ZoneStats>> actor_stats;
+
+    std::ofstream out(filename);
+    if (out.is_open())
+    {
+        out << "{\"traceEvents\":[\n";
+    }
+    bool first = true;
+
+    std::lock_guard<std::mutex> lock(g_buffers_mutex);
+    for (auto& buf: g_buffers)
+    {
+        std::lock_guard<std::mutex> buf_lock(buf->mutex);
+        for (const ZoneEvent& ev: buf->events)
+        {
+            const int64_t duration_us = ev.end_us - ev.begin_us;
+            ZoneStats& zs = zone_stats[ev.name];
+            zs.total_us += duration_us;
+            zs.count++;
+            if (ev.actor_id != -1)
+            {
+                ZoneStats& as = actor_stats[ev.actor_id][ev.name];
+                as.total_us += duration_us;
+                as.count++;
+            }
+
+            if (out.is_open())
+            {
+                out << (first ? "" : ",\n") << "{\"name\":";
+                WriteJsonString(out, ev.name);
+                out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buf->thread_index
+                    << ",\"ts\":" << ev.begin_us << ",\"dur\":" << duration_us;
+                if (ev.actor_id != -1)
+                {
+                    out << ",\"args\":{\"actor\":" << ev.actor_id << "}";
+                }
+                out << "}";
+                first = false;
+            }
+        }
+        buf->events.clear();
+    }
+
+    if (out.is_open())
+    {
+        out << "\n]}\n";
+    }
+
+    // Summary: zones sorted by total time, then the same per actor
+    typedef std::pair<std::string, ZoneStats> ZoneEntry;
+    auto format_stats = [](std::ostream& s, std::map<std::string, ZoneStats> const& stats, const char* indent)
+    {
+        std::vector<ZoneEntry> sorted(stats.begin(), stats.end());
+        std::sort(sorted.begin(), sorted.end(), [](ZoneEntry const& a, ZoneEntry const& b) { return a.second.total_us > b.second.total_us; });
+        for (auto& entry: sorted)
+        {
+            s << indent << entry.first << ": " << (entry.second.total_us / 1000.0) << " ms (" << entry.second.count << "x)\n";
+        }
+    };
+
+    std::stringstream summary;
+    format_stats(summary, zone_stats, "");
+    for (auto& entry: actor_stats)
+    {
+        summary << "actor " << entry.first << ":\n";
+        format_stats(summary, entry.second, "    ");
+    }
+    summary << "frame arena: " << s_arena_allocations.load() << " allocations (" << (s_arena_bytes.load() / 1024) << " KiB), "
+            << s_arena_heap_blocks.load() << " heap blocks (" << (s_arena_heap_bytes.load() / 1024) << " KiB)\n";
+    out_summary = summary.str();
+
+    if (out_totals)
+    {
+        out_totals->clear();
+        for (auto& entry: zone_stats)
+        {
+            out_totals->push_back(ZoneTotal{ entry.first, entry.second.total_us, entry.second.count });
+        }
+        std::sort(out_totals->begin(), out_totals->end(), [](ZoneTotal const& a, ZoneTotal const& b) { return a.total_us > b.total_us; });
+    }
+
+    return out.is_open() && out.good();
+}
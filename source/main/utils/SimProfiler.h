@@ -0,0 +1,100 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Lightweight zone profiler for the simulation hot path.
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Records named zones per thread, tagged with an actor instance ID.
+/// Nothing is recorded unless a capture is running (console command `simprofiler`),
+/// an idle zone costs a single atomic load. Captures are saved as Chrome trace JSON,
+/// viewable in chrome://tracing or https://ui.perfetto.dev
+class SimProfiler
+{
+public:
+    struct ZoneTotal
+    {
+        std::string name;
+        int64_t     total_us;
+        size_t      count;
+    };
+
+    static void        StartCapture();
+    static bool        StopCapture(std::string const& filename, std::string& out_summary, std::vector<ZoneTotal>* out_totals = nullptr); //!< Writes the trace file and a per-zone/per-actor summary; returns false if the file couldn't be written.
+    static bool        IsCapturing() { return s_capturing.load(std::memory_order_relaxed); }
+
+    static int64_t     GetTimestampUs();
+    static void        RecordZone(const char* name, int actor_id, int64_t begin_us, int64_t end_us);
+    static void        CountArenaAllocation(size_t bytes, bool heap_block) //!< Called by `FrameArena`; `heap_block` means the arena had to grow.
+    {
+        if (!IsCapturing())
+            return;
+        (heap_block ? s_arena_heap_blocks : s_arena_allocations).fetch_add(1, std::memory_order_relaxed);
+        (heap_block ? s_arena_heap_bytes : s_arena_bytes).fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+private:
+    static std::atomic<bool>     s_capturing;
+    static std::atomic<uint64_t> s_arena_allocations;
+    static std::atomic<uint64_t> s_arena_bytes;
+    static std::atomic<uint64_t> s_arena_heap_blocks;
+    static std::atomic<uint64_t> s_arena_heap_bytes;
+};
+
+/// Profiles the enclosing scope, use `ROR_PROFILE_ZONE()`.
+class SimProfilerZone
+{
+public:
+    SimProfilerZone(const char* name, int actor_id):
+        m_name(name), m_actor_id(actor_id), m_begin_us(SimProfiler::IsCapturing() ? SimProfiler::GetTimestampUs() : -1) {}
+
+    ~SimProfilerZone()
+    {
+        if (m_begin_us >= 0)
+            SimProfiler::RecordZone(m_name, m_actor_id, m_begin_us, SimProfiler::GetTimestampUs());
+    }
+
+private:
+    const char* m_name;     //!< Must be a string literal, it's stored as a pointer.
+    int         m_actor_id;
+    int64_t     m_begin_us;
+};
+
+#define ROR_PROFILE_CONCAT_IMPL(A, B) A##B
+#define ROR_PROFILE_CONCAT(A, B) ROR_PROFILE_CONCAT_IMPL(A, B)
+
+/// Profiles the rest of the enclosing scope. `NAME` must be a string literal, `ACTOR_ID` is an `ActorInstanceID_t` or -1.
+#define ROR_PROFILE_ZONE(NAME, ACTOR_ID) RoR::SimProfilerZone ROR_PROFILE_CONCAT(ror_profile_zone_, __LINE__)(NAME, ACTOR_ID)
+
+/// @} // addtogroup Application
+
+} // namespace RoR
@@ -0,0 +1,109 @@
+/*
+    This source file is part of Rigs of Rods
+    Copyright 2005-2012 Pierre-Michel Ricordel
+    Copyright 2007-2012 Thomas Fischer
+    Copyright 2013-2020 Petr Ohlidal
+
+    For more information, see http://www.rigsofrods.org/
+
+    Rigs of Rods is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License version 3, as
+    published by the Free Software Foundation.
+
+    Rigs of Rods is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with Rigs of Rods. If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/// @file
+/// @brief Bounded lock-free queue for passing data between exactly two threads.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace RoR {
+
+/// @addtogroup Application
+/// @{
+
+/// Single-producer/single-consumer ring of preallocated slots.
+/// The producer fills a slot in place (`BeginPush()` + `EndPush()`), the consumer
+/// reads it in place (`Front()`/`Peek()` + `Pop()`); the queue never allocates or copies elements.
+/// `Reset()` and `Clear()` are only safe while neither thread is using the ring.
+template <class T>
+class SpscRing
+{
+public:
+    void Reset(size_t capacity)
+    {
+        m_slots = std::vector<T>(capacity + 1); // One slot stays empty to tell 'full' from 'empty'
+        this->Clear();
+    }
+
+    void Clear()
+    {
+        m_head.store(0);
+        m_tail.store(0);
+    }
+
+    // Producer
+
+    T* BeginPush() //!< Returns the slot to fill, or nullptr if the ring is full.
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (m_slots.empty() || this->Next(tail) == m_head.load(std::memory_order_acquire))
+            return nullptr;
+        return &m_slots[tail];
+    }
+
+    void EndPush() //!< Publishes the slot obtained by `BeginPush()`.
+    {
+        m_tail.store(this->Next(m_tail.load(std::memory_order_relaxed)), std::memory_order_release);
+    }
+
+    // Consumer
+
+    T* Front() { return this->Peek(0); } //!< Oldest element, or nullptr if the ring is empty.
+
+    T* Peek(size_t offset) //!< Element `offset` places after the front, or nullptr if not published yet.
+    {
+        if (m_slots.empty())
+            return nullptr;
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        const size_t tail = m_tail.load(std::memory_order_acquire);
+        if (offset >= (tail + m_slots.size() - head) % m_slots.size())
+            return nullptr;
+        return &m_slots[(head + offset) % m_slots.size()];
+    }
+
+    void Pop() //!< Releases the front slot back to the producer.
+    {
+        m_head.store(this->Next(m_head.load(std::memory_order_relaxed)), std::memory_order_release);
+    }
+
+    size_t Size() const //!< Exact for either thread's own view, approximate for the other.
+    {
+        if (m_slots.empty())
+            return 0;
+        return (m_tail.load(std::memory_order_acquire) + m_slots.size() - m_head.load(std::memory_order_acquire)) % m_slots.size();
+    }
+
+private:
+    size_t Next(size_t index) const { return (index + 1) % m_slots.size(); }
+
+    std::vector<T>      m_slots;
+    std::atomic<size_t> m_head{0};   //!< Next slot to read, written by the consumer
+    char                m_padding[64 - sizeof(std::atomic<size_t>)]; //!< Keeps head and tail on separate cache lines
+    std::atomic<size_t> m_tail{0};   //!< Next slot to write, written by the producer
+};
+
+/// @} // addtogroup Application
+
+} // namespace RoR
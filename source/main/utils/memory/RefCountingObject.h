@@ -8,7 +8,8 @@
 
 #include <angelscript.h>
 
-#include <mutex> // Against accidental threaded access
+#include <atomic>
+#include <thread>
 #include "Application.h" // Provides access to AppContext
 #include "AppContext.h" // Stores main thread ID for debug checking
 
@@ -40,8 +41,8 @@ public:
     {
         // Detect and prevent accidental threaded access.
         RefCountingObject_ASSERT(RoR::App::GetAppContext()->GetMainThreadID() == std::this_thread::get_id());
-        std::unique_lock<std::mutex> lock(m_refcount_mtx);
-        m_refcount++;
+        // A new reference can only be made from an existing one, nothing to synchronize with.
+        m_refcount.fetch_add(1, std::memory_order_relaxed);
         RefCoutingObject_DEBUGTRACE();
     }
 
@@ -49,13 +50,9 @@ public:
     {
         // Detect and prevent accidental threaded access.
         RefCountingObject_ASSERT(RoR::App::GetAppContext()->GetMainThreadID() == std::this_thread::get_id());
-        int nw_refcount = -1;
-        {
-            std::unique_lock<std::mutex> lock(m_refcount_mtx);
-            m_refcount--;
-            nw_refcount = m_refcount;
-            RefCoutingObject_DEBUGTRACE();
-        }
+        // Release: our writes to the object happen before the deletion; acquire: so do everyone else's.
+        const int nw_refcount = m_refcount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        RefCoutingObject_DEBUGTRACE();
         if (nw_refcount == 0)
         {
             delete this; // commit suicide! This is legit in C++, but you must completely 100% positively read https://isocpp.org/wiki/faq/freestore-mgmt#delete-this
@@ -78,8 +75,7 @@ public:
         r = engine->RegisterObjectBehaviour(name, asBEHAVE_RELEASE, "void f()", asMETHOD(T,Release), asCALL_THISCALL); RefCountingObject_ASSERT( r >= 0 );
     }
 
-    int m_refcount = 0;
-    std::mutex m_refcount_mtx; // Against accidental threaded access
+    std::atomic<int> m_refcount{0};
 };
 
 /*
@@ -28,10 +28,12 @@ public:
     RefCountingObjectPtr(T* ref);
     RefCountingObjectPtr();
     RefCountingObjectPtr(const RefCountingObjectPtr<T> &other);
+    RefCountingObjectPtr(RefCountingObjectPtr<T> &&other); // Steals the reference, no refcount traffic
     ~RefCountingObjectPtr();
 
     // Assignments
     RefCountingObjectPtr &operator=(const RefCountingObjectPtr<T> &other);
+    RefCountingObjectPtr &operator=(RefCountingObjectPtr<T> &&other);
     // Intentionally omitting raw-pointer assignment, for simplicity - see raw pointer constructor.
 
     // Compare smart ptr
@@ -195,6 +197,14 @@ inline RefCountingObjectPtr<T>::RefCountingObjectPtr(const RefCountingObjectPtr<
     AddRefHandle();
 }
 
+template<class T>
+inline RefCountingObjectPtr<T>::RefCountingObjectPtr(RefCountingObjectPtr<T> &&other)
+{
+    RefCoutingObjectPtr_DEBUGTRACE(other.m_ref);
+    m_ref = other.m_ref;
+    other.m_ref = nullptr;
+}
+
 template<class T>
 inline RefCountingObjectPtr<T>::~RefCountingObjectPtr()
 {
@@ -233,6 +243,19 @@ inline RefCountingObjectPtr<T> &RefCountingObjectPtr<T>::operator =(const RefCou
     return *this;
 }
 
+template<class T>
+inline RefCountingObjectPtr<T> &RefCountingObjectPtr<T>::operator =(RefCountingObjectPtr<T> &&other)
+{
+    RefCoutingObjectPtr_DEBUGTRACE(other.m_ref);
+    if (this != &other)
+    {
+        ReleaseHandle();
+        m_ref = other.m_ref;
+        other.m_ref = nullptr;
+    }
+    return *this;
+}
+
 template<class T>
 inline void RefCountingObjectPtr<T>::Set(T* ref)
 {
@@ -0,0 +1,175 @@
+
+// Physics kernels on a synthetic soft body: a box lattice of nodes, each tied to
+// its 13 forward neighbours (like a typical 'beams' section), ~10 beams per node.
+// The beam math comes from 'physics/BeamKernels.h', same as in `Actor::CalcPlainBeam()`
+// and `Actor::CalcPlainBeamsParallel()`; the structs and the surrounding loops mirror
+// `node_t`, `beam_t`, those functions and the integration pass of `Actor::CalcNodes()`.
+
+#include "benchmark/benchmark.h"
+#include "BeamKernels.h" // The real `fast_invSqrt()` and beam kernels
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+using Ogre::Vector3;
+
+struct Node // Same hot fields and padding as `node_t`
+{
+    Vector3 RelPosition;
+    Vector3 AbsPosition;
+    Vector3 Velocity;
+    Vector3 Forces;
+    float   mass;
+    float   inverted_mass;
+    int     pos;
+    char    padding[64];
+};
+
+struct Beam // Same hot fields as `beam_t`
+{
+    Node* p1;
+    Node* p2;
+    float k;
+    float d;
+    float L;
+    float stress;
+    float minmaxposnegstress;
+    bool  bm_disabled;
+};
+
+struct SoftBody
+{
+    std::vector<Node> nodes;
+    std::vector<Beam> beams;
+    std::vector<std::vector<Vector3>> batch_forces;
+};
+
+static SoftBody MakeSoftBody(int side)
+{
+    SoftBody body;
+    body.nodes.resize(side * side * side);
+    for (int z = 0; z < side; z++)
+    for (int y = 0; y < side; y++)
+    for (int x = 0; x < side; x++)
+    {
+        Node& n = body.nodes[(z * side + y) * side + x];
+        n.RelPosition = Vector3(x * 0.5f, y * 0.5f, z * 0.5f);
+        n.Velocity = Vector3((std::rand() % 100) * 0.001f, 0.f, 0.f); // So that damping does something
+        n.mass = 10.f;
+        n.inverted_mass = 0.1f;
+        n.pos = (z * side + y) * side + x;
+    }
+
+    for (int z = 0; z < side; z++)
+    for (int y = 0; y < side; y++)
+    for (int x = 0; x < side; x++)
+    for (int dz = 0; dz <= 1; dz++)
+    for (int dy = -1; dy <= 1; dy++)
+    for (int dx = -1; dx <= 1; dx++)
+    {
+        const bool forward = dz > 0 || (dz == 0 && (dy > 0 || (dy == 0 && dx > 0)));
+        if (!forward || x + dx < 0 || x + dx >= side || y + dy < 0 || y + dy >= side || z + dz >= side)
+            continue;
+
+        Beam b;
+        b.p1 = &body.nodes[(z * side + y) * side + x];
+        b.p2 = &body.nodes[((z + dz) * side + (y + dy)) * side + (x + dx)];
+        b.k = 9000000.f;
+        b.d = 12000.f;
+        b.L = std::sqrt((b.p1->RelPosition - b.p2->RelPosition).squaredLength()) * 0.99f; // Slightly preloaded
+        b.stress = 0.f;
+        b.minmaxposnegstress = 1e30f; // Never deforms, like most beams in most steps
+        b.bm_disabled = false;
+        body.beams.push_back(b);
+    }
+    return body;
+}
+
+// `Actor::CalcPlainBeam()` over all beams: forces go straight to the nodes
+static void Bench_Beams_Sequential(benchmark::State& state)
+{
+    SoftBody body = MakeSoftBody(static_cast<int>(state.range(0)));
+    while (state.KeepRunning())
+    {
+        for (Beam& beam: body.beams)
+        {
+            if (beam.bm_disabled)
+                continue;
+
+            Vector3 dis; float inverted_dislen, difftoBeamL;
+            const float slen = RoR::CalcPlainBeamStress(beam, dis, inverted_dislen, difftoBeamL);
+            beam.stress = slen;
+            const Vector3 f = RoR::CalcPlainBeamForce(dis, slen, inverted_dislen);
+            beam.p1->Forces += f;
+            beam.p2->Forces -= f;
+        }
+        benchmark::DoNotOptimize(body.nodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * body.beams.size());
+    state.counters["nodes"] = static_cast<double>(body.nodes.size());
+}
+BENCHMARK(Bench_Beams_Sequential)->Arg(6)->Arg(10)->Arg(16);
+
+// `Actor::CalcPlainBeamsParallel()` on one thread: per-batch force buffers plus the reduction;
+// the overhead that the worker threads must win back
+static void Bench_Beams_BatchBuffers(benchmark::State& state)
+{
+    SoftBody body = MakeSoftBody(static_cast<int>(state.range(0)));
+    const size_t num_batches = 4;
+    const size_t batch_size = (body.beams.size() + num_batches - 1) / num_batches;
+    body.batch_forces.resize(num_batches);
+    while (state.KeepRunning())
+    {
+        for (size_t batch = 0; batch < num_batches; batch++)
+        {
+            std::vector<Vector3>& forces = body.batch_forces[batch];
+            forces.assign(body.nodes.size(), Vector3::ZERO);
+            const size_t end = std::min(body.beams.size(), (batch + 1) * batch_size);
+            for (size_t i = batch * batch_size; i < end; i++)
+            {
+                Beam& beam = body.beams[i];
+                Vector3 dis; float inverted_dislen, difftoBeamL;
+                const float slen = RoR::CalcPlainBeamStress(beam, dis, inverted_dislen, difftoBeamL);
+                beam.stress = slen;
+                const Vector3 f = RoR::CalcPlainBeamForce(dis, slen, inverted_dislen);
+                forces[beam.p1->pos] += f;
+                forces[beam.p2->pos] -= f;
+            }
+        }
+        for (size_t batch = 0; batch < num_batches; batch++)
+        {
+            const std::vector<Vector3>& forces = body.batch_forces[batch];
+            for (size_t n = 0; n < body.nodes.size(); n++)
+            {
+                body.nodes[n].Forces += forces[n];
+            }
+        }
+        benchmark::DoNotOptimize(body.nodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * body.beams.size());
+}
+BENCHMARK(Bench_Beams_BatchBuffers)->Arg(6)->Arg(10)->Arg(16);
+
+// Integration pass of `Actor::CalcNodes()`, gravity only, without ground or water
+static void Bench_Nodes_Integrate(benchmark::State& state)
+{
+    SoftBody body = MakeSoftBody(static_cast<int>(state.range(0)));
+    const float dt = 0.0005f;
+    const float gravity = -9.807f;
+    while (state.KeepRunning())
+    {
+        for (Node& node: body.nodes)
+        {
+            node.Forces.y += node.mass * gravity;
+            node.Velocity += node.Forces * (dt * node.inverted_mass);
+            node.RelPosition += node.Velocity * dt;
+            node.Forces = Vector3::ZERO;
+        }
+        benchmark::DoNotOptimize(body.nodes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * body.nodes.size());
+}
+BENCHMARK(Bench_Nodes_Integrate)->Arg(6)->Arg(10)->Arg(16);
+
+BENCHMARK_MAIN();
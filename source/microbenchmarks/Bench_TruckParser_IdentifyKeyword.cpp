@@ -1,6 +1,11 @@
 
 #include "benchmark/benchmark.h"
+#include <climits>
+#include <cstring>
 #include <regex>
+#ifndef WIN32
+#   include <strings.h>
+#endif
 #include <iostream>
 
     enum Keyword